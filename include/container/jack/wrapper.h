@@ -28,7 +28,7 @@
 #include <core/IWrapper.h>
 #include <core/IPort.h>
 #include <core/ICanvas.h>
-#include <core/ipc/NativeExecutor.h>
+#include <core/ipc/PoolExecutor.h>
 #include <core/ipc/Mutex.h>
 #include <container/CairoCanvas.h>
 
@@ -302,6 +302,9 @@ namespace lsp
 
     int JACKWrapper::run(size_t samples)
     {
+        // Update state of inline display consumer
+        pPlugin->update_display_state(samples);
+
         // Prepare ports
         size_t n_ports      = vPorts.size();
         JACKPort **v_ports  = vPorts.get_array();
@@ -883,8 +886,8 @@ namespace lsp
         if (pExecutor != NULL)
             return pExecutor;
 
-        lsp_trace("Creating native executor service");
-        ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+        lsp_trace("Creating pool executor service");
+        ipc::PoolExecutor *exec = new ipc::PoolExecutor();
         if (exec == NULL)
             return NULL;
         if (exec->start() != STATUS_OK)
@@ -917,6 +920,7 @@ namespace lsp
             return NULL;
 
         // Call plugin for rendering
+        pPlugin->display_drawn();
         if (!pPlugin->inline_display(pCanvas, width, height))
         {
             // Unlock canvas if possible
@@ -251,12 +251,19 @@ namespace lsp
 
             virtual ipc::IExecutor *get_executor()
             {
-                if (pExecutor == NULL)
+                if (pExecutor != NULL)
+                    return pExecutor;
+
+                lsp_trace("Creating pool executor service");
+                ipc::PoolExecutor *exec = new ipc::PoolExecutor();
+                if (exec == NULL)
+                    return NULL;
+                if (exec->start() != STATUS_OK)
                 {
-                    lsp_trace("Creating native executor service");
-                    pExecutor       = new ipc::NativeExecutor();
+                    delete exec;
+                    return NULL;
                 }
-                return pExecutor;
+                return pExecutor = exec;
             }
 
             virtual const position_t *position()
@@ -135,6 +135,9 @@ namespace lsp
             LV2_URID                uridConnectUI;
             LV2_URID                uridDisconnectUI;
             LV2_URID                uridDumpState;
+            LV2_URID                uridShmState;               // Shared memory transport announcement
+            LV2_URID                uridShmAttach;              // Shared memory transport acknowledgement
+            LV2_URID                uridShmName;                // Name of the shared memory segment
             LV2_URID                uridPathType;
             LV2_URID                uridMidiEventType;
             LV2_URID                uridKvtKeys;
@@ -290,6 +293,9 @@ namespace lsp
                 uridConnectUI               = map_primitive("ui_connect");
                 uridDisconnectUI            = map_primitive("ui_disconnect");
                 uridDumpState               = map_primitive("dumpState");
+                uridShmState                = map_primitive("shm_state");
+                uridShmAttach               = map_primitive("shm_attach");
+                uridShmName                 = map_field("ShmState#name");
                 uridPathType                = forge.Path;
                 uridMidiEventType           = map_uri(LV2_MIDI__MidiEvent);
                 uridKvtObject               = map_primitive("KVT");
@@ -731,6 +737,24 @@ namespace lsp
                 return true;
             }
 
+            inline bool ui_attach_shm()
+            {
+                if (map == NULL)
+                    return false;
+
+                // Prepare forge for transfer
+                LV2_Atom_Forge_Frame    frame;
+                forge_set_buffer(pBuffer, nBufSize);
+
+                // Send SHM ATTACH message
+                lsp_trace("Sending SHM ATTACH message");
+                LV2_Atom *msg = forge_object(&frame, uridShmAttach, uridUINotification);
+                forge_pop(&frame);
+                write_data(nAtomOut, lv2_atom_total_size(msg), uridEventTransfer, msg);
+
+                return true;
+            }
+
             inline void ui_disconnect_from_plugin()
             {
                 if (map == NULL)
@@ -847,6 +871,81 @@ namespace lsp
 
     #define PATCH_OVERHEAD  (sizeof(LV2_Atom_Property) + sizeof(LV2_Atom_URID) + sizeof(LV2_Atom) + 0x20)
 
+    inline long lv2_all_port_sizes(const port_t *ports, bool in, bool out);
+
+    /**
+     * Estimate the maximum size of the serialized port data
+     * @param p port metadata
+     * @param in take input ports into account
+     * @param out take output ports into account
+     * @return estimated size of the serialized port data in bytes
+     */
+    inline long lv2_port_size(const port_t *p, bool in, bool out)
+    {
+        long size           = 0;
+
+        switch (p->role)
+        {
+            case R_CONTROL:
+            case R_METER:
+                size            += PATCH_OVERHEAD + sizeof(LV2_Atom_Float);
+                break;
+            case R_MESH:
+                if (IS_OUT_PORT(p) && (!out))
+                    break;
+                else if (IS_IN_PORT(p) && (!in))
+                    break;
+                size            += LV2Mesh::size_of_port(p);
+                break;
+            case R_STREAM:
+            {
+                if (IS_OUT_PORT(p) && (!out))
+                    break;
+                else if (IS_IN_PORT(p) && (!in))
+                    break;
+
+                size_t vector_len   = sizeof(LV2_Atom_Vector) + 4 * sizeof(LV2_Atom_Int) + sizeof(float) * STREAM_MAX_FRAME_SIZE;
+                size_t frm_size     = sizeof(LV2_Atom_Object) + 8 * sizeof(LV2_Atom_Int) + size_t(p->min) * vector_len;
+                size_t data_size    = sizeof(LV2_Atom_Object) + 8 * sizeof(LV2_Atom_Int) + STREAM_BULK_MAX * frm_size;
+                size               += data_size;
+                break;
+            }
+            case R_FBUFFER:
+                if (IS_OUT_PORT(p) && (!out))
+                    break;
+                else if (IS_IN_PORT(p) && (!in))
+                    break;
+                size           += (4 * sizeof(LV2_Atom_Int) + 0x100) + // Headers
+                                    size_t(p->step) * FRAMEBUFFER_BULK_MAX * sizeof(float);
+                break;
+            case R_OSC:
+                size           += OSC_BUFFER_MAX;
+                break;
+            case R_MIDI:
+                if (IS_OUT_PORT(p) && (!out))
+                    break;
+                else if (IS_IN_PORT(p) && (!in))
+                    break;
+                size            += (sizeof(LV2_Atom_Event) + 0x10) * MIDI_EVENTS_MAX; // Size of atom event + pad for MIDI data
+                break;
+            case R_PATH: // Both sizes: IN and OUT
+                size            += PATCH_OVERHEAD + PATH_MAX;
+                break;
+            case R_PORT_SET:
+                if ((p->members != NULL) && (p->items != NULL))
+                {
+                    size_t items        = list_size(p->items);
+                    size               += items * lv2_all_port_sizes(p->members, in, out); // Add some overhead
+                    size               += sizeof(LV2_Atom_Int) + 0x10;
+                }
+                break;
+            default:
+                break;
+        }
+
+        return size;
+    }
+
     inline long lv2_all_port_sizes(const port_t *ports, bool in, bool out)
     {
         long size           = 0;
@@ -861,64 +960,7 @@ namespace lsp
 //                    continue;
 //            }
 
-            switch (p->role)
-            {
-                case R_CONTROL:
-                case R_METER:
-                    size            += PATCH_OVERHEAD + sizeof(LV2_Atom_Float);
-                    break;
-                case R_MESH:
-                    if (IS_OUT_PORT(p) && (!out))
-                        break;
-                    else if (IS_IN_PORT(p) && (!in))
-                        break;
-                    size            += LV2Mesh::size_of_port(p);
-                    break;
-                case R_STREAM:
-                {
-                    if (IS_OUT_PORT(p) && (!out))
-                        break;
-                    else if (IS_IN_PORT(p) && (!in))
-                        break;
-
-                    size_t vector_len   = sizeof(LV2_Atom_Vector) + 4 * sizeof(LV2_Atom_Int) + sizeof(float) * STREAM_MAX_FRAME_SIZE;
-                    size_t frm_size     = sizeof(LV2_Atom_Object) + 8 * sizeof(LV2_Atom_Int) + size_t(p->min) * vector_len;
-                    size_t data_size    = sizeof(LV2_Atom_Object) + 8 * sizeof(LV2_Atom_Int) + STREAM_BULK_MAX * frm_size;
-                    size               += data_size;
-                    break;
-                }
-                case R_FBUFFER:
-                    if (IS_OUT_PORT(p) && (!out))
-                        break;
-                    else if (IS_IN_PORT(p) && (!in))
-                        break;
-                    size           += (4 * sizeof(LV2_Atom_Int) + 0x100) + // Headers
-                                        size_t(p->step) * FRAMEBUFFER_BULK_MAX * sizeof(float);
-                    break;
-                case R_OSC:
-                    size           += OSC_BUFFER_MAX;
-                    break;
-                case R_MIDI:
-                    if (IS_OUT_PORT(p) && (!out))
-                        break;
-                    else if (IS_IN_PORT(p) && (!in))
-                        break;
-                    size            += (sizeof(LV2_Atom_Event) + 0x10) * MIDI_EVENTS_MAX; // Size of atom event + pad for MIDI data
-                    break;
-                case R_PATH: // Both sizes: IN and OUT
-                    size            += PATCH_OVERHEAD + PATH_MAX;
-                    break;
-                case R_PORT_SET:
-                    if ((p->members != NULL) && (p->items != NULL))
-                    {
-                        size_t items        = list_size(p->items);
-                        size               += items * lv2_all_port_sizes(p->members, in, out); // Add some overhead
-                        size               += sizeof(LV2_Atom_Int) + 0x10;
-                    }
-                    break;
-                default:
-                    break;
-            }
+            size               += lv2_port_size(p, in, out);
         }
 
         // Update state size
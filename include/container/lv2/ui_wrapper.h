@@ -47,12 +47,17 @@ namespace lsp
             KVTStorage              sKVT;
             ipc::Mutex              sKVTMutex;
             uint8_t                *pOscBuffer;     // OSC packet data
+            ipc::SharedMemory       sShm;           // Shared memory segment of the plugin
+            shm_ring_t             *pShmRing;       // Ring buffer stored in the shared memory segment
 
         protected:
             LV2UIPort *create_port(const port_t *p, const char *postfix);
             void create_ports(const port_t *port);
 
             void receive_atom(const LV2_Atom_Object * atom);
+            void attach_shm(const LV2_Atom_Object *obj);
+            void detach_shm();
+            void receive_shm();
             static LV2UIPort *find_by_urid(cvector<LV2UIPort> &v, LV2_URID urid);
             void sort_by_urid(cvector<LV2UIPort> &v);
 
@@ -69,6 +74,7 @@ namespace lsp
                 pLatency    = NULL;
                 bConnected  = false;
                 pOscBuffer  = NULL;
+                pShmRing    = NULL;
 
                 position_t::init(&sPosition);
             }
@@ -224,6 +230,9 @@ namespace lsp
                         pExt->ui_disconnect_from_plugin();
                     bConnected = false;
                 }
+
+                // Drop shared memory transport
+                detach_shm();
             }
 
             void destroy()
@@ -513,6 +522,8 @@ namespace lsp
                     pUI->position_updated(&pos);
                     sPosition           = pos;
                 }
+                else if (pShmRing != NULL)
+                    receive_shm();
 
                 // Transmit KVT state
                 if (sKVTMutex.try_lock())
@@ -888,6 +899,8 @@ namespace lsp
                 p->notify_all();
             }
         }
+        else if ((obj->body.otype == pExt->uridUINotification) && (obj->body.id == pExt->uridShmState))
+            attach_shm(obj);
         else
         {
             lsp_trace("obj->body.otype = %d (%s)", int(obj->body.otype), pExt->unmap_urid(obj->body.otype));
@@ -895,6 +908,71 @@ namespace lsp
         }
     }
 
+    void LV2UIWrapper::attach_shm(const LV2_Atom_Object *obj)
+    {
+        const char *name    = NULL;
+
+        for (
+            LV2_Atom_Property_Body *body = lv2_atom_object_begin(&obj->body) ;
+            !lv2_atom_object_is_end(&obj->body, obj->atom.size, body) ;
+            body = lv2_atom_object_next(body)
+        )
+        {
+            if ((body->key == pExt->uridShmName) && (body->value.type == pExt->forge.String))
+                name    = reinterpret_cast<const char *>(LV2_ATOM_BODY_CONST(&body->value));
+        }
+
+        if (name == NULL)
+            return;
+
+        // Map the segment of the plugin
+        detach_shm();
+        status_t res = sShm.open(name);
+        if (res != STATUS_OK)
+        {
+            lsp_trace("Could not open shared memory segment %s, code=%d", name, int(res));
+            return;
+        }
+
+        pShmRing    = shm_ring_t::attach(sShm.data(), sShm.size());
+        if (pShmRing == NULL)
+        {
+            sShm.close();
+            return;
+        }
+
+        // Acknowledge the plugin that data can be passed through the shared memory
+        lsp_trace("Attached to shared memory segment %s", name);
+        pExt->ui_attach_shm();
+    }
+
+    void LV2UIWrapper::detach_shm()
+    {
+        pShmRing    = NULL;
+        sShm.close();
+    }
+
+    void LV2UIWrapper::receive_shm()
+    {
+        const void *data;
+        size_t size;
+
+        while ((data = pShmRing->begin_read(&size)) != NULL)
+        {
+            // Validate the record, only port data is allowed to be passed through the ring
+            const LV2_Atom_Object *obj  = reinterpret_cast<const LV2_Atom_Object *>(data);
+            if ((size >= sizeof(LV2_Atom_Object)) &&
+                (lv2_atom_total_size(&obj->atom) <= size) &&
+                ((obj->atom.type == pExt->uridObject) || (obj->atom.type == pExt->uridBlank)) &&
+                ((obj->body.otype == pExt->uridMeshType) ||
+                 (obj->body.otype == pExt->uridStreamType) ||
+                 (obj->body.otype == pExt->uridFrameBufferType)))
+                receive_atom(obj);
+
+            pShmRing->commit_read();
+        }
+    }
+
     KVTStorage *LV2UIWrapper::kvt_lock()
     {
         return (sKVTMutex.lock()) ? &sKVT : NULL;
@@ -26,7 +26,8 @@
 
 #include <dsp/endian.h>
 #include <core/IWrapper.h>
-#include <core/ipc/NativeExecutor.h>
+#include <core/ipc/PoolExecutor.h>
+#include <core/ipc/SharedMemory.h>
 #include <core/KVTDispatcher.h>
 #include <container/lv2/lv2_sink.h>
 
@@ -105,6 +106,13 @@ namespace lsp
             ipc::Mutex              sKVTMutex;
             KVTDispatcher          *pKVTDispatcher;
 
+            ipc::SharedMemory       sShm;           // Shared memory segment for the UI transport
+            shm_ring_t             *pShmRing;       // Ring buffer stored in the shared memory segment
+            size_t                  nShmRecMax;     // Maximum size of the ring record
+            size_t                  nShmFirst;      // Port class transmitted first through the ring
+            bool                    bShmAnnounce;   // Shared memory segment should be announced to the UI
+            bool                    bShmActive;     // UI has attached to the shared memory segment
+
 #ifndef LSP_NO_LV2_UI
             CairoCanvas            *pCanvas;        // Canvas for drawing inline display
             LV2_Inline_Display_Image_Surface sSurface; // Canvas surface
@@ -116,6 +124,11 @@ namespace lsp
 
             void receive_atoms(size_t samples);
             void transmit_atoms(size_t samples);
+            void create_shm_transport();
+            void transmit_shm(bool sync_req);
+            bool transmit_shm_meshes(bool sync_req);
+            bool transmit_shm_streams();
+            bool transmit_shm_frame_buffers();
             static LV2Port *find_by_urid(cvector<LV2Port> &v, LV2_URID urid);
             static void sort_by_urid(cvector<LV2Port> &v);
 
@@ -160,6 +173,11 @@ namespace lsp
                 nDumpReq        = 0;
                 nDumpResp       = 0;
                 pKVTDispatcher  = NULL;
+                pShmRing        = NULL;
+                nShmRecMax      = 0;
+                nShmFirst       = 0;
+                bShmAnnounce    = false;
+                bShmActive      = false;
 
                 position_t::init(&sPosition);
             }
@@ -550,6 +568,52 @@ namespace lsp
         // Update refresh rate
         nSyncSamples        = srate / pExt->ui_refresh_rate();
         nClients            = 0;
+
+        // Create shared memory transport for out-of-process UI
+        create_shm_transport();
+    }
+
+    void LV2Wrapper::create_shm_transport()
+    {
+        size_t size         = 0;
+        nShmRecMax          = 0;
+
+        // Estimate the amount of data transferred per one synchronization
+        for (size_t i=0, n=vAllPorts.size(); i<n; ++i)
+        {
+            LV2Port *p          = vAllPorts.at(i);
+            if (p == NULL)
+                continue;
+            const port_t *meta  = p->metadata();
+            if ((meta->role != R_MESH) && (meta->role != R_STREAM) && (meta->role != R_FBUFFER))
+                continue;
+
+            size_t rec          = lv2_port_size(meta, false, true);
+            size               += rec;
+            if (nShmRecMax < rec)
+                nShmRecMax          = rec;
+        }
+
+        if (nShmRecMax <= 0)
+            return;
+
+        // Keep enough space for two synchronizations to let the UI lag a bit
+        size_t cap          = (size + nShmRecMax) * 2;
+        status_t res        = sShm.create_unique("lsp-lv2", shm_ring_t::size_of(cap));
+        if (res != STATUS_OK)
+        {
+            lsp_trace("Could not create shared memory segment, code=%d", int(res));
+            return;
+        }
+
+        pShmRing            = shm_ring_t::init(sShm.data(), sShm.size());
+        if (pShmRing == NULL)
+        {
+            sShm.close();
+            return;
+        }
+
+        lsp_trace("Created shared memory transport %s, capacity=%d", sShm.name(), int(pShmRing->capacity()));
     }
 
     LV2Port *LV2Wrapper::find_by_urid(cvector<LV2Port> &v, LV2_URID urid)
@@ -875,6 +939,8 @@ namespace lsp
             {
                 nClients    ++;
                 nStateReqs  ++;
+                bShmAnnounce    = pShmRing != NULL;
+                bShmActive      = false;
                 lsp_trace("UI has connected, current number of clients=%d", int(nClients));
                 if (pKVTDispatcher != NULL)
                     pKVTDispatcher->connect_client();
@@ -890,6 +956,9 @@ namespace lsp
             else if (obj->body.id == pExt->uridDisconnectUI)
             {
                 nClients    --;
+                bShmActive      = false;
+                // The remaining UI may read the ring buffer again, announce it
+                bShmAnnounce    = (pShmRing != NULL) && (nClients == 1);
                 if (pKVTDispatcher != NULL)
                     pKVTDispatcher->disconnect_client();
                 lsp_trace("UI has disconnected, current number of clients=%d", int(nClients));
@@ -899,6 +968,12 @@ namespace lsp
                 lsp_trace("Received DUMP_STATE event");
                 atomic_add(&nDumpReq, 1);
             }
+            else if (obj->body.id == pExt->uridShmAttach)
+            {
+                // Only one consumer can read the ring buffer
+                bShmActive      = (pShmRing != NULL) && (nClients == 1);
+                lsp_trace("UI has attached to shared memory, active=%s", (bShmActive) ? "true" : "false");
+            }
         }
         else
         {
@@ -1274,66 +1349,201 @@ namespace lsp
             if (msg != NULL)
                 pExt->forge_pop(&frame);
 
-            // Serialize meshes (it's own primitive MESH)
-            for (size_t i=0, n=vMeshPorts.size(); i<n; ++i)
+            // Announce shared memory transport to the connected UI
+            if (bShmAnnounce)
             {
-                LV2Port *p = vMeshPorts[i];
-                if (p == NULL)
-                    continue;
-                if ((!sync_req) && (!p->tx_pending()))
-                    continue;
-                mesh_t *mesh = p->getBuffer<mesh_t>();
-                if ((mesh == NULL) || (!mesh->containsData()))
-                    continue;
-
-//                lsp_trace("transmit mesh id=%s", p->metadata()->id);
                 pExt->forge_frame_time(0);  // Event header
-                msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridMeshType);
-                p->serialize();
+                pExt->forge_object(&frame, pExt->uridShmState, pExt->uridUINotification);
+                pExt->forge_key(pExt->uridShmName);
+                pExt->forge_string(sShm.name());
                 pExt->forge_pop(&frame);
-                bytes_out   += lv2_atom_total_size(msg);
-
-                // Cleanup data of the mesh for refill
-                mesh->markEmpty();
+                bShmAnnounce    = false;
             }
 
-            // Serialize streams (it's own primitive STREAM)
-            for (size_t i=0, n=vStreamPorts.size(); i<n; ++i)
+            // Meshes, streams and frame buffers are passed through the shared memory if UI has attached to it
+            if (!bShmActive)
             {
-                LV2Port *p = vStreamPorts[i];
-                if ((p == NULL) || (!p->tx_pending()))
-                    continue;
-                stream_t *s = p->getBuffer<stream_t>();
-                if (s == NULL)
-                    continue;
+                // Serialize meshes (it's own primitive MESH)
+                for (size_t i=0, n=vMeshPorts.size(); i<n; ++i)
+                {
+                    LV2Port *p = vMeshPorts[i];
+                    if (p == NULL)
+                        continue;
+                    if ((!sync_req) && (!p->tx_pending()))
+                        continue;
+                    mesh_t *mesh = p->getBuffer<mesh_t>();
+                    if ((mesh == NULL) || (!mesh->containsData()))
+                        continue;
 
-                pExt->forge_frame_time(0);  // Event header
-                msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridStreamType);
-                p->serialize();
-                pExt->forge_pop(&frame);
-                bytes_out   += lv2_atom_total_size(msg);
-            }
+//                    lsp_trace("transmit mesh id=%s", p->metadata()->id);
+                    pExt->forge_frame_time(0);  // Event header
+                    msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridMeshType);
+                    p->serialize();
+                    pExt->forge_pop(&frame);
+                    bytes_out   += lv2_atom_total_size(msg);
 
-            // Serialize frame buffers (it's own primitive FRAMEBUFFER)
-            for (size_t i=0, n=vFrameBufferPorts.size(); i<n; ++i)
-            {
-                LV2Port *p = vFrameBufferPorts[i];
-                if ((p == NULL) || (!p->tx_pending()))
-                    continue;
-                frame_buffer_t *fb= p->getBuffer<frame_buffer_t>();
-                if (fb == NULL)
-                    continue;
+                    // Cleanup data of the mesh for refill
+                    mesh->markEmpty();
+                }
 
-                pExt->forge_frame_time(0);  // Event header
-                msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridFrameBufferType);
-                p->serialize();
-                pExt->forge_pop(&frame);
-                bytes_out   += lv2_atom_total_size(msg);
+                // Serialize streams (it's own primitive STREAM)
+                for (size_t i=0, n=vStreamPorts.size(); i<n; ++i)
+                {
+                    LV2Port *p = vStreamPorts[i];
+                    if ((p == NULL) || (!p->tx_pending()))
+                        continue;
+                    stream_t *s = p->getBuffer<stream_t>();
+                    if (s == NULL)
+                        continue;
+
+                    pExt->forge_frame_time(0);  // Event header
+                    msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridStreamType);
+                    p->serialize();
+                    pExt->forge_pop(&frame);
+                    bytes_out   += lv2_atom_total_size(msg);
+                }
+
+                // Serialize frame buffers (it's own primitive FRAMEBUFFER)
+                for (size_t i=0, n=vFrameBufferPorts.size(); i<n; ++i)
+                {
+                    LV2Port *p = vFrameBufferPorts[i];
+                    if ((p == NULL) || (!p->tx_pending()))
+                        continue;
+                    frame_buffer_t *fb= p->getBuffer<frame_buffer_t>();
+                    if (fb == NULL)
+                        continue;
+
+                    pExt->forge_frame_time(0);  // Event header
+                    msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridFrameBufferType);
+                    p->serialize();
+                    pExt->forge_pop(&frame);
+                    bytes_out   += lv2_atom_total_size(msg);
+                }
             }
         }
 
         // Complete sequence
         pExt->forge_pop(&seq);
+
+        // Transmit meshes, streams and frame buffers through the shared memory
+        if ((nClients > 0) && (bShmActive))
+            transmit_shm(sync_req);
+    }
+
+    void LV2Wrapper::transmit_shm(bool sync_req)
+    {
+        // All records have the same size, so when the ring is out of space there is no
+        // sense to try the rest of ports. Rotate the port class transmitted first to
+        // not let meshes starve streams and frame buffers when the UI is slow
+        size_t first    = nShmFirst;
+        nShmFirst       = (nShmFirst + 1) % 3;
+
+        for (size_t i=0; i<3; ++i)
+        {
+            bool done;
+            switch ((first + i) % 3)
+            {
+                case 0:     done = transmit_shm_meshes(sync_req); break;
+                case 1:     done = transmit_shm_streams(); break;
+                default:    done = transmit_shm_frame_buffers(); break;
+            }
+            if (!done)
+                return;
+        }
+    }
+
+    bool LV2Wrapper::transmit_shm_meshes(bool sync_req)
+    {
+        LV2_Atom_Forge_Frame    frame;
+        LV2_Atom *msg;
+        void *rec;
+
+        for (size_t i=0, n=vMeshPorts.size(); i<n; ++i)
+        {
+            LV2Port *p = vMeshPorts[i];
+            if (p == NULL)
+                continue;
+            if ((!sync_req) && (!p->tx_pending()))
+                continue;
+            mesh_t *mesh = p->getBuffer<mesh_t>();
+            if ((mesh == NULL) || (!mesh->containsData()))
+                continue;
+
+            // Leave the port pending until the UI frees space in the ring
+            if ((rec = pShmRing->begin_write(nShmRecMax)) == NULL)
+                return false;
+
+            pExt->forge_set_buffer(rec, nShmRecMax);
+            msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridMeshType);
+            p->serialize();
+            pExt->forge_pop(&frame);
+            if (msg == NULL)
+                continue;
+            pShmRing->commit_write(lv2_atom_total_size(msg));
+
+            // Cleanup data of the mesh for refill
+            mesh->markEmpty();
+        }
+
+        return true;
+    }
+
+    bool LV2Wrapper::transmit_shm_streams()
+    {
+        LV2_Atom_Forge_Frame    frame;
+        LV2_Atom *msg;
+        void *rec;
+
+        for (size_t i=0, n=vStreamPorts.size(); i<n; ++i)
+        {
+            LV2Port *p = vStreamPorts[i];
+            if ((p == NULL) || (!p->tx_pending()))
+                continue;
+            stream_t *s = p->getBuffer<stream_t>();
+            if (s == NULL)
+                continue;
+
+            if ((rec = pShmRing->begin_write(nShmRecMax)) == NULL)
+                return false;
+
+            pExt->forge_set_buffer(rec, nShmRecMax);
+            msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridStreamType);
+            p->serialize();
+            pExt->forge_pop(&frame);
+            if (msg != NULL)
+                pShmRing->commit_write(lv2_atom_total_size(msg));
+        }
+
+        return true;
+    }
+
+    bool LV2Wrapper::transmit_shm_frame_buffers()
+    {
+        LV2_Atom_Forge_Frame    frame;
+        LV2_Atom *msg;
+        void *rec;
+
+        for (size_t i=0, n=vFrameBufferPorts.size(); i<n; ++i)
+        {
+            LV2Port *p = vFrameBufferPorts[i];
+            if ((p == NULL) || (!p->tx_pending()))
+                continue;
+            frame_buffer_t *fb= p->getBuffer<frame_buffer_t>();
+            if (fb == NULL)
+                continue;
+
+            if ((rec = pShmRing->begin_write(nShmRecMax)) == NULL)
+                return false;
+
+            pExt->forge_set_buffer(rec, nShmRecMax);
+            msg         = pExt->forge_object(&frame, p->get_urid(), pExt->uridFrameBufferType);
+            p->serialize();
+            pExt->forge_pop(&frame);
+            if (msg != NULL)
+                pShmRing->commit_write(lv2_atom_total_size(msg));
+        }
+
+        return true;
     }
 
     void LV2Wrapper::destroy()
@@ -1374,6 +1584,11 @@ namespace lsp
             pExecutor   = NULL;
         }
 
+        // Drop shared memory transport
+        pShmRing        = NULL;
+        bShmActive      = false;
+        sShm.close();
+
         // Drop plugin
         if (pPlugin != NULL)
         {
@@ -1459,6 +1674,9 @@ namespace lsp
         else if (pPlugin->ui_active())
             pPlugin->deactivate_ui();
 
+        // Update state of inline display consumer
+        pPlugin->update_display_state(samples);
+
         // First pre-process transport ports
         clear_midi_ports();
         receive_atoms(samples);
@@ -1557,8 +1775,8 @@ namespace lsp
         }
         else
         {
-            lsp_trace("Creating native executor service");
-            ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+            lsp_trace("Creating pool executor service");
+            ipc::PoolExecutor *exec = new ipc::PoolExecutor();
             if (exec == NULL)
                 return NULL;
             status_t res = exec->start();
@@ -2033,6 +2251,7 @@ namespace lsp
         }
 
         // Call plugin for rendering
+        pPlugin->display_drawn();
         if (!pPlugin->inline_display(pCanvas, width, height))
         {
             lsp_trace("failed pPlugin->inline_display");
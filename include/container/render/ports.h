@@ -0,0 +1,429 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONTAINER_RENDER_PORTS_H_
+#define CONTAINER_RENDER_PORTS_H_
+
+namespace lsp
+{
+    class RenderPort: public IPort
+    {
+        protected:
+            RenderWrapper      *pWrapper;
+
+        public:
+            explicit RenderPort(const port_t *meta, RenderWrapper *w): IPort(meta)
+            {
+                pWrapper        = w;
+            }
+
+            virtual ~RenderPort()
+            {
+                pWrapper        = NULL;
+            }
+
+        public:
+            virtual int init()
+            {
+                return STATUS_OK;
+            }
+
+            virtual void destroy()
+            {
+            }
+    };
+
+    class RenderPortGroup: public RenderPort
+    {
+        private:
+            float                   nCurrRow;
+            size_t                  nCols;
+            size_t                  nRows;
+
+        public:
+            explicit RenderPortGroup(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                nCurrRow            = meta->start;
+                nCols               = port_list_size(meta->members);
+                nRows               = list_size(meta->items);
+            }
+
+            virtual ~RenderPortGroup()
+            {
+                nCurrRow            = 0;
+                nCols               = 0;
+                nRows               = 0;
+            }
+
+        public:
+            virtual void setValue(float value)
+            {
+                int32_t v = value;
+                if ((v >= 0) && (v < ssize_t(nRows)))
+                    nCurrRow        = v;
+            }
+
+            virtual float getValue()
+            {
+                return nCurrRow;
+            }
+
+        public:
+            inline size_t rows() const      { return nRows; }
+            inline size_t cols() const      { return nCols; }
+            inline size_t curr_row() const  { return nCurrRow; }
+    };
+
+    class RenderAudioPort: public RenderPort
+    {
+        private:
+            float          *pBuffer;            // Data buffer of the block size
+
+        public:
+            explicit RenderAudioPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                pBuffer     = NULL;
+            }
+
+            virtual ~RenderAudioPort()
+            {
+                pBuffer     = NULL;
+            };
+
+        public:
+            virtual void *getBuffer()
+            {
+                return pBuffer;
+            };
+
+            virtual int init()
+            {
+                pBuffer     = reinterpret_cast<float *>(::malloc(sizeof(float) * pWrapper->block_size()));
+                if (pBuffer == NULL)
+                    return STATUS_NO_MEM;
+
+                dsp::fill_zero(pBuffer, pWrapper->block_size());
+                return STATUS_OK;
+            }
+
+            virtual void destroy()
+            {
+                if (pBuffer != NULL)
+                {
+                    ::free(pBuffer);
+                    pBuffer     = NULL;
+                }
+            }
+
+            /**
+             * Get the data buffer of the port
+             * @return data buffer
+             */
+            inline float *buffer()          { return pBuffer; }
+    };
+
+    class RenderMidiPort: public RenderPort
+    {
+        private:
+            midi_t          sMidi;
+
+        public:
+            explicit RenderMidiPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                sMidi.clear();
+            }
+
+            virtual ~RenderMidiPort()
+            {
+            };
+
+        public:
+            virtual void *getBuffer()
+            {
+                return &sMidi;
+            };
+
+            virtual bool pre_process(size_t samples)
+            {
+                // There is no MIDI source for offline rendering
+                if (IS_IN_PORT(pMetadata))
+                    sMidi.clear();
+                return false;
+            }
+
+            virtual void post_process(size_t samples)
+            {
+                // Just drop all generated MIDI events
+                sMidi.clear();
+            }
+    };
+
+    class RenderControlPort: public RenderPort
+    {
+        private:
+            float       fNewValue;
+            float       fCurrValue;
+
+        public:
+            explicit RenderControlPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                fNewValue   = meta->start;
+                fCurrValue  = meta->start;
+            }
+
+            virtual ~RenderControlPort()
+            {
+                fNewValue   = pMetadata->start;
+                fCurrValue  = pMetadata->start;
+            };
+
+        public:
+            virtual bool pre_process(size_t samples)
+            {
+                if (fNewValue == fCurrValue)
+                    return false;
+
+                fCurrValue   = fNewValue;
+                return true;
+            }
+
+            virtual float getValue()
+            {
+                return fCurrValue;
+            }
+
+            void updateValue(float value)
+            {
+                fNewValue   = limit_value(pMetadata, value);
+            }
+    };
+
+    class RenderMeterPort: public RenderPort
+    {
+        private:
+            float       fValue;
+
+        public:
+            explicit RenderMeterPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                fValue      = meta->start;
+            }
+
+            virtual ~RenderMeterPort()
+            {
+                fValue      = pMetadata->start;
+            };
+
+        public:
+            virtual float getValue()
+            {
+                return fValue;
+            }
+
+            virtual void setValue(float value)
+            {
+                fValue      = limit_value(pMetadata, value);
+            }
+    };
+
+    class RenderMeshPort: public RenderPort
+    {
+        private:
+            mesh_t     *pMesh;
+
+        public:
+            explicit RenderMeshPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                pMesh   = NULL;
+            }
+
+            virtual ~RenderMeshPort()
+            {
+                pMesh   = NULL;
+            }
+
+        public:
+            virtual void *getBuffer()
+            {
+                return pMesh;
+            }
+
+            virtual int init()
+            {
+                pMesh   = mesh_t::create(pMetadata->step, pMetadata->start);
+                return (pMesh == NULL) ? STATUS_NO_MEM : STATUS_OK;
+            }
+
+            virtual void destroy()
+            {
+                if (pMesh != NULL)
+                {
+                    mesh_t::destroy(pMesh);
+                    pMesh   = NULL;
+                }
+            }
+    };
+
+    class RenderStreamPort: public RenderPort
+    {
+        private:
+            stream_t       *pStream;
+
+        public:
+            explicit RenderStreamPort(const port_t *meta, RenderWrapper *w): RenderPort(meta, w)
+            {
+                pStream     = NULL;
+            }
+
+            virtual ~RenderStreamPort()
+            {
+                pStream     = NULL;
+            }
+
+        public:
+            virtual void *getBuffer()
+            {
+                return pStream;
+            }
+
+            virtual int init()
+            {
+                pStream = stream_t::create(pMetadata->min, pMetadata->max, pMetadata->start);
+                return (pStream == NULL) ? STATUS_NO_MEM : STATUS_OK;
+            }
+
+            virtual void destroy()
+            {
+                stream_t::destroy(pStream);
+                pStream     = NULL;
+            }
+    };
+
+    class RenderFrameBufferPort: public RenderPort
+    {
+        private:
+            frame_buffer_t      sFB;
+
+        public:
+            explicit RenderFrameBufferPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+            }
+
+            virtual ~RenderFrameBufferPort()
+            {
+            }
+
+        public:
+            virtual void *getBuffer()
+            {
+                return &sFB;
+            }
+
+            virtual int init()
+            {
+                return sFB.init(pMetadata->start, pMetadata->step);
+            }
+
+            virtual void destroy()
+            {
+                sFB.destroy();
+            }
+    };
+
+    class RenderOscPort: public RenderPort
+    {
+        private:
+            osc_buffer_t     *pFB;
+
+        public:
+            explicit RenderOscPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                pFB     = NULL;
+            }
+
+            virtual ~RenderOscPort()
+            {
+            }
+
+        public:
+            virtual void *getBuffer()
+            {
+                return pFB;
+            }
+
+            virtual int init()
+            {
+                pFB = osc_buffer_t::create(OSC_BUFFER_MAX);
+                return (pFB == NULL) ? STATUS_NO_MEM : STATUS_OK;
+            }
+
+            virtual void destroy()
+            {
+                if (pFB != NULL)
+                {
+                    osc_buffer_t::destroy(pFB);
+                    pFB     = NULL;
+                }
+            }
+    };
+
+    class RenderPathPort: public RenderPort
+    {
+        private:
+            render_path_t   sPath;
+
+        public:
+            explicit RenderPathPort(const port_t *meta, RenderWrapper *w) : RenderPort(meta, w)
+            {
+                sPath.init();
+            }
+
+            virtual ~RenderPathPort()
+            {
+            }
+
+        public:
+            virtual void *getBuffer()
+            {
+                return static_cast<path_t *>(&sPath);
+            }
+
+            virtual bool pre_process(size_t samples)
+            {
+                return sPath.pending();
+            }
+
+            inline void submit(const char *path, size_t flags)
+            {
+                sPath.submit(path, flags);
+            }
+
+            inline bool busy() const
+            {
+                return sPath.busy();
+            }
+    };
+
+}
+
+
+#endif /* CONTAINER_RENDER_PORTS_H_ */
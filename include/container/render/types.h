@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONTAINER_RENDER_TYPES_H_
+#define CONTAINER_RENDER_TYPES_H_
+
+namespace lsp
+{
+    typedef struct render_path_t: public path_t
+    {
+        enum flags_t
+        {
+            F_PENDING       = 1 << 0,
+            F_ACCEPTED      = 1 << 1
+        };
+
+        size_t      nFlags;
+        size_t      nXFlags;
+        char        sPath[PATH_MAX];
+
+        virtual void init()
+        {
+            nFlags          = 0;
+            nXFlags         = 0;
+            sPath[0]        = '\0';
+        }
+
+        virtual const char *get_path()
+        {
+            return sPath;
+        }
+
+        virtual size_t get_flags()
+        {
+            return nXFlags;
+        }
+
+        virtual void accept()
+        {
+            if (nFlags & F_PENDING)
+                nFlags     |= F_ACCEPTED;
+        }
+
+        virtual void commit()
+        {
+            if (nFlags & (F_PENDING | F_ACCEPTED))
+                nFlags      = 0;
+        }
+
+        virtual bool pending()
+        {
+            if (nFlags & F_PENDING)
+                return !(nFlags & F_ACCEPTED);
+            return false;
+        }
+
+        virtual bool accepted()
+        {
+            return nFlags & F_ACCEPTED;
+        }
+
+        /**
+         * Check that the path change request is still being processed by the plugin
+         * @return true if the request is still being processed
+         */
+        inline bool busy() const
+        {
+            return nFlags & (F_PENDING | F_ACCEPTED);
+        }
+
+        /**
+         * Submit new path, the renderer is single-threaded so there is no
+         * need to synchronize the request with the processing thread
+         * @param path path to submit
+         * @param flags path flags
+         */
+        void submit(const char *path, size_t flags)
+        {
+            ::strncpy(sPath, path, PATH_MAX);
+            sPath[PATH_MAX-1]   = '\0';
+            nFlags              = F_PENDING;
+            nXFlags             = flags;
+        }
+
+    } render_path_t;
+}
+
+#endif /* CONTAINER_RENDER_TYPES_H_ */
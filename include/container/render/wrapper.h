@@ -0,0 +1,651 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONTAINER_RENDER_WRAPPER_H_
+#define CONTAINER_RENDER_WRAPPER_H_
+
+#include <core/types.h>
+#include <core/debug.h>
+#include <core/alloc.h>
+#include <core/parse.h>
+#include <core/IWrapper.h>
+#include <core/IPort.h>
+#include <core/plugin.h>
+#include <core/ipc/IExecutor.h>
+#include <core/ipc/Mutex.h>
+#include <core/io/Path.h>
+#include <core/files/config.h>
+
+#include <data/cvector.h>
+
+#define RENDER_DEFAULT_BLOCK_SIZE       1024
+#define RENDER_SETTLE_BLOCKS_MAX        256
+
+namespace lsp
+{
+    class RenderPort;
+    class RenderAudioPort;
+    class RenderPathPort;
+
+    /**
+     * Executor service for offline rendering: the task is executed
+     * immediately in the caller's thread, so all offline work requested
+     * by the plugin completes before the next processed block and the
+     * rendering result does not depend on the thread scheduling.
+     */
+    class RenderExecutor: public ipc::IExecutor
+    {
+        private:
+            size_t          nSubmitted;
+
+        public:
+            explicit RenderExecutor()
+            {
+                nSubmitted      = 0;
+            }
+
+            virtual ~RenderExecutor()
+            {
+            }
+
+        public:
+            virtual bool submit(ipc::ITask *task)
+            {
+                if (!task->idle())
+                    return false;
+
+                change_task_state(task, ipc::ITask::TS_SUBMITTED);
+                ++nSubmitted;
+                run_task(task);
+                return true;
+            }
+
+            virtual void shutdown()
+            {
+            }
+
+            /**
+             * Get overall number of submitted tasks
+             * @return overall number of submitted tasks
+             */
+            inline size_t submitted() const     { return nSubmitted; }
+    };
+
+    class RenderWrapper: public IWrapper
+    {
+        private:
+            RenderExecutor              sExecutor;
+            size_t                      nSampleRate;
+            size_t                      nBlockSize;
+            bool                        bUpdateSettings;
+            bool                        bInitialized;
+
+            position_t                  sPosition;
+
+            cvector<RenderPort>         vPorts;
+            cvector<RenderAudioPort>    vInputs;
+            cvector<RenderAudioPort>    vOutputs;
+            cvector<RenderPathPort>     vPathPorts;
+            cvector<port_t>             vGenMetadata;   // Generated metadata
+
+            KVTStorage                  sKVT;
+            ipc::Mutex                  sKVTMutex;
+
+        public:
+            explicit RenderWrapper(plugin_t *plugin): IWrapper(plugin)
+            {
+                nSampleRate     = 0;
+                nBlockSize      = RENDER_DEFAULT_BLOCK_SIZE;
+                bUpdateSettings = true;
+                bInitialized    = false;
+
+                position_t::init(&sPosition);
+            }
+
+            virtual ~RenderWrapper()
+            {
+                pPlugin         = NULL;
+            }
+
+        protected:
+            void create_port(const port_t *port, const char *postfix);
+            void run(size_t samples);
+            bool offline_busy() const;
+
+        public:
+            virtual ipc::IExecutor *get_executor();
+
+            virtual const position_t *position()
+            {
+                return &sPosition;
+            }
+
+            virtual KVTStorage *kvt_lock();
+
+            virtual KVTStorage *kvt_trylock();
+
+            virtual bool kvt_release();
+
+        public:
+            /**
+             * Initialize wrapper, create ports and activate the plugin
+             * @param sample_rate sample rate of the processed data
+             * @param block_size maximum number of samples processed by the plugin per call
+             * @return status of operation
+             */
+            status_t init(size_t sample_rate, size_t block_size);
+
+            /**
+             * Deactivate the plugin and destroy all ports
+             */
+            void destroy();
+
+            /**
+             * Find port by identifier
+             * @param id port identifier
+             * @return port or NULL if not found
+             */
+            RenderPort *port(const char *id);
+
+            /**
+             * Set value of the input port, the value is parsed the same way as it is
+             * done when importing plugin settings
+             * @param id port identifier
+             * @param value text value of the port
+             * @param base base path for resolving relative file names, may be NULL
+             * @return status of operation
+             */
+            status_t set_value(const char *id, const char *value, const io::Path *base);
+
+            /**
+             * Load port values from the configuration file
+             * @param path path to the configuration file
+             * @return status of operation
+             */
+            status_t load_config(const char *path);
+
+            /**
+             * Feed the plugin with silence until all offline tasks triggered by the
+             * configuration (file loading, etc) are complete
+             * @param max_blocks maximum number of blocks to process
+             * @return true if plugin has settled, false if it is still busy
+             */
+            bool settle(size_t max_blocks = RENDER_SETTLE_BLOCKS_MAX);
+
+            /**
+             * Process audio data
+             * @param dst array of pointers to output buffers, one per audio output,
+             *        NULL pointers (or NULL array) drop the output
+             * @param src array of pointers to input buffers, one per audio input,
+             *        NULL pointers (or NULL array) are treated as silence
+             * @param samples number of samples to process
+             */
+            void process(float * const *dst, const float * const *src, size_t samples);
+
+            inline size_t sample_rate() const       { return nSampleRate;               }
+            inline size_t block_size() const        { return nBlockSize;                }
+            inline size_t audio_inputs() const      { return vInputs.size();            }
+            inline size_t audio_outputs() const     { return vOutputs.size();           }
+            inline ssize_t latency() const          { return pPlugin->get_latency();    }
+    };
+
+    class RenderConfigHandler: public config::IConfigHandler
+    {
+        private:
+            RenderWrapper      *pWrapper;
+            const io::Path     *pBase;
+
+        public:
+            explicit RenderConfigHandler(RenderWrapper *w, const io::Path *base)
+            {
+                pWrapper        = w;
+                pBase           = base;
+            }
+
+        public:
+            virtual status_t handle_parameter(const char *name, const char *value, size_t flags)
+            {
+                status_t res = pWrapper->set_value(name, value, pBase);
+                if (res != STATUS_OK)
+                    lsp_warn("Could not apply configuration parameter %s = %s: %s", name, value, get_status(res));
+                return STATUS_OK;
+            }
+
+            virtual status_t handle_kvt_parameter(const char *name, const kvt_param_t *param, size_t flags)
+            {
+                KVTStorage *kvt = pWrapper->kvt_lock();
+                if (kvt == NULL)
+                    return STATUS_OK;
+
+                kvt->put(name, param, KVT_RX);
+                pWrapper->kvt_release();
+                return STATUS_OK;
+            }
+    };
+}
+
+#include <container/render/types.h>
+#include <container/render/ports.h>
+
+namespace lsp
+{
+    void RenderWrapper::create_port(const port_t *port, const char *postfix)
+    {
+        RenderPort *rp  = NULL;
+
+        switch (port->role)
+        {
+            case R_MESH:
+                rp      = new RenderMeshPort(port, this);
+                break;
+
+            case R_FBUFFER:
+                rp      = new RenderFrameBufferPort(port, this);
+                break;
+
+            case R_STREAM:
+                rp      = new RenderStreamPort(port, this);
+                break;
+
+            case R_MIDI:
+                rp      = new RenderMidiPort(port, this);
+                break;
+
+            case R_AUDIO:
+            {
+                RenderAudioPort *rap = new RenderAudioPort(port, this);
+                if (IS_OUT_PORT(port))
+                    vOutputs.add(rap);
+                else
+                    vInputs.add(rap);
+                rp      = rap;
+                break;
+            }
+
+            case R_OSC:
+                rp      = new RenderOscPort(port, this);
+                break;
+
+            case R_PATH:
+            {
+                RenderPathPort *rpp = new RenderPathPort(port, this);
+                vPathPorts.add(rpp);
+                rp      = rpp;
+                break;
+            }
+
+            case R_CONTROL:
+            case R_BYPASS:
+                rp      = new RenderControlPort(port, this);
+                break;
+
+            case R_METER:
+                rp      = new RenderMeterPort(port, this);
+                break;
+
+            case R_PORT_SET:
+            {
+                char postfix_buf[LSP_MAX_PARAM_ID_BYTES];
+                RenderPortGroup *pg = new RenderPortGroup(port, this);
+                pg->init();
+                vPorts.add(pg);
+                pPlugin->add_port(pg);
+
+                for (size_t row=0; row<pg->rows(); ++row)
+                {
+                    // Generate postfix
+                    snprintf(postfix_buf, sizeof(postfix_buf)-1, "%s_%d", (postfix != NULL) ? postfix : "", int(row));
+
+                    // Clone port metadata
+                    port_t *cm          = clone_port_metadata(port->members, postfix_buf);
+                    if (cm != NULL)
+                    {
+                        vGenMetadata.add(cm);
+
+                        for (; cm->id != NULL; ++cm)
+                        {
+                            if (IS_GROWING_PORT(cm))
+                                cm->start    = cm->min + ((cm->max - cm->min) * row) / float(pg->rows());
+                            else if (IS_LOWERING_PORT(cm))
+                                cm->start    = cm->max - ((cm->max - cm->min) * row) / float(pg->rows());
+
+                            create_port(cm, postfix_buf);
+                        }
+                    }
+                }
+
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (rp != NULL)
+        {
+            if (rp->init() != STATUS_OK)
+                lsp_error("Could not initialize port %s", rp->metadata()->id);
+            vPorts.add(rp);
+            pPlugin->add_port(rp);
+        }
+    }
+
+    status_t RenderWrapper::init(size_t sample_rate, size_t block_size)
+    {
+        if (bInitialized)
+            return STATUS_BAD_STATE;
+        if ((sample_rate <= 0) || (block_size <= 0))
+            return STATUS_BAD_ARGUMENTS;
+
+        nSampleRate             = sample_rate;
+        nBlockSize              = block_size;
+
+        // Create ports
+        for (const port_t *meta = pPlugin->get_metadata()->ports ; meta->id != NULL; ++meta)
+            create_port(meta, NULL);
+
+        // Initialize plugin
+        pPlugin->init(this);
+
+        // Set plugin sample rate and activate it, the transport is stopped
+        // until the actual processing starts
+        sPosition.sampleRate    = sample_rate;
+        sPosition.speed         = 0.0f;
+        pPlugin->set_sample_rate(sample_rate);
+        bUpdateSettings         = true;
+        bInitialized            = true;
+
+        pPlugin->activate();
+
+        return STATUS_OK;
+    }
+
+    void RenderWrapper::destroy()
+    {
+        // Deactivate plugin
+        if ((pPlugin != NULL) && (bInitialized))
+            pPlugin->deactivate();
+        bInitialized    = false;
+
+        // Destroy ports
+        for (size_t i=0; i<vPorts.size(); ++i)
+        {
+            lsp_trace("destroy port id=%s", vPorts[i]->metadata()->id);
+            vPorts[i]->destroy();
+            delete vPorts[i];
+        }
+        vPorts.clear();
+
+        // Cleanup generated metadata
+        for (size_t i=0; i<vGenMetadata.size(); ++i)
+        {
+            lsp_trace("destroy generated port metadata %p", vGenMetadata[i]);
+            drop_port_metadata(vGenMetadata[i]);
+        }
+        vGenMetadata.clear();
+
+        // Clear all other port containers
+        vInputs.clear();
+        vOutputs.clear();
+        vPathPorts.clear();
+
+        // Forget plugin
+        pPlugin = NULL;
+    }
+
+    RenderPort *RenderWrapper::port(const char *id)
+    {
+        for (size_t i=0, n=vPorts.size(); i<n; ++i)
+        {
+            RenderPort *p   = vPorts.at(i);
+            if ((p != NULL) && (!::strcmp(p->metadata()->id, id)))
+                return p;
+        }
+        return NULL;
+    }
+
+    status_t RenderWrapper::set_value(const char *id, const char *value, const io::Path *base)
+    {
+        RenderPort *p   = port(id);
+        if (p == NULL)
+            return STATUS_NOT_FOUND;
+
+        const port_t *meta  = p->metadata();
+        if (!IS_IN_PORT(meta))
+            return STATUS_BAD_TYPE;
+
+        switch (meta->role)
+        {
+            case R_PORT_SET:
+            case R_CONTROL:
+            case R_BYPASS:
+            {
+                float v = 0.0f;
+                bool ok = false;
+
+                if (meta->unit == U_BOOL)
+                {
+                    PARSE_BOOL(value, { v = (__) ? 1.0f : 0.0f; ok = true; });
+                }
+                else if (is_discrete_unit(meta->unit))
+                {
+                    PARSE_INT(value, { v = __; ok = true; });
+                    if ((!ok) && (meta->unit == U_ENUM))
+                        ok = parse_enum(&v, value, meta) == STATUS_OK;
+                }
+                else
+                {
+                    PARSE_FLOAT(value, { v = __; ok = true; });
+                }
+
+                if (!ok)
+                    return STATUS_INVALID_VALUE;
+
+                if (meta->role == R_PORT_SET)
+                    p->setValue(v);
+                else
+                    static_cast<RenderControlPort *>(p)->updateValue(v);
+                break;
+            }
+
+            case R_PATH:
+            {
+                io::Path path;
+                LSPString svalue;
+                if (!svalue.set_utf8(value))
+                    return STATUS_NO_MEM;
+
+                // Resolve relative path against the base path
+                if ((base != NULL) && (svalue.length() > 0) && (!svalue.starts_with_ascii("builtin://")) &&
+                    (path.set(base, &svalue) == STATUS_OK) && (path.canonicalize() == STATUS_OK))
+                    value   = path.as_utf8();
+
+                static_cast<RenderPathPort *>(p)->submit(value, 0);
+                break;
+            }
+
+            default:
+                return STATUS_BAD_TYPE;
+        }
+
+        return STATUS_OK;
+    }
+
+    status_t RenderWrapper::load_config(const char *path)
+    {
+        io::Path cfg, base;
+        status_t res = cfg.set(path);
+        if (res != STATUS_OK)
+            return res;
+
+        // The file may have no parent directory, relative paths are left as is then
+        RenderConfigHandler h(this, (cfg.get_parent(&base) == STATUS_OK) ? &base : NULL);
+        return config::load(&cfg, &h);
+    }
+
+    bool RenderWrapper::offline_busy() const
+    {
+        for (size_t i=0, n=vPathPorts.size(); i<n; ++i)
+        {
+            RenderPathPort *p = vPathPorts.at(i);
+            if ((p != NULL) && (p->busy()))
+                return true;
+        }
+        return false;
+    }
+
+    bool RenderWrapper::settle(size_t max_blocks)
+    {
+        // Feed the silence to inputs
+        for (size_t i=0, n=vInputs.size(); i<n; ++i)
+            dsp::fill_zero(vInputs.at(i)->buffer(), nBlockSize);
+
+        // The plugin applies the result of offline task at least one
+        // block after the submission, so wait for two quiet blocks in a row
+        for (size_t i=0, quiet=0; i<max_blocks; ++i)
+        {
+            size_t submitted    = sExecutor.submitted();
+            run(nBlockSize);
+
+            quiet   = ((sExecutor.submitted() != submitted) || (offline_busy())) ? 0 : quiet + 1;
+            if (quiet >= 2)
+                return true;
+        }
+
+        return false;
+    }
+
+    void RenderWrapper::process(float * const *dst, const float * const *src, size_t samples)
+    {
+        size_t n_in     = vInputs.size();
+        size_t n_out    = vOutputs.size();
+
+        // The transport is rolling while processing the data
+        if (sPosition.speed != 1.0f)
+        {
+            sPosition.speed     = 1.0f;
+            if (pPlugin->set_position(&sPosition))
+                bUpdateSettings     = true;
+        }
+
+        for (size_t off=0; off < samples; )
+        {
+            size_t to_do    = samples - off;
+            if (to_do > nBlockSize)
+                to_do           = nBlockSize;
+
+            // Prepare input data
+            for (size_t i=0; i<n_in; ++i)
+            {
+                float *buf      = vInputs.at(i)->buffer();
+                const float *s  = (src != NULL) ? src[i] : NULL;
+                if (s != NULL)
+                    dsp::sanitize2(buf, &s[off], to_do);
+                else
+                    dsp::fill_zero(buf, to_do);
+            }
+
+            // Process data
+            run(to_do);
+
+            // Store output data
+            for (size_t i=0; i<n_out; ++i)
+            {
+                float *d        = (dst != NULL) ? dst[i] : NULL;
+                if (d != NULL)
+                    dsp::copy(&d[off], vOutputs.at(i)->buffer(), to_do);
+            }
+
+            off            += to_do;
+        }
+    }
+
+    void RenderWrapper::run(size_t samples)
+    {
+        // Prepare ports
+        size_t n_ports      = vPorts.size();
+        RenderPort **v_ports= vPorts.get_array();
+        for (size_t i=0; i<n_ports; ++i)
+        {
+            RenderPort *port = v_ports[i];
+            if ((port != NULL) && (port->pre_process(samples)))
+            {
+                lsp_trace("port changed: %s", port->metadata()->id);
+                bUpdateSettings = true;
+            }
+        }
+
+        // Check that input parameters have changed
+        if (bUpdateSettings)
+        {
+            lsp_trace("updating settings");
+            pPlugin->update_settings();
+            bUpdateSettings = false;
+        }
+
+        // Call the main processing unit
+        pPlugin->process(samples);
+
+        // Post-process ALL ports
+        for (size_t i=0; i<n_ports; ++i)
+        {
+            RenderPort *port = v_ports[i];
+            if (port != NULL)
+                port->post_process(samples);
+        }
+
+        // There is no UI, just drop all pending KVT transfers
+        if (sKVTMutex.try_lock())
+        {
+            sKVT.commit_all(KVT_TX);
+            sKVT.commit_all(KVT_RX);
+            sKVT.gc();
+            sKVTMutex.unlock();
+        }
+
+        // Update position
+        if (sPosition.speed > 0.0f)
+            sPosition.frame    += samples;
+    }
+
+    ipc::IExecutor *RenderWrapper::get_executor()
+    {
+        return &sExecutor;
+    }
+
+    KVTStorage *RenderWrapper::kvt_lock()
+    {
+        return (sKVTMutex.lock()) ? &sKVT : NULL;
+    }
+
+    KVTStorage *RenderWrapper::kvt_trylock()
+    {
+        return (sKVTMutex.try_lock()) ? &sKVT : NULL;
+    }
+
+    bool RenderWrapper::kvt_release()
+    {
+        return sKVTMutex.unlock();
+    }
+}
+
+#endif /* CONTAINER_RENDER_WRAPPER_H_ */
@@ -24,7 +24,7 @@
 
 #include <container/vst/defs.h>
 #include <container/vst/chunk.h>
-#include <core/ipc/NativeExecutor.h>
+#include <core/ipc/PoolExecutor.h>
 
 #ifndef LSP_NO_VST_UI
     #define IF_VST_UI_ON(...)       __VA_ARGS__
@@ -188,8 +188,8 @@ namespace lsp
                 if (pExecutor != NULL)
                     return pExecutor;
 
-                lsp_trace("Creating native executor service");
-                ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+                lsp_trace("Creating pool executor service");
+                ipc::PoolExecutor *exec = new ipc::PoolExecutor();
                 if (exec == NULL)
                     return NULL;
                 if (exec->start() != STATUS_OK)
@@ -67,13 +67,29 @@ namespace lsp
                 bound_box3d_t               bbox;
                 cstorage<rtx_triangle_t>    mesh;
                 cstorage<rtx_edge_t>        plan;
+                ssize_t                     bvh;            // Index of the root node of object's BVH, negative if none
             } rt_object_t;
 
+            typedef struct rt_bvh_node_t
+            {
+                bound_box3d_t               bbox;           // Bounding box of all triangles covered by node
+                size_t                      first;          // Index of the first item in the triangle index
+                size_t                      count;          // Number of triangles covered by node
+                size_t                      size;           // Number of nodes in the subtree including this node
+            } rt_bvh_node_t;
+
+            typedef struct rt_bvh_key_t
+            {
+                float                       key;            // Sort key of the triangle
+                size_t                      index;          // Index of the triangle in object's mesh
+            } rt_bvh_key_t;
+
             typedef struct stats_t
             {
                 uint64_t            root_tasks;
                 uint64_t            local_tasks;
                 uint64_t            calls_scan;
+                uint64_t            calls_bvh;
                 uint64_t            calls_cull;
                 uint64_t            calls_split;
                 uint64_t            calls_cullback;
@@ -81,6 +97,34 @@ namespace lsp
                 uint64_t            calls_capture;
             } stats_t;
 
+            typedef struct rt_hit_t
+            {
+                const rt_path_t            *path;           // Path of the captured view
+                size_t                      capture;        // Capture identifier
+                ssize_t                     rnum;           // Reflection number
+                size_t                      first;          // First sample affected by the view
+                size_t                      count;          // Number of samples affected by the view
+                size_t                      offset;         // Offset of the sample data in the kernel storage
+            } rt_hit_t;
+
+            typedef struct rt_path_cache_t
+            {
+                cstorage<rt_hit_t>          hits;           // Captured views
+                cstorage<float>             kernel;         // Sample data of captured views
+                cvector<rt_path_t>          chunks;         // Chunks of path items
+                size_t                      left;           // Number of free path items in the last chunk
+            } rt_path_cache_t;
+
+            class TaskThread;
+
+            typedef struct rt_merge_t
+            {
+                RayTrace3D                 *trace;          // Ray tracing object
+                cvector<TaskThread>        *threads;        // Threads that hold the captured data
+                size_t                      index;          // Index of the first tile
+                size_t                      step;           // Step between tiles
+            } rt_merge_t;
+
         protected:
             class TaskThread: public ipc::Thread
             {
@@ -89,23 +133,31 @@ namespace lsp
                     stats_t                 stats;
                     cvector<rt_context_t>   tasks;
                     cvector<rt_binding_t>   bindings;       // Bindings
-                    cvector<rt_object_t>    objects;
                     ssize_t                 heavy_state;
+                    cstorage<size_t>        visible;        // Indexes of triangles that passed the BVH test
+                    cstorage<size_t>        marks;          // Marks of scene edges added to the context
+                    size_t                  mark;           // Current mark
+                    rt_path_cache_t        *cache;          // Path cache, NULL if paths are not tracked
+                    size_t                  cache_used;     // Memory used by the path cache
+                    size_t                  cache_reserved; // Memory reserved for the path cache from the overall limit
 
                 protected:
                     status_t    main_loop();
                     status_t    process_context(rt_context_t *ctx);
 
-                    status_t    copy_objects(cvector<rt_object_t> *src);
+                    status_t    prepare_marks();
+                    status_t    prepare_cache();
+                    bool        reserve_cache(size_t bytes);
+                    const rt_path_t    *add_path(const rt_path_t *parent, const rt_triangle_t *t, size_t flags);
                     status_t    scan_objects(rt_context_t *ctx);
                     status_t    cull_view(rt_context_t *ctx);
                     status_t    split_view(rt_context_t *ctx);
                     status_t    cullback_view(rt_context_t *ctx);
                     status_t    reflect_view(rt_context_t *ctx);
                 #ifdef LSP_RT_TRACE
-                    status_t    capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, View3D *trace);
+                    status_t    capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, rt_hit_t *hit, View3D *trace);
                 #else
-                    status_t    capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v);
+                    status_t    capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, rt_hit_t *hit);
                 #endif
 
                     status_t    generate_root_mesh();
@@ -113,6 +165,7 @@ namespace lsp
                     status_t    generate_object_mesh(ssize_t id, rt_object_t *o, rt_mesh_t *src, Object3D *obj, const matrix3d_t *m);
                     status_t    generate_tasks(cvector<rt_context_t> *tasks, float initial);
                     status_t    check_object(rt_context_t *ctx, Object3D *obj, const matrix3d_t *m);
+                    status_t    scan_bvh(rt_context_t *ctx, rt_object_t *obj);
 
                     status_t    submit_task(rt_context_t *ctx);
 
@@ -123,19 +176,36 @@ namespace lsp
                 public:
                     status_t    prepare_main_loop(float initial);
                     status_t    prepare_captures();
-                    status_t    prepare_supplementary_loop(TaskThread *t);
+                    status_t    prepare_supplementary_loop();
 
                     virtual status_t run();
 
-                    status_t    merge_result();
-
                     inline stats_t *get_stats() { return &stats; }
+
+                    inline cvector<rt_binding_t> *get_bindings() { return &bindings; }
+
+                    inline rt_path_cache_t *release_cache()
+                    {
+                        rt_path_cache_t *res = cache;
+                        cache   = NULL;
+                        return res;
+                    }
             };
 
         private:
             cstorage<rt_material_t>     vMaterials;
             cstorage<rt_source_settings_t>    vSources;
             cvector<capture_t>          vCaptures;
+            cstorage<rt_bvh_node_t>     vBVH;           // Bounding volume hierarchies of objects, shared by all threads
+            cstorage<size_t>            vBVHIndex;      // Triangle indexes referenced by BVH nodes
+            cvector<rt_object_t>        vObjects;       // Snapshot of scene objects, shared by all threads
+            cvector<rt_path_cache_t>    vPathCache;     // Captured views of the last process() call
+            cstorage<rt_material_t>     vPathMaterials; // Materials used by the last process() call
+            bool                        bBVH;           // Use bounding volume hierarchies for large objects
+            bool                        bPathCache;     // Track paths of views
+            size_t                      nPathLimit;     // Maximum memory used by the path cache
+            size_t                      nPathUsed;      // Memory reserved by threads for the path cache
+            bool                        bPathOverflow;  // The path cache has exceeded the memory limit
             Scene3D                    *pScene;
             rt_progress_t               pProgress;
             void                       *pProgressData;
@@ -161,8 +231,19 @@ namespace lsp
             static void clear_stats(stats_t *stats);
             static void dump_stats(const char *label, const stats_t *stats);
             static void merge_stats(stats_t *dst, const stats_t *src);
+            static status_t merge_tiles(void *arg);
+            static status_t deposit(cstorage<sample_t> *bindings, ssize_t rnum, size_t index, float amplitude);
+            static float    path_factor(const rt_material_t *m, size_t flags);
+            static void     destroy_path_cache(rt_path_cache_t *cache);
+            static size_t   path_cache_size(const rt_path_cache_t *cache);
+            size_t          captured_size() const;
+            bool            reserve_path_cache(size_t bytes);
 
             static bool check_bound_box(const bound_box3d_t *bbox, const rt_view_t *view);
+            static bool check_bvh_node(const bound_box3d_t *bbox, const rt_view_t *view);
+            static int bvh_cmp_key(const void *a, const void *b);
+            static ssize_t build_bvh(cstorage<rt_bvh_node_t> *bvh, size_t *index, rt_bvh_key_t *keys,
+                    const rtx_triangle_t *mesh, size_t first, size_t count);
 
             void        remove_scene(bool destroy);
             status_t    resize_materials(size_t objects);
@@ -174,6 +255,7 @@ namespace lsp
             bool        is_already_passed(const sample_t *bind);
 
             status_t    do_process(size_t threads, float initial);
+            status_t    merge_results(cvector<TaskThread> *threads, size_t workers);
 
         public:
             /** Default constructor
@@ -327,6 +409,84 @@ namespace lsp
              * @return status of operation
              */
             status_t            process(size_t threads, float initial);
+
+            /**
+             * Enable scanning of large objects using bounding volume hierarchies.
+             * When disabled, process() tests all triangles of each object against
+             * the view, the result of processing remains the same
+             * @param enable enable flag
+             */
+            inline void         set_bvh(bool enable) { bBVH = enable; }
+
+            /**
+             * Check that scanning of large objects using bounding volume hierarchies is enabled
+             * @return true if bounding volume hierarchies are used
+             */
+            inline bool         get_bvh() const { return bBVH; }
+
+            /**
+             * Enable tracking of the view paths. When enabled, process() stores each captured
+             * view together with interactions of the view with materials, so the captured
+             * data can be re-computed by reweight() for other absorption and transparency
+             * of materials without tracing.
+             * @param enable enable flag
+             */
+            inline void         set_path_cache(bool enable) { bPathCache = enable; }
+
+            /**
+             * Check that tracking of view paths is enabled
+             * @return true if tracking of view paths is enabled
+             */
+            inline bool         get_path_cache() const { return bPathCache; }
+
+            /**
+             * Set the maximum amount of memory used for tracking of view paths. When
+             * process() exceeds the limit, it stops tracking and drops all captured views.
+             * Captured views are also dropped after process() if they take more than 1024 times
+             * the memory of the captured sample data
+             * @param bytes maximum amount of memory in bytes
+             */
+            inline void         set_path_cache_limit(size_t bytes) { nPathLimit = bytes; }
+
+            /**
+             * Get the maximum amount of memory used for tracking of view paths
+             * @return maximum amount of memory in bytes
+             */
+            inline size_t       get_path_cache_limit() const { return nPathLimit; }
+
+            /**
+             * Check that the last call of process() has stored captured views
+             * @return true if captured views are available for reweight()
+             */
+            inline bool         has_path_cache() const { return vPathCache.size() > 0; }
+
+            /**
+             * Drop the captured views of the last process() call
+             */
+            void                clear_path_cache();
+
+            /**
+             * Check that reweight() can be used for current absorption and transparency of
+             * materials. Views that have been dropped by process() because of the energy
+             * threshold are not restored, so re-weighting is allowed only when new values
+             * do not make any interaction of a view with a surface louder: absorption may
+             * only grow, transparency may only go down for refracted views and only up for
+             * reflected views. Any other edit (geometry, diffusion, dispersion, permeability,
+             * sources, captures, bindings, sample rate or energy threshold) changes the traced
+             * views and requires process() to be called
+             * @return true if captured views are available and can be re-weighted
+             */
+            bool                can_reweight() const;
+
+            /**
+             * Re-compute the data of bound samples from the captured views of the last
+             * process() call using current absorption and transparency of materials, non-RT-safe.
+             * Other properties of materials, scene, sources and captures should remain the same.
+             * The result differs from the one of process() only by the views that fall below
+             * the energy threshold with new materials and are not dropped by re-weighting.
+             * @return status of operation, STATUS_BAD_STATE if can_reweight() returns false
+             */
+            status_t            reweight();
     };
 
 } /* namespace lsp */
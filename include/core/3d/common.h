@@ -211,6 +211,19 @@ namespace lsp
         __IF_32(uint32_t    __pad[3];)  // Alignment to be sizeof() multiple of 16
     } rt_view_t;
 
+    enum rt_path_flags_t
+    {
+        RT_PF_INSIDE        = 1 << 0,   // The interaction happened inside of the object
+        RT_PF_REFRACT       = 1 << 1    // The view has passed through the surface
+    };
+
+    typedef struct rt_path_t
+    {
+        const rt_path_t    *parent;     // Previous interaction, NULL if the view has been emitted by the source
+        uint32_t            material;   // Index of material of the surface
+        uint32_t            flags;      // Interaction flags
+    } rt_path_t;
+
 #if 1
     typedef struct rtm_vertex_t: public point3d_t
     {
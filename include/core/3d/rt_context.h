@@ -64,6 +64,7 @@ namespace lsp
         public:
             rt_view_t                   view;       // Ray tracing point of view
             rt_context_state_t          state;      // Context state
+            const rt_path_t            *path;       // Interactions of the view with surfaces, NULL if not tracked
 
             rt_plan_t                   plan;       // Split plan
             Allocator3D<rt_triangle_t>  triangle;   // Triangle for raytracint
@@ -157,14 +158,19 @@ namespace lsp
             status_t        add_opaque_object(const rt_triangle_t *vt, size_t n);
 
             /**
-             * Add object for capturing data.
+             * Add object for capturing data. The object may be shared between several
+             * contexts, so it is not modified. Instead, the itag field of each edge
+             * should contain the unique index of the edge, and the edge is added to the
+             * plan only if marks[itag] differs from mark. After that the mark is stored
+             * in the marks array.
+             *
              * @param vt array of raw triangles
-             * @param ve array of edges that should be added to plan
              * @param nt number of raw triangles
-             * @param ne number of edges that should be added to plan
+             * @param marks array of edge marks indexed by itag field of the edge
+             * @param mark the mark of the current object
              * @return status of operation
              */
-            status_t        add_object(rtx_triangle_t *vt, rtx_edge_t *ve, size_t nt, size_t ne);
+            status_t        add_object(const rtx_triangle_t *vt, size_t nt, size_t *marks, size_t mark);
 
             /**
              * Cull view with the view planes
@@ -81,6 +81,16 @@ namespace lsp
         };
     } kvt_param_t;
 
+    /**
+     * Single entry of the batch update, @see KVTStorage::put_batch()
+     */
+    typedef struct kvt_entry_t
+    {
+        const char     *name;           // Parameter name relative to the base branch
+        kvt_param_t     value;          // Parameter value
+        size_t          flags;          // Operation flags @see kvt_flags_t
+    } kvt_entry_t;
+
     class KVTStorage;
 
     class KVTListener
@@ -223,6 +233,18 @@ namespace lsp
                 size_t              capacity;       // Capacity in children
             } kvt_node_t;
 
+            typedef struct kvt_chunk_t
+            {
+                kvt_chunk_t        *next;           // Next allocated chunk
+            } kvt_chunk_t;
+
+            typedef struct kvt_pool_t
+            {
+                kvt_chunk_t        *chunks;         // List of allocated chunks
+                void               *free;           // List of free items
+                size_t              size;           // Size of each item in bytes
+            } kvt_pool_t;
+
         protected:
             cvector<KVTListener>    vListeners;
 
@@ -239,6 +261,9 @@ namespace lsp
             size_t                  nTxPending;
             size_t                  nRxPending;
 
+            kvt_pool_t              sNodePool;      // Pool of nodes with short identifiers
+            kvt_pool_t              sParamPool;     // Pool of parameters
+
         protected:
             inline void             notify_created(const char *id, const kvt_param_t *param, size_t pending);
             inline void             notify_rejected(const char *id, const kvt_param_t *rej, const kvt_param_t *curr, size_t pending);
@@ -249,6 +274,11 @@ namespace lsp
             inline void             notify_missed(const char *id);
 
         protected:
+            static void             init_pool(kvt_pool_t *pool, size_t size);
+            static void            *pool_alloc(kvt_pool_t *pool);
+            static void             pool_free(kvt_pool_t *pool, void *item);
+            static void             destroy_pool(kvt_pool_t *pool);
+
             inline static void      link_list(kvt_link_t *root, kvt_link_t *item);
             inline static void      unlink_list(kvt_link_t *item);
 
@@ -268,6 +298,7 @@ namespace lsp
             void                    destroy_node(kvt_node_t *node);
             kvt_node_t             *get_node(kvt_node_t *base, const char *name, size_t len);
             status_t                walk_node(kvt_node_t **out, const char *name);
+            status_t                put_node(kvt_node_t *base, const char *path, const char *name, const kvt_param_t *value, size_t flags);
 
             status_t                do_remove_node(const char *name, kvt_node_t *node, const kvt_param_t **value, kvt_param_type_t type);
             status_t                do_touch(const char *name, kvt_node_t *node, size_t flags);
@@ -275,6 +306,7 @@ namespace lsp
             status_t                do_remove_branch(const char *name, kvt_node_t *node);
 
             static inline bool      validate_type(size_t type) { return (type >= KVT_INT32) && (type <= KVT_BLOB); }
+            bool                    validate_path(const char *path) const;
 
         public:
             explicit KVTStorage(char separator = '/');
@@ -340,6 +372,19 @@ namespace lsp
             status_t    put(const char *name, const kvt_blob_t *value, size_t flags = 0);
             status_t    put(const char *name, size_t size, const char *type, const void *value, size_t flags = 0);
 
+            /**
+             * Put the batch of parameters that belong to the same branch. The names and types
+             * of all entries are validated before the storage gets modified and the base branch
+             * is looked up only once
+             * @param base the base branch name
+             * @param entries list of entries with names relative to the base branch
+             * @param count number of entries
+             * @return status of operation:
+             *          STATUS_OK               if all parameters have been stored or rejected because of KVT_KEEP flag
+             *          other error             otherwise
+             */
+            status_t    put_batch(const char *base, const kvt_entry_t *entries, size_t count);
+
             /**
              * Fetch parameter from the storage
              * @param name parameter name
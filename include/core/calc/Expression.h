@@ -36,6 +36,7 @@ namespace lsp
     namespace calc
     {
         struct expr_t;
+        struct slot_t;
         class Tokenizer;
         
         class Expression
@@ -62,9 +63,12 @@ namespace lsp
                 Resolver           *pResolver;
                 cstorage<root_t>    vRoots;
                 cvector<LSPString>  vDependencies;
+                slot_t             *vSlots;
+                size_t              nSlots;
 
             protected:
                 void                destroy_all_data();
+                void                destroy_slots();
                 status_t            prepend_string(expr_t **expr, const LSPString *str, bool force);
                 status_t            parse_substitution(expr_t **expr, Tokenizer *t);
                 status_t            parse_regular(io::IInSequence *seq, size_t flags);
@@ -72,6 +76,8 @@ namespace lsp
                 status_t            post_process();
                 status_t            scan_dependencies(expr_t *expr);
                 status_t            add_dependency(const LSPString *str);
+                status_t            compile_slots();
+                status_t            scan_slots(expr_t *expr, cvector<LSPString> *names, cvector<expr_t> *refs);
 
             public:
                 explicit Expression();
@@ -180,6 +186,49 @@ namespace lsp
                  */
                 bool            has_dependency(const char *str) const;
 
+                /**
+                 * Get number of slots. Each slot corresponds to the variable that is referenced
+                 * without indexes and can be pre-bound to the value to omit resolving it by name
+                 * @return number of slots
+                 */
+                inline size_t   slots() const { return nSlots; }
+
+                /**
+                 * Get name of the variable associated with the slot
+                 * @param idx slot index
+                 * @return variable name or NULL
+                 */
+                const LSPString *slot_name(size_t idx) const;
+
+                /**
+                 * Bind value to the slot. After binding, the value of slot is used by evaluation
+                 * instead of resolving the variable
+                 * @param idx slot index
+                 * @param value value to bind
+                 * @return status of operation
+                 */
+                status_t        bind(size_t idx, const value_t *value);
+
+                /**
+                 * Bind floating-point value to the slot
+                 * @param idx slot index
+                 * @param value value to bind
+                 * @return status of operation
+                 */
+                status_t        bind_float(size_t idx, double value);
+
+                /**
+                 * Unbind slot, the variable will be resolved again by the resolver
+                 * @param idx slot index
+                 * @return status of operation
+                 */
+                status_t        unbind(size_t idx);
+
+                /**
+                 * Unbind all slots
+                 */
+                void            unbind_all();
+
         };
     
     } /* namespace calc */
@@ -38,6 +38,13 @@ namespace lsp
             ET_VALUE
         };
 
+        typedef struct slot_t
+        {
+            const LSPString    *name;       // Name of the variable
+            value_t             value;      // Value bound to the variable
+            bool                bound;      // Value is bound and should be used instead of resolving
+        } slot_t;
+
         typedef struct expr_t
         {
             evaluator_t     eval;       // Evaluation routine
@@ -56,6 +63,7 @@ namespace lsp
                     LSPString  *name;       // Base name of variable
                     size_t      count;      // Number of additional indexes
                     expr_t    **items;      // List of additional indexes
+                    slot_t     *slot;       // Pre-bound slot for variable without indexes, may be NULL
                 } resolve;
 
                 value_t     value;          // Value
@@ -23,6 +23,7 @@
 #define CORE_DYNAMICS_COMPRESSOR_H_
 
 #include <core/types.h>
+#include <dsp/dsp.h>
 #include <core/IStateDumper.h>
 
 namespace lsp
@@ -68,6 +69,7 @@ namespace lsp
             float       fBKE;           // Boost knee end
             float       vBHermite[3];   // Boost hermite interpolation
             float       fBoost;         // Overall gain boost
+            dsp::dyn_knee_t vKnees[2];  // Gain curve knees for vector processing
 
             // Additional parameters
             size_t      nSampleRate;
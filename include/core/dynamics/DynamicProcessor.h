@@ -23,6 +23,7 @@
 #define CORE_DYNAMICS_DYNAMICPROCESSOR_H_
 
 #include <core/types.h>
+#include <dsp/dsp.h>
 #include <core/IStateDumper.h>
 
 namespace lsp
@@ -81,6 +82,7 @@ namespace lsp
 
             // Processing parameters
             spline_t    vSplines[DYNAMIC_PROCESSOR_DOTS];
+            dsp::dyn_knee_t vKnees[DYNAMIC_PROCESSOR_DOTS];    // Knees of splines for vector processing
             reaction_t  vAttack[DYNAMIC_PROCESSOR_RANGES];
             reaction_t  vRelease[DYNAMIC_PROCESSOR_RANGES];
             uint8_t     fCount[CT_TOTAL];  // Number of elements for AttackLvl, ReleaseLvl, ... etc
@@ -99,6 +101,7 @@ namespace lsp
             void                    sort_reactions(reaction_t *s, size_t count);
             void                    sort_splines(spline_t *s, size_t count);
             static inline float     solve_reaction(const reaction_t *s, float x, size_t count);
+            void                    splines_gain(float *dst, float *tmp, const float *x, size_t count);
 
         public:
             explicit DynamicProcessor();
@@ -23,6 +23,7 @@
 #define CORE_DYNAMICS_EXPANDER_H_
 
 #include <core/types.h>
+#include <dsp/dsp.h>
 #include <core/IStateDumper.h>
 
 namespace lsp
@@ -55,6 +56,7 @@ namespace lsp
             float       fLogKS;         // Knee start
             float       fLogKE;         // Knee end
             float       fLogTH;         // Logarithmic threshold
+            dsp::dyn_knee_t sKnee;      // Gain curve knee for vector processing
 
             // Additional parameters
             size_t      nSampleRate;
@@ -23,6 +23,7 @@
 #define CORE_DYNAMICS_GATE_H_
 
 #include <core/types.h>
+#include <dsp/dsp.h>
 #include <core/IStateDumper.h>
 
 namespace lsp
@@ -42,6 +43,7 @@ namespace lsp
                 float       fLogZS;
                 float       fLogZE;
                 float       vHermite[4];
+                dsp::dyn_knee_t sKnee;      // Gain curve knee for vector processing
             } curve_t;
 
         protected:
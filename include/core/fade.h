@@ -43,6 +43,18 @@ namespace lsp
      * @param buf_len length of the buffer
      */
     void fade_out(float *dst, const float *src, size_t fade_len, size_t buf_len);
+
+    /** Fade-out of the part of the signal (with range check), the result is the same
+     * as if the fade-out was applied to the whole signal
+     *
+     * @param dst destination buffer
+     * @param src source buffer
+     * @param fade_len length of fade (in elements)
+     * @param offset offset of the part in the signal
+     * @param count length of the part
+     * @param sig_len overall length of the signal
+     */
+    void fade_out(float *dst, const float *src, size_t fade_len, size_t offset, size_t count, size_t sig_len);
 }
 
 #endif /* CORE_FADE_H_ */
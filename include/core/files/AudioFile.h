@@ -50,6 +50,25 @@ namespace lsp
                 float      *vChannels[];    // Pointer to deploy samples to channels
             } temporary_buffer_t;
 
+            typedef struct resampler_t
+            {
+                const float    *vKernels;       // Lanczos kernels, one per phase
+                const float    *vSrc;           // Source channel data
+                float          *vBuf;           // Accumulation buffer
+                size_t          nSrcStep;       // Number of source samples in block (number of phases)
+                size_t          nDstStep;       // Number of destination samples in block
+                size_t          nKSize;         // Size of each kernel
+                size_t          nSamples;       // Number of source samples
+                float           fKf;            // Resampling factor
+            } resampler_t;
+
+            typedef struct resample_task_t
+            {
+                const resampler_t  *pResampler; // Resampler
+                size_t              nFirst;     // Index of first block to process
+                size_t              nLast;      // Index of last block to process (exclusive)
+            } resample_task_t;
+
             file_content_t *pData;
 
         private:
@@ -69,8 +88,20 @@ namespace lsp
             status_t fast_upsample(size_t new_sample_rate);
             status_t complex_upsample(size_t new_sample_rate);
             status_t complex_downsample(size_t new_sample_rate);
+            status_t lanczos_resample(size_t new_sample_rate, ssize_t k_periods, ssize_t k_center, ssize_t k_size);
+
+            static void resample_blocks(const resampler_t *r, size_t first, size_t last);
+            static status_t resample_task(void *arg);
+            static void resample_parallel(resample_task_t *tasks, size_t count);
 
             status_t load_lspc(const LSPString *path, float max_duration);
+            status_t store_lspc(const LSPString *path);
+            status_t load_resample_cache(const LSPString *path, size_t sample_rate);
+
+            static uint64_t content_checksum(const file_content_t *content);
+            static status_t resample_cache_dir(io::Path *dst);
+            static status_t resample_cache_path(io::Path *dst, const LSPString *path, size_t sample_rate, float max_duration);
+            static void trim_resample_cache(const io::Path *entry);
 
         #ifdef PLATFORM_WINDOWS
             status_t load_mfapi(const LSPString *path, float max_duration);
@@ -137,6 +168,36 @@ namespace lsp
              */
             status_t load(const io::Path *path, float max_duration = -1);
 
+            /** Load file and resample it to the desired sample rate. The resampled data
+             * is stored in the cache and reused while the original file is not modified
+             *
+             * @param path path to the file
+             * @param sample_rate desired sample rate
+             * @param max_duration maximum duration of the file to load (in seconds)
+             * @return status of operation
+             */
+            status_t load_resampled(const char *path, size_t sample_rate, float max_duration = -1);
+
+            /** Load file and resample it to the desired sample rate. The resampled data
+             * is stored in the cache and reused while the original file is not modified
+             *
+             * @param path path to the file
+             * @param sample_rate desired sample rate
+             * @param max_duration maximum duration of the file to load (in seconds)
+             * @return status of operation
+             */
+            status_t load_resampled(const LSPString *path, size_t sample_rate, float max_duration = -1);
+
+            /** Load file and resample it to the desired sample rate. The resampled data
+             * is stored in the cache and reused while the original file is not modified
+             *
+             * @param path path to the file
+             * @param sample_rate desired sample rate
+             * @param max_duration maximum duration of the file to load (in seconds)
+             * @return status of operation
+             */
+            status_t load_resampled(const io::Path *path, size_t sample_rate, float max_duration = -1);
+
             /** Save file
              *
              * @param path path to the file
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_FILES_AUDIOSTREAM_H_
+#define CORE_FILES_AUDIOSTREAM_H_
+
+#include <core/types.h>
+#include <core/status.h>
+#include <core/LSPString.h>
+#include <core/io/Path.h>
+
+namespace lsp
+{
+    /**
+     * Random-access reader of the audio file that does not load the whole
+     * file contents into memory. Samples are decoded on demand at the
+     * requested position. The stream is not thread-safe: all reads should be
+     * performed by one thread at a time.
+     */
+    class AudioStream
+    {
+        private:
+            AudioStream & operator = (const AudioStream &);     // Deny copying
+
+        protected:
+            void           *hHandle;        // Native handle of the opened file
+            size_t          nChannels;      // Number of channels
+            size_t          nSamples;       // Number of samples per channel
+            size_t          nSampleRate;    // Sample rate
+            size_t          nOffset;        // Current read position in samples
+
+        public:
+            explicit AudioStream();
+            virtual ~AudioStream();
+
+        public:
+            /** Open audio file for streaming
+             *
+             * @param path path to the file
+             * @return status of operation
+             */
+            status_t open(const char *path);
+
+            /** Open audio file for streaming
+             *
+             * @param path path to the file
+             * @return status of operation
+             */
+            status_t open(const io::Path *path);
+
+            /** Open audio file for streaming
+             *
+             * @param path path to the file
+             * @return status of operation
+             */
+            virtual status_t open(const LSPString *path);
+
+            /** Close the stream
+             *
+             * @return status of operation
+             */
+            virtual status_t close();
+
+            /** Read interleaved frames
+             *
+             * @param dst destination buffer to store frames * channels() samples
+             * @param offset offset of the first frame to read
+             * @param frames number of frames to read
+             * @return number of frames read, zero at the end of file, negative error code on error
+             */
+            virtual ssize_t read_frames(float *dst, size_t offset, size_t frames);
+
+            /** Return number of channels
+             *
+             * @return number of channels
+             */
+            inline size_t channels() const          { return nChannels;     }
+
+            /** Return number of samples per channel
+             *
+             * @return number of samples per channel
+             */
+            inline size_t samples() const           { return nSamples;      }
+
+            /** Return sample rate of the file
+             *
+             * @return sample rate
+             */
+            inline size_t sample_rate() const       { return nSampleRate;   }
+    };
+
+} /* namespace lsp */
+
+#endif /* CORE_FILES_AUDIOSTREAM_H_ */
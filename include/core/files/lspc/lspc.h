@@ -94,12 +94,24 @@ namespace lsp
         uint32_t        reserved[6];    // Some reserved data for future use
     } lspc_chunk_audio_profile_t;
 
+    typedef struct lspc_chunk_resample_t // Magic number: 'RSMP'
+    {
+        lspc_header_t   common;         // Common header data
+        uint16_t        pad;            // Padding (reserved)
+        uint32_t        channels;       // Number of channels of the resampled data
+        uint32_t        sample_rate;    // Sample rate of the resampled data
+        uint64_t        frames;         // Number of frames of the resampled data
+        uint64_t        checksum;       // FNV-1a checksum of the resampled data
+        uint32_t        reserved[4];    // Some reserved data for future use
+    } lspc_chunk_resample_t;
+
 #pragma pack(pop)
 
 // Different chunk types
 #define LSPC_ROOT_MAGIC             0x4C535043
 #define LSPC_CHUNK_AUDIO            0x41554449
 #define LSPC_CHUNK_PROFILE          0x50524F46
+#define LSPC_CHUNK_RESAMPLE         0x52534D50
 
 // Chunk flags
 #define LSPC_CHUNK_FLAG_LAST        (1 << 0)
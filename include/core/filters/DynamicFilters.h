@@ -42,6 +42,7 @@ namespace lsp
             {
                 filter_params_t     sParams;                // Filter parameters
                 bool                bActive;                // Filter activity
+                bool                bPrecise;               // Double-precision processing
             } filter_t;
 
             union biquad_bank_t
@@ -51,6 +52,7 @@ namespace lsp
                 biquad_x2_t        *x2;
                 biquad_x4_t        *x4;
                 biquad_x8_t        *x8;
+                biquad_dx1_t       *dx1;
             };
 
             static const f_cascade_t    sNormal;
@@ -59,9 +61,11 @@ namespace lsp
             filter_t           *vFilters;           // Array of filters
             f_cascade_t        *vCascades;          // Analog filter cascade bank
             float              *vMemory;            // Filter memory
+            double             *vMemoryD;           // Double-precision filter memory
             biquad_bank_t       vBiquads;           // Biquad bank
             size_t              nFilters;           // Number of filters
             size_t              nSampleRate;        // Sample rate
+            size_t              nMaxCascades;       // Maximum number of cascades generated at once
             void               *pData;              // Aligned pointer data
             bool                bClearMem;          // Clear memory
 
@@ -133,6 +137,29 @@ namespace lsp
                 return true;
             }
 
+            /** Check that filter is processed with double precision
+             *
+             * @param id ID of filter
+             * @return true if filter is processed with double precision
+             */
+            inline bool         filter_precise(size_t id) const { return (id < nFilters) ? vFilters[id].bPrecise : false; };
+
+            /** Enable double-precision processing of the specific filter. Double precision
+             * keeps low-frequency filters at high sample rates stable. It applies to filters
+             * with bilinear transform only, the cascades are processed one by one
+             *
+             * @param id filter identifier
+             * @param precise double-precision processing flag
+             * @return true on success
+             */
+            bool                set_filter_precise(size_t id, bool precise);
+
+            /** Enable or disable double-precision processing of all filters
+             *
+             * @param precise double-precision processing flag
+             */
+            void                set_precise(bool precise);
+
             /** Update filter parameters
              * @param id ID of the filter
              * @param params  filter parameters
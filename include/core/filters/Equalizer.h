@@ -61,12 +61,15 @@ namespace lsp
             size_t              nFirRank;           // FFT rank
             size_t              nLatency;           // Equalizer latency
             size_t              nBufSize;           // Buffer size
+            size_t              nFdlHead;           // Position of the last input spectrum in frequency-domain delay line
             equalizer_mode_t    nMode;              // Equalizer mode
+            bool                bLowLatency;        // Partitioned convolution in FIR and FFT modes
 
             float              *vInBuffer;          // Input buffer data
             float              *vOutBuffer;         // Output buffer data
             float              *vConv;              // Convolution data
             float              *vFft;               // FFT transform data buffer (real + imaginary)
+            float              *vFdl;               // Frequency-domain delay line of input spectrums
             float              *vTemp;              // Temporary buffer for miscellaneous calculations
 
             size_t              nFlags;             // Flag that identifies that equalizer has to be rebuilt
@@ -74,6 +77,8 @@ namespace lsp
 
         protected:
             void                reconfigure();
+            inline bool         partitioned() const;
+            void                process_partition();
 
         public:
             explicit Equalizer();
@@ -144,6 +149,32 @@ namespace lsp
              */
             inline equalizer_mode_t get_mode() const { return nMode; }
 
+            /** Enable low-latency processing in FIR and FFT modes: the head of the impulse
+             * response is applied by direct convolution and the rest by small FFT partitions,
+             * so only the delay of the linear-phase impulse response remains as latency
+             *
+             * @param enable enable flag
+             */
+            void                set_low_latency(bool enable);
+
+            /** Check that low-latency processing is enabled
+             *
+             * @return true if low-latency processing is enabled
+             */
+            inline bool         low_latency() const { return bLowLatency; }
+
+            /** Enable double-precision processing of IIR filters
+             *
+             * @param precise double-precision processing flag
+             */
+            inline void         set_precise(bool precise) { sBank.set_precise(precise); }
+
+            /** Check that double-precision processing of IIR filters is enabled
+             *
+             * @return true if double-precision processing is enabled
+             */
+            inline bool         precise() const { return sBank.precise(); }
+
             /** Get equalizer latency
              *
              * @return equalizer latency
@@ -202,6 +233,21 @@ namespace lsp
              */
             void                process(float *out, const float *in, size_t samples);
 
+            /** Process the signal of two channels. If both equalizers are in IIR mode,
+             * the filters of both channels share the multichannel lanes
+             *
+             * @param l equalizer of the left channel
+             * @param r equalizer of the right channel
+             * @param l_out output signal samples of the left channel
+             * @param r_out output signal samples of the right channel
+             * @param l_in input signal samples of the left channel
+             * @param r_in input signal samples of the right channel
+             * @param samples number of samples to process
+             */
+            static void         process(Equalizer *l, Equalizer *r,
+                                        float *l_out, float *r_out, const float *l_in, const float *r_in,
+                                        size_t samples);
+
             /**
              * Dump the state
              * @param dumper dumper
@@ -111,6 +111,13 @@ namespace lsp
              */
             void                set_sample_rate(size_t sr);
 
+            /** Enable double-precision processing, has effect only when
+             * the filter owns it's filter bank
+             *
+             * @param precise double-precision processing flag
+             */
+            void                set_precise(bool precise);
+
             /** Get current filter parameters
              *
              * @param params pointer to filter parameters to store
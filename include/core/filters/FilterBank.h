@@ -34,15 +34,28 @@ namespace lsp
 
         protected:
             biquad_t           *vFilters;   // Optimized list of filters
-            biquad_x1_t        *vChains;    // List of biquad banks
+            biquad_d_t         *vPrecise;   // Optimized list of double-precision filters
+            biquad_dx1_t       *vChains;    // List of biquad banks
             size_t              nItems;     // Current number of biquad_x1 filters
             size_t              nMaxItems;  // Maximum number of biquad_x1 filters
             size_t              nLastItems; // Previous number of biquad_x1 filters
             float              *vBackup;    // Delay backup to take online impulse response
+            double             *vDBackup;   // Delay backup of double-precision filters
+            bool                bPrecise;   // Use double-precision filters
             uint8_t            *vData;      // Unaligned data
 
         protected:
             void                clear_delays();
+            const float        *process_pipeline(float *out, const float *in, size_t samples);
+
+            /** Get the single-cascade filter that ends the optimized list of filters
+             *
+             * @return single-cascade filter, valid only for odd number of cascades
+             */
+            inline biquad_t    *tail()
+            {
+                return &vFilters[(nItems >> 3) + ((nItems >> 2) & 1) + ((nItems >> 1) & 1)];
+            }
 
         public:
             explicit FilterBank();
@@ -79,13 +92,27 @@ namespace lsp
              *
              * @return added cascade
              */
-            biquad_x1_t        *add_chain();
+            biquad_dx1_t       *add_chain();
 
             /** Optimize structure of filter bank
              * @param clear force to clear delays
              */
             void                end(bool clear = false);
 
+            /** Enable double-precision processing. Single-precision coefficients
+             * of low-frequency filters at high sample rates lose too many significant
+             * bits, so the filter response drifts and limit cycles may appear
+             *
+             * @param precise double-precision processing flag
+             */
+            void                set_precise(bool precise);
+
+            /** Check that double-precision processing is enabled
+             *
+             * @return true if double-precision processing is enabled
+             */
+            inline bool         precise() const { return bPrecise; }
+
             /** Process samples
              *
              * @param out output buffer
@@ -94,6 +121,23 @@ namespace lsp
              */
             void                process(float *out, const float *in, size_t samples);
 
+            /** Process samples of two independent channels. The pipelined stages are
+             * processed for each bank separately while the single-cascade stages left
+             * in both banks are processed as two lanes of one interleaved filter
+             *
+             * @param l filter bank of the left channel
+             * @param r filter bank of the right channel
+             * @param l_out output buffer of the left channel
+             * @param r_out output buffer of the right channel
+             * @param l_in input buffer of the left channel
+             * @param r_in input buffer of the right channel
+             * @param buf temporary buffer to store interleaved frames, at least samples*2 floats
+             * @param samples number of samples to process
+             */
+            static void         process(FilterBank *l, FilterBank *r,
+                                        float *l_out, float *r_out, const float *l_in, const float *r_in,
+                                        float *buf, size_t samples);
+
             /** Get impulse response of the bank
              *
              * @param out output buffer to store impulse response
@@ -131,6 +131,7 @@ namespace lsp
     const size_t FILTER_RANK_MAX            = 12;
     const size_t FILTER_CONVOLUTION_MAX     = (1 << FILTER_RANK_MAX);
     const size_t FILTER_CHAINS_MAX          = 0x20;
+    const long FILTER_PRECISE_SRATE         = 96000;    // Sample rate above which IIR filters are computed with double precision
 }
 
 #endif /* INCLUDE_CORE_FILTERS_COMMON_H_ */
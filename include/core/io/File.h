@@ -259,6 +259,30 @@ namespace lsp
                  * @return status of operation
                  */
                 static status_t remove(const Path *path);
+
+                /**
+                 * Rename file, the existing destination file is replaced
+                 * @param from path to the file
+                 * @param to new path to the file
+                 * @return status of operation
+                 */
+                static status_t rename(const char *from, const char *to);
+
+                /**
+                 * Rename file, the existing destination file is replaced
+                 * @param from path to the file
+                 * @param to new path to the file
+                 * @return status of operation
+                 */
+                static status_t rename(const LSPString *from, const LSPString *to);
+
+                /**
+                 * Rename file, the existing destination file is replaced
+                 * @param from path to the file
+                 * @param to new path to the file
+                 * @return status of operation
+                 */
+                static status_t rename(const Path *from, const Path *to);
         };
     
     } /* namespace io */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_IPC_POOLEXECUTOR_H_
+#define CORE_IPC_POOLEXECUTOR_H_
+
+#include <dsp/atomic.h>
+#include <core/ipc/Thread.h>
+#include <core/ipc/Semaphore.h>
+#include <core/ipc/IExecutor.h>
+#include <core/ipc/ITask.h>
+
+#define POOL_EXECUTOR_MAX_WORKERS       4       /* Default maximum number of workers */
+
+namespace lsp
+{
+    namespace ipc
+    {
+        /**
+         * Executor service that runs tasks on the pool of worker threads.
+         * Each worker has its own task queue, submitted tasks are spread
+         * between queues, idle workers steal tasks from queues of other
+         * workers. Workers sleep on the semaphore and are woken up immediately
+         * when new task is submitted.
+         */
+        class PoolExecutor: public IExecutor
+        {
+            protected:
+                typedef struct worker_t
+                {
+                    PoolExecutor       *pExecutor;      // Executor
+                    Thread             *pThread;        // Worker thread
+                    ITask              *pHead;          // Head of the task queue
+                    ITask              *pTail;          // Tail of the task queue
+                    atomic_t            nLock;          // Queue lock
+                } worker_t;
+
+            private:
+                worker_t           *vWorkers;           // List of workers
+                size_t              nWorkers;           // Number of workers
+                volatile uatomic_t  nSubmit;            // Submit counter to spread tasks between queues
+                volatile bool       bShutdown;          // Shutdown flag
+                Semaphore           sSignal;            // Wakeup signal for workers
+
+            protected:
+                static status_t     execute(void *params);
+                void                run(worker_t *w);
+                ITask              *fetch(worker_t *w);
+                static ITask       *pop_task(worker_t *w);
+
+            private:
+                PoolExecutor &operator = (const PoolExecutor &src); // Deny copying
+
+            public:
+                /**
+                 * Create pool executor
+                 * @param workers number of worker threads, zero means the number of
+                 *        available CPU cores limited by POOL_EXECUTOR_MAX_WORKERS
+                 */
+                explicit PoolExecutor(size_t workers = 0);
+                virtual ~PoolExecutor();
+
+            public:
+                /**
+                 * Start worker threads
+                 * @return status of operation
+                 */
+                status_t start();
+
+                /**
+                 * Get number of worker threads
+                 * @return number of worker threads
+                 */
+                inline size_t workers() const       { return nWorkers; }
+
+                virtual bool submit(ITask *task);
+
+                virtual void shutdown();
+        };
+    }
+}
+
+#endif /* CORE_IPC_POOLEXECUTOR_H_ */
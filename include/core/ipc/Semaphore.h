@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_CORE_IPC_SEMAPHORE_H_
+#define INCLUDE_CORE_IPC_SEMAPHORE_H_
+
+#include <core/types.h>
+#include <core/status.h>
+#include <dsp/atomic.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <synchapi.h>
+#elif defined(PLATFORM_LINUX)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <errno.h>
+#else
+    #include <pthread.h>
+    #include <errno.h>
+#endif
+
+namespace lsp
+{
+    namespace ipc
+    {
+        /**
+         * Counting semaphore that allows one thread to wake up another
+         * without polling. The post() method never blocks and is safe to call
+         * from the realtime thread.
+         */
+        class Semaphore
+        {
+            private:
+#if defined(PLATFORM_WINDOWS)
+                mutable HANDLE                  hSem;       // Semaphore object
+#elif defined(PLATFORM_LINUX)
+                mutable volatile atomic_t       nCount;     // Number of pending posts
+                mutable volatile atomic_t       nWaiters;   // Number of waiting threads
+#else
+                mutable pthread_mutex_t         sMutex;     // Mutex
+                mutable pthread_cond_t          sCond;      // Condition variable
+                mutable size_t                  nCount;     // Number of pending posts
+#endif
+
+            private:
+                Semaphore & operator = (const Semaphore & m);       // Deny copying
+
+            public:
+                explicit Semaphore();
+                ~Semaphore();
+
+            public:
+                /**
+                 * Increment the semaphore counter and wake up one waiting thread
+                 * @return true on success
+                 */
+                bool post() const;
+
+                /**
+                 * Wait until the semaphore counter becomes positive and decrement it
+                 * @return status of operation
+                 */
+                status_t wait() const;
+
+                /**
+                 * Wait until the semaphore counter becomes positive and decrement it
+                 * @param millis maximum amount of milliseconds to wait
+                 * @return status of operation, STATUS_TIMED_OUT if timeout has expired
+                 */
+                status_t wait(wsize_t millis) const;
+
+                /**
+                 * Try to decrement the semaphore counter without blocking
+                 * @return true if counter was decremented
+                 */
+                bool try_wait() const;
+        };
+
+    } /* namespace ipc */
+} /* namespace lsp */
+
+#endif /* INCLUDE_CORE_IPC_SEMAPHORE_H_ */
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_IPC_SHAREDMEMORY_H_
+#define CORE_IPC_SHAREDMEMORY_H_
+
+#include <core/types.h>
+#include <core/status.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+#endif /* PLATFORM_WINDOWS */
+
+#define SHARED_MEMORY_NAME_MAX      64
+
+namespace lsp
+{
+    namespace ipc
+    {
+        /**
+         * Named shared memory segment which can be mapped by another process.
+         * The segment is created by the owner and removed from the system
+         * namespace when the owner closes it, other processes only map
+         * the existing segment
+         */
+        class SharedMemory
+        {
+            private:
+            #ifdef PLATFORM_WINDOWS
+                HANDLE      hMapping;
+            #else
+                int         hFD;
+            #endif
+                void       *pData;
+                size_t      nSize;
+                bool        bOwner;
+                char        sName[SHARED_MEMORY_NAME_MAX];
+
+            private:
+                SharedMemory & operator = (const SharedMemory &);
+
+            public:
+                explicit SharedMemory();
+                ~SharedMemory();
+
+            public:
+                /**
+                 * Check that shared memory segment is mapped
+                 * @return true if shared memory segment is mapped
+                 */
+                inline bool         opened() const  { return pData != NULL; }
+
+                /**
+                 * Get pointer to the mapped data
+                 * @return pointer to the mapped data or NULL
+                 */
+                inline void        *data()          { return pData; }
+
+                /**
+                 * Get size of the mapped data
+                 * @return size of the mapped data
+                 */
+                inline size_t       size() const    { return nSize; }
+
+                /**
+                 * Get name of the segment
+                 * @return name of the segment
+                 */
+                inline const char  *name() const    { return sName; }
+
+                /**
+                 * Check that this object owns the segment
+                 * @return true if this object owns the segment
+                 */
+                inline bool         owner() const   { return bOwner; }
+
+                /**
+                 * Create new shared memory segment and map it
+                 * @param name name of the segment, should be unique in the system
+                 * @param size size of the segment
+                 * @return status of operation
+                 */
+                status_t            create(const char *name, size_t size);
+
+                /**
+                 * Create new shared memory segment with automatically generated unique name
+                 * @param prefix the prefix of the segment name
+                 * @param size size of the segment
+                 * @return status of operation
+                 */
+                status_t            create_unique(const char *prefix, size_t size);
+
+                /**
+                 * Map the existing shared memory segment
+                 * @param name name of the segment
+                 * @return status of operation
+                 */
+                status_t            open(const char *name);
+
+                /**
+                 * Unmap the segment and remove it if the segment is owned
+                 * @return status of operation
+                 */
+                status_t            close();
+        };
+    }
+} /* namespace lsp */
+
+#endif /* CORE_IPC_SHAREDMEMORY_H_ */
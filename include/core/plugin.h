@@ -29,6 +29,7 @@
 #include <core/ICanvas.h>
 #include <core/IStateDumper.h>
 #include <core/debug.h>
+#include <core/util/CpuProfiler.h>
 
 #include <metadata/metadata.h>
 
@@ -50,6 +51,11 @@ namespace lsp
             ssize_t                     nLatency;
             bool                        bActivated;
             bool                        bUIActive;
+            bool                        bDisplayActive; // Inline display is being drawn by the host
+            volatile uatomic_t          nDisplayDraws;  // Number of inline display draws, updated by host thread
+            uatomic_t                   nDisplaySeen;   // Last observed number of inline display draws
+            size_t                      nDisplayIdle;   // Number of samples processed since last draw
+            CpuProfiler                 sProfiler;
 
         public:
             explicit plugin_t(const plugin_metadata_t &mdata);
@@ -69,8 +75,23 @@ namespace lsp
             inline ssize_t get_sample_rate() const      { return fSampleRate;       };
             inline bool active() const                  { return bActivated;        };
             inline bool ui_active() const               { return bUIActive;         };
+            inline bool display_active() const          { return bDisplayActive;    };
+
+            /** Check that there is any consumer of the graphical data produced
+             * by the plugin: the UI or the inline display. Plugins should skip
+             * computation of analysis data and curves if there are no consumers
+             *
+             * @return true if there is any consumer
+             */
+            inline bool has_consumers() const           { return bUIActive || bDisplayActive; };
+
+            /** Notify that the inline display has been drawn by the host,
+             * may be called from any thread
+             */
+            inline void display_drawn()                 { atomic_add(&nDisplayDraws, uatomic_t(1)); };
 
             inline IWrapper *wrapper()                  { return pWrapper;          };
+            inline CpuProfiler *profiler()              { return &sProfiler;        };
 
             inline void activate_ui()
             {
@@ -92,6 +113,13 @@ namespace lsp
                 }
             }
 
+            /** Update state of the inline display consumer, should be called
+             * by the wrapper from the processing thread
+             *
+             * @param samples number of samples to process
+             */
+            void update_display_state(size_t samples);
+
             inline void activate()
             {
                 if (!bActivated)
@@ -140,6 +168,12 @@ namespace lsp
              */
             virtual void ui_activated();
 
+            /** Triggered inline display activation: the host started
+             * drawing the inline display
+             *
+             */
+            virtual void display_activated();
+
             /** Triggered input port change, need to update configuration
              *
              */
@@ -174,6 +208,12 @@ namespace lsp
              */
             virtual void ui_deactivated();
 
+            /** Triggered inline display deactivation: the host stopped
+             * drawing the inline display for a while
+             *
+             */
+            virtual void display_deactivated();
+
             /** Triggered plugin deactivation
              *
              */
@@ -319,6 +319,107 @@ namespace lsp
 
     } frame_buffer_t;
 
+    /**
+     * Lock-free ring buffer of variable-sized records for single producer and
+     * single consumer. The structure does not contain any pointers, it is
+     * placed at the beginning of the memory chunk and is immediately followed
+     * by the record data, so the whole chunk can be a shared memory segment
+     * mapped at different addresses by different processes. Each record is
+     * stored contiguously and can be accessed in place without copying.
+     */
+    typedef struct shm_ring_t
+    {
+        protected:
+            typedef struct record_t
+            {
+                uint32_t            nSize;      // Size of the record payload
+                uint32_t            nType;      // Type of the record
+            } record_t;
+
+            enum record_type_t
+            {
+                RT_DATA,                        // Record contains data
+                RT_WRAP                         // Rest of the buffer is unused, continue from start
+            };
+
+            uint32_t            nMagic;         // Magic number
+            uint32_t            nCapacity;      // Capacity of the data area in bytes
+            uint32_t            nWrOff;         // Offset of the pending record, modified by producer only
+            uint32_t            nRdSize;        // Size of the record being read, modified by consumer only
+            uint8_t             __pad0[0x30];
+            volatile uint32_t   nHead;          // Write position, modified by producer only
+            uint8_t             __pad1[0x3c];
+            volatile uint32_t   nTail;          // Read position, modified by consumer only
+            uint8_t             __pad2[0x3c];
+
+        protected:
+            inline uint8_t         *data()                  { return reinterpret_cast<uint8_t *>(&this[1]); }
+
+        public:
+            /**
+             * Get the size of memory chunk required to store the ring buffer
+             * @param capacity capacity of the ring buffer in bytes
+             * @return size of memory chunk
+             */
+            static size_t           size_of(size_t capacity);
+
+            /**
+             * Initialize ring buffer at the specified memory chunk, should be called by producer
+             * @param ptr pointer to the memory chunk
+             * @param size size of the memory chunk
+             * @return pointer to the ring buffer or NULL on error
+             */
+            static shm_ring_t      *init(void *ptr, size_t size);
+
+            /**
+             * Attach to the ring buffer previously initialized at the specified memory chunk,
+             * should be called by consumer. Records that have not been read by the previous
+             * consumer are discarded, the producer should not write while consumer attaches
+             * @param ptr pointer to the memory chunk
+             * @param size size of the memory chunk
+             * @return pointer to the ring buffer or NULL if memory chunk does not contain valid ring buffer
+             */
+            static shm_ring_t      *attach(void *ptr, size_t size);
+
+        public:
+            /**
+             * Get capacity of the ring buffer in bytes
+             * @return capacity of the ring buffer
+             */
+            inline size_t           capacity() const        { return nCapacity; }
+
+            /**
+             * Check that ring buffer does not contain records
+             * @return true if ring buffer does not contain records
+             */
+            inline bool             empty() const           { return nHead == nTail; }
+
+            /**
+             * Reserve space for the new record, called by producer
+             * @param size maximum size of the record payload
+             * @return pointer to the record payload or NULL if there is not enough space
+             */
+            void                   *begin_write(size_t size);
+
+            /**
+             * Commit the reserved record and make it visible to the consumer, called by producer
+             * @param size actual size of the record payload, should not exceed the reserved size
+             */
+            void                    commit_write(size_t size);
+
+            /**
+             * Get the pending record, called by consumer
+             * @param size pointer to store the size of the record payload
+             * @return pointer to the record payload or NULL if there are no pending records
+             */
+            const void             *begin_read(size_t *size);
+
+            /**
+             * Release the record obtained by begin_read(), called by consumer
+             */
+            void                    commit_read();
+    } shm_ring_t;
+
     /**
      * Buffer to transfer OSC packets between two threads.
      * It is safe to use if one thread is reading data and one thread is
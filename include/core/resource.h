@@ -55,6 +55,20 @@ namespace lsp
         extern const float          float_dictionary[];
         extern const resource_t     builtin_resources[];
 
+        // Perfect hash index of builtin resources generated at build time
+        extern const size_t         builtin_index_buckets;  // Number of buckets, power of 2
+        extern const size_t         builtin_index_size;     // Number of slots, power of 2
+        extern const uint32_t       builtin_index_disp[];   // Hash seed for each bucket, 0 for empty bucket
+        extern const int32_t        builtin_index_slots[];  // Resource index for each slot, -1 for empty slot
+
+        /**
+         * Compute hash of resource identifier used by the resource index
+         * @param id resource identifier
+         * @param seed hash seed
+         * @return hash value
+         */
+        uint32_t            hash_id(const char *id, uint32_t seed);
+
         const resource_t   *get(const char *id, resource_type_t type);
         const resource_t   *all();
 
@@ -81,6 +95,11 @@ namespace lsp
             const char *string_dictionary = ""; \
             \
             const float float_dictionary[] = { 0.0f }; \
+            \
+            const size_t builtin_index_buckets = 1; \
+            const size_t builtin_index_size = 1; \
+            const uint32_t builtin_index_disp[] = { 0 }; \
+            const int32_t builtin_index_slots[] = { -1 }; \
         } \
     }
 
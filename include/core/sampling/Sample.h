@@ -28,6 +28,8 @@
 
 namespace lsp
 {
+    class AudioStream;
+
 #pragma pack(push, 1)
     typedef struct sample_header_t
     {
@@ -46,6 +48,11 @@ namespace lsp
             size_t      nMaxLength;
             size_t      nChannels;
 
+            AudioStream *pStream;       // Stream that provides sample data after the preloaded head
+            size_t      nStreamOffset;  // Position in the stream that corresponds to the beginning of the sample
+            size_t      nStreamLength;  // Overall length of the sample including the streamed part
+            size_t      nStreamFadeout; // Length of the fade-out at the end of the streamed sample
+
         private:
             Sample & operator = (const Sample &);
 
@@ -66,6 +73,41 @@ namespace lsp
 
             inline size_t channels() const { return nChannels; };
 
+            /** Get the stream that provides the data after the preloaded head
+             *
+             * @return stream or NULL if the whole sample is stored in memory
+             */
+            inline AudioStream *stream() const { return pStream; }
+
+            /** Get the position in the stream that corresponds to the beginning of the sample
+             *
+             * @return position in the stream
+             */
+            inline size_t stream_offset() const { return nStreamOffset; }
+
+            /** Get overall length of the sample including the data that is not stored in memory
+             *
+             * @return overall length of the sample
+             */
+            inline size_t total_length() const { return (pStream != NULL) ? nStreamLength : nLength; }
+
+            /** Get length of the fade-out which should be applied to the streamed data,
+             * the preloaded head of the sample should already contain the faded data
+             *
+             * @return length of the fade-out in samples
+             */
+            inline size_t stream_fadeout() const { return (pStream != NULL) ? nStreamFadeout : 0; }
+
+            /** Bind the stream that provides the sample data after the preloaded head
+             * of length() samples. The stream is not owned by the sample.
+             *
+             * @param stream stream to bind, NULL to unbind
+             * @param offset position in the stream that corresponds to the beginning of the sample
+             * @param length overall length of the sample, should not be less than length()
+             * @param fadeout length of the fade-out at the end of the sample
+             */
+            void set_stream(AudioStream *stream, size_t offset, size_t length, size_t fadeout);
+
             /** Set length of sample
              *
              * @param length length to set
@@ -23,6 +23,7 @@
 #define CORE_SAMPLING_SAMPLEPLAYER_H_
 
 #include <core/sampling/Sample.h>
+#include <core/sampling/SampleStreamer.h>
 
 namespace lsp
 {
@@ -38,6 +39,7 @@ namespace lsp
                 ssize_t     nFadeout;   // Fadeout (cancelling)
                 ssize_t     nFadeOffset;// Fadeout offset
                 float       nVolume;    // The volume of the sample
+                SampleStreamer::voice_t *pVoice; // Streaming voice for the data after the preloaded head
                 playback_t *pNext;      // Pointer to the next playback in the list
                 playback_t *pPrev;      // Pointer to the previous playback in the list
             } playback_t;
@@ -56,9 +58,13 @@ namespace lsp
             list_t          sActive;
             list_t          sInactive;
             float           fGain;
+            SampleStreamer *pStreamer;
+            float          *vStreamBuf;
 
         protected:
             static inline void cleanup(playback_t *pb);
+            void release_voice(playback_t *pb);
+            void add_samples(playback_t *pb, float *dst, const float *src, size_t count);
             static inline void list_remove(list_t *list, playback_t *pb);
             static inline playback_t *list_remove_first(list_t *list);
             static inline void list_add_first(list_t *list, playback_t *pb);
@@ -80,9 +86,11 @@ namespace lsp
              *
              * @param max_samples maximum available samples
              * @param max_playbacks maximum number of simultaneous played samples
+             * @param streamer streamer for samples that are not fully loaded into memory,
+             *        if not specified, such samples are played only until the end of preloaded data
              * @return true on success
              */
-            bool init(size_t max_samples, size_t max_playbacks);
+            bool init(size_t max_samples, size_t max_playbacks, SampleStreamer *streamer = NULL);
 
             /** Destroy player
              * @param cascade destroy the bound samples
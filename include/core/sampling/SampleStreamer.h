@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_SAMPLING_SAMPLESTREAMER_H_
+#define CORE_SAMPLING_SAMPLESTREAMER_H_
+
+#include <core/types.h>
+#include <core/status.h>
+#include <core/ipc/Thread.h>
+#include <core/ipc/Semaphore.h>
+#include <core/files/AudioStream.h>
+#include <dsp/atomic.h>
+
+#define SAMPLE_STREAMER_RING_SIZE       0x4000      /* Size of ring buffer of each voice in samples, power of 2 */
+
+namespace lsp
+{
+    /**
+     * Disk streamer for samples that are not fully loaded into memory.
+     * The streamer owns the fixed pool of voices, each voice has the ring buffer
+     * that is filled by the background thread with data of one channel of the
+     * audio stream. Voices are acquired, read and released by the realtime thread
+     * without locking and memory allocation.
+     */
+    class SampleStreamer
+    {
+        private:
+            SampleStreamer & operator = (const SampleStreamer &);
+
+        public:
+            enum voice_state_t
+            {
+                VS_FREE,                            // Voice is owned by the realtime thread and can be acquired
+                VS_ACTIVE,                          // Voice is filled by the streaming thread
+                VS_RELEASE                          // Voice has been released by the realtime thread
+            };
+
+            typedef struct voice_t
+            {
+                AudioStream        *pStream;        // Stream to read data from
+                size_t              nChannel;       // Channel of the stream
+                size_t              nPosition;      // Position in the stream of the next sample to read
+                size_t              nEnd;           // Position in the stream of the last sample to read
+                size_t              nLength;        // Number of samples the voice delivers to the realtime thread
+                float              *vRing;          // Ring buffer
+                volatile uatomic_t  nHead;          // Number of samples written to the ring buffer
+                volatile uatomic_t  nTail;          // Number of samples read from the ring buffer
+                volatile uatomic_t  nState;         // State of the voice
+            } voice_t;
+
+        protected:
+            static status_t     streaming_thread(void *arg);
+            void                run_streaming();
+            bool                fill_voice(voice_t *v);
+
+        private:
+            voice_t            *vVoices;            // Voices
+            size_t              nVoices;            // Number of voices
+            size_t              nRingSize;          // Size of ring buffer of each voice
+            float              *vBuffer;            // Buffer for reading interleaved frames
+            size_t              nBufSize;           // Size of buffer for reading frames
+            ipc::Thread        *pThread;            // Streaming thread
+            ipc::Semaphore      sWakeup;            // Wakeup signal for the streaming thread
+            volatile uatomic_t  nUnderruns;         // Number of underruns
+            volatile uatomic_t  nDropped;           // Number of acquire requests rejected because of no free voices
+            uint8_t            *pData;              // Allocated data
+
+        public:
+            explicit SampleStreamer();
+            ~SampleStreamer();
+
+        public:
+            /** Initialize streamer and launch the streaming thread
+             *
+             * @param voices maximum number of simultaneously streamed voices
+             * @param ring_size size of ring buffer for each voice in samples, will be rounded to power of 2
+             * @return status of operation
+             */
+            status_t init(size_t voices, size_t ring_size = SAMPLE_STREAMER_RING_SIZE);
+
+            /** Stop the streaming thread and destroy streamer
+             *
+             */
+            void destroy();
+
+            /** Acquire the voice and start prefetching data, realtime-safe
+             *
+             * @param stream stream to read data from
+             * @param channel channel of the stream
+             * @param offset position of the first sample in the stream
+             * @param count number of samples to stream
+             * @return pointer to the voice or NULL if there are no free voices
+             */
+            voice_t *acquire(AudioStream *stream, size_t channel, size_t offset, size_t count);
+
+            /** Read data from the voice, realtime-safe. If the streaming thread
+             * didn't manage to fetch the data in time, the missing samples are
+             * filled with zeros and the underrun is counted. Reading past the
+             * end of the streamed range also yields zeros but is not an underrun
+             *
+             * @param v voice to read
+             * @param dst destination buffer
+             * @param count number of samples to read
+             * @return number of samples actually fetched from the stream
+             */
+            size_t read(voice_t *v, float *dst, size_t count);
+
+            /** Release the voice, realtime-safe
+             *
+             * @param v voice to release
+             */
+            void release(voice_t *v);
+
+            /** Wait until all voices that reference the stream become free,
+             * should be called before destroying the stream. Should not be
+             * called from the realtime thread
+             *
+             * @param stream stream to unlink
+             */
+            void unlink(const AudioStream *stream);
+
+            /** Get number of voices
+             *
+             * @return number of voices
+             */
+            inline size_t voices() const            { return nVoices;       }
+
+            /** Get number of underruns happened since initialization
+             *
+             * @return number of underruns
+             */
+            inline size_t underruns() const         { return nUnderruns;    }
+
+            /** Get number of acquire requests rejected since initialization because
+             * all voices were in use, such playbacks are cut to the preloaded part
+             *
+             * @return number of rejected acquire requests
+             */
+            inline size_t dropped() const           { return nDropped;      }
+    };
+
+} /* namespace lsp */
+
+#endif /* CORE_SAMPLING_SAMPLESTREAMER_H_ */
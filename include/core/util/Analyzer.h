@@ -27,6 +27,10 @@
 #include <core/windows.h>
 #include <core/IStateDumper.h>
 
+#define ANALYZER_LEVELS_MAX         6       /* Maximum number of analysis levels */
+#define ANALYZER_FIR_TAPS           19      /* Number of taps of the half-band decimation filter */
+#define ANALYZER_FIR_HISTORY        32      /* Size of the decimation filter history, power of 2 */
+
 namespace lsp
 {
     enum freq_analyzer_flags_t
@@ -67,6 +71,20 @@ namespace lsp
                 R_ALL       = R_ENVELOPE | R_WINDOW | R_ANALYSIS | R_TAU | R_COUNTERS
             };
 
+            typedef struct level_t
+            {
+                float      *vBuffer;        // Delay buffer of the decimated signal
+                float      *vHistory;       // History of the decimation filter
+            } level_t;
+
+            typedef struct decimator_t
+            {
+                size_t      nBufSize;       // Size of the delay buffer
+                size_t      nHead;          // Head of the delay buffer
+                size_t      nHistPos;       // Position in the decimation filter history
+                size_t      nPhase;         // Decimation phase
+            } decimator_t;
+
             typedef struct channel_t
             {
                 float      *vBuffer;        // FFT delay buffer
@@ -75,12 +93,17 @@ namespace lsp
                 size_t      nDelay;         // Delay in the delay buffer
                 bool        bFreeze;        // Freeze analysis
                 bool        bActive;        // Enable analysis
+                level_t     vLevels[ANALYZER_LEVELS_MAX - 1]; // Decimated levels
             } channel_t;
 
         protected:
             size_t      nChannels;          // Overall number of channels
             size_t      nMaxRank;           // Maximum FFT rank
             size_t      nRank;              // Current FFT rank
+            size_t      nMaxLevels;         // Maximum number of analysis levels
+            size_t      nLevels;            // Number of analysis levels
+            size_t      nFftLevels;         // Actual number of analysis levels
+            size_t      nFftRank;           // Rank of FFT performed at each level
             size_t      nSampleRate;        // Sample rate
             size_t      nMaxSampleRate;     // Maximum possible sample rate
             size_t      nBufSize;           // Delay buffer size
@@ -104,6 +127,12 @@ namespace lsp
             float      *vFftReIm;           // Buffer for FFT transform (real part)
             float      *vWindow;            // FFT window
             float      *vEnvelope;          // FFT envelope
+            decimator_t vDecim[ANALYZER_LEVELS_MAX - 1]; // State of decimated levels
+
+        protected:
+            void        analyze(float *amp, const float *buf, size_t buf_size, size_t head, size_t delay);
+            void        decimate(channel_t *c, decimator_t *d, const float *src, size_t count);
+            size_t      bin_index(size_t idx) const;
 
         public:
             explicit Analyzer();
@@ -126,9 +155,10 @@ namespace lsp
              * @param max_rank maximum FFT rank
              * @param max_sr maximum sample rate
              * @param min_rate minimum refresh rate
+             * @param max_levels maximum number of multi-resolution analysis levels
              * @return status of operation
              */
-            bool init(size_t channels, size_t max_rank, size_t max_sr, float min_rate);
+            bool init(size_t channels, size_t max_rank, size_t max_sr, float min_rate, size_t max_levels = 1);
 
             /**
              * Get overall number of channels
@@ -233,6 +263,22 @@ namespace lsp
              */
             inline size_t get_rank() const          { return nRank; }
 
+            /** Set number of multi-resolution analysis levels. Each next level
+             * analyzes the signal decimated by 2 with FFT of the same size, the
+             * output is merged into one spectrum of the current rank: low frequencies
+             * are taken from the deepest levels, high frequencies from the upper ones
+             *
+             * @param levels number of levels, 1 means single full-rank FFT
+             * @return true on success
+             */
+            bool set_levels(size_t levels);
+
+            /**
+             * Get number of multi-resolution analysis levels
+             * @return number of multi-resolution analysis levels
+             */
+            inline size_t get_levels() const        { return nLevels; }
+
             /** Set analyzer activity
              *
              * @param active activity flag
@@ -24,17 +24,37 @@
 
 #include <core/types.h>
 #include <core/IStateDumper.h>
+#include <core/ipc/Thread.h>
+#include <core/ipc/Semaphore.h>
+#include <dsp/atomic.h>
 
 #define CONVOLVER_RANK_MIN          8                               /* buffer of 256 samples (128 effective)    */
 #define CONVOLVER_RANK_MAX          16                              /* buffer of 8192 samples (4096 effective)  */
 
 namespace lsp
 {
+    /**
+     * Convolver processing mode
+     */
+    enum convolver_mode_t
+    {
+        CONV_MODE_INLINE,       //!< CONV_MODE_INLINE all partitions are processed by the caller's thread
+        CONV_MODE_THREADED      //!< CONV_MODE_THREADED constant-size tail partitions are processed by the worker thread
+    };
+
     class Convolver
     {
         private:
             Convolver & operator = (const Convolver &);
 
+        protected:
+            volatile bool       bWorkerHold;        // The worker thread does not take tail blocks while set
+
+        protected:
+            static status_t     tail_worker(void *arg);
+            void                run_tail_worker();
+            void                complete_tail();
+
         private:
             float          *vDataBuffer;            // Buffer for storing convolution tail data
             float          *vFrame;                 // Pointer to the beginning of the input data frame
@@ -55,6 +75,13 @@ namespace lsp
             size_t          nBlkInit;               // Initial number of blocks to apply at step # 0
             float           fBlkCoef;               // The actual coefficient to compute proper block number per formula
 
+            float          *vTailData;              // Per-block output slots filled by the worker thread
+            float          *vTailBuffer;            // Convolution buffer of the worker thread
+            volatile uatomic_t *vTailState;         // Per-block claim state of the tail task
+            ipc::Thread    *pWorker;                // Worker thread for tail partitions
+            ipc::Semaphore  sWakeup;                // Wakeup signal for the worker thread
+            bool            bTailPending;           // Tail task has been submitted to the worker thread
+
             uint8_t        *vData;                  // Non-aligned pointer to the whole allocated data
 
         public:
@@ -78,9 +105,13 @@ namespace lsp
              * @param data convolution data
              * @param count number of samples in convolution
              * @param rank convolution rank
+             * @param phase initial phase of the frame in range [0..1)
+             * @param mode processing mode, the threaded mode launches the worker thread
+             *        that computes constant-size tail partitions ahead of time, the
+             *        head partitions are always computed by the caller of process()
              * @return true on success
              */
-            bool init(const float *data, size_t count, size_t rank, float phase);
+            bool init(const float *data, size_t count, size_t rank, float phase, convolver_mode_t mode = CONV_MODE_INLINE);
 
             /** Process samples
              *
@@ -102,6 +133,12 @@ namespace lsp
              */
             inline size_t rank() const                  { return nRank;         }
 
+            /**
+             * Check that constant-size tail partitions are processed by the worker thread
+             * @return true if worker thread is used
+             */
+            inline bool threaded() const                { return pWorker != NULL; }
+
             /**
              * Dump internal state
              * @param v state dumper
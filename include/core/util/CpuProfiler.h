@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CORE_UTIL_CPUPROFILER_H_
+#define CORE_UTIL_CPUPROFILER_H_
+
+#include <core/types.h>
+#include <core/IStateDumper.h>
+#include <dsp/atomic.h>
+
+#define CPU_PROFILER_STAGES_MAX         16      /* Maximum number of tracked stages */
+#define CPU_PROFILER_HISTORY_SIZE       64      /* Number of recent blocks stored in the history ring */
+#define CPU_PROFILER_BUCKETS            32      /* Number of throughput histogram buckets */
+#define CPU_PROFILER_BUCKET_SHIFT       3       /* Resolution of the histogram: 1/8 tick per sample */
+
+namespace lsp
+{
+    /**
+     * Realtime CPU profiler of the plugin's processing routine. The processing
+     * block is split into named stages, the profiler accumulates the time spent
+     * in each stage, the worst-case block time and the histogram of throughput.
+     *
+     * All methods that are called from the processing routine are wait-free and
+     * do not allocate memory. When the profiler is disabled, each probe costs
+     * one check of the flag.
+     */
+    class CpuProfiler
+    {
+        public:
+            typedef uint64_t        tick_t;
+
+            /**
+             * Scoped probe of the whole processing block: starts the block in the
+             * constructor and completes it in the destructor
+             */
+            class Block
+            {
+                private:
+                    CpuProfiler    *pProfiler;
+
+                public:
+                    inline explicit Block(CpuProfiler &p, size_t samples)
+                    {
+                        if (p.bEnabled)
+                        {
+                            pProfiler   = &p;
+                            p.begin_block(samples);
+                        }
+                        else
+                            pProfiler   = NULL;
+                    }
+
+                    inline ~Block()
+                    {
+                        if (pProfiler != NULL)
+                            pProfiler->end_block();
+                    }
+            };
+
+        protected:
+            typedef struct stage_t
+            {
+                const char     *sName;          // Name of the stage
+                tick_t          nTicks;         // Overall number of ticks spent in the stage
+                tick_t          nBlockTicks;    // Number of ticks spent in the stage in the current block
+                tick_t          nMaxTicks;      // Worst-case number of ticks spent in the stage per block
+                uint64_t        nBlocks;        // Number of blocks the stage was active in
+            } stage_t;
+
+            typedef struct record_t
+            {
+                size_t          nSamples;       // Number of samples in the block
+                tick_t          nTicks;         // Number of ticks spent to process the block
+            } record_t;
+
+        protected:
+            bool                bEnabled;       // Profiler enabled flag
+            bool                bBlock;         // Block is currently being processed
+            ssize_t             nStage;         // Index of the current stage, negative if none
+            size_t              nStages;        // Number of registered stages
+            size_t              nSampleRate;    // Sample rate of the plugin
+            size_t              nBlockSamples;  // Number of samples in the current block
+            tick_t              nBlockStart;    // Start time of the current block
+            tick_t              nStageStart;    // Start time of the current stage
+
+            uint64_t            nBlocks;        // Overall number of processed blocks
+            uint64_t            nSamples;       // Overall number of processed samples
+            tick_t              nTicks;         // Overall number of ticks spent in processing
+            tick_t              nMaxTicks;      // Worst-case block time in ticks
+            size_t              nMaxSamples;    // Number of samples in the worst-case block
+
+            volatile uatomic_t  nHead;          // Number of records written to the history ring
+            record_t            vHistory[CPU_PROFILER_HISTORY_SIZE];
+            uint64_t            vHistogram[CPU_PROFILER_BUCKETS];
+            stage_t             vStages[CPU_PROFILER_STAGES_MAX];
+
+        protected:
+            void                begin_block(size_t samples);
+            void                end_block();
+            void                switch_stage(const char *name);
+            void                close_stage(tick_t now);
+            ssize_t             find_stage(const char *name);
+
+        public:
+            explicit CpuProfiler();
+            ~CpuProfiler();
+
+        public:
+            /**
+             * Read the current value of the tick counter: time stamp counter
+             * on x86 architecture and nanosecond clock on other ones
+             * @return current value of the tick counter
+             */
+            static tick_t       ticks();
+
+            /**
+             * Get the frequency of the tick counter, the first call performs calibration
+             * and may take several milliseconds, should not be called from realtime thread
+             * @return number of ticks per second
+             */
+            static double       tick_frequency();
+
+        public:
+            /**
+             * Check that profiler is enabled
+             * @return true if profiler is enabled
+             */
+            inline bool         enabled() const     { return bEnabled;      }
+
+            /**
+             * Enable or disable profiler, should not be called while processing
+             * @param enabled enable flag
+             */
+            void                set_enabled(bool enabled);
+
+            /**
+             * Set sample rate used for computing DSP load
+             * @param sr sample rate
+             */
+            inline void         set_sample_rate(size_t sr)  { nSampleRate = sr; }
+
+            /**
+             * Reset all collected statistics and registered stages
+             */
+            void                reset();
+
+            /**
+             * Finish the previous stage and start the new one. Time between the start
+             * of the block and the first stage is not assigned to any stage.
+             * @param name name of the stage, should be a string literal. Stages
+             *        which don't fit into the CPU_PROFILER_STAGES_MAX are not tracked
+             */
+            inline void         stage(const char *name)
+            {
+                if (bEnabled)
+                    switch_stage(name);
+            }
+
+            /**
+             * Get overall number of processed blocks
+             * @return number of processed blocks
+             */
+            inline uint64_t     blocks() const      { return nBlocks;       }
+
+            /**
+             * Get overall number of processed samples
+             * @return number of processed samples
+             */
+            inline uint64_t     samples() const     { return nSamples;      }
+
+            /**
+             * Get number of registered stages
+             * @return number of registered stages
+             */
+            inline size_t       stages() const      { return nStages;       }
+
+            /**
+             * Get name of the stage
+             * @param index index of the stage
+             * @return name of the stage or NULL
+             */
+            const char         *stage_name(size_t index) const;
+
+            /**
+             * Get share of the overall processing time spent in the stage
+             * @param index index of the stage
+             * @return share of processing time in range [0..1]
+             */
+            float               stage_share(size_t index) const;
+
+            /**
+             * Dump the state and the collected statistics
+             * @param v state dumper
+             */
+            void                dump(IStateDumper *v) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* CORE_UTIL_CPUPROFILER_H_ */
@@ -25,6 +25,8 @@
 #include <core/IStateDumper.h>
 #include <core/filters/Filter.h>
 #include <core/filters/Equalizer.h>
+#include <core/ipc/IExecutor.h>
+#include <core/ipc/ITask.h>
 
 namespace lsp
 {
@@ -56,6 +58,21 @@ namespace lsp
                                         │  ┌─────┐     ┌─────┐
                                         └─►│HPF 2│────►│OUT 3│
                                            └─────┘     └─────┘
+
+         In FFT mode the input signal is split into blocks of the half FFT size, each block
+         is transformed once and then convolved with the linear-phase kernel of each band:
+
+        FFT   = Direct transform of the input block shared between all bands
+        KRN   = Band kernel: the magnitude response of the band built by the filters above
+        IFFT  = Reverse transform and overlap-add of the convolution result
+
+       ┌─────┐     ┌─────┐     ┌─────┐     ┌─────┐     ┌─────┐
+       │INPUT│────►│ FFT │──┬─►│KRN 0│────►│IFFT │────►│OUT 0│
+       └─────┘     └─────┘  │  └─────┘     └─────┘     └─────┘
+                            │     ...         ...         ...
+                            │  ┌─────┐     ┌─────┐     ┌─────┐
+                            └─►│KRN 3│────►│IFFT │────►│OUT 3│
+                               └─────┘     └─────┘     └─────┘
      */
 
     /**
@@ -80,6 +97,15 @@ namespace lsp
         CROSS_MODE_MT      //!< CROSS_MODE_MT matched transform
     };
 
+    /**
+     * Crossover implementation type
+     */
+    enum crossover_type_t
+    {
+        CROSS_TYPE_IIR,    //!< CROSS_TYPE_IIR IIR filters, minimum phase, no latency
+        CROSS_TYPE_FFT     //!< CROSS_TYPE_FFT fast convolution, linear phase, introduces latency
+    };
+
     /** Crossover, splits signal into bands, calls processing handler (if present)
      * and mixes processed bands back after adjusting the post-processing amplification gain
      *
@@ -89,6 +115,22 @@ namespace lsp
         private:
             Crossover & operator = (const Crossover &);
 
+        protected:
+            class KernelBuilder: public ipc::ITask
+            {
+                private:
+                    Crossover          *pCore;
+
+                public:
+                    explicit KernelBuilder(Crossover *core);
+                    virtual ~KernelBuilder();
+
+                public:
+                    virtual status_t    run();
+            };
+
+            friend class KernelBuilder;
+
         protected:
             enum xover_type_t
             {
@@ -121,8 +163,20 @@ namespace lsp
                 void               *pObject;        // Bound object
                 void               *pSubject;       // Bound subject
                 size_t              nId;            // Number of the band
+
+                float              *vKernel;        // Fast convolution data of the band kernel (FFT mode)
+                float              *vKernelNew;     // Kernel built by the kernel builder (FFT mode)
+                float              *vFftOut;        // Overlap-add buffer of the band output (FFT mode)
             } band_t;
 
+            typedef struct kband_t
+            {
+                bool                bEnabled;       // Enabled flag
+                float               fGain;          // Output gain of the band
+                filter_params_t     sHPF;           // High-pass filter at the start of the band
+                filter_params_t     sLPF;           // Low-pass filter at the end of the band
+            } kband_t;
+
             enum reconfigure_t
             {
                 R_GAIN          = 1 << 0,           // We can reconfigure band gain in softer mode
@@ -144,10 +198,34 @@ namespace lsp
 
             float          *vLpfBuf;        // Buffer for LPF
             float          *vHpfBuf;        // Buffer for HPF
+
+            crossover_type_t nType;         // Crossover type
+            size_t          nFftRank;       // FFT rank, 0 if FFT mode is not available
+            size_t          nFftOffset;     // Offset in the current input block
+            float          *vFftIn;         // Input block (FFT mode)
+            float          *vFftSpec;       // Fast convolution data of the input block (FFT mode)
+            float          *vFftTmp;        // Temporary buffer for transforms (FFT mode)
+
+            KernelBuilder  *pBuilder;       // Kernel builder task (FFT mode)
+            ipc::IExecutor *pExecutor;      // Executor of the kernel builder, may be NULL
+            size_t          nKernelReq;     // Kernel rebuild request counter
+            size_t          nKernelResp;    // Kernel rebuild response counter
+            size_t          nKernelRate;    // Sample rate of kernels being built
+            kband_t        *vKernelBands;   // Band settings of kernels being built
+            Filter          sKernelFilter;  // Filter used by the kernel builder
+            float          *vKernelBuf;     // Temporary buffers of the kernel builder
+
             uint8_t        *pData;          // Unaligned data
 
         protected:
             inline filter_type_t    select_filter(xover_type_t type, crossover_mode_t mode);
+            void                    split_params(filter_params_t *fp, xover_type_t type, const split_t *sp, float gain);
+            bool                    iir_chart(size_t band, float *re, float *im, const float *f, size_t count);
+            bool                    iir_chart(size_t band, float *c, const float *f, size_t count);
+            status_t                build_kernels();
+            void                    swap_kernels();
+            void                    sync_kernels();
+            void                    process_fft_block();
 
         public:
             explicit Crossover();
@@ -167,9 +245,11 @@ namespace lsp
              *
              * @param bands number of bands
              * @param buf_size maximum signal processing buffer size
+             * @param fft_rank rank of the FFT used by CROSS_TYPE_FFT, the length of band kernels is
+             *        2^(fft_rank-1) samples, 0 means that FFT mode is not available
              * @return status of operation
              */
-            bool            init(size_t bands, size_t buf_size);
+            bool            init(size_t bands, size_t buf_size, size_t fft_rank = 0);
 
         public:
             /**
@@ -193,6 +273,45 @@ namespace lsp
              */
             inline size_t   max_buffer_size() const                 { return nBufSize;      }
 
+            /**
+             * Set crossover type, FFT type is available only if crossover was initialized
+             * with non-zero FFT rank
+             * @param type crossover type
+             */
+            void            set_type(crossover_type_t type);
+
+            /**
+             * Get crossover type
+             * @return crossover type
+             */
+            inline crossover_type_t get_type() const                { return nType;         }
+
+            /**
+             * Set executor used for building kernels of the FFT type outside of the
+             * process() call. If executor is not set, kernels are built by the process() call.
+             * The crossover should not be destroyed while the kernel builder is active.
+             * @param executor executor or NULL
+             */
+            inline void     set_executor(ipc::IExecutor *executor)  { pExecutor = executor; }
+
+            /**
+             * Get latency of the crossover, non-zero only for FFT type
+             * @return latency of the crossover in samples
+             */
+            inline size_t   latency() const
+            {
+                return (nType == CROSS_TYPE_FFT) ? max_latency() : 0;
+            }
+
+            /**
+             * Get maximum possible latency of the crossover
+             * @return maximum possible latency of the crossover in samples
+             */
+            inline size_t   max_latency() const
+            {
+                return (nFftRank > 0) ? (size_t(3) << (nFftRank - 2)) : 0;
+            }
+
             /** Set slope of crossover
              *
              * @param sp split point number
@@ -302,7 +421,7 @@ namespace lsp
             inline size_t   get_sample_rate()                   { return nSampleRate;           }
 
             /** Get frequency chart of the crossover band. This method returns frequency chart
-             * without applied all-pass filters
+             * without applied all-pass filters, for FFT type the magnitude of the chart is returned
              *
              * @param band number of the band
              * @param re real part of the frequency chart
@@ -314,7 +433,7 @@ namespace lsp
             bool            freq_chart(size_t band,  float *re, float *im, const float *f, size_t count);
 
             /** Get frequency chart of the crossover. This method returns frequency chart
-             * without applied all-pass filters
+             * without applied all-pass filters, for FFT type the magnitude of the chart is returned
              *
              * @param band number of the band
              * @param c transfer function (packed complex numbers)
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_UTIL_MULTICONVOLVER_H_
+#define CORE_UTIL_MULTICONVOLVER_H_
+
+#include <core/types.h>
+#include <core/IStateDumper.h>
+#include <core/util/Convolver.h>
+
+namespace lsp
+{
+    /**
+     * Convolver of N inputs to M outputs (for example, true stereo convolution).
+     * The output #j is the sum of convolutions of each input #i with the kernel (i, j).
+     * The partitioning scheme is the same as for the Convolver, but the forward FFT
+     * of each input partition is computed once and shared by all kernels, and the
+     * results of all kernels of the same output are accumulated in the frequency
+     * domain before the single reverse FFT.
+     */
+    class MultiConvolver
+    {
+        private:
+            MultiConvolver & operator = (const MultiConvolver &);
+
+        protected:
+            typedef struct kernel_t
+            {
+                size_t          nDirect;        // Size of direct convolution data
+                size_t          nParts;         // Number of non-empty partitions
+            } kernel_t;
+
+        protected:
+            void                apply_partition(const float *conv, size_t part, float * const *spec, size_t rank, size_t off);
+
+        private:
+            float         **vDataBuffer;            // Buffers for storing convolution tail data, one per output
+            float         **vFrame;                 // Pointers to the beginning of the input data frame, one per input
+            float         **vTaskData;              // Task data for tail convolution, one per input
+            float         **vSpecData;              // Input spectrum of the partition, one per input
+            kernel_t       *vKernels;               // Kernel descriptors
+            float          *vConvBuffer;            // Convolution buffer to restore data
+            float          *vAccBuffer;             // Frequency-domain accumulation buffer
+            float          *vConvData;              // FFT convolution data
+            float          *vDirectData;            // Direct convolution data
+
+            size_t          nInputs;                // Number of inputs
+            size_t          nOutputs;               // Number of outputs
+            size_t          nKernels;               // Overall number of kernels
+            size_t          nDataBufferSize;        // Size of data buffer
+            size_t          nDirectStride;          // Stride of direct convolution data
+            size_t          nFrameSize;             // Size of input data frame
+            size_t          nFrameOff;              // Offset from the beginning of the input data frame
+            size_t          nConvSize;              // The actual convolution size in samples
+            size_t          nLevels;                // Number of raising convolution levels
+            size_t          nBlocks;                // Number of constant-size blocks
+            size_t          nBlocksDone;            // Number of applied constant-size blocks
+            size_t          nRank;                  // The actual rank of the convolution
+            size_t          nBlkInit;               // Initial number of blocks to apply at step # 0
+            float           fBlkCoef;               // The actual coefficient to compute proper block number per formula
+
+            uint8_t        *vData;                  // Non-aligned pointer to the whole allocated data
+
+        public:
+            explicit MultiConvolver();
+            ~MultiConvolver();
+
+            /** Construct the convolver
+             *
+             */
+            void construct();
+
+            /** Destroy convolver
+             *
+             */
+            void destroy();
+
+        public:
+            /** Initialize convolver
+             *
+             * @param data array of inputs*outputs convolution kernels, the kernel
+             *        from input #i to output #j is stored at index i*outputs + j,
+             *        NULL pointers are treated as empty kernels
+             * @param count array of inputs*outputs kernel lengths in samples
+             * @param inputs number of inputs
+             * @param outputs number of outputs
+             * @param rank convolution rank
+             * @param phase initial phase of the frame in range [0..1)
+             * @return true on success
+             */
+            bool init(const float * const *data, const size_t *count, size_t inputs, size_t outputs, size_t rank, float phase);
+
+            /** Process samples
+             *
+             * @param dst array of destination buffers, one per output
+             * @param src array of source buffers, one per input
+             * @param count number of samples to process
+             */
+            void process(float * const *dst, const float * const *src, size_t count);
+
+            /** Get the actual convolution size in samples
+             *
+             * @return actual convolution size in samples (maximum among all kernels)
+             */
+            inline size_t data_size() const             { return nConvSize;     }
+
+            /**
+             * Get actual convolution rank of the convolver
+             * @return convolution rank
+             */
+            inline size_t rank() const                  { return nRank;         }
+
+            /**
+             * Get number of inputs
+             * @return number of inputs
+             */
+            inline size_t inputs() const                { return nInputs;       }
+
+            /**
+             * Get number of outputs
+             * @return number of outputs
+             */
+            inline size_t outputs() const               { return nOutputs;      }
+
+            /**
+             * Dump internal state
+             * @param v state dumper
+             */
+            void dump(IStateDumper *v) const;
+    };
+
+} /* namespace lsp */
+
+#endif /* CORE_UTIL_MULTICONVOLVER_H_ */
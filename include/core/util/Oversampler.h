@@ -69,11 +69,36 @@ namespace lsp
 
         OM_LANCZOS_8X2,
         OM_LANCZOS_8X3,
-        OM_LANCZOS_8X4
+        OM_LANCZOS_8X4,
+
+        OM_FIR_LINEAR_2X,
+        OM_FIR_LINEAR_3X,
+        OM_FIR_LINEAR_4X,
+        OM_FIR_LINEAR_6X,
+        OM_FIR_LINEAR_8X,
+        OM_FIR_LINEAR_16X,
+        OM_FIR_LINEAR_32X,
+
+        OM_FIR_MINPHASE_2X,
+        OM_FIR_MINPHASE_3X,
+        OM_FIR_MINPHASE_4X,
+        OM_FIR_MINPHASE_6X,
+        OM_FIR_MINPHASE_8X,
+        OM_FIR_MINPHASE_16X,
+        OM_FIR_MINPHASE_32X
     };
 
     /** Oversampler class
      *
+     * Lanczos modes perform upsampling by zero-stuffing the input and applying
+     * the Lanczos kernel, downsampling is performed by the optional IIR low-pass
+     * filter followed by decimation.
+     *
+     * FIR modes perform both upsampling and downsampling with polyphase filter banks
+     * of the windowed-sinc low-pass kernel: only non-zero taps are computed
+     * on upsampling and only retained samples are computed on downsampling.
+     * The kernel may be linear-phase or minimum-phase, the last one provides
+     * much lower latency at the cost of non-linear phase response.
      */
     class Oversampler
     {
@@ -90,6 +115,11 @@ namespace lsp
                 UP_ALL          = UP_MODE | UP_OTHER | UP_SAMPLE_RATE
             };
 
+            enum fir_modes_t
+            {
+                FIR_MODES       = OM_FIR_MINPHASE_32X - OM_FIR_LINEAR_2X + 1
+            };
+
         protected:
             IOversamplerCallback   *pCallback;
             float                  *fUpBuffer;
@@ -102,6 +132,26 @@ namespace lsp
             uint8_t                *bData;
             bool                    bFilter;
 
+            float                  *vFirBank;       // Polyphase kernels of all FIR modes computed at initialization
+            float                  *vFirUp;         // Polyphase interpolation kernel of current mode, nFirTaps taps per phase
+            float                  *vFirDown;       // Polyphase decimation kernel of current mode, nFirTaps taps per phase
+            float                  *vFirUpHist;     // Interpolator input: history of nFirTaps-1 samples + current block
+            float                  *vFirDownHist;   // Decimator input history
+            float                  *vFirGather;     // Buffer for gathering phase data
+            float                  *vFirAcc;        // Convolution accumulator
+            size_t                  nFirTaps;       // Number of taps per phase
+            size_t                  nFirLatency;    // Latency of FIR oversampling
+            size_t                  vFirLatency[FIR_MODES]; // Latency of each FIR mode
+
+        protected:
+            static size_t           fir_ratio(size_t mode);
+            static bool             fir_minphase(size_t mode);
+            size_t                  fir_design(size_t mode, float *up, float *down);
+            void                    fir_select();
+            void                    fir_clear();
+            void                    fir_upsample(float *dst, const float *src, size_t samples);
+            void                    fir_downsample(float *dst, const float *src, size_t samples);
+
         public:
             explicit Oversampler();
             virtual ~Oversampler();
@@ -142,15 +192,16 @@ namespace lsp
             {
                 if (mode < OM_NONE)
                     mode = OM_NONE;
-                else if (mode > OM_LANCZOS_8X4)
-                    mode = OM_LANCZOS_8X4;
+                else if (mode > OM_FIR_MINPHASE_32X)
+                    mode = OM_FIR_MINPHASE_32X;
                 if (nMode == mode)
                     return;
                 nMode      = mode;
                 nUpdate   |= UP_MODE;
             }
 
-            /** Enable/disable low-pass filter when performing downsampling
+            /** Enable/disable low-pass filter when performing downsampling,
+             * FIR modes always perform filtering
              *
              * @param filter enables/diables low-pass filter
              */
@@ -225,10 +276,11 @@ namespace lsp
             size_t latency() const;
 
             /**
-             * Get maximum possible latency
+             * Get maximum possible latency among all modes, the linear-phase
+             * FIR modes have the highest latency
              * @return maximum possible latency
              */
-            inline size_t max_latency() const       { return 8; }
+            inline size_t max_latency() const       { return 48; }
 
             /**
              * Dump the state
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_NATIVE_DYNAMICS_H_
+#define DSP_ARCH_NATIVE_DYNAMICS_H_
+
+#ifndef __DSP_NATIVE_IMPL
+    #error "This header should not be included directly"
+#endif /* __DSP_NATIVE_IMPL */
+
+#define DYN_MIN_LEVEL       1.17549435e-38f     /* Minimum normalized float, ln(DYN_MIN_LEVEL) ~ -87.34 */
+
+namespace native
+{
+    static inline float dyn_knee_gain(const dsp::dyn_knee_t *k, float x, float lx)
+    {
+        if (x <= k->start)
+            return k->lo[0]*lx + k->lo[1];
+        if (x >= k->end)
+            return k->hi[0]*lx + k->hi[1];
+        return ((k->herm[0]*lx + k->herm[1])*lx + k->herm[2])*lx + k->herm[3];
+    }
+
+    void dyn_gain_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            float x     = fabs(src[i]);
+            float lx    = logf(lsp_max(x, DYN_MIN_LEVEL));
+            dst[i]      = expf(dyn_knee_gain(k, x, lx));
+        }
+    }
+
+    void dyn_gain_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            float x     = fabs(src[i]);
+            float lx    = logf(lsp_max(x, DYN_MIN_LEVEL));
+            dst[i]      = expf(dyn_knee_gain(&k[0], x, lx) + dyn_knee_gain(&k[1], x, lx));
+        }
+    }
+
+    void dyn_curve_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            float x     = fabs(src[i]);
+            float lx    = logf(lsp_max(x, DYN_MIN_LEVEL));
+            dst[i]      = x * expf(dyn_knee_gain(k, x, lx));
+        }
+    }
+
+    void dyn_curve_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            float x     = fabs(src[i]);
+            float lx    = logf(lsp_max(x, DYN_MIN_LEVEL));
+            dst[i]      = x * expf(dyn_knee_gain(&k[0], x, lx) + dyn_knee_gain(&k[1], x, lx));
+        }
+    }
+}
+
+#undef DYN_MIN_LEVEL
+
+#endif /* DSP_ARCH_NATIVE_DYNAMICS_H_ */
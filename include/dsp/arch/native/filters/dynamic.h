@@ -399,6 +399,26 @@ namespace native
             d          += 4;   // Shift memory pointer by 4 floats
         }
     }
+
+    void dyn_biquad_process_dx1(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f)
+    {
+        while (count--)
+        {
+            double s    = *(src++);
+            double s2   = f->b0*s + d[0];
+            double p1   = f->b1*s + f->a1*s2;
+            double p2   = f->b2*s + f->a2*s2;
+
+            // Shift buffer
+            d[0]        = d[1] + p1;
+            d[1]        = p2;
+
+            // Store result
+            *(dst++)    = s2;
+            f++;
+        }
+    }
+
 }
 
 #endif /* DSP_ARCH_NATIVE_FILTERS_DYNAMIC_H_ */
@@ -386,6 +386,96 @@ namespace native
             d          += 4;
         }
     }
+
+    void biquad_process_dx1(float *dst, const float *src, size_t count, biquad_d_t *f)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            double s    = src[i];
+            double s2   = f->x1.b0*s + f->d[0];
+            double p1   = f->x1.b1*s + f->x1.a1*s2;
+            double p2   = f->x1.b2*s + f->x1.a2*s2;
+
+            dst[i]      = s2;
+
+            // Shift buffer
+            f->d[0]     = f->d[1] + p1;
+            f->d[1]     = p2;
+        }
+    }
+
+    void biquad_process_dx2(float *dst, const float *src, size_t count, biquad_d_t *f)
+    {
+        if (count <= 0)
+            return;
+
+        double s, r, s2, r2, p1, q1, p2, q2;
+
+        // First filter only
+        s           = *(src++);
+        s2          = f->x2.b0[0]*s + f->d[0];
+        p1          = f->x2.b1[0]*s + f->x2.a1[0]*s2;
+        p2          = f->x2.b2[0]*s + f->x2.a2[0]*s2;
+        r           = s2;
+        f->d[0]     = f->d[2] + p1;
+        f->d[2]     = p2;
+
+        // Both filters
+        for (size_t i=1; i<count; ++i)
+        {
+            s           = *(src++);
+            r2          = f->x2.b0[1]*r + f->d[1];
+            s2          = f->x2.b0[0]*s + f->d[0];
+
+            q1          = f->x2.b1[1]*r + f->x2.a1[1]*r2;
+            p1          = f->x2.b1[0]*s + f->x2.a1[0]*s2;
+            q2          = f->x2.b2[1]*r + f->x2.a2[1]*r2;
+            p2          = f->x2.b2[0]*s + f->x2.a2[0]*s2;
+
+            r           = s2;
+            *(dst++)    = r2;
+
+            // Shift buffers
+            f->d[1]     = f->d[3] + q1;
+            f->d[0]     = f->d[2] + p1;
+            f->d[3]     = q2;
+            f->d[2]     = p2;
+        }
+
+        // Second filter only
+        r2          = f->x2.b0[1]*r + f->d[1];
+        q1          = f->x2.b1[1]*r + f->x2.a1[1]*r2;
+        q2          = f->x2.b2[1]*r + f->x2.a2[1]*r2;
+        *dst        = r2;
+        f->d[1]     = f->d[3] + q1;
+        f->d[3]     = q2;
+    }
+
+    void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f)
+    {
+        float s[2], s2[2];
+
+        for (size_t i=0; i<count; ++i)
+        {
+            s[0]        = src[0];
+            s[1]        = src[1];
+
+            s2[0]       = f->x2.b0[0]*s[0] + f->d[0];
+            s2[1]       = f->x2.b0[1]*s[1] + f->d[1];
+
+            dst[0]      = s2[0];
+            dst[1]      = s2[1];
+
+            // Shift buffers
+            f->d[0]     = f->d[2] + f->x2.b1[0]*s[0] + f->x2.a1[0]*s2[0];
+            f->d[1]     = f->d[3] + f->x2.b1[1]*s[1] + f->x2.a1[1]*s2[1];
+            f->d[2]     = f->x2.b2[0]*s[0] + f->x2.a2[0]*s2[0];
+            f->d[3]     = f->x2.b2[1]*s[1] + f->x2.a2[1]*s2[1];
+
+            src        += 2;
+            dst        += 2;
+        }
+    }
 }
 
 #endif /* DSP_ARCH_NATIVE_FILTERS_STATIC_H_ */
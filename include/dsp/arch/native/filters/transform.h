@@ -294,6 +294,45 @@ namespace native
         }
     }
 
+    void bilinear_transform_dx1(biquad_dx1_t *bf, const f_cascade_t *bc, double kf, size_t count)
+    {
+        if (count <= 0)
+            return;
+
+        double T[4], B[4], N;
+        double kf2      = kf * kf;
+
+        while (count--)
+        {
+            // Calculate top coefficients
+            T[0]            = bc->t[0];
+            T[1]            = bc->t[1]*kf;
+            T[2]            = bc->t[2]*kf2;
+
+            // Calculate bottom coefficients
+            B[0]            = bc->b[0];
+            B[1]            = bc->b[1]*kf;
+            B[2]            = bc->b[2]*kf2;
+
+            // Calculate the convolution
+            N               = 1.0 / (B[0] + B[1] + B[2]);
+
+            // Initialize filter parameters
+            bf->b0          = (T[0] + T[1] + T[2]) * N;
+            bf->b1          = 2.0 * (T[0] - T[2]) * N;
+            bf->b2          = (T[0] - T[1] + T[2]) * N;
+            bf->a1          = 2.0 * (B[2] - B[0]) * N;  // Sign negated
+            bf->a2          = (B[1] - B[2] - B[0]) * N; // Sign negated
+            bf->p0          = 0.0;
+            bf->p1          = 0.0;
+            bf->p2          = 0.0;
+
+            // Increment pointers
+            bc              ++;
+            bf              ++;
+        }
+    }
+
     static void matched_solve(float *p, float kf, float td, size_t count, size_t stride)
     {
         if (p[2] == 0.0) // Test polynom for second-order
@@ -303,6 +303,65 @@ namespace avx
 
         fastconv_reverse_butterfly_last_adding_fma3(dst, tmp, ak, wk, np);
     }
+    void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank)
+    {
+        size_t nb = 1 << (rank - 3);
+
+        ARCH_X86_ASM
+        (
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vmovups         0x00(%[c1]), %%ymm0")           /* ymm0 = r */
+            __ASM_EMIT("vmovups         0x20(%[c1]), %%ymm1")           /* ymm1 = i */
+            __ASM_EMIT("vmulps          0x00(%[c2]), %%ymm0, %%ymm2")   /* ymm2 = r*R */
+            __ASM_EMIT("vmulps          0x20(%[c2]), %%ymm1, %%ymm3")   /* ymm3 = i*I */
+            __ASM_EMIT("vmulps          0x20(%[c2]), %%ymm0, %%ymm0")   /* ymm0 = r*I */
+            __ASM_EMIT("vmulps          0x00(%[c2]), %%ymm1, %%ymm1")   /* ymm1 = i*R */
+            __ASM_EMIT("vsubps          %%ymm3, %%ymm2, %%ymm2")        /* ymm2 = r*R - i*I */
+            __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm0")        /* ymm0 = r*I + i*R */
+            __ASM_EMIT("vaddps          0x00(%[dst]), %%ymm2, %%ymm2")  /* ymm2 = dr + r*R - i*I */
+            __ASM_EMIT("vaddps          0x20(%[dst]), %%ymm0, %%ymm0")  /* ymm0 = di + r*I + i*R */
+            __ASM_EMIT("vmovups         %%ymm2, 0x00(%[dst])")
+            __ASM_EMIT("vmovups         %%ymm0, 0x20(%[dst])")
+            __ASM_EMIT("add             $0x40, %[c1]")
+            __ASM_EMIT("add             $0x40, %[c2]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("dec             %[nb]")
+            __ASM_EMIT("jnz             1b")
+            : [dst] "+r" (dst), [c1] "+r" (c1), [c2] "+r" (c2), [nb] "+r" (nb)
+            :
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3"
+        );
+    }
+
+    void fastconv_fmadd_fma3(float *dst, const float *c1, const float *c2, size_t rank)
+    {
+        size_t nb = 1 << (rank - 3);
+
+        ARCH_X86_ASM
+        (
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vmovups         0x00(%[c1]), %%ymm0")           /* ymm0 = r */
+            __ASM_EMIT("vmovups         0x20(%[c1]), %%ymm1")           /* ymm1 = i */
+            __ASM_EMIT("vmovups         0x00(%[dst]), %%ymm2")          /* ymm2 = dr */
+            __ASM_EMIT("vmovups         0x20(%[dst]), %%ymm3")          /* ymm3 = di */
+            __ASM_EMIT("vfmadd231ps     0x00(%[c2]), %%ymm0, %%ymm2")   /* ymm2 = dr + r*R */
+            __ASM_EMIT("vfmadd231ps     0x20(%[c2]), %%ymm0, %%ymm3")   /* ymm3 = di + r*I */
+            __ASM_EMIT("vfnmadd231ps    0x20(%[c2]), %%ymm1, %%ymm2")   /* ymm2 = dr + r*R - i*I */
+            __ASM_EMIT("vfmadd231ps     0x00(%[c2]), %%ymm1, %%ymm3")   /* ymm3 = di + r*I + i*R */
+            __ASM_EMIT("vmovups         %%ymm2, 0x00(%[dst])")
+            __ASM_EMIT("vmovups         %%ymm3, 0x20(%[dst])")
+            __ASM_EMIT("add             $0x40, %[c1]")
+            __ASM_EMIT("add             $0x40, %[c2]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("dec             %[nb]")
+            __ASM_EMIT("jnz             1b")
+            : [dst] "+r" (dst), [c1] "+r" (c1), [c2] "+r" (c2), [nb] "+r" (nb)
+            :
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3"
+        );
+    }
 }
 
 #endif /* DSP_ARCH_X86_AVX_FASTCONV_H_ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX2_DYNAMICS_H_
+#define DSP_ARCH_X86_AVX2_DYNAMICS_H_
+
+#ifndef DSP_ARCH_X86_AVX2_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX2_IMPL */
+
+#ifdef ARCH_X86_64
+
+namespace avx2
+{
+    #define X8VEC(x)    x, x, x, x, x, x, x, x
+
+    IF_ARCH_X86(
+        static const float DYN_CONST[] __lsp_aligned32 =
+        {
+            X8VEC(126.0f),              // Maximum power of 2
+            X8VEC(-126.0f),             // Minimum power of 2
+            X8VEC(1.17549435e-38f)      // Minimum level for logarithm
+        };
+    )
+
+    #undef X8VEC
+
+    /*
+     * Knee parameters are broadcasted to the array of 8-element vectors:
+     *   0x000: start, 0x020: end, 0x040: lo[0], 0x060: lo[1],
+     *   0x080: herm[0], 0x0a0: herm[1], 0x0c0: herm[2], 0x0e0: herm[3],
+     *   0x100: hi[0], 0x120: hi[1]
+     */
+    #define DYN_KNEE_VSIZE      (10 * 8)
+
+    #define DYN_KNEE_X8(K) \
+        /* ymm0 = lx, ymm7 = x */ \
+        __ASM_EMIT("vmulps          " K "+0x040(%[kp]), %%ymm0, %%ymm4")            /* ymm4 = lo[0]*lx */ \
+        __ASM_EMIT("vmulps          " K "+0x100(%[kp]), %%ymm0, %%ymm5")            /* ymm5 = hi[0]*lx */ \
+        __ASM_EMIT("vmulps          " K "+0x080(%[kp]), %%ymm0, %%ymm1")            /* ymm1 = h0*lx */ \
+        __ASM_EMIT("vaddps          " K "+0x060(%[kp]), %%ymm4, %%ymm4")            /* ymm4 = LO = lo[0]*lx + lo[1] */ \
+        __ASM_EMIT("vaddps          " K "+0x120(%[kp]), %%ymm5, %%ymm5")            /* ymm5 = HI = hi[0]*lx + hi[1] */ \
+        __ASM_EMIT("vaddps          " K "+0x0a0(%[kp]), %%ymm1, %%ymm1")            /* ymm1 = h0*lx + h1 */ \
+        __ASM_EMIT("vcmpps          $2, " K "+0x000(%[kp]), %%ymm7, %%ymm2")        /* ymm2 = [x <= start] */ \
+        __ASM_EMIT("vmulps          %%ymm0, %%ymm1, %%ymm1")                        /* ymm1 = (h0*lx + h1)*lx */ \
+        __ASM_EMIT("vcmpps          $5, " K "+0x020(%[kp]), %%ymm7, %%ymm3")        /* ymm3 = [x >= end] */ \
+        __ASM_EMIT("vaddps          " K "+0x0c0(%[kp]), %%ymm1, %%ymm1")            /* ymm1 = (h0*lx + h1)*lx + h2 */ \
+        __ASM_EMIT("vmulps          %%ymm0, %%ymm1, %%ymm1")                        /* ymm1 = ((h0*lx + h1)*lx + h2)*lx */ \
+        __ASM_EMIT("vaddps          " K "+0x0e0(%[kp]), %%ymm1, %%ymm1")            /* ymm1 = H = ((h0*lx + h1)*lx + h2)*lx + h3 */ \
+        __ASM_EMIT("vblendvps       %%ymm3, %%ymm5, %%ymm1, %%ymm1")                /* ymm1 = [x >= end] ? HI : H */ \
+        __ASM_EMIT("vblendvps       %%ymm2, %%ymm4, %%ymm1, %%ymm1")                /* ymm1 = G = [x <= start] ? LO : ([x >= end] ? HI : H) */
+
+    #define DYN_LOGE_X8 \
+        /* ymm0 = x */ \
+        __ASM_EMIT("vandps          0x000 + %[E2C], %%ymm0, %%ymm0")                /* ymm0 = fabs(x) */ \
+        __ASM_EMIT("vmovaps         %%ymm0, %%ymm7")                                /* ymm7 = fabs(x) */ \
+        __ASM_EMIT("vmaxps          0x040 + %[DC], %%ymm0, %%ymm0")                 /* ymm0 = max(fabs(x), FLT_MIN) */ \
+        LOGN_CORE_X8 \
+        __ASM_EMIT("vaddps          %%ymm0, %%ymm0, %%ymm0") \
+        __ASM_EMIT("vmulps          0x000 + %[LOGC], %%ymm1, %%ymm1") \
+        __ASM_EMIT("vaddps          %%ymm1, %%ymm0, %%ymm0")                        /* ymm0 = lx = ln(fabs(x)) */
+
+    #define DYN_EXP_X8 \
+        /* ymm1 = G */ \
+        __ASM_EMIT("vmulps          %[LOG2E], %%ymm1, %%ymm0")                      /* ymm0 = G * log2(E) */ \
+        __ASM_EMIT("vminps          0x000 + %[DC], %%ymm0, %%ymm0") \
+        __ASM_EMIT("vmaxps          0x020 + %[DC], %%ymm0, %%ymm0") \
+        POW2_CORE_X8                                                                /* ymm0 = exp(G) */
+
+    #define DYN_GAIN_BODY(KNEES, CURVE) \
+        ARCH_X86_ASM( \
+            __ASM_EMIT("test            %[count], %[count]") \
+            __ASM_EMIT("jz              2f") \
+            __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovups         0x00(%[src]), %%ymm0") \
+            DYN_LOGE_X8 \
+            KNEES \
+            DYN_EXP_X8 \
+            CURVE \
+            __ASM_EMIT("vmovups         %%ymm0, 0x00(%[dst])") \
+            __ASM_EMIT("add             $0x20, %[src]") \
+            __ASM_EMIT("add             $0x20, %[dst]") \
+            __ASM_EMIT("sub             $8, %[count]") \
+            __ASM_EMIT("jnz             1b") \
+            __ASM_EMIT("2:") \
+            __ASM_EMIT("vzeroupper") \
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count) \
+            : [kp] "r" (kp), \
+              [L2C] "o" (LOG2_CONST), \
+              [LOGC] "o" (LOGE_C), \
+              [E2C] "o" (EXP2_CONST), \
+              [LOG2E] "m" (EXP_LOG2E), \
+              [DC] "o" (DYN_CONST) \
+            : "cc", "memory", \
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7" \
+        );
+
+    #define DYN_KNEE_X1 \
+        DYN_KNEE_X8("0x000")
+
+    #define DYN_KNEE_X2 \
+        DYN_KNEE_X8("0x000") \
+        __ASM_EMIT("vmovaps         %%ymm1, %%ymm6")                                /* ymm6 = G1 */ \
+        DYN_KNEE_X8("0x140") \
+        __ASM_EMIT("vaddps          %%ymm6, %%ymm1, %%ymm1")                        /* ymm1 = G1 + G2 */
+
+    #define DYN_CURVE \
+        __ASM_EMIT("vmulps          %%ymm7, %%ymm0, %%ymm0")                        /* ymm0 = x * exp(G) */
+
+    #define DYN_GAIN
+
+    static inline void dyn_knee_broadcast(float *dst, const dsp::dyn_knee_t *k)
+    {
+        const float *v = &k->start;
+        for (size_t i=0; i<10; ++i, dst += 8)
+        {
+            float x     = v[i];
+            dst[0]      = x;
+            dst[1]      = x;
+            dst[2]      = x;
+            dst[3]      = x;
+            dst[4]      = x;
+            dst[5]      = x;
+            dst[6]      = x;
+            dst[7]      = x;
+        }
+    }
+
+    #define DYN_GAIN_FUNC(name, knees, KNEES, CURVE) \
+        static void name ## _core(float *dst, const float *src, const float *kp, size_t count) \
+        { \
+            DYN_GAIN_BODY(KNEES, CURVE) \
+        } \
+        \
+        void name(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count) \
+        { \
+            float kp[DYN_KNEE_VSIZE * knees] __lsp_aligned32; \
+            float tmp[8] __lsp_aligned32; \
+            \
+            for (size_t i=0; i<knees; ++i) \
+                dyn_knee_broadcast(&kp[i * DYN_KNEE_VSIZE], &k[i]); \
+            \
+            size_t n    = count & (~size_t(7)); \
+            name ## _core(dst, src, kp, n); \
+            count      -= n; \
+            if (count == 0) \
+                return; \
+            \
+            /* Process the tail */ \
+            dsp::fill_zero(tmp, 8); \
+            dsp::copy(tmp, &src[n], count); \
+            name ## _core(tmp, tmp, kp, 8); \
+            dsp::copy(&dst[n], tmp, count); \
+        }
+
+    DYN_GAIN_FUNC(x64_dyn_gain_x1, 1, DYN_KNEE_X1, DYN_GAIN)
+    DYN_GAIN_FUNC(x64_dyn_gain_x2, 2, DYN_KNEE_X2, DYN_GAIN)
+    DYN_GAIN_FUNC(x64_dyn_curve_x1, 1, DYN_KNEE_X1, DYN_CURVE)
+    DYN_GAIN_FUNC(x64_dyn_curve_x2, 2, DYN_KNEE_X2, DYN_CURVE)
+
+    #undef DYN_GAIN_FUNC
+    #undef DYN_GAIN
+    #undef DYN_CURVE
+    #undef DYN_KNEE_X2
+    #undef DYN_KNEE_X1
+    #undef DYN_GAIN_BODY
+    #undef DYN_EXP_X8
+    #undef DYN_LOGE_X8
+    #undef DYN_KNEE_X8
+    #undef DYN_KNEE_VSIZE
+}
+
+#endif /* ARCH_X86_64 */
+
+#endif /* DSP_ARCH_X86_AVX2_DYNAMICS_H_ */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_CONVOLUTION_H_
+#define DSP_ARCH_X86_AVX512_CONVOLUTION_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+namespace avx512
+{
+    /**
+     * Convolve 4 source samples with the kernel: dst[j] += k0*c[j] + k1*c[j-1] + k2*c[j-2] + k3*c[j-3]
+     *
+     * @param dst destination buffer
+     * @param k four source samples, unused samples should be zero
+     * @param conv convolution kernel
+     * @param length length of the convolution kernel
+     * @param nk number of valid source samples in range [1..4]
+     */
+    static inline void convolve_x4(float *dst, const float *k, const float *conv, size_t length, size_t nk)
+    {
+        // The tail of the kernel is processed with opmask registers
+        size_t tail     = length & 0x0f;
+        size_t lanes    = tail + nk - 1;
+        size_t mload    = (1 << tail) - 1;
+        size_t mtail    = (lanes > 16) ? 0xffff : (1 << lanes) - 1;
+        size_t mextra   = (lanes > 16) ? (1 << (lanes - 16)) - 1 : 0;
+
+        ARCH_X86_64_ASM(
+            __ASM_EMIT("vbroadcastss        0x00(%[k]), %%zmm0")                // zmm0 = k0
+            __ASM_EMIT("vbroadcastss        0x04(%[k]), %%zmm1")                // zmm1 = k1
+            __ASM_EMIT("vbroadcastss        0x08(%[k]), %%zmm2")                // zmm2 = k2
+            __ASM_EMIT("vbroadcastss        0x0c(%[k]), %%zmm3")                // zmm3 = k3
+            __ASM_EMIT("vpxord              %%zmm7, %%zmm7, %%zmm7")            // zmm7 = p = 0
+            // 16x convolution
+            __ASM_EMIT("sub                 $16, %[length]")
+            __ASM_EMIT("jb                  2f")
+            __ASM_EMIT(".align              16")
+            __ASM_EMIT("1:")
+                __ASM_EMIT("vmovups             0x00(%[c]), %%zmm4")                // zmm4 = c0 c1 ... c15
+                __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")       // zmm5 = p15 c0 ... c14
+                __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm6")       // zmm6 = p14 p15 c0 ... c13
+                __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm7")       // zmm7 = p13 p14 p15 c0 ... c12
+                __ASM_EMIT("vmovups             0x00(%[d]), %%zmm8")                // zmm8 = d
+                __ASM_EMIT("vmulps              %%zmm3, %%zmm7, %%zmm9")            // zmm9 = k3*p13 ...
+                __ASM_EMIT("vfmadd231ps         %%zmm0, %%zmm4, %%zmm8")            // zmm8 = d + k0*c0 ...
+                __ASM_EMIT("vfmadd231ps         %%zmm2, %%zmm6, %%zmm9")            // zmm9 = k2*p14 + k3*p13 ...
+                __ASM_EMIT("vfmadd231ps         %%zmm1, %%zmm5, %%zmm8")            // zmm8 = d + k0*c0 + k1*p15 ...
+                __ASM_EMIT("vmovaps             %%zmm4, %%zmm7")                    // zmm7 = p = c
+                __ASM_EMIT("vaddps              %%zmm9, %%zmm8, %%zmm8")            // zmm8 = d + k0*c0 + k1*p15 + k2*p14 + k3*p13 ...
+                __ASM_EMIT("vmovups             %%zmm8, 0x00(%[d])")
+                __ASM_EMIT("add                 $0x40, %[c]")                       // c += 16
+                __ASM_EMIT("add                 $0x40, %[d]")                       // d += 16
+                __ASM_EMIT("sub                 $16, %[length]")                    // length -= 16
+                __ASM_EMIT("jae                 1b")
+            __ASM_EMIT("2:")
+            // Tail of the kernel
+            __ASM_EMIT("kmovw               %k[mload], %%k1")
+            __ASM_EMIT("kmovw               %k[mtail], %%k2")
+            __ASM_EMIT("vmovups             0x00(%[c]), %%zmm4 %{%%k1%}%{z%}")  // zmm4 = c0 c1 ... 0
+            __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")
+            __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm6")
+            __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm7")
+            __ASM_EMIT("vmovups             0x00(%[d]), %%zmm8 %{%%k2%}%{z%}")
+            __ASM_EMIT("vmulps              %%zmm3, %%zmm7, %%zmm9")
+            __ASM_EMIT("vfmadd231ps         %%zmm0, %%zmm4, %%zmm8")
+            __ASM_EMIT("vfmadd231ps         %%zmm2, %%zmm6, %%zmm9")
+            __ASM_EMIT("vfmadd231ps         %%zmm1, %%zmm5, %%zmm8")
+            __ASM_EMIT("vmovaps             %%zmm4, %%zmm7")
+            __ASM_EMIT("vaddps              %%zmm9, %%zmm8, %%zmm8")
+            __ASM_EMIT("vmovups             %%zmm8, 0x00(%[d]) %{%%k2%}")
+            // Samples that come out of the last 16-sample block
+            __ASM_EMIT("test                %[mextra], %[mextra]")
+            __ASM_EMIT("jz                  4f")
+            __ASM_EMIT("kmovw               %k[mextra], %%k2")
+            __ASM_EMIT("vpxord              %%zmm4, %%zmm4, %%zmm4")            // zmm4 = 0
+            __ASM_EMIT("valignd             $15, %%zmm7, %%zmm4, %%zmm5")
+            __ASM_EMIT("valignd             $14, %%zmm7, %%zmm4, %%zmm6")
+            __ASM_EMIT("valignd             $13, %%zmm7, %%zmm4, %%zmm7")
+            __ASM_EMIT("vmovups             0x40(%[d]), %%zmm8 %{%%k2%}%{z%}")
+            __ASM_EMIT("vmulps              %%zmm3, %%zmm7, %%zmm9")
+            __ASM_EMIT("vfmadd231ps         %%zmm2, %%zmm6, %%zmm9")
+            __ASM_EMIT("vfmadd231ps         %%zmm1, %%zmm5, %%zmm8")
+            __ASM_EMIT("vaddps              %%zmm9, %%zmm8, %%zmm8")
+            __ASM_EMIT("vmovups             %%zmm8, 0x40(%[d]) %{%%k2%}")
+            __ASM_EMIT("4:")
+            __ASM_EMIT("vzeroupper")
+
+            : [c] "+r" (conv), [d] "+r" (dst), [length] "+r" (length)
+            : [k] "r" (k),
+              [mload] "r" (mload), [mtail] "r" (mtail), [mextra] "r" (mextra)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9",
+              "%k1", "%k2"
+        );
+    }
+
+    void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count)
+    {
+        if (length <= 0)
+            return;
+
+        // 4x blocks of source samples
+        for ( ; count >= 4; count -= 4)
+        {
+            convolve_x4(dst, src, conv, length, 4);
+            src        += 4;
+            dst        += 4;
+        }
+
+        // Source tail is padded with zeros
+        if (count > 0)
+        {
+            float k[4];
+            for (size_t i=0; i<4; ++i)
+                k[i]        = (i < count) ? src[i] : 0.0f;
+            convolve_x4(dst, k, conv, length, count);
+        }
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_CONVOLUTION_H_ */
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FASTCONV_H_
+#define DSP_ARCH_X86_AVX512_FASTCONV_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+// The first and the last stages are shared with the AVX implementation
+#define DSP_ARCH_X86_AVX_IMPL
+    #include <dsp/arch/x86/avx/fft/const.h>
+    #include <dsp/arch/x86/avx/fastconv/prepare.h>
+    #include <dsp/arch/x86/avx/fastconv/butterfly.h>
+    #include <dsp/arch/x86/avx/fastconv/apply.h>
+#undef DSP_ARCH_X86_AVX_IMPL
+
+#include <dsp/arch/x86/avx512/fft/const.h>
+#include <dsp/arch/x86/avx512/fastconv/butterfly.h>
+
+namespace avx512
+{
+    void fastconv_parse(float *dst, const float *src, size_t rank)
+    {
+        const float *ak = &avx::FFT_A[(rank - 3) << 4];
+        const float *wk = &avx::FFT_DW[(rank - 3) << 4];
+        size_t np       = 1 << (rank - 1);
+        size_t nb       = 1;
+
+        if (np > 4)
+        {
+            avx::fastconv_direct_prepare_fma3(dst, src, ak, wk, np);
+            ak         -= 16;
+            wk         -= 16;
+            np        >>= 1;
+            nb        <<= 1;
+        }
+        else
+            avx::fastconv_direct_unpack(dst, src);
+
+        while (np > 4)
+        {
+            fastconv_direct_butterfly(dst, ak, wk, np, nb);
+            ak         -= 16;
+            wk         -= 16;
+            np        >>= 1;
+            nb        <<= 1;
+        }
+
+        avx::fastconv_direct_butterfly_last_fma3(dst, nb);
+    }
+
+    void fastconv_restore(float *dst, float *tmp, size_t rank)
+    {
+        size_t nb = 1 << (rank - 3), np = 4;
+        const float *ak = avx::FFT_A;
+        const float *wk = avx::FFT_DW;
+
+        avx::fastconv_reverse_prepare_fma3(tmp, nb);
+        if ((nb >>= 1) <= 0)
+        {
+            avx::fastconv_reverse_unpack(dst, tmp, rank);
+            return;
+        }
+        ak     += 16;
+        wk     += 16;
+        np    <<= 1;
+
+        while (nb > 1)
+        {
+            fastconv_reverse_butterfly(tmp, ak, wk, np, nb);
+            ak     += 16;
+            wk     += 16;
+            np    <<= 1;
+            nb    >>= 1;
+        }
+
+        avx::fastconv_reverse_butterfly_last_fma3(dst, tmp, ak, wk, np);
+    }
+
+    void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank)
+    {
+        size_t nb = 1 << (rank - 3), np = 4;
+        const float *ak = avx::FFT_A;
+        const float *wk = avx::FFT_DW;
+
+        avx::fastconv_apply_prepare_fma3(tmp, c1, c2, nb);
+        if ((nb >>= 1) <= 0)
+        {
+            avx::fastconv_reverse_unpack_adding(dst, tmp, rank);
+            return;
+        }
+        ak     += 16;
+        wk     += 16;
+        np    <<= 1;
+
+        while (nb > 1)
+        {
+            fastconv_reverse_butterfly(tmp, ak, wk, np, nb);
+            ak     += 16;
+            wk     += 16;
+            np    <<= 1;
+            nb    >>= 1;
+        }
+
+        avx::fastconv_reverse_butterfly_last_adding_fma3(dst, tmp, ak, wk, np);
+    }
+
+    void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank)
+    {
+        const float *ak = &avx::FFT_A[(rank - 3) << 4];
+        const float *wk = &avx::FFT_DW[(rank - 3) << 4];
+        size_t np       = 1 << (rank - 1);
+        size_t nb       = 1;
+
+        if (np > 4)
+        {
+            avx::fastconv_direct_prepare_fma3(tmp, src, ak, wk, np);
+            ak         -= 16;
+            wk         -= 16;
+            np        >>= 1;
+            nb        <<= 1;
+        }
+        else
+            avx::fastconv_direct_unpack(tmp, src);
+
+        while (np > 4)
+        {
+            fastconv_direct_butterfly(tmp, ak, wk, np, nb);
+            ak         -= 16;
+            wk         -= 16;
+            np        >>= 1;
+            nb        <<= 1;
+        }
+
+        avx::fastconv_apply_internal_fma3(tmp, c, nb);
+
+        if ((nb >>= 1) <= 0)
+        {
+            avx::fastconv_reverse_unpack_adding(dst, tmp, rank);
+            return;
+        }
+        ak     += 16;
+        wk     += 16;
+        np    <<= 1;
+
+        while (nb > 1)
+        {
+            fastconv_reverse_butterfly(tmp, ak, wk, np, nb);
+            ak     += 16;
+            wk     += 16;
+            np    <<= 1;
+            nb    >>= 1;
+        }
+
+        avx::fastconv_reverse_butterfly_last_adding_fma3(dst, tmp, ak, wk, np);
+    }
+
+    void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank)
+    {
+        size_t nb = 1 << (rank - 3);
+
+        ARCH_X86_64_ASM
+        (
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vmovups         0x00(%[c1]), %%zmm0")           /* zmm0 = r i */
+            __ASM_EMIT("vmovups         0x00(%[c2]), %%zmm1")           /* zmm1 = R I */
+            __ASM_EMIT("vmovups         0x00(%[dst]), %%zmm5")          /* zmm5 = dr di */
+            __ASM_EMIT("vshuff64x2      $0x44, %%zmm0, %%zmm0, %%zmm2") /* zmm2 = r r */
+            __ASM_EMIT("vshuff64x2      $0xee, %%zmm0, %%zmm0, %%zmm3") /* zmm3 = i i */
+            __ASM_EMIT("vshuff64x2      $0x4e, %%zmm1, %%zmm1, %%zmm4") /* zmm4 = I R */
+            __ASM_EMIT("vpxord          %[XSIGN], %%zmm4, %%zmm4")      /* zmm4 = I -R */
+            __ASM_EMIT("vfmadd231ps     %%zmm2, %%zmm1, %%zmm5")        /* zmm5 = dr+r*R di+r*I */
+            __ASM_EMIT("vfnmadd231ps    %%zmm3, %%zmm4, %%zmm5")        /* zmm5 = dr+r*R-i*I di+r*I+i*R */
+            __ASM_EMIT("vmovups         %%zmm5, 0x00(%[dst])")
+            __ASM_EMIT("add             $0x40, %[c1]")
+            __ASM_EMIT("add             $0x40, %[c2]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("dec             %[nb]")
+            __ASM_EMIT("jnz             1b")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [c1] "+r" (c1), [c2] "+r" (c2), [nb] "+r" (nb)
+            : [XSIGN] "o" (FFT_XSIGN)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5"
+        );
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_FASTCONV_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_
+#define DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+#include <dsp/arch/x86/avx512/fft/p_butterfly.h>
+
+namespace avx512
+{
+    /*
+     * Intermediate butterflies of the fast convolution have the same packed layout
+     * as the packed FFT, so the packed FFT loop bodies are reused:
+     *   direct:  c = a - b, a' = a + b, b' = c * conj(w)
+     *   reverse: c = b * w, a' = a + c, b' = a - c
+     */
+    static inline void fastconv_direct_butterfly(float *dst, const float *ak, const float *wk, size_t pairs, size_t nb)
+    {
+        const float *fft_a  = ak;
+        const float *fft_w  = wk;
+
+        if (pairs <= 8)
+        {
+            FFT_PBUTTERFLY_BODY8(FFT_PBUTTERFLY_MUL_LAST, "vfmadd231ps");
+            return;
+        }
+
+        size_t off1 = 0, shift = pairs << 3;
+        for (size_t b=0; b<nb; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_PBUTTERFLY_BODY16(FFT_PBUTTERFLY_MUL_LAST, "vfmadd231ps");
+
+            off1        = off2;
+        }
+    }
+
+    static inline void fastconv_reverse_butterfly(float *dst, const float *ak, const float *wk, size_t pairs, size_t nb)
+    {
+        const float *fft_a  = ak;
+        const float *fft_w  = wk;
+
+        if (pairs <= 8)
+        {
+            FFT_PBUTTERFLY_BODY8(FFT_PBUTTERFLY_MUL_FIRST, "vfnmadd231ps");
+            return;
+        }
+
+        size_t off1 = 0, shift = pairs << 3;
+        for (size_t b=0; b<nb; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_PBUTTERFLY_BODY16(FFT_PBUTTERFLY_MUL_FIRST, "vfnmadd231ps");
+
+            off1        = off2;
+        }
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_FASTCONV_BUTTERFLY_H_ */
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FFT_H_
+#define DSP_ARCH_X86_AVX512_FFT_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+// Scrambling and the first butterfly stage are shared with the AVX implementation
+#define DSP_ARCH_X86_AVX_IMPL
+    #include <dsp/arch/x86/avx/fft/const.h>
+    #include <dsp/arch/x86/avx/fft/butterfly.h>
+
+    #define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct8_fma3
+    #define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse8_fma3
+    #define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct8_fma3
+    #define FFT_SCRAMBLE_COPY_REVERSE_NAME  scramble_copy_reverse8_fma3
+    #define FFT_TYPE                        uint8_t
+    #define FFT_FMA(a, b)                   b
+    #include <dsp/arch/x86/avx/fft/scramble.h>
+
+    #define FFT_SCRAMBLE_SELF_DIRECT_NAME   scramble_self_direct16_fma3
+    #define FFT_SCRAMBLE_SELF_REVERSE_NAME  scramble_self_reverse16_fma3
+    #define FFT_SCRAMBLE_COPY_DIRECT_NAME   scramble_copy_direct16_fma3
+    #define FFT_SCRAMBLE_COPY_REVERSE_NAME  scramble_copy_reverse16_fma3
+    #define FFT_TYPE                        uint16_t
+    #define FFT_FMA(a, b)                   b
+    #include <dsp/arch/x86/avx/fft/scramble.h>
+#undef DSP_ARCH_X86_AVX_IMPL
+
+#include <dsp/arch/x86/avx512/fft/const.h>
+#include <dsp/arch/x86/avx512/fft/butterfly.h>
+
+namespace avx
+{
+    void direct_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+    void reverse_fft_fma3(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+}
+
+namespace avx512
+{
+    void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+    {
+        // ZMM butterflies require at least 16 pairs, the AVX code is good enough for small transforms
+        if (rank < 5)
+        {
+            avx::direct_fft_fma3(dst_re, dst_im, src_re, src_im, rank);
+            return;
+        }
+
+        if ((dst_re == src_re) || (dst_im == src_im))
+        {
+            dsp::move(dst_re, src_re, 1 << rank);
+            dsp::move(dst_im, src_im, 1 << rank);
+            if (rank <= 8)
+                avx::scramble_self_direct8_fma3(dst_re, dst_im, rank);
+            else
+                avx::scramble_self_direct16_fma3(dst_re, dst_im, rank);
+        }
+        else
+        {
+            if (rank <= 12)
+                avx::scramble_copy_direct8_fma3(dst_re, dst_im, src_re, src_im, rank-4);
+            else
+                avx::scramble_copy_direct16_fma3(dst_re, dst_im, src_re, src_im, rank-4);
+        }
+
+        avx::butterfly_direct8p_fma3(dst_re, dst_im, 3, 1 << (rank - 4));
+        for (size_t i=4; i < rank; ++i)
+            butterfly_direct16p(dst_re, dst_im, i, 1 << (rank - i - 1));
+    }
+
+    void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank)
+    {
+        // ZMM butterflies require at least 16 pairs, the AVX code is good enough for small transforms
+        if (rank < 5)
+        {
+            avx::reverse_fft_fma3(dst_re, dst_im, src_re, src_im, rank);
+            return;
+        }
+
+        if ((dst_re == src_re) || (dst_im == src_im))
+        {
+            dsp::move(dst_re, src_re, 1 << rank);
+            dsp::move(dst_im, src_im, 1 << rank);
+            if (rank <= 8)
+                avx::scramble_self_reverse8_fma3(dst_re, dst_im, rank);
+            else
+                avx::scramble_self_reverse16_fma3(dst_re, dst_im, rank);
+        }
+        else
+        {
+            if (rank <= 12)
+                avx::scramble_copy_reverse8_fma3(dst_re, dst_im, src_re, src_im, rank-4);
+            else
+                avx::scramble_copy_reverse16_fma3(dst_re, dst_im, src_re, src_im, rank-4);
+        }
+
+        avx::butterfly_reverse8p_fma3(dst_re, dst_im, 3, 1 << (rank - 4));
+        for (size_t i=4; i < rank; ++i)
+            butterfly_reverse16p(dst_re, dst_im, i, 1 << (rank - i - 1));
+
+        dsp::normalize_fft2(dst_re, dst_im, rank);
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_FFT_H_ */
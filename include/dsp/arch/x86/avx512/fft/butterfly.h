@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_
+#define DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+/*
+ * The butterfly processes 16 pairs per iteration. The lower 8 angles are taken from
+ * the AVX table and the upper 8 angles are computed by rotating them by the 8-step
+ * angle. The rotation step for 16 pairs is the 8-step angle of the previous rank.
+ */
+#define FFT_BUTTERFLY_BODY16(add_b, add_a) \
+    ARCH_X86_64_ASM \
+    ( \
+        /* Prepare angle */ \
+        __ASM_EMIT("vmovaps         0x00(%[fft_a]), %%ymm6")            /* ymm6 = x_re */ \
+        __ASM_EMIT("vmovaps         0x20(%[fft_a]), %%ymm7")            /* ymm7 = x_im */ \
+        __ASM_EMIT("vmovaps         0x00(%[fft_w]), %%ymm4")            /* ymm4 = w_re */ \
+        __ASM_EMIT("vmovaps         0x20(%[fft_w]), %%ymm5")            /* ymm5 = w_im */ \
+        __ASM_EMIT("vmulps          %%ymm5, %%ymm6, %%ymm2")            /* ymm2 = w_im * x_re */ \
+        __ASM_EMIT("vmulps          %%ymm5, %%ymm7, %%ymm3")            /* ymm3 = w_im * x_im */ \
+        __ASM_EMIT("vfmsub231ps     %%ymm4, %%ymm6, %%ymm3")            /* ymm3 = w_re * x_re - w_im * x_im */ \
+        __ASM_EMIT("vfmadd231ps     %%ymm4, %%ymm7, %%ymm2")            /* ymm2 = w_re * x_im + w_im * x_re */ \
+        __ASM_EMIT("vinsertf64x4    $1, %%ymm3, %%zmm6, %%zmm6")        /* zmm6 = x_re */ \
+        __ASM_EMIT("vinsertf64x4    $1, %%ymm2, %%zmm7, %%zmm7")        /* zmm7 = x_im */ \
+        __ASM_EMIT("vbroadcastss    -0x40(%[fft_w]), %%zmm4")           /* zmm4 = w_re */ \
+        __ASM_EMIT("vbroadcastss    -0x20(%[fft_w]), %%zmm5")           /* zmm5 = w_im */ \
+        /* Start loop */ \
+        __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovups         0x00(%[dst_re], %[off1]), %%zmm0")  /* zmm0 = a_re */ \
+            __ASM_EMIT("vmovups         0x00(%[dst_re], %[off2]), %%zmm2")  /* zmm2 = b_re */ \
+            __ASM_EMIT("vmovups         0x00(%[dst_im], %[off1]), %%zmm1")  /* zmm1 = a_im */ \
+            __ASM_EMIT("vmovups         0x00(%[dst_im], %[off2]), %%zmm3")  /* zmm3 = b_im */ \
+            /* Calculate complex multiplication */ \
+            __ASM_EMIT("vmulps          %%zmm7, %%zmm3, %%zmm8")            /* zmm8 = x_im * b_im */ \
+            __ASM_EMIT("vmulps          %%zmm7, %%zmm2, %%zmm9")            /* zmm9 = x_im * b_re */ \
+            __ASM_EMIT(add_b "          %%zmm6, %%zmm2, %%zmm8")            /* zmm8 = c_re = x_re * b_re +- x_im * b_im */ \
+            __ASM_EMIT(add_a "          %%zmm6, %%zmm3, %%zmm9")            /* zmm9 = c_im = x_re * b_im -+ x_im * b_re */ \
+            /* Perform butterfly */ \
+            __ASM_EMIT("vsubps          %%zmm8, %%zmm0, %%zmm2")            /* zmm2 = a_re - c_re */ \
+            __ASM_EMIT("vsubps          %%zmm9, %%zmm1, %%zmm3")            /* zmm3 = a_im - c_im */ \
+            __ASM_EMIT("vaddps          %%zmm8, %%zmm0, %%zmm0")            /* zmm0 = a_re + c_re */ \
+            __ASM_EMIT("vaddps          %%zmm9, %%zmm1, %%zmm1")            /* zmm1 = a_im + c_im */ \
+            /* Store values */ \
+            __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst_re], %[off1])") \
+            __ASM_EMIT("vmovups         %%zmm2, 0x00(%[dst_re], %[off2])") \
+            __ASM_EMIT("vmovups         %%zmm1, 0x00(%[dst_im], %[off1])") \
+            __ASM_EMIT("vmovups         %%zmm3, 0x00(%[dst_im], %[off2])") \
+            __ASM_EMIT("add             $0x40, %[off1]") \
+            __ASM_EMIT("add             $0x40, %[off2]") \
+            __ASM_EMIT("sub             $16, %[np]") \
+            __ASM_EMIT("jz              2f") \
+            /* Rotate angle */ \
+            __ASM_EMIT("vmulps          %%zmm5, %%zmm6, %%zmm8")            /* zmm8 = w_im * x_re */ \
+            __ASM_EMIT("vmulps          %%zmm5, %%zmm7, %%zmm9")            /* zmm9 = w_im * x_im */ \
+            __ASM_EMIT("vfmsub132ps     %%zmm4, %%zmm9, %%zmm6")            /* zmm6 = x_re' = w_re * x_re - w_im * x_im */ \
+            __ASM_EMIT("vfmadd132ps     %%zmm4, %%zmm8, %%zmm7")            /* zmm7 = x_im' = w_re * x_im + w_im * x_re */ \
+            /* Repeat loop */ \
+        __ASM_EMIT("jmp             1b") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("vzeroupper") \
+        \
+        : [off1] "+r" (off1), [off2] "+r" (off2), [np] "+r" (np) \
+        : [dst_re] "r" (dst_re), [dst_im] "r" (dst_im), [fft_a] "r" (fft_a), [fft_w] "r" (fft_w) \
+        : "cc", "memory",  \
+        "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+        "%xmm4", "%xmm5", "%xmm6", "%xmm7", \
+        "%xmm8", "%xmm9" \
+    );
+
+namespace avx512
+{
+    static inline void butterfly_direct16p(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+    {
+        size_t pairs = 1 << rank;
+        size_t off1 = 0, shift = 4 << rank; // 1 << (rank + 2);
+        const float *fft_a = &avx::FFT_A[(rank - 2) << 4];
+        const float *fft_w = &avx::FFT_DW[(rank - 2) << 4];
+
+        for (size_t b=0; b<blocks; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_BUTTERFLY_BODY16("vfmadd231ps", "vfmsub231ps");
+
+            off1        = off2;
+        }
+    }
+
+    static inline void butterfly_reverse16p(float *dst_re, float *dst_im, size_t rank, size_t blocks)
+    {
+        size_t pairs = 1 << rank;
+        size_t off1 = 0, shift = 4 << rank; // 1 << (rank + 2);
+        const float *fft_a = &avx::FFT_A[(rank - 2) << 4];
+        const float *fft_w = &avx::FFT_DW[(rank - 2) << 4];
+
+        for (size_t b=0; b<blocks; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_BUTTERFLY_BODY16("vfmsub231ps", "vfmadd231ps");
+
+            off1        = off2;
+        }
+    }
+}
+
+#undef FFT_BUTTERFLY_BODY16
+
+#endif /* DSP_ARCH_X86_AVX512_FFT_BUTTERFLY_H_ */
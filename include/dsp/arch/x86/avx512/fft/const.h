@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FFT_CONST_H_
+#define DSP_ARCH_X86_AVX512_FFT_CONST_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+#define X8VEC(v)        v, v, v, v, v, v, v, v
+
+namespace avx512
+{
+    /*
+     * Sign mask for the packed complex layout: the register holds 8 real parts
+     * in the lower half and 8 imaginary parts in the upper half, the mask
+     * negates the upper half only.
+     */
+    static const uint32_t FFT_XSIGN[] __lsp_aligned64 =
+    {
+        X8VEC(0x00000000), X8VEC(0x80000000)
+    };
+}
+
+#undef X8VEC
+
+#endif /* DSP_ARCH_X86_AVX512_FFT_CONST_H_ */
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_FFT_P_BUTTERFLY_H_
+#define DSP_ARCH_X86_AVX512_FFT_P_BUTTERFLY_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+/*
+ * Packed complex data is stored as blocks of 8 real parts followed by 8 imaginary parts,
+ * so one ZMM register holds the whole block. The angle is kept as two registers:
+ *   x_re  = { re[0..7],  re[0..7] }
+ *   x_ims = { im[0..7], -im[0..7] }
+ * and the complex multiplication of the block b by the angle is computed as
+ *   c     = x_re * b +- x_ims * swap(b)
+ * where swap() exchanges the 256-bit halves of the register. The sign selects the
+ * multiplication by the conjugate (direct transform) or by the angle itself (reverse
+ * transform). Rotation of the angle keeps this form when w_ims has the same layout.
+ */
+
+// Load angle for 8 pairs: zmm6 = x_re, zmm7 = x_ims
+#define FFT_PANGLE_LOAD8 \
+    __ASM_EMIT("vbroadcastf64x4 0x00(%[fft_a]), %%zmm6")            /* zmm6 = x_re */ \
+    __ASM_EMIT("vbroadcastf64x4 0x20(%[fft_a]), %%zmm7")            /* zmm7 = x_im */ \
+    __ASM_EMIT("vpxord          %[XSIGN], %%zmm7, %%zmm7")          /* zmm7 = x_ims */
+
+// Load angles for 16 pairs: zmm6, zmm7 = first angle, zmm8, zmm9 = second angle, zmm10, zmm11 = rotation
+#define FFT_PANGLE_LOAD16 \
+    FFT_PANGLE_LOAD8 \
+    __ASM_EMIT("vbroadcastss    0x00(%[fft_w]), %%zmm10")           /* zmm10 = w_re */ \
+    __ASM_EMIT("vbroadcastss    0x20(%[fft_w]), %%zmm11")           /* zmm11 = w_im */ \
+    __ASM_EMIT("vpxord          %[XSIGN], %%zmm11, %%zmm11")        /* zmm11 = w_ims */ \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm7, %%zmm12")          /* zmm12 = w_ims * x_ims */ \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm6, %%zmm13")          /* zmm13 = w_ims * x_re */ \
+    __ASM_EMIT("vmulps          %%zmm10, %%zmm6, %%zmm8")           /* zmm8  = w_re * x_re */ \
+    __ASM_EMIT("vmulps          %%zmm10, %%zmm7, %%zmm9")           /* zmm9  = w_re * x_ims */ \
+    __ASM_EMIT("vsubps          %%zmm12, %%zmm8, %%zmm8")           /* zmm8  = w_re * x_re - w_ims * x_ims */ \
+    __ASM_EMIT("vaddps          %%zmm13, %%zmm9, %%zmm9")           /* zmm9  = w_re * x_ims + w_ims * x_re */ \
+    __ASM_EMIT("vbroadcastss    -0x40(%[fft_w]), %%zmm10")          /* zmm10 = w_re */ \
+    __ASM_EMIT("vbroadcastss    -0x20(%[fft_w]), %%zmm11")          /* zmm11 = w_im */ \
+    __ASM_EMIT("vpxord          %[XSIGN], %%zmm11, %%zmm11")        /* zmm11 = w_ims */
+
+// Rotate both angles by the 16-step angle
+#define FFT_PANGLE_ROTATE16 \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm7, %%zmm12")          /* zmm12 = w_ims * x_ims */ \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm6, %%zmm13")          /* zmm13 = w_ims * x_re */ \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm9, %%zmm14")          /* zmm14 = w_ims * x_ims */ \
+    __ASM_EMIT("vmulps          %%zmm11, %%zmm8, %%zmm15")          /* zmm15 = w_ims * x_re */ \
+    __ASM_EMIT("vfmsub132ps     %%zmm10, %%zmm12, %%zmm6")          /* zmm6 = x_re' = w_re * x_re - w_ims * x_ims */ \
+    __ASM_EMIT("vfmadd132ps     %%zmm10, %%zmm13, %%zmm7")          /* zmm7 = x_ims' = w_re * x_ims + w_ims * x_re */ \
+    __ASM_EMIT("vfmsub132ps     %%zmm10, %%zmm14, %%zmm8") \
+    __ASM_EMIT("vfmadd132ps     %%zmm10, %%zmm15, %%zmm9")
+
+// c = b * x, a' = a + c, b' = a - c
+#define FFT_PBUTTERFLY_MUL_FIRST(A, B, S, XR, XI, add_s) \
+    __ASM_EMIT("vshuff64x2      $0x4e, " B ", " B ", " S)           /* S = swap(b) */ \
+    __ASM_EMIT("vmulps          " XR ", " B ", " B)                 /* B = x_re * b */ \
+    __ASM_EMIT(add_s "          " XI ", " S ", " B)                 /* B = c = x_re * b +- x_ims * swap(b) */ \
+    __ASM_EMIT("vsubps          " B ", " A ", " S)                  /* S = a - c */ \
+    __ASM_EMIT("vaddps          " B ", " A ", " A)                  /* A = a + c */
+
+// c = a - b, a' = a + b, b' = c * x
+#define FFT_PBUTTERFLY_MUL_LAST(A, B, S, XR, XI, add_s) \
+    __ASM_EMIT("vsubps          " B ", " A ", " S)                  /* S = c = a - b */ \
+    __ASM_EMIT("vaddps          " B ", " A ", " A)                  /* A = a + b */ \
+    __ASM_EMIT("vshuff64x2      $0x4e, " S ", " S ", " B)           /* B = swap(c) */ \
+    __ASM_EMIT("vmulps          " XR ", " S ", " S)                 /* S = x_re * c */ \
+    __ASM_EMIT(add_s "          " XI ", " B ", " S)                 /* S = x_re * c +- x_ims * swap(c) */
+
+/*
+ * Single 8-pair butterfly in each block, the angle is constant
+ */
+#define FFT_PBUTTERFLY_BODY8(BUTTERFLY, add_s) \
+    ARCH_X86_64_ASM \
+    ( \
+        FFT_PANGLE_LOAD8 \
+        __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovups         0x00(%[dst]), %%zmm0")              /* zmm0 = a */ \
+            __ASM_EMIT("vmovups         0x40(%[dst]), %%zmm1")              /* zmm1 = b */ \
+            BUTTERFLY("%%zmm0", "%%zmm1", "%%zmm2", "%%zmm6", "%%zmm7", add_s) \
+            __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst])") \
+            __ASM_EMIT("vmovups         %%zmm2, 0x40(%[dst])") \
+            __ASM_EMIT("add             $0x80, %[dst]") \
+            __ASM_EMIT("dec             %[nb]") \
+        __ASM_EMIT("jnz             1b") \
+        __ASM_EMIT("vzeroupper") \
+        \
+        : [dst] "+r" (dst), [nb] "+r" (nb) \
+        : [fft_a] "r" (fft_a), [XSIGN] "o" (FFT_XSIGN) \
+        : "cc", "memory",  \
+        "%xmm0", "%xmm1", "%xmm2", \
+        "%xmm6", "%xmm7" \
+    );
+
+/*
+ * Two 8-pair blocks per iteration with independent angles
+ */
+#define FFT_PBUTTERFLY_BODY16(BUTTERFLY, add_s) \
+    ARCH_X86_64_ASM \
+    ( \
+        FFT_PANGLE_LOAD16 \
+        __ASM_EMIT("1:") \
+            __ASM_EMIT("vmovups         0x00(%[dst], %[off1]), %%zmm0")     /* zmm0 = a0 */ \
+            __ASM_EMIT("vmovups         0x40(%[dst], %[off1]), %%zmm1")     /* zmm1 = a1 */ \
+            __ASM_EMIT("vmovups         0x00(%[dst], %[off2]), %%zmm2")     /* zmm2 = b0 */ \
+            __ASM_EMIT("vmovups         0x40(%[dst], %[off2]), %%zmm3")     /* zmm3 = b1 */ \
+            BUTTERFLY("%%zmm0", "%%zmm2", "%%zmm4", "%%zmm6", "%%zmm7", add_s) \
+            BUTTERFLY("%%zmm1", "%%zmm3", "%%zmm5", "%%zmm8", "%%zmm9", add_s) \
+            __ASM_EMIT("vmovups         %%zmm0, 0x00(%[dst], %[off1])") \
+            __ASM_EMIT("vmovups         %%zmm1, 0x40(%[dst], %[off1])") \
+            __ASM_EMIT("vmovups         %%zmm4, 0x00(%[dst], %[off2])") \
+            __ASM_EMIT("vmovups         %%zmm5, 0x40(%[dst], %[off2])") \
+            __ASM_EMIT("add             $0x80, %[off1]") \
+            __ASM_EMIT("add             $0x80, %[off2]") \
+            __ASM_EMIT("sub             $16, %[np]") \
+            __ASM_EMIT("jz              2f") \
+            FFT_PANGLE_ROTATE16 \
+        __ASM_EMIT("jmp             1b") \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("vzeroupper") \
+        \
+        : [off1] "+r" (off1), [off2] "+r" (off2), [np] "+r" (np) \
+        : [dst] "r" (dst), [fft_a] "r" (fft_a), [fft_w] "r" (fft_w), \
+          [XSIGN] "o" (FFT_XSIGN) \
+        : "cc", "memory",  \
+        "%xmm0", "%xmm1", "%xmm2", "%xmm3", \
+        "%xmm4", "%xmm5", "%xmm6", "%xmm7", \
+        "%xmm8", "%xmm9", "%xmm10", "%xmm11", \
+        "%xmm12", "%xmm13", "%xmm14", "%xmm15" \
+    );
+
+namespace avx512
+{
+    static inline void packed_butterfly8p(float *dst, size_t nb, bool direct)
+    {
+        const float *fft_a = &avx::FFT_A[(3 - 2) << 4];
+
+        if (direct)
+        {
+            FFT_PBUTTERFLY_BODY8(FFT_PBUTTERFLY_MUL_FIRST, "vfmadd231ps");
+        }
+        else
+        {
+            FFT_PBUTTERFLY_BODY8(FFT_PBUTTERFLY_MUL_FIRST, "vfnmadd231ps");
+        }
+    }
+
+    static inline void packed_butterfly_direct16p(float *dst, size_t rank, size_t blocks)
+    {
+        size_t pairs = 1 << rank;
+        size_t off1 = 0, shift = 8 << rank; // 1 << (rank + 3);
+        const float *fft_a = &avx::FFT_A[(rank - 2) << 4];
+        const float *fft_w = &avx::FFT_DW[(rank - 2) << 4];
+
+        for (size_t b=0; b<blocks; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_PBUTTERFLY_BODY16(FFT_PBUTTERFLY_MUL_FIRST, "vfmadd231ps");
+
+            off1        = off2;
+        }
+    }
+
+    static inline void packed_butterfly_reverse16p(float *dst, size_t rank, size_t blocks)
+    {
+        size_t pairs = 1 << rank;
+        size_t off1 = 0, shift = 8 << rank; // 1 << (rank + 3);
+        const float *fft_a = &avx::FFT_A[(rank - 2) << 4];
+        const float *fft_w = &avx::FFT_DW[(rank - 2) << 4];
+
+        for (size_t b=0; b<blocks; ++b)
+        {
+            size_t off2  = off1 + shift;
+            size_t np    = pairs;
+
+            FFT_PBUTTERFLY_BODY16(FFT_PBUTTERFLY_MUL_FIRST, "vfnmadd231ps");
+
+            off1        = off2;
+        }
+    }
+
+    static inline void packed_butterfly_direct(float *dst, size_t rank, size_t blocks)
+    {
+        if (rank == 3)
+            packed_butterfly8p(dst, blocks, true);
+        else
+            packed_butterfly_direct16p(dst, rank, blocks);
+    }
+
+    static inline void packed_butterfly_reverse(float *dst, size_t rank, size_t blocks)
+    {
+        if (rank == 3)
+            packed_butterfly8p(dst, blocks, false);
+        else
+            packed_butterfly_reverse16p(dst, rank, blocks);
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_FFT_P_BUTTERFLY_H_ */
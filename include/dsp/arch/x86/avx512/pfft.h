@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_PFFT_H_
+#define DSP_ARCH_X86_AVX512_PFFT_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+// Scrambling and repacking are shared with the AVX implementation
+#define DSP_ARCH_X86_AVX_IMPL
+    #include <dsp/arch/x86/avx/fft/const.h>
+    #include <dsp/arch/x86/avx/fft/p_repack.h>
+
+    #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct8_fma3
+    #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse8_fma3
+    #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct8_fma3
+    #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse8_fma3
+    #define FFT_TYPE                            uint8_t
+    #define FFT_FMA(a, b)                       b
+    #include <dsp/arch/x86/avx/fft/p_scramble.h>
+
+    #define FFT_PSCRAMBLE_SELF_DIRECT_NAME      packed_scramble_self_direct16_fma3
+    #define FFT_PSCRAMBLE_SELF_REVERSE_NAME     packed_scramble_self_reverse16_fma3
+    #define FFT_PSCRAMBLE_COPY_DIRECT_NAME      packed_scramble_copy_direct16_fma3
+    #define FFT_PSCRAMBLE_COPY_REVERSE_NAME     packed_scramble_copy_reverse16_fma3
+    #define FFT_TYPE                            uint16_t
+    #define FFT_FMA(a, b)                       b
+    #include <dsp/arch/x86/avx/fft/p_scramble.h>
+#undef DSP_ARCH_X86_AVX_IMPL
+
+#include <dsp/arch/x86/avx512/fft/const.h>
+#include <dsp/arch/x86/avx512/fft/p_butterfly.h>
+
+namespace avx
+{
+    void packed_direct_fft_fma3(float *dst, const float *src, size_t rank);
+    void packed_reverse_fft_fma3(float *dst, const float *src, size_t rank);
+}
+
+namespace avx512
+{
+    void packed_direct_fft(float *dst, const float *src, size_t rank)
+    {
+        if (rank < 4)
+        {
+            avx::packed_direct_fft_fma3(dst, src, rank);
+            return;
+        }
+
+        if (dst == src)
+        {
+            if (rank <= 8)
+                avx::packed_scramble_self_direct8_fma3(dst, rank);
+            else
+                avx::packed_scramble_self_direct16_fma3(dst, rank);
+        }
+        else
+        {
+            if (rank <= 12)
+                avx::packed_scramble_copy_direct8_fma3(dst, src, rank-4);
+            else
+                avx::packed_scramble_copy_direct16_fma3(dst, src, rank-4);
+        }
+
+        for (size_t i=3; i < rank; ++i)
+            packed_butterfly_direct(dst, i, 1 << (rank - i - 1));
+
+        avx::packed_fft_repack(dst, rank);
+    }
+
+    void packed_reverse_fft(float *dst, const float *src, size_t rank)
+    {
+        if (rank < 4)
+        {
+            avx::packed_reverse_fft_fma3(dst, src, rank);
+            return;
+        }
+
+        if (dst == src)
+        {
+            if (rank <= 8)
+                avx::packed_scramble_self_reverse8_fma3(dst, rank);
+            else
+                avx::packed_scramble_self_reverse16_fma3(dst, rank);
+        }
+        else
+        {
+            if (rank <= 12)
+                avx::packed_scramble_copy_reverse8_fma3(dst, src, rank-4);
+            else
+                avx::packed_scramble_copy_reverse16_fma3(dst, src, rank-4);
+        }
+
+        for (size_t i=3; i < rank; ++i)
+            packed_butterfly_reverse(dst, i, 1 << (rank - i - 1));
+
+        avx::packed_fft_repack_normalize(dst, rank);
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_PFFT_H_ */
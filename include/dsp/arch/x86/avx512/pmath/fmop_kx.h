@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_PMATH_FMOP_KX_H_
+#define DSP_ARCH_X86_AVX512_PMATH_FMOP_KX_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+namespace avx512
+{
+    // Operations: A = A <op> B*C, B is destroyed
+    #define OP_FMADD(C, B, A)       __ASM_EMIT("vfmadd231ps " C ", " B ", " A)
+    #define OP_FMSUB(C, B, A)       __ASM_EMIT("vfnmadd231ps " C ", " B ", " A)
+    #define OP_FMRSUB(C, B, A)      __ASM_EMIT("vfmsub231ps " C ", " B ", " A)
+    #define OP_FMMUL(C, B, A) \
+        __ASM_EMIT("vmulps      " C ", " B ", " B) \
+        __ASM_EMIT("vmulps      " B ", " A ", " A)
+    #define OP_FMDIV(C, B, A) \
+        __ASM_EMIT("vmulps      " C ", " B ", " B) \
+        __ASM_EMIT("vdivps      " B ", " A ", " A)
+    #define OP_FMRDIV(C, B, A) \
+        __ASM_EMIT("vmulps      " C ", " B ", " B) \
+        __ASM_EMIT("vdivps      " A ", " B ", " A)
+
+    // Process 64 samples per iteration, the tail is processed with the opmask register
+    #define FMOP_KX_CORE(DST, SRC1, SRC2, OP) \
+        __ASM_EMIT("xor         %[off], %[off]") \
+        __ASM_EMIT("vbroadcastss %%xmm0, %%zmm0") \
+        __ASM_EMIT("sub         $64, %[count]") \
+        __ASM_EMIT("jb          2f")    \
+        /* 64x blocks */ \
+        __ASM_EMIT("1:") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC1 "], %[off]), %%zmm4") \
+        __ASM_EMIT("vmovups     0x040(%[" SRC1 "], %[off]), %%zmm5") \
+        __ASM_EMIT("vmovups     0x080(%[" SRC1 "], %[off]), %%zmm6") \
+        __ASM_EMIT("vmovups     0x0c0(%[" SRC1 "], %[off]), %%zmm7") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC2 "], %[off]), %%zmm8") \
+        __ASM_EMIT("vmovups     0x040(%[" SRC2 "], %[off]), %%zmm9") \
+        __ASM_EMIT("vmovups     0x080(%[" SRC2 "], %[off]), %%zmm10") \
+        __ASM_EMIT("vmovups     0x0c0(%[" SRC2 "], %[off]), %%zmm11") \
+        OP("%%zmm0", "%%zmm8", "%%zmm4") \
+        OP("%%zmm0", "%%zmm9", "%%zmm5") \
+        OP("%%zmm0", "%%zmm10", "%%zmm6") \
+        OP("%%zmm0", "%%zmm11", "%%zmm7") \
+        __ASM_EMIT("vmovups     %%zmm4, 0x000(%[" DST "], %[off])") \
+        __ASM_EMIT("vmovups     %%zmm5, 0x040(%[" DST "], %[off])") \
+        __ASM_EMIT("vmovups     %%zmm6, 0x080(%[" DST "], %[off])") \
+        __ASM_EMIT("vmovups     %%zmm7, 0x0c0(%[" DST "], %[off])") \
+        __ASM_EMIT("add         $0x100, %[off]") \
+        __ASM_EMIT("sub         $64, %[count]") \
+        __ASM_EMIT("jae         1b") \
+        /* 16x blocks */ \
+        __ASM_EMIT("2:") \
+        __ASM_EMIT("add         $48, %[count]")          /* 64 - 16 */ \
+        __ASM_EMIT("jl          4f") \
+        __ASM_EMIT("3:") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC1 "], %[off]), %%zmm4") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC2 "], %[off]), %%zmm8") \
+        OP("%%zmm0", "%%zmm8", "%%zmm4") \
+        __ASM_EMIT("vmovups     %%zmm4, 0x000(%[" DST "], %[off])") \
+        __ASM_EMIT("add         $0x40, %[off]") \
+        __ASM_EMIT("sub         $16, %[count]") \
+        __ASM_EMIT("jge         3b") \
+        /* Masked tail */ \
+        __ASM_EMIT("4:") \
+        __ASM_EMIT("test        %[mask], %[mask]") \
+        __ASM_EMIT("jz          6f") \
+        __ASM_EMIT("kmovw       %k[mask], %%k1") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC1 "], %[off]), %%zmm4%{%%k1%}%{z%}") \
+        __ASM_EMIT("vmovups     0x000(%[" SRC2 "], %[off]), %%zmm8%{%%k1%}%{z%}") \
+        OP("%%zmm0", "%%zmm8", "%%zmm4") \
+        __ASM_EMIT("vmovups     %%zmm4, 0x000(%[" DST "], %[off])%{%%k1%}") \
+        __ASM_EMIT("6:") \
+        __ASM_EMIT("vzeroupper")
+
+    void fmadd_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMADD)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmsub_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMSUB)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmrsub_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMRSUB)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmmul_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMMUL)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmdiv_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMDIV)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmrdiv_k3(float *dst, const float *src, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "dst", "src", OP_FMRDIV)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src] "r"(src),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmadd_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMADD)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMSUB)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmrsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMRSUB)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmmul_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMMUL)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMDIV)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    void fmrdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count)
+    {
+        IF_ARCH_X86(size_t off);
+        uint32_t mask = (1 << (count & 0x0f)) - 1;
+        ARCH_X86_64_ASM
+        (
+            FMOP_KX_CORE("dst", "src1", "src2", OP_FMRDIV)
+            : [off] "=&r" (off), [count] "+r" (count),
+              [k] "+Yz" (k)
+            : [dst] "r"(dst), [src1] "r" (src1), [src2] "r" (src2),
+              [mask] "r" (mask)
+            : "cc", "memory",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%k1"
+        );
+    }
+
+    #undef FMOP_KX_CORE
+    #undef OP_FMADD
+    #undef OP_FMSUB
+    #undef OP_FMRSUB
+    #undef OP_FMMUL
+    #undef OP_FMDIV
+    #undef OP_FMRDIV
+}
+
+#endif /* DSP_ARCH_X86_AVX512_PMATH_FMOP_KX_H_ */
@@ -0,0 +1,1221 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_AVX512_RESAMPLING_H_
+#define DSP_ARCH_X86_AVX512_RESAMPLING_H_
+
+#ifndef DSP_ARCH_X86_AVX512_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_AVX512_IMPL */
+
+namespace avx
+{
+    void lanczos_resample_2x2(float *dst, const float *src, size_t count);
+    void lanczos_resample_2x3(float *dst, const float *src, size_t count);
+    void lanczos_resample_2x4(float *dst, const float *src, size_t count);
+    void lanczos_resample_3x2(float *dst, const float *src, size_t count);
+    void lanczos_resample_3x3(float *dst, const float *src, size_t count);
+    void lanczos_resample_3x4(float *dst, const float *src, size_t count);
+    void lanczos_resample_4x2(float *dst, const float *src, size_t count);
+    void lanczos_resample_4x3(float *dst, const float *src, size_t count);
+    void lanczos_resample_4x4(float *dst, const float *src, size_t count);
+    void lanczos_resample_6x2(float *dst, const float *src, size_t count);
+    void lanczos_resample_6x3(float *dst, const float *src, size_t count);
+    void lanczos_resample_6x4(float *dst, const float *src, size_t count);
+    void lanczos_resample_8x2(float *dst, const float *src, size_t count);
+    void lanczos_resample_8x3(float *dst, const float *src, size_t count);
+    void lanczos_resample_8x4(float *dst, const float *src, size_t count);
+}
+
+/*
+ * Each function processes a group of source samples which produces the whole number
+ * of ZMM registers of output: the kernel is stored in memory with the zero padding,
+ * so the contribution of the source sample #p into the output register #z is the
+ * product of the broadcasted sample and the kernel at offset 16*z - p*TIMES.
+ * The products are accumulated in registers and added to the destination buffer once.
+ * The output range of the group is partially overlapped by the next group, the last
+ * register is stored with the mask to not to touch samples outside of the kernel.
+ * Remaining samples are processed by the AVX implementation.
+ */
+namespace avx512
+{
+    // Lanczos kernel 2x2: 8 samples per iteration, 2 ZMM accumulators
+    static const float lanczos_2x2[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0636843520278618f,
+        +0.0000000000000000f, +0.5731591682507563f, +1.0000000000000000f, +0.5731591682507563f, +0.0000000000000000f, -0.0636843520278618f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_2x2(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x038(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x030(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x028(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x018(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm5, %%zmm16")
+            __ASM_EMIT("vmulps          0x050(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x008(%[k]), %%zmm6, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x048(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm7, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_2x2), [mask] "r" (127)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_2x2(dst, src, count);
+    }
+
+    // Lanczos kernel 2x3: 8 samples per iteration, 2 ZMM accumulators
+    static const float lanczos_2x3[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0243170840741611f,
+        +0.0000000000000000f, -0.1350949115231170f, +0.0000000000000000f, +0.6079271018540265f, +1.0000000000000000f, +0.6079271018540265f, +0.0000000000000000f, -0.1350949115231170f,
+        +0.0000000000000000f, +0.0243170840741611f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_2x3(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x038(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x030(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x028(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vmulps          0x060(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x018(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x058(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm5, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x050(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x008(%[k]), %%zmm6, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x048(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm7, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_2x3), [mask] "r" (2047)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_2x3(dst, src, count);
+    }
+
+    // Lanczos kernel 2x4: 8 samples per iteration, 2 ZMM accumulators
+    static const float lanczos_2x4[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0126608778212387f,
+        +0.0000000000000000f, +0.0599094833772629f, +0.0000000000000000f, -0.1664152316035080f, +0.0000000000000000f, +0.6203830132406946f, +1.0000000000000000f, +0.6203830132406946f,
+        +0.0000000000000000f, -0.1664152316035080f, +0.0000000000000000f, +0.0599094833772629f, +0.0000000000000000f, -0.0126608778212387f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_2x4(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x038(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x030(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vmulps          0x070(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x028(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x068(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x060(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x018(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x058(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm5, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x050(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x008(%[k]), %%zmm6, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x048(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm7, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_2x4), [mask] "r" (32767)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_2x4(dst, src, count);
+    }
+
+    // Lanczos kernel 3x2: 16 samples per iteration, 4 ZMM accumulators
+    static const float lanczos_3x2[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0315888188312782f, -0.0854897486982225f,
+        +0.0000000000000000f, +0.3419589947928900f, +0.7897204707819555f, +1.0000000000000000f, +0.7897204707819555f, +0.3419589947928900f, +0.0000000000000000f, -0.0854897486982225f,
+        -0.0315888188312782f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_3x2(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0b4(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x0a8(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x09c(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vmulps          0x0dc(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x084(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0c4(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x0ac(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vmulps          0x0e0(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x20(%[src]), %%zmm8")              // zmm8 = s8
+            __ASM_EMIT("vfmadd231ps     0x094(%[k]), %%zmm8, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0d4(%[k]), %%zmm8, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x24(%[src]), %%zmm9")              // zmm9 = s9
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm9, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm9, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x28(%[src]), %%zmm10")             // zmm10 = s10
+            __ASM_EMIT("vfmadd231ps     0x07c(%[k]), %%zmm10, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0bc(%[k]), %%zmm10, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x2c(%[src]), %%zmm11")             // zmm11 = s11
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm11, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x30(%[src]), %%zmm12")             // zmm12 = s12
+            __ASM_EMIT("vfmadd231ps     0x0a4(%[k]), %%zmm12, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x34(%[src]), %%zmm13")             // zmm13 = s13
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm13, %%zmm18")
+            __ASM_EMIT("vmulps          0x0d8(%[k]), %%zmm13, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x38(%[src]), %%zmm14")             // zmm14 = s14
+            __ASM_EMIT("vfmadd231ps     0x08c(%[k]), %%zmm14, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0cc(%[k]), %%zmm14, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x3c(%[src]), %%zmm15")             // zmm15 = s15
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm15, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm15, %%zmm19")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x40, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $16, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_3x2), [mask] "r" (1023)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%xmm12", "%xmm13", "%xmm14", "%xmm15",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_3x2(dst, src, count);
+    }
+
+    // Lanczos kernel 3x3: 16 samples per iteration, 4 ZMM accumulators
+    static const float lanczos_3x3[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0126609519658153f, +0.0310789306368038f,
+        +0.0000000000000000f, -0.0933267410806225f, -0.1458230329384726f, +0.0000000000000000f, +0.3807169003008463f, +0.8103009258121772f, +1.0000000000000000f, +0.8103009258121772f,
+        +0.3807169003008463f, +0.0000000000000000f, -0.1458230329384726f, -0.0933267410806225f, +0.0000000000000000f, +0.0310789306368038f, +0.0126609519658153f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_3x3(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0b4(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x0f4(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x0a8(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0e8(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x09c(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0dc(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x084(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0c4(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vmulps          0x0f8(%[k]), %%zmm5, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x0ac(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0ec(%[k]), %%zmm6, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0e0(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x20(%[src]), %%zmm8")              // zmm8 = s8
+            __ASM_EMIT("vfmadd231ps     0x094(%[k]), %%zmm8, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0d4(%[k]), %%zmm8, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x24(%[src]), %%zmm9")              // zmm9 = s9
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm9, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm9, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x28(%[src]), %%zmm10")             // zmm10 = s10
+            __ASM_EMIT("vfmadd231ps     0x07c(%[k]), %%zmm10, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0bc(%[k]), %%zmm10, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x2c(%[src]), %%zmm11")             // zmm11 = s11
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm11, %%zmm18")
+            __ASM_EMIT("vmulps          0x0f0(%[k]), %%zmm11, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x30(%[src]), %%zmm12")             // zmm12 = s12
+            __ASM_EMIT("vfmadd231ps     0x0a4(%[k]), %%zmm12, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0e4(%[k]), %%zmm12, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x34(%[src]), %%zmm13")             // zmm13 = s13
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm13, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0d8(%[k]), %%zmm13, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x38(%[src]), %%zmm14")             // zmm14 = s14
+            __ASM_EMIT("vfmadd231ps     0x08c(%[k]), %%zmm14, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0cc(%[k]), %%zmm14, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x3c(%[src]), %%zmm15")             // zmm15 = s15
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm15, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm15, %%zmm19")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("add             $0x40, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $16, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_3x3), [mask] "r" (65535)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%xmm12", "%xmm13", "%xmm14", "%xmm15",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_3x3(dst, src, count);
+    }
+
+    // Lanczos kernel 3x4: 16 samples per iteration, 5 ZMM accumulators
+    static const float lanczos_3x4[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0067568495254777f, -0.0157944094156391f,
+        +0.0000000000000000f, +0.0427448743491113f, +0.0622703182267308f, +0.0000000000000000f, -0.1220498237243924f, -0.1709794973964449f, +0.0000000000000000f, +0.3948602353909778f,
+        +0.8175787925827955f, +1.0000000000000000f, +0.8175787925827955f, +0.3948602353909778f, +0.0000000000000000f, -0.1709794973964449f, -0.1220498237243924f, +0.0000000000000000f,
+        +0.0622703182267308f, +0.0427448743491113f, +0.0000000000000000f, -0.0157944094156391f, -0.0067568495254777f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_3x4(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0b4(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x0f4(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x0a8(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0e8(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x09c(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0dc(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vmulps          0x110(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x084(%[k]), %%zmm4, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0c4(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x104(%[k]), %%zmm4, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0f8(%[k]), %%zmm5, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x0ac(%[k]), %%zmm6, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0ec(%[k]), %%zmm6, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm7, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0e0(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x20(%[src]), %%zmm8")              // zmm8 = s8
+            __ASM_EMIT("vfmadd231ps     0x094(%[k]), %%zmm8, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0d4(%[k]), %%zmm8, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x24(%[src]), %%zmm9")              // zmm9 = s9
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm9, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm9, %%zmm18")
+            __ASM_EMIT("vmulps          0x108(%[k]), %%zmm9, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x28(%[src]), %%zmm10")             // zmm10 = s10
+            __ASM_EMIT("vfmadd231ps     0x07c(%[k]), %%zmm10, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0bc(%[k]), %%zmm10, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0fc(%[k]), %%zmm10, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x2c(%[src]), %%zmm11")             // zmm11 = s11
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm11, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0f0(%[k]), %%zmm11, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x30(%[src]), %%zmm12")             // zmm12 = s12
+            __ASM_EMIT("vfmadd231ps     0x0a4(%[k]), %%zmm12, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0e4(%[k]), %%zmm12, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x34(%[src]), %%zmm13")             // zmm13 = s13
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm13, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0d8(%[k]), %%zmm13, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x38(%[src]), %%zmm14")             // zmm14 = s14
+            __ASM_EMIT("vfmadd231ps     0x08c(%[k]), %%zmm14, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0cc(%[k]), %%zmm14, %%zmm19")
+            __ASM_EMIT("vmulps          0x10c(%[k]), %%zmm14, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x3c(%[src]), %%zmm15")             // zmm15 = s15
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm15, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm15, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x100(%[k]), %%zmm15, %%zmm20")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("vaddps          0x100(%[dst]), %%zmm20, %%zmm20 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm20, 0x100(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x40, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $16, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $16, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_3x4), [mask] "r" (63)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+              "%xmm12", "%xmm13", "%xmm14", "%xmm15",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%xmm20",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_3x4(dst, src, count);
+    }
+
+    // Lanczos kernel 4x2: 4 samples per iteration, 2 ZMM accumulators
+    static const float lanczos_4x2[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0179051851263444f, -0.0636843520278618f, -0.0847248039068907f,
+        +0.0000000000000000f, +0.2353466775191407f, +0.5731591682507563f, +0.8773540711908775f, +1.0000000000000000f, +0.8773540711908775f, +0.5731591682507563f, +0.2353466775191407f,
+        +0.0000000000000000f, -0.0847248039068907f, -0.0636843520278618f, -0.0179051851263444f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_4x2(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x030(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vmulps          0x060(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x050(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x10, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $4, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_4x2), [mask] "r" (8191)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm16", "%xmm17",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_4x2(dst, src, count);
+    }
+
+    // Lanczos kernel 4x3: 4 samples per iteration, 3 ZMM accumulators
+    static const float lanczos_4x3[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0073559260471942f, +0.0243170840741611f, +0.0300210914495816f,
+        +0.0000000000000000f, -0.0677913359005429f, -0.1350949115231170f, -0.1328710183650640f, +0.0000000000000000f, +0.2701898230462341f, +0.6079271018540265f, +0.8900670517104946f,
+        +1.0000000000000000f, +0.8900670517104946f, +0.6079271018540265f, +0.2701898230462341f, +0.0000000000000000f, -0.1328710183650640f, -0.1350949115231170f, -0.0677913359005429f,
+        +0.0000000000000000f, +0.0300210914495816f, +0.0243170840741611f, +0.0073559260471942f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_4x3(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x030(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x070(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x060(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x050(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vmulps          0x080(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x10, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $4, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_4x3), [mask] "r" (31)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm16", "%xmm17", "%xmm18",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_4x3(dst, src, count);
+    }
+
+    // Lanczos kernel 4x4: 4 samples per iteration, 3 ZMM accumulators
+    static const float lanczos_4x4[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0039757442382413f, -0.0126608778212387f, -0.0150736176408234f,
+        +0.0000000000000000f, +0.0315083921595442f, +0.0599094833772629f, +0.0555206000541729f, +0.0000000000000000f, -0.0917789511099593f, -0.1664152316035080f, -0.1525006180521938f,
+        +0.0000000000000000f, +0.2830490423665725f, +0.6203830132406946f, +0.8945424536042901f, +1.0000000000000000f, +0.8945424536042901f, +0.6203830132406946f, +0.2830490423665725f,
+        +0.0000000000000000f, -0.1525006180521938f, -0.1664152316035080f, -0.0917789511099593f, +0.0000000000000000f, +0.0555206000541729f, +0.0599094833772629f, +0.0315083921595442f,
+        +0.0000000000000000f, -0.0150736176408234f, -0.0126608778212387f, -0.0039757442382413f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_4x4(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x030(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x070(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x020(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x060(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vmulps          0x0a0(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x010(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x050(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm2, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm3, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x10, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $4, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $4, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_4x4), [mask] "r" (8191)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm16", "%xmm17", "%xmm18",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_4x4(dst, src, count);
+    }
+
+    // Lanczos kernel 6x2: 8 samples per iteration, 5 ZMM accumulators
+    static const float lanczos_6x2[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0078021377848166f, -0.0315888188312782f, -0.0636843520278618f, -0.0854897486982225f, -0.0719035699814534f,
+        +0.0000000000000000f, +0.1409309971636486f, +0.3419589947928900f, +0.5731591682507563f, +0.7897204707819555f, +0.9440586719628122f, +1.0000000000000000f, +0.9440586719628122f,
+        +0.7897204707819555f, +0.5731591682507563f, +0.3419589947928900f, +0.1409309971636486f, +0.0000000000000000f, -0.0719035699814534f, -0.0854897486982225f, -0.0636843520278618f,
+        -0.0315888188312782f, -0.0078021377848166f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_6x2(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0a8(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x0e8(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x078(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vmulps          0x0f8(%[k]), %%zmm2, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0e0(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm4, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x070(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm5, %%zmm18")
+            __ASM_EMIT("vmulps          0x0f0(%[k]), %%zmm5, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm6, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0d8(%[k]), %%zmm6, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm7, %%zmm19")
+            __ASM_EMIT("vmulps          0x100(%[k]), %%zmm7, %%zmm20")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("vaddps          0x100(%[dst]), %%zmm20, %%zmm20 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm20, 0x100(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_6x2), [mask] "r" (7)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%xmm20",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_6x2(dst, src, count);
+    }
+
+    // Lanczos kernel 6x3: 8 samples per iteration, 5 ZMM accumulators
+    static const float lanczos_6x3[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0032875048460955f, +0.0126609519658153f, +0.0243170840741611f, +0.0310789306368038f, +0.0248005479513036f,
+        +0.0000000000000000f, -0.0424907562338176f, -0.0933267410806225f, -0.1350949115231170f, -0.1458230329384726f, -0.1049261531488149f, +0.0000000000000000f, +0.1676517041508127f,
+        +0.3807169003008463f, +0.6079271018540265f, +0.8103009258121772f, +0.9500889005216107f, +1.0000000000000000f, +0.9500889005216107f, +0.8103009258121772f, +0.6079271018540265f,
+        +0.3807169003008463f, +0.1676517041508127f, +0.0000000000000000f, -0.1049261531488149f, -0.1458230329384726f, -0.1350949115231170f, -0.0933267410806225f, -0.0424907562338176f,
+        +0.0000000000000000f, +0.0248005479513036f, +0.0310789306368038f, +0.0243170840741611f, +0.0126609519658153f, +0.0032875048460955f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_6x3(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0a8(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x0e8(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vmulps          0x128(%[k]), %%zmm0, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x110(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x078(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0f8(%[k]), %%zmm2, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0e0(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vmulps          0x120(%[k]), %%zmm3, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm4, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x108(%[k]), %%zmm4, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x070(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm5, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0f0(%[k]), %%zmm5, %%zmm19")
+            __ASM_EMIT("vmulps          0x130(%[k]), %%zmm5, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm6, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0d8(%[k]), %%zmm6, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x118(%[k]), %%zmm6, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm7, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x100(%[k]), %%zmm7, %%zmm20")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("vaddps          0x100(%[dst]), %%zmm20, %%zmm20 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm20, 0x100(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_6x3), [mask] "r" (32767)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%xmm20",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_6x3(dst, src, count);
+    }
+
+    // Lanczos kernel 6x4: 8 samples per iteration, 6 ZMM accumulators
+    static const float lanczos_6x4[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, -0.0018000092949500f, -0.0067568495254777f, -0.0126608778212387f, -0.0157944094156391f, -0.0123019137260206f,
+        +0.0000000000000000f, +0.0200263389720192f, +0.0427448743491113f, +0.0599094833772629f, +0.0622703182267308f, +0.0427971267140625f, +0.0000000000000000f, -0.0597744992948478f,
+        -0.1220498237243924f, -0.1664152316035080f, -0.1709794973964449f, -0.1181145298553785f, +0.0000000000000000f, +0.1776396342037379f, +0.3948602353909778f, +0.6203830132406946f,
+        +0.8175787925827955f, +0.9522049170285306f, +1.0000000000000000f, +0.9522049170285306f, +0.8175787925827955f, +0.6203830132406946f, +0.3948602353909778f, +0.1776396342037379f,
+        +0.0000000000000000f, -0.1181145298553785f, -0.1709794973964449f, -0.1664152316035080f, -0.1220498237243924f, -0.0597744992948478f, +0.0000000000000000f, +0.0427971267140625f,
+        +0.0622703182267308f, +0.0599094833772629f, +0.0427448743491113f, +0.0200263389720192f, +0.0000000000000000f, -0.0123019137260206f, -0.0157944094156391f, -0.0126608778212387f,
+        -0.0067568495254777f, -0.0018000092949500f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_6x4(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x0a8(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x0e8(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vmulps          0x128(%[k]), %%zmm0, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x090(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0d0(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x110(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vmulps          0x150(%[k]), %%zmm1, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x08(%[src]), %%zmm2")              // zmm2 = s2
+            __ASM_EMIT("vfmadd231ps     0x078(%[k]), %%zmm2, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x0b8(%[k]), %%zmm2, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0f8(%[k]), %%zmm2, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x138(%[k]), %%zmm2, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x0c(%[src]), %%zmm3")              // zmm3 = s3
+            __ASM_EMIT("vfmadd231ps     0x0a0(%[k]), %%zmm3, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0e0(%[k]), %%zmm3, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x120(%[k]), %%zmm3, %%zmm19")
+            __ASM_EMIT("vmulps          0x160(%[k]), %%zmm3, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x10(%[src]), %%zmm4")              // zmm4 = s4
+            __ASM_EMIT("vfmadd231ps     0x088(%[k]), %%zmm4, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0c8(%[k]), %%zmm4, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x108(%[k]), %%zmm4, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x148(%[k]), %%zmm4, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x14(%[src]), %%zmm5")              // zmm5 = s5
+            __ASM_EMIT("vfmadd231ps     0x070(%[k]), %%zmm5, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x0b0(%[k]), %%zmm5, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0f0(%[k]), %%zmm5, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x130(%[k]), %%zmm5, %%zmm20")
+            __ASM_EMIT("vbroadcastss    0x18(%[src]), %%zmm6")              // zmm6 = s6
+            __ASM_EMIT("vfmadd231ps     0x098(%[k]), %%zmm6, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0d8(%[k]), %%zmm6, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x118(%[k]), %%zmm6, %%zmm20")
+            __ASM_EMIT("vmulps          0x158(%[k]), %%zmm6, %%zmm21")
+            __ASM_EMIT("vbroadcastss    0x1c(%[src]), %%zmm7")              // zmm7 = s7
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm7, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm7, %%zmm19")
+            __ASM_EMIT("vfmadd231ps     0x100(%[k]), %%zmm7, %%zmm20")
+            __ASM_EMIT("vfmadd231ps     0x140(%[k]), %%zmm7, %%zmm21")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("vaddps          0x100(%[dst]), %%zmm20, %%zmm20")
+            __ASM_EMIT("vmovups         %%zmm20, 0x100(%[dst])")
+            __ASM_EMIT("vaddps          0x140(%[dst]), %%zmm21, %%zmm21 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm21, 0x140(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x20, %[src]")
+            __ASM_EMIT("add             $0xc0, %[dst]")
+            __ASM_EMIT("sub             $8, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $8, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_6x4), [mask] "r" (2047)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+              "%xmm16", "%xmm17", "%xmm18", "%xmm19",
+              "%xmm20", "%xmm21",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_6x4(dst, src, count);
+    }
+
+    // Lanczos kernel 8x2: 2 samples per iteration, 3 ZMM accumulators
+    static const float lanczos_8x2[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, -0.0043033145538298f, -0.0179051851263444f, -0.0393892611124141f, -0.0636843520278618f, -0.0823353965569232f, -0.0847248039068907f, -0.0600950644541902f,
+        +0.0000000000000000f, +0.0993408208324369f, +0.2353466775191407f, +0.3985033193355084f, +0.5731591682507563f, +0.7396427919997760f, +0.8773540711908775f, +0.9682457746117045f,
+        +1.0000000000000000f, +0.9682457746117045f, +0.8773540711908775f, +0.7396427919997760f, +0.5731591682507563f, +0.3985033193355084f, +0.2353466775191407f, +0.0993408208324369f,
+        +0.0000000000000000f, -0.0600950644541902f, -0.0847248039068907f, -0.0823353965569232f, -0.0636843520278618f, -0.0393892611124141f, -0.0179051851263444f, -0.0043033145538298f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_8x2(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x020(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x060(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vmulps          0x080(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x08, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $2, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_8x2), [mask] "r" (511)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm16", "%xmm17",
+              "%xmm18",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_8x2(dst, src, count);
+    }
+
+    // Lanczos kernel 8x3: 2 samples per iteration, 4 ZMM accumulators
+    static const float lanczos_8x3[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0018368899607481f, +0.0073559260471942f, +0.0155961678435580f, +0.0243170840741611f, +0.0303079634725070f, +0.0300210914495816f, +0.0204366616947175f,
+        +0.0000000000000000f, -0.0305684889733737f, -0.0677913359005429f, -0.1054383717904384f, -0.1350949115231170f, -0.1472651639056537f, -0.1328710183650640f, -0.0849124693704824f,
+        +0.0000000000000000f, +0.1205345965259870f, +0.2701898230462341f, +0.4376469925430009f, +0.6079271018540265f, +0.7642122243343417f, +0.8900670517104946f, +0.9717147892357163f,
+        +1.0000000000000000f, +0.9717147892357163f, +0.8900670517104946f, +0.7642122243343417f, +0.6079271018540265f, +0.4376469925430009f, +0.2701898230462341f, +0.1205345965259870f,
+        +0.0000000000000000f, -0.0849124693704824f, -0.1328710183650640f, -0.1472651639056537f, -0.1350949115231170f, -0.1054383717904384f, -0.0677913359005429f, -0.0305684889733737f,
+        +0.0000000000000000f, +0.0204366616947175f, +0.0300210914495816f, +0.0303079634725070f, +0.0243170840741611f, +0.0155961678435580f, +0.0073559260471942f, +0.0018368899607481f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_8x3(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x020(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x060(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vmulps          0x0a0(%[k]), %%zmm0, %%zmm18")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vmulps          0x0c0(%[k]), %%zmm1, %%zmm19")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x08, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $2, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_8x3), [mask] "r" (511)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm16", "%xmm17",
+              "%xmm18", "%xmm19",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_8x3(dst, src, count);
+    }
+
+    // Lanczos kernel 8x4: 2 samples per iteration, 5 ZMM accumulators
+    static const float lanczos_8x4[] __lsp_aligned64 =
+    {
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, -0.0010124148822791f, -0.0039757442382413f, -0.0082714887261119f, -0.0126608778212387f, -0.0154958216565010f, -0.0150736176408234f, -0.0100753105205530f,
+        +0.0000000000000000f, +0.0145047275409824f, +0.0315083921595442f, +0.0479233082326825f, +0.0599094833772629f, +0.0635233253590927f, +0.0555206000541729f, +0.0341810767869351f,
+        +0.0000000000000000f, -0.0439036941841078f, -0.0917789511099593f, -0.1356918370096595f, -0.1664152316035080f, -0.1746626357901899f, -0.1525006180521938f, -0.0947284057923417f,
+        +0.0000000000000000f, +0.1285116137825641f, +0.2830490423665725f, +0.4518581595035692f, +0.6203830132406946f, +0.7729246687400148f, +0.8945424536042901f, +0.9729307018702211f,
+        +1.0000000000000000f, +0.9729307018702211f, +0.8945424536042901f, +0.7729246687400148f, +0.6203830132406946f, +0.4518581595035692f, +0.2830490423665725f, +0.1285116137825641f,
+        +0.0000000000000000f, -0.0947284057923417f, -0.1525006180521938f, -0.1746626357901899f, -0.1664152316035080f, -0.1356918370096595f, -0.0917789511099593f, -0.0439036941841078f,
+        +0.0000000000000000f, +0.0341810767869351f, +0.0555206000541729f, +0.0635233253590927f, +0.0599094833772629f, +0.0479233082326825f, +0.0315083921595442f, +0.0145047275409824f,
+        +0.0000000000000000f, -0.0100753105205530f, -0.0150736176408234f, -0.0154958216565010f, -0.0126608778212387f, -0.0082714887261119f, -0.0039757442382413f, -0.0010124148822791f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f,
+        +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f, +0.0000000000000000f
+    };
+
+    void lanczos_resample_8x4(float *dst, const float *src, size_t count)
+    {
+        ARCH_X86_64_ASM (
+            __ASM_EMIT("kmovw           %k[mask], %%k1")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jb              2f")
+            __ASM_EMIT(".align          16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("vbroadcastss    0x00(%[src]), %%zmm0")              // zmm0 = s0
+            __ASM_EMIT("vmulps          0x020(%[k]), %%zmm0, %%zmm16")
+            __ASM_EMIT("vmulps          0x060(%[k]), %%zmm0, %%zmm17")
+            __ASM_EMIT("vmulps          0x0a0(%[k]), %%zmm0, %%zmm18")
+            __ASM_EMIT("vmulps          0x0e0(%[k]), %%zmm0, %%zmm19")
+            __ASM_EMIT("vbroadcastss    0x04(%[src]), %%zmm1")              // zmm1 = s1
+            __ASM_EMIT("vfmadd231ps     0x000(%[k]), %%zmm1, %%zmm16")
+            __ASM_EMIT("vfmadd231ps     0x040(%[k]), %%zmm1, %%zmm17")
+            __ASM_EMIT("vfmadd231ps     0x080(%[k]), %%zmm1, %%zmm18")
+            __ASM_EMIT("vfmadd231ps     0x0c0(%[k]), %%zmm1, %%zmm19")
+            __ASM_EMIT("vmulps          0x100(%[k]), %%zmm1, %%zmm20")
+            __ASM_EMIT("vaddps          0x000(%[dst]), %%zmm16, %%zmm16")
+            __ASM_EMIT("vmovups         %%zmm16, 0x000(%[dst])")
+            __ASM_EMIT("vaddps          0x040(%[dst]), %%zmm17, %%zmm17")
+            __ASM_EMIT("vmovups         %%zmm17, 0x040(%[dst])")
+            __ASM_EMIT("vaddps          0x080(%[dst]), %%zmm18, %%zmm18")
+            __ASM_EMIT("vmovups         %%zmm18, 0x080(%[dst])")
+            __ASM_EMIT("vaddps          0x0c0(%[dst]), %%zmm19, %%zmm19")
+            __ASM_EMIT("vmovups         %%zmm19, 0x0c0(%[dst])")
+            __ASM_EMIT("vaddps          0x100(%[dst]), %%zmm20, %%zmm20 %{%%k1%}%{z%}")
+            __ASM_EMIT("vmovups         %%zmm20, 0x100(%[dst]) %{%%k1%}")
+            __ASM_EMIT("add             $0x08, %[src]")
+            __ASM_EMIT("add             $0x40, %[dst]")
+            __ASM_EMIT("sub             $2, %[count]")
+            __ASM_EMIT("jae             1b")
+            __ASM_EMIT("2:")
+            __ASM_EMIT("add             $2, %[count]")
+            __ASM_EMIT("vzeroupper")
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [k] "r" (lanczos_8x4), [mask] "r" (511)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm16", "%xmm17",
+              "%xmm18", "%xmm19", "%xmm20",
+              "%k1"
+        );
+
+        // Process the tail
+        if (count > 0)
+            avx::lanczos_resample_8x4(dst, src, count);
+    }
+}
+
+#endif /* DSP_ARCH_X86_AVX512_RESAMPLING_H_ */
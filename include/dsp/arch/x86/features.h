@@ -84,7 +84,8 @@ namespace x86
     {
         FEAT_FAST_MOVS,         // Processor implements optimized MOVS instruction
         FEAT_FAST_AVX,          // Fast AVX implementation
-        FEAT_FAST_FMA3          // Fast FMA3 implementation
+        FEAT_FAST_FMA3,         // Fast FMA3 implementation
+        FEAT_FAST_AVX512        // Fast AVX-512 implementation
     };
 
     /**
@@ -56,6 +56,52 @@ namespace sse
         // Do reverse FFT
         fastconv_restore_internal(dst, tmp, rank);
     }
+    void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank)
+    {
+        size_t items    = size_t(1) << (rank + 1);
+
+        ARCH_X86_ASM
+        (
+            __ASM_EMIT("1:")
+
+            // Load data
+            __ASM_EMIT("movups      0x00(%[c1]), %%xmm0")       /* xmm0 = r0 r1 r2 r3 */
+            __ASM_EMIT("movups      0x10(%[c1]), %%xmm2")       /* xmm2 = i0 i1 i2 i3 */
+            __ASM_EMIT("movups      0x00(%[c2]), %%xmm1")       /* xmm1 = rc0 rc1 rc2 rc3 */
+            __ASM_EMIT("movups      0x10(%[c2]), %%xmm3")       /* xmm3 = ic0 ic1 ic2 ic3 */
+            __ASM_EMIT("movaps      %%xmm1, %%xmm5")            /* xmm5 = rc */
+            __ASM_EMIT("movaps      %%xmm3, %%xmm7")            /* xmm7 = ic */
+
+            // Do complex multiplication
+            __ASM_EMIT("mulps       %%xmm0, %%xmm1")            /* xmm1 = rc*r */
+            __ASM_EMIT("mulps       %%xmm2, %%xmm7")            /* xmm7 = ic*i */
+            __ASM_EMIT("mulps       %%xmm0, %%xmm3")            /* xmm3 = ic*r */
+            __ASM_EMIT("mulps       %%xmm2, %%xmm5")            /* xmm5 = rc*i */
+            __ASM_EMIT("movups      0x00(%[dst]), %%xmm0")      /* xmm0 = dr */
+            __ASM_EMIT("movups      0x10(%[dst]), %%xmm2")      /* xmm2 = di */
+            __ASM_EMIT("subps       %%xmm7, %%xmm1")            /* xmm1 = rc*r - ic*i */
+            __ASM_EMIT("addps       %%xmm5, %%xmm3")            /* xmm3 = ic*r + rc*i */
+
+            // Accumulate and store
+            __ASM_EMIT("addps       %%xmm1, %%xmm0")            /* xmm0 = dr + rc*r - ic*i */
+            __ASM_EMIT("addps       %%xmm3, %%xmm2")            /* xmm2 = di + ic*r + rc*i */
+            __ASM_EMIT("movups      %%xmm0, 0x00(%[dst])")
+            __ASM_EMIT("movups      %%xmm2, 0x10(%[dst])")
+
+            // Move pointers and repeat
+            __ASM_EMIT("add         $0x20, %[c1]")
+            __ASM_EMIT("add         $0x20, %[c2]")
+            __ASM_EMIT("add         $0x20, %[dst]")
+            __ASM_EMIT("sub         $8, %[items]")
+            __ASM_EMIT("jnz         1b")
+
+            : [dst] "+r" (dst), [c1] "+r" (c1), [c2] "+r" (c2), [items] "+r" (items)
+            :
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm5", "%xmm7"
+        );
+    }
 }
 
 #undef DSP_ARCH_X86_SSE_FASTCONV_H_IMPL
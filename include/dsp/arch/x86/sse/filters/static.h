@@ -675,6 +675,57 @@ namespace sse
               "%xmm4", "%xmm5", "%xmm6", "%xmm7"
         );
     }
+
+    void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f)
+    {
+        ARCH_X86_ASM
+        (
+            // Check count
+            __ASM_EMIT("test        %[count], %[count]")
+            __ASM_EMIT("jz          2f")
+
+            // Load permanent data
+            __ASM_EMIT("xorps       %%xmm4, %%xmm4")                            // xmm4 = 0 0 0 0
+            __ASM_EMIT("movups      0x00(%[f]), %%xmm7")                        // xmm7 = d0 e0 d1 e1
+            __ASM_EMIT("movlps      " BIQUAD_XN_SOFF " + 0x00(%[f]), %%xmm4")   // xmm4 = b0 j0 0 0
+            __ASM_EMIT("movups      " BIQUAD_XN_SOFF " + 0x08(%[f]), %%xmm5")   // xmm5 = b1 j1 b2 j2
+            __ASM_EMIT("movups      " BIQUAD_XN_SOFF " + 0x18(%[f]), %%xmm6")   // xmm6 = a1 i1 a2 i2
+
+            // Start loop
+            __ASM_EMIT(".align      16")
+            __ASM_EMIT("1:")
+            __ASM_EMIT("movlps      (%[src]), %%xmm0")                          // xmm0 = s r ? ?
+            __ASM_EMIT("movaps      %%xmm4, %%xmm1")                            // xmm1 = b0 j0 0 0
+            __ASM_EMIT("movlhps     %%xmm0, %%xmm0")                            // xmm0 = s r s r
+            __ASM_EMIT("xorps       %%xmm3, %%xmm3")                            // xmm3 = 0 0 0 0
+            __ASM_EMIT("mulps       %%xmm0, %%xmm1")                            // xmm1 = b0*s j0*r 0 0
+            __ASM_EMIT("mulps       %%xmm5, %%xmm0")                            // xmm0 = b1*s j1*r b2*s j2*r
+            __ASM_EMIT("addps       %%xmm7, %%xmm1")                            // xmm1 = s' r' ? ? = b0*s+d0 j0*r+e0 ? ?
+            __ASM_EMIT("movhlps     %%xmm7, %%xmm3")                            // xmm3 = d1 e1 0 0
+            __ASM_EMIT("movlps      %%xmm1, (%[dst])")                          // *dst = s' r'
+            __ASM_EMIT("movlhps     %%xmm1, %%xmm1")                            // xmm1 = s' r' s' r'
+            __ASM_EMIT("mulps       %%xmm6, %%xmm1")                            // xmm1 = a1*s' i1*r' a2*s' i2*r'
+            __ASM_EMIT("addps       %%xmm3, %%xmm0")                            // xmm0 = d1+b1*s e1+j1*r b2*s j2*r
+            __ASM_EMIT("add         $0x08, %[src]")
+            __ASM_EMIT("addps       %%xmm0, %%xmm1")                            // xmm1 = d0' e0' d1' e1'
+            __ASM_EMIT("add         $0x08, %[dst]")
+            __ASM_EMIT("movaps      %%xmm1, %%xmm7")                            // xmm7 = d0' e0' d1' e1'
+            __ASM_EMIT("dec         %[count]")
+            __ASM_EMIT("jnz         1b")
+
+            // Store the updated buffer state
+            __ASM_EMIT("movups      %%xmm7, 0x00(%[f])")
+
+            // Exit label
+            __ASM_EMIT("2:")
+
+            : [dst] "+r" (dst), [src] "+r" (src), [count] "+r" (count)
+            : [f] "r" (f)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+        );
+    }
 }
 
 #endif /* DSP_ARCH_X86_SSE_FILTERS_STATIC_H_ */
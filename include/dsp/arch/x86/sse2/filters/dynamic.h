@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_SSE2_FILTERS_DYNAMIC_H_
+#define DSP_ARCH_X86_SSE2_FILTERS_DYNAMIC_H_
+
+#ifndef DSP_ARCH_X86_SSE2_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_SSE2_IMPL */
+
+namespace sse2
+{
+    void dyn_biquad_process_dx1(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f)
+    {
+        IF_ARCH_X86(size_t off);
+
+        ARCH_X86_ASM
+        (
+            // Check count
+            __ASM_EMIT32("cmpl      $0, %[count]")
+            __ASM_EMIT64("test      %[count], %[count]")
+            __ASM_EMIT("jz          2f")
+
+            // Load permanent data
+            __ASM_EMIT("movsd       0x00(%[d]), %%xmm6")                    // xmm6 = d0
+            __ASM_EMIT("xor         %[off], %[off]")
+            __ASM_EMIT("movsd       0x08(%[d]), %%xmm7")                    // xmm7 = d1
+
+            // Start loop
+            __ASM_EMIT("1:")
+            __ASM_EMIT("cvtss2sd    (%[src], %[off], 4), %%xmm0")           // xmm0 = s
+            __ASM_EMIT("movsd       0x00(%[f]), %%xmm1")                    // xmm1 = b0
+            __ASM_EMIT("movsd       0x08(%[f]), %%xmm2")                    // xmm2 = b1
+            __ASM_EMIT("mulsd       %%xmm0, %%xmm1")                        // xmm1 = b0*s
+            __ASM_EMIT("movsd       0x18(%[f]), %%xmm3")                    // xmm3 = a1
+            __ASM_EMIT("mulsd       %%xmm0, %%xmm2")                        // xmm2 = b1*s
+            __ASM_EMIT("addsd       %%xmm6, %%xmm1")                        // xmm1 = s' = b0*s + d0
+            __ASM_EMIT("mulsd       0x10(%[f]), %%xmm0")                    // xmm0 = b2*s
+            __ASM_EMIT("cvtsd2ss    %%xmm1, %%xmm4")                        // xmm4 = float(s')
+            __ASM_EMIT("movapd      %%xmm7, %%xmm6")                        // xmm6 = d1
+            __ASM_EMIT("movss       %%xmm4, (%[dst], %[off], 4)")           // *dst = s'
+            __ASM_EMIT("mulsd       %%xmm1, %%xmm3")                        // xmm3 = a1*s'
+            __ASM_EMIT("add         $1, %[off]")
+            __ASM_EMIT("mulsd       0x20(%[f]), %%xmm1")                    // xmm1 = a2*s'
+            __ASM_EMIT("addsd       %%xmm3, %%xmm2")                        // xmm2 = b1*s + a1*s'
+            __ASM_EMIT("addsd       %%xmm0, %%xmm1")                        // xmm1 = d1' = b2*s + a2*s'
+            __ASM_EMIT("add         $0x40, %[f]")
+            __ASM_EMIT("cmp         %[count], %[off]")
+            __ASM_EMIT("addsd       %%xmm2, %%xmm6")                        // xmm6 = d0' = d1 + b1*s + a1*s'
+            __ASM_EMIT("movapd      %%xmm1, %%xmm7")                        // xmm7 = d1'
+            __ASM_EMIT("jb          1b")
+
+            // Store the updated buffer state
+            __ASM_EMIT("movsd       %%xmm6, 0x00(%[d])")
+            __ASM_EMIT("movsd       %%xmm7, 0x08(%[d])")
+
+            // Exit label
+            __ASM_EMIT("2:")
+
+            : [off] "=&r"(off), [f] "+r" (f)
+            : [dst] "r" (dst), [src] "r" (src),
+              [count] __ASM_ARG_RO (count),
+              [d] "r" (d)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm6", "%xmm7"
+        );
+    }
+}
+
+#endif /* DSP_ARCH_X86_SSE2_FILTERS_DYNAMIC_H_ */
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_ARCH_X86_SSE2_FILTERS_STATIC_H_
+#define DSP_ARCH_X86_SSE2_FILTERS_STATIC_H_
+
+#ifndef DSP_ARCH_X86_SSE2_IMPL
+    #error "This header should not be included directly"
+#endif /* DSP_ARCH_X86_SSE2_IMPL */
+
+namespace sse2
+{
+    void biquad_process_dx1(float *dst, const float *src, size_t count, biquad_d_t *f)
+    {
+        IF_ARCH_X86(size_t off);
+
+        ARCH_X86_ASM
+        (
+            // Check count
+            __ASM_EMIT("test        %[count], %[count]")
+            __ASM_EMIT("jz          2f")
+
+            // Load permanent data
+            __ASM_EMIT("movsd       0x00(%[f]), %%xmm6")                            // xmm6 = d0
+            __ASM_EMIT("xor         %[off], %[off]")
+            __ASM_EMIT("movsd       0x08(%[f]), %%xmm7")                            // xmm7 = d1
+
+            // Start loop
+            __ASM_EMIT("1:")
+            __ASM_EMIT("cvtss2sd    (%[src], %[off], 4), %%xmm0")                   // xmm0 = s
+            __ASM_EMIT("movsd       " BIQUAD_XN_SOFF " + 0x00(%[f]), %%xmm1")       // xmm1 = b0
+            __ASM_EMIT("movsd       " BIQUAD_XN_SOFF " + 0x08(%[f]), %%xmm2")       // xmm2 = b1
+            __ASM_EMIT("mulsd       %%xmm0, %%xmm1")                                // xmm1 = b0*s
+            __ASM_EMIT("movsd       " BIQUAD_XN_SOFF " + 0x18(%[f]), %%xmm3")       // xmm3 = a1
+            __ASM_EMIT("mulsd       %%xmm0, %%xmm2")                                // xmm2 = b1*s
+            __ASM_EMIT("addsd       %%xmm6, %%xmm1")                                // xmm1 = s' = b0*s + d0
+            __ASM_EMIT("mulsd       " BIQUAD_XN_SOFF " + 0x10(%[f]), %%xmm0")       // xmm0 = b2*s
+            __ASM_EMIT("cvtsd2ss    %%xmm1, %%xmm4")                                // xmm4 = float(s')
+            __ASM_EMIT("movapd      %%xmm7, %%xmm6")                                // xmm6 = d1
+            __ASM_EMIT("movss       %%xmm4, (%[dst], %[off], 4)")                   // *dst = s'
+            __ASM_EMIT("mulsd       %%xmm1, %%xmm3")                                // xmm3 = a1*s'
+            __ASM_EMIT("add         $1, %[off]")
+            __ASM_EMIT("mulsd       " BIQUAD_XN_SOFF " + 0x20(%[f]), %%xmm1")       // xmm1 = a2*s'
+            __ASM_EMIT("addsd       %%xmm3, %%xmm2")                                // xmm2 = b1*s + a1*s'
+            __ASM_EMIT("addsd       %%xmm0, %%xmm1")                                // xmm1 = d1' = b2*s + a2*s'
+            __ASM_EMIT("cmp         %[count], %[off]")
+            __ASM_EMIT("addsd       %%xmm2, %%xmm6")                                // xmm6 = d0' = d1 + b1*s + a1*s'
+            __ASM_EMIT("movapd      %%xmm1, %%xmm7")                                // xmm7 = d1'
+            __ASM_EMIT("jb          1b")
+
+            // Store the updated buffer state
+            __ASM_EMIT("movsd       %%xmm6, 0x00(%[f])")
+            __ASM_EMIT("movsd       %%xmm7, 0x08(%[f])")
+
+            // Exit label
+            __ASM_EMIT("2:")
+
+            : [off] "=&r"(off)
+            : [dst] "r" (dst), [src] "r" (src),
+              [count] "r" (count),
+              [f] "r" (f)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm6", "%xmm7"
+        );
+    }
+
+    /*
+     * Compute both filters of the x2 bank:
+     *   in:    xmm0 = [s, r], xmm6 = d0, xmm7 = d1
+     *   out:   xmm0 = [s', r'], xmm1 = d0', xmm2 = d1'
+     */
+    #define BIQUAD_DX2_CALC \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm1")                                /* xmm1 = x */ \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm2")                                /* xmm2 = x */ \
+        __ASM_EMIT("mulpd       " BIQUAD_XN_SOFF " + 0x00(%[f]), %%xmm0")       /* xmm0 = b0*x */ \
+        __ASM_EMIT("mulpd       " BIQUAD_XN_SOFF " + 0x10(%[f]), %%xmm1")       /* xmm1 = b1*x */ \
+        __ASM_EMIT("addpd       %%xmm6, %%xmm0")                                /* xmm0 = x' = b0*x + d0 */ \
+        __ASM_EMIT("mulpd       " BIQUAD_XN_SOFF " + 0x20(%[f]), %%xmm2")       /* xmm2 = b2*x */ \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm3")                                /* xmm3 = x' */ \
+        __ASM_EMIT("movapd      %%xmm0, %%xmm4")                                /* xmm4 = x' */ \
+        __ASM_EMIT("mulpd       " BIQUAD_XN_SOFF " + 0x30(%[f]), %%xmm3")       /* xmm3 = a1*x' */ \
+        __ASM_EMIT("mulpd       " BIQUAD_XN_SOFF " + 0x40(%[f]), %%xmm4")       /* xmm4 = a2*x' */ \
+        __ASM_EMIT("addpd       %%xmm3, %%xmm1")                                /* xmm1 = b1*x + a1*x' */ \
+        __ASM_EMIT("addpd       %%xmm4, %%xmm2")                                /* xmm2 = d1' = b2*x + a2*x' */ \
+        __ASM_EMIT("addpd       %%xmm7, %%xmm1")                                /* xmm1 = d0' = d1 + b1*x + a1*x' */
+
+    void biquad_process_dx2(float *dst, const float *src, size_t count, biquad_d_t *f)
+    {
+        ARCH_X86_ASM
+        (
+            // Check count
+            __ASM_EMIT("test        %[count], %[count]")
+            __ASM_EMIT("jz          2f")
+
+            // Load permanent data
+            __ASM_EMIT("movapd      0x00(%[f]), %%xmm6")                            // xmm6 = d0
+            __ASM_EMIT("movapd      0x10(%[f]), %%xmm7")                            // xmm7 = d1
+
+            // First filter only
+            __ASM_EMIT("xorpd       %%xmm0, %%xmm0")
+            __ASM_EMIT("cvtss2sd    (%[src]), %%xmm0")                              // xmm0 = [s, 0]
+            BIQUAD_DX2_CALC
+            __ASM_EMIT("movsd       %%xmm1, %%xmm6")                                // xmm6 = [d0'[0], d0[1]]
+            __ASM_EMIT("movsd       %%xmm2, %%xmm7")                                // xmm7 = [d1'[0], d1[1]]
+            __ASM_EMIT("add         $4, %[src]")
+            __ASM_EMIT("sub         $1, %[count]")
+            __ASM_EMIT("jz          4f")
+
+            // Both filters
+            __ASM_EMIT("1:")
+            __ASM_EMIT("cvtss2sd    (%[src]), %%xmm5")                              // xmm5 = [s, ?]
+            __ASM_EMIT("unpcklpd    %%xmm0, %%xmm5")                                // xmm5 = [s, r]
+            __ASM_EMIT("movapd      %%xmm5, %%xmm0")                                // xmm0 = [s, r]
+            BIQUAD_DX2_CALC
+            __ASM_EMIT("movapd      %%xmm1, %%xmm6")                                // xmm6 = d0'
+            __ASM_EMIT("movhlps     %%xmm0, %%xmm3")                                // xmm3 = r'
+            __ASM_EMIT("movapd      %%xmm2, %%xmm7")                                // xmm7 = d1'
+            __ASM_EMIT("cvtsd2ss    %%xmm3, %%xmm3")                                // xmm3 = float(r')
+            __ASM_EMIT("add         $4, %[src]")
+            __ASM_EMIT("movss       %%xmm3, (%[dst])")                              // *dst = r'
+            __ASM_EMIT("add         $4, %[dst]")
+            __ASM_EMIT("sub         $1, %[count]")
+            __ASM_EMIT("jnz         1b")
+
+            // Second filter only
+            __ASM_EMIT("4:")
+            __ASM_EMIT("unpcklpd    %%xmm0, %%xmm0")                                // xmm0 = [r, r]
+            BIQUAD_DX2_CALC
+            __ASM_EMIT("movsd       %%xmm6, %%xmm1")                                // xmm1 = [d0[0], d0'[1]]
+            __ASM_EMIT("movsd       %%xmm7, %%xmm2")                                // xmm2 = [d1[0], d1'[1]]
+            __ASM_EMIT("movhlps     %%xmm0, %%xmm3")                                // xmm3 = r'
+            __ASM_EMIT("movapd      %%xmm1, 0x00(%[f])")
+            __ASM_EMIT("cvtsd2ss    %%xmm3, %%xmm3")                                // xmm3 = float(r')
+            __ASM_EMIT("movapd      %%xmm2, 0x10(%[f])")
+            __ASM_EMIT("movss       %%xmm3, (%[dst])")                              // *dst = r'
+
+            // Exit label
+            __ASM_EMIT("2:")
+
+            : [dst] "+r" (dst), [src] "+r" (src),
+              [count] "+r" (count)
+            : [f] "r" (f)
+            : "cc", "memory",
+              "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+              "%xmm4", "%xmm5", "%xmm6", "%xmm7"
+        );
+    }
+
+    #undef BIQUAD_DX2_CALC
+}
+
+#endif /* DSP_ARCH_X86_SSE2_FILTERS_STATIC_H_ */
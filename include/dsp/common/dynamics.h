@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DSP_COMMON_DYNAMICS_H_
+#define DSP_COMMON_DYNAMICS_H_
+
+#ifndef __DSP_DSP_DEFS
+    #error "This header should not be included directly"
+#endif /* __DSP_DSP_DEFS */
+
+namespace dsp
+{
+    /**
+     * Knee of the dynamics gain curve, all polynomials are computed
+     * for the natural logarithm of the input level lx = ln(|x|) and
+     * produce the natural logarithm of the gain:
+     *
+     *   x <= start         : g = lo[0]*lx + lo[1]
+     *   x >= end           : g = hi[0]*lx + hi[1]
+     *   start < x < end    : g = ((herm[0]*lx + herm[1])*lx + herm[2])*lx + herm[3]
+     *
+     * The knee covers downward and upward compression, expansion and gating
+     */
+    typedef struct dyn_knee_t
+    {
+        float   start;          // Start of the knee
+        float   end;            // End of the knee
+        float   lo[2];          // Log-gain below the knee
+        float   herm[4];        // Cubic Hermite interpolation of the log-gain inside the knee
+        float   hi[2];          // Log-gain above the knee
+    } dyn_knee_t;
+
+    /**
+     * Compute gain of the single-knee dynamics curve:
+     * dst[i] = exp(g(|src[i]|))
+     *
+     * @param dst destination buffer
+     * @param src source buffer (envelope)
+     * @param k knee
+     * @param count number of elements to process
+     */
+    extern void (* dyn_gain_x1)(float *dst, const float *src, const dyn_knee_t *k, size_t count);
+
+    /**
+     * Compute gain of the dual-knee dynamics curve:
+     * dst[i] = exp(g1(|src[i]|) + g2(|src[i]|))
+     *
+     * @param dst destination buffer
+     * @param src source buffer (envelope)
+     * @param k array of two knees
+     * @param count number of elements to process
+     */
+    extern void (* dyn_gain_x2)(float *dst, const float *src, const dyn_knee_t *k, size_t count);
+
+    /**
+     * Compute output level of the single-knee dynamics curve:
+     * dst[i] = |src[i]| * exp(g(|src[i]|))
+     *
+     * @param dst destination buffer
+     * @param src source buffer (input level)
+     * @param k knee
+     * @param count number of elements to process
+     */
+    extern void (* dyn_curve_x1)(float *dst, const float *src, const dyn_knee_t *k, size_t count);
+
+    /**
+     * Compute output level of the dual-knee dynamics curve:
+     * dst[i] = |src[i]| * exp(g1(|src[i]|) + g2(|src[i]|))
+     *
+     * @param dst destination buffer
+     * @param src source buffer (input level)
+     * @param k array of two knees
+     * @param count number of elements to process
+     */
+    extern void (* dyn_curve_x2)(float *dst, const float *src, const dyn_knee_t *k, size_t count);
+}
+
+#endif /* DSP_COMMON_DYNAMICS_H_ */
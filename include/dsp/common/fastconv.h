@@ -69,6 +69,16 @@ namespace dsp
      * @param rank the convolution rank
      */
     extern void (* fastconv_apply)(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+
+    /** Convolve two convolutions and add the result to the accumulator convolution data,
+     * allows to sum up several convolutions before calling the restore routine
+     *
+     * @param dst accumulator fast convolution data of 2^(rank+1) floats
+     * @param c1 fast convolution data of 2^(rank+1) floats
+     * @param c2 fast convolution data of 2^(rank+1) floats
+     * @param rank the convolution rank
+     */
+    extern void (* fastconv_fmadd)(float *dst, const float *c1, const float *c2, size_t rank);
 }
 
 #endif /* DSP_COMMON_FASTCONV_H_ */
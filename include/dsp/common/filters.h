@@ -129,6 +129,34 @@
    static filters and applied to the input sample in a pipeline mode.
  */
 
+/*
+  MULTICHANNEL FILTERS
+
+    Multichannel static filters use the same x2, x4 and x8 filter banks but
+    each lane of the bank belongs to an independent audio channel instead of
+    the next cascade of the same channel. The input and output data is
+    stored as interleaved frames, for example for x4 bank:
+
+      Index     +0x00   +0x01   +0x02   +0x03
+              ┌───────┬───────┬───────┬───────┐
+       +0x00  │ c[0:0]│ c[1:0]│ c[2:0]│ c[3:0]│
+              ├───────┼───────┼───────┼───────┤
+       +0x04  │ c[0:1]│ c[1:1]│ c[2:1]│ c[3:1]│
+              ├───────┼───────┼───────┼───────┤
+       +0x08  │ c[0:2]│ c[1:2]│ c[2:2]│ c[3:2]│
+              └───────┴───────┴───────┴───────┘
+
+       Each cell is the sample c[i:j] where:
+         - i is number of the channel
+         - j is number of the frame
+
+    Each frame is processed by all lanes at once, so there is no pipeline
+    latency and the whole SIMD register is used even for a single cascade.
+    Cascades of the filter chain are applied by sequential calls of the
+    function on the same buffer. The filter memory of the lane i is stored
+    at d[i] and d[i + N] elements, where N is the number of lanes.
+ */
+
 /*
   BILINEAR TRANSFORMATION
 
@@ -197,6 +225,7 @@
 #define BIQUAD_XN_SOFF          "0x40"
 #define BIQUAD_ALIGN            0x40
 #define BIQUAD_D_ITEMS          16
+#define BIQUAD_DD_ITEMS         8
 
 #pragma pack(push, 1)
 
@@ -281,6 +310,49 @@ typedef struct biquad_t
     float   __pad[8];
 } __lsp_aligned(BIQUAD_ALIGN) biquad_t;
 
+/**
+ * Double-precision biquad filter bank for 1 digital biquad filter
+ * Non-used elements should be filled with zeros
+ */
+typedef struct biquad_dx1_t
+{
+    double  b0, b1, b2;     //  b0 b1 b2
+    double  a1, a2;         //  a1 a2
+    double  p0, p1, p2;     //  padding (not used), SHOULD be zero
+} biquad_dx1_t;
+
+/**
+ * Double-precision biquad filter bank for 2 digital biquad filters
+ * Non-used elements should be filled with zeros
+ */
+typedef struct biquad_dx2_t
+{
+    double  b0[2];
+    double  b1[2];
+    double  b2[2];
+    double  a1[2];
+    double  a2[2];
+    double  p[2];           // padding (not used), SHOULD be zero
+} biquad_dx2_t;
+
+/**
+ * Double-precision filter structure with memory elements. Filter coefficients
+ * are located at the same offset as for the biquad_t structure.
+ * Double precision keeps low-frequency filters at high sample rates stable
+ * and free of limit cycles, the input and output samples are still
+ * single-precision
+ */
+typedef struct biquad_d_t
+{
+    double  d[BIQUAD_DD_ITEMS];
+    union
+    {
+        biquad_dx1_t x1;
+        biquad_dx2_t x2;
+    };
+    double  __pad[4];
+} __lsp_aligned(BIQUAD_ALIGN) biquad_d_t;
+
 #pragma pack(pop)
 
 //-----------------------------------------------------------------------
@@ -326,6 +398,36 @@ namespace dsp
      */
     extern void (* biquad_process_x8)(float *dst, const float *src, size_t count, biquad_t *f);
 
+    /** Process single double-precision bi-quadratic filter for multiple samples
+     *
+     * @param dst destination samples
+     * @param src source samples
+     * @param count number of samples to process
+     * @param f double-precision bi-quadratic filter structure
+     */
+    extern void (* biquad_process_dx1)(float *dst, const float *src, size_t count, biquad_d_t *f);
+
+    /** Process two double-precision bi-quadratic filters for multiple samples simultaneously
+     *
+     * @param dst destination samples
+     * @param src source samples
+     * @param count number of samples to process
+     * @param f double-precision bi-quadratic filter structure
+     */
+    extern void (* biquad_process_dx2)(float *dst, const float *src, size_t count, biquad_d_t *f);
+
+    //---------------------------------------------------------------------------------------
+    // Multichannel static filters
+    //---------------------------------------------------------------------------------------
+    /** Process one bi-quadratic filter cascade for two independent channels simultaneously
+     *
+     * @param dst destination interleaved frames of two samples
+     * @param src source interleaved frames of two samples
+     * @param count number of frames to process
+     * @param f bi-quadratic filter structure, x2 bank with one lane per channel
+     */
+    extern void (* biquad_process_c2)(float *dst, const float *src, size_t count, biquad_t *f);
+
     //---------------------------------------------------------------------------------------
     // Dynamic filters
     //---------------------------------------------------------------------------------------
@@ -369,6 +471,16 @@ namespace dsp
      */
     extern void (* dyn_biquad_process_x8)(float *dst, const float *src, float *d, size_t count, const biquad_x8_t *f);
 
+    /** Process single dynamic double-precision bi-quadratic filter for multiple samples
+     *
+     * @param dst array of count destination samples to emit
+     * @param src array of count source samples to process
+     * @param d pointer to filter memory (2 doubles)
+     * @param count number of samples to process
+     * @param f array of count memory-aligned double-precision bi-quadratic filters
+     */
+    extern void (* dyn_biquad_process_dx1)(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f);
+
     //---------------------------------------------------------------------------------------
     // Transfer function calculation
     //---------------------------------------------------------------------------------------
@@ -449,6 +561,15 @@ namespace dsp
      */
     extern void (* bilinear_transform_x8)(biquad_x8_t *bf, const f_cascade_t *bc, float kf, size_t count);
 
+    /** Perform bilinear transformation of one filter bank with double precision
+     *
+     * @param bf memory-aligned target transformed double-precision biquad x1 filters
+     * @param bc memory-aligned source analog bilinear filter cascades
+     * @param kf frequency shift coefficient
+     * @param count number of cascades  to process
+     */
+    extern void (* bilinear_transform_dx1)(biquad_dx1_t *bf, const f_cascade_t *bc, double kf, size_t count);
+
     //---------------------------------------------------------------------------------------
     // Matched Z transformation of dynamic filters
     //---------------------------------------------------------------------------------------
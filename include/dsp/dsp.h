@@ -46,6 +46,7 @@
 #include <dsp/common/smath.h>
 #include <dsp/common/interpolate.h>
 #include <dsp/common/crossfade.h>
+#include <dsp/common/dynamics.h>
 
 #include <dsp/common/search/minmax.h>
 #include <dsp/common/search/iminmax.h>
@@ -66,6 +66,9 @@ namespace lsp
         static const size_t         FFT_WINDOW          = windows::HANN;
         static const size_t         REFRESH_RATE        = 20;
 
+        // Linear-phase (FFT) crossover
+        static const size_t         XOVER_FFT_RANK      = 13;
+
         // Zoom
         static const float          ZOOM_MIN            = GAIN_AMP_M_18_DB;
         static const float          ZOOM_MAX            = GAIN_AMP_0_DB;
@@ -98,6 +98,18 @@ namespace lsp
             OVS_FULL_8X2,
             OVS_FULL_8X3,
 
+            OVS_FIR_LINEAR_2X,
+            OVS_FIR_LINEAR_3X,
+            OVS_FIR_LINEAR_4X,
+            OVS_FIR_LINEAR_6X,
+            OVS_FIR_LINEAR_8X,
+
+            OVS_FIR_MINPHASE_2X,
+            OVS_FIR_MINPHASE_3X,
+            OVS_FIR_MINPHASE_4X,
+            OVS_FIR_MINPHASE_6X,
+            OVS_FIR_MINPHASE_8X,
+
             OVS_DEFAULT     = OVS_NONE
         };
 
@@ -33,6 +33,11 @@ namespace lsp
         static const float SAMPLE_LENGTH_DFL        = 0.0f;     // Sample length (ms)
         static const float SAMPLE_LENGTH_STEP       = 0.1f;     // Sample step (ms)
 
+        static const float SAMPLE_STREAM_THRESHOLD  = 4000.0f;  // Minimum length of the file to stream it from disk (ms)
+        static const float SAMPLE_STREAM_HEAD       = 1000.0f;  // Length of the preloaded head of the streamed file (ms)
+        static const size_t SAMPLE_STREAM_VOICES    = 64;       // Maximum number of simultaneously streamed playbacks
+        static const size_t SAMPLE_STREAM_PEAKS     = 4096;     // Number of points of the peak envelope of the streamed file
+
         static const float PREDELAY_MIN             = 0.0f;     // Pre-delay min (ms)
         static const float PREDELAY_MAX             = 100.0f;   // Pre-delay max (ms)
         static const float PREDELAY_DFL             = 0.0f;     // Pre-delay default (ms)
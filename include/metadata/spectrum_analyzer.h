@@ -36,6 +36,8 @@ namespace lsp
         static const size_t         RANK_MIN            = 10;
         static const size_t         RANK_DFL            = 12;
         static const size_t         RANK_MAX            = 14;
+        static const size_t         RANK_LEVEL          = 11;   // FFT rank of each level of multi-resolution analysis
+        static const size_t         LEVELS_MAX          = RANK_MAX - RANK_LEVEL + 1;
         static const size_t         MESH_POINTS         = 640;
 
         static const float          THRESH_HI_DB        = 0.0f;
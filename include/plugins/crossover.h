@@ -81,12 +81,14 @@ namespace lsp
             {
                 Bypass          sBypass;            // Bypass
                 Crossover       sXOver;             // Crossover module
+                Delay           sDryDelay;          // Latency compensation delay for the dry signal
 
                 xover_split_t   vSplit[crossover_base_metadata::BANDS_MAX-1];   // Split bands
                 xover_band_t    vBands[crossover_base_metadata::BANDS_MAX];     // Crossover bands
 
                 float          *vIn;                // Input buffer
                 float          *vOut;               // Output buffer
+                float          *vDry;               // Dry signal buffer
                 float          *vInAnalyze;         // Input analysis
                 float          *vOutAnalyze;        // Output analysis
                 float          *vBuffer;            // Common data processing buffer
@@ -97,6 +99,7 @@ namespace lsp
                 size_t          nAnInChannel;       // Analyzer channel used for input signal analysis
                 size_t          nAnOutChannel;      // Analyzer channel used for output signal analysis
                 bool            bSyncCurve;         // Sync frequency response curve
+                bool            bUpdateCurve;       // Frequency response needs to be recomputed
                 float           fInLevel;           // Input level meter
                 float           fOutLevel;          // Output level meter
 
@@ -133,12 +136,14 @@ namespace lsp
             IPort          *pReactivity;            // Reactivity
             IPort          *pShiftGain;             // Shift gain port
             IPort          *pZoom;                  // Zoom port
+            IPort          *pType;                  // Crossover type
             IPort          *pMSOut;                 // Mid/Side output
 
         protected:
             static void         process_band(void *object, void *subject, size_t band, const float *data, size_t sample, size_t count);
             static inline crossover_mode_t  crossover_mode(size_t slope);
             static inline size_t            crossover_slope(size_t slope);
+            void                update_curves(channel_t *c);
 
         public:
             explicit crossover_base(const plugin_metadata_t &metadata, size_t mode);
@@ -119,6 +119,7 @@ namespace lsp
             float_buffer_t     *pIDisplay;      // Inline display buffer
 
             IPort              *pEqMode;        // Equalizer mode
+            IPort              *pLowLatency;    // Low-latency processing
             IPort              *pSlope;         // Filter slope
             IPort              *pListen;        // Mid-Side listen
             IPort              *pInGain;        // Input gain
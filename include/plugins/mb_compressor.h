@@ -177,6 +177,7 @@ namespace lsp
             bool            bSidechain;             // External side chain
             bool            bEnvUpdate;             // Envelope filter update
             bool            bModern;                // Modern mode
+            bool            bDisplaySync;           // Data shown on the inline display has changed
             size_t          nEnvBoost;              // Envelope boost
             channel_t      *vChannels;              // Compressor channels
             float           fInGain;                // Input gain
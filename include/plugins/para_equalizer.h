@@ -128,6 +128,7 @@ namespace lsp
             IPort              *pShiftGain;             // Shift gain
             IPort              *pZoom;                  // Graph zoom
             IPort              *pEqMode;                // Equalizer mode
+            IPort              *pLowLatency;            // Low-latency processing
             IPort              *pBalance;               // Output balance
 
         protected:
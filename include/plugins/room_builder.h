@@ -264,14 +264,18 @@ namespace lsp
                     room_builder_base      *pBuilder;
                     RayTrace3D             *pRT;
                     size_t                  nThreads;
+                    bool                    bReweight;      // Re-compute samples from cached view paths instead of tracing
+                    bool                    bPreview;       // Render the quick preview before the final pass
                     cvector<sample_t>       vSamples;
+                    cstorage<uint8_t>       vKey;           // Render settings key
                     ipc::Mutex              lkTerminate;
 
                 public:
-                    inline Renderer(room_builder_base *bld, RayTrace3D *rt, size_t threads, cvector<sample_t> &samples):
-                        pBuilder(bld), pRT(rt), nThreads(threads)
+                    inline Renderer(room_builder_base *bld, RayTrace3D *rt, size_t threads, cvector<sample_t> &samples, cstorage<uint8_t> &key, bool reweight, bool preview):
+                        pBuilder(bld), pRT(rt), nThreads(threads), bReweight(reweight), bPreview(preview)
                     {
                         vSamples.swap_data(&samples);
+                        vKey.swap(&key);
                     }
 
                     virtual status_t run();
@@ -332,6 +336,7 @@ namespace lsp
             ssize_t                 nRenderThreads;
             float                   fRenderQuality;
             bool                    bRenderNormalize;
+            bool                    bRenderPreview;
             status_t                enRenderStatus;
             float                   fRenderProgress;
             float                   fRenderCmd;
@@ -344,8 +349,12 @@ namespace lsp
             source_t                vSources[room_builder_base_metadata::SOURCES];
 
             Scene3D                 sScene;
+            size_t                  nSceneVersion;  // Version of the scene, incremented on each load
             vector3d_t              sScale;
             Renderer               *pRenderer;
+            RayTrace3D             *pCache;         // Ray tracer holding view paths of the last rendering
+            cvector<sample_t>       vCache;         // Samples bound to the cached ray tracer
+            cstorage<uint8_t>       vCacheKey;      // Render settings key of the cached ray tracer
 
             status_t                nSceneStatus;
             float                   fSceneProgress;
@@ -365,6 +374,7 @@ namespace lsp
             IPort                  *pRenderStatus;
             IPort                  *pRenderProgress;
             IPort                  *pRenderNormalize;
+            IPort                  *pRenderPreview;
             IPort                  *pRenderCmd;
             IPort                  *pOutGain;
             IPort                  *pPredelay;
@@ -387,6 +397,10 @@ namespace lsp
             status_t            bind_sources(RayTrace3D *rt);
             status_t            bind_captures(cvector<sample_t> &samples, RayTrace3D *rt);
             status_t            bind_scene(KVTStorage *kvt, RayTrace3D *rt);
+            status_t            bind_materials(KVTStorage *kvt, RayTrace3D *rt);
+            status_t            build_render_key(cstorage<uint8_t> *key, KVTStorage *kvt);
+            void                store_cache(RayTrace3D *rt, cvector<sample_t> &samples, cstorage<uint8_t> &key);
+            void                drop_cache();
             status_t            commit_samples(cvector<sample_t> &samples);
             status_t            reconfigure(const reconfig_t *cfg);
             status_t            save_sample(const char *path, size_t sample_id);
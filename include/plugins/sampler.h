@@ -33,7 +33,9 @@
 #include <core/util/Blink.h>
 #include <core/util/Randomizer.h>
 #include <core/files/AudioFile.h>
+#include <core/files/AudioStream.h>
 #include <core/sampling/SamplePlayer.h>
+#include <core/sampling/SampleStreamer.h>
 
 
 namespace lsp
@@ -57,6 +59,20 @@ namespace lsp
                     virtual status_t run();
             };
 
+            class AFScanner: public ipc::ITask
+            {
+                private:
+                    sampler_kernel         *pCore;
+                    afile_t                *pFile;
+
+                public:
+                    AFScanner(sampler_kernel *base, afile_t *descr);
+                    virtual ~AFScanner();
+
+                public:
+                    virtual status_t run();
+            };
+
         protected:
             struct afsample_t
             {
@@ -64,6 +80,12 @@ namespace lsp
                 float               fNorm;                  // Normalizing factor
                 Sample             *pSample;                // Sample
                 float              *vThumbs[TRACKS_MAX];    // List of thumbnails
+                AudioStream        *pStream;                // Stream of the data not loaded into memory
+                size_t              nLength;                // Overall length of the file in samples
+                float              *vPeaks[TRACKS_MAX];     // Peak envelope of the streamed file
+                AudioStream        *pScanStream;            // Stream for the background scan of the peak envelope
+                size_t              nPeakBlock;             // Number of samples per one point of peak envelope
+                bool                bFull;                  // Long file fully loaded into memory for reversed playback
             };
 
             enum afindex_t
@@ -78,9 +100,13 @@ namespace lsp
             {
                 size_t              nID;                    // ID of sample
                 AFLoader           *pLoader;                // Audio file loader task
+                AFScanner          *pScanner;               // Peak envelope scanner task
+                bool                bScan;                  // Peak envelope of the current file should be scanned
+                volatile bool       bScanCancel;            // Cancel the running peak envelope scan
 
                 bool                bDirty;                 // Dirty flag
                 bool                bSync;                  // Sync flag
+                bool                bReload;                // Reload flag: the file is being reloaded with another streaming mode
                 float               fVelocity;              // Velocity
                 float               fHeadCut;               // Head cut (ms)
                 float               fTailCut;               // Tail cut (ms)
@@ -122,6 +148,7 @@ namespace lsp
             afile_t            *vFiles;                     // List of audio files
             afile_t           **vActive;                    // List of active audio files
             SamplePlayer        vChannels[TRACKS_MAX];      // List of channels
+            SampleStreamer      sStreamer;                  // Disk streamer of long samples
             Bypass              vBypass[TRACKS_MAX];        // List of bypasses
             Blink               sActivity;                  // Note on led for instrument
 
@@ -148,6 +175,7 @@ namespace lsp
         protected:
             void        destroy_state();
             void        destroy_afsample(afsample_t *af);
+            status_t    scan_stream(afile_t *file);
             int         load_file(afile_t *file);
             void        copy_asample(afsample_t *dst, const afsample_t *src);
             void        clear_asample(afsample_t *dst);
@@ -112,6 +112,7 @@ namespace lsp
             IPort              *pBypass;
             IPort              *pMode;
             IPort              *pTolerance;
+            IPort              *pMultiRes;
             IPort              *pWindow;
             IPort              *pEnvelope;
             IPort              *pPreamp;
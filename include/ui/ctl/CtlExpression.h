@@ -57,6 +57,12 @@ namespace lsp
                         virtual status_t resolve(calc::value_t *value, const LSPString *name, size_t num_indexes, const ssize_t *indexes);
                 };
 
+                typedef struct binding_t
+                {
+                    size_t              nSlot;          // Slot of expression
+                    CtlPort            *pPort;          // Port bound to the slot
+                } binding_t;
+
             protected:
                 calc::Expression    sExpr;
                 calc::Variables     sVars;
@@ -65,6 +71,7 @@ namespace lsp
                 CtlRegistry        *pCtl;
                 CtlPortListener    *pListener;
                 cvector<CtlPort>    vDependencies;
+                cstorage<binding_t> vBindings;
                 #ifdef LSP_TRACE
                 LSPString           sText;
                 #endif /* LSP_TRACE */
@@ -72,6 +79,10 @@ namespace lsp
             protected:
                 void            do_destroy();
                 void            drop_dependencies();
+                void            drop_bindings();
+                status_t        bind_slots();
+                void            update_slots();
+                bool            bound(CtlPort *port) const;
                 status_t        on_resolved(const LSPString *name, CtlPort *p);
 
             public:
@@ -95,7 +106,7 @@ namespace lsp
                 bool            parse(const LSPString *expr, size_t flags = calc::Expression::FLAG_NONE);
                 bool            parse(io::IInSequence *expr, size_t flags = calc::Expression::FLAG_NONE);
                 inline bool     valid() const                   { return sExpr.valid(); };
-                inline bool     depends(CtlPort *port) const    { return vDependencies.index_of(port) >= 0; }
+                inline bool     depends(CtlPort *port) const    { return (vDependencies.index_of(port) >= 0) || (bound(port)); }
 
                 #ifdef LSP_TRACE
                 inline const char *text() const         { return sText.get_utf8(); }
@@ -388,6 +388,14 @@ namespace lsp
                  */
                 virtual void        query_draw(size_t flags = REDRAW_SURFACE);
 
+                /** Report the area of the window that has been changed and should be
+                 * flushed to the screen at the next frame, by default the request
+                 * is passed to the parent widget
+                 *
+                 * @param r damaged area in window coordinates
+                 */
+                virtual void        damage(const realize_t *r);
+
                 /**
                  * Put the widget to the destroy queue of the main loop
                  * @return status of operation
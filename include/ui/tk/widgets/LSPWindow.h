@@ -51,6 +51,12 @@ namespace lsp
                         virtual void        sync();
                 };
 
+            protected:
+                enum damage_t
+                {
+                    DAMAGE_RECTS        = 8     // Maximum number of damage rectangles tracked per frame
+                };
+
             protected:
                 INativeWindow      *pWindow;
                 void               *pNativeHandle;
@@ -59,12 +65,17 @@ namespace lsp
                 ssize_t             nScreen;
                 size_request_t      sConstraints;
                 LSPTimer            sRedraw;
+                timestamp_t         nLastFrame;
+                size_t              nDamage;
+                realize_t           vDamage[DAMAGE_RECTS];
                 LSPWidget          *pFocus;
                 LSPWidget          *pPointed;
                 bool                bHasFocus;
                 bool                bOverridePointer;
                 bool                bSizeRequest;
                 bool                bMapFlag;
+                bool                bRedrawQueued;
+                bool                bUnmapped;
                 float               nVertPos;
                 float               nHorPos;
                 float               nVertScale;
@@ -83,6 +94,9 @@ namespace lsp
 
                 virtual LSPWidget  *find_widget(ssize_t x, ssize_t y);
                 status_t            do_render();
+                void                schedule_render();
+                void                cancel_render();
+                void                flush_damage(ISurface *s, ISurface *bs, bool force);
                 void                do_destroy();
                 status_t            sync_size();
                 status_t            update_pointer();
@@ -161,6 +175,10 @@ namespace lsp
             public:
                 virtual void        query_resize();
 
+                virtual void        query_draw(size_t flags = REDRAW_SURFACE);
+
+                virtual void        damage(const realize_t *r);
+
                 /** Render window's content to surface
                  *
                  * @param s surface to perform rendering
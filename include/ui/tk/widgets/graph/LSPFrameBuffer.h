@@ -44,8 +44,10 @@ namespace lsp
                 size_t          nRows;          // Number of rows in frame buffer
                 size_t          nCols;          // Number of columns in frame buffer
                 uint32_t        nCurrRow;       // Synchronized rowId
+                size_t          nOrigin;        // Row of the surface ring that holds the most recent data
                 float          *vData;          // Frame buffer data
                 float          *vTempRGBA;      // Temporary RGBA buffer data
+                uint32_t       *vLUT;           // Color lookup table for the current palette
                 uint8_t        *pData;          // Allocation pointer
                 float           fTransparency;  // Frame buffer transparency
                 size_t          nAngle;         // Frame buffer rotation angle 0..3
@@ -54,6 +56,7 @@ namespace lsp
                 float           fWidth;         // Width in pixels (-1 .. 1)
                 float           fHeight;        // Height in pixels (-1 .. 1)
                 bool            bClear;         // Clear flag: do complete redraw
+                bool            bUpdateLUT;     // Color lookup table needs to be rebuilt
                 size_t          nPalette;       // Palette used for drawing
                 calc_color_t    pCalcColor;     // Function for estimating color
                 LSPColor        sColor;         // Base color
@@ -69,8 +72,11 @@ namespace lsp
                 void            calc_lightness2(float *rgba, const float *value, size_t n);
                 void            allocate_buffer();
                 void            check_color_changed();
+                void            update_lut();
+                void            draw_row(uint32_t *dst, const float *src, size_t n);
+                void            draw_ring_part(ISurface *s, ISurface *pp, float x, float y, float sx, float sy, float ra,
+                                    float shift, float first, float last, bool snap_first, bool snap_last);
                 float          *get_buffer();
-                float          *get_rgba_buffer();
 
             public:
                 explicit LSPFrameBuffer(LSPDisplay *dpy);
@@ -154,6 +154,7 @@ namespace lsp
 
                 protected:
                     volatile bool   bExit;
+                    int             vWakeup[2];         // Pipe that wakes up the main loop
                     Display        *pDisplay;
                     Window          hRootWnd;           // Root window of the display
                     Window          hClipWnd;           // Unmapped clipboard window
@@ -182,6 +183,8 @@ namespace lsp
 
                     status_t        do_main_iteration(timestamp_t ts);
                     void            do_destroy();
+                    void            wakeup();
+                    void            drain_wakeup();
                     X11Window      *get_locked(X11Window *wnd);
                     X11Window      *get_redirect(X11Window *wnd);
                     static void     compress_long_data(void *data, size_t nitems);
@@ -247,6 +250,8 @@ namespace lsp
                     virtual status_t main_iteration();
                     virtual void quit_main();
 
+                    virtual taskid_t submit_task(timestamp_t time, task_handler_t handler, void *arg);
+
                     virtual size_t screens();
                     virtual size_t default_screen();
                     virtual status_t screen_size(size_t screen, ssize_t *w, ssize_t *h);
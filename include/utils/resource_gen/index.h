@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_RESOURCE_GEN_INDEX_H_
+#define UTILS_RESOURCE_GEN_INDEX_H_
+
+#include <core/types.h>
+#include <core/stdlib/stdio.h>
+#include <core/resource.h>
+#include <data/cvector.h>
+
+#include <utils/resource_gen/resource.h>
+
+#define RESGEN_INDEX_MAX_DISP       0x1000000
+
+namespace lsp
+{
+    namespace resgen
+    {
+        typedef struct index_bucket_t
+        {
+            size_t              id;         // Bucket identifier
+            cstorage<size_t>    items;      // Indexes of resources stored in the bucket
+        } index_bucket_t;
+
+        static size_t index_pow2(size_t value)
+        {
+            size_t res = 1;
+            while (res < value)
+                res   <<= 1;
+            return res;
+        }
+
+        /**
+         * Build perfect hash index for resources (hash and displace method):
+         * resources are distributed into buckets by the hash with zero seed, then
+         * for each bucket the displacement (seed) is found that places all bucket
+         * items into unique free slots of the index
+         *
+         * @param resources list of resources
+         * @param disp array to store displacement for each bucket
+         * @param buckets number of buckets, power of 2
+         * @param slots array to store resource index for each slot
+         * @param size number of slots, power of 2
+         * @return status of operation
+         */
+        status_t build_resource_index(cvector<scan_resource_t> &resources,
+                uint32_t *disp, size_t buckets, int32_t *slots, size_t size)
+        {
+            status_t res = STATUS_OK;
+            cvector<index_bucket_t> vb;
+            cstorage<size_t> pos;
+
+            for (size_t i=0; i<buckets; ++i)
+                disp[i]     = 0;
+            for (size_t i=0; i<size; ++i)
+                slots[i]    = -1;
+
+            // Allocate buckets
+            for (size_t i=0; i<buckets; ++i)
+            {
+                index_bucket_t *b = new index_bucket_t;
+                if ((b == NULL) || (!vb.add(b)))
+                {
+                    if (b != NULL)
+                        delete b;
+                    res         = STATUS_NO_MEM;
+                    break;
+                }
+                b->id       = i;
+            }
+
+            // Distribute resources into buckets
+            for (size_t i=0, n=resources.size(); (res == STATUS_OK) && (i<n); ++i)
+            {
+                const char *id      = resources.at(i)->id;
+                index_bucket_t *b   = vb.at(resource::hash_id(id, 0) & (buckets - 1));
+
+                // Check for duplicates
+                for (size_t j=0, m=b->items.size(); j<m; ++j)
+                {
+                    if (!::strcmp(resources.at(*(b->items.at(j)))->id, id))
+                    {
+                        fprintf(stderr, "Duplicate resource identifier: %s\n", id);
+                        res     = STATUS_DUPLICATED;
+                        break;
+                    }
+                }
+
+                if ((res == STATUS_OK) && (!b->items.add(&i)))
+                    res     = STATUS_NO_MEM;
+            }
+
+            // Sort buckets by number of items in descending order
+            if (res == STATUS_OK)
+            {
+                for (size_t i=0; i<(buckets-1); ++i)
+                    for (size_t j=i+1; j<buckets; ++j)
+                        if (vb.at(i)->items.size() < vb.at(j)->items.size())
+                            vb.swap_unsafe(i, j);
+            }
+
+            // Find displacement for each bucket
+            for (size_t i=0; (res == STATUS_OK) && (i<buckets); ++i)
+            {
+                index_bucket_t *b   = vb.at(i);
+                size_t count        = b->items.size();
+                if (count <= 0)
+                    break;
+
+                uint32_t d;
+                for (d = 1; d < RESGEN_INDEX_MAX_DISP; ++d)
+                {
+                    pos.clear();
+                    bool ok = true;
+
+                    for (size_t j=0; (ok) && (j<count); ++j)
+                    {
+                        const char *id  = resources.at(*(b->items.at(j)))->id;
+                        size_t slot     = resource::hash_id(id, d) & (size - 1);
+                        if (slots[slot] >= 0)
+                            ok              = false;
+                        for (size_t k=0, m=pos.size(); (ok) && (k<m); ++k)
+                            if (*(pos.at(k)) == slot)
+                                ok              = false;
+                        if ((ok) && (!pos.add(&slot)))
+                        {
+                            res             = STATUS_NO_MEM;
+                            break;
+                        }
+                    }
+
+                    if ((ok) || (res != STATUS_OK))
+                        break;
+                }
+
+                if (res != STATUS_OK)
+                    break;
+                else if (d >= RESGEN_INDEX_MAX_DISP)
+                {
+                    fprintf(stderr, "Could not build resource index: bucket %d of %d items\n", int(b->id), int(count));
+                    res     = STATUS_OVERFLOW;
+                    break;
+                }
+
+                // Commit the bucket
+                disp[b->id]     = d;
+                for (size_t j=0; j<count; ++j)
+                    slots[*(pos.at(j))] = *(b->items.at(j));
+            }
+
+            // Free buckets
+            for (size_t i=0, n=vb.size(); i<n; ++i)
+                delete vb.at(i);
+            vb.flush();
+
+            return res;
+        }
+
+        int emit_resource_index(FILE *out, cvector<scan_resource_t> &resources)
+        {
+            // Estimate the size of index
+            size_t items    = resources.size();
+            size_t buckets  = index_pow2((items + 3) >> 2);
+            size_t size     = index_pow2(items + (items >> 2));
+
+            uint32_t *disp  = reinterpret_cast<uint32_t *>(::malloc(buckets * sizeof(uint32_t)));
+            int32_t *slots  = reinterpret_cast<int32_t *>(::malloc(size * sizeof(int32_t)));
+            if ((disp == NULL) || (slots == NULL))
+            {
+                if (disp != NULL)
+                    ::free(disp);
+                if (slots != NULL)
+                    ::free(slots);
+                return STATUS_NO_MEM;
+            }
+
+            status_t res = build_resource_index(resources, disp, buckets, slots, size);
+            if (res == STATUS_OK)
+            {
+                printf("Generated resource index: %d resources, %d buckets, %d slots\n",
+                        int(items), int(buckets), int(size));
+
+                fprintf(out,    "\t// Resource index\n");
+                fprintf(out,    "\tconst size_t builtin_index_buckets = %d;\n", int(buckets));
+                fprintf(out,    "\tconst size_t builtin_index_size = %d;\n\n", int(size));
+
+                fprintf(out,    "\tconst uint32_t builtin_index_disp[] =\n");
+                fprintf(out,    "\t{");
+                for (size_t i=0; i<buckets; ++i)
+                    fprintf(out, "%s%d,", ((i % 16) == 0) ? "\n\t\t" : " ", int(disp[i]));
+                fprintf(out,    "\n\t};\n\n");
+
+                fprintf(out,    "\tconst int32_t builtin_index_slots[] =\n");
+                fprintf(out,    "\t{");
+                for (size_t i=0; i<size; ++i)
+                    fprintf(out, "%s%d,", ((i % 16) == 0) ? "\n\t\t" : " ", int(slots[i]));
+                fprintf(out,    "\n\t};\n\n");
+            }
+
+            ::free(disp);
+            ::free(slots);
+
+            return res;
+        }
+    }
+}
+
+#undef RESGEN_INDEX_MAX_DISP
+
+#endif /* UTILS_RESOURCE_GEN_INDEX_H_ */
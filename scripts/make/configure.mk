@@ -7,7 +7,7 @@ endif
 
 # Determine list of modules to build
 ifndef BUILD_MODULES
-  BUILD_MODULES          := $(shell if (test -f "$(CFGDIR)/$(MODULES_FILE)" )  then cat "$(CFGDIR)/$(MODULES_FILE)" 2>/dev/null; else echo "ladspa lv2 vst jack profile src doc"; fi;)
+  BUILD_MODULES          := $(shell if (test -f "$(CFGDIR)/$(MODULES_FILE)" )  then cat "$(CFGDIR)/$(MODULES_FILE)" 2>/dev/null; else echo "ladspa lv2 vst jack render profile src doc"; fi;)
 endif
 
 ifndef BUILD_R3D_BACKENDS
@@ -45,6 +45,11 @@ ifeq ($(findstring jack,$(BUILD_MODULES)),jack)
   UNINSTALLATIONS        += uninstall_jack
   RELEASES               += release_jack
 endif
+ifeq ($(findstring render,$(BUILD_MODULES)),render)
+  INSTALLATIONS          += install_render
+  UNINSTALLATIONS        += uninstall_render
+  RELEASES               += release_render
+endif
 ifeq ($(findstring doc,$(BUILD_MODULES)),doc)
   INSTALLATIONS          += install_doc
   UNINSTALLATIONS        += uninstall_doc
@@ -131,6 +136,7 @@ else
   export ICONV_LIBS       = -liconv
   export MATH_LIBS        = -lm
   export DL_LIBS          = -ldl
+  export RT_LIBS          = -lrt
   export CAIRO_HEADERS    = $(shell pkg-config --cflags cairo)
   export CAIRO_LIBS       = $(shell pkg-config --libs cairo)
   export XLIB_HEADERS     = $(shell pkg-config --cflags x11)
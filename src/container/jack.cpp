@@ -29,7 +29,7 @@
 #include <core/lib.h>
 #include <core/debug.h>
 #include <core/status.h>
-#include <core/ipc/NativeExecutor.h>
+#include <core/ipc/PoolExecutor.h>
 
 #include <dsp/dsp.h>
 
@@ -0,0 +1,588 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <core/types.h>
+#include <core/debug.h>
+#include <core/status.h>
+#include <core/system.h>
+#include <core/files/AudioFile.h>
+
+#include <dsp/dsp.h>
+
+#include <plugins/plugins.h>
+#include <metadata/plugins.h>
+
+#include <container/render/wrapper.h>
+
+namespace lsp
+{
+    typedef struct render_config_t
+    {
+        const char             *plugin_id;
+        const char             *out_file;
+        const char             *cfg_file;
+        cvector<const char>     in_files;
+        cvector<const char>     params;
+        size_t                  block_size;
+        size_t                  sample_rate;
+        float                   tail;
+        float                   duration;
+        bool                    latency_comp;
+        bool                    stats;
+        bool                    profile;
+    } render_config_t;
+
+    static void render_list_plugins()
+    {
+        cvector<const char> plugin_ids;
+
+        #define MOD_PLUGIN(plugin, ui) plugin_ids.add(plugin::metadata.lv2_uid);
+        #include <metadata/modules.h>
+
+        // Sort the list of plugins
+        for (size_t i=1; i<plugin_ids.size(); ++i)
+            for (size_t j=i; j>0; --j)
+            {
+                if (::strcmp(plugin_ids[j-1], plugin_ids[j]) <= 0)
+                    break;
+                plugin_ids.swap(j-1, j);
+            }
+
+        printf("Available plugin identifiers:\n");
+        for (size_t i=0; i<plugin_ids.size(); ++i)
+            printf("  %s\n", plugin_ids[i]);
+    }
+
+    static bool render_parse_float(float *dst, const char *arg, const char *value)
+    {
+        char *end   = NULL;
+        errno       = 0;
+        float v     = ::strtof(value, &end);
+        if ((errno != 0) || (*end != '\0') || (v < 0.0f))
+        {
+            fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", value, arg);
+            return false;
+        }
+        *dst        = v;
+        return true;
+    }
+
+    static bool render_parse_size(size_t *dst, const char *arg, const char *value)
+    {
+        char *end   = NULL;
+        errno       = 0;
+        long v      = ::strtol(value, &end, 10);
+        if ((errno != 0) || (*end != '\0') || (v <= 0))
+        {
+            fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", value, arg);
+            return false;
+        }
+        *dst        = v;
+        return true;
+    }
+
+    status_t render_parse_config(render_config_t *cfg, int argc, const char **argv)
+    {
+        // Initialize config with default values
+        cfg->plugin_id      = NULL;
+        cfg->out_file       = NULL;
+        cfg->cfg_file       = NULL;
+        cfg->block_size     = RENDER_DEFAULT_BLOCK_SIZE;
+        cfg->sample_rate    = 0;
+        cfg->tail           = 0.0f;
+        cfg->duration       = 0.0f;
+        cfg->latency_comp   = true;
+        cfg->stats          = false;
+        cfg->profile        = false;
+
+        // Parse arguments
+        int i = 1;
+        while (i < argc)
+        {
+            const char *arg = argv[i++];
+            if ((!::strcmp(arg, "--help")) || (!::strcmp(arg, "-h")))
+            {
+                printf("Usage: %s <plugin-id> [parameters]\n\n", argv[0]);
+                printf("Renders audio files with the plugin without any audio server.\n");
+                printf("Audio channels of all input files are passed to the audio inputs of the\n");
+                printf("plugin in order, all audio outputs are stored to the output file.\n\n");
+                printf("Available parameters:\n");
+                printf("  -b, --block <samples>     Maximum block size passed to plugin (default %d)\n", int(RENDER_DEFAULT_BLOCK_SIZE));
+                printf("  -c, --config <file>       Load settings file before rendering\n");
+                printf("  -d, --duration <seconds>  Duration of rendering if there are no input files\n");
+                printf("  -h, --help                Output help\n");
+                printf("  -i, --input <file>        Input audio file, may be specified multiple times\n");
+                printf("  -l, --list                List available plugin identifiers\n");
+                printf("  -n, --no-latency-comp     Do not compensate the latency of the plugin\n");
+                printf("  -o, --output <file>       Output audio file\n");
+                printf("  -p, --param <id>=<value>  Set value of the port, may be specified multiple times\n");
+                printf("  -P, --profile             Profile processing stages and dump plugin state\n");
+                printf("  -r, --rate <hz>           Sample rate (default is sample rate of the first input file)\n");
+                printf("  -s, --stats               Output processing statistics\n");
+                printf("  -t, --tail <seconds>      Additional time to render after the end of input\n");
+                printf("\n");
+
+                return STATUS_CANCELLED;
+            }
+            else if ((!::strcmp(arg, "--list")) || (!::strcmp(arg, "-l")))
+            {
+                render_list_plugins();
+                return STATUS_CANCELLED;
+            }
+            else if ((!::strcmp(arg, "--no-latency-comp")) || (!::strcmp(arg, "-n")))
+                cfg->latency_comp   = false;
+            else if ((!::strcmp(arg, "--stats")) || (!::strcmp(arg, "-s")))
+                cfg->stats          = true;
+            else if ((!::strcmp(arg, "--profile")) || (!::strcmp(arg, "-P")))
+                cfg->profile        = true;
+            else if (arg[0] != '-')
+            {
+                if (cfg->plugin_id != NULL)
+                {
+                    fprintf(stderr, "Plugin identifier has already been specified: %s\n", cfg->plugin_id);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+                cfg->plugin_id      = arg;
+            }
+            else
+            {
+                // All other parameters require value
+                if (i >= argc)
+                {
+                    fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+                const char *value = argv[i++];
+
+                if ((!::strcmp(arg, "--input")) || (!::strcmp(arg, "-i")))
+                {
+                    if (!cfg->in_files.add(value))
+                        return STATUS_NO_MEM;
+                }
+                else if ((!::strcmp(arg, "--output")) || (!::strcmp(arg, "-o")))
+                    cfg->out_file       = value;
+                else if ((!::strcmp(arg, "--config")) || (!::strcmp(arg, "-c")))
+                    cfg->cfg_file       = value;
+                else if ((!::strcmp(arg, "--param")) || (!::strcmp(arg, "-p")))
+                {
+                    if (::strchr(value, '=') == NULL)
+                    {
+                        fprintf(stderr, "Port value should be specified as <id>=<value>: %s\n", value);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    if (!cfg->params.add(value))
+                        return STATUS_NO_MEM;
+                }
+                else if ((!::strcmp(arg, "--block")) || (!::strcmp(arg, "-b")))
+                {
+                    if (!render_parse_size(&cfg->block_size, arg, value))
+                        return STATUS_BAD_ARGUMENTS;
+                }
+                else if ((!::strcmp(arg, "--rate")) || (!::strcmp(arg, "-r")))
+                {
+                    if (!render_parse_size(&cfg->sample_rate, arg, value))
+                        return STATUS_BAD_ARGUMENTS;
+                }
+                else if ((!::strcmp(arg, "--tail")) || (!::strcmp(arg, "-t")))
+                {
+                    if (!render_parse_float(&cfg->tail, arg, value))
+                        return STATUS_BAD_ARGUMENTS;
+                }
+                else if ((!::strcmp(arg, "--duration")) || (!::strcmp(arg, "-d")))
+                {
+                    if (!render_parse_float(&cfg->duration, arg, value))
+                        return STATUS_BAD_ARGUMENTS;
+                }
+                else
+                {
+                    fprintf(stderr, "Unknown parameter: %s\n", arg);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+            }
+        }
+
+        if (cfg->plugin_id == NULL)
+        {
+            fprintf(stderr, "Plugin identifier required to be passed as parameter\n");
+            return STATUS_BAD_ARGUMENTS;
+        }
+        if ((cfg->in_files.size() <= 0) && (cfg->duration <= 0.0f))
+        {
+            fprintf(stderr, "At least one input file or duration of rendering should be specified\n");
+            return STATUS_BAD_ARGUMENTS;
+        }
+
+        return STATUS_OK;
+    }
+
+    status_t render_load_inputs(render_config_t *cfg, cvector<AudioFile> *files)
+    {
+        for (size_t i=0, n=cfg->in_files.size(); i<n; ++i)
+        {
+            const char *path    = cfg->in_files.at(i);
+            AudioFile *af       = new AudioFile();
+            if ((af == NULL) || (!files->add(af)))
+            {
+                delete af;
+                return STATUS_NO_MEM;
+            }
+
+            status_t res        = af->load(path);
+            if (res != STATUS_OK)
+            {
+                fprintf(stderr, "Error loading audio file '%s': %s\n", path, get_status(res));
+                return res;
+            }
+
+            // The sample rate of rendering is defined by the first file if not specified
+            if (cfg->sample_rate <= 0)
+                cfg->sample_rate    = af->sample_rate();
+            if (af->sample_rate() != cfg->sample_rate)
+            {
+                lsp_trace("Resampling file '%s' from %d to %d Hz", path, int(af->sample_rate()), int(cfg->sample_rate));
+                if ((res = af->resample(cfg->sample_rate)) != STATUS_OK)
+                {
+                    fprintf(stderr, "Error resampling audio file '%s': %s\n", path, get_status(res));
+                    return res;
+                }
+            }
+        }
+
+        return STATUS_OK;
+    }
+
+    int render_plugin_main(render_config_t &cfg, plugin_t *plugin)
+    {
+        status_t res;
+        cvector<AudioFile> in_files;
+        AudioFile out_file;
+        RenderWrapper w(plugin);
+
+        float **vin     = NULL;
+        float **vout    = NULL;
+        float **vtmp    = NULL;
+        size_t *vlen    = NULL;
+        const float **vsrc = NULL;
+        const float **vchan= NULL;
+
+        // Load input files
+        if ((res = render_load_inputs(&cfg, &in_files)) != STATUS_OK)
+            goto cleanup;
+        if (cfg.sample_rate <= 0)
+            cfg.sample_rate     = DEFAULT_SAMPLE_RATE;
+
+        // Initialize wrapper and apply settings
+        if ((res = w.init(cfg.sample_rate, cfg.block_size)) != STATUS_OK)
+        {
+            fprintf(stderr, "Error initializing plugin: %s\n", get_status(res));
+            goto cleanup;
+        }
+        if (cfg.cfg_file != NULL)
+        {
+            if ((res = w.load_config(cfg.cfg_file)) != STATUS_OK)
+            {
+                fprintf(stderr, "Error loading configuration file '%s': %s\n", cfg.cfg_file, get_status(res));
+                goto cleanup;
+            }
+        }
+        for (size_t i=0, n=cfg.params.size(); i<n; ++i)
+        {
+            const char *param   = cfg.params.at(i);
+            const char *split   = ::strchr(param, '=');
+            char *id            = ::strndup(param, split - param);
+            if (id == NULL)
+            {
+                res = STATUS_NO_MEM;
+                goto cleanup;
+            }
+            res = w.set_value(id, split + 1, NULL);
+            if (res != STATUS_OK)
+                fprintf(stderr, "Error setting value of port '%s' to '%s': %s\n", id, split + 1, get_status(res));
+            ::free(id);
+            if (res != STATUS_OK)
+                goto cleanup;
+        }
+
+        {
+            size_t n_in         = w.audio_inputs();
+            size_t n_out        = w.audio_outputs();
+
+            // Perform mapping of input channels
+            size_t n_chan       = 0;
+            for (size_t i=0, n=in_files.size(); i<n; ++i)
+                n_chan             += in_files.at(i)->channels();
+
+            vchan               = reinterpret_cast<const float **>(::calloc(n_chan + 1, sizeof(float *)));
+            vlen                = reinterpret_cast<size_t *>(::calloc(n_chan + n_in + 1, sizeof(size_t)));
+            vsrc                = reinterpret_cast<const float **>(::calloc(n_in + 1, sizeof(float *)));
+            vin                 = reinterpret_cast<float **>(::calloc(n_in + 1, sizeof(float *)));
+            vtmp                = reinterpret_cast<float **>(::calloc(n_in + 1, sizeof(float *)));
+            vout                = reinterpret_cast<float **>(::calloc(n_out + 1, sizeof(float *)));
+            if ((vchan == NULL) || (vlen == NULL) || (vsrc == NULL) || (vin == NULL) || (vtmp == NULL) || (vout == NULL))
+            {
+                res     = STATUS_NO_MEM;
+                goto cleanup;
+            }
+
+            size_t in_len       = 0;
+            for (size_t i=0, k=0, n=in_files.size(); i<n; ++i)
+            {
+                AudioFile *af       = in_files.at(i);
+                for (size_t j=0; j<af->channels(); ++j, ++k)
+                {
+                    vchan[k]            = af->channel(j);
+                    vlen[k]             = af->samples();
+                }
+                in_len              = lsp_max(in_len, af->samples());
+            }
+
+            if ((n_chan > 1) && (n_chan != n_in))
+                fprintf(stderr, "Warning: %d input channels are mapped to %d plugin audio inputs\n", int(n_chan), int(n_in));
+            size_t *vinlen      = &vlen[n_chan];
+            for (size_t i=0; i<n_in; ++i)
+            {
+                // The mono input is passed to all plugin inputs
+                size_t k            = (n_chan == 1) ? 0 : i;
+                if (k < n_chan)
+                {
+                    vin[i]              = const_cast<float *>(vchan[k]);
+                    vinlen[i]           = vlen[k];
+                }
+                vtmp[i]             = reinterpret_cast<float *>(::malloc(cfg.block_size * sizeof(float)));
+                if (vtmp[i] == NULL)
+                {
+                    res     = STATUS_NO_MEM;
+                    goto cleanup;
+                }
+            }
+
+            // Bring the plugin into the consistent state before processing
+            dsp::context_t ctx;
+            dsp::start(&ctx);
+            bool settled        = w.settle();
+            dsp::finish(&ctx);
+            if (!settled)
+                fprintf(stderr, "Warning: plugin still has pending offline tasks\n");
+
+            // Compute length of rendering
+            size_t latency      = (cfg.latency_comp) ? w.latency() : 0;
+            size_t out_len      = (in_files.size() > 0) ? in_len : size_t(cfg.duration * cfg.sample_rate);
+            out_len            += size_t(cfg.tail * cfg.sample_rate);
+            size_t total        = out_len + latency;
+
+            // Allocate output data
+            if (cfg.out_file != NULL)
+            {
+                if ((res = out_file.create_samples(n_out, cfg.sample_rate, out_len)) != STATUS_OK)
+                {
+                    fprintf(stderr, "Error allocating output data: %s\n", get_status(res));
+                    goto cleanup;
+                }
+                for (size_t i=0; i<n_out; ++i)
+                {
+                    vout[i]             = reinterpret_cast<float *>(::malloc(cfg.block_size * sizeof(float)));
+                    if (vout[i] == NULL)
+                    {
+                        res     = STATUS_NO_MEM;
+                        goto cleanup;
+                    }
+                }
+            }
+
+            // Enable profiler after settling, so it accounts only the rendering
+            CpuProfiler *prof   = plugin->profiler();
+            if (cfg.profile)
+            {
+                prof->reset();
+                prof->set_enabled(true);
+            }
+
+            // Main rendering loop
+            system::time_t ts, te;
+            system::get_time(&ts);
+            dsp::start(&ctx);
+
+            for (size_t off=0; off < total; )
+            {
+                size_t to_do        = lsp_min(total - off, cfg.block_size);
+
+                // Prepare input buffers, pad them with zeros at the end of file
+                for (size_t i=0; i<n_in; ++i)
+                {
+                    size_t len          = vinlen[i];
+                    if (off + to_do <= len)
+                        vsrc[i]             = &vin[i][off];
+                    else if (off >= len)
+                        vsrc[i]             = NULL;
+                    else
+                    {
+                        dsp::copy(vtmp[i], &vin[i][off], len - off);
+                        dsp::fill_zero(&vtmp[i][len - off], to_do - (len - off));
+                        vsrc[i]             = vtmp[i];
+                    }
+                }
+
+                w.process(vout, vsrc, to_do);
+
+                // Store output data, skip the latency
+                if ((cfg.out_file != NULL) && (off + to_do > latency))
+                {
+                    size_t skip         = (off < latency) ? latency - off : 0;
+                    for (size_t i=0; i<n_out; ++i)
+                        dsp::copy(&out_file.channel(i)[off + skip - latency], &vout[i][skip], to_do - skip);
+                }
+
+                off                += to_do;
+            }
+
+            dsp::finish(&ctx);
+            system::get_time(&te);
+
+            // Output statistics
+            if (cfg.stats)
+            {
+                double time         = (te.seconds - ts.seconds) + (double(te.nanos) - double(ts.nanos)) * 1e-9;
+                double duration     = double(total) / cfg.sample_rate;
+                printf("Plugin:              %s\n", plugin->get_metadata()->lv2_uid);
+                printf("Sample rate:         %d\n", int(cfg.sample_rate));
+                printf("Block size:          %d\n", int(cfg.block_size));
+                printf("Latency:             %d samples\n", int(w.latency()));
+                printf("Processed:           %ld samples (%.3f s)\n", long(total), duration);
+                printf("Processing time:     %.3f s\n", time);
+                if (time > 0.0)
+                {
+                    printf("Throughput:          %.1f samples/s\n", double(total) / time);
+                    printf("Realtime factor:     %.2f\n", duration / time);
+                }
+            }
+
+            // Output profiling data
+            if (cfg.profile)
+            {
+                prof->set_enabled(false);
+                printf("Profiled blocks:     %ld\n", long(prof->blocks()));
+                for (size_t i=0, n=prof->stages(); i<n; ++i)
+                    printf("  %-18s %6.2f%%\n", prof->stage_name(i), prof->stage_share(i) * 100.0f);
+                w.dump_plugin_state();
+            }
+
+            // Store output file
+            if (cfg.out_file != NULL)
+            {
+                if ((res = out_file.store_samples(cfg.out_file, out_len)) != STATUS_OK)
+                    fprintf(stderr, "Error storing audio file '%s': %s\n", cfg.out_file, get_status(res));
+            }
+        }
+
+    cleanup:
+        // Destroy objects
+        w.destroy();
+        out_file.destroy();
+        for (size_t i=0, n=in_files.size(); i<n; ++i)
+        {
+            AudioFile *af = in_files.at(i);
+            if (af != NULL)
+            {
+                af->destroy();
+                delete af;
+            }
+        }
+        in_files.flush();
+
+        for (size_t i=0; (vtmp != NULL) && (vtmp[i] != NULL); ++i)
+            ::free(vtmp[i]);
+        for (size_t i=0; (vout != NULL) && (vout[i] != NULL); ++i)
+            ::free(vout[i]);
+
+        ::free(vchan);
+        ::free(vlen);
+        ::free(vsrc);
+        ::free(vin);
+        ::free(vtmp);
+        ::free(vout);
+
+        return res;
+    }
+
+    static int render_exit_code(status_t res)
+    {
+        // 0 - success, 1 - processing failure, 2 - invalid command line
+        switch (res)
+        {
+            case STATUS_OK:
+            case STATUS_CANCELLED:
+                return 0;
+            case STATUS_BAD_ARGUMENTS:
+            case STATUS_INVALID_UID:
+                return 2;
+            default:
+                break;
+        }
+        return 1;
+    }
+}
+
+int main(int argc, const char **argv)
+{
+    using namespace lsp;
+
+    lsp_debug_init("render");
+
+    // Initialize DSP
+    lsp_trace("Initializing DSP");
+    dsp::init();
+
+    render_config_t cfg;
+    plugin_t  *p    = NULL;
+    status_t res    = STATUS_OK;
+
+    // Parse command-line arguments
+    if ((res = render_parse_config(&cfg, argc, argv)) != STATUS_OK)
+        return render_exit_code(res);
+
+    // Instantiate the plugin
+    #define MOD_PLUGIN(plugin, ui)    \
+        if ((!p) && (!strcmp(plugin::metadata.lv2_uid, cfg.plugin_id))) \
+            p = new plugin();
+
+    #include <metadata/modules.h>
+
+    if (p == NULL)
+    {
+        fprintf(stderr, "Unknown plugin identifier: %s\n", cfg.plugin_id);
+        render_list_plugins();
+        return render_exit_code(STATUS_INVALID_UID);
+    }
+
+    res = render_plugin_main(cfg, p);
+
+    // Destroy objects
+    p->destroy();
+    delete p;
+
+    return render_exit_code(res);
+}
@@ -28,6 +28,12 @@
 #define SAMPLE_QUANTITY     512
 #define TASK_LO_THRESH      0x2000
 #define TASK_HI_THRESH      0x4000
+#define BVH_LEAF_SIZE       16
+#define MERGE_TILE_SIZE     0x1000
+#define PATH_CHUNK_SIZE     0x1000
+#define PATH_CACHE_QUANTUM  0x100000            /* Memory reserved by the thread for the path cache at once */
+#define PATH_CACHE_LIMIT    (size_t(256) << 20) /* Default memory limit of the path cache */
+#define PATH_CACHE_RATIO    1024                /* Maximum ratio between kept path cache and captured data */
 
 namespace lsp
 {
@@ -52,6 +58,10 @@ namespace lsp
     {
         this->trace     = trace;
         heavy_state     = S_SCAN_OBJECTS;
+        mark            = 0;
+        cache           = NULL;
+        cache_used      = 0;
+        cache_reserved  = 0;
     }
 
     RayTrace3D::TaskThread::~TaskThread()
@@ -76,8 +86,13 @@ namespace lsp
             delete b;
         }
 
-        destroy_objects(&objects);
         bindings.flush();
+
+        if (cache != NULL)
+        {
+            destroy_path_cache(cache);
+            cache           = NULL;
+        }
     }
 
     status_t RayTrace3D::TaskThread::run()
@@ -89,7 +104,6 @@ namespace lsp
         // Enter the main loop
         status_t res = main_loop();
         destroy_tasks(&tasks);
-        destroy_objects(&objects);
 
         // Finalize DSP context and return result
         dsp::finish(&ctx);
@@ -409,7 +423,9 @@ namespace lsp
                 int(root.vertex.size()), int(root.edge.size()), int(root.triangle.size()));
 
         // Generate object meshes
-        destroy_objects(&objects);
+        destroy_objects(&trace->vObjects);
+        trace->vBVH.clear();
+        trace->vBVHIndex.clear();
         for (size_t i=0, n=trace->pScene->num_objects(); i<n; ++i, ++obj_id)
         {
             // Get object
@@ -423,10 +439,11 @@ namespace lsp
             rt_object_t *rt = new rt_object_t();
             if (rt == NULL)
                 return STATUS_NO_MEM;
-            else if (!objects.add(rt)) {
+            else if (!trace->vObjects.add(rt)) {
                 delete rt;
                 return STATUS_NO_MEM;
             }
+            rt->bvh     = -1;
 
             // Compute object's bounding box
             obj->calc_bound_box();
@@ -434,6 +451,15 @@ namespace lsp
                 return res;
         }
 
+        // Assign unique index to each edge of the scene, threads use it to mark edges added to the context
+        ssize_t itag = 0;
+        for (size_t i=0, n=trace->vObjects.size(); i<n; ++i)
+        {
+            cstorage<rtx_edge_t> *plan = &trace->vObjects.at(i)->plan;
+            for (size_t j=0, m=plan->size(); j<m; ++j)
+                plan->at(j)->itag   = itag++;
+        }
+
         RT_TRACE(trace->pDebug,
             if (!trace->pScene->validate())
                 return STATUS_CORRUPTED;
@@ -559,6 +585,27 @@ namespace lsp
         for (size_t i=0; i<8; ++i)
             dsp::apply_matrix3d_mp2(&o->bbox.p[i], &bbox->p[i], m);
 
+        // Build bounding volume hierarchy for large objects, it is shared with all threads
+        size_t nt       = o->mesh.size();
+        if ((trace->bBVH) && (nt > BVH_LEAF_SIZE))
+        {
+            size_t first    = trace->vBVHIndex.size();
+            if (trace->vBVHIndex.append_n(nt) == NULL)
+                return STATUS_NO_MEM;
+            rt_bvh_key_t *keys = reinterpret_cast<rt_bvh_key_t *>(::malloc(nt * sizeof(rt_bvh_key_t)));
+            if (keys == NULL)
+                return STATUS_NO_MEM;
+
+            size_t *index   = trace->vBVHIndex.get_array();
+            for (size_t i=0; i<nt; ++i)
+                index[first + i]    = i;
+
+            o->bvh          = build_bvh(&trace->vBVH, index, keys, o->mesh.get_array(), first, nt);
+            ::free(keys);
+            if (o->bvh < 0)
+                return status_t(-o->bvh);
+        }
+
         return STATUS_OK;
     }
 
@@ -642,64 +689,25 @@ namespace lsp
         }
 
         // Iterate all object and add to the context if the object is potentially participating the ray tracing algorithm
-        for (size_t i=0, n=objects.size(); i<n; ++i)
+        for (size_t i=0, n=trace->vObjects.size(); i<n; ++i)
         {
-            rt_object_t *rt = objects.at(i);
+            rt_object_t *rt = trace->vObjects.at(i);
             if (rt == NULL)
                 return STATUS_BAD_STATE;
 
-            // Check bound box
-            bool check = rt->mesh.size() > 16;
-            if (check)
-            {
-                RT_TRACE_BREAK(trace->pDebug,
-                    lsp_trace("Testing bound box");
-
-                    ctx->trace.add_view_1c(&ctx->view, &C3D_MAGENTA);
-                    v_vertex3d_t v[3];
-                    for (size_t j=0, m = sizeof(bbox_map)/sizeof(size_t); j < m; )
-                    {
-                        v[0].p      = rt->bbox.p[bbox_map[j++]];
-                        v[0].c      = C3D_YELLOW;
-                        v[1].p      = rt->bbox.p[bbox_map[j++]];
-                        v[1].c      = C3D_YELLOW;
-                        v[2].p      = rt->bbox.p[bbox_map[j++]];
-                        v[2].c      = C3D_YELLOW;
-
-                        dsp::calc_normal3d_p3(&v[0].n, &v[0].p, &v[1].p, &v[2].p);
-                        v[1].n      = v[0].n;
-                        v[2].n      = v[0].n;
-
-                        ctx->trace.add_triangle(v);
-                    }
-                )
-
-                // Perform simple bounding-box check
-                check = !check_bound_box(&rt->bbox, &ctx->view);
-            }
-            if (check)
+            // Large objects are scanned using bounding volume hierarchy
+            if (rt->bvh >= 0)
             {
-                RT_TRACE(trace->pDebug,
-                    for (size_t j=0,m=rt->mesh.size(); j<m; ++j)
-                    {
-                        rtx_triangle_t *st = rt->mesh.at(j);
-
-                        v_triangle3d_t t;
-                        t.p[0]  = st->v[0];
-                        t.p[1]  = st->v[1];
-                        t.p[2]  = st->v[2];
-                        t.n[0]  = st->n;
-                        t.n[1]  = st->n;
-                        t.n[2]  = st->n;
-
-                        ctx->ignored.add(&t);
-                    }
-                );
+                res = scan_bvh(ctx, rt);
+                if (res == STATUS_OK)
+                    ++n_objs;
+                else if (res != STATUS_SKIP)
+                    return res;
                 continue;
             }
 
             // Add object to context
-            res = ctx->add_object(rt->mesh.get_array(), rt->plan.get_array(), rt->mesh.size(), rt->plan.size());
+            res = ctx->add_object(rt->mesh.get_array(), rt->mesh.size(), marks.get_array(), ++mark);
             if (res != STATUS_OK)
                 return res;
             ++n_objs;
@@ -729,6 +737,87 @@ namespace lsp
         return submit_task(ctx);
     }
 
+    static int bvh_cmp_index(const void *a, const void *b)
+    {
+        size_t ia = *reinterpret_cast<const size_t *>(a);
+        size_t ib = *reinterpret_cast<const size_t *>(b);
+        return (ia < ib) ? -1 : (ia > ib) ? 1 : 0;
+    }
+
+    status_t RayTrace3D::TaskThread::scan_bvh(rt_context_t *ctx, rt_object_t *obj)
+    {
+        status_t res;
+        const rt_bvh_node_t *vn = trace->vBVH.at(obj->bvh);
+        const size_t *vi        = trace->vBVHIndex.get_array();
+        rtx_triangle_t *vt      = obj->mesh.get_array();
+
+        // Walk the hierarchy in depth-first order, skip subtrees that are out of the view
+        visible.clear();
+        for (size_t i=0, n=vn->size; i<n; )
+        {
+            const rt_bvh_node_t *node = &vn[i];
+            ++stats.calls_bvh;
+
+            if (!check_bvh_node(&node->bbox, &ctx->view))
+            {
+                RT_TRACE(trace->pDebug,
+                    for (size_t j=0; j<node->count; ++j)
+                    {
+                        rtx_triangle_t *st = &vt[vi[node->first + j]];
+
+                        v_triangle3d_t t;
+                        t.p[0]  = st->v[0];
+                        t.p[1]  = st->v[1];
+                        t.p[2]  = st->v[2];
+                        t.n[0]  = st->n;
+                        t.n[1]  = st->n;
+                        t.n[2]  = st->n;
+
+                        ctx->ignored.add(&t);
+                    }
+                );
+                i          += node->size;
+                continue;
+            }
+
+            // Collect triangles of the leaf node, descend to children of inner node
+            if (node->size <= 1)
+            {
+                size_t *dst     = visible.append_n(node->count);
+                if (dst == NULL)
+                    return STATUS_NO_MEM;
+                ::memcpy(dst, &vi[node->first], node->count * sizeof(size_t));
+            }
+            ++i;
+        }
+
+        size_t nv               = visible.size();
+        if (nv <= 0)
+            return STATUS_SKIP;
+
+        size_t *vm              = marks.get_array();
+        ++mark;
+
+        // Results of the tracing depend on the order of triangles, so add them
+        // in the same order as they follow in the object's mesh
+        size_t *vv              = visible.get_array();
+        ::qsort(vv, nv, sizeof(size_t), bvh_cmp_index);
+
+        for (size_t i=0; i<nv; )
+        {
+            size_t j    = i + 1;
+            while ((j < nv) && (vv[j] == vv[j-1] + 1))
+                ++j;
+
+            res = ctx->add_object(&vt[vv[i]], j - i, vm, mark);
+            if (res != STATUS_OK)
+                return res;
+            i           = j;
+        }
+
+        return STATUS_OK;
+    }
+
     status_t RayTrace3D::TaskThread::cull_view(rt_context_t *ctx)
     {
         status_t res = ctx->cull_view();
@@ -773,6 +862,7 @@ namespace lsp
                 rt_context_t *nctx = new rt_context_t(&ctx->view, (out.triangle.size() > 1) ? S_SPLIT : S_REFLECT);
                 if (nctx == NULL)
                     return STATUS_NO_MEM;
+                nctx->path      = ctx->path;
 
                 RT_TRACE(trace->pDebug,
                     nctx->set_debug_context(trace->pDebug);
@@ -970,13 +1060,34 @@ namespace lsp
                 rt_binding_t *b = bindings.get(ct->oid);
                 if (b != NULL)
                 {
+                    // Prepare the record of captured view
+                    rt_hit_t hit, *phit = NULL;
+                    if (cache != NULL)
+                    {
+                        hit.path        = ctx->path;
+                        hit.capture     = ct->oid;
+                        hit.rnum        = v.rnum;
+                        hit.first       = 0;
+                        hit.count       = 0;
+                        hit.offset      = cache->kernel.size();
+                        phit            = &hit;
+                    }
+
                     // Perform synchronized capturing
                     ++stats.calls_capture;
                     #ifdef LSP_RT_TRACE
-                        res = capture(cap, &b->bindings, &v, &ctx->trace);
+                        res = capture(cap, &b->bindings, &v, phit, &ctx->trace);
                     #else
-                        res = capture(cap, &b->bindings, &v);
+                        res = capture(cap, &b->bindings, &v, phit);
                     #endif /* LSP_RT_TRACE */
+
+                    // The cache could be dropped by capture() because of the memory limit
+                    if ((res == STATUS_OK) && (phit != NULL) && (hit.count > 0) &&
+                        (reserve_cache(sizeof(rt_hit_t))))
+                    {
+                        if (!cache->hits.add(&hit))
+                            res = STATUS_NO_MEM;
+                    }
                 }
                 else
                     res = STATUS_CORRUPTED;
@@ -985,6 +1096,7 @@ namespace lsp
             {
                 // Get material
                 rt_material_t *m    = ct->m;
+                size_t side         = (distance > 0.0f) ? 0 : RT_PF_INSIDE;
 
                 // Compute reflected and refracted views
                 rv          = v;
@@ -1078,7 +1190,11 @@ namespace lsp
                             rc->set_debug_context(trace->pDebug);
                         );
 
-                        if ((res = submit_task(rc)) != STATUS_OK)
+                        // add_path() drops the cache when it exceeds the memory limit
+                        if (cache != NULL)
+                            rc->path    = add_path(ctx->path, ct, side);
+                        res = ((cache != NULL) && (rc->path == NULL)) ? STATUS_NO_MEM : submit_task(rc);
+                        if (res != STATUS_OK)
                             delete rc;
                     }
                     else
@@ -1094,7 +1210,10 @@ namespace lsp
                             rc->set_debug_context(trace->pDebug);
                         );
 
-                        if ((res = submit_task(rc)) != STATUS_OK)
+                        if (cache != NULL)
+                            rc->path    = add_path(ctx->path, ct, side | RT_PF_REFRACT);
+                        res = ((cache != NULL) && (rc->path == NULL)) ? STATUS_NO_MEM : submit_task(rc);
+                        if (res != STATUS_OK)
                             delete rc;
                     }
                     else
@@ -1114,9 +1233,9 @@ namespace lsp
     }
 
 #ifdef LSP_RT_TRACE
-    status_t RayTrace3D::TaskThread::capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, View3D *view)
+    status_t RayTrace3D::TaskThread::capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, rt_hit_t *hit, View3D *view)
 #else
-    status_t RayTrace3D::TaskThread::capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v)
+    status_t RayTrace3D::TaskThread::capture(capture_t *capture, cstorage<sample_t> *bindings, const rt_view_t *v, rt_hit_t *hit)
 #endif /* LSP_RT_TRACE */
     {
 //        lsp_trace("Capture:\n"
@@ -1253,61 +1372,29 @@ namespace lsp
                 // Deploy energy value to the sample
                 if (csn > 0)
                 {
-                    // Lock capture data
-//                    trace->lkCapture.lock();
+                    status_t res = deposit(bindings, v->rnum, csn - 1, amplitude);
+                    if (res != STATUS_OK)
+                        return res;
 
-                    // Append sample to each matching capture
-                    for (size_t ci=0, cn=bindings->size(); ci<cn; ++ci)
+                    // Store the data for re-computing of captured samples
+                    if (hit != NULL)
                     {
-                        sample_t *s = bindings->at(ci);
-
-                        // Skip reflection not in range
-                        if ((s->r_min >= 0) && (v->rnum < s->r_min))
-                            continue;
-                        else if ((s->r_max >= 0) && (v->rnum > s->r_max))
-                            continue;
-
-                        // Ensure that we need to resize sample
-                        size_t len = s->sample->length();
-                        if (len <= size_t(csn))
+                        if (hit->count <= 0)
+                            hit->first      = csn - 1;
+                        size_t n        = csn - hit->first - hit->count;
+                        float *dst      = (reserve_cache(n * sizeof(float))) ? cache->kernel.append_n(n) : NULL;
+                        if (cache == NULL) // The cache has been dropped because of the memory limit
+                            hit             = NULL;
+                        else if (dst == NULL)
+                            return STATUS_NO_MEM;
+                        else
                         {
-                            // Need to resize sample?
-                            if (s->sample->max_length() <= size_t(csn))
-                            {
-                                len     = (csn + 1 + SAMPLE_QUANTITY) / SAMPLE_QUANTITY;
-                                len    *= SAMPLE_QUANTITY;
-
-                                lsp_trace("v->time = {%e, %e, %e}", v->time[0], v->time[1], v->time[2]);
-                                lsp_trace("ctime = %e, tsn = {%e, %e, %e}", ctime, tsn[0], tsn[1], tsn[2]);
-                                lsp_trace("spl = {%e, %e, %e, %e}",
-                                    spl.dx, spl.dy, spl.dz, spl.dw);
-                                lsp_trace("Requesting sample resize: csn=0x%llx, len=0x%llx, channels=%d",
-                                    (long long)csn, (long long)len, int(s->sample->channels())
-                                    );
-                                #ifdef LSP_TRACE
-                                    if (len > 0x100000) // TODO: This is currently impossible, added for debugging, remove in future
-                                        invalid_state_hook();
-                                #endif
-                                if (!s->sample->resize(s->sample->channels(), len, len))
-                                {
-                                    #ifdef LSP_TRACE
-                                        invalid_state_hook();
-                                    #endif
-                                    return STATUS_NO_MEM;
-                                }
-                            }
-
-                            // Update sample length
-                            s->sample->setLength(csn + 1);
+                            for (size_t i=1; i<n; ++i)
+                                *(dst++)        = 0.0f;
+                            *dst            = amplitude;
+                            hit->count     += n;
                         }
-
-                        // Deploy sample to curent channel
-                        float *buf  = s->sample->getBuffer(s->channel);
-                        buf[csn-1] += amplitude;
                     }
-
-                    // Unlock capture data
-//                    trace->lkCapture.unlock();
                 }
             }
 
@@ -1347,6 +1434,10 @@ namespace lsp
         res         = generate_root_mesh();
         if (res == STATUS_OK)
             res         = prepare_captures();
+        if (res == STATUS_OK)
+            res         = prepare_marks();
+        if (res == STATUS_OK)
+            res         = prepare_cache();
 
         if (res != STATUS_OK)
             return res;
@@ -1477,7 +1568,7 @@ namespace lsp
         return STATUS_OK;
     }
 
-    status_t RayTrace3D::TaskThread::prepare_supplementary_loop(TaskThread *t)
+    status_t RayTrace3D::TaskThread::prepare_supplementary_loop()
     {
         // Cleanup statistics
         clear_stats(&stats);
@@ -1485,127 +1576,92 @@ namespace lsp
         // Prepare captures and data context
         status_t res = prepare_captures();
         if (res == STATUS_OK)
-            res = copy_objects(&t->objects);
+            res = prepare_marks();
+        if (res == STATUS_OK)
+            res = prepare_cache();
 
         return res;
     }
 
-    status_t RayTrace3D::TaskThread::copy_objects(cvector<rt_object_t> *src)
+    status_t RayTrace3D::TaskThread::prepare_cache()
     {
-        rtx_edge_t *se, *de;
-        rtx_triangle_t *dt;
+        if (!trace->bPathCache)
+            return STATUS_OK;
 
-        for (size_t i=0, n=src->size(); i<n; ++i)
-        {
-            // Get source object
-            rt_object_t *s = src->at(i);
-            if (s == NULL)
-                return STATUS_CORRUPTED;
+        cache           = new rt_path_cache_t;
+        if (cache == NULL)
+            return STATUS_NO_MEM;
+        cache->left     = 0;
+        cache_used      = 0;
+        cache_reserved  = 0;
 
-            // Create destination object
-            rt_object_t *d = new rt_object_t;
-            if (d == NULL)
-                return STATUS_NO_MEM;
-            else if (!objects.add(d))
-            {
-                delete d;
-                return STATUS_NO_MEM;
-            }
+        return STATUS_OK;
+    }
 
-            // Copy edges and triangles
-            if (!d->plan.add_all(&s->plan))
-                return STATUS_NO_MEM;
-            if (!d->mesh.add_all(&s->mesh))
-                return STATUS_NO_MEM;
+    bool RayTrace3D::TaskThread::reserve_cache(size_t bytes)
+    {
+        if (cache == NULL)
+            return false;
 
-            // Patch pointers
-            se = s->plan.get_array();
-            de = d->plan.get_array();
-            dt = d->mesh.get_array();
-            for (size_t j=0, m=d->mesh.size(); j<m; ++j, ++dt)
-            {
-                dt->e[0] = &de[dt->e[0] - se];
-                dt->e[1] = &de[dt->e[1] - se];
-                dt->e[2] = &de[dt->e[2] - se];
-            }
+        // Reserve memory from the overall limit by quantums to reduce locking
+        cache_used     += bytes;
+        if (cache_used <= cache_reserved)
+            return true;
 
-            // Copy bound box
-            d->bbox     = s->bbox;
+        size_t reserve  = ALIGN_SIZE(cache_used - cache_reserved, PATH_CACHE_QUANTUM);
+        if (trace->reserve_path_cache(reserve))
+        {
+            cache_reserved += reserve;
+            return true;
         }
 
-        return STATUS_OK;
+        // The limit has been exceeded, stop tracking of paths in this thread
+        destroy_path_cache(cache);
+        cache           = NULL;
+        return false;
     }
 
-    status_t RayTrace3D::TaskThread::merge_result()
+    const rt_path_t *RayTrace3D::TaskThread::add_path(const rt_path_t *parent, const rt_triangle_t *t, size_t flags)
     {
-        cvector<capture_t> &dst = trace->vCaptures;
-        if (dst.size() != bindings.size())
-            return STATUS_CORRUPTED;
-
-        for (size_t i=0; i<dst.size(); ++i)
+        // Allocate new chunk if there are no free items
+        if (cache->left <= 0)
         {
-            rt_binding_t   *csrc    = bindings.at(i);
-            capture_t      *cdst    = dst.at(i);
-
-            if (csrc->bindings.size() != cdst->bindings.size())
-                return STATUS_CORRUPTED;
+            if (!reserve_cache(sizeof(rt_path_t) * PATH_CHUNK_SIZE))
+                return NULL;
 
-            for (size_t j=0; j<csrc->bindings.size(); ++j)
+            rt_path_t *chunk    = reinterpret_cast<rt_path_t *>(::malloc(sizeof(rt_path_t) * PATH_CHUNK_SIZE));
+            if (chunk == NULL)
+                return NULL;
+            else if (!cache->chunks.add(chunk))
             {
-                sample_t *ssrc  = csrc->bindings.at(j);
-                sample_t *sdst  = cdst->bindings.at(j);
-
-                if ((ssrc->sample == NULL) || (sdst->sample == NULL))
-                    return STATUS_CORRUPTED;
-
-                // Compute new sample size
-                size_t nc = ssrc->sample->channels();
-                if (nc != sdst->sample->channels())
-                    return STATUS_CORRUPTED;
-
-                bool resize = false;
-                size_t maxlen = sdst->sample->max_length();
-                if (maxlen < ssrc->sample->max_length())
-                {
-                    maxlen  = ssrc->sample->max_length();
-                    resize  = true;
-                }
-
-                size_t len = sdst->sample->length();
-                if (len < ssrc->sample->length())
-                {
-                    len     = ssrc->sample->length();
-                    resize  = true;
-                }
+                ::free(chunk);
+                return NULL;
+            }
+            cache->left         = PATH_CHUNK_SIZE;
+        }
 
-                if (maxlen < len)
-                    maxlen  = len;
+        rt_path_t *p    = &cache->chunks.last()[PATH_CHUNK_SIZE - (cache->left--)];
+        p->parent       = parent;
+        p->material     = uint32_t(t->m - trace->vMaterials.get_array());
+        p->flags        = flags;
 
-                // Check that we need resize
-                if (resize)
-                {
-                    if (!sdst->sample->resize(nc, maxlen, len))
-                        return STATUS_NO_MEM;
-                }
+        return p;
+    }
 
-                // Apply changes to the target sample
-                for (size_t k=0; k<nc; ++k)
-                {
-//                    lsp_trace("Merge %p (%lld samples) -> %p (%lld samples), channel=%d/%d",
-//                            ssrc->sample->getBuffer(k),
-//                            (long long)(ssrc->sample->length()),
-//                            sdst->sample->getBuffer(k),
-//                            (long long)(sdst->sample->length()),
-//                            int(k), int(nc)
-//                            );
-                    dsp::add2(
-                            sdst->sample->getBuffer(k),
-                            ssrc->sample->getBuffer(k),
-                            ssrc->sample->length()
-                        );
-                }
-            }
-        }
+    status_t RayTrace3D::TaskThread::prepare_marks()
+    {
+        // Objects are shared between threads, so each thread keeps own marks of edges
+        size_t n = 0;
+        for (size_t i=0, m=trace->vObjects.size(); i<m; ++i)
+            n      += trace->vObjects.at(i)->plan.size();
+
+        marks.clear();
+        size_t *vm  = marks.append_n(lsp_max(n, size_t(1)));
+        if (vm == NULL)
+            return STATUS_NO_MEM;
+        for (size_t i=0; i<n; ++i)
+            vm[i]       = 0;
+        mark        = 0;
 
         return STATUS_OK;
     }
@@ -1622,6 +1678,11 @@ namespace lsp
         fDetalization   = 1e-10f;
         bNormalize      = true;
         bCancelled      = false;
+        bBVH            = true;
+        bPathCache      = false;
+        nPathLimit      = PATH_CACHE_LIMIT;
+        nPathUsed       = 0;
+        bPathOverflow   = false;
         nQueueSize      = 0;
         nProgressPoints = 0;
         nProgressMax    = 0;
@@ -1637,6 +1698,7 @@ namespace lsp
         stats->root_tasks       = 0;
         stats->local_tasks      = 0;
         stats->calls_scan       = 0;
+        stats->calls_bvh        = 0;
         stats->calls_cull       = 0;
         stats->calls_split      = 0;
         stats->calls_cullback   = 0;
@@ -1650,6 +1712,7 @@ namespace lsp
                 "  root tasks processed     : %lld\n"
                 "  local tasks processed    : %lld\n"
                 "  scan_objects             : %lld\n"
+                "  bvh nodes tested         : %lld\n"
                 "  cull_view                : %lld\n"
                 "  split_view               : %lld\n"
                 "  cullback_view            : %lld\n"
@@ -1659,6 +1722,7 @@ namespace lsp
             (long long)stats->root_tasks,
             (long long)stats->local_tasks,
             (long long)stats->calls_scan,
+            (long long)stats->calls_bvh,
             (long long)stats->calls_cull,
             (long long)stats->calls_split,
             (long long)stats->calls_cullback,
@@ -1672,6 +1736,7 @@ namespace lsp
         dst->root_tasks        += src->root_tasks;
         dst->local_tasks       += src->local_tasks;
         dst->calls_scan        += src->calls_scan;
+        dst->calls_bvh         += src->calls_bvh;
         dst->calls_cull        += src->calls_cull;
         dst->calls_split       += src->calls_split;
         dst->calls_cullback    += src->calls_cullback;
@@ -1766,6 +1831,8 @@ namespace lsp
     void RayTrace3D::destroy(bool recursive)
     {
         destroy_tasks(&vTasks);
+        destroy_objects(&vObjects);
+        clear_path_cache();
         clear_progress_callback();
         remove_scene(recursive);
 
@@ -1782,6 +1849,8 @@ namespace lsp
 
         vMaterials.flush();
         vSources.flush();
+        vBVH.flush();
+        vBVHIndex.flush();
         vCaptures.flush();
     }
 
@@ -1901,12 +1970,379 @@ namespace lsp
         return pProgress(progress, pProgressData);
     }
 
+    status_t RayTrace3D::deposit(cstorage<sample_t> *bindings, ssize_t rnum, size_t index, float amplitude)
+    {
+        // Append sample to each matching capture
+        for (size_t ci=0, cn=bindings->size(); ci<cn; ++ci)
+        {
+            sample_t *s = bindings->at(ci);
+
+            // Skip reflection not in range
+            if ((s->r_min >= 0) && (rnum < s->r_min))
+                continue;
+            else if ((s->r_max >= 0) && (rnum > s->r_max))
+                continue;
+
+            // Ensure that we need to resize sample
+            size_t len = s->sample->length();
+            if (len <= (index + 1))
+            {
+                // Need to resize sample?
+                if (s->sample->max_length() <= (index + 1))
+                {
+                    len     = (index + 2 + SAMPLE_QUANTITY) / SAMPLE_QUANTITY;
+                    len    *= SAMPLE_QUANTITY;
+
+                    lsp_trace("Requesting sample resize: index=0x%llx, len=0x%llx, channels=%d",
+                        (long long)index, (long long)len, int(s->sample->channels())
+                        );
+                    #ifdef LSP_TRACE
+                        if (len > 0x100000) // TODO: This is currently impossible, added for debugging, remove in future
+                            invalid_state_hook();
+                    #endif
+                    if (!s->sample->resize(s->sample->channels(), len, len))
+                    {
+                        #ifdef LSP_TRACE
+                            invalid_state_hook();
+                        #endif
+                        return STATUS_NO_MEM;
+                    }
+                }
+
+                // Update sample length
+                s->sample->setLength(index + 2);
+            }
+
+            // Deploy sample to curent channel
+            float *buf  = s->sample->getBuffer(s->channel);
+            buf[index] += amplitude;
+        }
+
+        return STATUS_OK;
+    }
+
+    float RayTrace3D::path_factor(const rt_material_t *m, size_t flags)
+    {
+        size_t side = (flags & RT_PF_INSIDE) ? 1 : 0;
+        float k     = 1.0f - m->absorption[side];
+        return (flags & RT_PF_REFRACT) ? k * m->transparency[side] : k * (m->transparency[side] - 1.0f);
+    }
+
+    bool RayTrace3D::reserve_path_cache(size_t bytes)
+    {
+        if (!lkTasks.lock())
+            return false;
+
+        bool res        = (!bPathOverflow) && (nPathUsed + bytes <= nPathLimit);
+        if (res)
+            nPathUsed      += bytes;
+        else
+            bPathOverflow   = true;
+
+        lkTasks.unlock();
+        return res;
+    }
+
+    void RayTrace3D::destroy_path_cache(rt_path_cache_t *cache)
+    {
+        for (size_t i=0, n=cache->chunks.size(); i<n; ++i)
+            ::free(cache->chunks.at(i));
+
+        cache->hits.flush();
+        cache->kernel.flush();
+        cache->chunks.flush();
+        delete cache;
+    }
+
+    size_t RayTrace3D::path_cache_size(const rt_path_cache_t *cache)
+    {
+        return cache->hits.size() * sizeof(rt_hit_t) +
+               cache->kernel.size() * sizeof(float) +
+               cache->chunks.size() * sizeof(rt_path_t) * PATH_CHUNK_SIZE;
+    }
+
+    size_t RayTrace3D::captured_size() const
+    {
+        size_t bytes    = 0;
+        for (size_t i=0, n=vCaptures.size(); i<n; ++i)
+        {
+            const capture_t *cap    = vCaptures.at(i);
+            const sample_t *s       = cap->bindings.get_array();
+            for (size_t j=0, m=cap->bindings.size(); j<m; ++j)
+                bytes          += s[j].sample->length() * sizeof(float);
+        }
+        return bytes;
+    }
+
+    void RayTrace3D::clear_path_cache()
+    {
+        for (size_t i=0, n=vPathCache.size(); i<n; ++i)
+        {
+            rt_path_cache_t *cache = vPathCache.at(i);
+            if (cache != NULL)
+                destroy_path_cache(cache);
+        }
+
+        vPathCache.flush();
+        vPathMaterials.flush();
+    }
+
+    bool RayTrace3D::can_reweight() const
+    {
+        if ((vPathCache.size() <= 0) || (vPathMaterials.size() != vMaterials.size()))
+            return false;
+
+        static const size_t flags[] = { 0, RT_PF_REFRACT, RT_PF_INSIDE, RT_PF_INSIDE | RT_PF_REFRACT };
+        const rt_material_t *om = vPathMaterials.get_array();
+        const rt_material_t *nm = vMaterials.get_array();
+
+        for (size_t i=0, n=vMaterials.size(); i<n; ++i)
+        {
+            for (size_t j=0; j<sizeof(flags)/sizeof(size_t); ++j)
+            {
+                // Louder interaction could produce views that have been dropped by the energy threshold
+                if (fabs(path_factor(&nm[i], flags[j])) > fabs(path_factor(&om[i], flags[j])))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    status_t RayTrace3D::reweight()
+    {
+        if (!can_reweight())
+            return STATUS_BAD_STATE;
+
+        dsp::context_t ctx;
+        dsp::start(&ctx);
+
+        // Cleanup bound samples
+        for (size_t i=0; i<vCaptures.size(); ++i)
+        {
+            capture_t *cap = vCaptures.at(i);
+            for (size_t j=0; j<cap->bindings.size(); ++j)
+            {
+                sample_t *s = cap->bindings.at(j);
+                dsp::fill_zero(s->sample->getBuffer(s->channel), s->sample->max_length());
+                s->sample->setLength(0);
+            }
+        }
+
+        // Re-compute the amplitude of each captured view and deploy it's data to samples
+        status_t res            = STATUS_OK;
+        const rt_material_t *om = vPathMaterials.get_array();
+        const rt_material_t *nm = vMaterials.get_array();
+
+        for (size_t i=0, n=vPathCache.size(); (i<n) && (res == STATUS_OK); ++i)
+        {
+            rt_path_cache_t *cache  = vPathCache.at(i);
+            for (size_t j=0, m=cache->hits.size(); j<m; ++j)
+            {
+                const rt_hit_t *hit     = cache->hits.at(j);
+                capture_t *cap          = vCaptures.get(hit->capture);
+                if (cap == NULL)
+                {
+                    res     = STATUS_CORRUPTED;
+                    break;
+                }
+
+                // Compute the ratio between new and old amplitude of the view
+                double k    = 1.0;
+                for (const rt_path_t *p = hit->path; p != NULL; p = p->parent)
+                {
+                    float of    = path_factor(&om[p->material], p->flags);
+                    if (of == 0.0f)
+                    {
+                        k           = 0.0;
+                        break;
+                    }
+                    k          *= path_factor(&nm[p->material], p->flags) / of;
+                }
+                if (k == 0.0)
+                    continue;
+
+                const float *kv         = cache->kernel.at(hit->offset);
+                for (size_t l=0; l<hit->count; ++l)
+                {
+                    if (kv[l] == 0.0f)
+                        continue;
+                    if ((res = deposit(&cap->bindings, hit->rnum, hit->first + l, kv[l] * k)) != STATUS_OK)
+                        break;
+                }
+                if (res != STATUS_OK)
+                    break;
+            }
+        }
+
+        // Normalize output
+        if ((res == STATUS_OK) && (bNormalize))
+            normalize_output();
+
+        dsp::finish(&ctx);
+        return res;
+    }
+
+    status_t RayTrace3D::merge_tiles(void *arg)
+    {
+        rt_merge_t *m           = static_cast<rt_merge_t *>(arg);
+        cvector<capture_t> &dst = m->trace->vCaptures;
+        cvector<TaskThread> *vt = m->threads;
+
+        dsp::context_t ctx;
+        dsp::start(&ctx);
+
+        // Each tile of the destination sample is processed by one thread only
+        size_t tile = 0;
+        for (size_t i=0; i<dst.size(); ++i)
+        {
+            capture_t *cdst     = dst.at(i);
+            for (size_t j=0; j<cdst->bindings.size(); ++j)
+            {
+                Sample *sdst        = cdst->bindings.at(j)->sample;
+                for (size_t k=0, nc=sdst->channels(); k<nc; ++k)
+                {
+                    float *dbuf         = sdst->getBuffer(k);
+                    for (size_t off=0, len=sdst->length(); off<len; off += MERGE_TILE_SIZE, ++tile)
+                    {
+                        if ((tile % m->step) != m->index)
+                            continue;
+
+                        // Sum data of all threads in the same order to keep the result stable
+                        for (size_t t=0, nt=vt->size(); t<nt; ++t)
+                        {
+                            Sample *ssrc        = vt->at(t)->get_bindings()->at(i)->bindings.at(j)->sample;
+                            size_t slen         = ssrc->length();
+                            if (off < slen)
+                                dsp::add2(&dbuf[off], ssrc->getBuffer(k, off), lsp_min(slen - off, size_t(MERGE_TILE_SIZE)));
+                        }
+                    }
+                }
+            }
+        }
+
+        dsp::finish(&ctx);
+        return STATUS_OK;
+    }
+
+    status_t RayTrace3D::merge_results(cvector<TaskThread> *threads, size_t workers)
+    {
+        cvector<capture_t> &dst = vCaptures;
+
+        // Validate bindings and resize destination samples to fit data of all threads
+        for (size_t i=0; i<dst.size(); ++i)
+        {
+            capture_t *cdst     = dst.at(i);
+
+            for (size_t j=0; j<cdst->bindings.size(); ++j)
+            {
+                sample_t *sdst      = cdst->bindings.at(j);
+                if (sdst->sample == NULL)
+                    return STATUS_CORRUPTED;
+
+                size_t nc           = sdst->sample->channels();
+                size_t maxlen       = sdst->sample->max_length();
+                size_t len          = sdst->sample->length();
+                bool resize         = false;
+
+                for (size_t t=0, nt=threads->size(); t<nt; ++t)
+                {
+                    cvector<rt_binding_t> *src = threads->at(t)->get_bindings();
+                    if (src->size() != dst.size())
+                        return STATUS_CORRUPTED;
+                    rt_binding_t *csrc  = src->at(i);
+                    if (csrc->bindings.size() != cdst->bindings.size())
+                        return STATUS_CORRUPTED;
+
+                    sample_t *ssrc      = csrc->bindings.at(j);
+                    if (ssrc->sample == NULL)
+                        return STATUS_CORRUPTED;
+                    else if (ssrc->sample->channels() != nc)
+                        return STATUS_CORRUPTED;
+
+                    if (maxlen < ssrc->sample->max_length())
+                    {
+                        maxlen      = ssrc->sample->max_length();
+                        resize      = true;
+                    }
+                    if (len < ssrc->sample->length())
+                    {
+                        len         = ssrc->sample->length();
+                        resize      = true;
+                    }
+                }
+
+                if (maxlen < len)
+                    maxlen      = len;
+
+                if ((resize) && (!sdst->sample->resize(nc, maxlen, len)))
+                    return STATUS_NO_MEM;
+            }
+        }
+
+        // Sum tiles of captured data in parallel
+        rt_merge_t *vm          = new rt_merge_t[workers];
+        if (vm == NULL)
+            return STATUS_NO_MEM;
+        ipc::Thread **vt        = new ipc::Thread *[workers];
+        if (vt == NULL)
+        {
+            delete [] vm;
+            return STATUS_NO_MEM;
+        }
+
+        for (size_t i=0; i<workers; ++i)
+        {
+            vm[i].trace         = this;
+            vm[i].threads       = threads;
+            vm[i].index         = i;
+            vm[i].step          = workers;
+            vt[i]               = NULL;
+
+            if (i <= 0)
+                continue;
+
+            // Launch thread, process the tiles in the current thread on failure
+            vt[i]               = new ipc::Thread(merge_tiles, &vm[i]);
+            if ((vt[i] != NULL) && (vt[i]->start() != STATUS_OK))
+            {
+                delete vt[i];
+                vt[i]               = NULL;
+            }
+            if (vt[i] == NULL)
+                merge_tiles(&vm[i]);
+        }
+
+        status_t res            = merge_tiles(&vm[0]);
+        for (size_t i=1; i<workers; ++i)
+        {
+            if (vt[i] == NULL)
+                continue;
+            vt[i]->join();
+            if (res == STATUS_OK)
+                res                 = vt[i]->get_result();
+            delete vt[i];
+        }
+
+        delete [] vt;
+        delete [] vm;
+
+        return res;
+    }
+
     status_t RayTrace3D::do_process(size_t threads, float initial)
     {
         status_t res = STATUS_OK;
         bCancelled   = false;
         bFailed      = false;
 
+        // Remember materials used for tracking of view paths
+        clear_path_cache();
+        nPathUsed       = 0;
+        bPathOverflow   = false;
+        if ((bPathCache) && (!vPathMaterials.add_all(&vMaterials)))
+            return STATUS_NO_MEM;
+
         // Get time of execution start
 #ifdef LSP_TRACE
         struct timespec tstart;
@@ -1923,6 +2359,7 @@ namespace lsp
         if (res != STATUS_OK)
         {
             delete root;
+            destroy_objects(&vObjects);
             return res;
         }
 
@@ -1943,7 +2380,7 @@ namespace lsp
                 }
 
                 // Sync thread data
-                res = t->prepare_supplementary_loop(root);
+                res = t->prepare_supplementary_loop();
                 if (res != STATUS_OK)
                     break;
 
@@ -1970,20 +2407,63 @@ namespace lsp
                 res     = t->get_result(); // Update execution status
         }
 
+        // Merge captured data of all threads
+        cvector<TaskThread> all;
+        if ((all.add(root)) && (all.add_all(&workers)))
+        {
+            status_t xres = merge_results(&all, all.size());
+            if (res == STATUS_OK)
+                res     = xres;
+        }
+        else if (res == STATUS_OK)
+            res     = STATUS_NO_MEM;
+
+        // Take captured views of all threads
+        for (size_t i=0, n=all.size(); i<n; ++i)
+        {
+            rt_path_cache_t *cache = all.at(i)->release_cache();
+            if ((cache != NULL) && (!vPathCache.add(cache)))
+            {
+                destroy_path_cache(cache);
+                res     = STATUS_NO_MEM;
+            }
+        }
+        if ((res != STATUS_OK) || (bPathOverflow))
+        {
+            if (bPathOverflow)
+                lsp_trace("Path cache exceeded the limit of %ld bytes, views are not kept", long(nPathLimit));
+            clear_path_cache();
+        }
+        else if (vPathCache.size() > 0)
+        {
+            // Do not keep the path cache that is much larger than the captured data
+            size_t used     = 0;
+            for (size_t i=0, n=vPathCache.size(); i<n; ++i)
+                used           += path_cache_size(vPathCache.at(i));
+
+            size_t limit    = captured_size() * PATH_CACHE_RATIO;
+            if (used > limit)
+            {
+                lsp_trace("Path cache of %ld bytes exceeded the limit of %ld bytes for captured data, views are not kept",
+                        long(used), long(limit));
+                clear_path_cache();
+            }
+        }
+
+        all.flush();
+        destroy_objects(&vObjects);
+
         // Get root thread statistics
         stats_t overall;
         clear_stats(&overall);
         merge_stats(&overall, root->get_stats());
-        root->merge_result();
         if (res != STATUS_BREAK_POINT)
             dump_stats("Main thread statistics", root->get_stats());
 
         // Output thread stats and destroy threads
         for (size_t i=0,n=workers.size(); i<n; ++i)
         {
-            // Post-process each thread
             TaskThread *t = workers.get(i);
-            t->merge_result();
 
             // Merge and output statistics
             LSPString s;
@@ -2104,6 +2584,134 @@ namespace lsp
         }
     }
 
+    int RayTrace3D::bvh_cmp_key(const void *a, const void *b)
+    {
+        const rt_bvh_key_t *ka = reinterpret_cast<const rt_bvh_key_t *>(a);
+        const rt_bvh_key_t *kb = reinterpret_cast<const rt_bvh_key_t *>(b);
+        if (ka->key < kb->key)
+            return -1;
+        else if (ka->key > kb->key)
+            return 1;
+        return (ka->index < kb->index) ? -1 : (ka->index > kb->index) ? 1 : 0;
+    }
+
+    ssize_t RayTrace3D::build_bvh(cstorage<rt_bvh_node_t> *bvh, size_t *index, rt_bvh_key_t *keys,
+            const rtx_triangle_t *mesh, size_t first, size_t count)
+    {
+        // Compute bounds of triangles and bounds of their centers
+        point3d_t min, max, cmin, cmax;
+        const size_t *vi    = &index[first];
+        const rtx_triangle_t *t = &mesh[vi[0]];
+        min         = t->v[0];
+        max         = t->v[0];
+        dsp::init_point_xyz(&cmin, t->v[0].x + t->v[1].x + t->v[2].x, t->v[0].y + t->v[1].y + t->v[2].y, t->v[0].z + t->v[1].z + t->v[2].z);
+        cmax        = cmin;
+
+        for (size_t i=0; i<count; ++i)
+        {
+            t           = &mesh[vi[i]];
+            for (size_t j=0; j<3; ++j)
+            {
+                const point3d_t *p = &t->v[j];
+                min.x       = lsp_min(min.x, p->x);
+                min.y       = lsp_min(min.y, p->y);
+                min.z       = lsp_min(min.z, p->z);
+                max.x       = lsp_max(max.x, p->x);
+                max.y       = lsp_max(max.y, p->y);
+                max.z       = lsp_max(max.z, p->z);
+            }
+
+            float cx    = t->v[0].x + t->v[1].x + t->v[2].x;
+            float cy    = t->v[0].y + t->v[1].y + t->v[2].y;
+            float cz    = t->v[0].z + t->v[1].z + t->v[2].z;
+            cmin.x      = lsp_min(cmin.x, cx);
+            cmin.y      = lsp_min(cmin.y, cy);
+            cmin.z      = lsp_min(cmin.z, cz);
+            cmax.x      = lsp_max(cmax.x, cx);
+            cmax.y      = lsp_max(cmax.y, cy);
+            cmax.z      = lsp_max(cmax.z, cz);
+        }
+
+        // Allocate node
+        ssize_t id          = bvh->size();
+        rt_bvh_node_t *node = bvh->add();
+        if (node == NULL)
+            return -STATUS_NO_MEM;
+
+        bound_box3d_t *b    = &node->bbox;
+        dsp::init_point_xyz(&b->p[0], min.x, max.y, max.z);
+        dsp::init_point_xyz(&b->p[1], min.x, min.y, max.z);
+        dsp::init_point_xyz(&b->p[2], max.x, min.y, max.z);
+        dsp::init_point_xyz(&b->p[3], max.x, max.y, max.z);
+        dsp::init_point_xyz(&b->p[4], min.x, max.y, min.z);
+        dsp::init_point_xyz(&b->p[5], min.x, min.y, min.z);
+        dsp::init_point_xyz(&b->p[6], max.x, min.y, min.z);
+        dsp::init_point_xyz(&b->p[7], max.x, max.y, min.z);
+
+        node->first         = first;
+        node->count         = count;
+        node->size          = 1;
+        if (count <= BVH_LEAF_SIZE)
+            return id;
+
+        // Split triangles by the median of centers along the longest axis
+        float dx            = cmax.x - cmin.x;
+        float dy            = cmax.y - cmin.y;
+        float dz            = cmax.z - cmin.z;
+        size_t axis         = ((dx >= dy) && (dx >= dz)) ? 0 : (dy >= dz) ? 1 : 2;
+        if (lsp_max(dx, lsp_max(dy, dz)) <= 0.0f)
+            return id;
+
+        for (size_t i=0; i<count; ++i)
+        {
+            t               = &mesh[vi[i]];
+            keys[i].key     = (axis == 0) ? t->v[0].x + t->v[1].x + t->v[2].x :
+                              (axis == 1) ? t->v[0].y + t->v[1].y + t->v[2].y :
+                                            t->v[0].z + t->v[1].z + t->v[2].z;
+            keys[i].index   = vi[i];
+        }
+        ::qsort(keys, count, sizeof(rt_bvh_key_t), bvh_cmp_key);
+        for (size_t i=0; i<count; ++i)
+            index[first + i]    = keys[i].index;
+
+        size_t half         = count >> 1;
+        ssize_t res         = build_bvh(bvh, index, keys, mesh, first, half);
+        if (res < 0)
+            return res;
+        res                 = build_bvh(bvh, index, keys, mesh, first + half, count - half);
+        if (res < 0)
+            return res;
+
+        // Node pointer may be invalidated by the storage growth
+        node                = bvh->at(id);
+        node->size          = bvh->size() - id;
+
+        return id;
+    }
+
+    bool RayTrace3D::check_bvh_node(const bound_box3d_t *bbox, const rt_view_t *view)
+    {
+        // The node is out of the view only if all points of bounding box lay above one of
+        // the culling planes. Unlike check_bound_box(), this test keeps flat bounding boxes
+        // that lay on the culling plane
+        const vector3d_t *pl = view->pl;
+        for (size_t i=0; i<4; ++i, ++pl)
+        {
+            size_t j;
+            for (j=0; j<8; ++j)
+            {
+                const point3d_t *p  = &bbox->p[j];
+                float k             = pl->dx*p->x + pl->dy*p->y + pl->dz*p->z + pl->dw;
+                if (k <= DSP_3D_TOLERANCE)
+                    break;
+            }
+            if (j >= 8)
+                return false;
+        }
+
+        return true;
+    }
+
     bool RayTrace3D::check_bound_box(const bound_box3d_t *bbox, const rt_view_t *view)
     {
         const vector3d_t *pl;
@@ -42,6 +42,7 @@ namespace lsp
         triangle(1024)
     {
         this->state     = S_SCAN_OBJECTS;
+        this->path      = NULL;
         IF_RT_TRACE_Y( this->debug     = NULL; )
 
         // Initialize point of view
@@ -62,6 +63,7 @@ namespace lsp
         triangle(1024)
     {
         this->state     = S_SCAN_OBJECTS;
+        this->path      = NULL;
         IF_RT_TRACE_Y(this->debug     = NULL;)
         this->view      = *view;
     }
@@ -70,6 +72,7 @@ namespace lsp
         triangle(1024)
     {
         this->state     = state;
+        this->path      = NULL;
         IF_RT_TRACE_Y(this->debug     = NULL;)
         this->view      = *view;
     }
@@ -961,14 +964,10 @@ namespace lsp
         return STATUS_OK;
     }
 
-    status_t rt_context_t::add_object(rtx_triangle_t *vt, rtx_edge_t *ve, size_t nt, size_t ne)
+    status_t rt_context_t::add_object(const rtx_triangle_t *vt, size_t nt, size_t *marks, size_t mark)
     {
         status_t res;
 
-        // Set-up tag for the edge
-        for (size_t i=0; i<ne; ++i)
-            ve[i].itag      = 1;
-
         // Add all triangles
         for (size_t i=0; i<nt; ++i)
         {
@@ -985,23 +984,23 @@ namespace lsp
                 return res;
 
             // Add edges to plan
-            if (t->e[0]->itag)
+            if (marks[t->e[0]->itag] != mark)
             {
                 if ((res = add_edge(t->e[0])) != STATUS_OK)
                     return res;
-                t->e[0]->itag   = 0;
+                marks[t->e[0]->itag]    = mark;
             }
-            if (t->e[1]->itag)
+            if (marks[t->e[1]->itag] != mark)
             {
                 if ((res = add_edge(t->e[1])) != STATUS_OK)
                     return res;
-                t->e[1]->itag   = 0;
+                marks[t->e[1]->itag]    = mark;
             }
-            if (t->e[2]->itag)
+            if (marks[t->e[2]->itag] != mark)
             {
                 if ((res = add_edge(t->e[2])) != STATUS_OK)
                     return res;
-                t->e[2]->itag   = 0;
+                marks[t->e[2]->itag]    = mark;
             }
         }
 
@@ -22,6 +22,9 @@
 #include <core/KVTStorage.h>
 #include <core/stdlib/string.h>
 
+#define KVT_NODE_ID_INLINE          48      /* Maximum identifier length (with terminator) for pooled nodes */
+#define KVT_POOL_CHUNK_ITEMS        0x40    /* Number of items allocated by the pool at once */
+
 namespace lsp
 {
     KVTListener::KVTListener()
@@ -91,6 +94,9 @@ namespace lsp
         nTxPending          = 0;
         nRxPending          = 0;
 
+        init_pool(&sNodePool, sizeof(kvt_node_t) + KVT_NODE_ID_INLINE);
+        init_pool(&sParamPool, sizeof(kvt_gcparam_t));
+
         init_node(&sRoot, NULL, 0);
         ++sRoot.refs;
     }
@@ -175,6 +181,63 @@ namespace lsp
         nValues             = 0;
         nTxPending          = 0;
         nRxPending          = 0;
+
+        // Release allocated memory
+        destroy_pool(&sNodePool);
+        destroy_pool(&sParamPool);
+    }
+
+    void KVTStorage::init_pool(kvt_pool_t *pool, size_t size)
+    {
+        pool->chunks        = NULL;
+        pool->free          = NULL;
+        pool->size          = ALIGN_SIZE(lsp_max(size, sizeof(void *)), DEFAULT_ALIGN);
+    }
+
+    void *KVTStorage::pool_alloc(kvt_pool_t *pool)
+    {
+        // Allocate new chunk if there are no free items
+        if (pool->free == NULL)
+        {
+            size_t hdr_size     = ALIGN_SIZE(sizeof(kvt_chunk_t), DEFAULT_ALIGN);
+            uint8_t *ptr        = reinterpret_cast<uint8_t *>(::malloc(hdr_size + pool->size * KVT_POOL_CHUNK_ITEMS));
+            if (ptr == NULL)
+                return NULL;
+
+            kvt_chunk_t *chunk  = reinterpret_cast<kvt_chunk_t *>(ptr);
+            chunk->next         = pool->chunks;
+            pool->chunks        = chunk;
+
+            // Add all items of the chunk to the free list
+            ptr                += hdr_size;
+            for (size_t i=0; i<KVT_POOL_CHUNK_ITEMS; ++i, ptr += pool->size)
+            {
+                *reinterpret_cast<void **>(ptr)     = pool->free;
+                pool->free                          = ptr;
+            }
+        }
+
+        // Fetch item from the free list
+        void *item          = pool->free;
+        pool->free          = *reinterpret_cast<void **>(item);
+        return item;
+    }
+
+    void KVTStorage::pool_free(kvt_pool_t *pool, void *item)
+    {
+        *reinterpret_cast<void **>(item)    = pool->free;
+        pool->free                          = item;
+    }
+
+    void KVTStorage::destroy_pool(kvt_pool_t *pool)
+    {
+        while (pool->chunks != NULL)
+        {
+            kvt_chunk_t *next   = pool->chunks->next;
+            ::free(pool->chunks);
+            pool->chunks        = next;
+        }
+        pool->free          = NULL;
     }
 
     status_t KVTStorage::clear()
@@ -218,8 +281,16 @@ namespace lsp
 
     KVTStorage::kvt_node_t *KVTStorage::allocate_node(const char *name, size_t len)
     {
-        size_t to_alloc     = ALIGN_SIZE(sizeof(kvt_node_t) + len + 1, DEFAULT_ALIGN);
-        kvt_node_t *node    = reinterpret_cast<kvt_node_t *>(::malloc(to_alloc));
+        // Nodes with short identifiers are allocated from the pool
+        kvt_node_t *node;
+        if (len < KVT_NODE_ID_INLINE)
+            node                = reinterpret_cast<kvt_node_t *>(pool_alloc(&sNodePool));
+        else
+        {
+            size_t to_alloc     = ALIGN_SIZE(sizeof(kvt_node_t) + len + 1, DEFAULT_ALIGN);
+            node                = reinterpret_cast<kvt_node_t *>(::malloc(to_alloc));
+        }
+
         if (node != NULL)
         {
             init_node(node, name, len);
@@ -431,7 +502,7 @@ namespace lsp
             param->u64      = 0;
 
         param->type         = KVT_ANY;
-        ::free(param);
+        pool_free(&sParamPool, param);
     }
 
     char *KVTStorage::build_path(char **path, size_t *capacity, const kvt_node_t *node)
@@ -548,7 +619,9 @@ namespace lsp
 
     KVTStorage::kvt_gcparam_t *KVTStorage::copy_parameter(const kvt_param_t *src, size_t flags)
     {
-        kvt_gcparam_t *gcp  = reinterpret_cast<kvt_gcparam_t *>(::malloc(sizeof(kvt_gcparam_t)));
+        kvt_gcparam_t *gcp  = reinterpret_cast<kvt_gcparam_t *>(pool_alloc(&sParamPool));
+        if (gcp == NULL)
+            return NULL;
         gcp->flags          = flags & (KVT_PRIVATE | KVT_TRANSIENT);
         gcp->next           = NULL;
 
@@ -565,7 +638,7 @@ namespace lsp
             {
                 if (!(dst->str = ::strdup(src->str)))
                 {
-                    ::free(gcp);
+                    pool_free(&sParamPool, gcp);
                     return NULL;
                 }
             }
@@ -576,7 +649,7 @@ namespace lsp
             {
                 if (!(dst->blob.ctype = ::strdup(src->blob.ctype)))
                 {
-                    ::free(gcp);
+                    pool_free(&sParamPool, gcp);
                     return NULL;
                 }
             }
@@ -586,7 +659,7 @@ namespace lsp
                 {
                     if (dst->blob.ctype != NULL)
                         ::free(const_cast<char *>(dst->blob.ctype));
-                    ::free(gcp);
+                    pool_free(&sParamPool, gcp);
                     return NULL;
                 }
                 ::memcpy(const_cast<void *>(dst->blob.data), src->blob.data, src->blob.size);
@@ -650,8 +723,11 @@ namespace lsp
         else if (*(path++) != cSeparator)
             return STATUS_INVALID_VALUE;
 
-        kvt_node_t *curr = &sRoot;
+        return put_node(&sRoot, path, name, value, flags);
+    }
 
+    status_t KVTStorage::put_node(kvt_node_t *curr, const char *path, const char *name, const kvt_param_t *value, size_t flags)
+    {
         while (true)
         {
             const char *item = ::strchr(path, cSeparator);
@@ -681,6 +757,85 @@ namespace lsp
         }
     }
 
+    bool KVTStorage::validate_path(const char *path) const
+    {
+        // Do not allow empty names of nodes
+        if ((*path == '\0') || (*path == cSeparator))
+            return false;
+
+        for (const char *item = ::strchr(path, cSeparator); item != NULL; item = ::strchr(item + 1, cSeparator))
+        {
+            if ((item[1] == '\0') || (item[1] == cSeparator))
+                return false;
+        }
+
+        return true;
+    }
+
+    status_t KVTStorage::put_batch(const char *base, const kvt_entry_t *entries, size_t count)
+    {
+        if ((base == NULL) || ((entries == NULL) && (count > 0)))
+            return STATUS_BAD_ARGUMENTS;
+        else if (*base != cSeparator)
+            return STATUS_INVALID_VALUE;
+
+        // Validate the whole batch before applying any change
+        const char *bpath   = &base[1];
+        size_t blen         = ::strlen(base);
+        if ((*bpath != '\0') && (!validate_path(bpath)))
+            return STATUS_INVALID_VALUE;
+
+        size_t max_len      = 0;
+        for (size_t i=0; i<count; ++i)
+        {
+            const kvt_entry_t *e = &entries[i];
+            if (e->name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            else if (!validate_type(e->value.type))
+                return STATUS_BAD_TYPE;
+            else if (!validate_path(e->name))
+                return STATUS_INVALID_VALUE;
+            max_len             = lsp_max(max_len, ::strlen(e->name));
+        }
+
+        // Allocate buffer for full parameter names
+        char *name          = reinterpret_cast<char *>(::malloc(blen + max_len + 2));
+        if (name == NULL)
+            return STATUS_NO_MEM;
+        ::memcpy(name, base, blen);
+        if (*bpath != '\0')
+            name[blen++]        = cSeparator;
+
+        // Lookup for the base branch
+        status_t res        = STATUS_OK;
+        kvt_node_t *curr    = &sRoot;
+        for (const char *path = bpath; *path != '\0'; )
+        {
+            const char *item    = ::strchr(path, cSeparator);
+            size_t len          = (item != NULL) ? item - path : ::strlen(path);
+            if (!(curr = create_node(curr, path, len)))
+            {
+                res                 = STATUS_NO_MEM;
+                break;
+            }
+            path                = (item != NULL) ? item + 1 : &path[len];
+        }
+
+        // Store all parameters
+        for (size_t i=0; (res == STATUS_OK) && (i<count); ++i)
+        {
+            const kvt_entry_t *e = &entries[i];
+            ::strcpy(&name[blen], e->name);
+            res                 = put_node(curr, e->name, name, &e->value, e->flags);
+            if (res == STATUS_ALREADY_EXISTS) // Rejected parameters are not an error
+                res                 = STATUS_OK;
+        }
+
+        ::free(name);
+
+        return res;
+    }
+
     status_t KVTStorage::walk_node(kvt_node_t **out, const char *name)
     {
         const char *path    = name;
@@ -1496,6 +1651,7 @@ namespace lsp
 
     void KVTStorage::destroy_node(kvt_node_t *node)
     {
+        size_t len      = node->idlen;
         node->id        = NULL;
         node->idlen     = 0;
         node->parent    = NULL;
@@ -1515,7 +1671,10 @@ namespace lsp
         node->nchildren = 0;
         node->capacity  = 0;
 
-        ::free(node);
+        if (len < KVT_NODE_ID_INLINE)
+            pool_free(&sNodePool, node);
+        else
+            ::free(node);
     }
 
     status_t KVTStorage::gc()
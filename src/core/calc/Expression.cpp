@@ -32,11 +32,15 @@ namespace lsp
         Expression::Expression()
         {
             pResolver       = NULL;
+            vSlots          = NULL;
+            nSlots          = 0;
         }
         
         Expression::Expression(Resolver *res)
         {
             pResolver       = res;
+            vSlots          = NULL;
+            nSlots          = 0;
         }
         
         Expression::~Expression()
@@ -51,8 +55,22 @@ namespace lsp
             pResolver       = NULL;
         }
 
+        void Expression::destroy_slots()
+        {
+            if (vSlots != NULL)
+            {
+                for (size_t i=0; i<nSlots; ++i)
+                    destroy_value(&vSlots[i].value);
+                ::free(vSlots);
+                vSlots          = NULL;
+            }
+            nSlots          = 0;
+        }
+
         void Expression::destroy_all_data()
         {
+            destroy_slots();
+
             for (size_t i=0, n=vDependencies.size(); i<n; ++i)
             {
                 LSPString *dep = vDependencies.at(i);
@@ -416,9 +434,168 @@ namespace lsp
                     return res;
             }
 
+            // Compile variable references into slots
+            return compile_slots();
+        }
+
+        status_t Expression::scan_slots(expr_t *expr, cvector<LSPString> *names, cvector<expr_t> *refs)
+        {
+            if (expr == NULL)
+                return STATUS_OK;
+
+            switch (expr->type)
+            {
+                case ET_VALUE:
+                    return STATUS_OK;
+                case ET_CALC:
+                {
+                    status_t res = scan_slots(expr->calc.cond, names, refs);
+                    if (res == STATUS_OK)
+                        res = scan_slots(expr->calc.left, names, refs);
+                    if (res == STATUS_OK)
+                        res = scan_slots(expr->calc.right, names, refs);
+                    return res;
+                }
+                case ET_RESOLVE:
+                {
+                    // Variables with indexes can not be bound to the slot
+                    if (expr->resolve.count > 0)
+                    {
+                        for (size_t i=0; i<expr->resolve.count; ++i)
+                        {
+                            status_t res = scan_slots(expr->resolve.items[i], names, refs);
+                            if (res != STATUS_OK)
+                                return res;
+                        }
+                        return STATUS_OK;
+                    }
+
+                    if (!refs->add(expr))
+                        return STATUS_NO_MEM;
+
+                    // Name is already registered?
+                    for (size_t i=0, n=names->size(); i<n; ++i)
+                        if (names->at(i)->equals(expr->resolve.name))
+                            return STATUS_OK;
+
+                    // Use the name stored in dependencies
+                    for (size_t i=0, n=vDependencies.size(); i<n; ++i)
+                    {
+                        LSPString *dep = vDependencies.at(i);
+                        if (dep->equals(expr->resolve.name))
+                            return (names->add(dep)) ? STATUS_OK : STATUS_NO_MEM;
+                    }
+                    return STATUS_CORRUPTED;
+                }
+                default:
+                    break;
+            }
+            return STATUS_CORRUPTED;
+        }
+
+        status_t Expression::compile_slots()
+        {
+            cvector<LSPString> names;
+            cvector<expr_t> refs;
+
+            // Drop previously allocated slots
+            destroy_slots();
+
+            for (size_t i=0, n=vRoots.size(); i<n; ++i)
+            {
+                root_t *root = vRoots.at(i);
+                if (root == NULL)
+                    continue;
+
+                status_t res = scan_slots(root->expr, &names, &refs);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            size_t count = names.size();
+            if (count <= 0)
+                return STATUS_OK;
+
+            // Allocate slots
+            vSlots      = reinterpret_cast<slot_t *>(::malloc(count * sizeof(slot_t)));
+            if (vSlots == NULL)
+                return STATUS_NO_MEM;
+            nSlots      = count;
+
+            for (size_t i=0; i<count; ++i)
+            {
+                slot_t *s   = &vSlots[i];
+                s->name     = names.at(i);
+                s->bound    = false;
+                init_value(&s->value);
+            }
+
+            // Link references to slots
+            for (size_t i=0, n=refs.size(); i<n; ++i)
+            {
+                expr_t *e   = refs.at(i);
+                for (size_t j=0; j<count; ++j)
+                {
+                    if (vSlots[j].name->equals(e->resolve.name))
+                    {
+                        e->resolve.slot     = &vSlots[j];
+                        break;
+                    }
+                }
+            }
+
             return STATUS_OK;
         }
 
+        const LSPString *Expression::slot_name(size_t idx) const
+        {
+            return (idx < nSlots) ? vSlots[idx].name : NULL;
+        }
+
+        status_t Expression::bind(size_t idx, const value_t *value)
+        {
+            if (idx >= nSlots)
+                return STATUS_BAD_ARGUMENTS;
+
+            slot_t *s   = &vSlots[idx];
+            status_t res = copy_value(&s->value, value);
+            if (res == STATUS_OK)
+                s->bound    = true;
+            return res;
+        }
+
+        status_t Expression::bind_float(size_t idx, double value)
+        {
+            if (idx >= nSlots)
+                return STATUS_BAD_ARGUMENTS;
+
+            slot_t *s   = &vSlots[idx];
+            set_value_float(&s->value, value);
+            s->bound    = true;
+            return STATUS_OK;
+        }
+
+        status_t Expression::unbind(size_t idx)
+        {
+            if (idx >= nSlots)
+                return STATUS_BAD_ARGUMENTS;
+
+            slot_t *s   = &vSlots[idx];
+            destroy_value(&s->value);
+            s->bound    = false;
+            return STATUS_OK;
+        }
+
+        void Expression::unbind_all()
+        {
+            for (size_t i=0; i<nSlots; ++i)
+            {
+                slot_t *s   = &vSlots[i];
+                destroy_value(&s->value);
+                s->bound    = false;
+            }
+        }
+
         status_t Expression::add_dependency(const LSPString *str)
         {
             // Already have such dependency?
@@ -1118,6 +1118,11 @@ namespace lsp
 
         status_t eval_resolve(value_t *value, const expr_t *expr, eval_env_t *env)
         {
+            // Variable is pre-bound to the slot?
+            const slot_t *slot = expr->resolve.slot;
+            if ((slot != NULL) && (slot->bound))
+                return copy_value(value, &slot->value);
+
             status_t res;
             if (env == NULL)
             {
@@ -138,6 +138,7 @@ namespace lsp
                     bind->resolve.name  = name;
                     bind->resolve.count = 0;
                     bind->resolve.items = NULL;
+                    bind->resolve.slot  = NULL;
                 }
                 else
                 {
@@ -185,6 +186,7 @@ namespace lsp
             bind->resolve.name  = id;
             bind->resolve.count = indexes.size();
             bind->resolve.items = indexes.release();
+            bind->resolve.slot  = NULL;
 
             *expr               = bind;
             return STATUS_OK;
@@ -60,6 +60,21 @@ namespace lsp
         fBKE            = 0.0f;
         fBoost          = 1.0f;
 
+        for (size_t i=0; i<2; ++i)
+        {
+            dsp::dyn_knee_t *k  = &vKnees[i];
+            k->start            = 0.0f;
+            k->end              = 0.0f;
+            k->lo[0]            = 0.0f;
+            k->lo[1]            = 0.0f;
+            k->herm[0]          = 0.0f;
+            k->herm[1]          = 0.0f;
+            k->herm[2]          = 0.0f;
+            k->herm[3]          = 0.0f;
+            k->hi[0]            = 0.0f;
+            k->hi[1]            = 0.0f;
+        }
+
         // Additional parameters
         nSampleRate     = 0;
         nMode           = CM_DOWNWARD;
@@ -137,6 +152,40 @@ namespace lsp
                 break;
         }
 
+        // Compression knee: reduction of the gain
+        dsp::dyn_knee_t *k  = &vKnees[0];
+        k->start            = fKS;
+        k->end              = fKE;
+        k->lo[0]            = 0.0f;
+        k->lo[1]            = 0.0f;
+        k->herm[0]          = 0.0f;
+        k->herm[1]          = vHermite[0];
+        k->herm[2]          = vHermite[1] - 1.0f;
+        k->herm[3]          = vHermite[2];
+        k->hi[0]            = fXRatio - 1.0f;
+        k->hi[1]            = (1.0f - fXRatio) * fLogTH;
+
+        if (nMode != CM_DOWNWARD)
+        {
+            // Upward compression knee is inverted
+            k->hi[0]            = 1.0f - fXRatio;
+            k->hi[1]            = (fXRatio - 1.0f) * fLogTH;
+
+            // Boost knee, overall gain boost is applied here
+            float log_boost     = logf(fBoost);
+            k                   = &vKnees[1];
+            k->start            = fBKS;
+            k->end              = fBKE;
+            k->lo[0]            = 0.0f;
+            k->lo[1]            = log_boost;
+            k->herm[0]          = 0.0f;
+            k->herm[1]          = vBHermite[0];
+            k->herm[2]          = vBHermite[1] - 1.0f;
+            k->herm[3]          = vBHermite[2] + log_boost;
+            k->hi[0]            = fXRatio - 1.0f;
+            k->hi[1]            = (1.0f - fXRatio) * fBLogTH + log_boost;
+        }
+
         // Reset update flag
         bUpdate         = false;
     }
@@ -180,46 +229,9 @@ namespace lsp
     void Compressor::curve(float *out, const float *in, size_t dots)
     {
         if (nMode == CM_DOWNWARD)
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = fabs(in[i]);
-
-                if (x > fKS)
-                {
-                    float lx    = logf(x);
-                    out[i]      = (x >= fKE) ?
-                        expf(fXRatio*(lx - fLogTH) + fLogTH) :
-                        expf((vHermite[0]*lx + vHermite[1])*lx + vHermite[2]);
-                }
-                else
-                    out[i]      = x;
-            }
-        }
+            dsp::dyn_curve_x1(out, in, vKnees, dots);
         else
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = fabs(in[i]);
-                float lx    = logf(x);
-                float g1    = 1.0f, g2 = 1.0f;
-                if (x > fBKS)
-                {
-                    g1  = (x >= fBKE) ?
-                        expf((fXRatio - 1.0f)*(lx-fBLogTH)) :
-                        expf((vBHermite[0]*lx + vBHermite[1] - 1.0f)*lx + vBHermite[2]);
-                }
-
-                if (x > fKS)
-                {
-                    g2  = (x >= fKE) ?
-                        expf((1.0f - fXRatio)*(lx-fLogTH)) :
-                        expf((vHermite[0]*lx + vHermite[1] - 1.0f)*lx + vHermite[2]);
-                }
-
-                out[i]      = x * g1 * g2 * fBoost;
-            }
-        }
+            dsp::dyn_curve_x2(out, in, vKnees, dots);
     }
 
     float Compressor::curve(float in)
@@ -263,45 +275,9 @@ namespace lsp
     void Compressor::reduction(float *out, const float *in, size_t dots)
     {
         if (nMode == CM_DOWNWARD)
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = fabs(in[i]);
-                if (x > fKS)
-                {
-                    float lx    = logf(x);
-                    out[i]  = (x >= fKE) ?
-                        expf((fXRatio-1.0f)*(lx-fLogTH)) :
-                        expf((vHermite[0]*lx + vHermite[1] - 1.0f)*lx + vHermite[2]);
-                }
-                else
-                    out[i]      = 1.0f;
-            }
-        }
+            dsp::dyn_gain_x1(out, in, vKnees, dots);
         else
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = fabs(in[i]);
-                float lx    = logf(x);
-                float g1    = 1.0f, g2 = 1.0f;
-                if (x > fBKS)
-                {
-                    g1  = (x >= fBKE) ?
-                        expf((fXRatio - 1.0f)*(lx-fBLogTH)) :
-                        expf((vBHermite[0]*lx + vBHermite[1] - 1.0f)*lx + vBHermite[2]);
-                }
-
-                if (x > fKS)
-                {
-                    g2  = (x >= fKE) ?
-                        expf((1.0f - fXRatio)*(lx-fLogTH)) :
-                        expf((vHermite[0]*lx + vHermite[1] - 1.0f)*lx + vHermite[2]);
-                }
-
-                out[i]      = g1 * g2 * fBoost;
-            }
-        }
+            dsp::dyn_gain_x2(out, in, vKnees, dots);
     }
 
     float Compressor::reduction(float in)
@@ -364,6 +340,21 @@ namespace lsp
         v->write("fBKE", fBKE);
         v->writev("vBHermite", vBHermite, 3);
         v->write("fBoost", fBoost);
+        v->begin_array("vKnees", vKnees, 2);
+        for (size_t i=0; i<2; ++i)
+        {
+            const dsp::dyn_knee_t *k = &vKnees[i];
+            v->begin_object(k, sizeof(dsp::dyn_knee_t));
+            {
+                v->write("start", k->start);
+                v->write("end", k->end);
+                v->writev("lo", k->lo, 2);
+                v->writev("herm", k->herm, 4);
+                v->writev("hi", k->hi, 2);
+            }
+            v->end_object();
+        }
+        v->end_array();
         v->write("nSampleRate", nSampleRate);
         v->write("nMode", nMode);
         v->write("bUpdate", bUpdate);
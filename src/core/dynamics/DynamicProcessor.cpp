@@ -26,6 +26,8 @@
 #include <core/units.h>
 #include <math.h>
 
+#define DYNAMIC_PROCESSOR_BUF_SIZE      0x100
+
 namespace lsp
 {
     DynamicProcessor::DynamicProcessor()
@@ -183,6 +185,22 @@ namespace lsp
                 s[i].fPreRatio, s[i].fPostRatio,
                 s[i].fKneeStart, s[i].fKneeStop);
         }
+
+        // Convert splines into knees for vector processing
+        for (size_t i=0; i<count; ++i)
+        {
+            dsp::dyn_knee_t *k  = &vKnees[i];
+            k->start            = expf(s[i].fKneeStart);
+            k->end              = expf(s[i].fKneeStop);
+            k->lo[0]            = s[i].fPreRatio;
+            k->lo[1]            = s[i].fMakeup - s[i].fPreRatio * s[i].fThresh;
+            k->herm[0]          = 0.0f;
+            k->herm[1]          = s[i].vHermite[0];
+            k->herm[2]          = s[i].vHermite[1];
+            k->herm[3]          = s[i].vHermite[2];
+            k->hi[0]            = s[i].fPostRatio;
+            k->hi[1]            = s[i].fMakeup - s[i].fPostRatio * s[i].fThresh;
+        }
     }
 
     bool DynamicProcessor::set_dot(size_t id, const dyndot_t *src)
@@ -326,27 +344,52 @@ namespace lsp
         return reduction(fEnvelope);
     }
 
-    void DynamicProcessor::curve(float *out, const float *in, size_t dots)
+    void DynamicProcessor::splines_gain(float *dst, float *tmp, const float *x, size_t count)
     {
         size_t splines  = fCount[CT_SPLINES];
+        if (splines == 0)
+        {
+            dsp::fill_one(dst, count);
+            return;
+        }
 
-        for (size_t i=0; i<dots; ++i)
+        // Gain of the sum of splines is the product of their gains
+        const dsp::dyn_knee_t *k    = vKnees;
+        const dsp::dyn_knee_t *e    = &vKnees[splines];
+        if (splines & 1)
         {
-            float x     = *(in++);
-            if (x < 0.0f)
-                x       = -x;
-            if (x < FLOAT_SAT_N_INF)
-                x       = FLOAT_SAT_N_INF;
-            else if (x > FLOAT_SAT_P_INF)
-                x       = FLOAT_SAT_P_INF;
+            dsp::dyn_gain_x1(dst, x, k, count);
+            ++k;
+        }
+        else
+        {
+            dsp::dyn_gain_x2(dst, x, k, count);
+            k  += 2;
+        }
 
-            float lx    = logf(x);
-            float gain  = 0.0f;
+        for ( ; k < e; k += 2)
+        {
+            dsp::dyn_gain_x2(tmp, x, k, count);
+            dsp::mul2(dst, tmp, count);
+        }
+    }
 
-            for (size_t j=0; j<splines; ++j)
-                gain       += spline_amp(&vSplines[j], lx);
+    void DynamicProcessor::curve(float *out, const float *in, size_t dots)
+    {
+        float x[DYNAMIC_PROCESSOR_BUF_SIZE], tmp[DYNAMIC_PROCESSOR_BUF_SIZE];
 
-            *(out++)    = expf(gain) * x;
+        while (dots > 0)
+        {
+            size_t to_do    = lsp_min(dots, DYNAMIC_PROCESSOR_BUF_SIZE);
+
+            dsp::abs2(x, in, to_do);
+            dsp::limit1(x, 0.0f, FLOAT_SAT_P_INF, to_do);
+            splines_gain(out, tmp, x, to_do);
+            dsp::mul2(out, x, to_do);
+
+            in             += to_do;
+            out            += to_do;
+            dots           -= to_do;
         }
     }
 
@@ -416,25 +459,19 @@ namespace lsp
 
     void DynamicProcessor::reduction(float *out, const float *in, size_t dots)
     {
-        size_t splines  = fCount[CT_SPLINES];
+        float x[DYNAMIC_PROCESSOR_BUF_SIZE], tmp[DYNAMIC_PROCESSOR_BUF_SIZE];
 
-        for (size_t i=0; i<dots; ++i)
+        while (dots > 0)
         {
-            float x     = *(in++);
-            if (x < 0.0f)
-                x       = -x;
-            if (x < GAIN_AMP_MIN)
-                x       = GAIN_AMP_MIN;
-            else if (x > FLOAT_SAT_P_INF)
-                x       = FLOAT_SAT_P_INF;
+            size_t to_do    = lsp_min(dots, DYNAMIC_PROCESSOR_BUF_SIZE);
 
-            float lx    = logf(x);
-            float gain  = 0.0f;
+            dsp::abs2(x, in, to_do);
+            dsp::limit1(x, GAIN_AMP_MIN, FLOAT_SAT_P_INF, to_do);
+            splines_gain(out, tmp, x, to_do);
 
-            for (size_t j=0; j<splines; ++j)
-                gain       += spline_amp(&vSplines[j], lx);
-
-            *(out++)    = expf(gain);
+            in             += to_do;
+            out            += to_do;
+            dots           -= to_do;
         }
     }
 
@@ -500,6 +537,22 @@ namespace lsp
         }
         v->end_array();
 
+        v->begin_array("vKnees", vKnees, DYNAMIC_PROCESSOR_DOTS);
+        for (size_t i=0; i<DYNAMIC_PROCESSOR_DOTS; ++i)
+        {
+            const dsp::dyn_knee_t *k = &vKnees[i];
+            v->begin_object(k, sizeof(dsp::dyn_knee_t));
+            {
+                v->write("start", k->start);
+                v->write("end", k->end);
+                v->writev("lo", k->lo, 2);
+                v->writev("herm", k->herm, 4);
+                v->writev("hi", k->hi, 2);
+            }
+            v->end_object();
+        }
+        v->end_array();
+
         v->begin_array("vAttack", vAttack, DYNAMIC_PROCESSOR_RANGES);
         for (size_t i=0; i<DYNAMIC_PROCESSOR_RANGES; ++i)
         {
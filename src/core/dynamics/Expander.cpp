@@ -47,6 +47,16 @@ namespace lsp
         fLogKS          = 0.0f;
         fLogKE          = 0.0f;
         fLogTH          = 0.0f;
+        sKnee.start     = 0.0f;
+        sKnee.end       = 0.0f;
+        sKnee.lo[0]     = 0.0f;
+        sKnee.lo[1]     = 0.0f;
+        sKnee.herm[0]   = 0.0f;
+        sKnee.herm[1]   = 0.0f;
+        sKnee.herm[2]   = 0.0f;
+        sKnee.herm[3]   = 0.0f;
+        sKnee.hi[0]     = 0.0f;
+        sKnee.hi[1]     = 0.0f;
 
         // Additional parameters
         nSampleRate     = 0;
@@ -74,6 +84,19 @@ namespace lsp
         else
             interpolation::hermite_quadratic(vHermite, fLogKE, fLogKE, 1.0f, fLogKS, fRatio);
 
+        // Update knee for vector processing
+        float tilt      = fRatio - 1.0f;
+        sKnee.start     = fAttackThresh * fKnee;
+        sKnee.end       = fAttackThresh / fKnee;
+        sKnee.lo[0]     = (bUpward) ? 0.0f : tilt;
+        sKnee.lo[1]     = (bUpward) ? 0.0f : -tilt * fLogTH;
+        sKnee.herm[0]   = 0.0f;
+        sKnee.herm[1]   = vHermite[0];
+        sKnee.herm[2]   = vHermite[1] - 1.0f;
+        sKnee.herm[3]   = vHermite[2];
+        sKnee.hi[0]     = (bUpward) ? tilt : 0.0f;
+        sKnee.hi[1]     = (bUpward) ? -tilt * fLogTH : 0.0f;
+
         // Reset update flag
         bUpdate         = false;
     }
@@ -116,50 +139,7 @@ namespace lsp
 
     void Expander::curve(float *out, const float *in, size_t dots)
     {
-        if (bUpward)
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = *(in++);
-                if (x < 0.0f)
-                    x       = -x;
-                if (x > FLOAT_SAT_P_INF)
-                    x       = FLOAT_SAT_P_INF;
-
-                float lx    = logf(x);
-                if (lx > fLogKS)
-                {
-                    x   = (lx >= fLogKE) ?
-                        expf(fRatio*(lx - fLogTH) + fLogTH) :
-                        expf((vHermite[0]*lx + vHermite[1])*lx + vHermite[2]);
-                    *out        = x;
-                }
-                else
-                    *out        = x;
-                out++;
-            }
-        }
-        else
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = *(in++);
-                if (x < 0.0f)
-                    x       = -x;
-
-                float lx    = logf(x);
-                if (lx < fLogKE)
-                {
-                    x   = (lx <= fLogKS) ?
-                        expf(fRatio*(lx - fLogTH) + fLogTH) :
-                        expf((vHermite[0]*lx + vHermite[1])*lx + vHermite[2]);
-                    *out        = x;
-                }
-                else
-                    *out        = x;
-                out++;
-            }
-        }
+        dsp::dyn_curve_x1(out, in, &sKnee, dots);
     }
 
     float Expander::curve(float in)
@@ -192,48 +172,7 @@ namespace lsp
 
     void Expander::amplification(float *out, const float *in, size_t dots)
     {
-        if (bUpward)
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = *(in++);
-                if (x < 0.0f)
-                    x       = -x;
-                if (x > FLOAT_SAT_P_INF)
-                    x       = FLOAT_SAT_P_INF;
-
-                float lx    = logf(x);
-                if (lx > fLogKS)
-                {
-                    *out    = (lx >= fLogKE) ?
-                        expf((fRatio - 1.0f)*(lx - fLogTH)) :
-                        expf((vHermite[0]*lx + vHermite[1] - 1.0f)*lx + vHermite[2]);
-                }
-                else
-                    *out        = 1.0f;
-                out++;
-            }
-        }
-        else
-        {
-            for (size_t i=0; i<dots; ++i)
-            {
-                float x     = *(in++);
-                if (x < 0.0f)
-                    x       = -x;
-
-                float lx    = logf(x);
-                if (lx < fLogKE)
-                {
-                    *out    = (lx <= fLogKS) ?
-                        expf((fRatio - 1.0f)*(lx - fLogTH)) :
-                        expf((vHermite[0]*lx + vHermite[1] - 1.0f)*lx + vHermite[2]);
-                }
-                else
-                    *out        = 1.0f;
-                out++;
-            }
-        }
+        dsp::dyn_gain_x1(out, in, &sKnee, dots);
     }
 
     float Expander::amplification(float in)
@@ -280,6 +219,15 @@ namespace lsp
         v->write("fLogKS", fLogKS);
         v->write("fLogKE", fLogKE);
         v->write("fLogTH", fLogTH);
+        v->begin_object("sKnee", &sKnee, sizeof(dsp::dyn_knee_t));
+        {
+            v->write("start", sKnee.start);
+            v->write("end", sKnee.end);
+            v->writev("lo", sKnee.lo, 2);
+            v->writev("herm", sKnee.herm, 4);
+            v->writev("hi", sKnee.hi, 2);
+        }
+        v->end_object();
         v->write("nSampleRate", nSampleRate);
         v->write("bUpdate", bUpdate);
         v->write("bUpward", bUpward);
@@ -44,6 +44,17 @@ namespace lsp
             c->vHermite[1]  = 0.0f;
             c->vHermite[2]  = 0.0f;
             c->vHermite[3]  = 0.0f;
+
+            c->sKnee.start  = 0.0f;
+            c->sKnee.end    = 0.0f;
+            c->sKnee.lo[0]  = 0.0f;
+            c->sKnee.lo[1]  = 0.0f;
+            c->sKnee.herm[0] = 0.0f;
+            c->sKnee.herm[1] = 0.0f;
+            c->sKnee.herm[2] = 0.0f;
+            c->sKnee.herm[3] = 0.0f;
+            c->sKnee.hi[0]  = 0.0f;
+            c->sKnee.hi[1]  = 0.0f;
         }
 
         fAttack         = 0.0f;
@@ -94,6 +105,19 @@ namespace lsp
                         c->fLogZE, c->fLogZE, 1.0f
                     );
 //            }
+
+            // Update knee for vector processing
+            dsp::dyn_knee_t *k  = &c->sKnee;
+            k->start            = c->fZS;
+            k->end              = c->fZE;
+            k->lo[0]            = 0.0f;
+            k->lo[1]            = logf(fReduction);
+            k->herm[0]          = c->vHermite[0];
+            k->herm[1]          = c->vHermite[1];
+            k->herm[2]          = c->vHermite[2] - 1.0f;
+            k->herm[3]          = c->vHermite[3];
+            k->hi[0]            = 0.0f;
+            k->hi[1]            = 0.0f;
         }
 
         // Reset update flag
@@ -102,27 +126,7 @@ namespace lsp
 
     void Gate::curve(float *out, const float *in, size_t dots, bool hyst)
     {
-        curve_t *c      = &sCurves[(hyst) ? 1 : 0];
-
-        for (size_t i=0; i<dots; ++i)
-        {
-            float x     = *(in++);
-            if (x < 0.0f)
-                x       = -x;
-
-            if (x > c->fZS)
-            {
-                if (x < c->fZE)
-                {
-                    float lx    = logf(x);
-                    x           = expf(((c->vHermite[0]*lx + c->vHermite[1])*lx + c->vHermite[2])*lx + c->vHermite[3]);
-                }
-                *out    = x;
-            }
-            else
-                *out    = fReduction * x;
-            out++;
-        }
+        dsp::dyn_curve_x1(out, in, &sCurves[(hyst) ? 1 : 0].sKnee, dots);
     }
 
     float Gate::curve(float in, bool hyst)
@@ -201,28 +205,7 @@ namespace lsp
 
     void Gate::amplification(float *out, const float *in, size_t dots, bool hyst)
     {
-        curve_t *c      = &sCurves[(hyst) ? 1 : 0];
-
-        for (size_t i=0; i<dots; ++i)
-        {
-            float x     = *(in++);
-            if (x < 0.0f)
-                x       = -x;
-
-            if (x > c->fZS)
-            {
-                if (x < c->fZE)
-                {
-                    float lx    = logf(x);
-                    *out        = expf(((c->vHermite[0]*lx + c->vHermite[1])*lx + c->vHermite[2] - 1.0f)*lx + c->vHermite[3]);
-                }
-                else
-                    *out    = 1.0f;
-            }
-            else
-                *out    = fReduction;
-            out++;
-        }
+        dsp::dyn_gain_x1(out, in, &sCurves[(hyst) ? 1 : 0].sKnee, dots);
     }
 
     float Gate::amplification(float in)
@@ -280,6 +263,15 @@ namespace lsp
                 v->write("fLogZS", c->fLogZS);
                 v->write("fLogZE", c->fLogZE);
                 v->writev("vHermite", c->vHermite, 4);
+                v->begin_object("sKnee", &c->sKnee, sizeof(dsp::dyn_knee_t));
+                {
+                    v->write("start", c->sKnee.start);
+                    v->write("end", c->sKnee.end);
+                    v->writev("lo", c->sKnee.lo, 2);
+                    v->writev("herm", c->sKnee.herm, 4);
+                    v->writev("hi", c->sKnee.hi, 2);
+                }
+                v->end_object();
             }
             v->end_object();
         }
@@ -20,6 +20,7 @@
  */
 
 #include <core/fade.h>
+#include <core/sugar.h>
 
 namespace lsp
 {
@@ -53,5 +54,22 @@ namespace lsp
         for (size_t i=fade_len; i > 0; )
             *(dst++) = *(src++) * ((--i) * k);
     }
+
+    void fade_out(float *dst, const float *src, size_t fade_len, size_t offset, size_t count, size_t sig_len)
+    {
+        if ((fade_len <= 0) || (count <= 0) || (offset >= sig_len))
+            return;
+
+        // Compute the range of the part affected by the fade
+        size_t first    = (fade_len < sig_len) ? sig_len - fade_len : 0;
+        size_t last     = lsp_min(offset + count, sig_len);
+        if (last <= first)
+            return;
+
+        float k         = 1.0f / fade_len;
+        for (size_t i=lsp_max(first, offset); i < last; ++i)
+            dst[i - offset] = src[i - offset] * ((sig_len - 1 - i) * k);
+    }
+
 }
 
@@ -26,7 +26,13 @@
 #include <core/files/LSPCFile.h>
 #include <core/files/AudioFile.h>
 #include <core/files/lspc/LSPCAudioReader.h>
+#include <core/files/lspc/LSPCAudioWriter.h>
+#include <core/io/File.h>
+#include <core/io/Dir.h>
+#include <data/cstorage.h>
+#include <core/system.h>
 #include <core/alloc.h>
+#include <core/ipc/Thread.h>
 
 #ifdef PLATFORM_WINDOWS
 /*
@@ -78,10 +84,18 @@
 
 #else
     #include <sndfile.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <errno.h>
 #endif /* PLATFORM_WINDOWS */
 
 #define TMP_BUFFER_SIZE         1024
 #define RESAMPLING_PERIODS      8
+#define RESAMPLING_WORKERS_MAX  16          /* Maximum number of threads used for resampling */
+#define RESAMPLING_TASK_SIZE    0x4000      /* Minimum number of source samples processed by one thread */
+#define RESAMPLING_CACHE_DIR    "lsp-plugins-resample"
+#define RESAMPLING_CACHE_SIZE   (wsize_t(512) << 20)                /* Maximum size of the resampling cache in bytes */
+#define RESAMPLING_CACHE_AGE    (wsize_t(30 * 24 * 3600) * 1000)    /* Maximum age of the unused cache entry in milliseconds */
 #define ACM_INPUT_BUFSIZE       0x1000
 
 namespace lsp
@@ -422,14 +436,14 @@ namespace lsp
         }
 
         skip                = (skip > aparams.frames)? aparams.frames : skip;
-        size_t max_samples  = (max_duration >= 0.0f) ? seconds_to_samples(aparams.sample_rate, max_duration) : -1;
+        ssize_t max_samples = (max_duration >= 0.0f) ? ssize_t(seconds_to_samples(aparams.sample_rate, max_duration)) : -1;
         lsp_trace("file parameters: frames=%d, channels=%d, sample_rate=%d max_duration=%.3f, max_samples=%d",
                     int(aparams.frames), int(aparams.channels), int(aparams.sample_rate), max_duration, int(max_samples));
 
         aparams.frames     -= skip; // Remove number of frames to skip from audio parameters
 
         // Patch audio header
-        if ((max_samples >= 0) && (aparams.frames > max_samples))
+        if ((max_samples >= 0) && (aparams.frames > wsize_t(max_samples)))
             aparams.frames     = max_samples;
 
         // Skip set of frames
@@ -590,6 +604,382 @@ namespace lsp
         return load(path->as_string(), max_duration);
     }
 
+    status_t AudioFile::load_resampled(const char *path, size_t sample_rate, float max_duration)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+
+        LSPString spath;
+        if (!spath.set_utf8(path))
+            return STATUS_NO_MEM;
+
+        return load_resampled(&spath, sample_rate, max_duration);
+    }
+
+    status_t AudioFile::load_resampled(const io::Path *path, size_t sample_rate, float max_duration)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+        return load_resampled(path->as_string(), sample_rate, max_duration);
+    }
+
+    static uint64_t fnv1a_hash(uint64_t hash, const void *data, size_t bytes)
+    {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+        for (size_t i=0; i<bytes; ++i)
+        {
+            hash   ^= p[i];
+            hash   *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    uint64_t AudioFile::content_checksum(const file_content_t *content)
+    {
+        uint64_t hash       = 0xcbf29ce484222325ULL;
+        for (size_t i=0; i<content->nChannels; ++i)
+            hash                = fnv1a_hash(hash, content->vChannels[i], content->nSamples * sizeof(float));
+        return hash;
+    }
+
+    status_t AudioFile::load_resample_cache(const LSPString *path, size_t sample_rate)
+    {
+        LSPCFile fd;
+        status_t res = fd.open(path->get_native());
+        if (res != STATUS_OK)
+        {
+            fd.close();
+            return res;
+        }
+
+        // Read the description of the cached data
+        lspc_chunk_resample_t rs;
+        LSPCChunkReader *rd = fd.find_chunk(LSPC_CHUNK_RESAMPLE);
+        if (rd != NULL)
+        {
+            ssize_t n = rd->read_header(&rs, sizeof(lspc_chunk_resample_t));
+            if (n < 0)
+                res     = status_t(-n);
+            else if ((rs.common.version < 1) || (rs.common.size < sizeof(lspc_chunk_resample_t)))
+                res     = STATUS_CORRUPTED_FILE;
+
+            status_t res2 = rd->close();
+            if (res == STATUS_OK)
+                res = res2;
+            delete rd;
+        }
+        else
+            res     = STATUS_CORRUPTED_FILE;
+
+        status_t res2 = fd.close();
+        if (res == STATUS_OK)
+            res = res2;
+        if (res != STATUS_OK)
+            return res;
+
+        // Load the data and check that it matches the description
+        AudioFile af;
+        if ((res = af.load_lspc(path, -1)) != STATUS_OK)
+            return res;
+
+        const file_content_t *fc = af.pData;
+        if ((fc->nSampleRate != sample_rate) ||
+            (fc->nSampleRate != BE_TO_CPU(rs.sample_rate)) ||
+            (fc->nChannels != BE_TO_CPU(rs.channels)) ||
+            (fc->nSamples != BE_TO_CPU(rs.frames)) ||
+            (content_checksum(fc) != BE_TO_CPU(rs.checksum)))
+            return STATUS_CORRUPTED_FILE;
+
+        ::swap(pData, af.pData);
+        return STATUS_OK;
+    }
+
+    status_t AudioFile::load_resampled(const LSPString *path, size_t sample_rate, float max_duration)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+
+        // Try to load resampled data from cache
+        io::Path cache;
+        bool cached = (resample_cache_path(&cache, path, sample_rate, max_duration) == STATUS_OK);
+        if ((cached) && (cache.exists()))
+        {
+            if (load_resample_cache(cache.as_string(), sample_rate) == STATUS_OK)
+                return STATUS_OK;
+
+            // Drop the damaged cache entry
+            lsp_trace("Dropping invalid cache entry %s", cache.as_native());
+            io::File::remove(&cache);
+        }
+
+        // Load and resample the original file
+        status_t res = load(path, max_duration);
+        if ((res != STATUS_OK) || (pData->nSampleRate == sample_rate))
+            return res;
+        if ((res = resample(sample_rate)) != STATUS_OK)
+            return res;
+
+        // Store resampled data to the cache, errors are not critical
+        if (cached)
+        {
+            res = store_lspc(cache.as_string());
+            if (res == STATUS_OK)
+                trim_resample_cache(&cache);
+            else
+            {
+                lsp_trace("Could not store cache entry %s: code=%d", cache.as_native(), int(res));
+            }
+        }
+
+        return STATUS_OK;
+    }
+
+    typedef struct cache_entry_t
+    {
+        wsize_t     nTime;          // Time of the last use in milliseconds
+        wsize_t     nSize;          // Size of the entry in bytes
+        io::Path   *pPath;          // Full path to the entry
+    } cache_entry_t;
+
+    static int cmp_cache_entries(const void *a, const void *b)
+    {
+        const cache_entry_t *ea = reinterpret_cast<const cache_entry_t *>(a);
+        const cache_entry_t *eb = reinterpret_cast<const cache_entry_t *>(b);
+        return (ea->nTime < eb->nTime) ? -1 : (ea->nTime > eb->nTime) ? 1 : 0;
+    }
+
+    void AudioFile::trim_resample_cache(const io::Path *entry)
+    {
+        io::Path dir;
+        io::fattr_t fattr;
+        if ((entry->get_parent(&dir) != STATUS_OK) || (io::File::stat(entry, &fattr) != STATUS_OK))
+            return;
+
+        // The age of entries is measured relative to the entry just stored: this
+        // does not depend on the time base the file system uses for timestamps
+        wsize_t now         = lsp_max(fattr.mtime, fattr.atime);
+
+        LSPString ext;
+        io::Dir d;
+        if ((!ext.set_ascii(".lspc")) || (d.open(&dir) != STATUS_OK))
+            return;
+
+        // Collect all cache entries, the access time is used when the file system tracks it
+        cstorage<cache_entry_t> list;
+        wsize_t total       = 0;
+        io::Path *path      = new io::Path();
+        while ((path != NULL) && (d.reads(path, &fattr, true) == STATUS_OK))
+        {
+            if ((fattr.type != io::fattr_t::FT_REGULAR) || (!path->as_string()->ends_with(&ext)))
+                continue;
+
+            cache_entry_t *e    = list.add();
+            if (e == NULL)
+                break;
+            e->nTime            = lsp_max(fattr.mtime, fattr.atime);
+            e->nSize            = fattr.size;
+            e->pPath            = path;
+            total              += fattr.size;
+            path                = new io::Path();
+        }
+        d.close();
+        if (path != NULL)
+            delete path;
+
+        // Remove the least recently used entries until the cache fits the limits
+        ::qsort(list.get_array(), list.size(), sizeof(cache_entry_t), cmp_cache_entries);
+        for (size_t i=0, n=list.size(); i<n; ++i)
+        {
+            cache_entry_t *e    = list.at(i);
+            bool expired        = (e->nTime + RESAMPLING_CACHE_AGE) < now;
+            if (((expired) || (total > RESAMPLING_CACHE_SIZE)) && (!e->pPath->equals(entry)))
+            {
+                lsp_trace("Dropping cache entry %s", e->pPath->as_native());
+                if (io::File::remove(e->pPath) == STATUS_OK)
+                    total      -= e->nSize;
+            }
+            delete e->pPath;
+        }
+        list.flush();
+    }
+
+    status_t AudioFile::resample_cache_dir(io::Path *dst)
+    {
+        status_t res;
+
+    #ifdef PLATFORM_WINDOWS
+        // The temporary directory is private to the user
+        if ((res = system::get_temporary_dir(dst)) != STATUS_OK)
+            return res;
+        if ((res = dst->append_child(RESAMPLING_CACHE_DIR)) != STATUS_OK)
+            return res;
+        return dst->mkdir(true);
+    #else
+        // Use the cache directory of the user, the temporary directory is shared
+        LSPString xdg;
+        if ((system::get_env_var("XDG_CACHE_HOME", &xdg) == STATUS_OK) && (xdg.length() > 0))
+            res     = dst->set(&xdg);
+        else if ((res = system::get_home_directory(dst)) == STATUS_OK)
+            res     = dst->append_child(".cache");
+        if (res != STATUS_OK)
+            return res;
+        if (!dst->is_absolute())
+            return STATUS_BAD_PATH;
+        if ((res = dst->mkdir(true)) != STATUS_OK)
+            return res;
+        if ((res = dst->append_child(RESAMPLING_CACHE_DIR)) != STATUS_OK)
+            return res;
+
+        // The cache directory should be owned and accessible by the user only
+        const char *native  = dst->as_native();
+        if ((::mkdir(native, 0700) != 0) && (errno != EEXIST))
+            return STATUS_IO_ERROR;
+
+        struct stat st;
+        if (::lstat(native, &st) != 0)
+            return STATUS_IO_ERROR;
+        if ((!S_ISDIR(st.st_mode)) || (st.st_uid != ::geteuid()))
+            return STATUS_PERMISSION_DENIED;
+        if (((st.st_mode & 0077) != 0) && (::chmod(native, 0700) != 0))
+            return STATUS_PERMISSION_DENIED;
+
+        return STATUS_OK;
+    #endif /* PLATFORM_WINDOWS */
+    }
+
+    status_t AudioFile::resample_cache_path(io::Path *dst, const LSPString *path, size_t sample_rate, float max_duration)
+    {
+        // The cache entry is identified by the file path, its attributes and resampling parameters
+        io::fattr_t attr;
+        status_t res = io::File::stat(path, &attr);
+        if (res != STATUS_OK)
+            return res;
+
+        io::Path src;
+        if ((res = src.set(path)) != STATUS_OK)
+            return res;
+        if ((res = src.canonicalize()) != STATUS_OK)
+            return res;
+
+        uint64_t srate      = sample_rate;
+        uint64_t hash       = 0xcbf29ce484222325ULL;
+        hash                = fnv1a_hash(hash, src.as_utf8(), strlen(src.as_utf8()));
+        hash                = fnv1a_hash(hash, &attr.size, sizeof(attr.size));
+        hash                = fnv1a_hash(hash, &attr.mtime, sizeof(attr.mtime));
+        hash                = fnv1a_hash(hash, &srate, sizeof(srate));
+        hash                = fnv1a_hash(hash, &max_duration, sizeof(max_duration));
+
+        // Ensure that cache directory exists
+        io::Path dir;
+        if ((res = resample_cache_dir(&dir)) != STATUS_OK)
+            return res;
+
+        LSPString name;
+        if (!name.fmt_ascii("%016llx.lspc", (unsigned long long)(hash)))
+            return STATUS_NO_MEM;
+
+        return dst->set(&dir, &name);
+    }
+
+    status_t AudioFile::store_lspc(const LSPString *path)
+    {
+        if (pData == NULL)
+            return STATUS_NO_DATA;
+
+        // Write data to the temporary file first to not to expose partially written file
+        LSPString tmp;
+        if (!tmp.set(path))
+            return STATUS_NO_MEM;
+        if (!tmp.fmt_append_ascii(".%p.tmp", this))
+            return STATUS_NO_MEM;
+
+        LSPCFile fd;
+        status_t res = fd.create(&tmp);
+        if (res != STATUS_OK)
+            return res;
+
+        lspc_audio_parameters_t p;
+        p.channels          = pData->nChannels;
+        #ifdef ARCH_LE
+            p.sample_format     = LSPC_SAMPLE_FMT_F32LE;
+        #else
+            p.sample_format     = LSPC_SAMPLE_FMT_F32BE;
+        #endif /* ARCH_LE */
+        p.sample_rate       = pData->nSampleRate;
+        p.codec             = LSPC_CODEC_PCM;
+        p.frames            = pData->nSamples;
+
+        LSPCAudioWriter aw;
+        res = aw.open(&fd, &p);
+        if (res == STATUS_OK)
+            res = aw.write_samples(const_cast<const float **>(pData->vChannels), pData->nSamples);
+
+        uint32_t chunk_id = aw.unique_id();
+        status_t res2 = aw.close();
+        if (res == STATUS_OK)
+            res = res2;
+
+        // Write the description of the data used to validate the cache entry
+        if (res == STATUS_OK)
+        {
+            LSPCChunkWriter *wr = fd.write_chunk(LSPC_CHUNK_RESAMPLE);
+            if (wr != NULL)
+            {
+                lspc_chunk_resample_t rs;
+                ::memset(&rs, 0, sizeof(rs));
+                rs.common.version       = 1;
+                rs.common.size          = sizeof(lspc_chunk_resample_t);
+                rs.channels             = CPU_TO_BE(uint32_t(pData->nChannels));
+                rs.sample_rate          = CPU_TO_BE(uint32_t(pData->nSampleRate));
+                rs.frames               = CPU_TO_BE(uint64_t(pData->nSamples));
+                rs.checksum             = CPU_TO_BE(content_checksum(pData));
+
+                res     = wr->write_header(&rs);
+                res2    = wr->close();
+                if (res == STATUS_OK)
+                    res = res2;
+                delete wr;
+            }
+            else
+                res     = STATUS_NO_MEM;
+        }
+
+        // Write profile with zero skip, otherwise the audio data is treated as an impulse response
+        if (res == STATUS_OK)
+        {
+            LSPCChunkWriter *wr = fd.write_chunk(LSPC_CHUNK_PROFILE);
+            if (wr != NULL)
+            {
+                lspc_chunk_audio_profile_t prof;
+                ::memset(&prof, 0, sizeof(prof));
+                prof.common.version     = 2;
+                prof.common.size        = sizeof(lspc_chunk_audio_profile_t);
+                prof.chunk_id           = CPU_TO_BE(chunk_id);
+                prof.skip               = 0;
+
+                res     = wr->write_header(&prof);
+                res2    = wr->close();
+                if (res == STATUS_OK)
+                    res = res2;
+                delete wr;
+            }
+            else
+                res     = STATUS_NO_MEM;
+        }
+
+        res2 = fd.close();
+        if (res == STATUS_OK)
+            res = res2;
+
+        // Commit the file
+        if (res == STATUS_OK)
+            res = io::File::rename(&tmp, path);
+        if (res != STATUS_OK)
+            io::File::remove(&tmp);
+
+        return res;
+    }
+
     status_t AudioFile::store_samples(const io::Path *path, size_t from, size_t max_count) {
         if (path == NULL)
             return STATUS_BAD_ARGUMENTS;
@@ -759,50 +1149,50 @@ namespace lsp
     }
 
     status_t AudioFile::fast_upsample(size_t new_sample_rate)
+    {
+        // Integer ratio is a case of complex upsampling with a single kernel phase
+        return complex_upsample(new_sample_rate);
+    }
+
+    status_t AudioFile::complex_upsample(size_t new_sample_rate)
     {
         // Calculate parameters of transformation
-        ssize_t kf          = new_sample_rate / pData->nSampleRate;
-        float rkf           = 1.0f / kf;
+        float kf            = float(new_sample_rate) / float(pData->nSampleRate);
 
-        // Prepare kernel for resampling
-        ssize_t k_periods   = RESAMPLING_PERIODS; // * (kf >> 1);
+        // Prepare kernel parameters
+        ssize_t k_periods   = RESAMPLING_PERIODS; // Number of periods
         ssize_t k_base      = k_periods * kf;
         ssize_t k_center    = k_base + 1;
-        ssize_t k_len       = (k_center << 1) + 1;
+        ssize_t k_len       = (k_center << 1) + 1; // Centered impulse response
         ssize_t k_size      = ALIGN_SIZE(k_len + 1, 4); // Additional sample for time offset
-        float *k            = lsp_tmalloc(float, k_size);
-        if (k == NULL)
-            return STATUS_NO_MEM;
 
-        // Prepare temporary buffer for resampling
-        size_t new_samples  = kf * pData->nSamples;
-        size_t b_len        = new_samples + k_size;
-        size_t b_size       = ALIGN_SIZE(b_len, 4);
-        float *b            = lsp_tmalloc(float, b_size);
-        if (b == NULL)
-        {
-            lsp_free(k);
-            return STATUS_NO_MEM;
-        }
+        return lanczos_resample(new_sample_rate, k_periods, k_center, k_size);
+    }
 
-        // Prepare new data structure to store resampled data
-        file_content_t *fc  = create_file_content(pData->nChannels, new_samples);
-        if (fc == NULL)
-        {
-            lsp_free(b);
-            lsp_free(k);
-            return STATUS_NO_MEM;
-        }
-        fc->nSampleRate     = new_sample_rate;
+    status_t AudioFile::complex_downsample(size_t new_sample_rate)
+    {
+        // Calculate parameters of transformation
+        float rkf           = float(pData->nSampleRate) / float(new_sample_rate);
+
+        // Prepare kernel parameters
+        ssize_t k_base      = RESAMPLING_PERIODS;
+        ssize_t k_periods   = k_base * rkf; // Number of periods
+        ssize_t k_center    = k_base + 1;
+        ssize_t k_len       = (k_center << 1) + rkf + 1; // Centered impulse response
+        ssize_t k_size      = ALIGN_SIZE(k_len + 1, 4); // Additional sample for time offset
+
+        return lanczos_resample(new_sample_rate, k_periods, k_center, k_size);
+    }
 
-        // Generate Lanczos kernel
+    static void lanczos_kernel(float *k, ssize_t k_size, ssize_t k_center, ssize_t k_periods, float dt, float rkf)
+    {
         for (ssize_t j=0; j<k_size; ++j)
         {
-            float t         = (j - k_center) * rkf;
+            float t         = (j - k_center - dt) * rkf;
 
             if ((t > -k_periods) && (t < k_periods))
             {
-                if (t != 0)
+                if (t != 0.0f)
                 {
                     float t2    = M_PI * t;
                     k[j]        = k_periods * sinf(t2) * sinf(t2 / k_periods) / (t2 * t2);
@@ -813,147 +1203,74 @@ namespace lsp
             else
                 k[j]        = 0.0f;
         }
+    }
 
-        // Output dump
-//        printf("----------------------\n");
-//        printf("j;t;k(j);\n");
-//        for (ssize_t j=0; j<k_len; ++j)
-//        {
-//            float t         = (j - k_center) * rkf;
-//            printf("%d;%f;%f;\n", int(j), t, k[j]);
-//        }
-//        printf("----------------------\n");
-
-        // Iterate each channel
-        for (size_t c=0; c<fc->nChannels; ++c)
+    void AudioFile::resample_blocks(const resampler_t *r, size_t first, size_t last)
+    {
+        // Each block of src_step input samples is mapped to dst_step output samples,
+        // the input sample #i of the block is convolved with the kernel of phase #i
+        for (size_t i=0; i<r->nSrcStep; ++i)
         {
-            const float *src    = pData->vChannels[c];
-            dsp::fill_zero(b, b_size);  // Clear the temporary buffer
-
-            // Perform convolutions
-            for (size_t i=0, p=0; i<pData->nSamples; i++, p += kf)
-                dsp::fmadd_k3(&b[p], k, src[i], k_size);
+            const float *k  = &r->vKernels[i * r->nKSize];
+            size_t j        = first * r->nSrcStep + i;
+            ssize_t p       = first * r->nDstStep + ssize_t(r->fKf * i);
 
-            // Copy the data to the file content
-            dsp::copy(fc->vChannels[c], &b[k_center], fc->nSamples);
+            for (size_t m=first; (m < last) && (j < r->nSamples); ++m)
+            {
+                dsp::fmadd_k3(&r->vBuf[p], k, r->vSrc[j], r->nKSize);
+                j              += r->nSrcStep;
+                p              += r->nDstStep;
+            }
         }
+    }
 
-        // Delete  temporary buffers
-        destroy_file_content(pData);
-        lsp_free(b);
-        lsp_free(k);
+    status_t AudioFile::resample_task(void *arg)
+    {
+        resample_task_t *t  = reinterpret_cast<resample_task_t *>(arg);
 
-        // Store new file content
-        pData       = fc;
+        dsp::context_t ctx;
+        dsp::start(&ctx);
+        resample_blocks(t->pResampler, t->nFirst, t->nLast);
+        dsp::finish(&ctx);
 
         return STATUS_OK;
     }
 
-    status_t AudioFile::complex_upsample(size_t new_sample_rate)
+    void AudioFile::resample_parallel(resample_task_t *tasks, size_t count)
     {
-        // Calculate parameters of transformation
-        ssize_t gcd         = gcd_euclid(new_sample_rate, pData->nSampleRate);
-        ssize_t src_step    = pData->nSampleRate / gcd;
-        ssize_t dst_step    = new_sample_rate / gcd;
-        float kf            = float(dst_step) / float(src_step);
-        float rkf           = float(src_step) / float(dst_step);
+        ipc::Thread *threads[RESAMPLING_WORKERS_MAX];
 
-        // Prepare kernel for resampling
-        ssize_t k_periods   = RESAMPLING_PERIODS; // Number of periods
-        ssize_t k_base      = k_periods * kf;
-        ssize_t k_center    = k_base + 1;
-        ssize_t k_len       = (k_center << 1) + 1; // Centered impulse response
-        ssize_t k_size      = ALIGN_SIZE(k_len + 1, 4); // Additional sample for time offset
-        float *k            = lsp_tmalloc(float, k_size);
-        if (k == NULL)
-            return STATUS_NO_MEM;
-
-        // Prepare temporary buffer for resampling
-        size_t new_samples  = kf * pData->nSamples;
-        size_t b_len        = new_samples + k_size;
-        size_t b_size       = ALIGN_SIZE(b_len, 4);
-        float *b            = lsp_tmalloc(float, b_size);
-        if (b == NULL)
-        {
-            lsp_free(k);
-            return STATUS_NO_MEM;
-        }
-
-        // Prepare new data structure to store resampled data
-        file_content_t *fc  = create_file_content(pData->nChannels, new_samples);
-        if (fc == NULL)
+        // Tasks with the same parity never overlap in the output buffer,
+        // so each pass launches all tasks of the same parity simultaneously
+        for (size_t pass=0; pass<2; ++pass)
         {
-            lsp_free(b);
-            lsp_free(k);
-            return STATUS_NO_MEM;
-        }
-        fc->nSampleRate     = new_sample_rate;
-
-        // Iterate each channel
-        for (size_t c=0; c<fc->nChannels; ++c)
-        {
-            const float *src    = pData->vChannels[c];
-            dsp::fill_zero(b, b_size);  // Clear the temporary buffer
-
-            for (ssize_t i=0; i<src_step; ++i)
+            size_t n_threads    = 0;
+            for (size_t i=pass; i<count; i += 2)
             {
-                // calculate the offset between nearest samples
-                ssize_t p       = kf * i;
-                float dt        = i*kf - p;
-
-                // Generate Lanczos kernel
-                for (ssize_t j=0; j<k_size; ++j)
+                // Process the last task of the pass in the current thread
+                ipc::Thread *t      = ((i + 2) < count) ? new ipc::Thread(resample_task, &tasks[i]) : NULL;
+                if ((t != NULL) && (t->start() != STATUS_OK))
                 {
-                    float t         = (j - k_center - dt) * rkf;
-
-                    if ((t > -k_periods) && (t < k_periods))
-                    {
-                        if (t != 0.0f)
-                        {
-                            float t2    = M_PI * t;
-                            k[j]        = k_periods * sinf(t2) * sinf(t2 / k_periods) / (t2 * t2);
-                        }
-                        else
-                            k[j]        = 1.0f;
-                    }
-                    else
-                        k[j]        = 0.0f;
+                    delete t;
+                    t                   = NULL;
                 }
 
-                // Output dump
-//                printf("----------------------\n");
-//                printf("j;t;k(j);\n");
-//                for (ssize_t j=0; j<k_len; ++j)
-//                {
-//                    float t         = (j - k_center - dt) * kt;
-//                    printf("%d;%f;%f;\n", int(j), t, k[j]);
-//                }
-//                printf("----------------------\n");
-
-                // Perform convolutions
-                for (size_t j=i; j<pData->nSamples; j += src_step)
-                {
-                    dsp::fmadd_k3(&b[p], k, src[j], k_size);
-                    p   += dst_step;
-                }
+                if (t != NULL)
+                    threads[n_threads++]    = t;
+                else
+                    resample_blocks(tasks[i].pResampler, tasks[i].nFirst, tasks[i].nLast);
             }
 
-            // Copy the data to the file content
-            dsp::copy(fc->vChannels[c], &b[k_center], fc->nSamples);
+            // Wait for all threads
+            for (size_t i=0; i<n_threads; ++i)
+            {
+                threads[i]->join();
+                delete threads[i];
+            }
         }
-
-        // Delete  temporary buffers
-        destroy_file_content(pData);
-        lsp_free(b);
-        lsp_free(k);
-
-        // Store new file content
-        pData       = fc;
-
-        return STATUS_OK;
     }
 
-    status_t AudioFile::complex_downsample(size_t new_sample_rate)
+    status_t AudioFile::lanczos_resample(size_t new_sample_rate, ssize_t k_periods, ssize_t k_center, ssize_t k_size)
     {
         // Calculate parameters of transformation
         ssize_t gcd         = gcd_euclid(new_sample_rate, pData->nSampleRate);
@@ -962,13 +1279,8 @@ namespace lsp
         float kf            = float(dst_step) / float(src_step);
         float rkf           = float(src_step) / float(dst_step);
 
-        // Prepare kernel for resampling
-        ssize_t k_base      = RESAMPLING_PERIODS;
-        ssize_t k_periods   = k_base * rkf; // Number of periods
-        ssize_t k_center    = k_base + 1;
-        ssize_t k_len       = (k_center << 1) + rkf + 1; // Centered impulse response
-        ssize_t k_size      = ALIGN_SIZE(k_len + 1, 4); // Additional sample for time offset
-        float *k            = lsp_tmalloc(float, k_size);
+        // Prepare kernels for all phases of resampling
+        float *k            = lsp_tmalloc(float, k_size * src_step);
         if (k == NULL)
             return STATUS_NO_MEM;
 
@@ -993,54 +1305,56 @@ namespace lsp
         }
         fc->nSampleRate     = new_sample_rate;
 
-        // Iterate each channel
-        for (size_t c=0; c<fc->nChannels; ++c)
+        // Generate Lanczos kernels
+        for (ssize_t i=0; i<src_step; ++i)
         {
-            const float *src    = pData->vChannels[c];
-            dsp::fill_zero(b, b_size);  // Clear the temporary buffer
+            // calculate the offset between nearest samples
+            ssize_t p       = kf * i;
+            float dt        = i*kf - p; // Always positive, in range of [0..1]
 
-            for (ssize_t i=0; i<src_step; ++i)
-            {
-                // calculate the offset between nearest samples
-                ssize_t p       = kf * i;
-                float dt        = i*kf - p; // Always positive, in range of [0..1]
+            lanczos_kernel(&k[i * k_size], k_size, k_center, k_periods, dt, rkf);
+        }
 
-                // Generate Lanczos kernel
-                for (ssize_t j=0; j<k_size; ++j)
-                {
-                    float t         = (j - k_center - dt) * rkf;
+        // Split the input into tasks. The output of each task overlaps only with the
+        // output of the next task, so the length of the task should be enough to cover
+        // the overlapping area
+        resampler_t r;
+        r.vKernels          = k;
+        r.vBuf              = b;
+        r.vSrc              = NULL;
+        r.nSrcStep          = src_step;
+        r.nDstStep          = dst_step;
+        r.nKSize            = k_size;
+        r.nSamples          = pData->nSamples;
+        r.fKf               = kf;
 
-                    if ((t > -k_periods) && (t < k_periods))
-                    {
-                        if (t != 0.0f)
-                        {
-                            float t2    = M_PI * t;
-                            k[j]        = k_periods * sinf(t2) * sinf(t2 / k_periods) / (t2 * t2);
-                        }
-                        else
-                            k[j]        = 1.0f;
-                    }
-                    else
-                        k[j]        = 0.0f;
-                }
+        size_t blocks       = (pData->nSamples + src_step - 1) / src_step;
+        size_t overlap      = ssize_t(kf * (src_step - 1)) + k_size;
+        size_t min_blocks   = lsp_max(size_t((overlap + dst_step - 1) / dst_step), size_t((RESAMPLING_TASK_SIZE + src_step - 1) / src_step));
+        size_t workers      = lsp_min(ipc::Thread::system_cores(), size_t(RESAMPLING_WORKERS_MAX));
+        size_t n_tasks      = lsp_min(workers * 2, blocks / lsp_max(min_blocks, size_t(1)));
+        size_t task_blocks  = (n_tasks > 1) ? (blocks + n_tasks - 1) / n_tasks : blocks;
+        n_tasks             = (n_tasks > 1) ? (blocks + task_blocks - 1) / task_blocks : 1;
 
-                // Output dump
-//                printf("----------------------\n");
-//                printf("j;t;k(j);\n");
-//                for (ssize_t j=0; j<k_size; ++j)
-//                {
-//                    float t         = (j - k_center - dt) * kt;
-//                    printf("%d;%f;%f;\n", int(j), t, k[j]);
-//                }
-//                printf("----------------------\n");
-
-                // Perform convolutions
-                for (size_t j=i; j<pData->nSamples; j += src_step)
-                {
-                    dsp::fmadd_k3(&b[p], k, src[j], k_size);
-                    p   += dst_step;
-                }
-            }
+        resample_task_t tasks[RESAMPLING_WORKERS_MAX * 2];
+        for (size_t i=0; i<n_tasks; ++i)
+        {
+            tasks[i].pResampler = &r;
+            tasks[i].nFirst     = i * task_blocks;
+            tasks[i].nLast      = lsp_min((i + 1) * task_blocks, blocks);
+        }
+
+        // Iterate each channel
+        for (size_t c=0; c<fc->nChannels; ++c)
+        {
+            r.vSrc              = pData->vChannels[c];
+            dsp::fill_zero(b, b_size);  // Clear the temporary buffer
+
+            // Perform convolutions
+            if (n_tasks > 1)
+                resample_parallel(tasks, n_tasks);
+            else
+                resample_blocks(&r, 0, blocks);
 
             // Copy the data to the file content
             dsp::copy(fc->vChannels[c], &b[k_center], fc->nSamples);
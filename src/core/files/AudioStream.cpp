@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <core/types.h>
+#include <core/debug.h>
+#include <core/files/AudioStream.h>
+
+#ifndef PLATFORM_WINDOWS
+    #include <sndfile.h>
+#endif /* PLATFORM_WINDOWS */
+
+namespace lsp
+{
+    AudioStream::AudioStream()
+    {
+        hHandle         = NULL;
+        nChannels       = 0;
+        nSamples        = 0;
+        nSampleRate     = 0;
+        nOffset         = 0;
+    }
+
+    AudioStream::~AudioStream()
+    {
+        close();
+    }
+
+    status_t AudioStream::open(const char *path)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+
+        LSPString spath;
+        if (!spath.set_utf8(path))
+            return STATUS_NO_MEM;
+        return open(&spath);
+    }
+
+    status_t AudioStream::open(const io::Path *path)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+        return open(path->as_string());
+    }
+
+#ifdef PLATFORM_WINDOWS
+    status_t AudioStream::open(const LSPString *path)
+    {
+        // Random-access decoding is not implemented for MMIO/MFAPI backends yet
+        return STATUS_NOT_SUPPORTED;
+    }
+
+    status_t AudioStream::close()
+    {
+        hHandle         = NULL;
+        nChannels       = 0;
+        nSamples        = 0;
+        nSampleRate     = 0;
+        nOffset         = 0;
+        return STATUS_OK;
+    }
+
+    ssize_t AudioStream::read_frames(float *dst, size_t offset, size_t frames)
+    {
+        return -STATUS_CLOSED;
+    }
+#else
+    static status_t decode_sf_status(SNDFILE *fd)
+    {
+        switch (sf_error(fd))
+        {
+            case SF_ERR_NO_ERROR:
+                return STATUS_OK;
+            case SF_ERR_UNRECOGNISED_FORMAT:
+                return STATUS_BAD_FORMAT;
+            case SF_ERR_MALFORMED_FILE:
+                return STATUS_CORRUPTED_FILE;
+            case SF_ERR_UNSUPPORTED_ENCODING:
+                return STATUS_BAD_FORMAT;
+            default:
+                return STATUS_UNKNOWN_ERR;
+        }
+    }
+
+    status_t AudioStream::open(const LSPString *path)
+    {
+        if (path == NULL)
+            return STATUS_BAD_ARGUMENTS;
+        if (hHandle != NULL)
+            return STATUS_OPENED;
+
+        SF_INFO sf_info;
+        SNDFILE *sf_obj = sf_open(path->get_native(), SFM_READ, &sf_info);
+        if (sf_obj == NULL)
+            return decode_sf_status(NULL);
+
+        // Streaming requires random access to the file
+        if (!sf_info.seekable)
+        {
+            sf_close(sf_obj);
+            return STATUS_NOT_SUPPORTED;
+        }
+
+        lsp_trace("opened stream: %s, frames=%d, channels=%d, sample_rate=%d",
+                path->get_native(), int(sf_info.frames), int(sf_info.channels), int(sf_info.samplerate));
+
+        hHandle         = sf_obj;
+        nChannels       = sf_info.channels;
+        nSamples        = sf_info.frames;
+        nSampleRate     = sf_info.samplerate;
+        nOffset         = 0;
+
+        return STATUS_OK;
+    }
+
+    status_t AudioStream::close()
+    {
+        status_t res    = STATUS_OK;
+        if (hHandle != NULL)
+        {
+            if (sf_close(reinterpret_cast<SNDFILE *>(hHandle)) != 0)
+                res             = STATUS_IO_ERROR;
+            hHandle         = NULL;
+        }
+
+        nChannels       = 0;
+        nSamples        = 0;
+        nSampleRate     = 0;
+        nOffset         = 0;
+
+        return res;
+    }
+
+    ssize_t AudioStream::read_frames(float *dst, size_t offset, size_t frames)
+    {
+        SNDFILE *sf_obj = reinterpret_cast<SNDFILE *>(hHandle);
+        if (sf_obj == NULL)
+            return -STATUS_CLOSED;
+        if (offset >= nSamples)
+            return 0;
+        if (frames > (nSamples - offset))
+            frames          = nSamples - offset;
+
+        // Seek only when reading is not sequential
+        if (offset != nOffset)
+        {
+            if (sf_seek(sf_obj, offset, SEEK_SET) < 0)
+                return -STATUS_IO_ERROR;
+            nOffset         = offset;
+        }
+
+        sf_count_t amount   = sf_readf_float(sf_obj, dst, frames);
+        if (amount <= 0)
+        {
+            status_t res        = decode_sf_status(sf_obj);
+            return (res == STATUS_OK) ? -STATUS_EOF : -res;
+        }
+
+        nOffset        += amount;
+        return amount;
+    }
+#endif /* PLATFORM_WINDOWS */
+
+} /* namespace lsp */
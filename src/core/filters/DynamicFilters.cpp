@@ -49,10 +49,12 @@ namespace lsp
     {
         vFilters        = NULL;
         vMemory         = NULL;
+        vMemoryD        = NULL;
         vCascades       = NULL;
         vBiquads.ptr    = NULL;
         nFilters        = 0;
         nSampleRate     = 0;
+        nMaxCascades    = BLD_BUF_SIZE;
         pData           = NULL;
         bClearMem       = false;
     }
@@ -62,10 +64,11 @@ namespace lsp
         // Determine how many bytes to allocate
         size_t b_per_filter_t       = ALIGN_SIZE(sizeof(filter_t) * filters, ALIGN64);
         size_t b_per_memory         = FILTER_CHAINS_MAX * 2 * filters * sizeof(float);
+        size_t b_per_memory_d       = ALIGN_SIZE(FILTER_CHAINS_MAX * 2 * filters * sizeof(double), ALIGN64);
         size_t b_per_cascades       = ALIGN_SIZE(BLD_BUF_SIZE * (BUF_SIZE + BLD_BUF_SIZE) * sizeof(f_cascade_t), ALIGN64);
         size_t b_per_biquad         = sizeof(biquad_x8_t) * (BUF_SIZE + BLD_BUF_SIZE);
 
-        size_t to_alloc             = b_per_filter_t + b_per_memory + b_per_cascades + b_per_biquad;
+        size_t to_alloc             = b_per_filter_t + b_per_memory + b_per_memory_d + b_per_cascades + b_per_biquad;
 
         // Allocate memory
         uint8_t *ptr                = alloc_aligned<uint8_t>(pData, to_alloc, ALIGN64);
@@ -77,6 +80,8 @@ namespace lsp
         ptr            += b_per_filter_t;
         vMemory         = reinterpret_cast<float *>(ptr);
         ptr            += b_per_memory;
+        vMemoryD        = reinterpret_cast<double *>(ptr);
+        ptr            += b_per_memory_d;
         vCascades       = reinterpret_cast<f_cascade_t *>(ptr);
         ptr            += b_per_cascades;
         vBiquads.ptr    = ptr;
@@ -95,10 +100,13 @@ namespace lsp
             fp->nSlope      = 0;
             fp->fQuality    = 0.0f;
             f->bActive      = false;
+            f->bPrecise     = false;
         }
 
         // Cleanup filter memory
         dsp::fill_zero(vMemory, FILTER_CHAINS_MAX * 2 * filters);
+        for (size_t i=0, n=FILTER_CHAINS_MAX * 2 * filters; i<n; ++i)
+            vMemoryD[i]     = 0.0;
 
         return STATUS_OK;
     }
@@ -116,6 +124,32 @@ namespace lsp
         nSampleRate         = sr;
     }
 
+    bool DynamicFilters::set_filter_precise(size_t id, bool precise)
+    {
+        if (id >= nFilters)
+            return false;
+
+        filter_t *f     = &vFilters[id];
+        if (f->bPrecise == precise)
+            return true;
+
+        // Memory layouts of single and double precision differ, start from silence
+        f->bPrecise     = precise;
+        float *fmem     = &vMemory[id * FILTER_CHAINS_MAX * 2];
+        double *dmem    = &vMemoryD[id * FILTER_CHAINS_MAX * 2];
+        dsp::fill_zero(fmem, FILTER_CHAINS_MAX * 2);
+        for (size_t i=0; i<FILTER_CHAINS_MAX * 2; ++i)
+            dmem[i]         = 0.0;
+
+        return true;
+    }
+
+    void DynamicFilters::set_precise(bool precise)
+    {
+        for (size_t i=0; i<nFilters; ++i)
+            set_filter_precise(i, precise);
+    }
+
     bool DynamicFilters::set_params(size_t id, const filter_params_t *params)
     {
         if (id >= nFilters)
@@ -186,6 +220,8 @@ namespace lsp
         ssize_t n = nc - c;
         if (n <= 0)
             return 0;
+        if (n > ssize_t(nMaxCascades))
+            n = nMaxCascades;
 
         if (n >= 4)
             return (n >= 8) ? 8 : 4;
@@ -207,9 +243,16 @@ namespace lsp
         if (bClearMem)
         {
             dsp::fill_zero(vMemory, FILTER_CHAINS_MAX * 2 * nFilters);
+            for (size_t i=0, n=FILTER_CHAINS_MAX * 2 * nFilters; i<n; ++i)
+                vMemoryD[i]     = 0.0;
             bClearMem = false;
         }
 
+        // Double-precision filters are built and processed cascade by cascade
+        bool precise            = (f->bPrecise) && (f->sParams.nType & 1);
+        double kd               = (precise) ? 1.0/tan(f->sParams.fFreq * M_PI / double(nSampleRate)) : 0.0;
+        nMaxCascades            = (precise) ? 1 : BLD_BUF_SIZE;
+
         // Frequency coefficient for bilinear transform
         float kf =
                 (f->sParams.nType <= FLT_MT_AMPLIFIER) ? 0.95f :
@@ -223,6 +266,7 @@ namespace lsp
             // Initialize counter
             size_t to_process       = (samples > BUF_SIZE) ? BUF_SIZE : samples;
             float *fmem             = &vMemory[id * FILTER_CHAINS_MAX * 2];
+            double *dmem            = &vMemoryD[id * FILTER_CHAINS_MAX * 2];
             const float *src        = in;
             size_t cj               = 0;
 
@@ -286,6 +330,11 @@ namespace lsp
                         dsp::matched_transform_x2(vBiquads.x2, vCascades, f->sParams.fFreq, kf, to_process + 1);
                     dsp::dyn_biquad_process_x2(out, src, fmem, to_process, vBiquads.x2);
                 }
+                else if (precise)
+                {
+                    dsp::bilinear_transform_dx1(vBiquads.dx1, vCascades, kd, to_process);
+                    dsp::dyn_biquad_process_dx1(out, src, dmem, to_process, vBiquads.dx1);
+                }
                 else if (nj == 1)
                 {
                     if (f->sParams.nType & 1)
@@ -298,6 +347,7 @@ namespace lsp
                 // Update counters and pointers
                 cj                     += nj;
                 fmem                   += nj*2;
+                dmem                   += nj*2;
                 src                     = out;
             }
 
@@ -307,6 +357,8 @@ namespace lsp
             out                    += to_process;
             in                     += to_process;
         }
+
+        nMaxCascades            = BLD_BUF_SIZE;
     }
 
     size_t DynamicFilters::precalc_lrx_ladder_filter_bank(f_cascade_t *dst, const filter_params_t *fp, size_t cj, const float *sfg, size_t samples)
@@ -25,6 +25,7 @@
 #include <core/debug.h>
 
 #define BUFFER_SIZE         0x400U
+#define PARTITION_RANK      6
 
 namespace lsp
 {
@@ -49,11 +50,14 @@ namespace lsp
         nFirRank        = 0;
         nLatency        = 0;
         nBufSize        = 0;
+        nFdlHead        = 0;
         nMode           = EQM_BYPASS;
+        bLowLatency     = false;
         vInBuffer       = NULL;
         vOutBuffer      = NULL;
         vConv           = NULL;
         vFft            = NULL;
+        vFdl            = NULL;
         vTemp           = NULL;
         pData           = NULL;
         nFlags          = EF_REBUILD | EF_CLEAR;
@@ -84,7 +88,7 @@ namespace lsp
             size_t fft_size     = nFirSize << 1;
             size_t conv_size    = nFirSize << 2;
             size_t tmp_size     = lsp_max(conv_size, BUFFER_SIZE);
-            size_t allocate     = fft_size*2 + conv_size*2 + tmp_size + nFirSize;
+            size_t allocate     = fft_size*2 + conv_size*3 + tmp_size + nFirSize;
 
             float *ptr          = alloc_aligned<float>(pData, allocate);
             if (ptr == NULL)
@@ -104,6 +108,8 @@ namespace lsp
             ptr                += conv_size;            // nFirSize * 4
             vFft                = ptr;
             ptr                += conv_size;            // nFirSize * 4
+            vFdl                = ptr;
+            ptr                += conv_size;            // nFirSize * 4
             vTemp               = ptr;
             ptr                += tmp_size;             // nFirSize * 4
         }
@@ -124,6 +130,7 @@ namespace lsp
             vOutBuffer          = NULL;
             vConv               = NULL;
             vFft                = NULL;
+            vFdl                = NULL;
             vTemp               = ptr;
         }
 
@@ -141,6 +148,7 @@ namespace lsp
         nFlags              = EF_REBUILD | EF_CLEAR;
         nLatency            = 0;
         nBufSize            = 0;
+        nFdlHead            = 0;
 
         return true;
     }
@@ -163,6 +171,7 @@ namespace lsp
             vOutBuffer      = NULL;
             vConv           = NULL;
             vFft            = NULL;
+            vFdl            = NULL;
             vTemp           = NULL;
             pData           = NULL;
         }
@@ -292,10 +301,26 @@ namespace lsp
             windows::blackman_nuttall(vConv, nFirSize);                         // Compute the window function
             dsp::mul2(vTemp, vConv, nFirSize);                                  // Apply the window function
 
-            // Get the final impulse response data
-            dsp::fastconv_parse(vConv, vTemp, nFirRank + 1);                    // Get the IR function
+            if (partitioned())
+            {
+                // Split impulse response into the head for direct convolution and FFT partitions
+                size_t part_size    = 1 << PARTITION_RANK;
+                size_t parts        = nFirSize >> PARTITION_RANK;
+                size_t conv_size    = part_size << 2;
+
+                for (size_t i=1; i<parts; ++i)
+                    dsp::fastconv_parse(&vConv[(i-1) * conv_size], &vTemp[i * part_size], PARTITION_RANK + 1);
+                dsp::copy(&vConv[(parts-1) * conv_size], vTemp, part_size);
+
+                nLatency    = half_size;
+            }
+            else
+            {
+                // Get the final impulse response data
+                dsp::fastconv_parse(vConv, vTemp, nFirRank + 1);                // Get the IR function
 
-            nLatency    = nFirSize + half_size;
+                nLatency    = nFirSize + half_size;
+            }
         }
         else // EQM_SPM
         {
@@ -306,6 +331,29 @@ namespace lsp
         }
     }
 
+    bool Equalizer::partitioned() const
+    {
+        return (bLowLatency) && (nFirRank > PARTITION_RANK) && ((nMode == EQM_FIR) || (nMode == EQM_FFT));
+    }
+
+    void Equalizer::set_low_latency(bool enable)
+    {
+        if (enable == bLowLatency)
+            return;
+        bLowLatency = enable;
+        nFlags     |= EF_REBUILD | EF_CLEAR;
+
+        // Reset convolution state
+        if (nFirSize > 0)
+        {
+            dsp::fill_zero(vInBuffer, nFirSize << 1);
+            dsp::fill_zero(vOutBuffer, nFirSize << 1);
+            dsp::fill_zero(vFdl, nFirSize << 2);
+            nBufSize    = 0;
+            nFdlHead    = 0;
+        }
+    }
+
     void Equalizer::set_mode(equalizer_mode_t mode)
     {
         if (mode == nMode)
@@ -417,6 +465,37 @@ namespace lsp
             case EQM_FIR:
             case EQM_FFT:
             {
+                if (partitioned())
+                {
+                    size_t part_size    = 1 << PARTITION_RANK;
+                    size_t parts        = nFirSize >> PARTITION_RANK;
+                    const float *head   = &vConv[(parts-1) * (part_size << 2)];
+
+                    while (samples > 0)
+                    {
+                        if (nBufSize >= part_size)
+                        {
+                            process_partition();
+                            nBufSize    = 0; // Reset buffer size
+                        }
+
+                        // Determine number of samples to process
+                        size_t to_process = lsp_min(samples, part_size - nBufSize);
+
+                        // Push new data for processing, apply the head of impulse response and emit processed data
+                        dsp::copy(&vInBuffer[nBufSize], in, to_process);
+                        dsp::convolve(&vOutBuffer[nBufSize], in, head, part_size, to_process);
+                        dsp::copy(out, &vOutBuffer[nBufSize], to_process);
+
+                        // Update pointers and counters
+                        nBufSize       += to_process;
+                        out            += to_process;
+                        in             += to_process;
+                        samples        -= to_process;
+                    }
+                    break;
+                }
+
                 size_t conv_rank    = nFirRank + 1;
 
                 while (samples > 0)
@@ -497,6 +576,62 @@ namespace lsp
         }
     }
 
+    void Equalizer::process_partition()
+    {
+        size_t part_size    = 1 << PARTITION_RANK;
+        size_t parts        = (nFirSize >> PARTITION_RANK) - 1;
+        size_t conv_size    = part_size << 2;
+        float *acc          = vTemp;
+        float *buf          = &vTemp[conv_size];
+
+        // Store spectrum of the input block to the delay line
+        nFdlHead            = (nFdlHead + 1) % parts;
+        dsp::fastconv_parse(&vFdl[nFdlHead * conv_size], vInBuffer, PARTITION_RANK + 1);
+
+        // Shift output buffer
+        dsp::move(vOutBuffer, &vOutBuffer[part_size], part_size * 2);
+        dsp::fill_zero(&vOutBuffer[part_size * 2], part_size);
+
+        // Partition k is applied to the input block delayed by k-1 blocks,
+        // the result starts at the beginning of the next output block
+        dsp::fill_zero(acc, conv_size);
+        for (size_t i=0, k=nFdlHead; i<parts; ++i)
+        {
+            dsp::fastconv_fmadd(acc, &vFdl[k * conv_size], &vConv[i * conv_size], PARTITION_RANK + 1);
+            k                   = (k > 0) ? k - 1 : parts - 1;
+        }
+        dsp::fastconv_restore(buf, acc, PARTITION_RANK + 1);
+        dsp::add2(vOutBuffer, buf, part_size * 2);
+    }
+
+    void Equalizer::process(Equalizer *l, Equalizer *r, float *l_out, float *r_out, const float *l_in, const float *r_in, size_t samples)
+    {
+        if (l->nFlags != 0)
+            l->reconfigure();
+        if (r->nFlags != 0)
+            r->reconfigure();
+
+        if ((l->nMode != EQM_IIR) || (r->nMode != EQM_IIR))
+        {
+            l->process(l_out, l_in, samples);
+            r->process(r_out, r_in, samples);
+            return;
+        }
+
+        // Temporary buffer of the left equalizer holds interleaved frames
+        while (samples > 0)
+        {
+            size_t to_do    = lsp_min(samples, BUFFER_SIZE >> 1);
+            FilterBank::process(&l->sBank, &r->sBank, l_out, r_out, l_in, r_in, l->vTemp, to_do);
+
+            l_out          += to_do;
+            r_out          += to_do;
+            l_in           += to_do;
+            r_in           += to_do;
+            samples        -= to_do;
+        }
+    }
+
     void Equalizer::dump(IStateDumper *v) const
     {
         v->write_object("sBank", &sBank);
@@ -512,11 +647,14 @@ namespace lsp
         v->write("nFirRank", nFirRank);
         v->write("nLatency", nLatency);
         v->write("nBufSize", nBufSize);
+        v->write("nFdlHead", nFdlHead);
         v->write("nMode", nMode);
+        v->write("bLowLatency", bLowLatency);
         v->write("vInBuffer", vInBuffer);
         v->write("vOutBuffer", vOutBuffer);
         v->write("vConv", vConv);
         v->write("vFft", vFft);
+        v->write("vFdl", vFdl);
         v->write("vTemp", vTemp);
         v->write("nFlags", nFlags);
         v->write("pData", pData);
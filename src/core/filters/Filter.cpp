@@ -173,6 +173,12 @@ namespace lsp
         update(sr, &sParams);
     }
 
+    void Filter::set_precise(bool precise)
+    {
+        if (nFlags & FF_OWN_BANK)
+            pBank->set_precise(precise);
+    }
+
     void Filter::get_params(filter_params_t *params)
     {
         if (params != NULL)
@@ -1385,14 +1391,14 @@ namespace lsp
 
     void Filter::calc_apo_filter(size_t type, const filter_params_t *fp)
     {
-        float a0, a1, a2;
-        float b0, b1, b2;
+        double a0, a1, a2;
+        double b0, b1, b2;
 
-        float omega    = 2.0 * M_PI * fp->fFreq / float(nSampleRate);
-        float cs       = sinf(omega);
-        float cc       = cosf(omega); // Have to use trig functions for both to have correct sign
-        float Q        = (fp->fQuality > MIN_APO_Q) ? fp->fQuality : MIN_APO_Q;
-        float alpha    = 0.5 * cs / Q;
+        double omega    = 2.0 * M_PI * fp->fFreq / double(nSampleRate);
+        double cs       = sin(omega);
+        double cc       = cos(omega); // Have to use trig functions for both to have correct sign
+        double Q        = (fp->fQuality > MIN_APO_Q) ? fp->fQuality : MIN_APO_Q;
+        double alpha    = 0.5 * cs / Q;
 
         // In LSP convention, the b coefficients are in the denominator. The a coefficients are in the
         // numerator. This is opposite to the most usual convention.
@@ -1402,7 +1408,7 @@ namespace lsp
         {
             case FLT_DR_APO_LOPASS:
             {
-                float A     = fp->fGain;
+                double A    = fp->fGain;
 
                 a0 = A * 0.5 * (1.0 - cc);
                 a1 = A * (1.0 - cc);
@@ -1416,7 +1422,7 @@ namespace lsp
 
             case FLT_DR_APO_HIPASS:
             {
-                float A     = fp->fGain;
+                double A    = fp->fGain;
 
                 a0 = A * 0.5 * (1.0 + cc);
                 a1 = A * (-1.0 - cc);
@@ -1430,7 +1436,7 @@ namespace lsp
 
             case FLT_DR_APO_BANDPASS:
             {
-                float A     = fp->fGain;
+                double A    = fp->fGain;
 
                 a0 = A * alpha;
                 a1 = 0.0;
@@ -1444,7 +1450,7 @@ namespace lsp
 
             case FLT_DR_APO_NOTCH:
             {
-                float A     = fp->fGain;
+                double A    = fp->fGain;
 
                 a0 = A;
                 a1 = A * -2.0 * cc;
@@ -1458,7 +1464,7 @@ namespace lsp
 
             case FLT_DR_APO_ALLPASS:
             {
-                float A     = fp->fGain;
+                double A    = fp->fGain;
 
                 a0 = A * (1.0 - alpha);
                 a1 = A * -2.0 * cc;
@@ -1472,7 +1478,7 @@ namespace lsp
 
             case FLT_DR_APO_PEAKING:
             {
-                float A     = sqrtf(fp->fGain);
+                double A    = sqrt(fp->fGain);
 
                 a0 = 1.0 + alpha * A;
                 a1 = -2.0 * cc;
@@ -1486,8 +1492,8 @@ namespace lsp
 
             case FLT_DR_APO_LOSHELF:
             {
-                float A     = sqrtf(fp->fGain);
-                float beta  = 2.0 * alpha * sqrtf(A);
+                double A    = sqrt(fp->fGain);
+                double beta = 2.0 * alpha * sqrt(A);
 
                 a0 = A * ((A + 1.0) - (A - 1.0) * cc + beta);
                 a1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cc);
@@ -1501,8 +1507,8 @@ namespace lsp
 
             case FLT_DR_APO_HISHELF:
             {
-                float A     = sqrtf(fp->fGain);
-                float beta  = 2.0 * alpha * sqrtf(A);
+                double A    = sqrt(fp->fGain);
+                double beta = 2.0 * alpha * sqrt(A);
 
                 a0 = A * ((A + 1.0) + (A - 1.0) * cc + beta);
                 a1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cc);
@@ -1517,7 +1523,7 @@ namespace lsp
                 return;
         }
 
-        biquad_x1_t *f = pBank->add_chain();
+        biquad_dx1_t *f = pBank->add_chain();
         if (f == NULL)
             return;
 
@@ -1527,9 +1533,9 @@ namespace lsp
         f->b2   = a2 / b0;
         f->a1   = -b1 / b0;
         f->a2   = -b2 / b0;
-        f->p0   = 0.0f;
-        f->p1   = 0.0f;
-        f->p2   = 0.0f;
+        f->p0   = 0.0;
+        f->p1   = 0.0;
+        f->p2   = 0.0;
 
         // Storing the coefficient for plotting
         f_cascade_t *c  = add_cascade();
@@ -1576,9 +1582,9 @@ namespace lsp
 
     void Filter::bilinear_transform()
     {
-        float kf        = 1.0/tanf(sParams.fFreq * M_PI / float(nSampleRate));
-        float kf2       = kf * kf;
-        float T[4], B[4], N;
+        double kf       = 1.0/tan(sParams.fFreq * M_PI / double(nSampleRate));
+        double kf2      = kf * kf;
+        double T[4], B[4], N;
         size_t chains   = 0;
 
         for (size_t i=0; i<nItems; ++i)
@@ -1603,7 +1609,7 @@ namespace lsp
             // Initialize filter parameters
             if ((++chains) > FILTER_CHAINS_MAX)
                 break;
-            biquad_x1_t *f  = pBank->add_chain();
+            biquad_dx1_t *f = pBank->add_chain();
             if (f == NULL)
                 break;
 
@@ -1612,9 +1618,9 @@ namespace lsp
             f->b2           = (T[0] - T[1] + T[2]) * N;
             f->a1           = 2.0 * (B[2] - B[0]) * N; // Sign negated
             f->a2           = (B[1] - B[2] - B[0]) * N; // Sign negated
-            f->p0           = 0.0f;
-            f->p1           = 0.0f;
-            f->p2           = 0.0f;
+            f->p0           = 0.0;
+            f->p1           = 0.0;
+            f->p2           = 0.0;
         }
     }
 
@@ -1642,9 +1648,9 @@ namespace lsp
     */
     void Filter::matched_transform()
     {
-        float T[4], B[4], A[2], I[2];
-        float f         = sParams.fFreq;
-        float TD        = 2.0*M_PI / nSampleRate;
+        double T[4], B[4], A[2], I[2];
+        double f        = sParams.fFreq;
+        double TD       = 2.0*M_PI / nSampleRate;
         size_t chains   = 0;
 
         // Iterate each cascade
@@ -1656,7 +1662,7 @@ namespace lsp
             for (size_t i=0; i<2; ++i)
             {
                 float *p    = (i) ? c->b : c->t;
-                float *P    = (i) ? B : T;
+                double *P   = (i) ? B : T;
 
                 if (p[2] == 0.0) // Test polynom for second-order
                 {
@@ -1674,10 +1680,10 @@ namespace lsp
                         //
                         // Transformed polynom:
                         //   P[z] = p[1]/f - p[1]/f * exp(-f*p[0]*T/p[1]) * z^-1
-                        float k     = p[1]/f;
-                        float R     = -p[0]/k;
+                        double k    = p[1]/f;
+                        double R    = -p[0]/k;
                         P[0]        = k;
-                        P[1]        = -k * expf(R*TD);
+                        P[1]        = -k * exp(R*TD);
                     }
                 }
                 else
@@ -1686,35 +1692,35 @@ namespace lsp
                     //   p(s) = p[0] + p[1]*(s/f) + p[2]*(s/f)^2 = p[2]/f^2 * (p[0]*f^2/p[2] + p[1]*f/p[2]*s + s^2)
                     //
                     // Calculate the roots of the second-order polynom equation a*x^2 + b*x + c = 0
-                    float k     = p[2];
-                    float a     = 1.0/(f*f);
-                    float b     = p[1]/(f*p[2]);
-                    float c     = p[0]/p[2];
-                    float D     = b*b - 4.0*a*c;
+                    double k    = p[2];
+                    double a    = 1.0/(f*f);
+                    double b    = p[1]/(f*p[2]);
+                    double c    = p[0]/p[2];
+                    double D    = b*b - 4.0*a*c;
 
                     if (D >= 0)
                     {
                         // Has real roots R0 and R1
                         // Transformed form is:
                         //   P[z] = k*(1 - (exp(R0*T) + exp(R1*T))*z^-1 + exp((R0+R1)*T)*z^-2)
-                        D           = sqrtf(D);
-                        float R0    = (-b - D)/(2.0*a);
-                        float R1    = (-b + D)/(2.0*a);
+                        D           = sqrt(D);
+                        double R0   = (-b - D)/(2.0*a);
+                        double R1   = (-b + D)/(2.0*a);
                         P[0]        = k;
-                        P[1]        = -k * (expf(R0*TD) + expf(R1*TD));
-                        P[2]        = k * expf((R0+R1)*TD);
+                        P[1]        = -k * (exp(R0*TD) + exp(R1*TD));
+                        P[2]        = k * exp((R0+R1)*TD);
                     }
                     else
                     {
                         // Has complex roots R+j*K and R-j*K
                         // Transformed form is:
                         //   P[z] = k*(1 - 2*exp(R*T)*cos(K*T)*z^-1 + exp(2*R*T)*z^-2)
-                        D           = sqrtf(-D);
-                        float R     = -b / (2.0*a);
-                        float K     = D / (2.0*a);
+                        D           = sqrt(-D);
+                        double R    = -b / (2.0*a);
+                        double K    = D / (2.0*a);
                         P[0]        = k;
-                        P[1]        = -2.0 * k * expf(R*TD) * cosf(K*TD);
-                        P[2]        = k * expf(2.0*R*TD);
+                        P[1]        = -2.0 * k * exp(R*TD) * cos(K*TD);
+                        P[2]        = k * exp(2.0*R*TD);
                     }
                 }
 
@@ -1752,7 +1758,7 @@ namespace lsp
             // Initialize filter parameters
             if ((++chains) > FILTER_CHAINS_MAX)
                 break;
-            biquad_x1_t *f  = pBank->add_chain();
+            biquad_dx1_t *f = pBank->add_chain();
             if (f == NULL)
                 break;
 
@@ -1761,9 +1767,9 @@ namespace lsp
             f->b2           = T[2] * N * AN;
             f->a1           = -B[1] * N; // Sign negated
             f->a2           = -B[2] * N; // Sign negated
-            f->p0           = 0.0f;
-            f->p1           = 0.0f;
-            f->p2           = 0.0f;
+            f->p0           = 0.0;
+            f->p1           = 0.0;
+            f->p2           = 0.0;
         }
     }
 
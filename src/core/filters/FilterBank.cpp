@@ -40,12 +40,15 @@ namespace lsp
     void FilterBank::construct()
     {
         vFilters    = NULL;
+        vPrecise    = NULL;
         vChains     = NULL;
         nItems      = 0;
         nMaxItems   = 0;
         nLastItems  = -1;
         vData       = NULL;
         vBackup     = NULL;
+        vDBackup    = NULL;
+        bPrecise    = false;
     }
 
     void FilterBank::destroy()
@@ -62,12 +65,15 @@ namespace lsp
 
         // Calculate data size
         size_t n_banks      = (filters/8) + 3;
+        size_t n_dbanks     = (filters/2) + 2;
         size_t bank_alloc   = ALIGN_SIZE(sizeof(biquad_t), BIQUAD_ALIGN) * n_banks;
-        size_t chain_alloc  = sizeof(biquad_x1_t) * filters;
+        size_t dbank_alloc  = ALIGN_SIZE(sizeof(biquad_d_t), BIQUAD_ALIGN) * n_dbanks;
+        size_t chain_alloc  = sizeof(biquad_dx1_t) * filters;
         size_t backup_alloc = sizeof(float) * BIQUAD_D_ITEMS * n_banks;
+        size_t dbackup_alloc= sizeof(double) * BIQUAD_DD_ITEMS * n_dbanks;
 
         // Allocate data
-        size_t allocate     = bank_alloc + chain_alloc + backup_alloc + BIQUAD_ALIGN;
+        size_t allocate     = bank_alloc + dbank_alloc + chain_alloc + backup_alloc + dbackup_alloc + BIQUAD_ALIGN;
         vData               = lsp_tmalloc(uint8_t, allocate);
         if (vData == NULL)
             return false;
@@ -76,8 +82,12 @@ namespace lsp
         uint8_t *ptr        = ALIGN_PTR(vData, BIQUAD_ALIGN);
         vFilters            = reinterpret_cast<biquad_t *>(ptr);
         ptr                += bank_alloc;
-        vChains             = reinterpret_cast<biquad_x1_t *>(ptr);
+        vPrecise            = reinterpret_cast<biquad_d_t *>(ptr);
+        ptr                += dbank_alloc;
+        vChains             = reinterpret_cast<biquad_dx1_t *>(ptr);
         ptr                += chain_alloc;
+        vDBackup            = reinterpret_cast<double *>(ptr);
+        ptr                += dbackup_alloc;
         vBackup             = reinterpret_cast<float *>(ptr);
         ptr                += backup_alloc;
 
@@ -89,17 +99,67 @@ namespace lsp
         return true;
     }
 
-    biquad_x1_t *FilterBank::add_chain()
+    biquad_dx1_t *FilterBank::add_chain()
     {
         if (nItems >= nMaxItems)
             return (nItems <= 0) ? NULL : &vChains[nItems-1];
         return &vChains[nItems++];
     }
 
+    void FilterBank::set_precise(bool precise)
+    {
+        if (bPrecise == precise)
+            return;
+
+        // Rebuild the filter banks from the chains, filter memory is not compatible
+        bPrecise        = precise;
+        end(true);
+    }
+
     void FilterBank::end(bool clear)
     {
         size_t items    = nItems;
-        biquad_x1_t *c  = vChains;
+        biquad_dx1_t *c = vChains;
+
+        if (bPrecise)
+        {
+            biquad_d_t *b   = vPrecise;
+
+            // Add 2x double-precision filter banks
+            for ( ; items >= 2; items -= 2)
+            {
+                biquad_dx2_t *f = &b->x2;
+
+                f->b0[0]    = c[0].b0;
+                f->b0[1]    = c[1].b0;
+                f->b1[0]    = c[0].b1;
+                f->b1[1]    = c[1].b1;
+                f->b2[0]    = c[0].b2;
+                f->b2[1]    = c[1].b2;
+
+                f->a1[0]    = c[0].a1;
+                f->a1[1]    = c[1].a1;
+                f->a2[0]    = c[0].a2;
+                f->a2[1]    = c[1].a2;
+
+                f->p[0]     = 0.0;
+                f->p[1]     = 0.0;
+
+                c          += 2;
+                b          ++;
+            }
+
+            // Add 1x double-precision filter
+            if (items & 1)
+                b->x1       = *c;
+
+            // Clear delays if structure has changed
+            if ((clear) || (nItems != nLastItems))
+                reset();
+            nLastItems      = nItems;
+            return;
+        }
+
         biquad_t *b     = vFilters;
 
         // Add 8x filter bank
@@ -218,7 +278,18 @@ namespace lsp
         // Add 1x filter
         if (items & 1)
         {
-            b->x1       = *(c++);
+            biquad_x1_t *f = &b->x1;
+
+            f->b0       = c->b0;
+            f->b1       = c->b1;
+            f->b2       = c->b2;
+            f->a1       = c->a1;
+            f->a2       = c->a2;
+            f->p0       = 0.0f;
+            f->p1       = 0.0f;
+            f->p2       = 0.0f;
+
+            c          ++;
             b          ++;
         }
 
@@ -230,6 +301,18 @@ namespace lsp
 
     void FilterBank::reset()
     {
+        if (bPrecise)
+        {
+            size_t items    = (nItems >> 1) + (nItems & 1);
+            biquad_d_t *b   = vPrecise;
+            for ( ; items > 0; --items, ++b)
+            {
+                for (size_t i=0; i<BIQUAD_DD_ITEMS; ++i)
+                    b->d[i]     = 0.0;
+            }
+            return;
+        }
+
         size_t items    = nItems >> 3;
         if (nItems & 4)
             items ++;
@@ -249,7 +332,6 @@ namespace lsp
     void FilterBank::process(float *out, const float *in, size_t samples)
     {
         size_t items        = nItems;
-        biquad_t *f         = vFilters;
 
         if (items == 0)
         {
@@ -257,6 +339,32 @@ namespace lsp
             return;
         }
 
+        if (bPrecise)
+        {
+            biquad_d_t *d       = vPrecise;
+
+            for ( ; items >= 2; items -= 2)
+            {
+                dsp::biquad_process_dx2(out, in, samples, d);
+                in         = out;  // actual data for the next chain is in output buffer now
+                d         ++;
+            }
+
+            if (items & 1)
+                dsp::biquad_process_dx1(out, in, samples, d);
+            return;
+        }
+
+        in          = process_pipeline(out, in, samples);
+        if (items & 1)
+            dsp::biquad_process_x1(out, in, samples, tail());
+    }
+
+    const float *FilterBank::process_pipeline(float *out, const float *in, size_t samples)
+    {
+        size_t items        = nItems;
+        biquad_t *f         = vFilters;
+
         while (items >= 8)
         {
             dsp::biquad_process_x8(out, in, samples, f);
@@ -276,15 +384,94 @@ namespace lsp
         {
             dsp::biquad_process_x2(out, in, samples, f);
             in         = out;  // actual data for the next chain is in output buffer now
-            f         ++;
         }
 
-        if (items & 1)
-            dsp::biquad_process_x1(out, in, samples, f);
+        return in;
+    }
+
+    void FilterBank::process(FilterBank *l, FilterBank *r, float *l_out, float *r_out, const float *l_in, const float *r_in, float *buf, size_t samples)
+    {
+        // The pair can be processed only if both banks have the odd single-cascade stage
+        if ((l->bPrecise) || (r->bPrecise) || (!(l->nItems & r->nItems & 1)))
+        {
+            l->process(l_out, l_in, samples);
+            r->process(r_out, r_in, samples);
+            return;
+        }
+
+        // Process the pipelined stages of each bank
+        l_in                = l->process_pipeline(l_out, l_in, samples);
+        r_in                = r->process_pipeline(r_out, r_in, samples);
+
+        // Pack the single-cascade stages into two lanes of one filter
+        biquad_t *lf        = l->tail();
+        biquad_t *rf        = r->tail();
+        biquad_t c;
+
+        c.x2.b0[0]          = lf->x1.b0;
+        c.x2.b0[1]          = rf->x1.b0;
+        c.x2.b1[0]          = lf->x1.b1;
+        c.x2.b1[1]          = rf->x1.b1;
+        c.x2.b2[0]          = lf->x1.b2;
+        c.x2.b2[1]          = rf->x1.b2;
+        c.x2.a1[0]          = lf->x1.a1;
+        c.x2.a1[1]          = rf->x1.a1;
+        c.x2.a2[0]          = lf->x1.a2;
+        c.x2.a2[1]          = rf->x1.a2;
+        c.x2.p[0]           = 0.0f;
+        c.x2.p[1]           = 0.0f;
+
+        c.d[0]              = lf->d[0];
+        c.d[1]              = rf->d[0];
+        c.d[2]              = lf->d[1];
+        c.d[3]              = rf->d[1];
+
+        // Process both channels as interleaved frames
+        dsp::pcomplex_ri2c(buf, l_in, r_in, samples);
+        dsp::biquad_process_c2(buf, buf, samples, &c);
+        dsp::pcomplex_c2ri(l_out, r_out, buf, samples);
+
+        // Store the filter memory back
+        lf->d[0]            = c.d[0];
+        rf->d[0]            = c.d[1];
+        lf->d[1]            = c.d[2];
+        rf->d[1]            = c.d[3];
     }
 
     void FilterBank::impulse_response(float *out, size_t samples)
     {
+        if (bPrecise)
+        {
+            // Backup and clean all delays
+            size_t items        = (nItems >> 1) + (nItems & 1);
+            double *dst         = vDBackup;
+            biquad_d_t *d       = vPrecise;
+
+            for (size_t i=0; i < items; ++i, ++d)
+            {
+                for (size_t j=0; j<BIQUAD_DD_ITEMS; ++j)
+                {
+                    *(dst++)        = d->d[j];
+                    d->d[j]         = 0.0;
+                }
+            }
+
+            // Generate impulse response
+            dsp::fill_zero(out, samples);
+            out[0]              = 1.0f;
+            process(out, out, samples);
+
+            // Restore all delays
+            dst                 = vDBackup;
+            d                   = vPrecise;
+            for (size_t i=0; i < items; ++i, ++d)
+            {
+                for (size_t j=0; j<BIQUAD_DD_ITEMS; ++j)
+                    d->d[j]         = *(dst++);
+            }
+            return;
+        }
+
         // Backup and clean all delays
         biquad_t *f         = vFilters;
         float *dst          = vBackup;
@@ -391,11 +578,42 @@ namespace lsp
         }
         v->end_array();
 
+        size_t np       = (bPrecise) ? (nItems >> 1) + (nItems & 1) : 0;
+        biquad_d_t *d   = vPrecise;
+        v->begin_array("vPrecise", vPrecise, np);
+        for (ni = nItems; np > 0; --np, ++d)
+        {
+            v->begin_object(d, sizeof(biquad_d_t));
+            {
+                v->writev("d", d->d, BIQUAD_DD_ITEMS);
+                if (ni >= 2)
+                {
+                    v->writev("b0", d->x2.b0, 2);
+                    v->writev("b1", d->x2.b1, 2);
+                    v->writev("b2", d->x2.b2, 2);
+                    v->writev("a1", d->x2.a1, 2);
+                    v->writev("a2", d->x2.a2, 2);
+                    v->writev("p", d->x2.p, 2);
+                    ni     -= 2;
+                }
+                else
+                {
+                    v->write("b0", d->x1.b0);
+                    v->write("b1", d->x1.b1);
+                    v->write("b2", d->x1.b2);
+                    v->write("a1", d->x1.a1);
+                    v->write("a2", d->x1.a2);
+                }
+            }
+            v->end_object();
+        }
+        v->end_array();
+
         v->begin_array("vChains", vChains, nItems);
         for (size_t i=0; i<nItems; ++i)
         {
-            biquad_x1_t *bq = &vChains[i];
-            v->begin_object(bq, sizeof(biquad_x1_t));
+            biquad_dx1_t *bq = &vChains[i];
+            v->begin_object(bq, sizeof(biquad_dx1_t));
             {
                 v->write("b0", bq->b0);
                 v->write("b1", bq->b1);
@@ -413,6 +631,8 @@ namespace lsp
         v->write("nMaxItems", nMaxItems);
         v->write("nLastItems", nLastItems);
         v->write("vBackup", vBackup);
+        v->write("vDBackup", vDBackup);
+        v->write("bPrecise", bPrecise);
         v->write("vData", vData);
     }
 } /* namespace lsp */
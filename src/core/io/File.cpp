@@ -29,6 +29,7 @@
     #include <sys/stat.h>
     #include <errno.h>
     #include <unistd.h>
+    #include <stdio.h>
 #endif /* PLATFORM_WINDOWS */
 
 namespace lsp
@@ -461,5 +462,78 @@ namespace lsp
             return STATUS_OK;
         }
 
+        status_t File::rename(const char *from, const char *to)
+        {
+            if ((from == NULL) || (to == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+            LSPString sfrom, sto;
+            if ((!sfrom.set_utf8(from)) || (!sto.set_utf8(to)))
+                return STATUS_NO_MEM;
+            return rename(&sfrom, &sto);
+        }
+
+        status_t File::rename(const Path *from, const Path *to)
+        {
+            if ((from == NULL) || (to == NULL))
+                return STATUS_BAD_ARGUMENTS;
+            return rename(from->as_string(), to->as_string());
+        }
+
+        status_t File::rename(const LSPString *from, const LSPString *to)
+        {
+            if ((from == NULL) || (to == NULL))
+                return STATUS_BAD_ARGUMENTS;
+
+#ifdef PLATFORM_WINDOWS
+            if (::MoveFileExW(from->get_utf16(), to->get_utf16(), MOVEFILE_REPLACE_EXISTING))
+                return STATUS_OK;
+
+            // Analyze error code
+            DWORD code = ::GetLastError();
+            switch (code)
+            {
+                case ERROR_ACCESS_DENIED:
+                    return STATUS_PERMISSION_DENIED;
+                case ERROR_FILE_NOT_FOUND:
+                case ERROR_PATH_NOT_FOUND:
+                    return STATUS_NOT_FOUND;
+                default:
+                    return STATUS_IO_ERROR;
+            }
+#else
+            // Try to rename file
+            if (::rename(from->get_native(), to->get_native()) == 0)
+                return STATUS_OK;
+
+            // Analyze error code
+            int code = errno;
+            switch (code)
+            {
+                case EACCES:
+                case EPERM:
+                    return STATUS_PERMISSION_DENIED;
+                case EDQUOT:
+                case ENOSPC:
+                    return STATUS_OVERFLOW;
+                case EISDIR:
+                    return STATUS_IS_DIRECTORY;
+                case EFAULT:
+                case EINVAL:
+                case ENAMETOOLONG:
+                    return STATUS_BAD_ARGUMENTS;
+                case ENOTDIR:
+                    return STATUS_BAD_TYPE;
+                case ENOENT:
+                    return STATUS_NOT_FOUND;
+                case ENOTEMPTY:
+                    return STATUS_NOT_EMPTY;
+                default:
+                    return STATUS_IO_ERROR;
+            }
+#endif /* PLATFORM_WINDOWS */
+            return STATUS_OK;
+        }
+
     } /* namespace io */
 } /* namespace lsp */
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <core/debug.h>
+#include <core/ipc/PoolExecutor.h>
+
+namespace lsp
+{
+    namespace ipc
+    {
+        PoolExecutor::PoolExecutor(size_t workers)
+        {
+            if (workers <= 0)
+            {
+                workers     = Thread::system_cores();
+                if (workers > POOL_EXECUTOR_MAX_WORKERS)
+                    workers     = POOL_EXECUTOR_MAX_WORKERS;
+                else if (workers <= 0)
+                    workers     = 1;
+            }
+
+            vWorkers    = NULL;
+            nWorkers    = workers;
+            nSubmit     = 0;
+            bShutdown   = false;
+        }
+
+        PoolExecutor::~PoolExecutor()
+        {
+            if (vWorkers != NULL)
+                shutdown();
+        }
+
+        status_t PoolExecutor::start()
+        {
+            if (vWorkers != NULL)
+                return STATUS_BAD_STATE;
+
+            worker_t *list  = new worker_t[nWorkers];
+            if (list == NULL)
+                return STATUS_NO_MEM;
+
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w     = &list[i];
+                w->pExecutor    = this;
+                w->pThread      = NULL;
+                w->pHead        = NULL;
+                w->pTail        = NULL;
+                atomic_init(w->nLock);
+            }
+
+            bShutdown       = false;
+            vWorkers        = list;
+
+            // Launch threads
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w     = &list[i];
+                w->pThread      = new Thread(execute, w);
+                if (w->pThread == NULL)
+                {
+                    shutdown();
+                    return STATUS_NO_MEM;
+                }
+
+                status_t res    = w->pThread->start();
+                if (res != STATUS_OK)
+                {
+                    delete w->pThread;
+                    w->pThread      = NULL;
+                    shutdown();
+                    return res;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        bool PoolExecutor::submit(ITask *task)
+        {
+            lsp_trace("submit task=%p", task);
+
+            // Check executor and task state
+            if ((vWorkers == NULL) || (bShutdown))
+                return false;
+            if (!task->idle())
+                return false;
+
+            // Update task state to SUBMITTED
+            change_task_state(task, ITask::TS_SUBMITTED);
+
+            // Put the task to the first non-locked queue starting with
+            // the next queue in the round-robin order. Critical sections
+            // are very short, so the loop never spins for a long time
+            size_t idx      = atomic_add(&nSubmit, 1) % nWorkers;
+            while (true)
+            {
+                worker_t *w     = &vWorkers[idx];
+                if (atomic_trylock(w->nLock))
+                {
+                    if (w->pTail != NULL)
+                        link_task(w->pTail, task);
+                    else
+                        w->pHead        = task;
+                    w->pTail        = task;
+
+                    atomic_unlock(w->nLock);
+                    break;
+                }
+
+                if ((++idx) >= nWorkers)
+                    idx             = 0;
+            }
+
+            // Wake up one of the workers
+            sSignal.post();
+            return true;
+        }
+
+        void PoolExecutor::shutdown()
+        {
+            lsp_trace("start shutdown");
+            if (vWorkers == NULL)
+                return;
+
+            // Workers terminate only when there are no more tasks in all queues
+            bShutdown       = true;
+            for (size_t i=0; i<nWorkers; ++i)
+                sSignal.post();
+
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                worker_t *w     = &vWorkers[i];
+                if (w->pThread == NULL)
+                    continue;
+
+                w->pThread->join();
+                delete w->pThread;
+                w->pThread      = NULL;
+            }
+
+            // Complete tasks that could not be processed by workers
+            for (size_t i=0; i<nWorkers; ++i)
+            {
+                ITask *task;
+                while ((task = pop_task(&vWorkers[i])) != NULL)
+                    run_task(task);
+            }
+
+            delete [] vWorkers;
+            vWorkers        = NULL;
+
+            lsp_trace("shutdown complete");
+        }
+
+        ITask *PoolExecutor::pop_task(worker_t *w)
+        {
+            // Acquire critical section
+            while (!atomic_trylock(w->nLock))
+                /* nothing */ ;
+
+            // Remove task from queue
+            ITask *task     = w->pHead;
+            if (task != NULL)
+            {
+                w->pHead        = next_task(task);
+                if (w->pHead == NULL)
+                    w->pTail        = NULL;
+            }
+
+            // Release critical section
+            atomic_unlock(w->nLock);
+            return task;
+        }
+
+        ITask *PoolExecutor::fetch(worker_t *w)
+        {
+            // Try to get task from own queue first
+            ITask *task     = pop_task(w);
+            if (task != NULL)
+                return task;
+
+            // Steal task from queues of other workers
+            size_t idx      = w - vWorkers;
+            for (size_t i=1; i<nWorkers; ++i)
+            {
+                if ((++idx) >= nWorkers)
+                    idx             = 0;
+                if ((task = pop_task(&vWorkers[idx])) != NULL)
+                    return task;
+            }
+
+            return NULL;
+        }
+
+        void PoolExecutor::run(worker_t *w)
+        {
+            while (true)
+            {
+                ITask *task     = fetch(w);
+                if (task != NULL)
+                {
+                    // Execute task
+                    lsp_trace("executing task %p", task);
+                    run_task(task);
+                    lsp_trace("executed task %p with code %d", task, int(task->code()));
+                    continue;
+                }
+
+                // Leave the loop only when there are no pending tasks
+                if (bShutdown)
+                    break;
+
+                sSignal.wait();
+            }
+        }
+
+        status_t PoolExecutor::execute(void *params)
+        {
+            worker_t *w = reinterpret_cast<worker_t *>(params);
+            w->pExecutor->run(w);
+            return STATUS_OK;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <core/ipc/Semaphore.h>
+#include <time.h>
+
+namespace lsp
+{
+    namespace ipc
+    {
+#if defined(PLATFORM_WINDOWS)
+        Semaphore::Semaphore()
+        {
+            hSem        = CreateSemaphoreW(NULL, 0, 0x7fffffff, NULL);
+        }
+
+        Semaphore::~Semaphore()
+        {
+            CloseHandle(hSem);
+        }
+
+        bool Semaphore::post() const
+        {
+            return ReleaseSemaphore(hSem, 1, NULL);
+        }
+
+        status_t Semaphore::wait() const
+        {
+            DWORD res = WaitForSingleObject(hSem, INFINITE);
+            return (res == WAIT_OBJECT_0) ? STATUS_OK : STATUS_UNKNOWN_ERR;
+        }
+
+        status_t Semaphore::wait(wsize_t millis) const
+        {
+            DWORD res = WaitForSingleObject(hSem, millis);
+            switch (res)
+            {
+                case WAIT_OBJECT_0: return STATUS_OK;
+                case WAIT_TIMEOUT: return STATUS_TIMED_OUT;
+                default: break;
+            }
+            return STATUS_UNKNOWN_ERR;
+        }
+
+        bool Semaphore::try_wait() const
+        {
+            return WaitForSingleObject(hSem, 0) == WAIT_OBJECT_0;
+        }
+
+#elif defined(PLATFORM_LINUX)
+        Semaphore::Semaphore()
+        {
+            nCount      = 0;
+            nWaiters    = 0;
+        }
+
+        Semaphore::~Semaphore()
+        {
+        }
+
+        bool Semaphore::post() const
+        {
+            atomic_add(&nCount, 1);
+            if (nWaiters > 0)
+                syscall(SYS_futex, &nCount, FUTEX_WAKE, 1, NULL, 0, 0);
+            return true;
+        }
+
+        bool Semaphore::try_wait() const
+        {
+            while (true)
+            {
+                atomic_t count  = nCount;
+                if (count <= 0)
+                    return false;
+                if (atomic_cas(&nCount, count, count - 1))
+                    return true;
+            }
+        }
+
+        status_t Semaphore::wait() const
+        {
+            if (try_wait())
+                return STATUS_OK;
+
+            atomic_add(&nWaiters, 1);
+            while (!try_wait())
+                syscall(SYS_futex, &nCount, FUTEX_WAIT, 0, NULL, 0, 0);
+            atomic_add(&nWaiters, -1);
+
+            return STATUS_OK;
+        }
+
+        status_t Semaphore::wait(wsize_t millis) const
+        {
+            if (try_wait())
+                return STATUS_OK;
+
+            struct timespec ts, now;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            wssize_t deadline   = wssize_t(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000 + millis;
+            status_t res        = STATUS_OK;
+
+            atomic_add(&nWaiters, 1);
+            while (!try_wait())
+            {
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                wssize_t left       = deadline - (wssize_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000);
+                if (left <= 0)
+                {
+                    res                 = STATUS_TIMED_OUT;
+                    break;
+                }
+
+                ts.tv_sec           = left / 1000;
+                ts.tv_nsec          = (left % 1000) * 1000000;
+                syscall(SYS_futex, &nCount, FUTEX_WAIT, 0, &ts, 0, 0);
+            }
+            atomic_add(&nWaiters, -1);
+
+            return res;
+        }
+
+#else
+        Semaphore::Semaphore()
+        {
+            pthread_mutex_init(&sMutex, NULL);
+            pthread_cond_init(&sCond, NULL);
+            nCount      = 0;
+        }
+
+        Semaphore::~Semaphore()
+        {
+            pthread_cond_destroy(&sCond);
+            pthread_mutex_destroy(&sMutex);
+        }
+
+        bool Semaphore::post() const
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            ++nCount;
+            pthread_cond_signal(&sCond);
+            pthread_mutex_unlock(&sMutex);
+            return true;
+        }
+
+        bool Semaphore::try_wait() const
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return false;
+            bool res = nCount > 0;
+            if (res)
+                --nCount;
+            pthread_mutex_unlock(&sMutex);
+            return res;
+        }
+
+        status_t Semaphore::wait() const
+        {
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return STATUS_UNKNOWN_ERR;
+            while (nCount <= 0)
+                pthread_cond_wait(&sCond, &sMutex);
+            --nCount;
+            pthread_mutex_unlock(&sMutex);
+            return STATUS_OK;
+        }
+
+        status_t Semaphore::wait(wsize_t millis) const
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            ts.tv_sec          += millis / 1000;
+            ts.tv_nsec         += (millis % 1000) * 1000000;
+            if (ts.tv_nsec >= 1000000000)
+            {
+                ts.tv_nsec         -= 1000000000;
+                ++ts.tv_sec;
+            }
+
+            if (pthread_mutex_lock(&sMutex) != 0)
+                return STATUS_UNKNOWN_ERR;
+
+            status_t res = STATUS_OK;
+            while (nCount <= 0)
+            {
+                if (pthread_cond_timedwait(&sCond, &sMutex, &ts) == ETIMEDOUT)
+                {
+                    res         = STATUS_TIMED_OUT;
+                    break;
+                }
+            }
+            if (res == STATUS_OK)
+                --nCount;
+
+            pthread_mutex_unlock(&sMutex);
+            return res;
+        }
+#endif /* PLATFORM_LINUX */
+
+    } /* namespace ipc */
+} /* namespace lsp */
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <core/debug.h>
+#include <core/ipc/SharedMemory.h>
+#include <dsp/atomic.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#ifndef PLATFORM_WINDOWS
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif /* PLATFORM_WINDOWS */
+
+#define SHM_CREATE_ATTEMPTS         16
+
+namespace lsp
+{
+    namespace ipc
+    {
+        static uatomic_t shm_counter   = 0;
+
+        SharedMemory::SharedMemory()
+        {
+        #ifdef PLATFORM_WINDOWS
+            hMapping    = NULL;
+        #else
+            hFD         = -1;
+        #endif
+            pData       = NULL;
+            nSize       = 0;
+            bOwner      = false;
+            sName[0]    = '\0';
+        }
+
+        SharedMemory::~SharedMemory()
+        {
+            close();
+        }
+
+        status_t SharedMemory::create(const char *name, size_t size)
+        {
+            if ((name == NULL) || (size <= 0))
+                return STATUS_BAD_ARGUMENTS;
+            if (pData != NULL)
+                return STATUS_OPENED;
+
+            // Segment names should start with '/' for portability
+            int len = ::snprintf(sName, sizeof(sName), (name[0] == '/') ? "%s" : "/%s", name);
+            if ((len <= 0) || (len >= int(sizeof(sName))))
+            {
+                sName[0]    = '\0';
+                return STATUS_BAD_ARGUMENTS;
+            }
+
+        #ifdef PLATFORM_WINDOWS
+            HANDLE hMap     = ::CreateFileMappingA(
+                    INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                    DWORD(uint64_t(size) >> 32), DWORD(size), &sName[1]);
+            if (hMap == NULL)
+            {
+                sName[0]    = '\0';
+                return STATUS_IO_ERROR;
+            }
+            if (::GetLastError() == ERROR_ALREADY_EXISTS)
+            {
+                ::CloseHandle(hMap);
+                sName[0]    = '\0';
+                return STATUS_ALREADY_EXISTS;
+            }
+
+            void *ptr       = ::MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, size);
+            if (ptr == NULL)
+            {
+                ::CloseHandle(hMap);
+                sName[0]    = '\0';
+                return STATUS_NO_MEM;
+            }
+
+            hMapping        = hMap;
+        #else
+            int fd          = ::shm_open(sName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+            if (fd < 0)
+            {
+                int code    = errno;
+                sName[0]    = '\0';
+                return (code == EEXIST) ? STATUS_ALREADY_EXISTS : STATUS_IO_ERROR;
+            }
+
+            if (::ftruncate(fd, size) != 0)
+            {
+                ::close(fd);
+                ::shm_unlink(sName);
+                sName[0]    = '\0';
+                return STATUS_NO_MEM;
+            }
+
+            void *ptr       = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (ptr == MAP_FAILED)
+            {
+                ::close(fd);
+                ::shm_unlink(sName);
+                sName[0]    = '\0';
+                return STATUS_NO_MEM;
+            }
+
+            hFD             = fd;
+        #endif
+
+            pData           = ptr;
+            nSize           = size;
+            bOwner          = true;
+
+            return STATUS_OK;
+        }
+
+        status_t SharedMemory::create_unique(const char *prefix, size_t size)
+        {
+            if (prefix == NULL)
+                return STATUS_BAD_ARGUMENTS;
+
+            char name[SHARED_MEMORY_NAME_MAX];
+        #ifdef PLATFORM_WINDOWS
+            int pid     = int(::GetCurrentProcessId());
+        #else
+            int pid     = int(::getpid());
+        #endif
+
+            for (size_t i=0; i<SHM_CREATE_ATTEMPTS; ++i)
+            {
+                uatomic_t id    = atomic_add(&shm_counter, 1);
+                int len         = ::snprintf(name, sizeof(name), "/%s-%d-%u", prefix, pid, (unsigned int)(id));
+                if ((len <= 0) || (len >= int(sizeof(name))))
+                    return STATUS_BAD_ARGUMENTS;
+
+                status_t res    = create(name, size);
+                if (res != STATUS_ALREADY_EXISTS)
+                    return res;
+            }
+
+            return STATUS_ALREADY_EXISTS;
+        }
+
+        status_t SharedMemory::open(const char *name)
+        {
+            if (name == NULL)
+                return STATUS_BAD_ARGUMENTS;
+            if (pData != NULL)
+                return STATUS_OPENED;
+
+            int len = ::snprintf(sName, sizeof(sName), (name[0] == '/') ? "%s" : "/%s", name);
+            if ((len <= 0) || (len >= int(sizeof(sName))))
+            {
+                sName[0]    = '\0';
+                return STATUS_BAD_ARGUMENTS;
+            }
+
+        #ifdef PLATFORM_WINDOWS
+            HANDLE hMap     = ::OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, &sName[1]);
+            if (hMap == NULL)
+            {
+                sName[0]    = '\0';
+                return STATUS_NOT_FOUND;
+            }
+
+            void *ptr       = ::MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+            if (ptr == NULL)
+            {
+                ::CloseHandle(hMap);
+                sName[0]    = '\0';
+                return STATUS_NO_MEM;
+            }
+
+            MEMORY_BASIC_INFORMATION info;
+            size_t size     = (::VirtualQuery(ptr, &info, sizeof(info)) != 0) ? info.RegionSize : 0;
+
+            hMapping        = hMap;
+        #else
+            int fd          = ::shm_open(sName, O_RDWR, 0);
+            if (fd < 0)
+            {
+                int code    = errno;
+                sName[0]    = '\0';
+                return (code == ENOENT) ? STATUS_NOT_FOUND : STATUS_IO_ERROR;
+            }
+
+            struct stat st;
+            if ((::fstat(fd, &st) != 0) || (st.st_size <= 0))
+            {
+                ::close(fd);
+                sName[0]    = '\0';
+                return STATUS_IO_ERROR;
+            }
+
+            size_t size     = st.st_size;
+            void *ptr       = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (ptr == MAP_FAILED)
+            {
+                ::close(fd);
+                sName[0]    = '\0';
+                return STATUS_NO_MEM;
+            }
+
+            hFD             = fd;
+        #endif
+
+            pData           = ptr;
+            nSize           = size;
+            bOwner          = false;
+
+            return STATUS_OK;
+        }
+
+        status_t SharedMemory::close()
+        {
+            if (pData == NULL)
+                return STATUS_OK;
+
+        #ifdef PLATFORM_WINDOWS
+            ::UnmapViewOfFile(pData);
+            ::CloseHandle(hMapping);
+            hMapping    = NULL;
+        #else
+            ::munmap(pData, nSize);
+            ::close(hFD);
+            if (bOwner)
+                ::shm_unlink(sName);
+            hFD         = -1;
+        #endif
+
+            pData       = NULL;
+            nSize       = 0;
+            bOwner      = false;
+            sName[0]    = '\0';
+
+            return STATUS_OK;
+        }
+    }
+} /* namespace lsp */
@@ -22,6 +22,8 @@
 #include <core/plugin.h>
 #include <core/debug.h>
 
+#define DISPLAY_IDLE_TIMEOUT        2       /* Inline display idle timeout in seconds */
+
 namespace lsp
 {
     plugin_t::plugin_t(const plugin_metadata_t &mdata)
@@ -32,6 +34,10 @@ namespace lsp
         nLatency        = 0;
         bActivated      = false;
         bUIActive       = true;
+        bDisplayActive  = false;
+        nDisplayDraws   = 0;
+        nDisplaySeen    = 0;
+        nDisplayIdle    = 0;
     }
 
     plugin_t::~plugin_t()
@@ -48,6 +54,7 @@ namespace lsp
         if (fSampleRate != sr)
         {
             fSampleRate = sr;
+            sProfiler.set_sample_rate(sr);
             update_sample_rate(sr);
         }
     };
@@ -72,6 +79,43 @@ namespace lsp
     {
     }
 
+    void plugin_t::display_activated()
+    {
+    }
+
+    void plugin_t::display_deactivated()
+    {
+    }
+
+    void plugin_t::update_display_state(size_t samples)
+    {
+        uatomic_t draws     = nDisplayDraws;
+        if (draws != nDisplaySeen)
+        {
+            nDisplaySeen        = draws;
+            nDisplayIdle        = 0;
+            if (!bDisplayActive)
+            {
+                bDisplayActive      = true;
+                lsp_trace("Inline display has been activated");
+                display_activated();
+            }
+            return;
+        }
+
+        if (!bDisplayActive)
+            return;
+
+        // Deactivate inline display if host didn't draw it for a while
+        nDisplayIdle       += samples;
+        if ((fSampleRate > 0) && (nDisplayIdle >= size_t(fSampleRate * DISPLAY_IDLE_TIMEOUT)))
+        {
+            bDisplayActive      = false;
+            lsp_trace("Inline display has been deactivated");
+            display_deactivated();
+        }
+    }
+
     void plugin_t::destroy()
     {
         vPorts.clear();
@@ -126,6 +170,11 @@ namespace lsp
         v->write("nLatency", nLatency);
         v->write("bActivated", bActivated);
         v->write("bUIActive", bUIActive);
+        v->write("bDisplayActive", bDisplayActive);
+        v->write("nDisplayDraws", nDisplayDraws);
+        v->write("nDisplaySeen", nDisplaySeen);
+        v->write("nDisplayIdle", nDisplayIdle);
+        v->write_object("sProfiler", &sProfiler);
     }
 }
 
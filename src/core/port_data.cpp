@@ -639,6 +639,159 @@ namespace lsp
         pos->ticksPerBeat   = DEFAULT_TICKS_PER_BEAT;
     }
 
+    //-------------------------------------------------------------------------
+    // shm_ring_t methods
+    #define SHM_RING_MAGIC      0x52494e47  /* 'RING' */
+    #define SHM_RECORD_SIZE(x)  ALIGN_SIZE((x) + sizeof(record_t), sizeof(record_t))
+
+    size_t shm_ring_t::size_of(size_t capacity)
+    {
+        return sizeof(shm_ring_t) + ALIGN_SIZE(capacity, sizeof(record_t));
+    }
+
+    shm_ring_t *shm_ring_t::init(void *ptr, size_t size)
+    {
+        if ((ptr == NULL) || (size < (sizeof(shm_ring_t) + sizeof(record_t) * 2)))
+            return NULL;
+
+        size_t cap          = (size - sizeof(shm_ring_t)) & (~(sizeof(record_t) - 1));
+        if (cap > 0x7fffffff)
+            cap                 = 0x7ffffff8;
+
+        shm_ring_t *ring    = reinterpret_cast<shm_ring_t *>(ptr);
+        ring->nCapacity     = cap;
+        ring->nWrOff        = 0;
+        ring->nRdSize       = 0;
+        ring->nHead         = 0;
+        ring->nTail         = 0;
+        atomic_swap(&ring->nMagic, uint32_t(SHM_RING_MAGIC)); // This should be the last operation
+
+        return ring;
+    }
+
+    shm_ring_t *shm_ring_t::attach(void *ptr, size_t size)
+    {
+        if ((ptr == NULL) || (size < sizeof(shm_ring_t)))
+            return NULL;
+
+        shm_ring_t *ring    = reinterpret_cast<shm_ring_t *>(ptr);
+        if (ring->nMagic != SHM_RING_MAGIC)
+            return NULL;
+
+        // Validate the state of the ring
+        size_t cap          = ring->nCapacity;
+        if ((cap > (size - sizeof(shm_ring_t))) || (cap % sizeof(record_t)))
+            return NULL;
+        if ((ring->nHead >= cap) || (ring->nTail >= cap))
+            return NULL;
+
+        // Drop records left by the previous consumer, they are stale
+        ring->nRdSize       = 0;
+        ring->nTail         = ring->nHead;
+
+        return ring;
+    }
+
+    void *shm_ring_t::begin_write(size_t size)
+    {
+        size_t cap          = nCapacity;
+        size_t need         = SHM_RECORD_SIZE(size);
+        size_t head         = nHead;
+        size_t tail         = nTail;
+
+        if (head >= tail)
+        {
+            // The free space is at the end and at the start of the buffer,
+            // the head should never reach the tail when wrapping around
+            size_t free     = (tail > 0) ? cap - head : cap - head - sizeof(record_t);
+            if (need > free)
+            {
+                if (need + sizeof(record_t) > tail)
+                    return NULL;
+                head            = 0;
+            }
+        }
+        else if (need + sizeof(record_t) > tail - head)
+            return NULL;
+
+        nWrOff              = head;
+        return &data()[head + sizeof(record_t)];
+    }
+
+    void shm_ring_t::commit_write(size_t size)
+    {
+        uint8_t *ptr        = data();
+        size_t head         = nHead;
+        size_t off          = nWrOff;
+
+        // Mark the rest of the buffer as unused if record has been wrapped
+        if (off != head)
+        {
+            record_t *wrap      = reinterpret_cast<record_t *>(&ptr[head]);
+            wrap->nSize         = nCapacity - head - sizeof(record_t);
+            wrap->nType         = RT_WRAP;
+        }
+
+        // Store the record header
+        record_t *rec       = reinterpret_cast<record_t *>(&ptr[off]);
+        rec->nSize          = size;
+        rec->nType          = RT_DATA;
+
+        // Publish the record
+        off                += SHM_RECORD_SIZE(size);
+        if (off >= nCapacity)
+            off                 = 0;
+        atomic_swap(&nHead, uint32_t(off));
+    }
+
+    const void *shm_ring_t::begin_read(size_t *size)
+    {
+        uint8_t *ptr        = data();
+        size_t cap          = nCapacity;
+        size_t tail         = nTail;
+
+        while (true)
+        {
+            size_t head         = nHead;
+            if (tail == head)
+                return NULL;
+
+            // Validate the record
+            record_t *rec       = reinterpret_cast<record_t *>(&ptr[tail]);
+            size_t limit        = (head > tail) ? head - tail : cap - tail;
+            size_t rsize        = rec->nSize;
+            if ((head >= cap) || (rsize > limit) || (SHM_RECORD_SIZE(rsize) > limit))
+            {
+                // The ring contains corrupted data, skip all pending records
+                atomic_swap(&nTail, uint32_t(head));
+                return NULL;
+            }
+
+            if (rec->nType == RT_DATA)
+            {
+                nRdSize             = rsize;
+                *size               = rsize;
+                return &rec[1];
+            }
+
+            // Wrap around the buffer
+            tail                = 0;
+            atomic_swap(&nTail, uint32_t(tail));
+        }
+    }
+
+    void shm_ring_t::commit_read()
+    {
+        size_t tail         = nTail + SHM_RECORD_SIZE(nRdSize);
+        if (tail >= nCapacity)
+            tail                = 0;
+        nRdSize             = 0;
+        atomic_swap(&nTail, uint32_t(tail));
+    }
+
+    #undef SHM_RECORD_SIZE
+    #undef SHM_RING_MAGIC
+
     //-------------------------------------------------------------------------
     // osc_buffer_t methods
     osc_buffer_t *osc_buffer_t::create(size_t capacity)
@@ -21,6 +21,32 @@
 
 #include <core/resource.h>
 
+namespace lsp
+{
+    namespace resource
+    {
+        uint32_t hash_id(const char *id, uint32_t seed)
+        {
+            // FNV-1a hash with seeded basis
+            uint32_t h  = 0x811c9dc5 ^ (seed * 0x9e3779b9);
+            for ( ; *id != '\0'; ++id)
+            {
+                h          ^= uint8_t(*id);
+                h          *= 0x01000193;
+            }
+
+            // Final avalanche, the index uses lower bits of hash
+            h          ^= h >> 16;
+            h          *= 0x85ebca6b;
+            h          ^= h >> 13;
+            h          *= 0xc2b2ae35;
+            h          ^= h >> 16;
+
+            return h;
+        }
+    }
+}
+
 #ifdef LSP_BUILTIN_RESOURCES
 namespace lsp
 {
@@ -31,15 +57,19 @@ namespace lsp
             if (id == NULL)
                 return NULL;
 
-            // Iterate list of all resources and lookup for the proper one
-            for (const resource_t *res = builtin_resources; (res->id != NULL) && (res->data != NULL); ++res)
-            {
-                if (strcmp(res->id, id) != 0)
-                    continue;
-                if ((type == RESOURCE_UNKNOWN) || (res->type == type))
-                    return res;
-            }
-            return NULL;
+            // Lookup the bucket and the slot in the perfect hash index
+            uint32_t seed   = builtin_index_disp[hash_id(id, 0) & (builtin_index_buckets - 1)];
+            if (seed == 0)
+                return NULL;
+            ssize_t idx     = builtin_index_slots[hash_id(id, seed) & (builtin_index_size - 1)];
+            if (idx < 0)
+                return NULL;
+
+            // Verify that the resource matches
+            const resource_t *res = &builtin_resources[idx];
+            if (strcmp(res->id, id) != 0)
+                return NULL;
+            return ((type == RESOURCE_UNKNOWN) || (res->type == type)) ? res : NULL;
         }
 
         const resource_t *all()
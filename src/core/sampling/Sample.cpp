@@ -32,6 +32,10 @@ namespace lsp
         nLength     = 0;
         nMaxLength  = 0;
         nChannels   = 0;
+        pStream     = NULL;
+        nStreamOffset = 0;
+        nStreamLength = 0;
+        nStreamFadeout = 0;
     }
 
     Sample::~Sample()
@@ -123,6 +127,18 @@ namespace lsp
         nMaxLength      = 0;
         nLength         = 0;
         nChannels       = 0;
+        pStream         = NULL;
+        nStreamOffset   = 0;
+        nStreamLength   = 0;
+        nStreamFadeout  = 0;
+    }
+
+    void Sample::set_stream(AudioStream *stream, size_t offset, size_t length, size_t fadeout)
+    {
+        pStream         = stream;
+        nStreamOffset   = (stream != NULL) ? offset : 0;
+        nStreamLength   = (stream != NULL) ? lsp_max(length, nLength) : 0;
+        nStreamFadeout  = (stream != NULL) ? fadeout : 0;
     }
 
     void Sample::swap(Sample *dst)
@@ -131,6 +147,10 @@ namespace lsp
         ::swap(nMaxLength, dst->nMaxLength);
         ::swap(nLength, dst->nLength);
         ::swap(nChannels, dst->nChannels);
+        ::swap(pStream, dst->pStream);
+        ::swap(nStreamOffset, dst->nStreamOffset);
+        ::swap(nStreamLength, dst->nStreamLength);
+        ::swap(nStreamFadeout, dst->nStreamFadeout);
     }
 
 } /* namespace lsp */
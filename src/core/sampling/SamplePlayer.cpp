@@ -21,8 +21,11 @@
 
 #include <dsp/dsp.h>
 #include <core/debug.h>
+#include <core/fade.h>
 #include <core/sampling/SamplePlayer.h>
 
+#define STREAM_BUF_SIZE         0x400
+
 namespace lsp
 {
     SamplePlayer::SamplePlayer()
@@ -36,6 +39,8 @@ namespace lsp
         sInactive.pHead = NULL;
         sInactive.pTail = NULL;
         fGain           = 1.0f;
+        pStreamer       = NULL;
+        vStreamBuf      = NULL;
     }
     
     SamplePlayer::~SamplePlayer()
@@ -123,14 +128,31 @@ namespace lsp
         pb->nFadeOffset     = 0;
         pb->nVolume         = 0.0f;
         pb->nOffset         = 0;
+        pb->pVoice          = NULL;
+    }
+
+    void SamplePlayer::release_voice(playback_t *pb)
+    {
+        if (pb->pVoice == NULL)
+            return;
+        pStreamer->release(pb->pVoice);
+        pb->pVoice          = NULL;
     }
 
-    bool SamplePlayer::init(size_t max_samples, size_t max_playbacks)
+    bool SamplePlayer::init(size_t max_samples, size_t max_playbacks, SampleStreamer *streamer)
     {
         // Check arguments
         if ((max_samples <= 0) || (max_playbacks <= 0))
             return false;
 
+        // Allocate buffer for streamed data
+        if (streamer != NULL)
+        {
+            vStreamBuf          = new float[STREAM_BUF_SIZE];
+            if (vStreamBuf == NULL)
+                return false;
+        }
+
         // Allocate array of samples
         vSamples            = new Sample *[max_samples];
         if (vSamples == NULL)
@@ -148,6 +170,7 @@ namespace lsp
         // Update state
         nSamples            = max_samples;
         nPlayback           = max_playbacks;
+        pStreamer           = streamer;
         for (size_t i=0; i<max_samples; ++i)
             vSamples[i]         = NULL;
 
@@ -206,10 +229,21 @@ namespace lsp
 
         if (vPlayback != NULL)
         {
+            // Release all streaming voices
+            for (playback_t *pb = sActive.pHead; pb != NULL; pb = pb->pNext)
+                release_voice(pb);
+
             delete [] vPlayback;
             vPlayback       = NULL;
         }
         nPlayback       = 0;
+
+        if (vStreamBuf != NULL)
+        {
+            delete [] vStreamBuf;
+            vStreamBuf      = NULL;
+        }
+        pStreamer       = NULL;
         sActive.pHead   = NULL;
         sActive.pTail   = NULL;
         sInactive.pHead = NULL;
@@ -242,6 +276,7 @@ namespace lsp
             playback_t *next    = pb->pNext;
             if (pb->pSample == old)
             {
+                release_voice(pb);
                 pb->pSample     = NULL;
                 list_remove(&sActive, pb);
                 list_add_first(&sInactive, pb);
@@ -302,11 +337,13 @@ namespace lsp
             // Get next playback
             playback_t *next    = pb->pNext;
 
-            // Check bounds
+            // Check bounds, samples without streaming voice are played
+            // only until the end of the preloaded data
             ssize_t src_head    = pb->nOffset;
             pb->nOffset        += samples;
             Sample *s           = pb->pSample;
-            ssize_t s_len       = s->length();
+            ssize_t h_len       = s->length();
+            ssize_t s_len       = (pb->pVoice != NULL) ? s->total_length() : h_len;
 
             // Handle sample if active
             if (pb->nOffset > 0)
@@ -328,25 +365,27 @@ namespace lsp
                 if (count > 0)
                 {
 //                    lsp_trace("add_multiplied dst_off=%d, src_head=%d, volume=%f, count=%d", int(dst_off), int(src_head), pb->nVolume, int(count));
-                    if (pb->nFadeout < 0)
-                        dsp::fmadd_k3(&dst[dst_off], s->getBuffer(pb->nChannel, src_head), pb->nVolume * fGain, count);
-                    else
+                    float *dp           = &dst[dst_off];
+
+                    // Add preloaded data
+                    if (src_head < h_len)
                     {
-                        ssize_t fade_head   = pb->nFadeOffset;
-                        float gain          = pb->nVolume * fGain;
-                        float *sp           = s->getBuffer(pb->nChannel, src_head);
-                        float *dp           = &dst[dst_off];
-
-                        float fgain         = gain / (pb->nFadeout + 1);
-                        for (ssize_t i=0; (i<count) && (fade_head < pb->nFadeout); ++i, ++fade_head)
-                        {
-                            if (fade_head < 0)
-                                *(dp++)        += *(sp++) * gain;
-                            else
-                                *(dp++)        += *(sp++) * fgain * (pb->nFadeout - fade_head);
-                        }
-
-                        pb->nFadeOffset     = fade_head;
+                        ssize_t to_do       = lsp_min(count, h_len - src_head);
+                        add_samples(pb, dp, s->getBuffer(pb->nChannel, src_head), to_do);
+                        dp                 += to_do;
+                        count              -= to_do;
+                    }
+
+                    // Add streamed data
+                    for (ssize_t pos = lsp_max(src_head, h_len); count > 0; )
+                    {
+                        ssize_t to_do       = lsp_min(count, ssize_t(STREAM_BUF_SIZE));
+                        pStreamer->read(pb->pVoice, vStreamBuf, to_do);
+                        fade_out(vStreamBuf, vStreamBuf, s->stream_fadeout(), pos, to_do, s_len);
+                        add_samples(pb, dp, vStreamBuf, to_do);
+                        dp                 += to_do;
+                        pos                += to_do;
+                        count              -= to_do;
                     }
                 }
             }
@@ -356,6 +395,7 @@ namespace lsp
                 ((pb->nFadeout >= 0) && (pb->nFadeOffset >= pb->nFadeout)))
             {
                 // Cleanup playback
+                release_voice(pb);
                 cleanup(pb);
 
                 // Move to inactive
@@ -370,6 +410,29 @@ namespace lsp
         }
     }
 
+    void SamplePlayer::add_samples(playback_t *pb, float *dst, const float *src, size_t count)
+    {
+        if (pb->nFadeout < 0)
+        {
+            dsp::fmadd_k3(dst, src, pb->nVolume * fGain, count);
+            return;
+        }
+
+        ssize_t fade_head   = pb->nFadeOffset;
+        float gain          = pb->nVolume * fGain;
+        float fgain         = gain / (pb->nFadeout + 1);
+
+        for (size_t i=0; (i<count) && (fade_head < pb->nFadeout); ++i, ++fade_head)
+        {
+            if (fade_head < 0)
+                *(dst++)       += *(src++) * gain;
+            else
+                *(dst++)       += *(src++) * fgain * (pb->nFadeout - fade_head);
+        }
+
+        pb->nFadeOffset     = fade_head;
+    }
+
     bool SamplePlayer::play(size_t id, size_t channel, float volume, ssize_t delay)
     {
         // Check that ID of the sample is correct
@@ -403,6 +466,12 @@ namespace lsp
         pb->nFadeout    = -1;  // No fadeout
         pb->nFadeOffset = -1; // No cancellation
 
+        // Start prefetching the data that is not stored in memory
+        release_voice(pb);
+        if ((pStreamer != NULL) && (s->stream() != NULL) && (s->total_length() > s->length()))
+            pb->pVoice      = pStreamer->acquire(s->stream(), channel,
+                                s->stream_offset() + s->length(), s->total_length() - s->length());
+
         // Add the playback to the active list
         list_insert_from_tail(&sActive, pb);
 
@@ -458,6 +527,7 @@ namespace lsp
         do
         {
             // Cancel playback
+            release_voice(pb);
             cleanup(pb);
 
             // Iterate next playback
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <core/debug.h>
+#include <core/alloc.h>
+#include <core/sampling/SampleStreamer.h>
+
+#define STREAMER_BUF_SIZE       0x8000      /* Size of buffer for reading interleaved frames */
+#define STREAMER_WAIT_PERIOD    20          /* Maximum period of waiting for requests in milliseconds */
+
+namespace lsp
+{
+    SampleStreamer::SampleStreamer()
+    {
+        vVoices         = NULL;
+        nVoices         = 0;
+        nRingSize       = 0;
+        vBuffer         = NULL;
+        nBufSize        = 0;
+        pThread         = NULL;
+        nUnderruns      = 0;
+        nDropped        = 0;
+        pData           = NULL;
+    }
+
+    SampleStreamer::~SampleStreamer()
+    {
+        destroy();
+    }
+
+    status_t SampleStreamer::init(size_t voices, size_t ring_size)
+    {
+        destroy();
+        if (voices <= 0)
+            return STATUS_BAD_ARGUMENTS;
+
+        // Round ring size to the power of 2
+        size_t rsize    = 0x100;
+        while (rsize < ring_size)
+            rsize         <<= 1;
+
+        // Allocate data
+        size_t v_size   = ALIGN_SIZE(sizeof(voice_t) * voices, DEFAULT_ALIGN);
+        size_t r_size   = rsize * sizeof(float);
+        size_t b_size   = STREAMER_BUF_SIZE * sizeof(float);
+        size_t total    = v_size + r_size * voices + b_size + DEFAULT_ALIGN;
+
+        uint8_t *data   = lsp_tmalloc(uint8_t, total);
+        if (data == NULL)
+            return STATUS_NO_MEM;
+        uint8_t *ptr    = ALIGN_PTR(data, DEFAULT_ALIGN);
+
+        vVoices         = reinterpret_cast<voice_t *>(ptr);
+        ptr            += v_size;
+        vBuffer         = reinterpret_cast<float *>(ptr);
+        ptr            += b_size;
+
+        for (size_t i=0; i<voices; ++i)
+        {
+            voice_t *v      = &vVoices[i];
+            v->pStream      = NULL;
+            v->nChannel     = 0;
+            v->nPosition    = 0;
+            v->nEnd         = 0;
+            v->nLength      = 0;
+            v->vRing        = reinterpret_cast<float *>(ptr);
+            v->nHead        = 0;
+            v->nTail        = 0;
+            v->nState       = VS_FREE;
+            ptr            += r_size;
+        }
+
+        nVoices         = voices;
+        nRingSize       = rsize;
+        nBufSize        = STREAMER_BUF_SIZE;
+        nUnderruns      = 0;
+        nDropped        = 0;
+        pData           = data;
+
+        // Launch the streaming thread
+        ipc::Thread *thread = new ipc::Thread(streaming_thread, this);
+        if (thread == NULL)
+        {
+            destroy();
+            return STATUS_NO_MEM;
+        }
+
+        status_t res = thread->start();
+        if (res != STATUS_OK)
+        {
+            delete thread;
+            destroy();
+            return res;
+        }
+        pThread         = thread;
+
+        return STATUS_OK;
+    }
+
+    void SampleStreamer::destroy()
+    {
+        if (pThread != NULL)
+        {
+            pThread->cancel();
+            sWakeup.post();
+            pThread->join();
+            delete pThread;
+            pThread         = NULL;
+        }
+
+        if (pData != NULL)
+        {
+            lsp_free(pData);
+            pData           = NULL;
+        }
+
+        vVoices         = NULL;
+        nVoices         = 0;
+        nRingSize       = 0;
+        vBuffer         = NULL;
+        nBufSize        = 0;
+    }
+
+    status_t SampleStreamer::streaming_thread(void *arg)
+    {
+        SampleStreamer *_this = reinterpret_cast<SampleStreamer *>(arg);
+        _this->run_streaming();
+        return STATUS_OK;
+    }
+
+    void SampleStreamer::run_streaming()
+    {
+        // Enable DSP context for the streaming thread
+        dsp::context_t ctx;
+        dsp::start(&ctx);
+
+        while (!ipc::Thread::is_cancelled())
+        {
+            sWakeup.wait(STREAMER_WAIT_PERIOD);
+
+            // Fill voices until there is nothing to do
+            bool work;
+            do
+            {
+                work    = false;
+
+                for (size_t i=0; i<nVoices; ++i)
+                {
+                    voice_t *v      = &vVoices[i];
+                    switch (v->nState)
+                    {
+                        case VS_ACTIVE:
+                            if (fill_voice(v))
+                                work        = true;
+                            break;
+                        case VS_RELEASE:
+                            v->pStream      = NULL;
+                            atomic_cas(&v->nState, VS_RELEASE, VS_FREE);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            } while ((work) && (!ipc::Thread::is_cancelled()));
+        }
+
+        dsp::finish(&ctx);
+    }
+
+    bool SampleStreamer::fill_voice(voice_t *v)
+    {
+        uatomic_t head  = v->nHead;
+        uatomic_t tail  = v->nTail;
+
+        // Skip the data that was not fetched in time
+        atomic_t lag    = atomic_t(tail - head);
+        if (lag > 0)
+        {
+            v->nPosition   += lag;
+            head           += lag;
+        }
+        else
+            lag             = 0;
+
+        // Check that there is enough space in the ring buffer and the data to read
+        size_t space    = nRingSize - (head - tail);
+        if ((space < (nRingSize >> 2)) || (v->nPosition >= v->nEnd))
+        {
+            if (lag > 0)
+                atomic_add(&v->nHead, lag);
+            return false;
+        }
+
+        // Read interleaved frames
+        AudioStream *s  = v->pStream;
+        size_t channels = s->channels();
+        size_t to_read  = lsp_min(space, v->nEnd - v->nPosition);
+        to_read         = lsp_min(to_read, nBufSize / channels);
+
+        ssize_t frames  = s->read_frames(vBuffer, v->nPosition, to_read);
+        if (frames <= 0)
+        {
+            // Stop streaming, the missing data will be replaced with zeros
+            lsp_trace("stream read error at position %d, code=%d", int(v->nPosition), int(-frames));
+            v->nEnd         = v->nPosition;
+            if (lag > 0)
+                atomic_add(&v->nHead, lag);
+            return false;
+        }
+
+        // Deploy the channel data to the ring buffer
+        const float *src    = &vBuffer[v->nChannel];
+        size_t mask         = nRingSize - 1;
+        for (ssize_t i=0; i<frames; ++i, src += channels)
+            v->vRing[(head + i) & mask] = *src;
+
+        // Commit the data
+        v->nPosition       += frames;
+        atomic_add(&v->nHead, uatomic_t(frames + lag));
+
+        return true;
+    }
+
+    SampleStreamer::voice_t *SampleStreamer::acquire(AudioStream *stream, size_t channel, size_t offset, size_t count)
+    {
+        if ((stream == NULL) || (channel >= stream->channels()))
+            return NULL;
+
+        for (size_t i=0; i<nVoices; ++i)
+        {
+            voice_t *v      = &vVoices[i];
+            if (v->nState != VS_FREE)
+                continue;
+
+            // Configure the voice and pass it to the streaming thread
+            v->pStream      = stream;
+            v->nChannel     = channel;
+            v->nPosition    = offset;
+            v->nEnd         = offset + count;
+            v->nLength      = count;
+            v->nHead        = 0;
+            v->nTail        = 0;
+            atomic_swap(&v->nState, VS_ACTIVE);
+            sWakeup.post();
+
+            return v;
+        }
+
+        // All voices are in use, the playback will be cut to the preloaded part of the sample
+        lsp_trace("no free voices to stream %d samples at offset %d", int(count), int(offset));
+        atomic_add(&nDropped, 1);
+
+        return NULL;
+    }
+
+    size_t SampleStreamer::read(voice_t *v, float *dst, size_t count)
+    {
+        uatomic_t head  = v->nHead;
+        uatomic_t tail  = v->nTail;
+        atomic_t avail  = atomic_t(head - tail);
+        size_t n        = (avail > 0) ? lsp_min(size_t(avail), count) : 0;
+
+        // Copy available data
+        if (n > 0)
+        {
+            size_t off      = tail & (nRingSize - 1);
+            size_t first    = lsp_min(n, nRingSize - off);
+            dsp::copy(dst, &v->vRing[off], first);
+            if (n > first)
+                dsp::copy(&dst[first], v->vRing, n - first);
+        }
+
+        // Fill missing data with zeros, it is an underrun only if the voice
+        // still had data to deliver and not the regular end of the sample
+        if (n < count)
+        {
+            dsp::fill_zero(&dst[n], count - n);
+            if ((size_t(tail) + n) < v->nLength)
+                atomic_add(&nUnderruns, 1);
+        }
+
+        atomic_add(&v->nTail, uatomic_t(count));
+
+        // Wake up the streaming thread if the ring buffer has been drained enough
+        if ((avail - atomic_t(count)) < atomic_t(nRingSize >> 1))
+            sWakeup.post();
+
+        return n;
+    }
+
+    void SampleStreamer::release(voice_t *v)
+    {
+        if (v == NULL)
+            return;
+        atomic_swap(&v->nState, VS_RELEASE);
+        sWakeup.post();
+    }
+
+    void SampleStreamer::unlink(const AudioStream *stream)
+    {
+        while (true)
+        {
+            bool found  = false;
+            for (size_t i=0; i<nVoices; ++i)
+            {
+                voice_t *v      = &vVoices[i];
+                if ((v->nState != VS_FREE) && (v->pStream == stream))
+                {
+                    found           = true;
+                    break;
+                }
+            }
+
+            if ((!found) || (pThread == NULL))
+                break;
+
+            sWakeup.post();
+            ipc::Thread::sleep(1);
+        }
+    }
+
+} /* namespace lsp */
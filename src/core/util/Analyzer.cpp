@@ -27,7 +27,12 @@
 
 namespace lsp
 {
-    
+    // Odd taps of the half-band decimation filter, the central tap is 0.5
+    static const float hb_kernel[] =
+    {
+        0.305787204f, -0.073154504f, 0.021654296f, -0.004612275f, 0.000325278f
+    };
+
     Analyzer::Analyzer()
     {
         construct();
@@ -43,6 +48,10 @@ namespace lsp
         nChannels       = 0;
         nMaxRank        = 0;
         nRank           = 0;
+        nMaxLevels      = 1;
+        nLevels         = 1;
+        nFftLevels      = 1;
+        nFftRank        = 0;
         nSampleRate     = 0;
         nMaxSampleRate  = 0;
         nBufSize        = 0;
@@ -66,6 +75,15 @@ namespace lsp
         vFftReIm        = NULL;
         vWindow         = NULL;
         vEnvelope       = NULL;
+
+        for (size_t i=0; i<(ANALYZER_LEVELS_MAX - 1); ++i)
+        {
+            decimator_t *d  = &vDecim[i];
+            d->nBufSize     = 0;
+            d->nHead        = 0;
+            d->nHistPos     = 0;
+            d->nPhase       = 0;
+        }
     }
 
     void Analyzer::destroy()
@@ -79,16 +97,31 @@ namespace lsp
         free_aligned(vData);
     }
 
-    bool Analyzer::init(size_t channels, size_t max_rank, size_t max_sr, float min_rate)
+    bool Analyzer::init(size_t channels, size_t max_rank, size_t max_sr, float min_rate, size_t max_levels)
     {
         destroy();
 
+        if ((max_levels < 1) || (max_levels > ANALYZER_LEVELS_MAX) || (max_levels > max_rank))
+            return false;
+
         size_t fft_size         = 1 << max_rank;
-        nBufSize                = ALIGN_SIZE(fft_size + size_t(float(max_sr * 2) / min_rate) + DEFAULT_ALIGN, DEFAULT_ALIGN);
+        size_t period           = float(max_sr * 2) / min_rate;
+        nBufSize                = ALIGN_SIZE(fft_size + period + DEFAULT_ALIGN, DEFAULT_ALIGN);
+
+        // Decimated levels perform FFT of at most half of the maximum size
+        size_t dec_size         = 0;
+        for (size_t i=1; i<max_levels; ++i)
+        {
+            decimator_t *d          = &vDecim[i-1];
+            d->nBufSize             = ALIGN_SIZE((fft_size >> 1) + (period >> i) + DEFAULT_ALIGN, DEFAULT_ALIGN);
+            dec_size               += d->nBufSize + ANALYZER_FIR_HISTORY * 2;
+        }
+
         size_t allocate         = 5 * fft_size +                // vSigRe, vFftReIm (re + im), vWindow, vEnvelope
                                   channels * nBufSize +         // c->vBuffer
                                   channels * fft_size +         // c->vAmp
-                                  channels * fft_size;          // c->vData
+                                  channels * fft_size +         // c->vData
+                                  channels * dec_size;          // c->vLevels
 
         // Allocate data
         float *abuf         = alloc_aligned<float>(vData, allocate);
@@ -106,6 +139,8 @@ namespace lsp
         nChannels           = channels;
         nMaxRank            = max_rank;
         nRank               = max_rank;
+        nMaxLevels          = max_levels;
+        nLevels             = 1;
         nMaxSampleRate      = max_sr;
         fMinRate            = min_rate;
 
@@ -136,6 +171,24 @@ namespace lsp
             c->vData            = abuf;
             abuf               += fft_size;
 
+            // Decimated levels
+            for (size_t j=1; j<ANALYZER_LEVELS_MAX; ++j)
+            {
+                level_t *l          = &c->vLevels[j-1];
+                if (j < max_levels)
+                {
+                    l->vBuffer          = abuf;
+                    abuf               += vDecim[j-1].nBufSize;
+                    l->vHistory         = abuf;
+                    abuf               += ANALYZER_FIR_HISTORY * 2;
+                }
+                else
+                {
+                    l->vBuffer          = NULL;
+                    l->vHistory         = NULL;
+                }
+            }
+
             // Counters
             c->nDelay           = 0;
             c->bFreeze          = false;
@@ -215,6 +268,17 @@ namespace lsp
         return true;
     }
 
+    bool Analyzer::set_levels(size_t levels)
+    {
+        if ((levels < 1) || (levels > nMaxLevels))
+            return false;
+        else if (nLevels == levels)
+            return true;
+        nLevels         = levels;
+        nReconfigure   |= R_ALL;
+        return true;
+    }
+
     bool Analyzer::freeze_channel(size_t channel, bool freeze)
     {
         if (channel >= nChannels)
@@ -240,16 +304,20 @@ namespace lsp
         if (!nReconfigure)
             return;
 
+        // Each level should perform at least 4-point FFT
+        nFftLevels          = lsp_min(nLevels, nRank - 1);
+        nFftRank            = nRank - nFftLevels + 1;
+
         size_t fft_size     = 1 << nRank;
         size_t fft_period   = float(nSampleRate) / fRate;
         nStep               = fft_period / nChannels;
         nPeriod             = nStep * nChannels;
 
-        // Update envelope
+        // Update envelope, amplitudes of all levels are normalized to the size of their FFT
         if (nReconfigure & R_ENVELOPE)
         {
             envelope::reverse_noise(vEnvelope, fft_size, envelope::envelope_t(nEnvelope));
-            dsp::mul_k2(vEnvelope, fShift / fft_size, fft_size);
+            dsp::mul_k2(vEnvelope, fShift / (1 << nFftRank), fft_size);
         }
 
         // Clear analysis
@@ -257,13 +325,30 @@ namespace lsp
         {
             for (size_t i=0; i<nChannels; ++i)
             {
-                dsp::fill_zero(vChannels[i].vAmp, fft_size);
-                dsp::fill_zero(vChannels[i].vData, fft_size);
+                channel_t *c        = &vChannels[i];
+                dsp::fill_zero(c->vBuffer, nBufSize);
+                dsp::fill_zero(c->vAmp, fft_size);
+                dsp::fill_zero(c->vData, fft_size);
+
+                for (size_t j=1; j<nMaxLevels; ++j)
+                {
+                    level_t *l          = &c->vLevels[j-1];
+                    dsp::fill_zero(l->vBuffer, vDecim[j-1].nBufSize);
+                    dsp::fill_zero(l->vHistory, ANALYZER_FIR_HISTORY * 2);
+                }
+            }
+
+            for (size_t j=1; j<nMaxLevels; ++j)
+            {
+                decimator_t *d      = &vDecim[j-1];
+                d->nHead            = 0;
+                d->nHistPos         = 0;
+                d->nPhase           = 0;
             }
         }
         // Update window
         if (nReconfigure & R_WINDOW)
-            windows::window(vWindow, fft_size, windows::window_t(nWindow));
+            windows::window(vWindow, 1 << nFftRank, windows::window_t(nWindow));
         // Update reactivity
         if (nReconfigure & R_TAU)
             fTau    = 1.0f - expf(logf(1.0f - M_SQRT1_2) / seconds_to_samples(float(nSampleRate) / float(nPeriod), fReactivity));
@@ -288,8 +373,8 @@ namespace lsp
 
         // Do main processing
         channel_t *c;
-        ssize_t fft_size    = 1 << nRank;
-        ssize_t fft_csize   = (fft_size >> 1) + 1;
+        size_t fft_size     = 1 << nRank;
+        size_t fft_lsize    = 1 << nFftRank;
 
         for (size_t offset = 0; offset < samples; )
         {
@@ -315,32 +400,14 @@ namespace lsp
                 {
                     if ((bActive) && (c->bActive))
                     {
-                        // Get the time mark to start from
-                        ssize_t doff    = nHead - (fft_size + c->nDelay);
-
-//                        lsp_trace("channel=%d, head=%d, delay=%d, offset=%d, buf_size=%d, samples=%d",
-//                                int(channel), int(nHead), int(c->nDelay), int(doff), int(nBufSize), int(samples));
-
-                        if (doff < 0)
-                            doff           += nBufSize;
-
-                        // Prepare the real buffer
-                        ssize_t count   = nBufSize - doff;
-                        if (count < fft_size)
+                        // Analyze full-rate signal and all decimated levels, each level
+                        // is aligned to the same point in time
+                        analyze(c->vAmp, c->vBuffer, nBufSize, nHead, c->nDelay);
+                        for (size_t j=1; j<nFftLevels; ++j)
                         {
-                            dsp::mul3(vSigRe, &c->vBuffer[doff], vWindow, count);
-                            dsp::mul3(&vSigRe[count], c->vBuffer, &vWindow[count], fft_size - count);
+                            decimator_t *d  = &vDecim[j-1];
+                            analyze(&c->vAmp[j * fft_lsize], c->vLevels[j-1].vBuffer, d->nBufSize, d->nHead, c->nDelay >> j);
                         }
-                        else
-                            dsp::mul3(vSigRe, &c->vBuffer[doff], vWindow, fft_size);
-
-                        // Do Real->complex conversion and FFT
-                        dsp::pcomplex_r2c(vFftReIm, vSigRe, fft_size);
-                        dsp::packed_direct_fft(vFftReIm, vFftReIm, nRank);
-                        // Get complex argument
-                        dsp::pcomplex_mod(vFftReIm, vFftReIm, fft_csize);
-                        // Mix with the previous value
-                        dsp::mix2(c->vAmp, vFftReIm, 1.0 - fTau, fTau, fft_csize);
                     }
                     else
                         dsp::fill_zero(c->vAmp, fft_size);
@@ -379,6 +446,24 @@ namespace lsp
                 }
             }
 
+            // Commit data to decimated levels
+            if (nFftLevels > 1)
+            {
+                decimator_t dec[ANALYZER_LEVELS_MAX - 1];
+                for (size_t i=0; i<nChannels; ++i)
+                {
+                    // All channels have the same decimator state
+                    for (size_t j=1; j<nFftLevels; ++j)
+                        dec[j-1]            = vDecim[j-1];
+
+                    const float *src    = (in != NULL) ? in[i] : NULL;
+                    decimate(&vChannels[i], dec, (src != NULL) ? &src[offset] : NULL, to_process);
+                }
+
+                for (size_t j=1; j<nFftLevels; ++j)
+                    vDecim[j-1]         = dec[j-1];
+            }
+
             // Update positions
             offset     += to_process;
             nCounter   += to_process;
@@ -390,6 +475,92 @@ namespace lsp
         }
     }
 
+    void Analyzer::analyze(float *amp, const float *buf, size_t buf_size, size_t head, size_t delay)
+    {
+        ssize_t fft_size    = 1 << nFftRank;
+        ssize_t fft_csize   = (fft_size >> 1) + 1;
+
+        // Get the time mark to start from
+        ssize_t doff    = head - (fft_size + delay);
+
+//        lsp_trace("head=%d, delay=%d, offset=%d, buf_size=%d",
+//                int(head), int(delay), int(doff), int(buf_size));
+
+        if (doff < 0)
+            doff           += buf_size;
+
+        // Prepare the real buffer
+        ssize_t count   = buf_size - doff;
+        if (count < fft_size)
+        {
+            dsp::mul3(vSigRe, &buf[doff], vWindow, count);
+            dsp::mul3(&vSigRe[count], buf, &vWindow[count], fft_size - count);
+        }
+        else
+            dsp::mul3(vSigRe, &buf[doff], vWindow, fft_size);
+
+        // Do Real->complex conversion and FFT
+        dsp::pcomplex_r2c(vFftReIm, vSigRe, fft_size);
+        dsp::packed_direct_fft(vFftReIm, vFftReIm, nFftRank);
+        // Get complex argument
+        dsp::pcomplex_mod(vFftReIm, vFftReIm, fft_csize);
+        // Mix with the previous value
+        dsp::mix2(amp, vFftReIm, 1.0 - fTau, fTau, fft_csize);
+    }
+
+    void Analyzer::decimate(channel_t *c, decimator_t *d, const float *src, size_t count)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            float s         = (src != NULL) ? src[i] : 0.0f;
+
+            // Pass the sample down through the levels, each level produces one
+            // sample of output per two samples of input
+            for (size_t j=1; j<nFftLevels; ++j)
+            {
+                decimator_t *xd = &d[j-1];
+                level_t *l      = &c->vLevels[j-1];
+
+                // Store sample twice to keep the filter window contiguous
+                l->vHistory[xd->nHistPos]                           = s;
+                l->vHistory[xd->nHistPos + ANALYZER_FIR_HISTORY]    = s;
+                xd->nHistPos    = (xd->nHistPos + 1) & (ANALYZER_FIR_HISTORY - 1);
+                xd->nPhase     ^= 1;
+                if (xd->nPhase)
+                    break;
+
+                // Apply half-band filter to the last ANALYZER_FIR_TAPS samples
+                const float *x  = &l->vHistory[xd->nHistPos + ANALYZER_FIR_HISTORY - ANALYZER_FIR_TAPS];
+                s               = 0.5f * x[9] +
+                                  hb_kernel[0] * (x[8] + x[10]) +
+                                  hb_kernel[1] * (x[6] + x[12]) +
+                                  hb_kernel[2] * (x[4] + x[14]) +
+                                  hb_kernel[3] * (x[2] + x[16]) +
+                                  hb_kernel[4] * (x[0] + x[18]);
+
+                l->vBuffer[xd->nHead]   = s;
+                if ((++xd->nHead) >= xd->nBufSize)
+                    xd->nHead       = 0;
+            }
+        }
+    }
+
+    size_t Analyzer::bin_index(size_t idx) const
+    {
+        if (nFftLevels <= 1)
+            return idx;
+
+        // Level j is decimated by 2^j and is used for frequencies below
+        // the half of it's Nyquist frequency, the deepest level covers the
+        // lowest frequencies with the resolution of the full-rank FFT
+        size_t fft_size     = 1 << nRank;
+        size_t level        = nFftLevels - 1;
+        while ((level > 0) && (idx >= (fft_size >> (level + 2))))
+            --level;
+
+        return (level << nFftRank) + (idx >> (nFftLevels - 1 - level));
+    }
+
     bool Analyzer::read_frequencies(float *frq, float start, float stop, size_t count, size_t flags)
     {
         if ((vChannels == NULL) || (count == 0))
@@ -428,10 +599,21 @@ namespace lsp
             return false;
 
         channel_t *c        = &vChannels[channel];
-        for (size_t i=0; i<count; ++i)
+        if (nFftLevels > 1)
+        {
+            for (size_t i=0; i<count; ++i)
+            {
+                size_t j            = idx[i];
+                out[i]              = c->vData[bin_index(j)] * vEnvelope[j];
+            }
+        }
+        else
         {
-            size_t j            = idx[i];
-            out[i]              = c->vData[j] * vEnvelope[j];
+            for (size_t i=0; i<count; ++i)
+            {
+                size_t j            = idx[i];
+                out[i]              = c->vData[j] * vEnvelope[j];
+            }
         }
 
         return true;
@@ -442,7 +624,7 @@ namespace lsp
         if ((vChannels == NULL) || (channel >= nChannels))
             return 0.0f;
 
-        return vChannels[channel].vData[idx] * vEnvelope[idx];
+        return vChannels[channel].vData[bin_index(idx)] * vEnvelope[idx];
     }
 
     void Analyzer::get_frequencies(float *frq, uint32_t *idx, float start, float stop, size_t count)
@@ -471,6 +653,10 @@ namespace lsp
         v->write("nChannels", nChannels);
         v->write("nMaxRank", nMaxRank);
         v->write("nRank", nRank);
+        v->write("nMaxLevels", nMaxLevels);
+        v->write("nLevels", nLevels);
+        v->write("nFftLevels", nFftLevels);
+        v->write("nFftRank", nFftRank);
         v->write("nSampleRate", nSampleRate);
         v->write("nMaxSampleRate", nMaxSampleRate);
         v->write("nBufSize", nBufSize);
@@ -500,6 +686,33 @@ namespace lsp
                 v->write("nDelay", c->nDelay);
                 v->write("bFreeze", c->bFreeze);
                 v->write("bActive", c->bActive);
+                v->begin_array("vLevels", c->vLevels, nMaxLevels - 1);
+                for (size_t j=1; j<nMaxLevels; ++j)
+                {
+                    const level_t *l = &c->vLevels[j-1];
+                    v->begin_object(l, sizeof(level_t));
+                    {
+                        v->write("vBuffer", l->vBuffer);
+                        v->write("vHistory", l->vHistory);
+                    }
+                    v->end_object();
+                }
+                v->end_array();
+            }
+            v->end_object();
+        }
+        v->end_array();
+
+        v->begin_array("vDecim", vDecim, nMaxLevels - 1);
+        for (size_t j=1; j<nMaxLevels; ++j)
+        {
+            const decimator_t *d = &vDecim[j-1];
+            v->begin_object(d, sizeof(decimator_t));
+            {
+                v->write("nBufSize", d->nBufSize);
+                v->write("nHead", d->nHead);
+                v->write("nHistPos", d->nHistPos);
+                v->write("nPhase", d->nPhase);
             }
             v->end_object();
         }
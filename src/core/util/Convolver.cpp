@@ -31,6 +31,12 @@
 
 #define CONVOLVER_DATA_ALIGN                0x40
 
+// States of the tail block
+#define TAIL_FREE                           0       /* Block is not claimed yet */
+#define TAIL_BUSY                           1       /* Block is being computed by the worker thread */
+#define TAIL_DONE                           2       /* Block has been computed by the worker thread */
+#define TAIL_TAKEN                          3       /* Block has been claimed by the processing thread */
+
 namespace lsp
 {
     Convolver::Convolver()
@@ -62,15 +68,101 @@ namespace lsp
         nBlocksDone         = 0;
         nRank               = 0;
 
+        vTailData           = NULL;
+        vTailBuffer         = NULL;
+        vTailState          = NULL;
+        pWorker             = NULL;
+        bTailPending        = false;
+        bWorkerHold         = false;
+
         vData               = NULL;
     }
 
     void Convolver::destroy()
     {
+        // Stop the worker thread first, it may still access the data
+        if (pWorker != NULL)
+        {
+            pWorker->cancel();
+            sWakeup.post();
+            pWorker->join();
+            delete pWorker;
+            pWorker             = NULL;
+        }
+
         free_aligned(vData);
         construct();
     }
 
+    status_t Convolver::tail_worker(void *arg)
+    {
+        Convolver *_this = reinterpret_cast<Convolver *>(arg);
+        _this->run_tail_worker();
+        return STATUS_OK;
+    }
+
+    void Convolver::run_tail_worker()
+    {
+        // Enable DSP context for the worker thread
+        dsp::context_t ctx;
+        dsp::start(&ctx);
+
+        size_t fft_step     = 1 << (nRank + 1);
+        size_t slot_size    = nFrameSize << 1;
+
+        while (true)
+        {
+            sWakeup.wait();
+            if (ipc::Thread::is_cancelled())
+                break;
+            if (bWorkerHold)
+                continue;
+
+            // The first block is always applied by the processing thread
+            for (size_t i=1; i<nBlocks; ++i)
+            {
+                if (!atomic_cas(&vTailState[i], TAIL_FREE, TAIL_BUSY))
+                    continue;
+
+                // Compute the block into its own slot, the result is published only
+                // if the processing thread did not take the block over in the meantime
+                float *slot         = &vTailData[i * slot_size];
+                dsp::fill_zero(slot, slot_size);
+                dsp::fastconv_apply(slot, vTailBuffer, &vConvData[(i + 1) * fft_step], vTaskData, nRank);
+                atomic_cas(&vTailState[i], TAIL_BUSY, TAIL_DONE);
+            }
+        }
+
+        dsp::finish(&ctx);
+    }
+
+    void Convolver::complete_tail()
+    {
+        if (!bTailPending)
+            return;
+
+        // The task has been issued one frame ago, the data buffer has already been
+        // shifted. Blocks the worker thread was late for have been already applied by
+        // the processing thread during the frame, the block the worker thread is
+        // computing right now is applied here, so the processing thread never waits
+        // for the worker thread.
+        size_t fft_step     = 1 << (nRank + 1);
+        size_t slot_size    = nFrameSize << 1;
+
+        for (size_t i=1; i<nBlocks; ++i)
+        {
+            float *dst          = &vDataBuffer[(i - 1) * nFrameSize];
+
+            if ((atomic_cas(&vTailState[i], TAIL_FREE, TAIL_TAKEN)) ||
+                (atomic_cas(&vTailState[i], TAIL_BUSY, TAIL_TAKEN)))
+                dsp::fastconv_apply(dst, vConvBuffer, &vConvData[(i + 1) * fft_step], vTaskData, nRank);
+            else if (atomic_cas(&vTailState[i], TAIL_DONE, TAIL_TAKEN))
+                dsp::add2(dst, &vTailData[i * slot_size], slot_size);
+        }
+
+        bTailPending        = false;
+    }
+
 //    static void dump(const float *buf, size_t count, const char *fmt, ...)
 //    {
 //        va_list args;
@@ -107,7 +199,7 @@ namespace lsp
 //        fprintf(stderr, "\n");
 //    }
 
-    bool Convolver::init(const float *data, size_t count, size_t rank, float phase)
+    bool Convolver::init(const float *data, size_t count, size_t rank, float phase, convolver_mode_t mode)
     {
         // Check arguments
         if (count <= 0)
@@ -131,6 +223,12 @@ namespace lsp
         allocate               += fft_buf_size;                     // Task data for tail convolution
         allocate               += bins * fft_buf_size;              // FFT convolution data
         allocate               += direct_buf_size;                  // Direct convolution data
+        if (mode == CONV_MODE_THREADED)
+        {
+            allocate               += bins * data_buf_size * 2;     // Per-block output slots
+            allocate               += fft_buf_size;                 // Convolution buffer of the worker thread
+            allocate               += ALIGN_SIZE(bins, CONVOLVER_DATA_ALIGN/sizeof(float)); // Per-block claim states
+        }
 
         // Allocate buffer and clear
         uint8_t *pdata          = NULL;
@@ -168,6 +266,23 @@ namespace lsp
         vDirectData             = fptr;
         fptr                   += direct_buf_size;
 
+        if (mode == CONV_MODE_THREADED)
+        {
+            // Per-block output slots
+            vTailData               = fptr;
+            fptr                   += bins * data_buf_size * 2;
+
+            // Convolution buffer of the worker thread
+            vTailBuffer             = fptr;
+            fptr                   += fft_buf_size;
+
+            // Per-block claim states, all blocks are initially claimed by the processing thread
+            vTailState              = reinterpret_cast<uatomic_t *>(fptr);
+            for (size_t i=0; i<bins; ++i)
+                vTailState[i]           = TAIL_TAKEN;
+            fptr                   += ALIGN_SIZE(bins, CONVOLVER_DATA_ALIGN/sizeof(float));
+        }
+
         // Validate allocation
         lsp_assert(fptr == &save[allocate]);
 
@@ -250,6 +365,20 @@ namespace lsp
 
         nRank                   = rank;
 
+        // Launch the worker thread only if there are tail blocks that can be computed ahead of time
+        if ((mode == CONV_MODE_THREADED) && (nBlocks > 1))
+        {
+            ipc::Thread *worker     = new ipc::Thread(tail_worker, this);
+            if (worker == NULL)
+                return true;
+            if (worker->start() != STATUS_OK)
+            {
+                delete worker;
+                return true;
+            }
+            pWorker                 = worker;
+        }
+
         return true;
     }
 
@@ -306,11 +435,29 @@ namespace lsp
                     // Need to reset tasks?
                     if (mask & 1)
                     {
+                        // Commit the result of the previous tail task
+                        if (pWorker != NULL)
+                            complete_tail();
+
                         dsp::fastconv_parse(vTaskData, vFrame - nFrameSize, nRank);
                         nBlocksDone         = 0;
+
+                        // Apply the first block immediately since it is required by the current frame,
+                        // other blocks will be applied by the worker thread until the next frame
+                        if (pWorker != NULL)
+                        {
+                            dsp::fastconv_apply(vDataBuffer, vConvBuffer, &vConvData[1 << (nRank + 1)], vTaskData, nRank);
+                            nBlocksDone         = 1;
+
+                            for (size_t i=1; i<nBlocks; ++i)
+                                atomic_swap(&vTailState[i], TAIL_FREE);
+                            bTailPending        = true;
+                            sWakeup.post();
+                        }
                     }
 
-                    // Need to execute tasks?
+                    // Need to execute tasks? In threaded mode the block is applied here only if
+                    // the worker thread is late and did not take it yet
                     size_t target_blk   = lsp_min(nBlocks, size_t(nBlkInit + fBlkCoef * sub_id));
                     size_t fft_step     = 1 << (nRank + 1);
                     conv                = &vConvData[(nBlocksDone + 1) * fft_step];     // Source convolution
@@ -318,7 +465,8 @@ namespace lsp
 
                     for ( ; nBlocksDone < target_blk; ++nBlocksDone)
                     {
-                        dsp::fastconv_apply(xdst, vConvBuffer, conv, vTaskData, rank);
+                        if ((pWorker == NULL) || (atomic_cas(&vTailState[nBlocksDone], TAIL_FREE, TAIL_TAKEN)))
+                            dsp::fastconv_apply(xdst, vConvBuffer, conv, vTaskData, rank);
                         xdst               += (fft_step >> 2);
                         conv               += fft_step;
                     }
@@ -371,6 +519,12 @@ namespace lsp
         v->write("nRank", nRank);
         v->write("nBlkInit", nBlkInit);
         v->write("fBlkCoef", fBlkCoef);
+        v->write("vTailData", vTailData);
+        v->write("vTailBuffer", vTailBuffer);
+        v->write("pWorker", pWorker);
+        v->write("vTailState", const_cast<uatomic_t *>(vTailState));
+        v->write("bTailPending", bTailPending);
+        v->write("bWorkerHold", bWorkerHold);
 
         v->write("vData", vData);
     }
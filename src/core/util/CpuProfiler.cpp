@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <core/util/CpuProfiler.h>
+#include <core/system.h>
+#include <core/LSPString.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CPU_PROFILER_ENV            "LSP_CPU_PROFILER"
+#define CPU_PROFILER_CALIBRATE      20000   /* Calibration time in microseconds */
+
+namespace lsp
+{
+    static double tick_freq     = 0.0;
+
+    CpuProfiler::CpuProfiler()
+    {
+        bEnabled        = false;
+        nSampleRate     = 0;
+        reset();
+
+        // Enable profiler if environment variable is set
+        LSPString value;
+        if (system::get_env_var(CPU_PROFILER_ENV, &value) == STATUS_OK)
+            bEnabled        = !((value.equals_ascii("0")) ||
+                                (value.equals_ascii_nocase("false")) ||
+                                (value.equals_ascii_nocase("off")));
+    }
+
+    CpuProfiler::~CpuProfiler()
+    {
+        bEnabled        = false;
+    }
+
+    CpuProfiler::tick_t CpuProfiler::ticks()
+    {
+    #if defined(ARCH_X86)
+        uint32_t lo, hi;
+        ARCH_X86_ASM("rdtsc" : "=a"(lo), "=d"(hi));
+        return (tick_t(hi) << 32) | lo;
+    #else
+        system::time_t ts;
+        system::get_time(&ts);
+        return tick_t(ts.seconds) * 1000000000ULL + ts.nanos;
+    #endif
+    }
+
+    double CpuProfiler::tick_frequency()
+    {
+        if (tick_freq > 0.0)
+            return tick_freq;
+
+    #if defined(ARCH_X86)
+        system::time_t t1, t2;
+
+        system::get_time(&t1);
+        tick_t c1       = ticks();
+        usleep(CPU_PROFILER_CALIBRATE);
+        system::get_time(&t2);
+        tick_t c2       = ticks();
+
+        double dt       = (double(t2.seconds) - double(t1.seconds)) + (double(t2.nanos) - double(t1.nanos)) * 1e-9;
+        tick_freq       = (dt > 0.0) ? double(c2 - c1) / dt : 1e+9;
+    #else
+        tick_freq       = 1e+9;
+    #endif
+
+        return tick_freq;
+    }
+
+    void CpuProfiler::set_enabled(bool enabled)
+    {
+        if (bEnabled == enabled)
+            return;
+        bEnabled        = enabled;
+        bBlock          = false;
+        nStage          = -1;
+    }
+
+    void CpuProfiler::reset()
+    {
+        bBlock          = false;
+        nStage          = -1;
+        nStages         = 0;
+        nBlockSamples   = 0;
+        nBlockStart     = 0;
+        nStageStart     = 0;
+
+        nBlocks         = 0;
+        nSamples        = 0;
+        nTicks          = 0;
+        nMaxTicks       = 0;
+        nMaxSamples     = 0;
+
+        nHead           = 0;
+        ::memset(vHistory, 0, sizeof(vHistory));
+        ::memset(vHistogram, 0, sizeof(vHistogram));
+        ::memset(vStages, 0, sizeof(vStages));
+    }
+
+    void CpuProfiler::begin_block(size_t samples)
+    {
+        for (size_t i=0; i<nStages; ++i)
+            vStages[i].nBlockTicks  = 0;
+
+        nStage          = -1;
+        nBlockSamples   = samples;
+        bBlock          = true;
+        nBlockStart     = ticks();
+        nStageStart     = nBlockStart;
+    }
+
+    void CpuProfiler::close_stage(tick_t now)
+    {
+        if (nStage < 0)
+            return;
+
+        stage_t *s          = &vStages[nStage];
+        s->nBlockTicks     += now - nStageStart;
+        nStage              = -1;
+    }
+
+    ssize_t CpuProfiler::find_stage(const char *name)
+    {
+        // Fast lookup: stage names are usually string literals
+        for (size_t i=0; i<nStages; ++i)
+            if (vStages[i].sName == name)
+                return i;
+
+        // Slow lookup: same name may be passed by different pointers
+        for (size_t i=0; i<nStages; ++i)
+            if (!::strcmp(vStages[i].sName, name))
+                return i;
+
+        // Register new stage
+        if (nStages >= CPU_PROFILER_STAGES_MAX)
+            return -1;
+
+        stage_t *s          = &vStages[nStages];
+        s->sName            = name;
+        s->nTicks           = 0;
+        s->nBlockTicks      = 0;
+        s->nMaxTicks        = 0;
+        s->nBlocks          = 0;
+
+        return nStages++;
+    }
+
+    void CpuProfiler::switch_stage(const char *name)
+    {
+        if (!bBlock)
+            return;
+
+        tick_t now          = ticks();
+        close_stage(now);
+        nStage              = find_stage(name);
+        nStageStart         = now;
+    }
+
+    void CpuProfiler::end_block()
+    {
+        if (!bBlock)
+            return;
+
+        tick_t now          = ticks();
+        close_stage(now);
+        bBlock              = false;
+
+        tick_t delta        = now - nBlockStart;
+
+        // Update stage statistics
+        for (size_t i=0; i<nStages; ++i)
+        {
+            stage_t *s          = &vStages[i];
+            if (s->nBlockTicks <= 0)
+                continue;
+            s->nTicks          += s->nBlockTicks;
+            s->nBlocks         ++;
+            if (s->nMaxTicks < s->nBlockTicks)
+                s->nMaxTicks        = s->nBlockTicks;
+        }
+
+        // Update overall statistics
+        nBlocks            ++;
+        nSamples           += nBlockSamples;
+        nTicks             += delta;
+        if (nMaxTicks < delta)
+        {
+            nMaxTicks           = delta;
+            nMaxSamples         = nBlockSamples;
+        }
+
+        // Update histogram: bucket index is log2 of the number of ticks per sample
+        if (nBlockSamples > 0)
+        {
+            tick_t tps          = (delta << CPU_PROFILER_BUCKET_SHIFT) / nBlockSamples;
+            size_t bucket       = 0;
+            while ((tps > 1) && (bucket < (CPU_PROFILER_BUCKETS - 1)))
+            {
+                tps               >>= 1;
+                ++bucket;
+            }
+            ++vHistogram[bucket];
+        }
+
+        // Commit the record to the history ring
+        record_t *r         = &vHistory[nHead % CPU_PROFILER_HISTORY_SIZE];
+        r->nSamples         = nBlockSamples;
+        r->nTicks           = delta;
+        atomic_add(&nHead, 1);
+    }
+
+    const char *CpuProfiler::stage_name(size_t index) const
+    {
+        return (index < nStages) ? vStages[index].sName : NULL;
+    }
+
+    float CpuProfiler::stage_share(size_t index) const
+    {
+        if ((index >= nStages) || (nTicks <= 0))
+            return 0.0f;
+        return double(vStages[index].nTicks) / double(nTicks);
+    }
+
+    void CpuProfiler::dump(IStateDumper *v) const
+    {
+        double freq     = tick_frequency();
+        double kt       = 1.0 / freq;
+        double srate    = nSampleRate;
+        double total    = nTicks * kt;
+        double play     = (srate > 0.0) ? nSamples / srate : 0.0;
+        double worst    = nMaxTicks * kt;
+        double wplay    = (srate > 0.0) ? nMaxSamples / srate : 0.0;
+
+        v->write("bEnabled", bEnabled);
+        v->write("nSampleRate", nSampleRate);
+        v->write("fTickFrequency", freq);
+        v->write("nBlocks", nBlocks);
+        v->write("nSamples", nSamples);
+        v->write("fTotalTime", total);
+        v->write("fAvgBlockTime", (nBlocks > 0) ? total / nBlocks : 0.0);
+        v->write("fWorstBlockTime", worst);
+        v->write("nWorstBlockSamples", nMaxSamples);
+        v->write("fThroughput", (total > 0.0) ? nSamples / total : 0.0);
+        v->write("fAvgLoad", (play > 0.0) ? total / play : 0.0);
+        v->write("fWorstLoad", (wplay > 0.0) ? worst / wplay : 0.0);
+
+        v->begin_array("vStages", vStages, nStages);
+        {
+            for (size_t i=0; i<nStages; ++i)
+            {
+                const stage_t *s = &vStages[i];
+
+                v->begin_object(s, sizeof(stage_t));
+                {
+                    v->write("sName", s->sName);
+                    v->write("nBlocks", s->nBlocks);
+                    v->write("fTime", s->nTicks * kt);
+                    v->write("fWorstTime", s->nMaxTicks * kt);
+                    v->write("fShare", (nTicks > 0) ? double(s->nTicks) / double(nTicks) : 0.0);
+                }
+                v->end_object();
+            }
+        }
+        v->end_array();
+
+        // Histogram of per-block DSP load, only non-empty buckets
+        size_t buckets = 0;
+        for (size_t i=0; i<CPU_PROFILER_BUCKETS; ++i)
+            if (vHistogram[i] > 0)
+                ++buckets;
+
+        v->begin_array("vHistogram", vHistogram, buckets);
+        {
+            for (size_t i=0; i<CPU_PROFILER_BUCKETS; ++i)
+            {
+                if (vHistogram[i] <= 0)
+                    continue;
+
+                // Bucket i covers [2^i, 2^(i+1)) ticks per sample divided by 2^BUCKET_SHIFT
+                double tmin     = double(1ULL << i) / double(1 << CPU_PROFILER_BUCKET_SHIFT);
+                double tmax     = tmin * 2.0;
+
+                v->begin_object(&vHistogram[i], sizeof(uint64_t));
+                {
+                    v->write("fMinTime", tmin * kt);
+                    v->write("fMaxTime", tmax * kt);
+                    v->write("fMinLoad", tmin * kt * srate);
+                    v->write("fMaxLoad", tmax * kt * srate);
+                    v->write("nBlocks", vHistogram[i]);
+                }
+                v->end_object();
+            }
+        }
+        v->end_array();
+
+        // Recent history of blocks, oldest first
+        size_t head     = nHead;
+        size_t count    = lsp_min(head, size_t(CPU_PROFILER_HISTORY_SIZE));
+        v->begin_array("vHistory", vHistory, count);
+        {
+            for (size_t i=head - count; i<head; ++i)
+            {
+                const record_t *r = &vHistory[i % CPU_PROFILER_HISTORY_SIZE];
+                double t        = r->nTicks * kt;
+                double p        = (srate > 0.0) ? r->nSamples / srate : 0.0;
+
+                v->begin_object(r, sizeof(record_t));
+                {
+                    v->write("nSamples", r->nSamples);
+                    v->write("fTime", t);
+                    v->write("fLoad", (p > 0.0) ? t / p : 0.0);
+                }
+                v->end_object();
+            }
+        }
+        v->end_array();
+    }
+
+} /* namespace lsp */
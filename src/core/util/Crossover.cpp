@@ -25,8 +25,26 @@
 #include <core/sugar.h>
 #include <core/stdlib/math.h>
 
+#define XOVER_FFT_RANK_MIN      6
+#define XOVER_FFT_RANK_MAX      16
+
 namespace lsp
 {
+    Crossover::KernelBuilder::KernelBuilder(Crossover *core)
+    {
+        pCore       = core;
+    }
+
+    Crossover::KernelBuilder::~KernelBuilder()
+    {
+        pCore       = NULL;
+    }
+
+    status_t Crossover::KernelBuilder::run()
+    {
+        return pCore->build_kernels();
+    }
+
     Crossover::Crossover()
     {
         construct();
@@ -52,6 +70,22 @@ namespace lsp
         vLpfBuf         = NULL;
         vHpfBuf         = NULL;
 
+        nType           = CROSS_TYPE_IIR;
+        nFftRank        = 0;
+        nFftOffset      = 0;
+        vFftIn          = NULL;
+        vFftSpec        = NULL;
+        vFftTmp         = NULL;
+
+        pBuilder        = NULL;
+        pExecutor       = NULL;
+        nKernelReq      = 0;
+        nKernelResp     = 0;
+        nKernelRate     = DEFAULT_SAMPLE_RATE;
+        vKernelBands    = NULL;
+        sKernelFilter.construct();
+        vKernelBuf      = NULL;
+
         pData           = NULL;
     }
 
@@ -67,23 +101,39 @@ namespace lsp
             }
         }
 
+        if (pBuilder != NULL)
+        {
+            delete pBuilder;
+            pBuilder        = NULL;
+        }
+        sKernelFilter.destroy();
+
         free_aligned(pData);
         construct();
     }
 
-    bool Crossover::init(size_t bands, size_t buf_size)
+    bool Crossover::init(size_t bands, size_t buf_size, size_t fft_rank)
     {
         if (bands < 1)
             return false;
+        if (fft_rank > 0)
+            fft_rank            = lsp_limit(fft_rank, size_t(XOVER_FFT_RANK_MIN), size_t(XOVER_FFT_RANK_MAX));
 
+        size_t fft_size     = (fft_rank > 0) ? (size_t(1) << fft_rank) : 0;
         size_t xbuf_size    = ALIGN_SIZE(buf_size * sizeof(float), DEFAULT_ALIGN);
         size_t band_size    = ALIGN_SIZE(bands * sizeof(band_t), DEFAULT_ALIGN);
         size_t split_size   = ALIGN_SIZE((bands - 1) * sizeof(split_t), DEFAULT_ALIGN);
         size_t plan_size    = ALIGN_SIZE((bands - 1) * sizeof(split_t *), DEFAULT_ALIGN);
+        size_t kband_size   = (fft_rank > 0) ? ALIGN_SIZE(bands * sizeof(kband_t), DEFAULT_ALIGN) : 0;
+        size_t fbuf_size    = ALIGN_SIZE(fft_size * sizeof(float), DEFAULT_ALIGN);
         size_t to_alloc     = band_size +
                               split_size +
                               plan_size +
-                              xbuf_size * 2;
+                              kband_size +
+                              xbuf_size * 2 +
+                              fbuf_size * 5 * bands +   // Two kernels and output buffer for each band
+                              fbuf_size * 5 +           // Input, spectrum and temporary buffers
+                              fbuf_size * 6;            // Buffers of the kernel builder
 
         // Allocate buffers
         uint8_t *data       = NULL;
@@ -99,20 +149,53 @@ namespace lsp
         ptr                += split_size;
         vPlan               = reinterpret_cast<split_t **>(ptr);
         ptr                += plan_size;
+        vKernelBands        = (fft_rank > 0) ? reinterpret_cast<kband_t *>(ptr) : NULL;
+        ptr                += kband_size;
         vLpfBuf             = reinterpret_cast<float *>(ptr);
         ptr                += xbuf_size;
         vHpfBuf             = reinterpret_cast<float *>(ptr);
         ptr                += xbuf_size;
 
+        if (fft_rank > 0)
+        {
+            vFftIn              = reinterpret_cast<float *>(ptr);
+            ptr                += fbuf_size;
+            vFftSpec            = reinterpret_cast<float *>(ptr);
+            ptr                += fbuf_size * 2;
+            vFftTmp             = reinterpret_cast<float *>(ptr);
+            ptr                += fbuf_size * 2;
+            vKernelBuf          = reinterpret_cast<float *>(ptr);
+            ptr                += fbuf_size * 6;
+        }
+
         // Initialize fields, keep sample_rate unchanged
         nReconfigure        = R_ALL;
         nSplits             = bands - 1;
         nBufSize            = buf_size;
         nPlanSize           = 0;
 
+        nType               = CROSS_TYPE_IIR;
+        nFftRank            = fft_rank;
+        nFftOffset          = 0;
+
+        nKernelReq          = 0;
+        nKernelResp         = 0;
+        nKernelRate         = nSampleRate;
+
         // Store allocated data pointer
         pData               = data;
 
+        // Initialize the kernel builder
+        if (fft_rank > 0)
+        {
+            pBuilder            = new KernelBuilder(this);
+            if ((pBuilder == NULL) || (!sKernelFilter.init(NULL)))
+            {
+                destroy();
+                return false;
+            }
+        }
+
         // Construct all splits
         float step          = logf(SPEC_FREQ_MAX / SPEC_FREQ_MIN) / bands;
 
@@ -164,8 +247,26 @@ namespace lsp
             sb->pObject         = NULL;
             sb->pSubject        = NULL;
             sb->nId             = i;
+
+            sb->vKernel         = NULL;
+            sb->vKernelNew      = NULL;
+            sb->vFftOut         = NULL;
+
+            if (fft_rank > 0)
+            {
+                sb->vKernel         = reinterpret_cast<float *>(ptr);
+                ptr                += fbuf_size * 2;
+                sb->vKernelNew      = reinterpret_cast<float *>(ptr);
+                ptr                += fbuf_size * 2;
+                sb->vFftOut         = reinterpret_cast<float *>(ptr);
+                ptr                += fbuf_size;
+            }
         }
 
+        // Clear FFT buffers
+        if (fft_rank > 0)
+            dsp::fill_zero(vFftIn, fft_size * (11 + bands * 5));
+
         lsp_assert(ptr <= &save[to_alloc]);
 
         return true;
@@ -183,6 +284,37 @@ namespace lsp
         }
     }
 
+    void Crossover::split_params(filter_params_t *fp, xover_type_t type, const split_t *sp, float gain)
+    {
+        fp->nType           = (sp != NULL) ? select_filter(type, sp->nMode) : FLT_NONE;
+        fp->fFreq           = (sp != NULL) ? sp->fFreq : 0.0f;
+        fp->fFreq2          = fp->fFreq;
+        fp->fGain           = gain;
+        fp->nSlope          = (sp != NULL) ? sp->nSlope : 0;
+        fp->fQuality        = 0.0f;
+    }
+
+    void Crossover::set_type(crossover_type_t type)
+    {
+        if ((type == CROSS_TYPE_FFT) && (nFftRank <= 0))
+            return;
+        if (type == nType)
+            return;
+
+        nType           = type;
+        nReconfigure   |= R_ALL;
+
+        // Reset state of the FFT processing
+        if (nFftRank > 0)
+        {
+            size_t fft_size = size_t(1) << nFftRank;
+            nFftOffset      = 0;
+            dsp::fill_zero(vFftIn, fft_size);
+            for (size_t i=0; i<=nSplits; ++i)
+                dsp::fill_zero(vBands[i].vFftOut, fft_size);
+        }
+    }
+
     void Crossover::set_slope(size_t sp, size_t slope)
     {
         if (sp >= nSplits)
@@ -432,12 +564,182 @@ namespace lsp
 
         // Reset reconfiguration flag
         nReconfigure        = 0;
+
+        // Request rebuild of band kernels
+        if (nType == CROSS_TYPE_FFT)
+            ++nKernelReq;
+    }
+
+    status_t Crossover::build_kernels()
+    {
+        size_t fft_size     = size_t(1) << nFftRank;
+        size_t half         = fft_size >> 1;
+        size_t kcenter      = half >> 1;
+        size_t points       = half + 1;
+        float *freqs        = vKernelBuf;
+        float *mag          = &freqs[fft_size];
+        float *tmp          = &mag[fft_size];
+        float *chart        = &tmp[fft_size * 2];
+        float kf            = float(nKernelRate) / float(fft_size);
+        float kw            = 2.0f * M_PI / half;
+
+        for (size_t i=0; i<points; ++i)
+            freqs[i]            = i * kf;
+
+        for (size_t i=0; i<=nSplits; ++i)
+        {
+            kband_t *kb         = &vKernelBands[i];
+            if (!kb->bEnabled)
+                continue;
+
+            // Compute magnitude of the band response
+            if ((kb->sHPF.nType == FLT_NONE) && (kb->sLPF.nType == FLT_NONE))
+                dsp::fill(mag, kb->fGain, points);
+            else
+                dsp::fill_one(mag, points);
+
+            for (size_t j=0; j<2; ++j)
+            {
+                filter_params_t *fp = (j > 0) ? &kb->sLPF : &kb->sHPF;
+                if (fp->nType == FLT_NONE)
+                    continue;
+
+                sKernelFilter.update(nKernelRate, fp);
+                sKernelFilter.rebuild();
+                sKernelFilter.freq_chart(tmp, freqs, points);
+                dsp::pcomplex_mod(chart, tmp, points);
+                dsp::mul2(mag, chart, points);
+            }
+
+            // Form zero-phase spectrum and compute the impulse response
+            for (size_t j=0; j<fft_size; ++j)
+            {
+                tmp[j*2]            = mag[(j <= half) ? j : fft_size - j];
+                tmp[j*2+1]          = 0.0f;
+            }
+            dsp::packed_reverse_fft(tmp, tmp, nFftRank);
+
+            // Center the impulse response in the kernel and apply window
+            for (size_t j=0; j<half; ++j)
+            {
+                size_t k            = (j + fft_size - kcenter) & (fft_size - 1);
+                chart[j]            = tmp[k*2] * (0.5f - 0.5f * cosf(kw * j));
+            }
+
+            // Convert kernel to fast convolution data
+            dsp::fastconv_parse(vBands[i].vKernelNew, chart, nFftRank);
+        }
+
+        return STATUS_OK;
+    }
+
+    void Crossover::swap_kernels()
+    {
+        for (size_t i=0; i<=nSplits; ++i)
+        {
+            band_t *b           = &vBands[i];
+            if (vKernelBands[i].bEnabled)
+                swap(b->vKernel, b->vKernelNew);
+        }
+    }
+
+    void Crossover::sync_kernels()
+    {
+        // Apply kernels built by the executor
+        if (pBuilder->completed())
+        {
+            if (pBuilder->successful())
+                swap_kernels();
+            pBuilder->reset();
+        }
+
+        // Check that kernels need to be rebuilt and the builder is not busy
+        if ((nKernelReq == nKernelResp) || (!pBuilder->idle()))
+            return;
+
+        // Make the snapshot of the band settings for the builder
+        nKernelRate         = nSampleRate;
+        for (size_t i=0; i<=nSplits; ++i)
+        {
+            band_t *b           = &vBands[i];
+            kband_t *kb         = &vKernelBands[i];
+
+            kb->bEnabled        = b->bEnabled;
+            kb->fGain           = b->fGain;
+            split_params(&kb->sHPF, FILTER_HPF, b->pStart, (b->pEnd != NULL) ? GAIN_AMP_0_DB : b->fGain);
+            split_params(&kb->sLPF, FILTER_LPF, b->pEnd, b->fGain);
+        }
+
+        // Build kernels in place if there is no executor
+        if (pExecutor == NULL)
+        {
+            build_kernels();
+            swap_kernels();
+            nKernelResp         = nKernelReq;
+        }
+        else if (pExecutor->submit(pBuilder))
+            nKernelResp         = nKernelReq;
+    }
+
+    void Crossover::process_fft_block()
+    {
+        size_t half         = size_t(1) << (nFftRank - 1);
+
+        // Perform the direct transform of the input block
+        dsp::fastconv_parse(vFftSpec, vFftIn, nFftRank);
+
+        for (size_t i=0; i<=nSplits; ++i)
+        {
+            band_t *b           = &vBands[i];
+
+            // Shift the overlap-add buffer
+            dsp::move(b->vFftOut, &b->vFftOut[half], half);
+            dsp::fill_zero(&b->vFftOut[half], half);
+
+            // Apply the kernel
+            if ((b->bEnabled) && (b->pFunc != NULL))
+                dsp::fastconv_apply(b->vFftOut, vFftTmp, b->vKernel, vFftSpec, nFftRank);
+        }
     }
 
     void Crossover::process(const float *in, size_t samples)
     {
         reconfigure();
 
+        if (nType == CROSS_TYPE_FFT)
+        {
+            size_t half         = size_t(1) << (nFftRank - 1);
+            sync_kernels();
+
+            for (size_t sample=0; sample < samples; )
+            {
+                size_t to_do        = lsp_min(lsp_min(samples - sample, half - nFftOffset), nBufSize);
+
+                // Store input data and call handlers for the output data of the previous block
+                dsp::copy(&vFftIn[nFftOffset], in, to_do);
+                for (size_t i=0; i<=nSplits; ++i)
+                {
+                    band_t *b           = &vBands[i];
+                    if ((b->bEnabled) && (b->pFunc != NULL))
+                        b->pFunc(b->pObject, b->pSubject, b->nId, &b->vFftOut[nFftOffset], sample, to_do);
+                }
+
+                // Process the input block
+                nFftOffset         += to_do;
+                if (nFftOffset >= half)
+                {
+                    process_fft_block();
+                    nFftOffset          = 0;
+                }
+
+                // Update pointers
+                in                 += to_do;
+                sample             += to_do;
+            }
+
+            return;
+        }
+
         for (size_t sample=0; sample < samples; )
         {
             size_t to_do        = lsp_min(samples - sample, nBufSize);
@@ -477,11 +779,54 @@ namespace lsp
 
             // Update pointers
             in                 += to_do;
-            sample             -= to_do;
+            sample             += to_do;
         }
     }
 
     bool Crossover::freq_chart(size_t band, float *re, float *im, const float *f, size_t count)
+    {
+        // Valid index of the band?
+        if (band > nSplits)
+            return false;
+
+        // FFT type has linear phase, return the magnitude
+        if (nType == CROSS_TYPE_FFT)
+        {
+            if (!iir_chart(band, re, im, f, count))
+                return false;
+            dsp::complex_mod(re, re, im, count);
+            dsp::fill_zero(im, count);
+            return true;
+        }
+
+        return iir_chart(band, re, im, f, count);
+    }
+
+    bool Crossover::freq_chart(size_t band, float *c, const float *f, size_t count)
+    {
+        // Valid index of the band?
+        if (band > nSplits)
+            return false;
+
+        // FFT type has linear phase, return the magnitude
+        if (nType == CROSS_TYPE_FFT)
+        {
+            if (!iir_chart(band, c, f, count))
+                return false;
+            for (size_t i=0; i<count; )
+            {
+                size_t to_do    = lsp_min(count - i, nBufSize);
+                dsp::pcomplex_mod(vLpfBuf, &c[i*2], to_do);
+                dsp::pcomplex_r2c(&c[i*2], vLpfBuf, to_do);
+                i              += to_do;
+            }
+            return true;
+        }
+
+        return iir_chart(band, c, f, count);
+    }
+
+    bool Crossover::iir_chart(size_t band, float *re, float *im, const float *f, size_t count)
     {
         // Valid index of the band?
         if (band > nSplits)
@@ -529,7 +874,7 @@ namespace lsp
         return true;
     }
 
-    bool Crossover::freq_chart(size_t band, float *c, const float *f, size_t count)
+    bool Crossover::iir_chart(size_t band, float *c, const float *f, size_t count)
     {
         // Valid index of the band?
         if (band > nSplits)
@@ -595,6 +940,10 @@ namespace lsp
                 v->write("pOpbject", b->pObject);
                 v->write("pSubject", b->pSubject);
                 v->write("nId", b->nId);
+
+                v->write("vKernel", b->vKernel);
+                v->write("vKernelNew", b->vKernelNew);
+                v->write("vFftOut", b->vFftOut);
             }
             v->end_object();
         }
@@ -623,6 +972,23 @@ namespace lsp
 
         v->write("vLpfBuf", vLpfBuf);
         v->write("vHpfBuf", vHpfBuf);
+
+        v->write("nType", nType);
+        v->write("nFftRank", nFftRank);
+        v->write("nFftOffset", nFftOffset);
+        v->write("vFftIn", vFftIn);
+        v->write("vFftSpec", vFftSpec);
+        v->write("vFftTmp", vFftTmp);
+
+        v->write("pBuilder", pBuilder);
+        v->write("pExecutor", pExecutor);
+        v->write("nKernelReq", nKernelReq);
+        v->write("nKernelResp", nKernelResp);
+        v->write("nKernelRate", nKernelRate);
+        v->write("vKernelBands", vKernelBands);
+        v->write_object("sKernelFilter", &sKernelFilter);
+        v->write("vKernelBuf", vKernelBuf);
+
         v->write("pData", pData);
     }
 
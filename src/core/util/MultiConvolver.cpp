@@ -0,0 +1,475 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <core/debug.h>
+#include <core/util/MultiConvolver.h>
+#include <core/sugar.h>
+
+#define CONVOLVER_MIN_CONV_BUF_SIZE         (1 << (CONVOLVER_RANK_MIN))
+#define CONVOLVER_MIN_DATA_BUF_SIZE         (1 << (CONVOLVER_RANK_MIN - 1))
+#define CONVOLVER_MIN_FFT_BUF_SIZE          (1 << (CONVOLVER_RANK_MIN + 1))
+
+#define CONVOLVER_DATA_ALIGN                0x40
+
+namespace lsp
+{
+    MultiConvolver::MultiConvolver()
+    {
+        construct();
+    }
+
+    MultiConvolver::~MultiConvolver()
+    {
+        destroy();
+    }
+
+    void MultiConvolver::construct()
+    {
+        vDataBuffer         = NULL;
+        vFrame              = NULL;
+        vTaskData           = NULL;
+        vSpecData           = NULL;
+        vKernels            = NULL;
+        vConvBuffer         = NULL;
+        vAccBuffer          = NULL;
+        vConvData           = NULL;
+        vDirectData         = NULL;
+
+        nInputs             = 0;
+        nOutputs            = 0;
+        nKernels            = 0;
+        nDataBufferSize     = 0;
+        nDirectStride       = 0;
+        nFrameSize          = 0;
+        nFrameOff           = 0;
+        nConvSize           = 0;
+        nLevels             = 0;
+        nBlocks             = 0;
+        nBlocksDone         = 0;
+        nRank               = 0;
+        nBlkInit            = 0;
+        fBlkCoef            = 0.0f;
+
+        vData               = NULL;
+    }
+
+    void MultiConvolver::destroy()
+    {
+        free_aligned(vData);
+        construct();
+    }
+
+    bool MultiConvolver::init(const float * const *data, const size_t *count, size_t inputs, size_t outputs, size_t rank, float phase)
+    {
+        // Compute the maximum kernel length
+        size_t kernels          = inputs * outputs;
+        size_t max_count        = 0;
+        for (size_t i=0; i<kernels; ++i)
+        {
+            if (data[i] != NULL)
+                max_count               = lsp_max(max_count, count[i]);
+        }
+
+        // Check arguments
+        if (max_count <= 0)
+        {
+            destroy();
+            return true;
+        }
+
+        // Determine number of buffers
+        rank                    = lsp_limit(ssize_t(rank), CONVOLVER_RANK_MIN, CONVOLVER_RANK_MAX);
+
+        // Determine size of buffer
+        size_t data_buf_size    = 1 << (rank - 1);
+        size_t fft_buf_size     = 1 << (rank + 1);
+        size_t direct_buf_size  = lsp_max(CONVOLVER_MIN_DATA_BUF_SIZE, int(CONVOLVER_DATA_ALIGN/sizeof(float)));
+        size_t bins             = (max_count + data_buf_size - 1) >> (rank - 1);
+
+        // Compute the partitioning scheme
+        size_t levels           = 0;
+        size_t blocks           = 0;
+        size_t left             = max_count - lsp_min(max_count, size_t(CONVOLVER_MIN_DATA_BUF_SIZE));
+        for (size_t brank = CONVOLVER_RANK_MIN; (left > 0) && (brank < rank); ++brank, ++levels)
+            left                   -= lsp_min(left, size_t(1 << (brank - 1)));
+        for ( ; left > 0; ++blocks)
+            left                   -= lsp_min(left, data_buf_size);
+
+        // Compute the size of the structural data
+        size_t szof_ptrs        = ALIGN_SIZE(sizeof(float *) * (outputs + inputs * 3), CONVOLVER_DATA_ALIGN);
+        size_t szof_kernels     = ALIGN_SIZE(sizeof(kernel_t) * kernels, CONVOLVER_DATA_ALIGN);
+
+        size_t allocate         = (bins + 1) * data_buf_size * outputs; // Size of data buffers (convolution tail)
+        allocate               += data_buf_size * 2 * inputs;           // Input data frames
+        allocate               += fft_buf_size * inputs;                // Task data for tail convolution
+        allocate               += fft_buf_size * inputs;                // Input spectrum of the partition
+        allocate               += fft_buf_size;                         // Convolution buffer
+        allocate               += fft_buf_size;                         // Accumulation buffer
+        allocate               += bins * fft_buf_size * kernels;        // FFT convolution data
+        allocate               += direct_buf_size * kernels;            // Direct convolution data
+
+        // Allocate buffer and clear
+        uint8_t *pdata          = NULL;
+        uint8_t *ptr            = alloc_aligned<uint8_t>(pdata, szof_ptrs + szof_kernels + allocate * sizeof(float), CONVOLVER_DATA_ALIGN);
+        if (ptr == NULL)
+            return false;
+
+        destroy();
+        vData                   = pdata;
+
+        // Structural data
+        float **pptr            = reinterpret_cast<float **>(ptr);
+        ptr                    += szof_ptrs;
+        vKernels                = reinterpret_cast<kernel_t *>(ptr);
+        ptr                    += szof_kernels;
+
+        float *fptr             = reinterpret_cast<float *>(ptr);
+        lsp_guard_assert(float *save = fptr);
+        dsp::fill_zero(fptr, allocate);                             // Cleanup all buffer data
+
+        vDataBuffer             = pptr;
+        pptr                   += outputs;
+        vFrame                  = pptr;
+        pptr                   += inputs;
+        vTaskData               = pptr;
+        pptr                   += inputs;
+        vSpecData               = pptr;
+        pptr                   += inputs;
+
+        // Perform initialization
+        for (size_t i=0; i<outputs; ++i)
+        {
+            vDataBuffer[i]          = fptr;
+            fptr                   += (bins + 1) * data_buf_size;
+        }
+
+        for (size_t i=0; i<inputs; ++i)
+        {
+            fptr                   += data_buf_size;
+            vFrame[i]               = fptr;
+            fptr                   += data_buf_size;
+        }
+
+        for (size_t i=0; i<inputs; ++i)
+        {
+            vTaskData[i]            = fptr;
+            fptr                   += fft_buf_size;
+        }
+
+        for (size_t i=0; i<inputs; ++i)
+        {
+            vSpecData[i]            = fptr;
+            fptr                   += fft_buf_size;
+        }
+
+        vConvBuffer             = fptr;
+        fptr                   += fft_buf_size;
+        vAccBuffer              = fptr;
+        fptr                   += fft_buf_size;
+        vConvData               = fptr;
+        fptr                   += bins * fft_buf_size * kernels;
+        vDirectData             = fptr;
+        fptr                   += direct_buf_size * kernels;
+
+        // Validate allocation
+        lsp_assert(fptr == &save[allocate]);
+
+        // Initialize simple values
+        nInputs                 = inputs;
+        nOutputs                = outputs;
+        nKernels                = kernels;
+        nDataBufferSize         = (bins + 1) * data_buf_size;
+        nDirectStride           = direct_buf_size;
+        nFrameSize              = data_buf_size;
+        nFrameOff               = size_t(phase * nFrameSize) % nFrameSize;
+        nConvSize               = max_count;
+        nLevels                 = levels;
+        nBlocks                 = blocks;
+
+        /* Calculate convolutions
+
+            Conv buffer layout, each partition stores the data of all kernels:
+            +---+---+------+------------+------------------------+
+            |FFT|FFT|FFT x2|   FFT x4   |       FFT x8           |  . . .
+            +---+---+------+------------+------------------------+
+         */
+
+        for (size_t k=0; k<kernels; ++k)
+        {
+            kernel_t *kd            = &vKernels[k];
+            const float *kdata      = data[k];
+            size_t kcount           = (kdata != NULL) ? count[k] : 0;
+
+            float *conv             = &vConvData[k * CONVOLVER_MIN_FFT_BUF_SIZE];
+            size_t brank            = CONVOLVER_RANK_MIN;
+
+            kd->nDirect             = lsp_min(kcount, size_t(CONVOLVER_MIN_DATA_BUF_SIZE));
+            kd->nParts              = 0;
+            if (kcount <= 0)
+                continue;
+
+            // Process direct convolution data
+            dsp::copy(&vDirectData[k * direct_buf_size], kdata, kd->nDirect);
+            dsp::fill_zero(vConvBuffer, fft_buf_size);
+            dsp::copy(vConvBuffer, kdata, kd->nDirect);
+            dsp::fastconv_parse(conv, vConvBuffer, brank);
+
+            kdata                  += kd->nDirect;
+            conv                   += (1 << (brank + 1)) * kernels;
+            kcount                 -= kd->nDirect;
+            kd->nParts              = 1;
+
+            // Prepare raising levels
+            for (size_t i=0; i<levels; ++i, ++brank)
+            {
+                size_t n                = lsp_min(kcount, size_t(1 << (brank - 1)));
+                size_t step             = 1 << (brank + 1);
+                if (n > 0)
+                {
+                    dsp::fill_zero(vConvBuffer, fft_buf_size);
+                    dsp::copy(vConvBuffer, kdata, n);
+                    dsp::fastconv_parse(&conv[k * (step - CONVOLVER_MIN_FFT_BUF_SIZE)], vConvBuffer, brank);
+                    kd->nParts             ++;
+                }
+
+                kdata                  += n;
+                conv                   += step * kernels;
+                kcount                 -= n;
+            }
+
+            // Prepare constant part
+            for (size_t i=0; i<blocks; ++i)
+            {
+                size_t n                = lsp_min(kcount, data_buf_size);
+                if (n > 0)
+                {
+                    dsp::fill_zero(vConvBuffer, fft_buf_size);
+                    dsp::copy(vConvBuffer, kdata, n);
+                    dsp::fastconv_parse(&conv[k * (fft_buf_size - CONVOLVER_MIN_FFT_BUF_SIZE)], vConvBuffer, rank);
+                    kd->nParts             ++;
+                }
+
+                kdata                  += n;
+                conv                   += fft_buf_size * kernels;
+                kcount                 -= n;
+            }
+
+            lsp_assert(conv <= &vDirectData[k * CONVOLVER_MIN_FFT_BUF_SIZE]);
+        }
+
+        nBlocksDone             = nBlocks;
+        ssize_t steps           = data_buf_size >> (CONVOLVER_RANK_MIN - 1);
+        if (steps <= 1)
+        {
+            nBlkInit                = nBlocks;
+            fBlkCoef                = 0.0f;
+        }
+        else
+        {
+            nBlkInit                = 1;
+            fBlkCoef                = (float(nBlocks) + 1e-3f) / (float(steps) - 1.0f);
+        }
+
+        nRank                   = rank;
+
+        return true;
+    }
+
+    void MultiConvolver::apply_partition(const float *conv, size_t part, float * const *spec, size_t rank, size_t off)
+    {
+        size_t fft_size     = 1 << (rank + 1);
+
+        for (size_t j=0; j<nOutputs; ++j)
+        {
+            // Accumulate spectrum of all kernels that contribute to the output
+            size_t applied      = 0;
+            for (size_t i=0; i<nInputs; ++i)
+            {
+                size_t k            = i * nOutputs + j;
+                if (part >= vKernels[k].nParts)
+                    continue;
+
+                if ((applied++) == 0)
+                    dsp::fill_zero(vAccBuffer, fft_size);
+                dsp::fastconv_fmadd(vAccBuffer, spec[i], &conv[k * fft_size], rank);
+            }
+
+            // Perform single reverse FFT per output
+            if (applied > 0)
+            {
+                dsp::fastconv_restore(vConvBuffer, vAccBuffer, rank);
+                dsp::add2(&vDataBuffer[j][off], vConvBuffer, fft_size >> 1);
+            }
+        }
+    }
+
+    void MultiConvolver::process(float * const *dst, const float * const *src, size_t count)
+    {
+        if (vData == NULL)
+        {
+            for (size_t j=0; j<nOutputs; ++j)
+                dsp::fill_zero(dst[j], count);
+            return;
+        }
+
+        for (size_t off=0; off < count; )
+        {
+            size_t sub_off      = nFrameOff & (CONVOLVER_MIN_DATA_BUF_SIZE - 1);        // Determine sub-offset in the frame
+
+            // We are strictly at the boundary of the frame?
+            if (sub_off == 0)
+            {
+                // Compute the trigger mask the same way the Convolver does
+                size_t sub_id       = nFrameOff >> (CONVOLVER_RANK_MIN - 1);
+                size_t mask         = ((sub_id-1) ^ sub_id);
+                size_t rank         = CONVOLVER_RANK_MIN;
+                size_t part         = 1;
+                const float *conv   = &vConvData[CONVOLVER_MIN_FFT_BUF_SIZE * nKernels];
+
+                // Apply convolution with raising level
+                for (size_t l=0; l<nLevels; ++l, ++part)
+                {
+                    if (mask & 1)
+                    {
+                        size_t delta        = 1 << (rank - 1);
+                        for (size_t i=0; i<nInputs; ++i)
+                            dsp::fastconv_parse(vSpecData[i], &vFrame[i][nFrameOff] - delta, rank);
+                        apply_partition(conv, part, vSpecData, rank, nFrameOff);
+                    }
+
+                    ++rank;
+                    conv               += (1 << rank) * nKernels;
+                    mask              >>= 1;
+                }
+
+                // Need to apply long tail?
+                if (nBlocks > 0)
+                {
+                    // Need to reset tasks?
+                    if (mask & 1)
+                    {
+                        for (size_t i=0; i<nInputs; ++i)
+                            dsp::fastconv_parse(vTaskData[i], vFrame[i] - nFrameSize, nRank);
+                        nBlocksDone         = 0;
+                    }
+
+                    // Need to execute tasks?
+                    size_t target_blk   = lsp_min(nBlocks, size_t(nBlkInit + fBlkCoef * sub_id));
+                    size_t fft_step     = (1 << (nRank + 1)) * nKernels;
+                    conv                = &vConvData[(nBlocksDone + 1) * fft_step];     // Source convolution
+
+                    for ( ; nBlocksDone < target_blk; ++nBlocksDone)
+                    {
+                        apply_partition(conv, nLevels + nBlocksDone + 1, vTaskData, nRank, nBlocksDone << (nRank - 1));
+                        conv               += fft_step;
+                    }
+                }
+            }
+
+            // Store data to frames
+            size_t to_do        = lsp_min(count - off, size_t(CONVOLVER_MIN_DATA_BUF_SIZE - sub_off));
+            for (size_t i=0; i<nInputs; ++i)
+                dsp::copy(&vFrame[i][nFrameOff], &src[i][off], to_do);
+
+            // Apply direct convolution
+            if (to_do == CONVOLVER_MIN_DATA_BUF_SIZE)
+            {
+                for (size_t i=0; i<nInputs; ++i)
+                    dsp::fastconv_parse(vSpecData[i], &src[i][off], CONVOLVER_RANK_MIN);
+                apply_partition(vConvData, 0, vSpecData, CONVOLVER_RANK_MIN, nFrameOff);
+            }
+            else
+            {
+                for (size_t i=0; i<nInputs; ++i)
+                    for (size_t j=0; j<nOutputs; ++j)
+                    {
+                        size_t k            = i * nOutputs + j;
+                        if (vKernels[k].nDirect > 0)
+                            dsp::convolve(&vDataBuffer[j][nFrameOff], &src[i][off], &vDirectData[k * nDirectStride], vKernels[k].nDirect, to_do);
+                    }
+            }
+
+            // Output result
+            for (size_t j=0; j<nOutputs; ++j)
+                dsp::copy(&dst[j][off], &vDataBuffer[j][nFrameOff], to_do);
+
+            // Update counters/pointers
+            nFrameOff          += to_do;
+            off                += to_do;
+
+            // Check that we are out of the frame and need to shift the data and convolution tail
+            if (nFrameOff >= nFrameSize)
+            {
+                nFrameOff          -= nFrameSize;
+                for (size_t i=0; i<nInputs; ++i)
+                    dsp::move(vFrame[i] - nFrameSize, vFrame[i], nFrameSize);
+                for (size_t j=0; j<nOutputs; ++j)
+                {
+                    dsp::move(vDataBuffer[j], &vDataBuffer[j][nFrameSize], nDataBufferSize - nFrameSize);
+                    dsp::fill_zero(&vDataBuffer[j][nDataBufferSize - nFrameSize], nFrameSize);
+                }
+            }
+        }
+    }
+
+    void MultiConvolver::dump(IStateDumper *v) const
+    {
+        v->writev("vDataBuffer", vDataBuffer, nOutputs);
+        v->writev("vFrame", vFrame, nInputs);
+        v->writev("vTaskData", vTaskData, nInputs);
+        v->writev("vSpecData", vSpecData, nInputs);
+        v->begin_array("vKernels", vKernels, nKernels);
+        for (size_t i=0; i<nKernels; ++i)
+        {
+            const kernel_t *k = &vKernels[i];
+            v->begin_object(k, sizeof(kernel_t));
+            {
+                v->write("nDirect", k->nDirect);
+                v->write("nParts", k->nParts);
+            }
+            v->end_object();
+        }
+        v->end_array();
+        v->write("vConvBuffer", vConvBuffer);
+        v->write("vAccBuffer", vAccBuffer);
+        v->write("vConvData", vConvData);
+        v->write("vDirectData", vDirectData);
+
+        v->write("nInputs", nInputs);
+        v->write("nOutputs", nOutputs);
+        v->write("nKernels", nKernels);
+        v->write("nDataBufferSize", nDataBufferSize);
+        v->write("nDirectStride", nDirectStride);
+        v->write("nFrameSize", nFrameSize);
+        v->write("nFrameOff", nFrameOff);
+        v->write("nConvSize", nConvSize);
+        v->write("nLevels", nLevels);
+        v->write("nBlocks", nBlocks);
+        v->write("nBlocksDone", nBlocksDone);
+        v->write("nRank", nRank);
+        v->write("nBlkInit", nBlkInit);
+        v->write("fBlkCoef", fBlkCoef);
+
+        v->write("vData", vData);
+    }
+
+} /* namespace lsp */
@@ -28,6 +28,18 @@
 #define OS_DOWN_BUFFER_SIZE     (12 * 1024)   /* Multiple of 3 and 4 */
 #define OS_CUTOFF               21000.0f
 
+#define OS_FIR_TAPS             48            /* Kernel length in original samples, also the latency of linear-phase FIR */
+#define OS_FIR_MAX_RATIO        32
+#define OS_FIR_PHASE_SIZE       (OS_FIR_TAPS + 1)
+#define OS_FIR_KERNEL_SIZE      (OS_FIR_PHASE_SIZE * OS_FIR_MAX_RATIO)
+#define OS_FIR_RATIO_SUM        (2 + 3 + 4 + 6 + 8 + 16 + 32)   /* Sum of ratios of all FIR modes */
+#define OS_FIR_BANK_SIZE        (OS_FIR_PHASE_SIZE * OS_FIR_RATIO_SUM * 4) /* Up and down kernels, linear and minimum phase */
+#define OS_FIR_BLOCK            (OS_UP_BUFFER_SIZE / OS_FIR_MAX_RATIO)
+#define OS_FIR_CUTOFF           1.0f          /* Cutoff (-6 dB) frequency relative to the Nyquist frequency of the original signal */
+#define OS_FIR_BETA             8.0f          /* Kaiser window parameter: passband is flat up to 0.9 of Nyquist, stopband starts at 1.1 */
+#define OS_FIR_MINPHASE_RANK    13            /* Rank of FFT used for minimum-phase kernel computation */
+#define OS_FIR_LOG_THRESH       1e-7f         /* Minimum magnitude of kernel spectrum when computing logarithm */
+
 namespace lsp
 {
     IOversamplerCallback::~IOversamplerCallback()
@@ -60,6 +72,19 @@ namespace lsp
         nUpdate     = UP_ALL;
         bData       = NULL;
         bFilter     = true;
+
+        vFirBank    = NULL;
+        vFirUp      = NULL;
+        vFirDown    = NULL;
+        vFirUpHist  = NULL;
+        vFirDownHist= NULL;
+        vFirGather  = NULL;
+        vFirAcc     = NULL;
+        nFirTaps    = OS_FIR_PHASE_SIZE;
+        nFirLatency = OS_FIR_TAPS;
+
+        for (size_t i=0; i<FIR_MODES; ++i)
+            vFirLatency[i]  = OS_FIR_TAPS;
     }
 
     bool Oversampler::init()
@@ -69,7 +94,11 @@ namespace lsp
 
         if (bData == NULL)
         {
-            size_t samples  = OS_UP_BUFFER_SIZE + OS_DOWN_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES;
+            size_t up_hist  = ALIGN_SIZE(OS_FIR_TAPS + OS_FIR_BLOCK, 16);
+            size_t gather   = ALIGN_SIZE(OS_FIR_BLOCK + OS_FIR_PHASE_SIZE, 16);
+            size_t acc      = ALIGN_SIZE(OS_FIR_BLOCK + OS_FIR_TAPS * 2, 16);
+            size_t samples  = OS_UP_BUFFER_SIZE + OS_DOWN_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES +
+                              OS_FIR_BANK_SIZE + OS_FIR_KERNEL_SIZE + up_hist + gather + acc;
             bData           = new uint8_t[samples * sizeof(float) + DEFAULT_ALIGN];
             if (bData == NULL)
                 return false;
@@ -78,14 +107,37 @@ namespace lsp
             ptr            += OS_DOWN_BUFFER_SIZE;
             fUpBuffer       = reinterpret_cast<float *>(ptr);
             ptr            += OS_UP_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES;
+            vFirBank        = ptr;
+            ptr            += OS_FIR_BANK_SIZE;
+            vFirDownHist    = ptr;
+            ptr            += OS_FIR_KERNEL_SIZE;
+            vFirUpHist      = ptr;
+            ptr            += up_hist;
+            vFirGather      = ptr;
+            ptr            += gather;
+            vFirAcc         = ptr;
+            ptr            += acc;
 
             lsp_assert(reinterpret_cast<uint8_t *>(ptr) <= &bData[samples * sizeof(float) + DEFAULT_ALIGN]);
         }
 
+        // Compute kernels of all FIR modes, the minimum-phase design is too expensive
+        // to be performed in the processing thread when the mode changes
+        float *k        = vFirBank;
+        for (size_t mode=OM_FIR_LINEAR_2X; mode<=OM_FIR_MINPHASE_32X; ++mode)
+        {
+            size_t size     = fir_ratio(mode) * nFirTaps;
+            vFirLatency[mode - OM_FIR_LINEAR_2X] = fir_design(mode, k, &k[size]);
+            k              += size * 2;
+        }
+        lsp_assert(k <= &vFirBank[OS_FIR_BANK_SIZE]);
+        fir_select();
+
         // Clear buffer
         dsp::fill_zero(fUpBuffer, OS_UP_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES);
         dsp::fill_zero(fDownBuffer, OS_DOWN_BUFFER_SIZE);
         nUpHead       = 0;
+        fir_clear();
 
         return true;
     }
@@ -98,6 +150,13 @@ namespace lsp
             delete [] bData;
             fUpBuffer   = NULL;
             fDownBuffer = NULL;
+            vFirBank    = NULL;
+            vFirUp      = NULL;
+            vFirDown    = NULL;
+            vFirUpHist  = NULL;
+            vFirDownHist= NULL;
+            vFirGather  = NULL;
+            vFirAcc     = NULL;
             bData       = NULL;
         }
         pCallback = NULL;
@@ -125,11 +184,15 @@ namespace lsp
 
     void Oversampler::update_settings()
     {
+        if (nUpdate & UP_MODE)
+            fir_select();
+
         if (nUpdate & (UP_MODE | UP_SAMPLE_RATE))
         {
             dsp::fill_zero(fUpBuffer, OS_UP_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES);
             nUpHead       = 0;
             sFilter.clear();
+            fir_clear();
         }
 
         size_t os       = get_oversampling();
@@ -174,7 +237,8 @@ namespace lsp
                 break;
         }
 
-        return 1;
+        size_t ratio = fir_ratio(nMode);
+        return (ratio > 0) ? ratio : 1;
     }
 
     size_t Oversampler::latency() const
@@ -206,11 +270,279 @@ namespace lsp
                 break;
         }
 
+        return (fir_ratio(nMode) > 0) ? vFirLatency[nMode - OM_FIR_LINEAR_2X] : 0;
+    }
+
+    size_t Oversampler::fir_ratio(size_t mode)
+    {
+        switch (mode)
+        {
+            case OM_FIR_LINEAR_2X:
+            case OM_FIR_MINPHASE_2X:
+                return 2;
+            case OM_FIR_LINEAR_3X:
+            case OM_FIR_MINPHASE_3X:
+                return 3;
+            case OM_FIR_LINEAR_4X:
+            case OM_FIR_MINPHASE_4X:
+                return 4;
+            case OM_FIR_LINEAR_6X:
+            case OM_FIR_MINPHASE_6X:
+                return 6;
+            case OM_FIR_LINEAR_8X:
+            case OM_FIR_MINPHASE_8X:
+                return 8;
+            case OM_FIR_LINEAR_16X:
+            case OM_FIR_MINPHASE_16X:
+                return 16;
+            case OM_FIR_LINEAR_32X:
+            case OM_FIR_MINPHASE_32X:
+                return 32;
+            default:
+                break;
+        }
+
         return 0;
     }
 
+    bool Oversampler::fir_minphase(size_t mode)
+    {
+        return (mode >= OM_FIR_MINPHASE_2X) && (mode <= OM_FIR_MINPHASE_32X);
+    }
+
+    void Oversampler::fir_select()
+    {
+        // Find precomputed kernels of the current mode
+        size_t ratio    = fir_ratio(nMode);
+        if ((ratio <= 0) || (vFirBank == NULL))
+            return;
+
+        float *k        = vFirBank;
+        for (size_t mode=OM_FIR_LINEAR_2X; mode<nMode; ++mode)
+            k              += fir_ratio(mode) * nFirTaps * 2;
+
+        vFirUp          = k;
+        vFirDown        = &k[ratio * nFirTaps];
+        nFirLatency     = vFirLatency[nMode - OM_FIR_LINEAR_2X];
+    }
+
+    static float bessel_i0(float x)
+    {
+        // Power series of the modified Bessel function of the first kind
+        float s = 1.0f, t = 1.0f;
+        for (size_t i=1; i<64; ++i)
+        {
+            float h     = x / (2 * i);
+            t          *= h * h;
+            s          += t;
+            if (t < s * 1e-8f)
+                break;
+        }
+        return s;
+    }
+
+    static void kaiser_window(float *dst, size_t n, float beta)
+    {
+        float k     = 1.0f / bessel_i0(beta);
+        float kx    = 2.0f / (n - 1);
+        for (size_t i=0; i<n; ++i)
+        {
+            float x     = i * kx - 1.0f;
+            dst[i]      = bessel_i0(beta * sqrtf(lsp_max(0.0f, 1.0f - x*x))) * k;
+        }
+    }
+
+    size_t Oversampler::fir_design(size_t mode, float *up, float *down)
+    {
+        size_t ratio    = fir_ratio(mode);
+
+        // Kaiser-windowed sinc low-pass kernel with odd length, it's center lies at the sample
+        // that corresponds to the original sample rate, so the overall latency of
+        // linear-phase upsampling and downsampling is exactly OS_FIR_TAPS samples.
+        // The design is performed at initialization only: fUpBuffer follows fDownBuffer
+        // and both are used as scratch memory
+        size_t len      = OS_FIR_TAPS * ratio + 1;
+        ssize_t center  = len >> 1;
+        float *k        = &fDownBuffer[2 << OS_FIR_MINPHASE_RANK];
+        float fc        = (OS_FIR_CUTOFF * 0.5f) / ratio;
+        float kw        = 2.0f * M_PI * fc;
+
+        lsp_assert(&k[len] <= &fUpBuffer[OS_UP_BUFFER_SIZE + RESAMPLING_RESERVED_SAMPLES]);
+        kaiser_window(k, len, OS_FIR_BETA);
+        for (size_t i=0; i<len; ++i)
+        {
+            ssize_t n       = ssize_t(i) - center;
+            k[i]           *= (n != 0) ? sinf(kw * n) / (M_PI * n) : 2.0f * fc;
+        }
+
+        if (fir_minphase(mode))
+        {
+            // Compute minimum-phase kernel with the same magnitude response
+            // using the real cepstrum of the linear-phase kernel
+            size_t rank     = OS_FIR_MINPHASE_RANK;
+            size_t n        = 1 << rank;
+            float *buf      = fDownBuffer;
+
+            dsp::fill_zero(buf, n << 1);
+            for (size_t i=0; i<len; ++i)
+                buf[i << 1]     = k[i];
+
+            // Real cepstrum: IFFT(log(abs(FFT(k))))
+            dsp::packed_direct_fft(buf, buf, rank);
+            for (size_t i=0; i<n; ++i)
+            {
+                float *v        = &buf[i << 1];
+                float mag       = sqrtf(v[0]*v[0] + v[1]*v[1]);
+                v[0]            = logf(lsp_max(mag, OS_FIR_LOG_THRESH));
+                v[1]            = 0.0f;
+            }
+            dsp::packed_reverse_fft(buf, buf, rank);
+
+            // Fold the cepstrum to make it causal
+            for (size_t i=1; i<(n >> 1); ++i)
+            {
+                buf[i << 1]                 *= 2.0f;
+                buf[(n - i) << 1]           = 0.0f;
+            }
+            for (size_t i=0; i<n; ++i)
+                buf[(i << 1) + 1]           = 0.0f;
+
+            // Minimum-phase kernel: IFFT(exp(FFT(folded cepstrum)))
+            dsp::packed_direct_fft(buf, buf, rank);
+            for (size_t i=0; i<n; ++i)
+            {
+                float *v        = &buf[i << 1];
+                float mag       = expf(v[0]);
+                v[0]            = mag * cosf(v[1]);
+                v[1]            = mag * sinf(v[1]);
+            }
+            dsp::packed_reverse_fft(buf, buf, rank);
+
+            for (size_t i=0; i<len; ++i)
+                k[i]            = buf[i << 1];
+        }
+
+        // Normalize kernel and estimate latency as the group delay at DC
+        float sum = 0.0f, moment = 0.0f;
+        for (size_t i=0; i<len; ++i)
+        {
+            sum            += k[i];
+            moment         += k[i] * i;
+        }
+        dsp::mul_k2(k, 1.0f / sum, len);
+
+        // Distribute the kernel between phases
+        for (size_t p=0; p<ratio; ++p)
+        {
+            float *pup      = &up[p * nFirTaps];
+            float *pdown    = &down[p * nFirTaps];
+
+            for (size_t i=0; i<nFirTaps; ++i)
+            {
+                size_t idx      = i * ratio + p;
+                float v         = (idx < len) ? k[idx] : 0.0f;
+                pup[i]          = v * ratio;
+                pdown[i]        = v;
+            }
+        }
+
+        return (fir_minphase(mode)) ? size_t((2.0f * moment) / (sum * ratio) + 0.5f) : OS_FIR_TAPS;
+    }
+
+    void Oversampler::fir_clear()
+    {
+        if (bData == NULL)
+            return;
+        dsp::fill_zero(vFirUpHist, OS_FIR_TAPS);
+        dsp::fill_zero(vFirDownHist, OS_FIR_KERNEL_SIZE);
+    }
+
+    void Oversampler::fir_upsample(float *dst, const float *src, size_t samples)
+    {
+        // Output sample #i of phase #p is the convolution of the source
+        // signal with the p'th polyphase component of the kernel
+        size_t ratio    = fir_ratio(nMode);
+        size_t hist     = nFirTaps - 1;
+        size_t count    = samples + hist;
+        float *buf      = vFirUpHist;
+
+        dsp::copy(&buf[hist], src, samples);
+
+        for (size_t p=0; p<ratio; ++p)
+        {
+            dsp::fill_zero(vFirAcc, count + hist);
+            dsp::convolve(vFirAcc, buf, &vFirUp[p * nFirTaps], nFirTaps, count);
+
+            const float *s  = &vFirAcc[hist];
+            float *d        = &dst[p];
+            for (size_t i=0; i<samples; ++i, d += ratio)
+                *d              = s[i];
+        }
+
+        dsp::move(buf, &buf[samples], hist);
+    }
+
+    void Oversampler::fir_downsample(float *dst, const float *src, size_t samples)
+    {
+        // Only retained samples are computed: each phase of the source signal
+        // is convolved with the corresponding polyphase component of the kernel
+        size_t ratio    = fir_ratio(nMode);
+        size_t hist     = nFirTaps - 1;
+        size_t hlen     = nFirTaps * ratio;
+        size_t count    = samples + hist;
+        const float *h  = &vFirDownHist[hlen];
+
+        dsp::fill_zero(vFirAcc, count + hist);
+
+        for (size_t p=0; p<ratio; ++p)
+        {
+            // Gather samples src[(i - hist)*ratio - p]
+            float *g        = vFirGather;
+            size_t split    = (p > 0) ? hist + 1 : hist;
+            ssize_t idx     = -ssize_t(hist * ratio + p);
+            size_t i        = 0;
+
+            if (split > count)
+                split           = count;
+            for ( ; i < split; ++i, idx += ratio)
+                g[i]            = h[idx];
+            for ( ; i < count; ++i, idx += ratio)
+                g[i]            = src[idx];
+
+            dsp::convolve(vFirAcc, g, &vFirDown[p * nFirTaps], nFirTaps, count);
+        }
+
+        dsp::copy(dst, &vFirAcc[hist], samples);
+
+        // Update history
+        size_t n        = samples * ratio;
+        if (n >= hlen)
+            dsp::copy(vFirDownHist, &src[n - hlen], hlen);
+        else
+        {
+            dsp::move(vFirDownHist, &vFirDownHist[n], hlen - n);
+            dsp::copy(&vFirDownHist[hlen - n], src, n);
+        }
+    }
+
     void Oversampler::upsample(float *dst, const float *src, size_t samples)
     {
+        size_t ratio    = fir_ratio(nMode);
+        if (ratio > 0)
+        {
+            while (samples > 0)
+            {
+                size_t to_do    = (samples > OS_FIR_BLOCK) ? OS_FIR_BLOCK : samples;
+                fir_upsample(dst, src, to_do);
+
+                // Update pointers
+                dst            += to_do * ratio;
+                src            += to_do;
+                samples        -= to_do;
+            }
+            return;
+        }
+
         switch (nMode)
         {
             case OM_LANCZOS_2X2:
@@ -393,6 +725,22 @@ namespace lsp
 
     void Oversampler::downsample(float *dst, const float *src, size_t samples)
     {
+        size_t ratio    = fir_ratio(nMode);
+        if (ratio > 0)
+        {
+            while (samples > 0)
+            {
+                size_t to_do    = (samples > OS_FIR_BLOCK) ? OS_FIR_BLOCK : samples;
+                fir_downsample(dst, src, to_do);
+
+                // Update pointers
+                src            += to_do * ratio;
+                dst            += to_do;
+                samples        -= to_do;
+            }
+            return;
+        }
+
         switch (nMode)
         {
             case OM_LANCZOS_2X2:
@@ -536,6 +884,26 @@ namespace lsp
 
     void Oversampler::process(float *dst, const float *src, size_t samples, IOversamplerCallback *callback)
     {
+        size_t ratio    = fir_ratio(nMode);
+        if (ratio > 0)
+        {
+            while (samples > 0)
+            {
+                size_t to_do    = (samples > OS_FIR_BLOCK) ? OS_FIR_BLOCK : samples;
+
+                fir_upsample(fUpBuffer, src, to_do);
+                if (callback != NULL)
+                    callback->process(fUpBuffer, fUpBuffer, to_do * ratio);
+                fir_downsample(dst, fUpBuffer, to_do);
+
+                // Update pointers
+                dst            += to_do;
+                src            += to_do;
+                samples        -= to_do;
+            }
+            return;
+        }
+
         switch (nMode)
         {
             case OM_LANCZOS_2X2:
@@ -770,6 +1138,15 @@ namespace lsp
         v->write_object("sFilter", &sFilter);
         v->write("bData", bData);
         v->write("bFilter", bFilter);
+        v->write("vFirBank", vFirBank);
+        v->write("vFirUp", vFirUp);
+        v->write("vFirDown", vFirDown);
+        v->write("vFirUpHist", vFirUpHist);
+        v->write("vFirDownHist", vFirDownHist);
+        v->write("vFirGather", vFirGather);
+        v->write("vFirAcc", vFirAcc);
+        v->write("nFirTaps", nFirTaps);
+        v->write("nFirLatency", nFirLatency);
     }
 
 } /* namespace lsp */
@@ -70,6 +70,11 @@
 <ul>
 	<li><b>Input</b> - the amount of gain applied to the input signal before processing.</li>
 	<li><b>Output</b> - the amount of gain applied to the output signal before processing.</li>
+	<li><b>Type</b> - the type of the crossover:</li>
+	<ul>
+		<li><b>IIR</b> - Linkwitz-Riley filters, minimum phase, does not add latency to the output signal.</li>
+		<li><b>FFT</b> - fast convolution with the magnitude response of each band, linear phase, adds latency to the output signal.</li>
+	</ul>
 </ul>
 <p><b>'Analysis' section:</b></p>
 <ul>
@@ -85,6 +85,8 @@ words: the more work should be done, the more CPU resources will be used. Beware
 		<li><b>Full 4x(2L)</b>, <b>Full 4x(3L)</b> - 4x Lanczos oversampling of Sidechain and Input signal with 2 or 3 lobes (L) in the kernel.</li>
 		<li><b>Full 6x(2L)</b>, <b>Full 6x(3L)</b> - 6x Lanczos oversampling of Sidechain and Input signal with 2 or 3 lobes (L) in the kernel.</li>
 		<li><b>Full 8x(2L)</b>, <b>Full 8x(3L)</b> - 8x Lanczos oversampling of Sidechain and Input signal with 2 or 3 lobes (L) in the kernel.</li>
+		<li><b>FIR Linear x2</b> ... <b>FIR Linear x8</b> - polyphase FIR oversampling of Sidechain and Input signal with linear-phase kernel, adds 24 samples of latency.</li>
+		<li><b>FIR MinPhase x2</b> ... <b>FIR MinPhase x8</b> - polyphase FIR oversampling of Sidechain and Input signal with minimum-phase kernel, adds only a few samples of latency at the cost of non-linear phase response.</li>
 	</ul>
 	<li><b>Dither</b> - allows to enable dithering for the specified sample bitness.</li>
 	<li><b>SC</b> - enables drawing of sidechain input graph and corresponding level meter.</li>
@@ -215,6 +215,7 @@ This allows to understand the final result with minimum number of actions.</p>
 	<li><b>Status</b> - current rendering status</li>
 	<li><b>Threads</b> - allows to select number of threads for parallel rendering</li>
 	<li><b>Quality</b> - specifies the quality of rendering. The higher quality takes more time.</li>
+	<li><b>Preview</b> - renders a quick low-quality impulse response first when the quality is high, then renders the final one.</li>
 	<li><b>Progress</b> - the indicator of the completion of the rendering process.</li>
 	<li><b>Launch</b> - the button that starts the offline rendering process.</li>
 	<li><b>Stop</b> - the button that terminates the offline rendering process.</li>
@@ -304,6 +304,7 @@ namespace avx
         CEXPORT1(favx, fastconv_restore);
         CEXPORT1(favx, fastconv_apply);
         CEXPORT1(favx, fastconv_parse_apply);
+        CEXPORT1(favx, fastconv_fmadd);
 
         CEXPORT1(favx, filter_transfer_calc_ri);
         CEXPORT1(favx, filter_transfer_apply_ri);
@@ -409,6 +410,7 @@ namespace avx
             CEXPORT2(favx, fastconv_restore, fastconv_restore_fma3);
             CEXPORT2(favx, fastconv_apply, fastconv_apply_fma3);
             CEXPORT2(favx, fastconv_parse_apply, fastconv_parse_apply_fma3);
+            CEXPORT2(favx, fastconv_fmadd, fastconv_fmadd_fma3);
 
             CEXPORT2(favx, filter_transfer_calc_ri, filter_transfer_calc_ri_fma3);
             CEXPORT2(favx, filter_transfer_apply_ri, filter_transfer_apply_ri_fma3);
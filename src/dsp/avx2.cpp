@@ -37,6 +37,8 @@
 #include <dsp/arch/x86/avx2/pmath/log.h>
 #include <dsp/arch/x86/avx2/pmath/pow.h>
 
+#include <dsp/arch/x86/avx2/dynamics.h>
+
 #include <dsp/arch/x86/avx2/fft/normalize.h>
 
 #include <dsp/arch/x86/avx2/search/iminmax.h>
@@ -153,6 +155,11 @@ namespace avx2
         CEXPORT2_X64(favx, powvx1, x64_powvx1);
         CEXPORT2_X64(favx, powvx2, x64_powvx2);
 
+        CEXPORT2_X64(favx, dyn_gain_x1, x64_dyn_gain_x1);
+        CEXPORT2_X64(favx, dyn_gain_x2, x64_dyn_gain_x2);
+        CEXPORT2_X64(favx, dyn_curve_x1, x64_dyn_curve_x1);
+        CEXPORT2_X64(favx, dyn_curve_x2, x64_dyn_curve_x2);
+
         CEXPORT2_X64(favx, eff_hsla_hue, x64_eff_hsla_hue);
         CEXPORT2_X64(favx, eff_hsla_sat, x64_eff_hsla_sat);
         CEXPORT2_X64(favx, eff_hsla_light, x64_eff_hsla_light);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <dsp/bits.h>
+#include <test/test.h>
+
+#include <core/types.h>
+#include <core/debug.h>
+
+#include <dsp/arch/x86/features.h>
+
+#define DSP_ARCH_X86_AVX512_IMPL
+
+#include <dsp/arch/x86/avx512/pmath/fmop_kx.h>
+#include <dsp/arch/x86/avx512/pmath/fmop_vv.h>
+
+#include <dsp/arch/x86/avx512/fft.h>
+#include <dsp/arch/x86/avx512/pfft.h>
+#include <dsp/arch/x86/avx512/fastconv.h>
+
+#include <dsp/arch/x86/avx512/convolution.h>
+#include <dsp/arch/x86/avx512/resampling.h>
+
+#undef DSP_ARCH_X86_AVX512_IMPL
+
+namespace avx512
+{
+    using namespace x86;
+
+    #define CEXPORT1(cond, export)    \
+        IF_ARCH_X86_64( \
+                TEST_EXPORT(avx512::export); \
+                if (cond) \
+                    dsp::export = avx512::export; \
+            );
+
+    void dsp_init(const cpu_features_t *f)
+    {
+        if ((f->features & (CPU_OPTION_AVX512F | CPU_OPTION_AVX2 | CPU_OPTION_FMA3)) != (CPU_OPTION_AVX512F | CPU_OPTION_AVX2 | CPU_OPTION_FMA3))
+            return;
+
+        lsp_trace("Optimizing DSP for AVX-512 instruction set");
+
+        // Wide vectors may lower the core frequency, use them only where they are known to be fast
+        bool favx512    = feature_check(f, FEAT_FAST_AVX512);
+
+        CEXPORT1(favx512, fmadd_k3);
+        CEXPORT1(favx512, fmsub_k3);
+        CEXPORT1(favx512, fmrsub_k3);
+        CEXPORT1(favx512, fmmul_k3);
+        CEXPORT1(favx512, fmdiv_k3);
+        CEXPORT1(favx512, fmrdiv_k3);
+
+        CEXPORT1(favx512, fmadd_k4);
+        CEXPORT1(favx512, fmsub_k4);
+        CEXPORT1(favx512, fmrsub_k4);
+        CEXPORT1(favx512, fmmul_k4);
+        CEXPORT1(favx512, fmdiv_k4);
+        CEXPORT1(favx512, fmrdiv_k4);
+
+        CEXPORT1(favx512, fmadd3);
+        CEXPORT1(favx512, fmsub3);
+        CEXPORT1(favx512, fmrsub3);
+        CEXPORT1(favx512, fmmul3);
+        CEXPORT1(favx512, fmdiv3);
+        CEXPORT1(favx512, fmrdiv3);
+
+        CEXPORT1(favx512, fmadd4);
+        CEXPORT1(favx512, fmsub4);
+        CEXPORT1(favx512, fmrsub4);
+        CEXPORT1(favx512, fmmul4);
+        CEXPORT1(favx512, fmdiv4);
+        CEXPORT1(favx512, fmrdiv4);
+
+        CEXPORT1(favx512, direct_fft);
+        CEXPORT1(favx512, reverse_fft);
+        CEXPORT1(favx512, packed_direct_fft);
+        CEXPORT1(favx512, packed_reverse_fft);
+
+        CEXPORT1(favx512, fastconv_parse);
+        CEXPORT1(favx512, fastconv_parse_apply);
+        CEXPORT1(favx512, fastconv_restore);
+        CEXPORT1(favx512, fastconv_apply);
+        CEXPORT1(favx512, fastconv_fmadd);
+
+        CEXPORT1(favx512, convolve);
+
+        CEXPORT1(favx512, lanczos_resample_2x2);
+        CEXPORT1(favx512, lanczos_resample_2x3);
+        CEXPORT1(favx512, lanczos_resample_2x4);
+        CEXPORT1(favx512, lanczos_resample_3x2);
+        CEXPORT1(favx512, lanczos_resample_3x3);
+        CEXPORT1(favx512, lanczos_resample_3x4);
+        CEXPORT1(favx512, lanczos_resample_4x2);
+        CEXPORT1(favx512, lanczos_resample_4x3);
+        CEXPORT1(favx512, lanczos_resample_4x4);
+        CEXPORT1(favx512, lanczos_resample_6x2);
+        CEXPORT1(favx512, lanczos_resample_6x3);
+        CEXPORT1(favx512, lanczos_resample_6x4);
+        CEXPORT1(favx512, lanczos_resample_8x2);
+        CEXPORT1(favx512, lanczos_resample_8x3);
+        CEXPORT1(favx512, lanczos_resample_8x4);
+    }
+
+    #undef CEXPORT1
+}
@@ -282,6 +282,7 @@ namespace dsp
     void    (* fastconv_parse_apply)(float *dst, float *tmp, const float *c, const float *src, size_t rank) = NULL;
     void    (* fastconv_restore)(float *dst, float *tmp, size_t rank) = NULL;
     void    (* fastconv_apply)(float *dst, float *tmp, const float *c1, const float *c2, size_t rank) = NULL;
+    void    (* fastconv_fmadd)(float *dst, const float *c1, const float *c2, size_t rank) = NULL;
 
     void    (* lr_to_ms)(float *m, float *s, const float *l, const float *r, size_t count) = NULL;
     void    (* lr_to_mid)(float *m, const float *l, const float *r, size_t count) = NULL;
@@ -296,11 +297,18 @@ namespace dsp
     void    (* biquad_process_x4)(float *dst, const float *src, size_t count, biquad_t *f) = NULL;
     void    (* biquad_process_x8)(float *dst, const float *src, size_t count, biquad_t *f) = NULL;
 
+    void    (* biquad_process_dx1)(float *dst, const float *src, size_t count, biquad_d_t *f) = NULL;
+    void    (* biquad_process_dx2)(float *dst, const float *src, size_t count, biquad_d_t *f) = NULL;
+
+    void    (* biquad_process_c2)(float *dst, const float *src, size_t count, biquad_t *f) = NULL;
+
     void    (* dyn_biquad_process_x1)(float *dst, const float *src, float *d, size_t count, const biquad_x1_t *f) = NULL;
     void    (* dyn_biquad_process_x2)(float *dst, const float *src, float *d, size_t count, const biquad_x2_t *f) = NULL;
     void    (* dyn_biquad_process_x4)(float *dst, const float *src, float *d, size_t count, const biquad_x4_t *f) = NULL;
     void    (* dyn_biquad_process_x8)(float *dst, const float *src, float *d, size_t count, const biquad_x8_t *f) = NULL;
 
+    void    (* dyn_biquad_process_dx1)(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f) = NULL;
+
     void    (* filter_transfer_calc_ri)(float *re, float *im, const f_cascade_t *c, const float *freq, size_t count) = NULL;
     void    (* filter_transfer_apply_ri)(float *re, float *im, const f_cascade_t *c, const float *freq, size_t count) = NULL;
     void    (* filter_transfer_calc_pc)(float *dst, const f_cascade_t *c, const float *freq, size_t count) = NULL;
@@ -311,6 +319,8 @@ namespace dsp
     void    (* bilinear_transform_x4)(biquad_x4_t *bf, const f_cascade_t *bc, float kf, size_t count) = NULL;
     void    (* bilinear_transform_x8)(biquad_x8_t *bf, const f_cascade_t *bc, float kf, size_t count) = NULL;
 
+    void    (* bilinear_transform_dx1)(biquad_dx1_t *bf, const f_cascade_t *bc, double kf, size_t count) = NULL;
+
     void    (* matched_transform_x1)(biquad_x1_t *bf, f_cascade_t *bc, float kf, float td, size_t count) = NULL;
     void    (* matched_transform_x2)(biquad_x2_t *bf, f_cascade_t *bc, float kf, float td, size_t count) = NULL;
     void    (* matched_transform_x4)(biquad_x4_t *bf, f_cascade_t *bc, float kf, float td, size_t count) = NULL;
@@ -520,6 +530,11 @@ namespace dsp
     void    (* lin_xfade2)(float *dst, const float *src, int32_t x0, float y0, int32_t x1, float y1, int32_t x, uint32_t n) = 0;
     void    (* lin_xfade3)(float *dst, const float *a, const float *b, int32_t x0, float y0, int32_t x1, float y1, int32_t x, uint32_t n) = 0;
     void    (* lin_xfade_add3)(float *dst, const float *a, const float *b, int32_t x0, float y0, int32_t x1, float y1, int32_t x, uint32_t n) = 0;
+
+    void    (* dyn_gain_x1)(float *dst, const float *src, const dyn_knee_t *k, size_t count) = NULL;
+    void    (* dyn_gain_x2)(float *dst, const float *src, const dyn_knee_t *k, size_t count) = NULL;
+    void    (* dyn_curve_x1)(float *dst, const float *src, const dyn_knee_t *k, size_t count) = NULL;
+    void    (* dyn_curve_x2)(float *dst, const float *src, const dyn_knee_t *k, size_t count) = NULL;
 }
 
 namespace dsp
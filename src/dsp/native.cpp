@@ -71,6 +71,7 @@
 #include <dsp/arch/native/coding.h>
 #include <dsp/arch/native/interpolate.h>
 #include <dsp/arch/native/crossfade.h>
+#include <dsp/arch/native/dynamics.h>
 
 #undef __DSP_NATIVE_IMPL
 
@@ -269,6 +270,7 @@ namespace native
         EXPORT1(fastconv_parse_apply);
         EXPORT1(fastconv_restore);
         EXPORT1(fastconv_apply);
+        EXPORT1(fastconv_fmadd);
 
         EXPORT1(complex_mul2);
         EXPORT1(complex_mul3);
@@ -320,10 +322,16 @@ namespace native
         EXPORT1(biquad_process_x4);
         EXPORT1(biquad_process_x8);
 
+        EXPORT1(biquad_process_dx1);
+        EXPORT1(biquad_process_dx2);
+
+        EXPORT1(biquad_process_c2);
+
         EXPORT1(dyn_biquad_process_x1);
         EXPORT1(dyn_biquad_process_x2);
         EXPORT1(dyn_biquad_process_x4);
         EXPORT1(dyn_biquad_process_x8);
+        EXPORT1(dyn_biquad_process_dx1);
 
         EXPORT1(filter_transfer_calc_ri);
         EXPORT1(filter_transfer_apply_ri);
@@ -335,6 +343,8 @@ namespace native
         EXPORT1(bilinear_transform_x4);
         EXPORT1(bilinear_transform_x8);
 
+        EXPORT1(bilinear_transform_dx1);
+
         EXPORT1(matched_transform_x1);
         EXPORT1(matched_transform_x2);
         EXPORT1(matched_transform_x4);
@@ -547,6 +557,11 @@ namespace native
         EXPORT1(lin_xfade2);
         EXPORT1(lin_xfade3);
         EXPORT1(lin_xfade_add3);
+
+        EXPORT1(dyn_gain_x1);
+        EXPORT1(dyn_gain_x2);
+        EXPORT1(dyn_curve_x1);
+        EXPORT1(dyn_curve_x2);
     }
 
     #undef EXPORT1
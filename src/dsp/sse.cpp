@@ -293,6 +293,7 @@ namespace sse
         EXPORT1(fastconv_parse_apply);
         EXPORT1(fastconv_restore);
         EXPORT1(fastconv_apply);
+        EXPORT1(fastconv_fmadd);
 
         EXPORT1(complex_mul2);
         EXPORT1(complex_mul3);
@@ -329,6 +330,8 @@ namespace sse
         EXPORT1(biquad_process_x4);
         EXPORT1(biquad_process_x8);
 
+        EXPORT1(biquad_process_c2);
+
         EXPORT1(dyn_biquad_process_x1);
         EXPORT1(dyn_biquad_process_x2);
         EXPORT1(dyn_biquad_process_x4);
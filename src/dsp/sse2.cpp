@@ -76,6 +76,9 @@ namespace sse2 // TODO: make constants common for all architectures
 #include <dsp/arch/x86/sse2/pmath/log.h>
 #include <dsp/arch/x86/sse2/pmath/pow.h>
 
+#include <dsp/arch/x86/sse2/filters/static.h>
+#include <dsp/arch/x86/sse2/filters/dynamic.h>
+
 #undef DSP_ARCH_X86_SSE2_IMPL
 
 namespace sse2
@@ -148,6 +151,10 @@ namespace sse2
         EXPORT1(axis_apply_log1);
         EXPORT1(axis_apply_log2);
         EXPORT1(rgba32_to_bgra32);
+
+        EXPORT1(biquad_process_dx1);
+        EXPORT1(biquad_process_dx2);
+        EXPORT1(dyn_biquad_process_dx1);
     }
 
     #undef EXPORT1
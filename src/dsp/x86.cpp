@@ -66,6 +66,13 @@ namespace avx2
     extern void dsp_init(const x86::cpu_features_t *f);
 }
 
+#ifdef ARCH_X86_64
+namespace avx512
+{
+    extern void dsp_init(const x86::cpu_features_t *f);
+}
+#endif /* ARCH_X86_64 */
+
 namespace x86
 {
 #pragma pack(push, 1)
@@ -273,6 +280,28 @@ namespace x86
 
             if (info.ebx & X86_CPUID7_AMD_EBX_AVX2)
                 f->features     |= CPU_OPTION_AVX2;
+
+            if (f->features & CPU_OPTION_OSXSAVE)
+            {
+                if ((xcr0 & XCR_FLAGS_AVX512) == XCR_FLAGS_AVX512)
+                {
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512F)
+                        f->features     |= CPU_OPTION_AVX512F;
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512DQ)
+                        f->features     |= CPU_OPTION_AVX512DQ;
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512IFMA)
+                        f->features     |= CPU_OPTION_AVX512IFMA;
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512CD)
+                        f->features     |= CPU_OPTION_AVX512CD;
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512BW)
+                        f->features     |= CPU_OPTION_AVX512BW;
+                    if (info.ebx & X86_CPUID7_AMD_EBX_AVX512VL)
+                        f->features     |= CPU_OPTION_AVX512VL;
+
+                    if (info.ecx & X86_CPUID7_AMD_ECX_AVX512VBMI)
+                        f->features     |= CPU_OPTION_AVX512VBMI;
+                }
+            }
         }
 
         // FUNCTION 0x80000001
@@ -503,6 +532,16 @@ namespace x86
                 if ((f->vendor == CPU_VENDOR_AMD) || (f->vendor == CPU_VENDOR_HYGON))
                     return (f->family >= AMD_FAMILY_ZEN); // Only starting with ZEN architecture AMD's implementation of AVX is fast enough
                 break;
+            case FEAT_FAST_AVX512:
+                if (f->vendor == CPU_VENDOR_INTEL) // Any Intel CPU with AVX-512 has full-width FMA units on at least one port
+                    return true;
+                // AMD: Zen 3 has no AVX-512, Zen 4 (same family 0x19) executes 512-bit operations as two
+                // 256-bit halves, so it has no throughput gain over AVX2/FMA3 while the cross-lane permutes
+                // of the FFT butterflies become more expensive. Zen 5 desktop and server cores have full-width
+                // 512-bit data paths.
+                if ((f->vendor == CPU_VENDOR_AMD) || (f->vendor == CPU_VENDOR_HYGON))
+                    return (f->family >= AMD_FAMILY_ZEN5);
+                break;
             case FEAT_FAST_FMA3:
                 if (f->vendor == CPU_VENDOR_INTEL) // Any Intel CPU is good enough with AVX
                     return true;
@@ -546,6 +585,7 @@ namespace x86
         sse4::dsp_init(&f);
         avx::dsp_init(&f);
         avx2::dsp_init(&f);
+        IF_ARCH_X86_64(avx512::dsp_init(&f));
     }
 
     #undef EXPORT1
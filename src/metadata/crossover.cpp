@@ -57,13 +57,21 @@ namespace lsp
         { NULL, NULL }
     };
 
+    static const port_item_t crossover_types[] =
+    {
+        { "IIR",            "crossover.type.iir"            },
+        { "FFT",            "crossover.type.fft"            },
+        { NULL, NULL }
+    };
+
     #define XOVER_COMMON \
             BYPASS, \
             AMP_GAIN("g_in", "Input gain", crossover_base_metadata::IN_GAIN_DFL, 10.0f), \
             AMP_GAIN("g_out", "Output gain", crossover_base_metadata::OUT_GAIN_DFL, 10.0f), \
             LOG_CONTROL("react", "FFT reactivity", U_MSEC, crossover_base_metadata::REACT_TIME), \
             AMP_GAIN("shift", "Shift gain", GAIN_AMP_0_DB, GAIN_AMP_P_60_DB), \
-            LOG_CONTROL("zoom", "Graph zoom", U_GAIN_AMP, crossover_base_metadata::ZOOM)
+            LOG_CONTROL("zoom", "Graph zoom", U_GAIN_AMP, crossover_base_metadata::ZOOM), \
+            COMBO("type", "Crossover type", 0.0f, crossover_types)
 
     #define XOVER_CHANNEL(id, label) \
             SWITCH("flt" id, "Band filter curves" label, 1.0f), \
@@ -433,7 +441,7 @@ namespace lsp
         "crossover_mono",
         "rmnv",
         LSP_CROSSOVER_BASE + 0,
-        LSP_VERSION(1, 0, 0),
+        LSP_VERSION(1, 0, 1),
         crossover_classes,
         E_INLINE_DISPLAY | E_DUMP_STATE,
         crossover_mono_ports,
@@ -451,7 +459,7 @@ namespace lsp
         "crossover_stereo",
         "ooqb",
         LSP_CROSSOVER_BASE + 1,
-        LSP_VERSION(1, 0, 0),
+        LSP_VERSION(1, 0, 1),
         crossover_classes,
         E_INLINE_DISPLAY | E_DUMP_STATE,
         crossover_stereo_ports,
@@ -469,7 +477,7 @@ namespace lsp
         "crossover_lr",
         "wvbr",
         LSP_CROSSOVER_BASE + 2,
-        LSP_VERSION(1, 0, 0),
+        LSP_VERSION(1, 0, 1),
         crossover_classes,
         E_INLINE_DISPLAY | E_DUMP_STATE,
         crossover_lr_ports,
@@ -487,7 +495,7 @@ namespace lsp
         "crossover_ms",
         "vlqv",
         LSP_CROSSOVER_BASE + 3,
-        LSP_VERSION(1, 0, 0),
+        LSP_VERSION(1, 0, 1),
         crossover_classes,
         E_INLINE_DISPLAY | E_DUMP_STATE,
         crossover_ms_ports,
@@ -161,6 +161,7 @@ namespace lsp
         AMP_GAIN("g_in", "Input gain", graph_equalizer_base_metadata::IN_GAIN_DFL, 10.0f), \
         AMP_GAIN("g_out", "Output gain", graph_equalizer_base_metadata::OUT_GAIN_DFL, 10.0f), \
         COMBO("mode", "Equalizer mode", 0, band_eq_modes), \
+        SWITCH("lowlat", "Low latency", 0.0f), \
         COMBO("slope", "Filter slope", 0, band_slopes), \
         COMBO("fft", "FFT analysis", 0, band_fft_mode), \
         LOG_CONTROL("react", "FFT reactivity", U_MSEC, graph_equalizer_base_metadata::REACT_TIME), \
@@ -317,7 +318,7 @@ namespace lsp
         "graph_equalizer_x16_mono",
         "rvwk",
         LSP_GRAPH_EQUALIZER_BASE + 0,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x16_mono_ports,
@@ -335,7 +336,7 @@ namespace lsp
         "graph_equalizer_x32_mono",
         "vnca",
         LSP_GRAPH_EQUALIZER_BASE + 1,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x32_mono_ports,
@@ -353,7 +354,7 @@ namespace lsp
         "graph_equalizer_x16_stereo",
         "argl",
         LSP_GRAPH_EQUALIZER_BASE + 2,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x16_stereo_ports,
@@ -371,7 +372,7 @@ namespace lsp
         "graph_equalizer_x32_stereo",
         "nvsd",
         LSP_GRAPH_EQUALIZER_BASE + 3,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x32_stereo_ports,
@@ -389,7 +390,7 @@ namespace lsp
         "graph_equalizer_x16_lr",
         "zefi",
         LSP_GRAPH_EQUALIZER_BASE + 4,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x16_lr_ports,
@@ -407,7 +408,7 @@ namespace lsp
         "graph_equalizer_x32_lr",
         "0heu",
         LSP_GRAPH_EQUALIZER_BASE + 5,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x32_lr_ports,
@@ -425,7 +426,7 @@ namespace lsp
         "graph_equalizer_x16_ms",
         "woys",
         LSP_GRAPH_EQUALIZER_BASE + 6,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x16_ms_ports,
@@ -443,7 +444,7 @@ namespace lsp
         "graph_equalizer_x32_ms",
         "ku8j",
         LSP_GRAPH_EQUALIZER_BASE + 7,
-        LSP_VERSION(1, 0, 2),
+        LSP_VERSION(1, 0, 3),
         graph_equalizer_classes,
         E_INLINE_DISPLAY,
         graph_equalizer_x32_ms_ports,
@@ -76,6 +76,18 @@ namespace lsp
         { "Full x8(2L)",    "oversampler.full.8x2" },
         { "Full x8(3L)",    "oversampler.full.8x3" },
 
+        { "FIR Linear x2",  "oversampler.linear.x2" },
+        { "FIR Linear x3",  "oversampler.linear.x3" },
+        { "FIR Linear x4",  "oversampler.linear.x4" },
+        { "FIR Linear x6",  "oversampler.linear.x6" },
+        { "FIR Linear x8",  "oversampler.linear.x8" },
+
+        { "FIR MinPhase x2", "oversampler.minphase.x2" },
+        { "FIR MinPhase x3", "oversampler.minphase.x3" },
+        { "FIR MinPhase x4", "oversampler.minphase.x4" },
+        { "FIR MinPhase x6", "oversampler.minphase.x6" },
+        { "FIR MinPhase x8", "oversampler.minphase.x8" },
+
         { NULL, NULL }
     };
 
@@ -174,6 +174,7 @@ namespace lsp
             AMP_GAIN("g_in", "Input gain", para_equalizer_base_metadata::IN_GAIN_DFL, 10.0f), \
             AMP_GAIN("g_out", "Output gain", para_equalizer_base_metadata::OUT_GAIN_DFL, 10.0f), \
             COMBO("mode", "Equalizer mode", 0, equalizer_eq_modes), \
+            SWITCH("lowlat", "Low latency", 0.0f), \
             COMBO("fft", "FFT analysis", 0, equalizer_fft_mode), \
             LOG_CONTROL("react", "FFT reactivity", U_MSEC, para_equalizer_base_metadata::REACT_TIME), \
             AMP_GAIN("shift", "Shift gain", 1.0f, 100.0f), \
@@ -506,7 +507,7 @@ namespace lsp
         "para_equalizer_x16_mono",
         "dh3y",
         LSP_PARA_EQUALIZER_BASE + 0,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x16_mono_ports,
@@ -524,7 +525,7 @@ namespace lsp
         "para_equalizer_x32_mono",
         "i0px",
         LSP_PARA_EQUALIZER_BASE + 1,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x32_mono_ports,
@@ -542,7 +543,7 @@ namespace lsp
         "para_equalizer_x16_stereo",
         "a5er",
         LSP_PARA_EQUALIZER_BASE + 2,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x16_stereo_ports,
@@ -560,7 +561,7 @@ namespace lsp
         "para_equalizer_x32_stereo",
         "s2nz",
         LSP_PARA_EQUALIZER_BASE + 3,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x32_stereo_ports,
@@ -578,7 +579,7 @@ namespace lsp
         "para_equalizer_x16_lr",
         "4kef",
         LSP_PARA_EQUALIZER_BASE + 4,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x16_lr_ports,
@@ -596,7 +597,7 @@ namespace lsp
         "para_equalizer_x32_lr",
         "ilqj",
         LSP_PARA_EQUALIZER_BASE + 5,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x32_lr_ports,
@@ -614,7 +615,7 @@ namespace lsp
         "para_equalizer_x16_ms",
         "opjs",
         LSP_PARA_EQUALIZER_BASE + 6,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x16_ms_ports,
@@ -632,7 +633,7 @@ namespace lsp
         "para_equalizer_x32_ms",
         "lgz9",
         LSP_PARA_EQUALIZER_BASE + 7,
-        LSP_VERSION(1, 0, 4),
+        LSP_VERSION(1, 0, 5),
         para_equalizer_classes,
         E_INLINE_DISPLAY,
         para_equalizer_x32_ms_ports,
@@ -246,6 +246,7 @@ namespace lsp
         STATUS("status", "Render status"), \
         OUT_PERCENTS("prog", "Rendering progress"), \
         SWITCH("normal", "Normalize rendered samples", 1.0f), \
+        SWITCH("preview", "Render quick preview first", 0.0f), \
         TRIGGER("render", "Launch/Stop rendering process"), \
         PATH("ifn", "Input 3D model file name"),    \
         STATUS("ifs", "Input 3D model load status"), \
@@ -501,7 +502,7 @@ namespace lsp
         "room_builder_mono",
         "cqbr",
         0,
-        LSP_VERSION(1, 0, 1),
+        LSP_VERSION(1, 0, 2),
         room_builder_classes,
         E_3D_BACKEND | E_KVT_SYNC,
         room_builder_mono_ports,
@@ -519,7 +520,7 @@ namespace lsp
         "room_builder_stereo",
         "mprh",
         0,
-        LSP_VERSION(1, 0, 1),
+        LSP_VERSION(1, 0, 2),
         room_builder_classes,
         E_3D_BACKEND | E_KVT_SYNC,
         room_builder_stereo_ports,
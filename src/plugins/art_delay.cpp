@@ -965,6 +965,8 @@ namespace lsp
 
     void art_delay_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Estimate number of channels
         size_t channels = (bStereoIn) ? 2 : 1;
 
@@ -238,6 +238,8 @@ namespace lsp
 
     void comp_delay_mono::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         vDelay.process(samples);
     }
 
@@ -295,6 +297,8 @@ namespace lsp
 
     void comp_delay_stereo::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         vDelay[0].process(samples);
         vDelay[1].process(samples);
     }
@@ -362,6 +366,8 @@ namespace lsp
 
     void comp_delay_x2_stereo::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         vDelay[0].process(samples);
         vDelay[1].process(samples);
     }
@@ -413,6 +413,7 @@ namespace lsp
             c->sComp.set_sample_rate(sr);
             c->sSC.set_sample_rate(sr);
             c->sSCEq.set_sample_rate(sr);
+            c->sSCEq.set_precise(sr > FILTER_PRECISE_SRATE);
             c->sDelay.init(max_delay);
             c->sCompDelay.init(max_delay);
             c->sDryDelay.init(max_delay);
@@ -578,6 +579,8 @@ namespace lsp
 
     void compressor_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels = (nMode == CM_MONO) ? 1 : 2;
         size_t feedback = 0;
 
@@ -626,6 +629,7 @@ namespace lsp
             }
 
             // Process meters
+            sProfiler.stage("sidechain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -635,6 +639,7 @@ namespace lsp
             }
 
             // Do compression
+            sProfiler.stage("dynamics");
             switch (feedback)
             {
                 case 0:
@@ -734,6 +739,7 @@ namespace lsp
             }
 
             // Apply gain to each channel and process meters
+            sProfiler.stage("gain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -759,6 +765,7 @@ namespace lsp
             }
 
             // Form output signal
+            sProfiler.stage("output");
             if (nMode == CM_MS)
             {
                 channel_t *cm       = &vChannels[0];
@@ -816,6 +823,7 @@ namespace lsp
         if ((!bPause) || (bClear) || (bUISync))
         {
             // Process mesh requests
+            sProfiler.stage("meshes");
             for (size_t i=0; i<channels; ++i)
             {
                 // Get channel
@@ -847,6 +855,7 @@ namespace lsp
         }
 
         // Output compressor curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c       = &vChannels[i];
@@ -54,6 +54,7 @@ namespace lsp
         pReactivity     = NULL;
         pShiftGain      = NULL;
         pZoom           = NULL;
+        pType           = NULL;
         pMSOut          = NULL;
     }
 
@@ -79,8 +80,8 @@ namespace lsp
                                   channels * (
                                       2 * mesh_size                           +                   // vTr (both complex and real)
                                       mesh_size                               +                   // vFc (real only)
-                                      BUFFER_SIZE * sizeof(float) * 4         +                   // vInAnalyze, vOutAnalyze, vBuffer, vResult
-                                      BUFFER_SIZE * crossover_base_metadata::BANDS_MAX +          // band.vResult
+                                      BUFFER_SIZE * sizeof(float) * 5         +                   // vDry, vInAnalyze, vOutAnalyze, vBuffer, vResult
+                                      BUFFER_SIZE * sizeof(float) * crossover_base_metadata::BANDS_MAX +  // band.vResult
                                       crossover_base_metadata::BANDS_MAX * mesh_size * 2 +        // band.vTr
                                       crossover_base_metadata::BANDS_MAX * mesh_size              // band.vFc
                                   );
@@ -118,9 +119,15 @@ namespace lsp
 
             c->sBypass.construct();
             c->sXOver.construct();
+            c->sDryDelay.construct();
 
-            if (!c->sXOver.init(crossover_base_metadata::BANDS_MAX, BUFFER_SIZE))
+            if (!c->sXOver.init(crossover_base_metadata::BANDS_MAX, BUFFER_SIZE, crossover_base_metadata::XOVER_FFT_RANK))
                 return;
+            if (!c->sDryDelay.init(c->sXOver.max_latency()))
+                return;
+
+            // Build kernels of the FFT crossover outside of the processing thread
+            c->sXOver.set_executor(wrapper->get_executor());
 
             for (size_t i=0; i<crossover_base_metadata::BANDS_MAX; ++i)
             {
@@ -133,7 +140,7 @@ namespace lsp
                 b->vOut             = NULL;
 
                 b->vResult          = reinterpret_cast<float *>(ptr);
-                ptr                += BUFFER_SIZE;
+                ptr                += BUFFER_SIZE * sizeof(float);
                 b->vTr              = reinterpret_cast<float *>(ptr);           // Transfer buffer
                 ptr                += mesh_size * 2;
                 b->vFc              = reinterpret_cast<float *>(ptr);           // Frequency chart
@@ -168,6 +175,8 @@ namespace lsp
 
             c->vIn              = NULL;
             c->vOut             = NULL;
+            c->vDry             = reinterpret_cast<float *>(ptr);
+            ptr                += BUFFER_SIZE * sizeof(float);
             c->vInAnalyze       = reinterpret_cast<float *>(ptr);
             ptr                += BUFFER_SIZE * sizeof(float);
             c->vOutAnalyze      = reinterpret_cast<float *>(ptr);
@@ -188,6 +197,7 @@ namespace lsp
             vAnalyze[c->nAnOutChannel]  = c->vOutAnalyze;
 
             c->bSyncCurve       = false;
+            c->bUpdateCurve     = false;
             c->fInLevel         = 0.0f;
             c->fOutLevel        = 0.0f;
 
@@ -258,6 +268,8 @@ namespace lsp
         pShiftGain      = vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
         pZoom           = vPorts[port_id++];
+        TRACE_PORT(vPorts[port_id]);
+        pType           = vPorts[port_id++];
 
         if ((nMode == XOVER_LR) || (nMode == XOVER_MS))
         {
@@ -405,6 +417,7 @@ namespace lsp
                 channel_t *c    = &vChannels[i];
 
                 c->sXOver.destroy();
+                c->sDryDelay.destroy();
                 c->vBuffer      = NULL;
                 c->vTr          = NULL;
 
@@ -488,12 +501,15 @@ namespace lsp
             sync    = true;
         }
 
+        crossover_type_t type   = (pType->getValue() >= 0.5f) ? CROSS_TYPE_FFT : CROSS_TYPE_IIR;
+
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c    = &vChannels[i];
             Crossover *xc   = &c->sXOver;
 
             c->sBypass.set_bypass(pBypass->getValue() >= 0.5f);
+            xc->set_type(type);
 
             // Configure split points
             for (size_t i=0; i<crossover_base_metadata::BANDS_MAX-1; ++i)
@@ -545,47 +561,36 @@ namespace lsp
             bool csync = (sync) || (xc->needs_reconfiguration());
             xc->reconfigure();
 
-            // Output band parameters and update sync curve flag
+            // Output band parameters
             for (size_t j=0; j<crossover_base_metadata::BANDS_MAX; ++j)
             {
                 xover_band_t *b     = &c->vBands[j];
                 b->pFreqEnd->setValue(xc->get_band_end(j));
-                if (csync)
-                {
-                    // Get frequency response for band
-                    c->sXOver.freq_chart(j, b->vTr, vFreqs, crossover_base_metadata::MESH_POINTS);
-                    dsp::pcomplex_mod(b->vFc, b->vTr, crossover_base_metadata::MESH_POINTS);
-
-                    b->bSyncCurve       = true;
-                }
             }
 
+            // Compute frequency response only if there is someone to show it
             if (csync)
             {
-                // Compute amplitude response for the whole crossover
-                dsp::copy(c->vFc, c->vBands[0].vFc, crossover_base_metadata::MESH_POINTS);
-                for (size_t j=1; j<crossover_base_metadata::BANDS_MAX; ++j)
-                {
-                    xover_band_t *b     = &c->vBands[j];
-                    if (xc->band_active(j))
-                        dsp::add2(c->vFc, b->vFc, crossover_base_metadata::MESH_POINTS);
-                }
-
-                c->bSyncCurve       = true;
-            }
-
-            // Request for redraw
-            if ((csync) && (pWrapper != NULL))
+                c->bUpdateCurve     = true;
+                if (has_consumers())
+                    update_curves(c);
                 redraw              = true;
+            }
         }
 
+        // Update latency
+        size_t latency      = vChannels[0].sXOver.latency();
+        for (size_t i=0; i<channels; ++i)
+            vChannels[i].sDryDelay.set_delay(latency);
+        set_latency(latency);
+
         // Global parameters
         fInGain         = pInGain->getValue();
         fOutGain        = pOutGain->getValue();
         fZoom           = pZoom->getValue();
         bMSOut          = (pMSOut != NULL) ? pMSOut->getValue() >= 0.5f : false;
 
-        if (redraw)
+        if ((redraw) && (pWrapper != NULL))
             pWrapper->query_display_draw();
     }
 
@@ -613,8 +618,37 @@ namespace lsp
         sAnalyzer.set_sample_rate(sr);
     }
 
+    void crossover_base::update_curves(channel_t *c)
+    {
+        Crossover *xc   = &c->sXOver;
+
+        // Get frequency response for each band
+        for (size_t j=0; j<crossover_base_metadata::BANDS_MAX; ++j)
+        {
+            xover_band_t *b     = &c->vBands[j];
+            xc->freq_chart(j, b->vTr, vFreqs, crossover_base_metadata::MESH_POINTS);
+            dsp::pcomplex_mod(b->vFc, b->vTr, crossover_base_metadata::MESH_POINTS);
+            b->bSyncCurve       = true;
+        }
+
+        // Compute amplitude response for the whole crossover
+        dsp::copy(c->vFc, c->vBands[0].vFc, crossover_base_metadata::MESH_POINTS);
+        for (size_t j=1; j<crossover_base_metadata::BANDS_MAX; ++j)
+        {
+            xover_band_t *b     = &c->vBands[j];
+            if (xc->band_active(j))
+                dsp::add2(c->vFc, b->vFc, crossover_base_metadata::MESH_POINTS);
+        }
+
+        c->bSyncCurve       = true;
+        c->bUpdateCurve     = false;
+    }
+
     void crossover_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         // Determine number of channels
         size_t channels     = (nMode == XOVER_MONO) ? 1 : 2;
 
@@ -644,6 +678,8 @@ namespace lsp
 
     void crossover_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Determine number of channels
         size_t channels     = (nMode == XOVER_MONO) ? 1 : 2;
 
@@ -671,6 +707,13 @@ namespace lsp
             size_t to_do        = lsp_min(samples, BUFFER_SIZE);
 
             // Apply input gain and M/S transform (if required)
+            sProfiler.stage("input");
+            for (size_t i=0; i<channels; ++i)
+            {
+                channel_t *c        = &vChannels[i];
+                c->sDryDelay.process(c->vDry, c->vIn, to_do);
+            }
+
             if (nMode == XOVER_MS)
             {
                 vChannels[0].fInLevel   = lsp_max(vChannels[0].fInLevel, dsp::abs_max(vChannels[0].vIn, to_do) * fInGain);
@@ -704,6 +747,7 @@ namespace lsp
             }
 
             // Call the crossovers
+            sProfiler.stage("split");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -711,6 +755,7 @@ namespace lsp
             }
 
             // Output signal of each band to output buffers
+            sProfiler.stage("bands");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -729,6 +774,7 @@ namespace lsp
             }
 
             // Post-process and route signal to outputs via bypasses
+            sProfiler.stage("output");
             if (nMode == XOVER_MS)
             {
                 dsp::copy(vChannels[0].vOutAnalyze, vChannels[0].vResult, to_do);
@@ -743,8 +789,8 @@ namespace lsp
                 vChannels[0].fOutLevel  = lsp_max(vChannels[0].fOutLevel, dsp::abs_max(vChannels[0].vResult, to_do));
                 vChannels[1].fOutLevel  = lsp_max(vChannels[1].fOutLevel, dsp::abs_max(vChannels[1].vResult, to_do));
 
-                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vIn, vChannels[0].vResult, to_do);
-                vChannels[1].sBypass.process(vChannels[1].vOut, vChannels[1].vIn, vChannels[1].vResult, to_do);
+                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vDry, vChannels[0].vResult, to_do);
+                vChannels[1].sBypass.process(vChannels[1].vOut, vChannels[1].vDry, vChannels[1].vResult, to_do);
             }
             else if (channels > 1)
             {
@@ -757,8 +803,8 @@ namespace lsp
                 vChannels[0].fOutLevel  = lsp_max(vChannels[0].fOutLevel, dsp::abs_max(vChannels[0].vResult, to_do));
                 vChannels[1].fOutLevel  = lsp_max(vChannels[1].fOutLevel, dsp::abs_max(vChannels[1].vResult, to_do));
 
-                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vIn, vChannels[0].vResult, to_do);
-                vChannels[1].sBypass.process(vChannels[1].vOut, vChannels[1].vIn, vChannels[1].vResult, to_do);
+                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vDry, vChannels[0].vResult, to_do);
+                vChannels[1].sBypass.process(vChannels[1].vOut, vChannels[1].vDry, vChannels[1].vResult, to_do);
             }
             else
             {
@@ -767,11 +813,15 @@ namespace lsp
                 dsp::mul_k2(vChannels[0].vResult, fOutGain, to_do);
                 vChannels[0].fOutLevel  = lsp_max(vChannels[0].fOutLevel, dsp::abs_max(vChannels[0].vResult, to_do));
 
-                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vIn, vChannels[0].vResult, to_do);
+                vChannels[0].sBypass.process(vChannels[0].vOut, vChannels[0].vDry, vChannels[0].vResult, to_do);
             }
 
-            // Call the analyzer
-            sAnalyzer.process(vAnalyze, to_do);
+            // Call the analyzer only if there is someone to show results
+            if (ui_active())
+            {
+                sProfiler.stage("analysis");
+                sAnalyzer.process(vAnalyze, to_do);
+            }
 
             // Update pointers
             for (size_t i=0; i<channels; ++i)
@@ -792,8 +842,11 @@ namespace lsp
 
         //---------------------------------------------------------------------
         // Output meters and graphs
+        sProfiler.stage("meshes");
         mesh_t *mesh;
 
+        bool consumers      = has_consumers();
+
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c        = &vChannels[i];
@@ -801,6 +854,14 @@ namespace lsp
             c->pInLvl->setValue(c->fInLevel);
             c->pOutLvl->setValue(c->fOutLevel);
 
+            // Compute deferred frequency response
+            if ((c->bUpdateCurve) && (consumers))
+            {
+                update_curves(c);
+                if (pWrapper != NULL)
+                    pWrapper->query_display_draw();
+            }
+
             // Output transfer function of the mesh
             mesh        = ((c->bSyncCurve) && (c->pAmpGraph != NULL)) ? c->pAmpGraph->getBuffer<mesh_t>() : NULL;
             if ((mesh != NULL) && (mesh->isEmpty()))
@@ -836,6 +897,9 @@ namespace lsp
             }
 
             // Output spectrum analysis for input channel
+            if (!ui_active())
+                continue;
+
             mesh        = ((sAnalyzer.channel_active(c->nAnInChannel)) && (c->pFftIn != NULL)) ? c->pFftIn->getBuffer<mesh_t>() : NULL;
             if ((mesh != NULL) && (mesh->isEmpty()))
             {
@@ -1018,6 +1082,7 @@ namespace lsp
                 {
                     v->write_object("sBypasss", &c->sBypass);
                     v->write_object("sXOver", &c->sXOver);
+                    v->write_object("sDryDelay", &c->sDryDelay);
 
                     v->begin_array("vSplit", c->vSplit, crossover_base_metadata::BANDS_MAX-1);
                     {
@@ -1075,6 +1140,7 @@ namespace lsp
 
                     v->write("vIn", c->vIn);
                     v->write("vOut", c->vOut);
+                    v->write("vDry", c->vDry);
                     v->write("vInAnalyze", c->vInAnalyze);
                     v->write("vOutAnalyze", c->vOutAnalyze);
                     v->write("vBuffer", c->vBuffer);
@@ -1085,6 +1151,7 @@ namespace lsp
                     v->write("nAnInChannel", c->nAnInChannel);
                     v->write("nAnOutChannel", c->nAnOutChannel);
                     v->write("bSyncCurve", c->bSyncCurve);
+                    v->write("bUpdateCurve", c->bUpdateCurve);
                     v->write("fInLevel", c->fInLevel);
                     v->write("fOutLevel", c->fOutLevel);
 
@@ -1122,6 +1189,7 @@ namespace lsp
         v->write("pReactivity", pReactivity);
         v->write("pShiftGain", pShiftGain);
         v->write("pZoom", pZoom);
+        v->write("pType", pType);
         v->write("pMSOut", pMSOut);
     }
 
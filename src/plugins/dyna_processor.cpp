@@ -459,6 +459,7 @@ namespace lsp
             c->sProc.set_sample_rate(sr);
             c->sSC.set_sample_rate(sr);
             c->sSCEq.set_sample_rate(sr);
+            c->sSCEq.set_precise(sr > FILTER_PRECISE_SRATE);
             c->sDelay.init(max_delay);
             c->sCompDelay.init(max_delay);
             c->sDryDelay.init(max_delay);
@@ -624,6 +625,8 @@ namespace lsp
 
     void dyna_processor_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels = (nMode == DYNA_MONO) ? 1 : 2;
         size_t feedback = 0;
 
@@ -672,6 +675,7 @@ namespace lsp
             }
 
             // Process meters
+            sProfiler.stage("sidechain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -681,6 +685,7 @@ namespace lsp
             }
 
             // Do compression
+            sProfiler.stage("dynamics");
             switch (feedback)
             {
                 case 0:
@@ -780,6 +785,7 @@ namespace lsp
             }
 
             // Apply gain to each channel and process meters
+            sProfiler.stage("gain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -805,6 +811,7 @@ namespace lsp
             }
 
             // Form output signal
+            sProfiler.stage("output");
             if (nMode == DYNA_MS)
             {
                 channel_t *cm       = &vChannels[0];
@@ -862,6 +869,7 @@ namespace lsp
         if ((!bPause) || (bClear) || (bUISync))
         {
             // Process mesh requests
+            sProfiler.stage("meshes");
             for (size_t i=0; i<channels; ++i)
             {
                 // Get channel
@@ -893,6 +901,7 @@ namespace lsp
         }
 
         // Output curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c       = &vChannels[i];
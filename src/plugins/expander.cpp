@@ -407,6 +407,7 @@ namespace lsp
             c->sExp.set_sample_rate(sr);
             c->sSC.set_sample_rate(sr);
             c->sSCEq.set_sample_rate(sr);
+            c->sSCEq.set_precise(sr > FILTER_PRECISE_SRATE);
             c->sDelay.init(max_delay);
             c->sCompDelay.init(max_delay);
             c->sDryDelay.init(max_delay);
@@ -528,6 +529,8 @@ namespace lsp
 
     void expander_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels = (nMode == EM_MONO) ? 1 : 2;
 
         float *in_buf[2];   // Input buffer
@@ -569,6 +572,7 @@ namespace lsp
             }
 
             // Perform sidechain processing
+            sProfiler.stage("dynamics");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -586,6 +590,7 @@ namespace lsp
             }
 
             // Apply gain to each channel and process meters
+            sProfiler.stage("gain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -611,6 +616,7 @@ namespace lsp
             }
 
             // Form output signal
+            sProfiler.stage("output");
             if (nMode == EM_MS)
             {
                 channel_t *cm       = &vChannels[0];
@@ -666,6 +672,7 @@ namespace lsp
         if ((!bPause) || (bClear) || (bUISync))
         {
             // Process mesh requests
+            sProfiler.stage("meshes");
             for (size_t i=0; i<channels; ++i)
             {
                 // Get channel
@@ -697,6 +704,7 @@ namespace lsp
         }
 
         // Output expander curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c       = &vChannels[i];
@@ -172,6 +172,8 @@ namespace lsp
 
     void test_plugin::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         for (size_t i=0; i<2; ++i)
         {
             // Get data buffers
@@ -477,6 +479,8 @@ namespace lsp
 
     void filter_analyzer::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Bypass signal
         dsp::copy(pOut->getBuffer<float>(), pIn->getBuffer<float>(), samples);
 
@@ -427,6 +427,7 @@ namespace lsp
             c->sGate.set_sample_rate(sr);
             c->sSC.set_sample_rate(sr);
             c->sSCEq.set_sample_rate(sr);
+            c->sSCEq.set_precise(sr > FILTER_PRECISE_SRATE);
             c->sDelay.init(max_delay);
             c->sCompDelay.init(max_delay);
             c->sDryDelay.init(max_delay);
@@ -555,6 +556,8 @@ namespace lsp
 
     void gate_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels = (nMode == GM_MONO) ? 1 : 2;
 
         float *in_buf[2];   // Input buffer
@@ -598,6 +601,7 @@ namespace lsp
             }
 
             // Perform sidechain processing for each channel
+            sProfiler.stage("dynamics");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -623,6 +627,7 @@ namespace lsp
             }
 
             // Apply gain to each channel
+            sProfiler.stage("gain");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -648,6 +653,7 @@ namespace lsp
             }
 
             // Form output signal
+            sProfiler.stage("output");
             if (nMode == GM_MS)
             {
                 channel_t *cm       = &vChannels[0];
@@ -703,6 +709,7 @@ namespace lsp
         if ((!bPause) || (bClear) || (bUISync))
         {
             // Process mesh requests
+            sProfiler.stage("meshes");
             for (size_t i=0; i<channels; ++i)
             {
                 // Get channel
@@ -733,6 +740,7 @@ namespace lsp
         }
 
         // Output gate curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c       = &vChannels[i];
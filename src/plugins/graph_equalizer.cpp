@@ -53,6 +53,7 @@ namespace lsp
         pIDisplay       = NULL;
 
         pEqMode         = NULL;
+        pLowLatency     = NULL;
         pSlope          = NULL;
         pListen         = NULL;
         pInGain         = NULL;
@@ -207,6 +208,8 @@ namespace lsp
         TRACE_PORT(vPorts[port_id]);
         pEqMode                 = vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
+        pLowLatency             = vPorts[port_id++];
+        TRACE_PORT(vPorts[port_id]);
         pSlope                  = vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
         pFftMode                = vPorts[port_id++];
@@ -434,6 +437,7 @@ namespace lsp
         bMatched                    = (slope & 1) != 0;
         fInGain                     = pInGain->getValue();
         equalizer_mode_t eq_mode    = get_eq_mode();
+        bool low_latency            = pLowLatency->getValue() >= 0.5f;
         slope                       = graph_equalizer_base_metadata::SLOPE_MIN + (slope >> 1);
 
         // Update channels
@@ -445,6 +449,7 @@ namespace lsp
 
             // Update settings
             c->sEqualizer.set_mode(eq_mode);
+            c->sEqualizer.set_low_latency(low_latency);
             if (c->sBypass.set_bypass(bypass))
                 pWrapper->query_display_draw();
             c->fOutGain         = bal[i];
@@ -567,11 +572,15 @@ namespace lsp
             eq_channel_t *c     = &vChannels[i];
             c->sBypass.init(sr);
             c->sEqualizer.set_sample_rate(sr);
+            c->sEqualizer.set_precise(sr > FILTER_PRECISE_SRATE);
         }
     }
 
     void graph_equalizer_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         size_t channels     = ((nMode == EQ_MONO) || (nMode == EQ_STEREO)) ? 1 : 2;
         for (size_t i=0; i<channels; ++i)
             vChannels[i].nSync     = CS_UPDATE;
@@ -579,6 +588,8 @@ namespace lsp
 
     void graph_equalizer_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
         float *analyze[2];
 
@@ -607,6 +618,7 @@ namespace lsp
             }
 
             // Pre-process data
+            sProfiler.stage("input");
             if (nMode == EQ_MID_SIDE)
             {
                 if (!bListen)
@@ -654,13 +666,17 @@ namespace lsp
             if (fft_pos == FFTP_PRE)
                 sAnalyzer.process(analyze, to_process);
 
-            // Process each channel individually
+            // Process the signal by the equalizer, both channels at once if possible
+            sProfiler.stage("equalizer");
+            if (channels > 1)
+                Equalizer::process(&vChannels[0].sEqualizer, &vChannels[1].sEqualizer,
+                        vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
+            else
+                vChannels[0].sEqualizer.process(vChannels[0].vBuffer, vChannels[0].vBuffer, to_process);
+
             for (size_t i=0; i<channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
-
-                // Process the signal by the equalizer
-                c->sEqualizer.process(c->vBuffer, c->vBuffer, to_process);
                 if (c->fInGain != 1.0f)
                     dsp::mul_k2(c->vBuffer, c->fInGain, to_process);
             }
@@ -670,6 +686,7 @@ namespace lsp
                 sAnalyzer.process(analyze, to_process);
 
             // Post-process data (if needed)
+            sProfiler.stage("output");
             if ((nMode == EQ_MID_SIDE) && (!bListen))
                 dsp::ms_to_lr(vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
 
@@ -698,6 +715,7 @@ namespace lsp
         }
 
         // Output FFT curves for each channel and report latency
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             eq_channel_t *c     = &vChannels[i];
@@ -720,6 +738,11 @@ namespace lsp
             }
         }
 
+        // Skip curves computation if there is no one to show them,
+        // pending updates are applied when a consumer appears
+        if (!has_consumers())
+            return;
+
         // For Mono and Stereo channels only the first channel should be processed
         if (nMode == EQ_STEREO)
             channels        = 1;
@@ -579,8 +579,11 @@ namespace lsp
 
     void impulse_responses_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         //---------------------------------------------------------------------
         // Stage 1: process reconfiguration requests and file events
+        sProfiler.stage("reconfigure");
         if (sConfigurator.idle())
         {
             // Check that reconfigure is pending
@@ -676,6 +679,7 @@ namespace lsp
 
         //---------------------------------------------------------------------
         // Stage 2: perform convolution
+        sProfiler.stage("convolution");
         // Get pointers to data channels
         for (size_t i=0; i<nChannels; ++i)
         {
@@ -717,6 +721,7 @@ namespace lsp
 
         //---------------------------------------------------------------------
         // Stage 3: output parameters
+        sProfiler.stage("meshes");
 
         for (size_t i=0; i<nChannels; ++i)
         {
@@ -786,9 +791,9 @@ namespace lsp
         if (af == NULL)
             return STATUS_NO_MEM;
 
-        // Try to load file
+        // Try to load and resample file
         float convLengthMaxSeconds = impulse_reverb_base_metadata::CONV_LENGTH_MAX * 0.001f;
-        status_t status = af->load(fname,  convLengthMaxSeconds);
+        status_t status = af->load_resampled(fname, fSampleRate, convLengthMaxSeconds);
         if (status != STATUS_OK)
         {
             af->destroy();
@@ -797,16 +802,6 @@ namespace lsp
             return status;
         }
 
-        // Try to resample
-        status  = af->resample(fSampleRate);
-        if (status != STATUS_OK)
-        {
-            af->destroy();
-            delete af;
-            lsp_trace("resample failed: status=%d (%s)", status, get_status(status));
-            return status;
-        }
-
         // Determine the normalizing factor
         size_t channels         = af->channels();
         float max = 0.0f;
@@ -946,7 +941,7 @@ namespace lsp
 
             // Now we can create convolver
             Convolver *cv   = new Convolver();
-            if (!cv->init(s->getBuffer(track), s->length(), cfg[i].nRank, float((phase + i*step)& 0x7fffffff)/float(0x80000000)))
+            if (!cv->init(s->getBuffer(track), s->length(), cfg[i].nRank, float((phase + i*step)& 0x7fffffff)/float(0x80000000), CONV_MODE_THREADED))
                 return STATUS_NO_MEM;
             c->pSwap        = cv;
         }
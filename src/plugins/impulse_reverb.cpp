@@ -778,12 +778,16 @@ namespace lsp
 
     void impulse_reverb_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         //---------------------------------------------------------------------
         // Stage 1: process reconfiguration requests and file events
+        sProfiler.stage("reconfigure");
         sync_offline_tasks();
 
         //---------------------------------------------------------------------
         // Stage 2: perform convolution
+        sProfiler.stage("convolution");
         // Get pointers to data channels
         for (size_t i=0; i<nInputs; ++i)
             vInputs[i].vIn      = vInputs[i].pIn->getBuffer<float>();
@@ -827,6 +831,7 @@ namespace lsp
             }
 
             // Now apply equalization, bypass control and players
+            sProfiler.stage("output");
             for (size_t i=0; i<2; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -856,6 +861,7 @@ namespace lsp
 
         //---------------------------------------------------------------------
         // Stage 3: output parameters
+        sProfiler.stage("meshes");
         for (size_t i=0; i<impulse_reverb_base_metadata::CONVOLVERS; ++i)
         {
             // Output information about the convolver
@@ -926,9 +932,9 @@ namespace lsp
         if (af == NULL)
             return STATUS_NO_MEM;
 
-        // Try to load file
+        // Try to load and resample file
         float convLengthMaxSeconds = impulse_reverb_base_metadata::CONV_LENGTH_MAX * 0.001f;
-        status_t status = af->load(fname, convLengthMaxSeconds);
+        status_t status = af->load_resampled(fname, fSampleRate, convLengthMaxSeconds);
         if (status != STATUS_OK)
         {
             af->destroy();
@@ -937,16 +943,6 @@ namespace lsp
             return status;
         }
 
-        // Try to resample
-        status  = af->resample(fSampleRate);
-        if (status != STATUS_OK)
-        {
-            af->destroy();
-            delete af;
-            lsp_trace("resample failed: status=%d (%s)", status, get_status(status));
-            return status;
-        }
-
         // Determine the normalizing factor
         size_t channels         = af->channels();
         float max = 0.0f;
@@ -1101,7 +1097,7 @@ namespace lsp
 
             // Now we can create convolver
             Convolver *cv   = new Convolver();
-            if (!cv->init(s->getBuffer(track), s->length(), cfg->nRank[i], float((phase + i*step)& 0x7fffffff)/float(0x80000000)))
+            if (!cv->init(s->getBuffer(track), s->length(), cfg->nRank[i], float((phase + i*step)& 0x7fffffff)/float(0x80000000), CONV_MODE_THREADED))
             {
                 cv->destroy();
                 delete cv;
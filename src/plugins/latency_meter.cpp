@@ -109,6 +109,8 @@ namespace lsp
 
     void latency_meter::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         float *in = pIn->getBuffer<float>();
         if (in == NULL)
             return;
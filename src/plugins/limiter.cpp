@@ -329,6 +329,11 @@ namespace lsp
             case limiter_base_metadata::OVS_HALF_ ## x: \
             case limiter_base_metadata::OVS_FULL_ ## x: \
                 return OM_LANCZOS_ ## x;
+        #define F_KEY(x) \
+            case limiter_base_metadata::OVS_FIR_LINEAR_ ## x: \
+                return OM_FIR_LINEAR_ ## x; \
+            case limiter_base_metadata::OVS_FIR_MINPHASE_ ## x: \
+                return OM_FIR_MINPHASE_ ## x;
 
         switch (mode)
         {
@@ -343,11 +348,18 @@ namespace lsp
             L_KEY(8X2)
             L_KEY(8X3)
 
+            F_KEY(2X)
+            F_KEY(3X)
+            F_KEY(4X)
+            F_KEY(6X)
+            F_KEY(8X)
+
             case limiter_base_metadata::OVS_NONE:
             default:
                 return OM_NONE;
         }
         #undef L_KEY
+        #undef F_KEY
         return OM_NONE;
     }
 
@@ -514,6 +526,8 @@ namespace lsp
 
     void limiter_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Bind audio ports
         for (size_t i=0; i<nChannels; ++i)
         {
@@ -531,6 +545,7 @@ namespace lsp
         for (size_t nsamples = samples; nsamples > 0; )
         {
             // Perform oversampling of signal and sidechain
+            sProfiler.stage("upsampling");
             size_t to_do    = (nsamples > buf_size) ? buf_size : nsamples;
             size_t to_doxn  = to_do * times;
 
@@ -573,10 +588,12 @@ namespace lsp
                 c->pMeter[G_SC]->setValue(dsp::max(c->vScBuf, to_doxn));
 
                 // Perform processing by limiter
+                sProfiler.stage("limiter");
                 c->sLimit.process(c->vDataBuf, c->vGainBuf, c->vDataBuf, c->vScBuf, to_doxn);
             }
 
             // Perform stereo linking
+            sProfiler.stage("link");
             if (nChannels == 2)
             {
                 float *cl = vChannels[0].vGainBuf;
@@ -595,6 +612,7 @@ namespace lsp
             }
 
             // Perform downsampling and post-processing of signal and sidechain
+            sProfiler.stage("downsampling");
             for (size_t i=0; i<nChannels; ++i)
             {
                 channel_t *c    = &vChannels[i];
@@ -636,6 +654,7 @@ namespace lsp
         }
 
         // Output history
+        sProfiler.stage("meshes");
         if ((!bPause) || (bClear) || (bUISync))
         {
             // Process mesh requests
@@ -453,6 +453,8 @@ namespace lsp
 
     void loud_comp_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         //---------------------------------------------------------------------
         // Bind ports
         for (size_t i=0; i<nChannels; ++i)
@@ -37,6 +37,7 @@ namespace lsp
         bSidechain      = sc;
         bEnvUpdate      = true;
         bModern         = true;
+        bDisplaySync    = true;
         nEnvBoost       = mb_compressor_base_metadata::FB_DEFAULT;
         vChannels       = NULL;
         fInGain         = GAIN_AMP_0_DB;
@@ -1076,6 +1077,7 @@ namespace lsp
 
         nEnvBoost       = env_boost;
         bEnvUpdate      = false;
+        bDisplaySync    = true;
     }
 
     void mb_compressor_base::update_sample_rate(long sr)
@@ -1087,6 +1089,7 @@ namespace lsp
         // Update analyzer's sample rate
         sAnalyzer.set_sample_rate(sr);
         sFilters.set_sample_rate(sr);
+        sFilters.set_precise(sr > FILTER_PRECISE_SRATE);
         bEnvUpdate          = true;
 
         // Update channels
@@ -1120,6 +1123,9 @@ namespace lsp
 
     void mb_compressor_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
 
         for (size_t i=0; i<channels; ++i)
@@ -1155,6 +1161,8 @@ namespace lsp
 
     void mb_compressor_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels     = (nMode == MBCM_MONO) ? 1 : 2;
 
         // Bind input signal
@@ -1174,6 +1182,7 @@ namespace lsp
             size_t to_process   = (samples > MBC_BUFFER_SIZE) ? MBC_BUFFER_SIZE : samples;
 
             // Measure input signal level
+            sProfiler.stage("input");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1214,6 +1223,7 @@ namespace lsp
 
 
             // Do frequency boost and input channel analysis
+            sProfiler.stage("split");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1225,6 +1235,7 @@ namespace lsp
             }
 
             // MAIN PLUGIN STUFF
+            sProfiler.stage("dynamics");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1255,7 +1266,11 @@ namespace lsp
                         b->pCurveLvl->setValue(lvl);
 
                         // Remember last envelope level and buffer level
-                        b->fGainLevel   = b->vVCA[to_process-1];
+                        if (b->fGainLevel != b->vVCA[to_process-1])
+                        {
+                            b->fGainLevel   = b->vVCA[to_process-1];
+                            bDisplaySync    = true;
+                        }
 
                         // Check muting option
                         if (b->bMute)
@@ -1264,7 +1279,11 @@ namespace lsp
                     else
                     {
                         dsp::fill(b->vVCA, (b->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, to_process);
-                        b->fGainLevel   = GAIN_AMP_0_DB;
+                        if (b->fGainLevel != GAIN_AMP_0_DB)
+                        {
+                            b->fGainLevel   = GAIN_AMP_0_DB;
+                            bDisplaySync    = true;
+                        }
                     }
                 }
 
@@ -1282,6 +1301,7 @@ namespace lsp
             }
 
             // Here, we apply VCA to input signal dependent on the input
+            sProfiler.stage("mix");
             if (bModern) // 'Modern' mode
             {
                 // Apply VCA control
@@ -1326,13 +1346,15 @@ namespace lsp
             // MAIN PLUGIN STUFF END
 
             // Do output channel analysis
+            sProfiler.stage("output");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
                 dsp::copy(c->vOutAnalyze, c->vBuffer, to_process);
             }
 
-            sAnalyzer.process(vAnalyze, to_process);
+            if (ui_active())
+                sAnalyzer.process(vAnalyze, to_process);
 
             // Post-process data (if needed)
             if (nMode == MBCM_MS)
@@ -1361,7 +1383,20 @@ namespace lsp
             samples    -= to_process;
         } // while (samples > 0)
 
+        // Skip curves computation if there is no one to show them, but ask
+        // the host to draw the inline display if its data has changed
+        if (!has_consumers())
+        {
+            if ((bDisplaySync) && (pWrapper != NULL))
+            {
+                pWrapper->query_display_draw();
+                bDisplaySync    = false;
+            }
+            return;
+        }
+
         // Output FFT curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c     = &vChannels[i];
@@ -1509,6 +1544,7 @@ namespace lsp
         // Request for redraw
         if (pWrapper != NULL)
             pWrapper->query_display_draw();
+        bDisplaySync    = false;
     }
 
     bool mb_compressor_base::inline_display(ICanvas *cv, size_t width, size_t height)
@@ -36,6 +36,7 @@ namespace lsp
         bSidechain      = sc;
         bEnvUpdate      = true;
         bModern         = true;
+        bDisplaySync    = true;
         nEnvBoost       = mb_expander_base_metadata::FB_DEFAULT;
         vChannels       = NULL;
         fInGain         = GAIN_AMP_0_DB;
@@ -1029,6 +1030,7 @@ namespace lsp
 
         nEnvBoost       = env_boost;
         bEnvUpdate      = false;
+        bDisplaySync    = true;
     }
 
     void mb_expander_base::update_sample_rate(long sr)
@@ -1040,6 +1042,7 @@ namespace lsp
         // Update analyzer's sample rate
         sAnalyzer.set_sample_rate(sr);
         sFilters.set_sample_rate(sr);
+        sFilters.set_precise(sr > FILTER_PRECISE_SRATE);
         bEnvUpdate          = true;
 
         // Update channels
@@ -1073,6 +1076,9 @@ namespace lsp
 
     void mb_expander_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         size_t channels     = (nMode == MBEM_MONO) ? 1 : 2;
 
         for (size_t i=0; i<channels; ++i)
@@ -1089,6 +1095,8 @@ namespace lsp
 
     void mb_expander_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels     = (nMode == MBEM_MONO) ? 1 : 2;
 
         // Bind input signal
@@ -1108,6 +1116,7 @@ namespace lsp
             size_t to_process   = (samples > MBE_BUFFER_SIZE) ? MBE_BUFFER_SIZE : samples;
 
             // Measure input signal level
+            sProfiler.stage("input");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1148,6 +1157,7 @@ namespace lsp
 
 
             // Do frequency boost and input channel analysis
+            sProfiler.stage("split");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1159,6 +1169,7 @@ namespace lsp
             }
 
             // MAIN PLUGIN STUFF
+            sProfiler.stage("dynamics");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1191,7 +1202,11 @@ namespace lsp
                         b->pCurveLvl->setValue(lvl);
 
                         // Remember last envelope level and buffer level
-                        b->fGainLevel   = b->vVCA[to_process-1];
+                        if (b->fGainLevel != b->vVCA[to_process-1])
+                        {
+                            b->fGainLevel   = b->vVCA[to_process-1];
+                            bDisplaySync    = true;
+                        }
 
                         // Check muting option
                         if (b->bMute)
@@ -1200,7 +1215,11 @@ namespace lsp
                     else
                     {
                         dsp::fill(b->vVCA, (b->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, to_process);
-                        b->fGainLevel   = GAIN_AMP_0_DB;
+                        if (b->fGainLevel != GAIN_AMP_0_DB)
+                        {
+                            b->fGainLevel   = GAIN_AMP_0_DB;
+                            bDisplaySync    = true;
+                        }
                     }
                 }
 
@@ -1218,6 +1237,7 @@ namespace lsp
             }
 
             // Here, we apply VCA to input signal dependent on the input
+            sProfiler.stage("mix");
             if (bModern) // 'Modern' mode
             {
                 // Apply VCA control
@@ -1262,13 +1282,15 @@ namespace lsp
             // MAIN PLUGIN STUFF END
 
             // Do output channel analysis
+            sProfiler.stage("output");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
                 dsp::copy(c->vOutAnalyze, c->vBuffer, to_process);
             }
 
-            sAnalyzer.process(vAnalyze, to_process);
+            if (ui_active())
+                sAnalyzer.process(vAnalyze, to_process);
 
             // Post-process data (if needed)
             if (nMode == MBEM_MS)
@@ -1297,7 +1319,20 @@ namespace lsp
             samples    -= to_process;
         } // while (samples > 0)
 
+        // Skip curves computation if there is no one to show them, but ask
+        // the host to draw the inline display if its data has changed
+        if (!has_consumers())
+        {
+            if ((bDisplaySync) && (pWrapper != NULL))
+            {
+                pWrapper->query_display_draw();
+                bDisplaySync    = false;
+            }
+            return;
+        }
+
         // Output FFT curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c     = &vChannels[i];
@@ -1445,6 +1480,7 @@ namespace lsp
         // Request for redraw
         if (pWrapper != NULL)
             pWrapper->query_display_draw();
+        bDisplaySync    = false;
     }
 
     bool mb_expander_base::inline_display(ICanvas *cv, size_t width, size_t height)
@@ -36,6 +36,7 @@ namespace lsp
         bSidechain      = sc;
         bEnvUpdate      = true;
         bModern         = true;
+        bDisplaySync    = true;
         nEnvBoost       = mb_gate_base_metadata::FB_DEFAULT;
         vChannels       = NULL;
         fInGain         = GAIN_AMP_0_DB;
@@ -1036,6 +1037,7 @@ namespace lsp
 
         nEnvBoost       = env_boost;
         bEnvUpdate      = false;
+        bDisplaySync    = true;
     }
 
     void mb_gate_base::update_sample_rate(long sr)
@@ -1047,6 +1049,7 @@ namespace lsp
         // Update analyzer's sample rate
         sAnalyzer.set_sample_rate(sr);
         sFilters.set_sample_rate(sr);
+        sFilters.set_precise(sr > FILTER_PRECISE_SRATE);
         bEnvUpdate          = true;
 
         // Update channels
@@ -1080,6 +1083,9 @@ namespace lsp
 
     void mb_gate_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         size_t channels     = (nMode == MBGM_MONO) ? 1 : 2;
 
         for (size_t i=0; i<channels; ++i)
@@ -1096,6 +1102,8 @@ namespace lsp
 
     void mb_gate_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels     = (nMode == MBGM_MONO) ? 1 : 2;
 
         // Bind input signal
@@ -1115,6 +1123,7 @@ namespace lsp
             size_t to_process   = (samples > MBG_BUFFER_SIZE) ? MBG_BUFFER_SIZE : samples;
 
             // Measure input signal level
+            sProfiler.stage("input");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1155,6 +1164,7 @@ namespace lsp
 
 
             // Do frequency boost and input channel analysis
+            sProfiler.stage("split");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1166,6 +1176,7 @@ namespace lsp
             }
 
             // MAIN PLUGIN STUFF
+            sProfiler.stage("dynamics");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
@@ -1199,7 +1210,11 @@ namespace lsp
 
                         // Remember last envelope level and buffer level
                         b->fEnvLevel    = vEnv[to_process-1];
-                        b->fGainLevel   = b->vVCA[to_process-1];
+                        if (b->fGainLevel != b->vVCA[to_process-1])
+                        {
+                            b->fGainLevel   = b->vVCA[to_process-1];
+                            bDisplaySync    = true;
+                        }
 
                         // Check muting option
                         if (b->bMute)
@@ -1209,7 +1224,11 @@ namespace lsp
                     {
                         dsp::fill(b->vVCA, (b->bMute) ? GAIN_AMP_M_36_DB : GAIN_AMP_0_DB, to_process);
                         b->fEnvLevel    = GAIN_AMP_0_DB;
-                        b->fGainLevel   = GAIN_AMP_0_DB;
+                        if (b->fGainLevel != GAIN_AMP_0_DB)
+                        {
+                            b->fGainLevel   = GAIN_AMP_0_DB;
+                            bDisplaySync    = true;
+                        }
                     }
                 }
 
@@ -1227,6 +1246,7 @@ namespace lsp
             }
 
             // Here, we apply VCA to input signal dependent on the input
+            sProfiler.stage("mix");
             if (bModern) // 'Modern' mode
             {
                 // Apply VCA control
@@ -1271,13 +1291,15 @@ namespace lsp
             // MAIN PLUGIN STUFF END
 
             // Do output channel analysis
+            sProfiler.stage("output");
             for (size_t i=0; i<channels; ++i)
             {
                 channel_t *c        = &vChannels[i];
                 dsp::copy(c->vOutAnalyze, c->vBuffer, to_process);
             }
 
-            sAnalyzer.process(vAnalyze, to_process);
+            if (ui_active())
+                sAnalyzer.process(vAnalyze, to_process);
 
             // Post-process data (if needed)
             if (nMode == MBGM_MS)
@@ -1306,7 +1328,20 @@ namespace lsp
             samples    -= to_process;
         } // while (samples > 0)
 
+        // Skip curves computation if there is no one to show them, but ask
+        // the host to draw the inline display if its data has changed
+        if (!has_consumers())
+        {
+            if ((bDisplaySync) && (pWrapper != NULL))
+            {
+                pWrapper->query_display_draw();
+                bDisplaySync    = false;
+            }
+            return;
+        }
+
         // Output FFT curves for each channel
+        sProfiler.stage("curves");
         for (size_t i=0; i<channels; ++i)
         {
             channel_t *c     = &vChannels[i];
@@ -1458,6 +1493,7 @@ namespace lsp
         // Request for redraw
         if (pWrapper != NULL)
             pWrapper->query_display_draw();
+        bDisplaySync    = false;
     }
 
     bool mb_gate_base::inline_display(ICanvas *cv, size_t width, size_t height)
@@ -518,6 +518,8 @@ namespace lsp
 
     void nonlinear_convolver_mono::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         float *in = pIn->getBuffer<float>();
         if (in == NULL)
             return;
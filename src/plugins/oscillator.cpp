@@ -223,6 +223,8 @@ namespace lsp
 
     void oscillator_mono::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         float *in = pIn->getBuffer<float>();
         if (in == NULL)
             return;
@@ -157,18 +157,18 @@ namespace lsp
 
         rFilterBank.begin();
 
-        biquad_x1_t *f = rFilterBank.add_chain();
+        biquad_dx1_t *f = rFilterBank.add_chain();
         if (f == NULL)
             return;
 
         f->b0   = sDCBlockParams.fGain;
         f->b1   = -sDCBlockParams.fGain;
-        f->b2   = 0.0f;
+        f->b2   = 0.0;
         f->a1   = sDCBlockParams.fAlpha;
-        f->a2   = 0.0f;
-        f->p0   = 0.0f;
-        f->p1   = 0.0f;
-        f->p2   = 0.0f;
+        f->a2   = 0.0;
+        f->p0   = 0.0;
+        f->p1   = 0.0;
+        f->p2   = 0.0;
 
         rFilterBank.end(true);
     }
@@ -1193,6 +1193,8 @@ namespace lsp
 
     void oscilloscope_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Prepare channels
         for (size_t ch = 0; ch < nChannels; ++ch)
         {
@@ -58,6 +58,7 @@ namespace lsp
         pShiftGain  = NULL;
         pZoom       = NULL;
         pEqMode     = NULL;
+        pLowLatency = NULL;
         pBalance    = NULL;
     }
     
@@ -508,6 +509,8 @@ namespace lsp
         TRACE_PORT(vPorts[port_id]);
         pEqMode                 = vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
+        pLowLatency             = vPorts[port_id++];
+        TRACE_PORT(vPorts[port_id]);
         pFftMode                = vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
         pReactivity             = vPorts[port_id++];
@@ -621,6 +624,9 @@ namespace lsp
 
     void para_equalizer_base::ui_activated()
     {
+        // Resume spectrum analysis from scratch
+        sAnalyzer.reset();
+
         size_t channels     = ((nMode == EQ_MONO) || (nMode == EQ_STEREO)) ? 1 : 2;
         for (size_t i=0; i<channels; ++i)
             for (size_t j=0; j<nFilters; ++j)
@@ -736,6 +742,7 @@ namespace lsp
 
         // Update equalizer mode
         equalizer_mode_t eq_mode    = get_eq_mode();
+        bool low_latency            = pLowLatency->getValue() >= 0.5f;
         bool bypass                 = pBypass->getValue() >= 0.5f;
 
         // For each channel
@@ -746,6 +753,7 @@ namespace lsp
             bool solo           = false;
             bool visible        = (c->pVisible == NULL) ?  true : (c->pVisible->getValue() >= 0.5f);
             c->sEqualizer.set_mode(eq_mode);
+            c->sEqualizer.set_low_latency(low_latency);
 
             // Update settings
             if (c->sBypass.set_bypass(bypass))
@@ -843,11 +851,14 @@ namespace lsp
             eq_channel_t *c     = &vChannels[i];
             c->sBypass.init(sr);
             c->sEqualizer.set_sample_rate(sr);
+            c->sEqualizer.set_precise(sr > FILTER_PRECISE_SRATE);
         }
     }
 
     void para_equalizer_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         size_t channels     = (nMode == EQ_MONO) ? 1 : 2;
         float *analyze[2];
 
@@ -875,6 +886,7 @@ namespace lsp
             }
 
             // Pre-process data
+            sProfiler.stage("input");
             if (nMode == EQ_MID_SIDE)
             {
                 if (!bListen)
@@ -922,13 +934,17 @@ namespace lsp
             if (fft_pos == FFTP_PRE)
                 sAnalyzer.process(analyze, to_process);
 
-            // Process each channel individually
+            // Process the signal by the equalizer, both channels at once if possible
+            sProfiler.stage("equalizer");
+            if (channels > 1)
+                Equalizer::process(&vChannels[0].sEqualizer, &vChannels[1].sEqualizer,
+                        vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
+            else
+                vChannels[0].sEqualizer.process(vChannels[0].vBuffer, vChannels[0].vBuffer, to_process);
+
             for (size_t i=0; i<channels; ++i)
             {
                 eq_channel_t *c     = &vChannels[i];
-
-                // Process the signal by the equalizer
-                c->sEqualizer.process(c->vBuffer, c->vBuffer, to_process);
                 if (c->fInGain != 1.0f)
                     dsp::mul_k2(c->vBuffer, c->fInGain, to_process);
             }
@@ -938,6 +954,7 @@ namespace lsp
                 sAnalyzer.process(analyze, to_process);
 
             // Post-process data (if needed)
+            sProfiler.stage("output");
             if ((nMode == EQ_MID_SIDE) && (!bListen))
                 dsp::ms_to_lr(vChannels[0].vBuffer, vChannels[1].vBuffer, vChannels[0].vBuffer, vChannels[1].vBuffer, to_process);
 
@@ -966,6 +983,7 @@ namespace lsp
         }
 
         // Output FFT curves for each channel and report latency
+        sProfiler.stage("curves");
         size_t latency          = 0;
 
         for (size_t i=0; i<channels; ++i)
@@ -995,6 +1013,11 @@ namespace lsp
 
         set_latency(latency);
 
+        // Skip curves computation if there is no one to show them,
+        // pending updates are applied when a consumer appears
+        if (!has_consumers())
+            return;
+
         // For Mono and Stereo channels only the first channel should be processed
         if (nMode == EQ_STEREO)
             channels        = 1;
@@ -165,6 +165,8 @@ namespace lsp
 
     void phase_detector::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Store pointers to buffers
         float *in_a         = vPorts[IN_A]->getBuffer<float>(); //reinterpret_cast<float *>(vPorts[IN_A]    -> getBuffer());
         float *in_b         = vPorts[IN_B]->getBuffer<float>(); // reinterpret_cast<float *>(vPorts[IN_B]    -> getBuffer());
@@ -655,6 +655,8 @@ namespace lsp
 
     void profiler_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Bind audio ports
         for (size_t ch = 0; ch < nChannels; ++ch)
         {
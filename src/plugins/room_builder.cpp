@@ -32,6 +32,7 @@
 
 #define TMP_BUF_SIZE            4096
 #define CONV_RANK               10
+#define PREVIEW_ENERGY          1e-3f
 #define TRACE_PORT(p)           lsp_trace("  port id=%s", (p)->metadata()->id);
 
 namespace lsp
@@ -70,20 +71,29 @@ namespace lsp
         return pBuilder->start_rendering();
     }
 
-    template <class T>
-        static bool kvt_deploy(KVTStorage *s, const char *base, const char *branch, T value, size_t flags)
-        {
-            char name[0x100]; // Should be enough
-            size_t len = ::strlen(base) + ::strlen(branch) + 2;
-            if (len >= 0x100)
-                return false;
+    static inline void kvt_entry(kvt_entry_t *e, const char *name, int32_t value, size_t flags)
+    {
+        e->name         = name;
+        e->value.type   = KVT_INT32;
+        e->value.i32    = value;
+        e->flags        = flags;
+    }
 
-            char *tail = ::stpcpy(name, base);
-            *(tail++)  = '/';
-            stpcpy(tail, branch);
+    static inline void kvt_entry(kvt_entry_t *e, const char *name, float value, size_t flags)
+    {
+        e->name         = name;
+        e->value.type   = KVT_FLOAT32;
+        e->value.f32    = value;
+        e->flags        = flags;
+    }
 
-            return s->put(name, value, flags) == STATUS_OK;
-        }
+    static inline void kvt_entry(kvt_entry_t *e, const char *name, const char *value, size_t flags)
+    {
+        e->name         = name;
+        e->value.type   = KVT_STRING;
+        e->value.str    = value;
+        e->flags        = flags;
+    }
 
     status_t room_builder_base::SceneLoader::run()
     {
@@ -118,52 +128,63 @@ namespace lsp
         size_t f_hue    = (nFlags & (PF_STATE_IMPORT | PF_STATE_RESTORE)) ? KVT_KEEP | KVT_TX : KVT_TX;
 
         char base[128];
-        kvt_deploy(kvt, "/scene", "objects", int32_t(nobjs), KVT_TX);
-        kvt_deploy(kvt, "/scene", "selected", 0.0f, f_extra);
+        kvt_entry_t v[0x20];
+        size_t n = 0;
+
+        kvt_entry(&v[n++], "objects", int32_t(nobjs), KVT_TX);
+        kvt_entry(&v[n++], "selected", 0.0f, f_extra);
+        kvt->put_batch("/scene", v, n);
 
         for (size_t i=0; i<nobjs; ++i)
         {
             Object3D *obj       = sScene.object(i);
             if (obj == NULL)
+            {
+                pCore->kvt_release();
                 return STATUS_UNKNOWN_ERR;
+            }
             const point3d_t *c  = obj->center();
 
             sprintf(base, "/scene/object/%d", int(i));
             lsp_trace("Deploying KVT parameters for %s", base);
 
-            kvt_deploy(kvt, base, "name", obj->get_name(), KVT_TX); // Always overwrite name
-
-            kvt_deploy(kvt, base, "enabled", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "center/x", c->x, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
-            kvt_deploy(kvt, base, "center/y", c->y, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
-            kvt_deploy(kvt, base, "center/z", c->z, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
-            kvt_deploy(kvt, base, "position/x", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "position/y", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "position/z", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "rotation/yaw", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "rotation/pitch", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "rotation/roll", 0.0f, f_extra);
-            kvt_deploy(kvt, base, "scale/x", 100.0f, f_extra);
-            kvt_deploy(kvt, base, "scale/y", 100.0f, f_extra);
-            kvt_deploy(kvt, base, "scale/z", 100.0f, f_extra);
-            kvt_deploy(kvt, base, "color/hue", float(i) / float(nobjs), f_hue); // Always overwrite hue
-
-            kvt_deploy(kvt, base, "material/absorption/outer", 1.5f, f_extra); // Absorption of concrete material
-            kvt_deploy(kvt, base, "material/dispersion/outer", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/diffusion/outer", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/transparency/outer", 48.0f, f_extra);
-
-            kvt_deploy(kvt, base, "material/absorption/inner", 1.5f, f_extra);
-            kvt_deploy(kvt, base, "material/dispersion/inner", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/diffusion/inner", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/transparency/inner", 52.0f, f_extra);
-
-            kvt_deploy(kvt, base, "material/absorption/link", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/dispersion/link", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/diffusion/link", 1.0f, f_extra);
-            kvt_deploy(kvt, base, "material/transparency/link", 1.0f, f_extra);
-
-            kvt_deploy(kvt, base, "material/sound_speed", 4250.0f, f_extra);  // Sound speed in concrete material
+            // All object's parameters are deployed as a single batch
+            n = 0;
+            kvt_entry(&v[n++], "name", obj->get_name(), KVT_TX); // Always overwrite name
+
+            kvt_entry(&v[n++], "enabled", 1.0f, f_extra);
+            kvt_entry(&v[n++], "center/x", c->x, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
+            kvt_entry(&v[n++], "center/y", c->y, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
+            kvt_entry(&v[n++], "center/z", c->z, KVT_TX | KVT_TRANSIENT); // Always overwrite, do not save in state
+            kvt_entry(&v[n++], "position/x", 0.0f, f_extra);
+            kvt_entry(&v[n++], "position/y", 0.0f, f_extra);
+            kvt_entry(&v[n++], "position/z", 0.0f, f_extra);
+            kvt_entry(&v[n++], "rotation/yaw", 0.0f, f_extra);
+            kvt_entry(&v[n++], "rotation/pitch", 0.0f, f_extra);
+            kvt_entry(&v[n++], "rotation/roll", 0.0f, f_extra);
+            kvt_entry(&v[n++], "scale/x", 100.0f, f_extra);
+            kvt_entry(&v[n++], "scale/y", 100.0f, f_extra);
+            kvt_entry(&v[n++], "scale/z", 100.0f, f_extra);
+            kvt_entry(&v[n++], "color/hue", float(i) / float(nobjs), f_hue); // Always overwrite hue
+
+            kvt_entry(&v[n++], "material/absorption/outer", 1.5f, f_extra); // Absorption of concrete material
+            kvt_entry(&v[n++], "material/dispersion/outer", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/diffusion/outer", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/transparency/outer", 48.0f, f_extra);
+
+            kvt_entry(&v[n++], "material/absorption/inner", 1.5f, f_extra);
+            kvt_entry(&v[n++], "material/dispersion/inner", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/diffusion/inner", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/transparency/inner", 52.0f, f_extra);
+
+            kvt_entry(&v[n++], "material/absorption/link", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/dispersion/link", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/diffusion/link", 1.0f, f_extra);
+            kvt_entry(&v[n++], "material/transparency/link", 1.0f, f_extra);
+
+            kvt_entry(&v[n++], "material/sound_speed", 4250.0f, f_extra);  // Sound speed in concrete material
+
+            kvt->put_batch(base, v, n);
         }
 
         // Drop rare (unused) objects
@@ -290,25 +311,75 @@ namespace lsp
 
     status_t room_builder_base::Renderer::run()
     {
-        // Perform processing
-        lsp_trace("Launching process() method");
+        status_t res    = STATUS_OK;
         pBuilder->enRenderStatus    = STATUS_IN_PROCESS;
-        status_t res    = pRT->process(nThreads, 1.0f);
+
+        if (bReweight)
+        {
+            // Only materials have changed, re-compute samples from cached view paths
+            lsp_trace("Launching reweight() method");
+            res = pRT->reweight();
+        }
+        else
+        {
+            // Render the preview with the high energy threshold first if requested
+            float energy    = pRT->get_energy_threshold();
+            if ((bPreview) && ((energy * 10.0f) < PREVIEW_ENERGY))
+            {
+                bool cache      = pRT->get_path_cache();
+                lsp_trace("Launching process() method for preview");
+                pRT->set_energy_threshold(PREVIEW_ENERGY);
+                pRT->set_path_cache(false);
+                res = pRT->process(nThreads, 1.0f);
+                if (res == STATUS_OK)
+                    res = pBuilder->commit_samples(vSamples);
+
+                // Reset samples for the final pass
+                for (size_t i=0, n=vSamples.size(); (res == STATUS_OK) && (i<n); ++i)
+                {
+                    Sample *s = &vSamples.at(i)->sSample;
+                    if (!s->init(s->channels(), 512))
+                        res = STATUS_NO_MEM;
+                }
+
+                pRT->set_energy_threshold(energy);
+                pRT->set_path_cache(cache);
+
+                // Check that rendering has not been cancelled between passes
+                if ((res == STATUS_OK) && (lkTerminate.lock()))
+                {
+                    if (pRT->cancelled())
+                        res = STATUS_CANCELLED;
+                    lkTerminate.unlock();
+                }
+            }
+
+            // Perform processing
+            lsp_trace("Launching process() method");
+            if (res == STATUS_OK)
+                res = pRT->process(nThreads, 1.0f);
+        }
 
         // Deploy success result
         if (res == STATUS_OK)
             res = pBuilder->commit_samples(vSamples);
 
-        // Free all resources
+        // Pass resources to the cache or free them
         if (lkTerminate.lock())
         {
-            pRT->destroy(true);
-            delete pRT;
+            if ((res == STATUS_OK) && (pRT->has_path_cache()))
+                pBuilder->store_cache(pRT, vSamples, vKey);
+            else
+            {
+                pRT->destroy(true);
+                delete pRT;
+            }
             pRT = NULL;
             lkTerminate.unlock();
         }
 
         room_builder_base::destroy_samples(vSamples);
+        vKey.flush();
 
         return pBuilder->enRenderStatus = res;
     }
@@ -366,6 +437,7 @@ namespace lsp
         nRenderThreads  = 0;
         fRenderQuality  = 0.5f;
         bRenderNormalize= true;
+        bRenderPreview  = false;
         enRenderStatus  = STATUS_OK;
         fRenderProgress = 0.0f;
         fRenderCmd      = 0.0f;
@@ -374,6 +446,7 @@ namespace lsp
         nSceneStatus    = STATUS_UNSPECIFIED;
         fSceneProgress  = 0.0f;
         nSync           = 0;
+        nSceneVersion   = 0;
 
         pBypass         = NULL;
         pRank           = NULL;
@@ -384,6 +457,7 @@ namespace lsp
         pRenderStatus   = NULL;
         pRenderProgress = NULL;
         pRenderNormalize= NULL;
+        pRenderPreview  = NULL;
         pRenderCmd      = NULL;
         pOutGain        = NULL;
         pPredelay       = NULL;
@@ -395,6 +469,7 @@ namespace lsp
         pScaleY         = NULL;
         pScaleZ         = NULL;
         pRenderer       = NULL;
+        pCache          = NULL;
 
         pData           = NULL;
         pExecutor       = NULL;
@@ -664,6 +739,8 @@ namespace lsp
         TRACE_PORT(vPorts[port_id]);
         pRenderNormalize= vPorts[port_id++];
         TRACE_PORT(vPorts[port_id]);
+        pRenderPreview  = vPorts[port_id++];
+        TRACE_PORT(vPorts[port_id]);
         pRenderCmd      = vPorts[port_id++];
 
         TRACE_PORT(vPorts[port_id]);
@@ -876,6 +953,7 @@ namespace lsp
             delete pRenderer;
             pRenderer = NULL;
         }
+        drop_cache();
 
         sScene.destroy();
         s3DLoader.destroy();
@@ -961,6 +1039,7 @@ namespace lsp
         sScale.dz           = pScaleZ->getValue() * 0.01f;
         nRenderThreads      = pRenderThreads->getValue();
         bRenderNormalize    = pRenderNormalize->getValue() >= 0.5f;
+        bRenderPreview      = pRenderPreview->getValue() >= 0.5f;
         fRenderQuality      = pRenderQuality->getValue() * 0.01f;
 
         // Check that render request has been triggered
@@ -1261,6 +1340,8 @@ namespace lsp
 
     void room_builder_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Stage 1: Process reconfiguration requests and file events
         sync_offline_tasks();
 
@@ -1431,6 +1512,7 @@ namespace lsp
                 fSceneProgress  = 100.0f;
 
                 sScene.swap(&s3DLoader.sScene);
+                nSceneVersion   ++;
                 nReconfigReq    ++;
 
                 // Now we surely can commit changes and reset task state
@@ -1656,7 +1738,6 @@ namespace lsp
         // Update object properties
         obj_props_t props;
         char base[0x40];
-        rt_material_t mat;
         matrix3d_t world;
         dsp::init_matrix3d_scale(&world, sScale.dx, sScale.dy, sScale.dz);
 
@@ -1673,6 +1754,22 @@ namespace lsp
             // Update object matrix and visibility
             build_object_matrix(obj->matrix(), &props, &world);
             obj->set_visible(props.bEnabled);
+        }
+
+        return bind_materials(kvt, rt);
+    }
+
+    status_t room_builder_base::bind_materials(KVTStorage *kvt, RayTrace3D *rt)
+    {
+        obj_props_t props;
+        char base[0x40];
+        rt_material_t mat;
+
+        for (size_t i=0, n=sScene.num_objects(); i<n; ++i)
+        {
+            // Read object properties
+            sprintf(base, "/scene/object/%d", int(i));
+            read_object_properties(&props, base, kvt);
 
             // Initialize material
             mat.absorption[0]   = props.fAbsorption[0] * 0.01f; // % -> units
@@ -1686,7 +1783,7 @@ namespace lsp
             mat.permeability    = props.fSndSpeed / SOUND_SPEED_M_S;
 
             // Commit material properties
-            res = rt->set_material(i, &mat);
+            status_t res = rt->set_material(i, &mat);
             if (res != STATUS_OK)
                 return res;
         }
@@ -1694,6 +1791,132 @@ namespace lsp
         return STATUS_OK;
     }
 
+    static bool append_key(cstorage<uint8_t> *key, const void *data, size_t bytes)
+    {
+        if (bytes <= 0)
+            return true;
+        uint8_t *dst = key->append_n(bytes);
+        if (dst == NULL)
+            return false;
+        ::memcpy(dst, data, bytes);
+        return true;
+    }
+
+    status_t room_builder_base::build_render_key(cstorage<uint8_t> *key, KVTStorage *kvt)
+    {
+        // The key contains all settings that affect the geometry of traced views,
+        // absorption and transparency of materials are not the part of the key
+        key->clear();
+
+        long sample_rate = fSampleRate;
+        size_t objects  = sScene.num_objects();
+        if (!append_key(key, &nSceneVersion, sizeof(nSceneVersion)))
+            return STATUS_NO_MEM;
+        if (!append_key(key, &sample_rate, sizeof(sample_rate)))
+            return STATUS_NO_MEM;
+        if (!append_key(key, &fRenderQuality, sizeof(fRenderQuality)))
+            return STATUS_NO_MEM;
+        if (!append_key(key, &sScale, sizeof(sScale)))
+            return STATUS_NO_MEM;
+        if (!append_key(key, &objects, sizeof(objects)))
+            return STATUS_NO_MEM;
+
+        // Objects
+        obj_props_t props;
+        char base[0x40];
+        matrix3d_t world, m;
+        float geom[6];
+        dsp::init_matrix3d_scale(&world, sScale.dx, sScale.dy, sScale.dz);
+
+        for (size_t i=0; i<objects; ++i)
+        {
+            sprintf(base, "/scene/object/%d", int(i));
+            read_object_properties(&props, base, kvt);
+            build_object_matrix(&m, &props, &world);
+
+            geom[0]     = (props.bEnabled) ? 1.0f : 0.0f;
+            geom[1]     = props.fDispersion[0];
+            geom[2]     = props.fDispersion[1];
+            geom[3]     = props.fDiffusion[0];
+            geom[4]     = props.fDiffusion[1];
+            geom[5]     = props.fSndSpeed;
+
+            if (!append_key(key, &m, sizeof(m)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, geom, sizeof(geom)))
+                return STATUS_NO_MEM;
+        }
+
+        // Sources
+        rt_source_settings_t ss;
+        for (size_t i=0; i<room_builder_base_metadata::SOURCES; ++i)
+        {
+            source_t *src = &vSources[i];
+            if (!src->bEnabled)
+                continue;
+
+            ::memset(&ss, 0, sizeof(ss));
+            status_t res = rt_configure_source(&ss, src);
+            if (res != STATUS_OK)
+                return res;
+            if (!append_key(key, &i, sizeof(i)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, &ss, sizeof(ss)))
+                return STATUS_NO_MEM;
+        }
+
+        // Captures
+        rt_capture_settings_t cs[2];
+        for (size_t i=0; i<room_builder_base_metadata::CAPTURES; ++i)
+        {
+            capture_t *cap = &vCaptures[i];
+            if (!cap->bEnabled)
+                continue;
+            else if ((cap->nRMax >= 0) && (cap->nRMax < cap->nRMin))
+                continue;
+
+            size_t n = 0;
+            ::memset(cs, 0, sizeof(cs));
+            status_t res = rt_configure_capture(&n, cs, cap);
+            if (res != STATUS_OK)
+                return res;
+            if (!append_key(key, &i, sizeof(i)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, &cap->nRMin, sizeof(cap->nRMin)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, &cap->nRMax, sizeof(cap->nRMax)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, &cap->sConfig, sizeof(cap->sConfig)))
+                return STATUS_NO_MEM;
+            if (!append_key(key, cs, sizeof(rt_capture_settings_t) * n))
+                return STATUS_NO_MEM;
+        }
+
+        return STATUS_OK;
+    }
+
+    void room_builder_base::store_cache(RayTrace3D *rt, cvector<sample_t> &samples, cstorage<uint8_t> &key)
+    {
+        drop_cache();
+
+        pCache      = rt;
+        vCache.swap_data(&samples);
+        vCacheKey.swap(&key);
+    }
+
+    void room_builder_base::drop_cache()
+    {
+        if (pCache != NULL)
+        {
+            pCache->destroy(true);
+            delete pCache;
+            pCache  = NULL;
+        }
+
+        destroy_samples(vCache);
+        vCacheKey.flush();
+    }
+
     status_t room_builder_base::progress_callback(float progress, void *ptr)
     {
         room_builder_base *_this    = reinterpret_cast<room_builder_base *>(ptr);
@@ -1723,12 +1946,59 @@ namespace lsp
             }
         }
 
+        // Check that only materials have changed since the last rendering
+        cstorage<uint8_t> key;
+        bool reweight   = false;
+        status_t res    = STATUS_OK;
+
+        KVTStorage *kvt = kvt_lock();
+        if (kvt != NULL)
+        {
+            if (build_render_key(&key, kvt) != STATUS_OK)
+                key.flush();
+            else if ((pCache != NULL) && (key.size() == vCacheKey.size()) &&
+                     (::memcmp(key.get_array(), vCacheKey.get_array(), key.size()) == 0))
+            {
+                // Only absorption and transparency of materials differ. Re-weighting is not
+                // possible if some view could become louder than the energy threshold of the
+                // cached rendering, so only edits that attenuate all views avoid tracing
+                res         = bind_materials(kvt, pCache);
+                reweight    = (res == STATUS_OK) && (pCache->can_reweight());
+            }
+            kvt_release();
+        }
+
+        if (reweight)
+        {
+            // Re-compute samples from the cached view paths
+            RayTrace3D *rt  = pCache;
+            rt->set_normalize(bRenderNormalize);
+            pRenderer = new Renderer(this, rt, nRenderThreads, vCache, key, true, false);
+            if (pRenderer == NULL)
+                return STATUS_NO_MEM;
+
+            pCache  = NULL;
+            vCacheKey.flush();
+            if ((res = pRenderer->start()) != STATUS_OK)
+            {
+                delete pRenderer;
+                pRenderer = NULL;
+                rt->destroy(true);
+                delete rt;
+            }
+
+            return res;
+        }
+
+        // Full rendering is required, drop the cache
+        drop_cache();
+
         // Create raytracing object and initialize with basic values
         RayTrace3D *rt = new RayTrace3D();
         if (rt == NULL)
             return STATUS_NO_MEM;
 
-        status_t res = rt->init();
+        res = rt->init();
         if (res != STATUS_OK)
         {
             rt->destroy(false);
@@ -1747,9 +2017,10 @@ namespace lsp
         rt->set_detalization(details);
         rt->set_normalize(bRenderNormalize);
         rt->set_progress_callback(progress_callback, this);
+        rt->set_path_cache(key.size() > 0);
 
         // Bind scene to the raytracing
-        KVTStorage *kvt = kvt_lock();
+        kvt = kvt_lock();
         if (kvt != NULL)
         {
             res = bind_scene(kvt, rt);
@@ -1781,7 +2052,7 @@ namespace lsp
         // Create renderer and start execution
         if (res == STATUS_OK)
         {
-            pRenderer = new Renderer(this, rt, nRenderThreads, samples);
+            pRenderer = new Renderer(this, rt, nRenderThreads, samples, key, false, bRenderPreview);
             if (pRenderer == NULL)
                 res = STATUS_NO_MEM;
             else if ((res = pRenderer->start()) != STATUS_OK)
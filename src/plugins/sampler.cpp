@@ -48,6 +48,24 @@ namespace lsp
         return pCore->load_file(pFile);
     };
 
+    //-------------------------------------------------------------------------
+    sampler_kernel::AFScanner::AFScanner(sampler_kernel *base, afile_t *descr)
+    {
+        pCore       = base;
+        pFile       = descr;
+    }
+
+    sampler_kernel::AFScanner::~AFScanner()
+    {
+        pCore       = NULL;
+        pFile       = NULL;
+    }
+
+    status_t sampler_kernel::AFScanner::run()
+    {
+        return pCore->scan_stream(pFile);
+    };
+
     //-------------------------------------------------------------------------
     sampler_kernel::sampler_kernel()
     {
@@ -131,9 +149,13 @@ namespace lsp
 
             af->nID                     = i;
             af->pLoader                 = NULL;
+            af->pScanner                = NULL;
+            af->bScan                   = false;
+            af->bScanCancel             = false;
 
             af->bDirty                  = false;
             af->bSync                   = false;
+            af->bReload                 = false;
             af->fVelocity               = 1.0f;
             af->fHeadCut                = 0.0f;
             af->fTailCut                = 0.0f;
@@ -181,9 +203,17 @@ namespace lsp
                 afs->pFile                  = NULL;
                 afs->fNorm                  = 1.0f;
                 afs->pSample                = NULL;
+                afs->pStream                = NULL;
+                afs->nLength                = 0;
+                afs->nPeakBlock             = 0;
+                afs->bFull                  = false;
+                afs->pScanStream            = NULL;
 
                 for (size_t k=0; k<TRACKS_MAX; ++k)
+                {
                     afs->vThumbs[k]     = NULL;
+                    afs->vPeaks[k]      = NULL;
+                }
             }
 
             vActive[i]                  = NULL;
@@ -205,13 +235,32 @@ namespace lsp
 
             // Store loader
             af->pLoader         = ldr;
+
+            // Create peak envelope scanner
+            AFScanner *scn      = new AFScanner(this, af);
+            if (scn == NULL)
+            {
+                destroy_state();
+                return false;
+            }
+
+            // Store scanner
+            af->pScanner        = scn;
+        }
+
+        // Initialize disk streamer
+        lsp_trace("Initialize streamer");
+        if (sStreamer.init(SAMPLE_STREAM_VOICES) != STATUS_OK)
+        {
+            destroy_state();
+            return false;
         }
 
         // Initialize channels
         lsp_trace("Initialize channels");
         for (size_t i=0; i<nChannels; ++i)
         {
-            if (!vChannels[i].init(nFiles, sampler_base_metadata::PLAYBACKS_MAX))
+            if (!vChannels[i].init(nFiles, sampler_base_metadata::PLAYBACKS_MAX, &sStreamer))
             {
                 destroy_state();
                 return false;
@@ -336,6 +385,14 @@ namespace lsp
                     vFiles[i].pLoader = NULL;
                 }
 
+                // Delete peak envelope scanners
+                AFScanner *scn  = vFiles[i].pScanner;
+                if (scn != NULL)
+                {
+                    delete scn;
+                    vFiles[i].pScanner = NULL;
+                }
+
                 // Destroy samples
                 for (size_t j=0; j<AFI_TOTAL; ++j)
                     destroy_afsample(vFiles[i].vData[j]);
@@ -346,6 +403,8 @@ namespace lsp
             vFiles = NULL;
         }
 
+        sStreamer.destroy();
+
         free_aligned(pData);
 
         // Foget variables
@@ -383,8 +442,10 @@ namespace lsp
             if ((path == NULL) || (!path->pending()))
                 continue;
 
-            // Check task state
-            if (af->pLoader->idle())
+            // Check task state, the scan of the previous file should be cancelled first
+            if (!af->pScanner->idle())
+                af->bScanCancel     = true;
+            else if (af->pLoader->idle())
             {
                 // Try to submit task
                 if (pExecutor->submit(af->pLoader))
@@ -534,6 +595,91 @@ namespace lsp
             delete af->pSample;
             af->pSample     = NULL;
         }
+
+        if (af->vPeaks[0] != NULL)
+        {
+            delete [] af->vPeaks[0];
+
+            for (size_t i=0; i<TRACKS_MAX; ++i)
+                af->vPeaks[i]       = NULL;
+        }
+
+        if (af->pStream != NULL)
+        {
+            // Wait until the streamer stops reading the file
+            sStreamer.unlink(af->pStream);
+            af->pStream->close();
+            delete af->pStream;
+            af->pStream         = NULL;
+        }
+
+        if (af->pScanStream != NULL)
+        {
+            af->pScanStream->close();
+            delete af->pScanStream;
+            af->pScanStream     = NULL;
+        }
+
+        af->nLength         = 0;
+        af->nPeakBlock      = 0;
+        af->bFull           = false;
+    }
+
+    status_t sampler_kernel::scan_stream(afile_t *file)
+    {
+        afsample_t *af      = file->vData[AFI_CURR];
+        AudioStream *s      = af->pScanStream;
+        if ((s == NULL) || (af->pSample == NULL))
+            return STATUS_BAD_STATE;
+
+        size_t channels     = af->pSample->channels();
+        size_t stride       = s->channels();
+        size_t block        = af->nPeakBlock;
+
+        float *buf          = new float[block * stride];
+        if (buf == NULL)
+            return STATUS_NO_MEM;
+
+        // Compute peak envelope of each channel, the envelope of the preloaded
+        // head has already been computed while loading the file
+        status_t res        = STATUS_OK;
+        size_t first        = af->pFile->samples() / block;
+        for (size_t i=first, offset=first*block; offset < af->nLength; ++i)
+        {
+            if (file->bScanCancel)
+            {
+                res                 = STATUS_CANCELLED;
+                break;
+            }
+
+            size_t to_read      = lsp_min(block, af->nLength - offset);
+            for (size_t n=0; n < to_read; )
+            {
+                ssize_t read        = s->read_frames(&buf[n * stride], offset + n, to_read - n);
+                if (read <= 0)
+                {
+                    res                 = (read < 0) ? -read : STATUS_CORRUPTED;
+                    break;
+                }
+                n                  += read;
+            }
+            if (res != STATUS_OK)
+                break;
+
+            for (size_t j=0; j<channels; ++j)
+            {
+                const float *src    = &buf[j];
+                float peak          = 0.0f;
+                for (size_t k=0; k<to_read; ++k, src += stride)
+                    peak                = lsp_max(peak, fabs(*src));
+                af->vPeaks[j][i]    = peak;
+            }
+
+            offset             += to_read;
+        }
+
+        delete [] buf;
+        return res;
     }
 
     int sampler_kernel::load_file(afile_t *file)
@@ -567,23 +713,41 @@ namespace lsp
         if (strlen(fname) <= 0)
             return STATUS_UNSPECIFIED;
 
-        // Load audio file
-        snew->pFile         = new AudioFile();
-        if (snew->pFile == NULL)
+        // Long files that do not need resampling are streamed from disk.
+        // The stream is read forward only, so reversed files are loaded entirely
+        AudioStream *stream = new AudioStream();
+        if (stream == NULL)
             return STATUS_NO_MEM;
 
-        status_t status = snew->pFile->load(fname, SAMPLE_LENGTH_MAX * 0.001f);
-        if (status != STATUS_OK)
+        status_t status     = stream->open(fname);
+        if ((status == STATUS_OK) &&
+            (stream->sample_rate() == nSampleRate) &&
+            (stream->samples() > millis_to_samples(nSampleRate, SAMPLE_STREAM_THRESHOLD)))
+        {
+            if (file->bReverse)
+                snew->bFull         = true;
+            else
+                snew->pStream       = stream;
+        }
+        if (snew->pStream == NULL)
+        {
+            stream->close();
+            delete stream;
+        }
+
+        // Load audio file, only the head is loaded for streamed files
+        snew->pFile         = new AudioFile();
+        if (snew->pFile == NULL)
         {
-            lsp_trace("load failed: status=%d (%s)", status, get_status(status));
             destroy_afsample(snew);
-            return status;
+            return STATUS_NO_MEM;
         }
 
-        status = snew->pFile->resample(nSampleRate);
+        float duration      = (snew->pStream != NULL) ? SAMPLE_STREAM_HEAD : SAMPLE_LENGTH_MAX;
+        status              = snew->pFile->load_resampled(fname, nSampleRate, duration * 0.001f);
         if (status != STATUS_OK)
         {
-            lsp_trace("resample failed: status=%d (%s)", status, get_status(status));
+            lsp_trace("load failed: status=%d (%s)", status, get_status(status));
             destroy_afsample(snew);
             return status;
         }
@@ -613,12 +777,59 @@ namespace lsp
             return STATUS_NO_MEM;
         }
 
-        // Determine the normalizing factor
         for (size_t i=0; i<channels; ++i)
         {
             snew->vThumbs[i]        = thumbs;
             thumbs                 += MESH_SIZE;
+        }
+
+        // Streamed file: compute the peak envelope of the preloaded head,
+        // the rest of the file is scanned later by the background task
+        if (snew->pStream != NULL)
+        {
+            snew->nLength           = lsp_min(snew->pStream->samples(), size_t(millis_to_samples(nSampleRate, SAMPLE_LENGTH_MAX)));
+            snew->nPeakBlock        = (snew->nLength + SAMPLE_STREAM_PEAKS - 1) / SAMPLE_STREAM_PEAKS;
+
+            float *peaks            = new float[channels * SAMPLE_STREAM_PEAKS];
+            if (peaks == NULL)
+            {
+                destroy_afsample(snew);
+                return STATUS_NO_MEM;
+            }
+
+            for (size_t i=0; i<channels; ++i)
+            {
+                const float *src        = snew->pFile->channel(i);
+                snew->vPeaks[i]         = peaks;
+                peaks                  += SAMPLE_STREAM_PEAKS;
+
+                dsp::fill_zero(snew->vPeaks[i], SAMPLE_STREAM_PEAKS);
+                for (size_t k=0, offset=0; offset < samples; ++k, offset += snew->nPeakBlock)
+                    snew->vPeaks[i][k]      = dsp::abs_max(&src[offset], lsp_min(snew->nPeakBlock, samples - offset));
+            }
+
+            // The scan reads the file concurrently with the disk streamer, so it needs its own stream
+            snew->pScanStream       = new AudioStream();
+            if (snew->pScanStream == NULL)
+            {
+                destroy_afsample(snew);
+                return STATUS_NO_MEM;
+            }
+
+            status                  = snew->pScanStream->open(fname);
+            if (status != STATUS_OK)
+            {
+                lsp_trace("stream open failed: status=%d (%s)", status, get_status(status));
+                destroy_afsample(snew);
+                return status;
+            }
+        }
+        else
+            snew->nLength           = samples;
 
+        // Determine the normalizing factor, for streamed files it is refined after the scan
+        for (size_t i=0; i<channels; ++i)
+        {
             // Determine the maximum amplitude
             float a_max = dsp::abs_max(snew->pFile->channel(i), samples);
             lsp_trace("dsp::abs_max(%p, %d): a_max=%f", snew->pFile->channel(i), int(samples), a_max);
@@ -640,9 +851,17 @@ namespace lsp
         dst->pFile          = src->pFile;
         dst->fNorm          = src->fNorm;
         dst->pSample        = src->pSample;
+        dst->pStream        = src->pStream;
+        dst->nLength        = src->nLength;
+        dst->nPeakBlock     = src->nPeakBlock;
+        dst->bFull          = src->bFull;
+        dst->pScanStream    = src->pScanStream;
 
         for (size_t j=0; j<TRACKS_MAX; ++j)
+        {
             dst->vThumbs[j]     = src->vThumbs[j];
+            dst->vPeaks[j]      = src->vPeaks[j];
+        }
     }
 
     void sampler_kernel::clear_asample(afsample_t *dst)
@@ -650,9 +869,17 @@ namespace lsp
         dst->pFile          = NULL;
         dst->pSample        = NULL;
         dst->fNorm          = 1.0f;
+        dst->pStream        = NULL;
+        dst->nLength        = 0;
+        dst->nPeakBlock     = 0;
+        dst->bFull          = false;
+        dst->pScanStream    = NULL;
 
         for (size_t j=0; j<TRACKS_MAX; ++j)
+        {
             dst->vThumbs[j]     = NULL;
+            dst->vPeaks[j]      = NULL;
+        }
     }
 
     void sampler_kernel::render_sample(afile_t *af)
@@ -667,9 +894,17 @@ namespace lsp
             ssize_t max_samples = tot_samples - head - tail;
             Sample *s           = afs->pSample;
 
-            if (max_samples > 0)
+            // Streamed files have only the head in memory. The rest of the file is read
+            // from disk while playing. Reversed playback of the streamed file is limited
+            // by the head until the file gets reloaded entirely.
+            ssize_t fadeout     = millis_to_samples(nSampleRate, af->fFadeOut);
+            ssize_t mem_samples = lsp_min(max_samples, ssize_t(afs->pFile->samples()) - ((af->bReverse) ? tail : head));
+            bool streaming      = (afs->pStream != NULL) && (!af->bReverse) &&
+                                  (mem_samples > 0) && (mem_samples < max_samples);
+
+            if (mem_samples > 0)
             {
-                lsp_trace("re-render sample max_samples=%d", int(max_samples));
+                lsp_trace("re-render sample max_samples=%d, mem_samples=%d", int(max_samples), int(mem_samples));
 
                 // Re-render sample
                 for (size_t j=0; j<s->channels(); ++j)
@@ -678,25 +913,41 @@ namespace lsp
                     const float *src    = afs->pFile->channel(j);
 
                     if (af->bReverse)
-                        dsp::reverse2(dst, &src[tail], max_samples);
+                        dsp::reverse2(dst, &src[tail], mem_samples);
                     else
-                        dsp::copy(dst, &src[head], max_samples);
+                        dsp::copy(dst, &src[head], mem_samples);
 
                     // Apply fade-in and fade-out to the buffer
-                    fade_in(dst, dst, millis_to_samples(nSampleRate, af->fFadeIn), max_samples);
-                    fade_out(dst, dst, millis_to_samples(nSampleRate, af->fFadeOut), max_samples);
+                    fade_in(dst, dst, millis_to_samples(nSampleRate, af->fFadeIn), mem_samples);
+                    if (streaming)
+                        fade_out(dst, dst, fadeout, 0, mem_samples, max_samples);
+                    else
+                        fade_out(dst, dst, fadeout, mem_samples);
 
                     // Now render thumbnail
                     src                 = dst;
                     dst                 = afs->vThumbs[j];
-                    for (size_t k=0; k<MESH_SIZE; ++k)
+                    if (streaming)
+                    {
+                        const float *peaks  = afs->vPeaks[j];
+                        for (size_t k=0; k<MESH_SIZE; ++k)
+                        {
+                            size_t first    = (head + (k * max_samples) / MESH_SIZE) / afs->nPeakBlock;
+                            size_t last     = (head + ((k + 1) * max_samples) / MESH_SIZE) / afs->nPeakBlock;
+                            dst[k]          = (first < last) ? dsp::abs_max(&peaks[first], last - first) : peaks[first];
+                        }
+                    }
+                    else
                     {
-                        size_t first    = (k * max_samples) / MESH_SIZE;
-                        size_t last     = ((k + 1) * max_samples) / MESH_SIZE;
-                        if (first < last)
-                            dst[k]          = dsp::abs_max(&src[first], last - first);
-                        else
-                            dst[k]          = fabs(src[first]);
+                        for (size_t k=0; k<MESH_SIZE; ++k)
+                        {
+                            size_t first    = (k * mem_samples) / MESH_SIZE;
+                            size_t last     = ((k + 1) * mem_samples) / MESH_SIZE;
+                            if (first < last)
+                                dst[k]          = dsp::abs_max(&src[first], last - first);
+                            else
+                                dst[k]          = fabs(src[first]);
+                        }
                     }
 
                     // Normalize graph if possible
@@ -705,7 +956,8 @@ namespace lsp
                 }
 
                 // Update length of the sample
-                s->setLength(max_samples);
+                s->setLength(mem_samples);
+                s->set_stream((streaming) ? afs->pStream : NULL, head, max_samples, fadeout);
 
                 // (Re)bind sample
                 for (size_t j=0; j<nChannels; ++j)
@@ -918,7 +1170,7 @@ namespace lsp
 
             // Get path and check task state
             path_t *path = af->pFile->getBuffer<path_t>();
-            if ((path != NULL) && (path->accepted()) && (af->pLoader->completed()))
+            if ((path != NULL) && ((path->accepted()) || (af->bReload)) && (af->pLoader->completed()))
             {
                 // Task has been completed
                 lsp_trace("task has been completed");
@@ -931,7 +1183,8 @@ namespace lsp
                 afsample_t *afs = af->vData[AFI_CURR];
                 af->nStatus     = af->pLoader->code();
                 af->bDirty      = true; // Mark sample for re-rendering
-                af->fLength     = (af->nStatus == STATUS_OK) ? samples_to_millis(nSampleRate, afs->pFile->samples()) : 0.0f;
+                af->fLength     = (af->nStatus == STATUS_OK) ? samples_to_millis(nSampleRate, afs->nLength) : 0.0f;
+                af->bScan       = (afs->pScanStream != NULL);
 
                 lsp_trace("Current file: status=%d (%s), length=%f msec\n",
                     int(af->nStatus), get_status(af->nStatus), af->fLength);
@@ -939,11 +1192,55 @@ namespace lsp
                 // Now we surely can commit changes and reset task state
                 path->commit();
                 af->pLoader->reset();
+                af->bReload     = false;
 
                 // Trigger the state for reorder
                 bReorder        = true;
             }
 
+            // Reload the long file if its streaming mode does not match the playback direction
+            afsample_t *curr    = af->vData[AFI_CURR];
+            bool reload         = (af->bReverse) ? (curr->pStream != NULL) : (curr->bFull);
+            if ((reload) && (path != NULL) && (!path->accepted()) && (af->pLoader->idle()))
+            {
+                if (!af->pScanner->idle())
+                    af->bScanCancel = true;
+                else if (pExecutor->submit(af->pLoader))
+                {
+                    af->nStatus     = STATUS_LOADING;
+                    af->bReload     = true;
+                    lsp_trace("successfully submitted reload task");
+                }
+            }
+
+            // Check the state of the peak envelope scan
+            if (af->pScanner->completed())
+            {
+                lsp_trace("scan has been completed: status=%d (%s)",
+                    int(af->pScanner->code()), get_status(af->pScanner->code()));
+
+                // Refine the normalizing factor by the envelope of the whole file
+                if (af->pScanner->successful())
+                {
+                    float max = 0.0f;
+                    for (size_t j=0, n=curr->pSample->channels(); j<n; ++j)
+                        max     = lsp_max(max, dsp::abs_max(curr->vPeaks[j], SAMPLE_STREAM_PEAKS));
+                    curr->fNorm     = (max != 0.0f) ? 1.0f / max : 1.0f;
+                    af->bDirty      = true;
+                }
+
+                af->pScanner->reset();
+            }
+            else if ((af->bScan) && (af->pScanner->idle()) && (af->pLoader->idle()))
+            {
+                af->bScanCancel = false;
+                if (pExecutor->submit(af->pScanner))
+                {
+                    af->bScan       = false;
+                    lsp_trace("successfully submitted scan task");
+                }
+            }
+
             // Check that we need to re-render sample
             if (af->bDirty)
                 render_sample(af);
@@ -1590,6 +1887,8 @@ namespace lsp
 
     void sampler_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Process all MIDI events
         process_trigger_events();
 
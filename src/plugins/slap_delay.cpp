@@ -485,6 +485,8 @@ namespace lsp
 
     void slap_delay_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Prepare inputs and outputs
         for (size_t i=0; i<nInputs; ++i)
             vInputs[i].vIn      = vInputs[i].pIn->getBuffer<float>();
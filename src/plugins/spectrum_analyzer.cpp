@@ -59,6 +59,7 @@ namespace lsp
         pBypass         = NULL;
         pMode           = NULL;
         pTolerance      = NULL;
+        pMultiRes       = NULL;
         pWindow         = NULL;
         pEnvelope       = NULL;
         pPreamp         = NULL;
@@ -191,7 +192,8 @@ namespace lsp
 
         // Initialize analyzer
         sAnalyzer.init(channels, spectrum_analyzer_base_metadata::RANK_MAX,
-                       MAX_SAMPLE_RATE, spectrum_analyzer_base_metadata::REFRESH_RATE);
+                       MAX_SAMPLE_RATE, spectrum_analyzer_base_metadata::REFRESH_RATE,
+                       spectrum_analyzer_base_metadata::LEVELS_MAX);
         sAnalyzer.set_rate(spectrum_analyzer_base_metadata::REFRESH_RATE);
 
         // Initialize counter
@@ -260,6 +262,7 @@ namespace lsp
         pLogScale       = vPorts[port_id++];
         pFreeze         = vPorts[port_id++];
         pTolerance      = vPorts[port_id++];
+        pMultiRes       = vPorts[port_id++];
         pWindow         = vPorts[port_id++];
         pEnvelope       = vPorts[port_id++];
         pPreamp         = vPorts[port_id++];
@@ -444,6 +447,7 @@ namespace lsp
         fZoom                   = pZoom->getValue();
         bLogScale               = (pLogScale != NULL) && (pLogScale->getValue() >= 0.5f);
         size_t rank             = pTolerance->getValue() + spectrum_analyzer_base_metadata::RANK_MIN;
+        bool multires           = pMultiRes->getValue() >= 0.5f;
 
         lsp_trace("rank         = %d",     int(rank));
         lsp_trace("channel      = %d",     int(nChannel));
@@ -502,6 +506,12 @@ namespace lsp
         if (sync_freqs)
             sAnalyzer.set_rank(rank);
 
+        // Multi-resolution analysis keeps the resolution of low frequencies
+        // but performs FFT of RANK_LEVEL size for each octave level
+        size_t levels           = ((multires) && (rank > spectrum_analyzer_base_metadata::RANK_LEVEL)) ?
+                                  rank - spectrum_analyzer_base_metadata::RANK_LEVEL + 1 : 1;
+        sAnalyzer.set_levels(levels);
+
         sAnalyzer.set_reactivity(pReactivity->getValue());
         sAnalyzer.set_window(pWindow->getValue());
         sAnalyzer.set_envelope(pEnvelope->getValue());
@@ -592,10 +602,13 @@ namespace lsp
 
     void spectrum_analyzer_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Always query for drawing
         pWrapper->query_display_draw();
 
         // Now process the channels
+        sProfiler.stage("analysis");
         size_t fft_size     = 1 << sAnalyzer.get_rank();
 
         for (size_t i=0; i<nChannels; ++i)
@@ -687,6 +700,7 @@ namespace lsp
             }
 
             // Synchronize buffer state
+            sProfiler.stage("framebuffers");
             if ((enMode == SA_SPECTRALIZER) || (enMode == SA_SPECTRALIZER_STEREO))
             {
                 // Update frame buffers if counter has fired
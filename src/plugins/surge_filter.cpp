@@ -291,6 +291,8 @@ namespace lsp
 
     void surge_filter_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Bind ports
         for (size_t i=0; i<nChannels; ++i)
         {
@@ -645,6 +645,8 @@ namespace lsp
 
     void trigger_base::process(size_t samples)
     {
+        CpuProfiler::Block prof(sProfiler, samples);
+
         // Bypass MIDI events (additionally to the triggered events)
         if ((pMidiIn != NULL) && (pMidiOut != NULL))
         {
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/ptest.h>
+#include <core/util/Oversampler.h>
+
+#define SRATE           48000
+#define STEP_SIZE       256
+#define MAX_RATIO       32
+#define FIR_TAPS        48          /* Kernel length of FIR modes in original samples */
+
+using namespace dsp;
+using namespace lsp;
+
+//-----------------------------------------------------------------------------
+// Performance test for oversampler: polyphase FIR modes are compared against
+// the direct FIR filtering of zero-stuffed signal with kernel of the same length
+PTEST_BEGIN("core.util", oversampler, 10, 1000)
+
+    void call(const char *label, float *dst, float *up, const float *src, over_mode_t mode)
+    {
+        char buf[80];
+        sprintf(buf, "%s", label);
+        printf("Testing %s oversampling ...\n", buf);
+
+        Oversampler os;
+        os.init();
+        os.set_sample_rate(SRATE);
+        os.set_mode(mode);
+        os.update_settings();
+
+        PTEST_LOOP(buf,
+            os.upsample(up, src, STEP_SIZE);
+            os.downsample(dst, up, STEP_SIZE);
+        );
+
+        os.destroy();
+    }
+
+    void call_direct(const char *label, float *dst, float *up, const float *src, size_t ratio, float *tmp)
+    {
+        char buf[80];
+        sprintf(buf, "%s", label);
+        printf("Testing %s oversampling ...\n", buf);
+
+        size_t len      = FIR_TAPS * ratio + 1;
+        size_t count    = STEP_SIZE * ratio;
+        float *k        = tmp;
+        float *acc      = &k[len];
+
+        // Windowed sinc, the exact shape does not matter for the timing
+        for (size_t i=0; i<len; ++i)
+        {
+            float x         = (ssize_t(i) - ssize_t(len >> 1)) * (M_PI / ratio);
+            k[i]            = (x != 0.0f) ? sinf(x) / x : 1.0f;
+        }
+
+        PTEST_LOOP(buf,
+            // Upsample: stuff zeros and filter at the oversampled rate
+            dsp::fill_zero(up, count);
+            for (size_t i=0; i<STEP_SIZE; ++i)
+                up[i * ratio]   = src[i];
+            dsp::fill_zero(acc, count + len);
+            dsp::convolve(acc, up, k, len, count);
+
+            // Downsample: filter at the oversampled rate and decimate
+            dsp::fill_zero(up, count + len);
+            dsp::convolve(up, acc, k, len, count);
+            for (size_t i=0; i<STEP_SIZE; ++i)
+                dst[i]          = up[i * ratio];
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t max_len  = FIR_TAPS * MAX_RATIO + 1;
+        size_t up_len   = STEP_SIZE * MAX_RATIO + max_len;
+
+        uint8_t *data   = NULL;
+        float *src      = alloc_aligned<float>(data, STEP_SIZE * 2 + up_len + max_len + up_len, 64);
+        float *dst      = &src[STEP_SIZE];
+        float *up       = &dst[STEP_SIZE];
+        float *tmp      = &up[up_len];
+
+        for (size_t i=0; i < STEP_SIZE; ++i)
+            src[i]          = float(rand()) / RAND_MAX;
+
+        call("lanczos 2x3", dst, up, src, OM_LANCZOS_2X3);
+        call("lanczos 4x3", dst, up, src, OM_LANCZOS_4X3);
+        call("lanczos 8x3", dst, up, src, OM_LANCZOS_8X3);
+        PTEST_SEPARATOR;
+
+        call("fir linear 2x", dst, up, src, OM_FIR_LINEAR_2X);
+        call_direct("direct fir 2x", dst, up, src, 2, tmp);
+        PTEST_SEPARATOR;
+
+        call("fir linear 4x", dst, up, src, OM_FIR_LINEAR_4X);
+        call_direct("direct fir 4x", dst, up, src, 4, tmp);
+        PTEST_SEPARATOR;
+
+        call("fir linear 8x", dst, up, src, OM_FIR_LINEAR_8X);
+        call_direct("direct fir 8x", dst, up, src, 8, tmp);
+        PTEST_SEPARATOR;
+
+        call("fir linear 16x", dst, up, src, OM_FIR_LINEAR_16X);
+        call_direct("direct fir 16x", dst, up, src, 16, tmp);
+        PTEST_SEPARATOR;
+
+        call("fir linear 32x", dst, up, src, OM_FIR_LINEAR_32X);
+        call_direct("direct fir 32x", dst, up, src, 32, tmp);
+        PTEST_SEPARATOR;
+
+        call("fir minphase 8x", dst, up, src, OM_FIR_MINPHASE_8X);
+        PTEST_SEPARATOR;
+
+        free_aligned(data);
+    }
+PTEST_END
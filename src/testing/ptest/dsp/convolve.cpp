@@ -43,6 +43,13 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -124,6 +131,7 @@ PTEST_BEGIN("dsp", convolve, 5, 1000)
                 IF_ARCH_X86(CALL((1 << j), (1 << i), sse::convolve));
                 IF_ARCH_X86(CALL((1 << j), (1 << i), avx::convolve));
                 IF_ARCH_X86(CALL((1 << j), (1 << i), avx::convolve_fma3));
+                IF_ARCH_X86_64(CALL((1 << j), (1 << i), avx512::convolve));
                 IF_ARCH_ARM(CALL((1 << j), (1 << i), neon_d32::convolve));
                 IF_ARCH_AARCH64(CALL((1 << j), (1 << i), asimd::convolve));
 
@@ -136,6 +144,7 @@ PTEST_BEGIN("dsp", convolve, 5, 1000)
         IF_ARCH_X86(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, sse::convolve));
         IF_ARCH_X86(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, avx::convolve));
         IF_ARCH_X86(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, avx::convolve_fma3));
+        IF_ARCH_X86_64(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, avx512::convolve));
         IF_ARCH_ARM(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, neon_d32::convolve));
         IF_ARCH_AARCH64(CALL((1 << MAX_RANK) - 1, (1 << MAX_RANK) - 1, asimd::convolve));
 
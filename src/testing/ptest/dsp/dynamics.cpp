@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/ptest.h>
+#include <core/sugar.h>
+
+#define MIN_RANK 8
+#define MAX_RANK 16
+
+namespace native
+{
+    void dyn_gain_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    void dyn_gain_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+}
+
+IF_ARCH_X86_64(
+    namespace avx2
+    {
+        void x64_dyn_gain_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+        void x64_dyn_gain_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    }
+)
+
+typedef void (* dyn_func_t)(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+
+//-----------------------------------------------------------------------------
+// Performance test
+PTEST_BEGIN("dsp", dynamics, 5, 1000)
+
+    void call(const char *label, float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count, dyn_func_t func)
+    {
+        if (!PTEST_SUPPORTED(func))
+            return;
+
+        char buf[80];
+        sprintf(buf, "%s x %d", label, int(count));
+        printf("Testing %s numbers...\n", buf);
+
+        PTEST_LOOP(buf,
+            func(dst, src, k, count);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t buf_size = 1 << MAX_RANK;
+        uint8_t *data   = NULL;
+        float *dst      = alloc_aligned<float>(data, buf_size * 2, 64);
+        float *src      = &dst[buf_size];
+
+        for (size_t i=0; i < buf_size*2; ++i)
+            dst[i]          = float(rand()) / RAND_MAX;
+
+        // Downward compressor with threshold -12 dB, ratio 4:1 and hard knee
+        dsp::dyn_knee_t k[2];
+        k[0].start      = 0.25f;
+        k[0].end        = 0.25f;
+        k[0].lo[0]      = 0.0f;
+        k[0].lo[1]      = 0.0f;
+        k[0].herm[0]    = 0.0f;
+        k[0].herm[1]    = 0.0f;
+        k[0].herm[2]    = 0.0f;
+        k[0].herm[3]    = 0.0f;
+        k[0].hi[0]      = -0.75f;
+        k[0].hi[1]      = 0.75f * logf(0.25f);
+        k[1]            = k[0];
+
+        #define CALL(func) \
+            call(#func, dst, src, k, count, func);
+
+        for (size_t i=MIN_RANK; i <= MAX_RANK; ++i)
+        {
+            size_t count = 1 << i;
+
+            CALL(native::dyn_gain_x1);
+            IF_ARCH_X86_64(CALL(avx2::x64_dyn_gain_x1));
+            PTEST_SEPARATOR;
+
+            CALL(native::dyn_gain_x2);
+            IF_ARCH_X86_64(CALL(avx2::x64_dyn_gain_x2));
+            PTEST_SEPARATOR2;
+        }
+
+        free_aligned(data);
+    }
+PTEST_END
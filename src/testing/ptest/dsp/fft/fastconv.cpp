@@ -68,6 +68,16 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void fastconv_parse(float *dst, const float *src, size_t rank);
+        void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -203,6 +213,13 @@ PTEST_BEGIN("dsp.fft", fastconv, 10, 1000)
                     avx::fastconv_parse_fma3, avx::fastconv_parse_apply_fma3);
             )
 
+            IF_ARCH_X86_64(
+                call("avx512::fft", out, tmp, tmp2, conv, in, cv, rank,
+                    avx512::direct_fft, avx::complex_mul3_fma3, avx512::reverse_fft, avx::add2);
+                call("avx512::fastconv_fft", out, tmp, conv, in, cv, rank,
+                    avx512::fastconv_parse, avx512::fastconv_parse_apply);
+            )
+
             IF_ARCH_ARM(
                 call("neon_d32::fft", out, tmp, tmp2, conv, in, cv, rank,
                     neon_d32::direct_fft, neon_d32::complex_mul3, neon_d32::reverse_fft, neon_d32::add2);
@@ -49,6 +49,14 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void packed_direct_fft(float *dst, const float *src, size_t rank);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -129,6 +137,7 @@ PTEST_BEGIN("dsp.fft", fft, 10, 1000)
             IF_ARCH_X86(CALL1(sse::direct_fft));
             IF_ARCH_X86(CALL1(avx::direct_fft));
             IF_ARCH_X86(CALL1(avx::direct_fft_fma3));
+            IF_ARCH_X86_64(CALL1(avx512::direct_fft));
             IF_ARCH_ARM(CALL1(neon_d32::direct_fft));
             IF_ARCH_AARCH64(CALL1(asimd::direct_fft));
 
@@ -136,6 +145,7 @@ PTEST_BEGIN("dsp.fft", fft, 10, 1000)
             IF_ARCH_X86(CALL2(sse::packed_direct_fft));
             IF_ARCH_X86(CALL2(avx::packed_direct_fft));
             IF_ARCH_X86(CALL2(avx::packed_direct_fft_fma3));
+            IF_ARCH_X86_64(CALL2(avx512::packed_direct_fft));
             IF_ARCH_ARM(CALL2(neon_d32::packed_direct_fft));
             IF_ARCH_AARCH64(CALL2(asimd::packed_direct_fft));
             PTEST_SEPARATOR;
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/ptest.h>
+
+#define FTEST_BUF_SIZE 0x200
+
+namespace native
+{
+    void biquad_process_x1(float *dst, const float *src, size_t count, biquad_t *f);
+    void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f);
+}
+
+IF_ARCH_X86(
+    namespace sse
+    {
+        void biquad_process_x1(float *dst, const float *src, size_t count, biquad_t *f);
+        void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f);
+    }
+
+    namespace avx
+    {
+        void biquad_process_x1(float *dst, const float *src, size_t count, biquad_t *f);
+        void biquad_process_x1_fma3(float *dst, const float *src, size_t count, biquad_t *f);
+    }
+)
+
+typedef void (* biquad_process_t)(float *dst, const float *src, size_t count, biquad_t *f);
+
+static biquad_x1_t bq_normal = {
+    1.0, 2.0, 1.0,
+    -2.0, -1.0,
+    0.0, 0.0, 0.0
+};
+
+//-----------------------------------------------------------------------------
+// Performance test for multichannel static biquad processing
+PTEST_BEGIN("dsp.filters", multichannel, 10, 1000)
+
+    void process_planar(const char *text, float *out, const float *in, size_t channels, biquad_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s on %d channels of %d samples ...\n", text, int(channels), int(FTEST_BUF_SIZE));
+
+        biquad_t f[8] __lsp_aligned64;
+        for (size_t i=0; i<channels; ++i)
+        {
+            f[i].x1 = bq_normal;
+            dsp::fill_zero(f[i].d, BIQUAD_D_ITEMS);
+        }
+
+        PTEST_LOOP(text,
+            for (size_t i=0; i<channels; ++i)
+                process(&out[i * FTEST_BUF_SIZE], &in[i * FTEST_BUF_SIZE], FTEST_BUF_SIZE, &f[i]);
+        );
+    }
+
+    void process_interleaved(const char *text, float *out, const float *in, size_t channels, biquad_process_t process)
+    {
+        if (!PTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s on %d channels of %d samples ...\n", text, int(channels), int(FTEST_BUF_SIZE));
+
+        biquad_t f __lsp_aligned64;
+        float *c = &f.x1.b0;
+        for (size_t i=0; i<channels; ++i)
+        {
+            c[i]                = bq_normal.b0;
+            c[channels + i]     = bq_normal.b1;
+            c[channels*2 + i]   = bq_normal.b2;
+            c[channels*3 + i]   = bq_normal.a1;
+            c[channels*4 + i]   = bq_normal.a2;
+        }
+        dsp::fill_zero(f.d, BIQUAD_D_ITEMS);
+
+        PTEST_LOOP(text,
+            process(out, in, FTEST_BUF_SIZE, &f);
+        );
+    }
+
+    PTEST_MAIN
+    {
+        size_t count        = FTEST_BUF_SIZE * 2;
+        float *out          = new float[count];
+        float *in           = new float[count];
+
+        for (size_t i=0; i<count; ++i)
+        {
+            in[i]               = (i & 1) ? 1.0f : -1.0f;
+            out[i]              = 0.0f;
+        }
+
+        process_planar("native::biquad_process_x1", out, in, 2, native::biquad_process_x1);
+        IF_ARCH_X86(process_planar("sse::biquad_process_x1", out, in, 2, sse::biquad_process_x1));
+        IF_ARCH_X86(process_planar("avx::biquad_process_x1", out, in, 2, avx::biquad_process_x1));
+        IF_ARCH_X86(process_planar("avx::biquad_process_x1_fma3", out, in, 2, avx::biquad_process_x1_fma3));
+        process_interleaved("native::biquad_process_c2", out, in, 2, native::biquad_process_c2);
+        IF_ARCH_X86(process_interleaved("sse::biquad_process_c2", out, in, 2, sse::biquad_process_c2));
+        PTEST_SEPARATOR;
+
+        delete [] out;
+        delete [] in;
+    }
+
+PTEST_END
@@ -75,6 +75,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd3(float *dst, const float *a, const float *b, size_t count);
+        void    fmsub3(float *dst, const float *a, const float *b, size_t count);
+        void    fmrsub3(float *dst, const float *a, const float *b, size_t count);
+        void    fmmul3(float *dst, const float *a, const float *b, size_t count);
+        void    fmdiv3(float *dst, const float *a, const float *b, size_t count);
+        void    fmrdiv3(float *dst, const float *a, const float *b, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -146,6 +158,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmadd3));
             IF_ARCH_X86(CALL(avx::fmadd3));
             IF_ARCH_X86(CALL(avx::fmadd3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmadd3));
             IF_ARCH_ARM(CALL(neon_d32::fmadd3));
             IF_ARCH_AARCH64(CALL(asimd::fmadd3));
             PTEST_SEPARATOR;
@@ -154,6 +167,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmsub3));
             IF_ARCH_X86(CALL(avx::fmsub3));
             IF_ARCH_X86(CALL(avx::fmsub3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmsub3));
             IF_ARCH_ARM(CALL(neon_d32::fmsub3));
             IF_ARCH_AARCH64(CALL(asimd::fmsub3));
             PTEST_SEPARATOR;
@@ -162,6 +176,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmrsub3));
             IF_ARCH_X86(CALL(avx::fmrsub3));
             IF_ARCH_X86(CALL(avx::fmrsub3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmrsub3));
             IF_ARCH_ARM(CALL(neon_d32::fmrsub3));
             IF_ARCH_AARCH64(CALL(asimd::fmrsub3));
             PTEST_SEPARATOR;
@@ -169,6 +184,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             CALL(native::fmmul3);
             IF_ARCH_X86(CALL(sse::fmmul3));
             IF_ARCH_X86(CALL(avx::fmmul3));
+            IF_ARCH_X86_64(CALL(avx512::fmmul3));
             IF_ARCH_ARM(CALL(neon_d32::fmmul3));
             IF_ARCH_AARCH64(CALL(asimd::fmmul3));
             PTEST_SEPARATOR;
@@ -176,6 +192,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             CALL(native::fmdiv3);
             IF_ARCH_X86(CALL(sse::fmdiv3));
             IF_ARCH_X86(CALL(avx::fmdiv3));
+            IF_ARCH_X86_64(CALL(avx512::fmdiv3));
             IF_ARCH_ARM(CALL(neon_d32::fmdiv3));
             IF_ARCH_AARCH64(CALL(asimd::fmdiv3));
             PTEST_SEPARATOR;
@@ -183,6 +200,7 @@ PTEST_BEGIN("dsp.pmath", fmop3, 5, 1000)
             CALL(native::fmrdiv3);
             IF_ARCH_X86(CALL(sse::fmrdiv3));
             IF_ARCH_X86(CALL(avx::fmrdiv3));
+            IF_ARCH_X86_64(CALL(avx512::fmrdiv3));
             IF_ARCH_ARM(CALL(neon_d32::fmrdiv3));
             IF_ARCH_AARCH64(CALL(asimd::fmrdiv3));
             PTEST_SEPARATOR;
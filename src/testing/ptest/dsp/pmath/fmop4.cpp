@@ -75,6 +75,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmsub4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmrsub4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmmul4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmdiv4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmrdiv4(float *dst, const float *a, const float *b, const float *c, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -144,6 +156,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmadd4));
             IF_ARCH_X86(CALL(avx::fmadd4));
             IF_ARCH_X86(CALL(avx::fmadd4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmadd4));
             IF_ARCH_ARM(CALL(neon_d32::fmadd4));
             IF_ARCH_AARCH64(CALL(asimd::fmadd4));
             PTEST_SEPARATOR;
@@ -152,6 +165,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmsub4));
             IF_ARCH_X86(CALL(avx::fmsub4));
             IF_ARCH_X86(CALL(avx::fmsub4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmsub4));
             IF_ARCH_ARM(CALL(neon_d32::fmsub4));
             IF_ARCH_AARCH64(CALL(asimd::fmsub4));
             PTEST_SEPARATOR;
@@ -160,6 +174,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmrsub4));
             IF_ARCH_X86(CALL(avx::fmrsub4));
             IF_ARCH_X86(CALL(avx::fmrsub4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmrsub4));
             IF_ARCH_ARM(CALL(neon_d32::fmrsub4));
             IF_ARCH_AARCH64(CALL(asimd::fmrsub4));
             PTEST_SEPARATOR;
@@ -167,6 +182,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             CALL(native::fmmul4);
             IF_ARCH_X86(CALL(sse::fmmul4));
             IF_ARCH_X86(CALL(avx::fmmul4));
+            IF_ARCH_X86_64(CALL(avx512::fmmul4));
             IF_ARCH_ARM(CALL(neon_d32::fmmul4));
             IF_ARCH_AARCH64(CALL(asimd::fmmul4));
             PTEST_SEPARATOR;
@@ -174,6 +190,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             CALL(native::fmdiv4);
             IF_ARCH_X86(CALL(sse::fmdiv4));
             IF_ARCH_X86(CALL(avx::fmdiv4));
+            IF_ARCH_X86_64(CALL(avx512::fmdiv4));
             IF_ARCH_ARM(CALL(neon_d32::fmdiv4));
             IF_ARCH_AARCH64(CALL(asimd::fmdiv4));
             PTEST_SEPARATOR;
@@ -181,6 +198,7 @@ PTEST_BEGIN("dsp.pmath", fmop4, 5, 1000)
             CALL(native::fmrdiv4);
             IF_ARCH_X86(CALL(sse::fmrdiv4));
             IF_ARCH_X86(CALL(avx::fmrdiv4));
+            IF_ARCH_X86_64(CALL(avx512::fmrdiv4));
             IF_ARCH_ARM(CALL(neon_d32::fmrdiv4));
             IF_ARCH_AARCH64(CALL(asimd::fmrdiv4));
             PTEST_SEPARATOR;
@@ -93,6 +93,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd_k3(float *dst, const float *src, float k, size_t count);
+        void    fmsub_k3(float *dst, const float *src, float k, size_t count);
+        void    fmrsub_k3(float *dst, const float *src, float k, size_t count);
+        void    fmmul_k3(float *dst, const float *src, float k, size_t count);
+        void    fmdiv_k3(float *dst, const float *src, float k, size_t count);
+        void    fmrdiv_k3(float *dst, const float *src, float k, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -163,6 +175,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmadd_k3));
             IF_ARCH_X86(CALL(avx::fmadd_k3));
             IF_ARCH_X86(CALL(avx::fmadd_k3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmadd_k3));
             IF_ARCH_X86(CALL(avx2::fmadd_k3));
             IF_ARCH_X86(CALL(avx2::fmadd_k3_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmadd_k3));
@@ -173,6 +186,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmsub_k3));
             IF_ARCH_X86(CALL(avx::fmsub_k3));
             IF_ARCH_X86(CALL(avx::fmsub_k3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmsub_k3));
             IF_ARCH_X86(CALL(avx2::fmsub_k3));
             IF_ARCH_X86(CALL(avx2::fmsub_k3_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmsub_k3));
@@ -183,6 +197,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmrsub_k3));
             IF_ARCH_X86(CALL(avx::fmrsub_k3));
             IF_ARCH_X86(CALL(avx::fmrsub_k3_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmrsub_k3));
             IF_ARCH_X86(CALL(avx2::fmrsub_k3));
             IF_ARCH_X86(CALL(avx2::fmrsub_k3_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmrsub_k3));
@@ -192,6 +207,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             CALL(native::fmmul_k3);
             IF_ARCH_X86(CALL(sse::fmmul_k3));
             IF_ARCH_X86(CALL(avx::fmmul_k3));
+            IF_ARCH_X86_64(CALL(avx512::fmmul_k3));
             IF_ARCH_X86(CALL(avx2::fmmul_k3));
             IF_ARCH_ARM(CALL(neon_d32::fmmul_k3));
             IF_ARCH_AARCH64(CALL(asimd::fmmul_k3));
@@ -200,6 +216,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             CALL(native::fmdiv_k3);
             IF_ARCH_X86(CALL(sse::fmdiv_k3));
             IF_ARCH_X86(CALL(avx::fmdiv_k3));
+            IF_ARCH_X86_64(CALL(avx512::fmdiv_k3));
             IF_ARCH_X86(CALL(avx2::fmdiv_k3));
             IF_ARCH_ARM(CALL(neon_d32::fmdiv_k3));
             IF_ARCH_AARCH64(CALL(asimd::fmdiv_k3));
@@ -208,6 +225,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k3, 5, 1000)
             CALL(native::fmrdiv_k3);
             IF_ARCH_X86(CALL(sse::fmrdiv_k3));
             IF_ARCH_X86(CALL(avx::fmrdiv_k3));
+            IF_ARCH_X86_64(CALL(avx512::fmrdiv_k3));
             IF_ARCH_X86(CALL(avx2::fmrdiv_k3));
             IF_ARCH_ARM(CALL(neon_d32::fmrdiv_k3));
             IF_ARCH_AARCH64(CALL(asimd::fmrdiv_k3));
@@ -94,6 +94,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmrsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmmul_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmrdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -165,6 +177,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmadd_k4));
             IF_ARCH_X86(CALL(avx::fmadd_k4));
             IF_ARCH_X86(CALL(avx::fmadd_k4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmadd_k4));
             IF_ARCH_X86(CALL(avx2::fmadd_k4));
             IF_ARCH_X86(CALL(avx2::fmadd_k4_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmadd_k4));
@@ -175,6 +188,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmsub_k4));
             IF_ARCH_X86(CALL(avx::fmsub_k4));
             IF_ARCH_X86(CALL(avx::fmsub_k4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmsub_k4));
             IF_ARCH_X86(CALL(avx2::fmsub_k4));
             IF_ARCH_X86(CALL(avx2::fmsub_k4_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmsub_k4));
@@ -185,6 +199,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             IF_ARCH_X86(CALL(sse::fmrsub_k4));
             IF_ARCH_X86(CALL(avx::fmrsub_k4));
             IF_ARCH_X86(CALL(avx::fmrsub_k4_fma3));
+            IF_ARCH_X86_64(CALL(avx512::fmrsub_k4));
             IF_ARCH_X86(CALL(avx2::fmrsub_k4));
             IF_ARCH_X86(CALL(avx2::fmrsub_k4_fma3));
             IF_ARCH_ARM(CALL(neon_d32::fmrsub_k4));
@@ -194,6 +209,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             CALL(native::fmmul_k4);
             IF_ARCH_X86(CALL(sse::fmmul_k4));
             IF_ARCH_X86(CALL(avx::fmmul_k4));
+            IF_ARCH_X86_64(CALL(avx512::fmmul_k4));
             IF_ARCH_X86(CALL(avx2::fmmul_k4));
             IF_ARCH_ARM(CALL(neon_d32::fmmul_k4));
             IF_ARCH_AARCH64(CALL(asimd::fmmul_k4));
@@ -202,6 +218,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             CALL(native::fmdiv_k4);
             IF_ARCH_X86(CALL(sse::fmdiv_k4));
             IF_ARCH_X86(CALL(avx::fmdiv_k4));
+            IF_ARCH_X86_64(CALL(avx512::fmdiv_k4));
             IF_ARCH_X86(CALL(avx2::fmdiv_k4));
             IF_ARCH_ARM(CALL(neon_d32::fmdiv_k4));
             IF_ARCH_AARCH64(CALL(asimd::fmdiv_k4));
@@ -210,6 +227,7 @@ PTEST_BEGIN("dsp.pmath", fmop_k4, 5, 1000)
             CALL(native::fmrdiv_k4);
             IF_ARCH_X86(CALL(sse::fmrdiv_k4));
             IF_ARCH_X86(CALL(avx::fmrdiv_k4));
+            IF_ARCH_X86_64(CALL(avx512::fmrdiv_k4));
             IF_ARCH_X86(CALL(avx2::fmrdiv_k4));
             IF_ARCH_ARM(CALL(neon_d32::fmrdiv_k4));
             IF_ARCH_AARCH64(CALL(asimd::fmrdiv_k4));
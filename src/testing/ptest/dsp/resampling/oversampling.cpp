@@ -83,6 +83,27 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void lanczos_resample_2x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_2x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_2x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x4(float *dst, const float *src, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -160,6 +181,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_2x2, 2);
         IF_ARCH_X86(CALL(sse::lanczos_resample_2x2, 2));
         IF_ARCH_X86(CALL(avx::lanczos_resample_2x2, 2));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_2x2, 2));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_2x2, 2));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_2x2, 2));
         PTEST_SEPARATOR;
@@ -167,6 +189,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_2x3, 2);
         IF_ARCH_X86(CALL(sse::lanczos_resample_2x3, 2));
         IF_ARCH_X86(CALL(avx::lanczos_resample_2x3, 2));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_2x3, 2));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_2x3, 2));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_2x3, 2));
         PTEST_SEPARATOR;
@@ -174,6 +197,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_2x4, 2);
         IF_ARCH_X86(CALL(sse::lanczos_resample_2x4, 2));
         IF_ARCH_X86(CALL(avx::lanczos_resample_2x4, 2));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_2x4, 2));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_2x4, 2));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_2x4, 2));
         PTEST_SEPARATOR;
@@ -181,6 +205,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_3x2, 3);
         IF_ARCH_X86(CALL(sse::lanczos_resample_3x2, 3));
         IF_ARCH_X86(CALL(avx::lanczos_resample_3x2, 3));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_3x2, 3));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_3x2, 3));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_3x2, 3));
         PTEST_SEPARATOR;
@@ -188,6 +213,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_3x3, 3);
         IF_ARCH_X86(CALL(sse::lanczos_resample_3x3, 3));
         IF_ARCH_X86(CALL(avx::lanczos_resample_3x3, 3));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_3x3, 3));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_3x3, 3));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_3x3, 3));
         PTEST_SEPARATOR;
@@ -195,6 +221,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_3x4, 3);
         IF_ARCH_X86(CALL(sse::lanczos_resample_3x4, 3));
         IF_ARCH_X86(CALL(avx::lanczos_resample_3x4, 3));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_3x4, 3));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_3x4, 3));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_3x4, 3));
         PTEST_SEPARATOR;
@@ -202,6 +229,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_4x2, 4);
         IF_ARCH_X86(CALL(sse::lanczos_resample_4x2, 4));
         IF_ARCH_X86(CALL(avx::lanczos_resample_4x2, 4));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_4x2, 4));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_4x2, 4));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_4x2, 4));
         PTEST_SEPARATOR;
@@ -209,6 +237,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_4x3, 4);
         IF_ARCH_X86(CALL(sse::lanczos_resample_4x3, 4));
         IF_ARCH_X86(CALL(avx::lanczos_resample_4x3, 4));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_4x3, 4));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_4x3, 4));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_4x3, 4));
         PTEST_SEPARATOR;
@@ -216,6 +245,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_4x4, 4);
         IF_ARCH_X86(CALL(sse::lanczos_resample_4x4, 4));
         IF_ARCH_X86(CALL(avx::lanczos_resample_4x4, 4));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_4x4, 4));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_4x4, 4));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_4x4, 4));
         PTEST_SEPARATOR;
@@ -223,6 +253,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_6x2, 6);
         IF_ARCH_X86(CALL(sse::lanczos_resample_6x2, 6));
         IF_ARCH_X86(CALL(avx::lanczos_resample_6x2, 6));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_6x2, 6));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_6x2, 6));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_6x2, 6));
         PTEST_SEPARATOR;
@@ -230,6 +261,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_6x3, 6);
         IF_ARCH_X86(CALL(sse::lanczos_resample_6x3, 6));
         IF_ARCH_X86(CALL(avx::lanczos_resample_6x3, 6));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_6x3, 6));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_6x3, 6));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_6x3, 6));
         PTEST_SEPARATOR;
@@ -237,6 +269,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_6x4, 6);
         IF_ARCH_X86(CALL(sse::lanczos_resample_6x4, 6));
         IF_ARCH_X86(CALL(avx::lanczos_resample_6x4, 6));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_6x4, 6));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_6x4, 6));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_6x4, 6));
         PTEST_SEPARATOR;
@@ -244,6 +277,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_8x2, 8);
         IF_ARCH_X86(CALL(sse::lanczos_resample_8x2, 8));
         IF_ARCH_X86(CALL(avx::lanczos_resample_8x2, 8));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_8x2, 8));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_8x2, 8));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_8x2, 8));
         PTEST_SEPARATOR;
@@ -251,6 +285,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_8x3, 8);
         IF_ARCH_X86(CALL(sse::lanczos_resample_8x3, 8));
         IF_ARCH_X86(CALL(avx::lanczos_resample_8x3, 8));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_8x3, 8));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_8x3, 8));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_8x3, 8));
         PTEST_SEPARATOR;
@@ -258,6 +293,7 @@ PTEST_BEGIN("dsp.resampling", oversampling, 5, 1000)
         CALL(native::lanczos_resample_8x4, 8);
         IF_ARCH_X86(CALL(sse::lanczos_resample_8x4, 8));
         IF_ARCH_X86(CALL(avx::lanczos_resample_8x4, 8));
+        IF_ARCH_X86_64(CALL(avx512::lanczos_resample_8x4, 8));
         IF_ARCH_ARM(CALL(neon_d32::lanczos_resample_8x4, 8));
         IF_ARCH_AARCH64(CALL(asimd::lanczos_resample_8x4, 8));
         PTEST_SEPARATOR;
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <core/3d/RayTrace3D.h>
+#include <core/files/Model3DFile.h>
+#include <core/sampling/Sample.h>
+
+#define SRATE           48000
+#define ENERGY_THRESH   1e-2f
+#define ROOM_SCENE      "res/test/3d/empty-room-4x4x3.obj"
+#define BVH_SCENE       "res/test/3d/auditorium-opened-10x6x4.obj"
+
+using namespace lsp;
+
+UTEST_BEGIN("core.3d", raytrace)
+
+    UTEST_TIMELIMIT(120)
+
+    void init_material(rt_material_t *m, float absorption, float transparency)
+    {
+        m->absorption[0]    = absorption;
+        m->absorption[1]    = absorption;
+        m->diffusion[0]     = 1.0f;
+        m->diffusion[1]     = 1.0f;
+        m->dispersion[0]    = 1.0f;
+        m->dispersion[1]    = 1.0f;
+        m->transparency[0]  = transparency;
+        m->transparency[1]  = transparency;
+        m->permeability     = 1.0f;
+    }
+
+    void set_materials(RayTrace3D *rt, const rt_material_t *m)
+    {
+        for (size_t i=0; rt->object(i) != NULL; ++i)
+            UTEST_ASSERT(rt->set_material(i, m) == STATUS_OK);
+    }
+
+    void init_trace(RayTrace3D *rt, Scene3D *scene, Sample *dst, const char *path)
+    {
+        UTEST_ASSERT(Model3DFile::load(scene, path, true) == STATUS_OK);
+        UTEST_ASSERT(dst->init(1, 512, 0));
+
+        UTEST_ASSERT(rt->init() == STATUS_OK);
+        rt->set_sample_rate(SRATE);
+        rt->set_energy_threshold(ENERGY_THRESH);
+        rt->set_tolerance(1e-5f);
+        rt->set_detalization(1e-9f);
+        rt->set_normalize(false);
+        UTEST_ASSERT(rt->set_scene(scene, false) == STATUS_OK);
+
+        // Add source
+        rt_source_settings_t src;
+        dsp::init_matrix3d_identity(&src.pos);
+        src.type        = RT_AS_ICOSPHERE;
+        src.size        = 0.3048f;
+        src.height      = 0.3048f;
+        src.angle       = 0.0f;
+        src.curvature   = 0.0f;
+        src.amplitude   = 1.0f;
+        UTEST_ASSERT(rt->add_source(&src) == STATUS_OK);
+
+        // Add capture
+        ray3d_t cap;
+        rt_capture_settings_t cs;
+        dsp::init_point_xyz(&cap.z, 1.0f, 0.0f, 0.0f);
+        dsp::init_vector_dxyz(&cap.v, -1.0f, 0.0f, 0.0f);
+        dsp::calc_matrix3d_transform_r1(&cs.pos, &cap);
+        cs.radius       = 0.0254f * 2;
+        cs.type         = RT_AC_OMNI;
+        UTEST_ASSERT(rt->add_capture(&cs) == 0);
+        UTEST_ASSERT(rt->bind_capture(0, dst, 0, -1, -1) == STATUS_OK);
+    }
+
+    void render(Sample *dst, const rt_material_t *m, const char *path, bool bvh, size_t threads)
+    {
+        Scene3D scene;
+        RayTrace3D rt;
+
+        init_trace(&rt, &scene, dst, path);
+        rt.set_bvh(bvh);
+        set_materials(&rt, m);
+        UTEST_ASSERT(rt.process(threads, 1.0f) == STATUS_OK);
+
+        rt.destroy(false);
+        scene.destroy();
+    }
+
+    void compare(const char *label, Sample *a, Sample *b, float tol)
+    {
+        size_t len      = lsp_max(a->length(), b->length());
+        const float *va = a->getBuffer(0);
+        const float *vb = b->getBuffer(0);
+        float peak      = 0.0f, diff = 0.0f;
+
+        for (size_t i=0; i<len; ++i)
+        {
+            float xa        = (i < a->length()) ? va[i] : 0.0f;
+            float xb        = (i < b->length()) ? vb[i] : 0.0f;
+            peak            = lsp_max(peak, fabs(xb));
+            diff            = lsp_max(diff, fabs(xa - xb));
+        }
+
+        printf("  %s: length = %d/%d, peak = %f, maximum difference = %f\n",
+                label, int(a->length()), int(b->length()), peak, diff);
+        UTEST_ASSERT_MSG(peak > 0.0f, "%s: empty output", label);
+        UTEST_ASSERT_MSG(diff <= peak * tol, "%s: maximum difference %f exceeds %f", label, diff, peak * tol);
+    }
+
+    void test_reweight()
+    {
+        rt_material_t m1, m2, m3;
+        init_material(&m1, 0.4f, 0.0f);
+        init_material(&m2, 0.6f, 0.0f);
+        init_material(&m3, 0.2f, 0.0f);
+
+        printf("Testing re-weighting of captured views against full rendering\n");
+
+        // Render with path cache
+        Scene3D scene;
+        RayTrace3D rt;
+        Sample cached, full;
+
+        init_trace(&rt, &scene, &cached, ROOM_SCENE);
+        rt.set_path_cache(true);
+        set_materials(&rt, &m1);
+        UTEST_ASSERT(rt.process(1, 1.0f) == STATUS_OK);
+        UTEST_ASSERT(rt.has_path_cache());
+
+        // Re-weighting with same materials should give the same result
+        size_t len  = cached.length();
+        UTEST_ASSERT(full.init(1, len, len));
+        dsp::copy(full.getBuffer(0), cached.getBuffer(0), len);
+        UTEST_ASSERT(rt.can_reweight());
+        UTEST_ASSERT(rt.reweight() == STATUS_OK);
+        compare("same materials", &cached, &full, 1e-4f);
+
+        // Re-weighting to louder materials is not allowed
+        set_materials(&rt, &m3);
+        UTEST_ASSERT(!rt.can_reweight());
+        UTEST_ASSERT(rt.reweight() == STATUS_BAD_STATE);
+
+        // Re-weighting to more absorbing materials should match full rendering
+        // except views that fall below the energy threshold
+        full.destroy();
+        render(&full, &m2, ROOM_SCENE, true, 1);
+        set_materials(&rt, &m2);
+        UTEST_ASSERT(rt.can_reweight());
+        UTEST_ASSERT(rt.reweight() == STATUS_OK);
+        compare("more absorbing materials", &cached, &full, 2e-2f);
+
+        rt.destroy(false);
+        scene.destroy();
+    }
+
+    void test_bvh()
+    {
+        rt_material_t m;
+        init_material(&m, 0.4f, 0.0f);
+
+        printf("Testing bounding volume hierarchy against scanning of whole objects\n");
+
+        Sample bvh, whole;
+        render(&bvh, &m, BVH_SCENE, true, 1);
+        render(&whole, &m, BVH_SCENE, false, 1);
+        compare("bounding volume hierarchy", &bvh, &whole, 1e-4f);
+    }
+
+    void test_threads()
+    {
+        rt_material_t m;
+        init_material(&m, 0.4f, 0.0f);
+
+        Sample single;
+        render(&single, &m, ROOM_SCENE, true, 1);
+
+        for (size_t threads=2; threads <= 4; threads += 2)
+        {
+            printf("Testing merged captures of %d threads against single thread\n", int(threads));
+
+            Sample multi;
+            render(&multi, &m, ROOM_SCENE, true, threads);
+            compare("multiple threads", &multi, &single, 1e-4f);
+        }
+    }
+
+    UTEST_MAIN
+    {
+        test_reweight();
+        test_bvh();
+        test_threads();
+    }
+
+UTEST_END
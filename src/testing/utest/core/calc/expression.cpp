@@ -132,6 +132,69 @@ UTEST_BEGIN("core.calc", expression)
         UTEST_ASSERT(!e.has_dependency("zc"));
     }
 
+    ssize_t find_slot(Expression &e, const char *name)
+    {
+        for (size_t i=0, n=e.slots(); i<n; ++i)
+        {
+            const LSPString *s = e.slot_name(i);
+            if ((s != NULL) && (s->equals_ascii(name)))
+                return i;
+        }
+        return -1;
+    }
+
+    void test_slot_value(Expression &e, double value)
+    {
+        value_t res;
+        init_value(&res);
+        UTEST_ASSERT(e.evaluate(&res) == STATUS_OK);
+        UTEST_ASSERT(cast_float(&res) == STATUS_OK);
+        UTEST_ASSERT(res.type == VT_FLOAT);
+        UTEST_ASSERT_MSG(float_equals_relative(res.v_float, value, 0.001),
+                "result (%f) != expected (%f)", double(res.v_float), value);
+        destroy_value(&res);
+    }
+
+    void test_slots(Resolver *r)
+    {
+        Expression e(r);
+
+        static const char *expr = ":fa + :fb * :v[0][:ia] + :fa";
+
+        printf("Testing slots for expression\n");
+        UTEST_ASSERT_MSG(e.parse(expr, NULL, Expression::FLAG_NONE) == STATUS_OK, "Error parsing expression: %s", expr);
+
+        // Variables with indexes are not bound to slots
+        UTEST_ASSERT(e.slots() == 3);
+        ssize_t fa = find_slot(e, "fa");
+        ssize_t ia = find_slot(e, "ia");
+        UTEST_ASSERT((fa >= 0) && (ia >= 0));
+        UTEST_ASSERT(find_slot(e, "fb") >= 0);
+        UTEST_ASSERT(find_slot(e, "v") < 0);
+        UTEST_ASSERT(e.slot_name(3) == NULL);
+
+        // Unbound slots are resolved
+        test_slot_value(e, 1.0 + 0.3 * 1.234 + 1.0);
+
+        // Bound slots override resolver
+        UTEST_ASSERT(e.bind_float(fa, 2.0) == STATUS_OK);
+        test_slot_value(e, 2.0 + 0.3 * 1.234 + 2.0);
+
+        value_t v;
+        init_value(&v);
+        set_value_int(&v, 0);
+        UTEST_ASSERT(e.bind(ia, &v) == STATUS_OK);
+        test_slot_value(e, 2.0 + 0.3 * 1234 + 2.0);
+        UTEST_ASSERT(e.bind(3, &v) == STATUS_BAD_ARGUMENTS);
+        destroy_value(&v);
+
+        UTEST_ASSERT(e.unbind(fa) == STATUS_OK);
+        test_slot_value(e, 1.0 + 0.3 * 1234 + 1.0);
+
+        e.unbind_all();
+        test_slot_value(e, 1.0 + 0.3 * 1.234 + 1.0);
+    }
+
     void init_vars(Variables &v)
     {
         UTEST_ASSERT(v.set_int("ia", 1) == STATUS_OK);
@@ -247,6 +310,7 @@ UTEST_BEGIN("core.calc", expression)
         test_substitution("${ia}+${:ie}-${:ic}=${:ia+:ie-:ic}", &v, "1+10-5=6");
 
         test_dependencies(&v);
+        test_slots(&v);
     }
 
 UTEST_END;
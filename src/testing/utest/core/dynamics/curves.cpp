@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <test/FloatBuffer.h>
+#include <core/dynamics/Compressor.h>
+#include <core/dynamics/Expander.h>
+#include <core/dynamics/Gate.h>
+#include <core/dynamics/DynamicProcessor.h>
+
+#define SRATE       48000
+#define BUF_SIZE    1029
+
+using namespace lsp;
+
+UTEST_BEGIN("core.dynamics", curves)
+
+    void fill_levels(FloatBuffer &in)
+    {
+        // Logarithmic sweep from -80 dB to +12 dB with alternating sign
+        float k     = logf(4.0f * 10000.0f) / (BUF_SIZE - 1);
+        for (size_t i=0; i<BUF_SIZE; ++i)
+        {
+            float x     = 1e-4f * expf(k * i);
+            in[i]       = (i & 1) ? -x : x;
+        }
+    }
+
+    void check_curve(const char *label, FloatBuffer &in, FloatBuffer &out, const float *ref)
+    {
+        for (size_t i=0; i<BUF_SIZE; ++i)
+        {
+            if (!float_equals_relative(out[i], ref[i], 1e-3f))
+            {
+                out.dump("out");
+                UTEST_FAIL_MSG("%s: vector=%.6f, scalar=%.6f at index %d, input=%.6f",
+                        label, out[i], ref[i], int(i), in[i]);
+            }
+        }
+    }
+
+    void test_compressor(size_t mode)
+    {
+        FloatBuffer in(BUF_SIZE), out(BUF_SIZE);
+        float ref[BUF_SIZE];
+        fill_levels(in);
+
+        Compressor c;
+        c.set_sample_rate(SRATE);
+        c.set_mode(mode);
+        c.set_threshold(0.25f, 1.0f);
+        c.set_boost_threshold(0.01f);
+        c.set_knee(0.5f);
+        c.set_ratio(4.0f);
+        c.update_settings();
+
+        printf("Testing compressor mode=%d\n", int(mode));
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = c.curve(in[i]);
+        c.curve(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("compressor curve", in, out, ref);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = c.reduction(in[i]);
+        c.reduction(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("compressor reduction", in, out, ref);
+    }
+
+    void test_expander(size_t mode)
+    {
+        FloatBuffer in(BUF_SIZE), out(BUF_SIZE);
+        float ref[BUF_SIZE];
+        fill_levels(in);
+
+        Expander e;
+        e.set_sample_rate(SRATE);
+        e.set_mode(mode);
+        e.set_threshold(0.1f, 1.0f);
+        e.set_knee(0.5f);
+        e.set_ratio(2.0f);
+        e.update_settings();
+
+        printf("Testing expander mode=%d\n", int(mode));
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = e.curve(in[i]);
+        e.curve(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("expander curve", in, out, ref);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = e.amplification(in[i]);
+        e.amplification(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("expander amplification", in, out, ref);
+    }
+
+    void test_gate(bool hyst)
+    {
+        FloatBuffer in(BUF_SIZE), out(BUF_SIZE);
+        float ref[BUF_SIZE];
+        fill_levels(in);
+
+        Gate g;
+        g.set_sample_rate(SRATE);
+        g.set_threshold(0.1f, 0.05f);
+        g.set_zone(0.25f, 0.5f);
+        g.set_reduction(0.01f);
+        g.update_settings();
+
+        printf("Testing gate hysteresis=%s\n", (hyst) ? "true" : "false");
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = g.curve(in[i], hyst);
+        g.curve(out, in, BUF_SIZE, hyst);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("gate curve", in, out, ref);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = g.amplification(in[i], hyst);
+        g.amplification(out, in, BUF_SIZE, hyst);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("gate amplification", in, out, ref);
+    }
+
+    void test_processor(size_t dots)
+    {
+        FloatBuffer in(BUF_SIZE), out(BUF_SIZE);
+        float ref[BUF_SIZE];
+        fill_levels(in);
+
+        DynamicProcessor dp;
+        dp.set_sample_rate(SRATE);
+        dp.set_in_ratio(1.5f);
+        dp.set_out_ratio(4.0f);
+        for (size_t i=0; i<DYNAMIC_PROCESSOR_DOTS; ++i)
+        {
+            if (i < dots)
+                dp.set_dot(i, 0.01f * (i*4 + 1), 0.02f * (i*2 + 1), 0.5f);
+            else
+                dp.set_dot(i, NULL);
+        }
+        dp.update_settings();
+
+        printf("Testing dynamic processor dots=%d\n", int(dots));
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = dp.curve(in[i]);
+        dp.curve(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("dynamic processor curve", in, out, ref);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            ref[i]      = dp.reduction(in[i]);
+        dp.reduction(out, in, BUF_SIZE);
+        UTEST_ASSERT_MSG(out.valid(), "Output buffer corrupted");
+        check_curve("dynamic processor reduction", in, out, ref);
+    }
+
+    UTEST_MAIN
+    {
+        test_compressor(CM_DOWNWARD);
+        test_compressor(CM_UPWARD);
+        test_compressor(CM_BOOSTING);
+
+        test_expander(EM_DOWNWARD);
+        test_expander(EM_UPWARD);
+
+        test_gate(false);
+        test_gate(true);
+
+        for (size_t i=0; i<=DYNAMIC_PROCESSOR_DOTS; ++i)
+            test_processor(i);
+    }
+
+UTEST_END
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <core/alloc.h>
+#include <core/LSPString.h>
+#include <core/io/File.h>
+#include <core/files/AudioFile.h>
+#include <core/files/LSPCFile.h>
+#include <core/files/lspc/LSPCAudioWriter.h>
+
+#ifndef PLATFORM_WINDOWS
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+#define SRC_RATE            48000
+#define SRC_SAMPLES         200000
+#define CHANNELS            2
+#define KERNEL_PERIODS      8
+
+using namespace lsp;
+
+namespace
+{
+    class TestAudioFile: public AudioFile
+    {
+        public:
+            static status_t cache_path(io::Path *dst, const LSPString *path, size_t sample_rate, float max_duration)
+            {
+                return resample_cache_path(dst, path, sample_rate, max_duration);
+            }
+    };
+}
+
+UTEST_BEGIN("core.files", resample)
+
+    static size_t gcd(size_t a, size_t b)
+    {
+        while (b)
+        {
+            size_t c = a % b;
+            a = b;
+            b = c;
+        }
+        return a;
+    }
+
+    // Straightforward single-threaded Lanczos resampling
+    void resample_reference(FloatBuffer &dst, const float *src, size_t samples, size_t src_rate, size_t dst_rate)
+    {
+        ssize_t g           = gcd(src_rate, dst_rate);
+        ssize_t src_step    = src_rate / g;
+        ssize_t dst_step    = dst_rate / g;
+        float kf            = float(dst_step) / float(src_step);
+        float rkf           = float(src_step) / float(dst_step);
+
+        ssize_t k_periods, k_center, k_size;
+        if (dst_rate > src_rate)
+        {
+            k_periods           = KERNEL_PERIODS;
+            k_center            = ssize_t(k_periods * kf) + 1;
+            k_size              = ALIGN_SIZE((k_center << 1) + 2, 4);
+        }
+        else
+        {
+            k_periods           = KERNEL_PERIODS * rkf;
+            k_center            = KERNEL_PERIODS + 1;
+            k_size              = ALIGN_SIZE(ssize_t((k_center << 1) + rkf + 1) + 1, 4);
+        }
+
+        FloatBuffer k(k_size);
+        FloatBuffer b(ALIGN_SIZE(dst.size() + k_size, 4));
+        b.fill_zero();
+
+        for (ssize_t i=0; i<src_step; ++i)
+        {
+            ssize_t p       = kf * i;
+            float dt        = i*kf - p;
+
+            for (size_t j=0; j<size_t(k_size); ++j)
+            {
+                float t         = (ssize_t(j) - k_center - dt) * rkf;
+                if ((t > -k_periods) && (t < k_periods))
+                {
+                    float t2        = M_PI * t;
+                    k[j]            = (t != 0.0f) ? k_periods * sinf(t2) * sinf(t2 / k_periods) / (t2 * t2) : 1.0f;
+                }
+                else
+                    k[j]            = 0.0f;
+            }
+
+            for (size_t j=i; j<samples; j += src_step, p += dst_step)
+                dsp::fmadd_k3(b.data(p), k, src[j], k_size);
+        }
+
+        dsp::copy(dst, b.data(k_center), dst.size());
+    }
+
+    void create_source(AudioFile &af, size_t samples)
+    {
+        UTEST_ASSERT(af.create_samples(CHANNELS, SRC_RATE, samples) == STATUS_OK);
+        for (size_t c=0; c<CHANNELS; ++c)
+        {
+            float *v = af.channel(c);
+            for (size_t i=0; i<samples; ++i)
+                v[i]        = (float(rand()) / RAND_MAX) * 2.0f - 1.0f;
+        }
+    }
+
+    void test_resample(size_t samples, size_t dst_rate)
+    {
+        printf("Testing resampling of %d samples %d -> %d...\n", int(samples), int(SRC_RATE), int(dst_rate));
+
+        AudioFile af;
+        create_source(af, samples);
+
+        // Compute reference data
+        size_t src_samples  = af.samples();
+        size_t new_samples  = (float(dst_rate) / float(SRC_RATE)) * src_samples;
+        FloatBuffer *ref[CHANNELS];
+        for (size_t c=0; c<CHANNELS; ++c)
+        {
+            ref[c]      = new FloatBuffer(new_samples);
+            resample_reference(*ref[c], af.channel(c), src_samples, SRC_RATE, dst_rate);
+        }
+
+        // Resample and compare
+        UTEST_ASSERT(af.resample(dst_rate) == STATUS_OK);
+        UTEST_ASSERT(af.sample_rate() == dst_rate);
+        UTEST_ASSERT(af.samples() >= new_samples);
+
+        for (size_t c=0; c<CHANNELS; ++c)
+        {
+            FloatBuffer res(new_samples);
+            dsp::copy(res, af.channel(c), new_samples);
+            if (!res.equals_absolute(*ref[c], 1e-4))
+            {
+                int diff = res.last_diff();
+                UTEST_FAIL_MSG("Channel %d differs at sample %d: %.6f vs %.6f",
+                        int(c), diff, ref[c]->get(diff), res.get(diff));
+            }
+            delete ref[c];
+        }
+    }
+
+    void write_lspc(const LSPString *path, AudioFile &af)
+    {
+        LSPCFile fd;
+        LSPCAudioWriter aw;
+        lspc_audio_parameters_t p;
+        p.channels          = af.channels();
+        p.sample_format     = LSPC_SAMPLE_FMT_F32LE;
+        p.sample_rate       = af.sample_rate();
+        p.codec             = LSPC_CODEC_PCM;
+        p.frames            = af.samples();
+
+        const float *vp[CHANNELS];
+        for (size_t c=0; c<af.channels(); ++c)
+            vp[c]               = af.channel(c);
+
+        UTEST_ASSERT(fd.create(path) == STATUS_OK);
+        UTEST_ASSERT(aw.open(&fd, &p) == STATUS_OK);
+        UTEST_ASSERT(aw.write_samples(vp, af.samples()) == STATUS_OK);
+        UTEST_ASSERT(aw.close() == STATUS_OK);
+        UTEST_ASSERT(fd.close() == STATUS_OK);
+    }
+
+    void check_cached(const LSPString *path, AudioFile &ref)
+    {
+        AudioFile af;
+        UTEST_ASSERT(af.load_resampled(path, 44100) == STATUS_OK);
+        UTEST_ASSERT(af.sample_rate() == 44100);
+        UTEST_ASSERT(af.channels() == ref.channels());
+        UTEST_ASSERT(af.samples() == ref.samples());
+        for (size_t c=0; c<CHANNELS; ++c)
+            UTEST_ASSERT(memcmp(af.channel(c), ref.channel(c), ref.samples() * sizeof(float)) == 0);
+    }
+
+    void test_cache()
+    {
+        printf("Testing cache of resampled data...\n");
+
+        AudioFile src;
+        create_source(src, SRC_SAMPLES);
+
+        // Create source file
+        LSPString path;
+        UTEST_ASSERT(path.fmt_utf8("tmp/utest-%s.lspc", full_name()));
+        write_lspc(&path, src);
+
+        // Drop the stale cache entry
+        io::Path cache;
+        UTEST_ASSERT(TestAudioFile::cache_path(&cache, &path, 44100, -1) == STATUS_OK);
+        io::File::remove(&cache);
+
+        // Load the file, the cache entry should be created
+        AudioFile af1, af2;
+        UTEST_ASSERT(af1.load_resampled(&path, 44100) == STATUS_OK);
+        UTEST_ASSERT(cache.exists());
+        UTEST_ASSERT(af2.load_resampled(&path, 44100) == STATUS_OK);
+
+        // Compare with the directly resampled data
+        AudioFile ref;
+        UTEST_ASSERT(ref.load(&path) == STATUS_OK);
+        UTEST_ASSERT(ref.resample(44100) == STATUS_OK);
+        UTEST_ASSERT(af1.sample_rate() == 44100);
+        UTEST_ASSERT(af2.sample_rate() == 44100);
+        UTEST_ASSERT(af1.samples() == ref.samples());
+        UTEST_ASSERT(af2.samples() == ref.samples());
+
+        for (size_t c=0; c<CHANNELS; ++c)
+        {
+            UTEST_ASSERT(memcmp(af1.channel(c), ref.channel(c), ref.samples() * sizeof(float)) == 0);
+            UTEST_ASSERT(memcmp(af2.channel(c), ref.channel(c), ref.samples() * sizeof(float)) == 0);
+        }
+
+    #ifndef PLATFORM_WINDOWS
+        // The cache directory should be accessible by the user only
+        io::Path dir;
+        struct stat st;
+        UTEST_ASSERT(cache.get_parent(&dir) == STATUS_OK);
+        UTEST_ASSERT(::stat(dir.as_native(), &st) == 0);
+        UTEST_ASSERT(st.st_uid == ::geteuid());
+        UTEST_ASSERT((st.st_mode & 0777) == 0700);
+    #endif /* PLATFORM_WINDOWS */
+
+        // Replace the cache entry by the file with the same format but another content,
+        // it should be rejected and replaced by the valid entry
+        printf("Testing rejection of the invalid cache entry...\n");
+        AudioFile fake;
+        UTEST_ASSERT(fake.create_samples(CHANNELS, 44100, ref.samples()) == STATUS_OK);
+        write_lspc(cache.as_string(), fake);
+        check_cached(&path, ref);
+        check_cached(&path, ref);
+
+        io::File::remove(&cache);
+        io::File::remove(&path);
+    }
+
+    UTEST_MAIN
+    {
+        test_resample(1000, 96000);
+        test_resample(SRC_SAMPLES, 96000);
+        test_resample(1000, 44100);
+        test_resample(SRC_SAMPLES, 44100);
+        test_resample(SRC_SAMPLES, 88200);
+        test_resample(SRC_SAMPLES, 22050);
+        test_resample(SRC_SAMPLES, 32000);
+        test_cache();
+    }
+
+UTEST_END;
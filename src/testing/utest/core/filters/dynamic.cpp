@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <core/filters/DynamicFilters.h>
+#include <test/FloatBuffer.h>
+#include <dsp/dsp.h>
+
+using namespace lsp;
+
+#define BUF_SIZE        0x1000
+
+UTEST_BEGIN("core.filters", dynamic)
+
+    void init_filters(DynamicFilters *df, size_t sr, const filter_params_t *fp)
+    {
+        UTEST_ASSERT(df->init(2) == STATUS_OK);
+        df->set_sample_rate(sr);
+        for (size_t i=0; i<2; ++i)
+        {
+            UTEST_ASSERT(df->set_params(i, fp));
+            UTEST_ASSERT(df->set_filter_active(i, true));
+        }
+        UTEST_ASSERT(df->set_filter_precise(1, true));
+        UTEST_ASSERT(!df->filter_precise(0));
+        UTEST_ASSERT(df->filter_precise(1));
+    }
+
+    void test_dc_gain(size_t sr, float freq)
+    {
+        DynamicFilters df;
+        filter_params_t fp;
+
+        printf("Testing double-precision dynamic filter at %d Hz for %.1f Hz filter\n", int(sr), freq);
+
+        fp.nType    = FLT_BT_BWC_LOPASS;
+        fp.fFreq    = freq;
+        fp.fFreq2   = freq;
+        fp.fGain    = 1.0f;
+        fp.nSlope   = 4;
+        fp.fQuality = 0.0f;
+        init_filters(&df, sr, &fp);
+
+        // Feed the DC signal, the lo-pass filter should pass it at unity gain
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer gain(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        for (size_t i=0; i<BUF_SIZE; ++i)
+        {
+            src[i]      = 1.0f;
+            gain[i]     = 1.0f;
+        }
+
+        for (size_t i=0; i<(sr / BUF_SIZE) * 4; ++i)
+        {
+            df.process(0, dst1, src, gain, BUF_SIZE);
+            df.process(1, dst2, src, gain, BUF_SIZE);
+        }
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst1.corrupted());
+        UTEST_ASSERT(!dst2.corrupted());
+
+        float v1    = dst1[BUF_SIZE-1];
+        float v2    = dst2[BUF_SIZE-1];
+        printf("  DC gain: single-precision = %.6f, double-precision = %.6f\n", v1, v2);
+        UTEST_ASSERT_MSG(fabs(v2 - 1.0f) < 1e-3f, "Invalid DC gain of double-precision filter: %.6f", v2);
+
+        df.destroy();
+    }
+
+    void test_match(const char *label, size_t type, size_t slope)
+    {
+        DynamicFilters df;
+        filter_params_t fp;
+
+        printf("Testing double-precision %s dynamic filter against single precision\n", label);
+
+        fp.nType    = type;
+        fp.fFreq    = 500.0f;
+        fp.fFreq2   = 5000.0f;
+        fp.fGain    = 1.0f;
+        fp.nSlope   = slope;
+        fp.fQuality = 0.0f;
+        init_filters(&df, 48000, &fp);
+
+        // Process random signal
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer gain(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        src.randomize_sign();
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            gain[i]     = 0.5f;
+
+        df.process(0, dst1, src, gain, BUF_SIZE);
+        df.process(1, dst2, src, gain, BUF_SIZE);
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst1.corrupted());
+        UTEST_ASSERT(!dst2.corrupted());
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            UTEST_ASSERT_MSG(float_equals_absolute(dst1[i], dst2[i], 1e-3f),
+                "Sample mismatch at index %d: %f vs %f", int(i), dst1[i], dst2[i]);
+
+        df.destroy();
+    }
+
+    void test_blocks(const char *label, size_t type, size_t slope)
+    {
+        DynamicFilters df;
+        filter_params_t fp;
+
+        printf("Testing double-precision %s dynamic filter with irregular blocks\n", label);
+
+        fp.nType    = type;
+        fp.fFreq    = 500.0f;
+        fp.fFreq2   = 5000.0f;
+        fp.fGain    = 1.0f;
+        fp.nSlope   = slope;
+        fp.fQuality = 0.0f;
+        init_filters(&df, 48000, &fp);
+        UTEST_ASSERT(df.set_filter_precise(0, true));
+
+        // Process random signal with varying gain
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer gain(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        src.randomize_sign();
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            gain[i]     = 0.25f + 0.75f * float(i) / BUF_SIZE;
+
+        df.process(0, dst1, src, gain, BUF_SIZE);
+        for (size_t off=0, step=1; off < BUF_SIZE; step = (step * 7 + 3) % 300 + 1)
+        {
+            size_t to_do = lsp_min(BUF_SIZE - off, step);
+            df.process(1, &dst2[off], &src[off], &gain[off], to_do);
+            off    += to_do;
+        }
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst1.corrupted());
+        UTEST_ASSERT(!dst2.corrupted());
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            UTEST_ASSERT_MSG(float_equals_absolute(dst1[i], dst2[i], 1e-5f),
+                "Sample mismatch at index %d: %f vs %f", int(i), dst1[i], dst2[i]);
+
+        df.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        test_dc_gain(192000, 10.0f);
+        test_dc_gain(192000, 20.0f);
+
+        test_match("BWC lo-pass", FLT_BT_BWC_LOPASS, 4);
+        test_match("RLC bell", FLT_BT_RLC_BELL, 2);
+        test_match("LRX hi-shelf", FLT_BT_LRX_HISHELF, 2);
+        test_match("LRX ladder-pass", FLT_BT_LRX_LADDERPASS, 2);
+
+        test_blocks("BWC lo-pass", FLT_BT_BWC_LOPASS, 4);
+        test_blocks("LRX ladder-pass", FLT_BT_LRX_LADDERPASS, 2);
+    }
+
+UTEST_END
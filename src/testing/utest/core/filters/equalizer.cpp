@@ -33,7 +33,7 @@ using namespace lsp;
 
 UTEST_BEGIN("core.filters", equalizer)
 
-    void test_latency(const char *label, equalizer_mode_t mode)
+    void test_latency(const char *label, equalizer_mode_t mode, bool low_latency)
     {
         Equalizer eq;
         filter_params_t fp;
@@ -43,6 +43,7 @@ UTEST_BEGIN("core.filters", equalizer)
         // Configure the equalizer
         eq.init(1, FFT_RANK);
         eq.set_mode(mode);
+        eq.set_low_latency(low_latency);
         eq.set_sample_rate(48000);
 
         fp.nType    = FLT_BT_LRX_HIPASS;
@@ -87,11 +88,201 @@ UTEST_BEGIN("core.filters", equalizer)
         eq.destroy();
     }
 
+    void test_low_latency(const char *label, equalizer_mode_t mode)
+    {
+        Equalizer eq[2];
+        filter_params_t fp;
+
+        printf("Testing low-latency processing for %s mode\n", label);
+
+        fp.nType    = FLT_BT_RLC_BELL;
+        fp.fFreq    = 1000.0f;
+        fp.fFreq2   = 1000.0f;
+        fp.fGain    = 4.0f;
+        fp.nSlope   = 2;
+        fp.fQuality = 1.0f;
+
+        for (size_t i=0; i<2; ++i)
+        {
+            UTEST_ASSERT(eq[i].init(1, FFT_RANK));
+            eq[i].set_mode(mode);
+            eq[i].set_low_latency(i > 0);
+            eq[i].set_sample_rate(48000);
+            eq[i].set_params(0, &fp);
+        }
+
+        size_t latency  = eq[0].get_latency();
+        size_t ll       = eq[1].get_latency();
+        UTEST_ASSERT(ll < latency);
+
+        // Process random signal with irregular block sizes
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        src.randomize_sign();
+        dst1.fill_zero();
+        dst2.fill_zero();
+
+        eq[0].process(dst1, src, BUF_SIZE);
+        for (size_t off=0, step=1; off < BUF_SIZE; step = (step * 7 + 3) % 300 + 1)
+        {
+            size_t to_do = lsp_min(BUF_SIZE - off, step);
+            eq[1].process(&dst2[off], &src[off], to_do);
+            off    += to_do;
+        }
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst1.corrupted());
+        UTEST_ASSERT(!dst2.corrupted());
+
+        // The output should be the same, but less delayed
+        size_t delta    = latency - ll;
+        for (size_t i=0; i<BUF_SIZE - delta; ++i)
+            UTEST_ASSERT_MSG(float_equals_absolute(dst2[i], dst1[i + delta], 1e-4f),
+                "Sample mismatch at index %d: %f vs %f", int(i), dst2[i], dst1[i + delta]);
+
+        eq[0].destroy();
+        eq[1].destroy();
+    }
+
+    void test_precise(size_t sr, float freq)
+    {
+        Equalizer eq[2];
+        filter_params_t fp;
+
+        printf("Testing double-precision IIR processing at %d Hz for %.1f Hz filter\n", int(sr), freq);
+
+        fp.nType    = FLT_BT_BWC_LOPASS;
+        fp.fFreq    = freq;
+        fp.fFreq2   = freq;
+        fp.fGain    = 1.0f;
+        fp.nSlope   = 4;
+        fp.fQuality = 0.0f;
+
+        for (size_t i=0; i<2; ++i)
+        {
+            UTEST_ASSERT(eq[i].init(1, 0));
+            eq[i].set_mode(EQM_IIR);
+            eq[i].set_sample_rate(sr);
+            eq[i].set_params(0, &fp);
+        }
+        eq[1].set_precise(true);
+        UTEST_ASSERT(!eq[0].precise());
+        UTEST_ASSERT(eq[1].precise());
+
+        // Feed the DC signal, the lo-pass filter should pass it at unity gain
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            src[i]      = 1.0f;
+
+        for (size_t i=0; i<(sr / BUF_SIZE) * 4; ++i)
+        {
+            eq[0].process(dst1, src, BUF_SIZE);
+            eq[1].process(dst2, src, BUF_SIZE);
+        }
+        UTEST_ASSERT(!src.corrupted());
+        UTEST_ASSERT(!dst1.corrupted());
+        UTEST_ASSERT(!dst2.corrupted());
+
+        float v1    = dst1[BUF_SIZE-1];
+        float v2    = dst2[BUF_SIZE-1];
+        printf("  DC gain: single-precision = %.6f, double-precision = %.6f\n", v1, v2);
+        UTEST_ASSERT_MSG(fabs(v2 - 1.0f) < 1e-3f, "Invalid DC gain of double-precision filter: %.6f", v2);
+
+        // Switching back should keep the filter working
+        eq[1].set_precise(false);
+        eq[1].process(dst2, src, BUF_SIZE);
+        UTEST_ASSERT(!dst2.corrupted());
+
+        eq[0].destroy();
+        eq[1].destroy();
+    }
+
+    void test_stereo(size_t l_slope, size_t r_slope)
+    {
+        Equalizer eq[4];
+        filter_params_t fp;
+
+        printf("Testing stereo IIR processing for slopes %d and %d\n", int(l_slope), int(r_slope));
+
+        fp.nType    = FLT_BT_RLC_BELL;
+        fp.fGain    = 2.0f;
+        fp.fQuality = 1.0f;
+
+        // eq[0], eq[1] are processed as a pair, eq[2], eq[3] separately
+        for (size_t i=0; i<4; ++i)
+        {
+            UTEST_ASSERT(eq[i].init(2, 0));
+            eq[i].set_mode(EQM_IIR);
+            eq[i].set_sample_rate(48000);
+
+            fp.nSlope   = (i & 1) ? r_slope : l_slope;
+            fp.fFreq    = (i & 1) ? 440.0f : 1000.0f;
+            fp.fFreq2   = fp.fFreq;
+            eq[i].set_params(0, &fp);
+
+            fp.nSlope   = 2;
+            fp.fFreq    = (i & 1) ? 5000.0f : 100.0f;
+            fp.fFreq2   = fp.fFreq;
+            eq[i].set_params(1, &fp);
+        }
+
+        FloatBuffer l_src(BUF_SIZE);
+        FloatBuffer r_src(BUF_SIZE);
+        FloatBuffer l_dst1(BUF_SIZE);
+        FloatBuffer r_dst1(BUF_SIZE);
+        FloatBuffer l_dst2(BUF_SIZE);
+        FloatBuffer r_dst2(BUF_SIZE);
+        l_src.randomize_sign();
+        r_src.randomize_sign();
+
+        // Irregular block sizes check the state of filters between calls
+        for (size_t off=0, step=1; off < BUF_SIZE; step = (step * 13 + 5) % 1500 + 1)
+        {
+            size_t to_do = lsp_min(BUF_SIZE - off, step);
+            Equalizer::process(&eq[0], &eq[1], &l_dst1[off], &r_dst1[off], &l_src[off], &r_src[off], to_do);
+            eq[2].process(&l_dst2[off], &l_src[off], to_do);
+            eq[3].process(&r_dst2[off], &r_src[off], to_do);
+            off    += to_do;
+        }
+
+        UTEST_ASSERT(!l_src.corrupted());
+        UTEST_ASSERT(!r_src.corrupted());
+        UTEST_ASSERT(!l_dst1.corrupted());
+        UTEST_ASSERT(!r_dst1.corrupted());
+        UTEST_ASSERT(!l_dst2.corrupted());
+        UTEST_ASSERT(!r_dst2.corrupted());
+
+        if (!l_dst1.equals_adaptive(l_dst2, 1e-3f))
+            UTEST_FAIL_MSG("Left channel differs at sample %d: %.6f vs %.6f",
+                    int(l_dst1.last_diff()), l_dst1.get_diff(), l_dst2.get_diff());
+        if (!r_dst1.equals_adaptive(r_dst2, 1e-3f))
+            UTEST_FAIL_MSG("Right channel differs at sample %d: %.6f vs %.6f",
+                    int(r_dst1.last_diff()), r_dst1.get_diff(), r_dst2.get_diff());
+
+        for (size_t i=0; i<4; ++i)
+            eq[i].destroy();
+    }
+
     UTEST_MAIN
     {
-        test_latency("FIR", EQM_FIR);
-        test_latency("FFT", EQM_FFT);
-        test_latency("SPM", EQM_SPM);
+        test_latency("FIR", EQM_FIR, false);
+        test_latency("FFT", EQM_FFT, false);
+        test_latency("SPM", EQM_SPM, false);
+        test_latency("FIR-LL", EQM_FIR, true);
+        test_latency("FFT-LL", EQM_FFT, true);
+
+        test_low_latency("FIR", EQM_FIR);
+        test_low_latency("FFT", EQM_FFT);
+
+        test_precise(48000, 1000.0f);
+        test_precise(192000, 10.0f);
+
+        test_stereo(1, 1);
+        test_stereo(1, 3);
+        test_stereo(2, 1);
+        test_stereo(7, 5);
     }
 
 UTEST_END
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <core/ipc/Thread.h>
+#include <core/ipc/PoolExecutor.h>
+#include <core/system.h>
+#include <dsp/atomic.h>
+
+#define TASKS           32
+#define WORKERS         4
+
+using namespace lsp;
+
+static const status_t statuses[] =
+{
+    STATUS_OK, STATUS_NOT_FOUND, STATUS_BAD_ARGUMENTS, STATUS_CANCELLED
+};
+
+UTEST_BEGIN("core.ipc", pool_executor)
+
+    class TestTask: public ipc::ITask
+    {
+        private:
+            size_t              nDelay;
+            status_t            nResult;
+            volatile atomic_t  *pCounter;
+
+        public:
+            explicit TestTask(size_t delay, status_t result, volatile atomic_t *counter):
+                nDelay(delay), nResult(result), pCounter(counter) {}
+            virtual ~TestTask() {}
+
+        public:
+            virtual status_t run()
+            {
+                atomic_add(pCounter, 1);
+                ipc::Thread::sleep(nDelay);
+                return nResult;
+            }
+    };
+
+    static wssize_t time_millis()
+    {
+        system::time_t ts;
+        system::get_time(&ts);
+        return wssize_t(ts.seconds) * 1000 + ts.nanos / 1000000;
+    }
+
+    void test_latency()
+    {
+        volatile atomic_t counter = 0;
+        TestTask task(0, STATUS_OK, &counter);
+
+        printf("Testing latency of task start...\n");
+        ipc::PoolExecutor executor(WORKERS);
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+        UTEST_ASSERT(executor.workers() == WORKERS);
+
+        // The task should be executed immediately, not after the polling period
+        wssize_t start = time_millis();
+        UTEST_ASSERT(executor.submit(&task));
+        while (!task.completed())
+        {
+            UTEST_ASSERT_MSG((time_millis() - start) < 50, "Task has not been started in time");
+            ipc::Thread::sleep(1);
+        }
+        UTEST_ASSERT(counter == 1);
+        UTEST_ASSERT(task.code() == STATUS_OK);
+
+        // Submitting non-idle task should fail
+        UTEST_ASSERT(!executor.submit(&task));
+        UTEST_ASSERT(task.reset());
+
+        executor.shutdown();
+        UTEST_ASSERT(!executor.submit(&task));
+    }
+
+    void test_parallel()
+    {
+        volatile atomic_t counter = 0;
+        TestTask *tasks[TASKS];
+
+        for (size_t i=0; i<TASKS; ++i)
+        {
+            tasks[i] = new TestTask(50, statuses[i % 4], &counter);
+            UTEST_ASSERT(tasks[i] != NULL);
+            UTEST_ASSERT(tasks[i]->idle());
+        }
+
+        printf("Starting pool executor...\n");
+        ipc::PoolExecutor executor(WORKERS);
+        UTEST_ASSERT(executor.start() == STATUS_OK);
+
+        printf("Submitting tasks...\n");
+        wssize_t start = time_millis();
+        for (size_t i=0; i<TASKS; ++i)
+        {
+            UTEST_ASSERT(executor.submit(tasks[i]));
+            ipc::ITask::task_state_t ts = tasks[i]->state();
+            UTEST_ASSERT(
+                    (ts == ipc::ITask::TS_SUBMITTED) ||
+                    (ts == ipc::ITask::TS_RUNNING) ||
+                    (ts == ipc::ITask::TS_COMPLETED)
+                    );
+        }
+
+        printf("Shutting down executor...\n");
+        executor.shutdown();
+        wssize_t time = time_millis() - start;
+        printf("Execution time: %d ms\n", int(time));
+
+        // Tasks should be executed in parallel
+        UTEST_ASSERT(counter == TASKS);
+        UTEST_ASSERT_MSG(time < wssize_t(TASKS * 50 / 2), "Tasks have not been executed in parallel");
+
+        printf("Checking tasks...\n");
+        for (size_t i=0; i<TASKS; ++i)
+        {
+            UTEST_ASSERT(tasks[i]->completed());
+            UTEST_ASSERT(tasks[i]->code() == statuses[i % 4]);
+            UTEST_ASSERT(tasks[i]->reset());
+            UTEST_ASSERT(tasks[i]->idle());
+        }
+
+        printf("Destroying tasks...\n");
+        for (size_t i=0; i<TASKS; ++i)
+            delete tasks[i];
+    }
+
+    UTEST_MAIN
+    {
+        test_latency();
+        test_parallel();
+    }
+
+UTEST_END
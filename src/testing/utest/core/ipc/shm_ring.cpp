@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <core/port_data.h>
+#include <core/ipc/SharedMemory.h>
+#include <core/ipc/Thread.h>
+
+#define RING_SIZE           0x1000
+#define RECORDS             20000
+#define RECORD_MAX          300
+
+using namespace lsp;
+
+UTEST_BEGIN("core.ipc", shm_ring)
+
+    static inline size_t record_length(size_t id)
+    {
+        return ((id * 37) % RECORD_MAX) + 1;
+    }
+
+    static status_t producer(void *arg)
+    {
+        shm_ring_t *ring    = reinterpret_cast<shm_ring_t *>(arg);
+
+        for (size_t id=0; id<RECORDS; )
+        {
+            size_t len          = record_length(id);
+            uint8_t *dst        = reinterpret_cast<uint8_t *>(ring->begin_write(RECORD_MAX));
+            if (dst == NULL)
+            {
+                ipc::Thread::sleep(0);
+                continue;
+            }
+
+            for (size_t i=0; i<len; ++i)
+                dst[i]              = uint8_t(id + i);
+            ring->commit_write(len);
+            ++id;
+        }
+
+        return STATUS_OK;
+    }
+
+    void test_single_thread()
+    {
+        uint8_t buf[0x400];
+        shm_ring_t *ring    = shm_ring_t::init(buf, sizeof(buf));
+        UTEST_ASSERT(ring != NULL);
+        UTEST_ASSERT(ring->empty());
+
+        size_t size;
+        UTEST_ASSERT(ring->begin_read(&size) == NULL);
+
+        // Fill the ring until it overflows
+        size_t written = 0;
+        while (true)
+        {
+            uint32_t *dst   = reinterpret_cast<uint32_t *>(ring->begin_write(sizeof(uint32_t) * 4));
+            if (dst == NULL)
+                break;
+            dst[0]          = written++;
+            ring->commit_write(sizeof(uint32_t));
+        }
+        printf("Written %d records into the ring of %d bytes\n", int(written), int(ring->capacity()));
+        UTEST_ASSERT(written > 0);
+        UTEST_ASSERT(!ring->empty());
+
+        // Read records in the same order
+        for (size_t i=0; i<written; ++i)
+        {
+            const uint32_t *src = reinterpret_cast<const uint32_t *>(ring->begin_read(&size));
+            UTEST_ASSERT(src != NULL);
+            UTEST_ASSERT(size == sizeof(uint32_t));
+            UTEST_ASSERT(src[0] == i);
+            ring->commit_read();
+        }
+        UTEST_ASSERT(ring->begin_read(&size) == NULL);
+        UTEST_ASSERT(ring->empty());
+
+        // Uninitialized memory should not be attached
+        uint8_t bad[0x100];
+        for (size_t i=0; i<sizeof(bad); ++i)
+            bad[i]          = 0xff;
+        UTEST_ASSERT(shm_ring_t::attach(bad, sizeof(bad)) == NULL);
+    }
+
+    void test_reattach()
+    {
+        uint8_t buf[0x400];
+        shm_ring_t *ring    = shm_ring_t::init(buf, sizeof(buf));
+        UTEST_ASSERT(ring != NULL);
+
+        // Leave records unread by the consumer
+        for (size_t i=0; i<4; ++i)
+        {
+            uint32_t *dst   = reinterpret_cast<uint32_t *>(ring->begin_write(sizeof(uint32_t)));
+            UTEST_ASSERT(dst != NULL);
+            dst[0]          = i;
+            ring->commit_write(sizeof(uint32_t));
+        }
+
+        size_t size;
+        const uint32_t *src = reinterpret_cast<const uint32_t *>(ring->begin_read(&size));
+        UTEST_ASSERT((src != NULL) && (src[0] == 0));
+        ring->commit_read();
+
+        // New consumer should not see stale records
+        shm_ring_t *in      = shm_ring_t::attach(buf, sizeof(buf));
+        UTEST_ASSERT(in == ring);
+        UTEST_ASSERT(in->empty());
+        UTEST_ASSERT(in->begin_read(&size) == NULL);
+
+        // New records should be passed to the new consumer
+        uint32_t *dst       = reinterpret_cast<uint32_t *>(ring->begin_write(sizeof(uint32_t)));
+        UTEST_ASSERT(dst != NULL);
+        dst[0]              = 100;
+        ring->commit_write(sizeof(uint32_t));
+
+        src                 = reinterpret_cast<const uint32_t *>(in->begin_read(&size));
+        UTEST_ASSERT(src != NULL);
+        UTEST_ASSERT(size == sizeof(uint32_t));
+        UTEST_ASSERT(src[0] == 100);
+        in->commit_read();
+        UTEST_ASSERT(in->empty());
+    }
+
+    void test_shared_memory()
+    {
+        ipc::SharedMemory wr, rd;
+
+        UTEST_ASSERT(wr.create_unique("lsp-utest", shm_ring_t::size_of(RING_SIZE)) == STATUS_OK);
+        printf("Created shared memory segment %s of %d bytes\n", wr.name(), int(wr.size()));
+        UTEST_ASSERT(wr.owner());
+        UTEST_ASSERT(rd.open(wr.name()) == STATUS_OK);
+        UTEST_ASSERT(!rd.owner());
+        UTEST_ASSERT(rd.size() >= wr.size());
+        UTEST_ASSERT(rd.data() != wr.data());
+
+        // Producer and consumer use different mappings of the same memory
+        shm_ring_t *out     = shm_ring_t::init(wr.data(), wr.size());
+        UTEST_ASSERT(out != NULL);
+        shm_ring_t *in      = shm_ring_t::attach(rd.data(), rd.size());
+        UTEST_ASSERT(in != NULL);
+
+        ipc::Thread thread(producer, out);
+        UTEST_ASSERT(thread.start() == STATUS_OK);
+
+        size_t size;
+        for (size_t id=0; id<RECORDS; )
+        {
+            const uint8_t *src  = reinterpret_cast<const uint8_t *>(in->begin_read(&size));
+            if (src == NULL)
+            {
+                ipc::Thread::sleep(0);
+                continue;
+            }
+
+            size_t len          = record_length(id);
+            UTEST_ASSERT_MSG(size == len, "Invalid size of record %d: %d vs %d", int(id), int(size), int(len));
+            for (size_t i=0; i<len; ++i)
+                UTEST_ASSERT_MSG(src[i] == uint8_t(id + i), "Invalid contents of record %d at offset %d", int(id), int(i));
+            in->commit_read();
+            ++id;
+        }
+
+        UTEST_ASSERT(thread.join() == STATUS_OK);
+        UTEST_ASSERT(in->begin_read(&size) == NULL);
+
+        UTEST_ASSERT(rd.close() == STATUS_OK);
+        UTEST_ASSERT(wr.close() == STATUS_OK);
+
+        // Segment should be removed after close by the owner
+        char name[SHARED_MEMORY_NAME_MAX];
+        UTEST_ASSERT(wr.create("lsp-utest-removed", 0x1000) == STATUS_OK);
+        ::strcpy(name, wr.name());
+        UTEST_ASSERT(wr.close() == STATUS_OK);
+        UTEST_ASSERT(rd.open(name) == STATUS_NOT_FOUND);
+    }
+
+    UTEST_MAIN
+    {
+        test_single_thread();
+        test_reattach();
+        test_shared_memory();
+    }
+
+UTEST_END;
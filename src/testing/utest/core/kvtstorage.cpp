@@ -25,6 +25,9 @@
 
 using namespace lsp;
 
+#define POOL_KEYS               0x40
+#define POOL_ROUNDS             0x40
+
 enum
 {
     F_Attached  = 1 << 0,
@@ -847,6 +850,110 @@ UTEST_BEGIN("core", kvtstorage)
         UTEST_ASSERT(s.listeners() == 0);
     }
 
+    void test_batch()
+    {
+        KVTStorage s;
+        kvt_entry_t v[4];
+        int32_t ivalue;
+        float fvalue;
+        const char *svalue;
+
+        printf("Testing batch put\n");
+
+        v[0].name       = "a";
+        v[0].value.type = KVT_INT32;
+        v[0].value.i32  = 42;
+        v[0].flags      = KVT_TX;
+        v[1].name       = "b/c";
+        v[1].value.type = KVT_FLOAT32;
+        v[1].value.f32  = 1.5f;
+        v[1].flags      = KVT_TX;
+        v[2].name       = "d//e";
+        v[2].value.type = KVT_STRING;
+        v[2].value.str  = "string";
+        v[2].flags      = 0;
+
+        // Invalid entry should reject the whole batch
+        UTEST_ASSERT(s.put_batch("/base", v, 3) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.values() == 0);
+        UTEST_ASSERT(s.put_batch("/base/", v, 2) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.values() == 0);
+
+        // Valid batch
+        v[2].name       = "d/e";
+        UTEST_ASSERT(s.put_batch("/base", v, 3) == STATUS_OK);
+        UTEST_ASSERT(s.values() == 3);
+        UTEST_ASSERT(s.tx_pending() == 2);
+        UTEST_ASSERT((s.get("/base/a", &ivalue) == STATUS_OK) && (ivalue == 42));
+        UTEST_ASSERT((s.get("/base/b/c", &fvalue) == STATUS_OK) && (fvalue == 1.5f));
+        UTEST_ASSERT((s.get("/base/d/e", &svalue) == STATUS_OK) && (::strcmp(svalue, "string") == 0));
+
+        // Rejected entries are not errors
+        v[0].value.i32  = 10;
+        v[0].flags      = KVT_KEEP;
+        v[1].value.f32  = 2.5f;
+        v[1].flags      = 0;
+        UTEST_ASSERT(s.put_batch("/base", v, 2) == STATUS_OK);
+        UTEST_ASSERT((s.get("/base/a", &ivalue) == STATUS_OK) && (ivalue == 42));
+        UTEST_ASSERT((s.get("/base/b/c", &fvalue) == STATUS_OK) && (fvalue == 2.5f));
+
+        // Batch at the root
+        v[0].name       = "root";
+        v[0].flags      = 0;
+        UTEST_ASSERT(s.put_batch("/", v, 1) == STATUS_OK);
+        UTEST_ASSERT((s.get("/root", &ivalue) == STATUS_OK) && (ivalue == 10));
+        UTEST_ASSERT(s.values() == 4);
+
+        s.destroy();
+    }
+
+    static void pool_key(char *dst, size_t i)
+    {
+        // Every fourth key is too long to be allocated from the node pool
+        if (i & 3)
+            ::sprintf(dst, "/pool/%d/value", int(i));
+        else
+            ::sprintf(dst, "/pool/%d/very_long_identifier_of_the_node_that_does_not_fit_pool/value", int(i));
+    }
+
+    void test_pool()
+    {
+        KVTStorage s;
+        char name[0x100];
+
+        printf("Testing reuse of pooled nodes and parameters\n");
+
+        for (size_t round=0; round < POOL_ROUNDS; ++round)
+        {
+            for (size_t i=0; i<POOL_KEYS; ++i)
+            {
+                pool_key(name, i);
+                if ((i + round) % 3)
+                {
+                    UTEST_ASSERT(s.put(name, int32_t(round * POOL_KEYS + i)) == STATUS_OK);
+                }
+                else
+                    s.remove_branch(name);
+            }
+            UTEST_ASSERT(s.gc() == STATUS_OK);
+        }
+
+        // Validate the final state
+        for (size_t i=0; i<POOL_KEYS; ++i)
+        {
+            int32_t value = -1;
+            size_t round = POOL_ROUNDS - 1;
+            pool_key(name, i);
+            status_t res = s.get(name, &value);
+            bool valid   = ((i + round) % 3) ?
+                    (res == STATUS_OK) && (value == int32_t(round * POOL_KEYS + i)) :
+                    (res == STATUS_NOT_FOUND);
+            UTEST_ASSERT_MSG(valid, "Invalid state of parameter %s", name);
+        }
+
+        s.destroy();
+    }
+
     UTEST_MAIN
     {
         TestListener l(this);
@@ -866,6 +973,9 @@ UTEST_BEGIN("core", kvtstorage)
 
         // Destroy storage
         s.destroy();
+
+        test_batch();
+        test_pool();
     }
 UTEST_END;
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2026 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <core/plugin.h>
+#include <metadata/ports.h>
+
+#define SRATE           48000
+#define BLOCK_SIZE      1024
+
+namespace
+{
+    using namespace lsp;
+
+    static const port_t test_ports[] =
+    {
+        PORTS_END
+    };
+
+    static const int test_classes[] = { -1 };
+
+    static const plugin_metadata_t test_metadata =
+    {
+        "Test", "Test plugin", "T", NULL, "test", "tst0", 0, 0,
+        test_classes, E_NONE, test_ports, NULL, NULL, NULL
+    };
+
+    class TestPlugin: public plugin_t
+    {
+        public:
+            size_t      nActivated;
+            size_t      nDeactivated;
+
+        public:
+            explicit TestPlugin(): plugin_t(test_metadata)
+            {
+                nActivated      = 0;
+                nDeactivated    = 0;
+            }
+
+        public:
+            virtual void display_activated()    { ++nActivated;     }
+            virtual void display_deactivated()  { ++nDeactivated;   }
+    };
+}
+
+UTEST_BEGIN("core", plugin)
+
+    void process(TestPlugin *p, size_t samples)
+    {
+        for (size_t off=0; off < samples; off += BLOCK_SIZE)
+            p->update_display_state(lsp_min(samples - off, size_t(BLOCK_SIZE)));
+    }
+
+    UTEST_MAIN
+    {
+        TestPlugin p;
+        p.set_sample_rate(SRATE);
+        p.deactivate_ui();
+
+        // Nothing should be activated without draws
+        process(&p, SRATE * 4);
+        UTEST_ASSERT(!p.display_active());
+        UTEST_ASSERT(!p.has_consumers());
+        UTEST_ASSERT(p.nActivated == 0);
+
+        // Draw of inline display activates it
+        p.display_drawn();
+        process(&p, BLOCK_SIZE);
+        UTEST_ASSERT(p.display_active());
+        UTEST_ASSERT(p.has_consumers());
+        UTEST_ASSERT(p.nActivated == 1);
+
+        // Display should stay active until the idle timeout expires, the first
+        // block after the draw only resets the idle counter
+        process(&p, SRATE);
+        UTEST_ASSERT(p.display_active());
+        p.display_drawn();
+        p.display_drawn();
+        process(&p, SRATE * 2);
+        UTEST_ASSERT(p.display_active());
+        UTEST_ASSERT(p.nActivated == 1);
+        UTEST_ASSERT(p.nDeactivated == 0);
+
+        // Display should be deactivated after two seconds without draws
+        process(&p, BLOCK_SIZE);
+        UTEST_ASSERT(!p.display_active());
+        UTEST_ASSERT(!p.has_consumers());
+        UTEST_ASSERT(p.nDeactivated == 1);
+        process(&p, SRATE * 4);
+        UTEST_ASSERT(p.nDeactivated == 1);
+
+        // New draw should activate the display again
+        p.display_drawn();
+        process(&p, BLOCK_SIZE);
+        UTEST_ASSERT(p.display_active());
+        UTEST_ASSERT(p.nActivated == 2);
+
+        // The UI is a consumer too
+        p.activate_ui();
+        UTEST_ASSERT(p.has_consumers());
+    }
+
+UTEST_END
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <core/resource.h>
+
+#ifdef LSP_BUILTIN_RESOURCES
+
+using namespace lsp;
+
+UTEST_BEGIN("core", resource)
+
+    UTEST_MAIN
+    {
+        size_t count = 0;
+
+        printf("Testing lookup of all builtin resources...\n");
+        for (const resource::resource_t *res = resource::all(); (res->id != NULL) && (res->data != NULL); ++res, ++count)
+        {
+            UTEST_ASSERT_MSG(resource::get(res->id, resource::RESOURCE_UNKNOWN) == res,
+                    "Resource lookup failed: %s", res->id);
+            UTEST_ASSERT_MSG(resource::get(res->id, resource::resource_type_t(res->type)) == res,
+                    "Typed resource lookup failed: %s", res->id);
+
+            // Resource of another type should not be found
+            resource::resource_type_t type = (res->type == resource::RESOURCE_XML) ?
+                    resource::RESOURCE_JSON : resource::RESOURCE_XML;
+            UTEST_ASSERT(resource::get(res->id, type) == NULL);
+        }
+        printf("Checked %d resources\n", int(count));
+        UTEST_ASSERT(count <= resource::builtin_index_size);
+
+        printf("Testing lookup of missing resources...\n");
+        UTEST_ASSERT(resource::get(NULL, resource::RESOURCE_UNKNOWN) == NULL);
+        UTEST_ASSERT(resource::get("", resource::RESOURCE_UNKNOWN) == NULL);
+        UTEST_ASSERT(resource::get("unexisting/resource.xml", resource::RESOURCE_UNKNOWN) == NULL);
+        UTEST_ASSERT(resource::get("ui/unexisting.xml", resource::RESOURCE_XML) == NULL);
+    }
+
+UTEST_END;
+
+#endif /* LSP_BUILTIN_RESOURCES */
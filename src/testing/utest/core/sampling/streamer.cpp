@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <dsp/dsp.h>
+#include <core/ipc/Thread.h>
+#include <core/fade.h>
+#include <core/files/AudioStream.h>
+#include <core/sampling/SamplePlayer.h>
+#include <core/sampling/SampleStreamer.h>
+
+#define STREAM_CHANNELS     2
+#define STREAM_LENGTH       100000
+#define SAMPLE_OFFSET       1000
+#define SAMPLE_HEAD         2048
+#define SAMPLE_LENGTH       60000
+#define SAMPLE_FADEOUT      59000
+#define PLAY_DELAY          10
+#define BLOCK_SIZE          256
+
+using namespace lsp;
+
+namespace
+{
+    /**
+     * Audio stream that reads interleaved frames from memory
+     */
+    class MemoryStream: public AudioStream
+    {
+        private:
+            const float    *vData;
+
+        public:
+            explicit MemoryStream(const float *data, size_t channels, size_t samples)
+            {
+                vData           = data;
+                nChannels       = channels;
+                nSamples        = samples;
+                nSampleRate     = 48000;
+            }
+
+            virtual status_t open(const LSPString *path)
+            {
+                return STATUS_NOT_SUPPORTED;
+            }
+
+            virtual status_t close()
+            {
+                return STATUS_OK;
+            }
+
+            virtual ssize_t read_frames(float *dst, size_t offset, size_t frames)
+            {
+                if (offset >= nSamples)
+                    return 0;
+                frames          = lsp_min(frames, nSamples - offset);
+                dsp::copy(dst, &vData[offset * nChannels], frames * nChannels);
+                return frames;
+            }
+    };
+}
+
+UTEST_BEGIN("core.sampling", streamer)
+
+    Sample *create_sample(const float *data, AudioStream *stream, size_t fadeout)
+    {
+        Sample *s = new Sample();
+        UTEST_ASSERT(s->init(STREAM_CHANNELS, SAMPLE_HEAD, SAMPLE_HEAD));
+        for (size_t j=0; j<STREAM_CHANNELS; ++j)
+        {
+            float *dst = s->getBuffer(j);
+            for (size_t i=0; i<SAMPLE_HEAD; ++i)
+                dst[i]  = data[(SAMPLE_OFFSET + i) * STREAM_CHANNELS + j];
+            fade_out(dst, dst, fadeout, 0, SAMPLE_HEAD, SAMPLE_LENGTH);
+        }
+        s->set_stream(stream, SAMPLE_OFFSET, SAMPLE_LENGTH, fadeout);
+        UTEST_ASSERT(s->total_length() == SAMPLE_LENGTH);
+        return s;
+    }
+
+    void render(SamplePlayer *sp, FloatBuffer &dst)
+    {
+        for (size_t off=0; off < dst.size(); off += BLOCK_SIZE)
+        {
+            sp->process(dst.data(off), lsp_min(size_t(BLOCK_SIZE), dst.size() - off));
+            ipc::Thread::sleep(2);  // Give time for the streaming thread
+        }
+    }
+
+    void test_playback(const float *data, AudioStream *stream)
+    {
+        printf("Testing streamed playback...\n");
+
+        SampleStreamer ss;
+        SamplePlayer sp;
+        UTEST_ASSERT(ss.init(4) == STATUS_OK);
+        UTEST_ASSERT(sp.init(1, 4, &ss));
+        UTEST_ASSERT(sp.bind(0, create_sample(data, stream, 0)));
+
+        FloatBuffer ref(SAMPLE_LENGTH + PLAY_DELAY + BLOCK_SIZE);
+        FloatBuffer dst(ref.size());
+        ref.fill_zero();
+        for (size_t i=0; i<SAMPLE_LENGTH; ++i)
+            ref[PLAY_DELAY + i]     = 0.5f * data[(SAMPLE_OFFSET + i) * STREAM_CHANNELS + 1];
+
+        UTEST_ASSERT(sp.play(0, 1, 0.5f, PLAY_DELAY));
+        render(&sp, dst);
+
+        sp.destroy(true);
+        ss.unlink(stream);
+
+        UTEST_ASSERT_MSG(ss.underruns() == 0, "Unexpected underruns: %d", int(ss.underruns()));
+        ss.destroy();
+
+        UTEST_ASSERT(dst.valid());
+        if (!dst.equals_absolute(ref, 1e-5))
+        {
+            size_t index = dst.last_diff();
+            UTEST_FAIL_MSG("Streamed output differs at sample=%d: %.6f vs %.6f",
+                    int(index), ref.get(index), dst.get(index));
+        }
+    }
+
+    void test_no_voices(const float *data, AudioStream *stream)
+    {
+        printf("Testing playback without free streaming voices...\n");
+
+        SampleStreamer ss;
+        SamplePlayer sp;
+        UTEST_ASSERT(ss.init(1) == STATUS_OK);
+        UTEST_ASSERT(sp.init(1, 4, &ss));
+        UTEST_ASSERT(sp.bind(0, create_sample(data, stream, 0)));
+
+        // The second playback has no streaming voice and plays only the head
+        FloatBuffer ref(SAMPLE_LENGTH + BLOCK_SIZE);
+        FloatBuffer dst(ref.size());
+        ref.fill_zero();
+        for (size_t i=0; i<SAMPLE_LENGTH; ++i)
+            ref[i]                  = data[(SAMPLE_OFFSET + i) * STREAM_CHANNELS];
+        for (size_t i=0; i<SAMPLE_HEAD; ++i)
+            ref[i]                 += data[(SAMPLE_OFFSET + i) * STREAM_CHANNELS + 1];
+
+        UTEST_ASSERT(sp.play(0, 0, 1.0f, 0));
+        UTEST_ASSERT(sp.play(0, 1, 1.0f, 0));
+        render(&sp, dst);
+
+        size_t underruns    = ss.underruns();
+        size_t dropped      = ss.dropped();
+
+        sp.destroy(true);
+        ss.unlink(stream);
+        ss.destroy();
+
+        UTEST_ASSERT_MSG(underruns == 0, "Unexpected underruns: %d", int(underruns));
+        UTEST_ASSERT_MSG(dropped == 1, "Unexpected dropped voices: %d", int(dropped));
+        UTEST_ASSERT(dst.valid());
+        if (!dst.equals_absolute(ref, 1e-5))
+        {
+            size_t index = dst.last_diff();
+            UTEST_FAIL_MSG("Output differs at sample=%d: %.6f vs %.6f",
+                    int(index), ref.get(index), dst.get(index));
+        }
+    }
+
+    void test_fadeout(const float *data, AudioStream *stream)
+    {
+        printf("Testing fade-out of the streamed sample...\n");
+
+        SampleStreamer ss;
+        SamplePlayer sp;
+        UTEST_ASSERT(ss.init(4) == STATUS_OK);
+        UTEST_ASSERT(sp.init(1, 4, &ss));
+        UTEST_ASSERT(sp.bind(0, create_sample(data, stream, SAMPLE_FADEOUT)));
+
+        // The fade-out starts within the preloaded head and continues over the streamed part
+        FloatBuffer ref(SAMPLE_LENGTH + BLOCK_SIZE);
+        FloatBuffer dst(ref.size());
+        ref.fill_zero();
+        for (size_t i=0; i<SAMPLE_LENGTH; ++i)
+        {
+            float gain  = (i < (SAMPLE_LENGTH - SAMPLE_FADEOUT)) ? 1.0f : float(SAMPLE_LENGTH - 1 - i) / SAMPLE_FADEOUT;
+            ref[i]      = gain * data[(SAMPLE_OFFSET + i) * STREAM_CHANNELS];
+        }
+
+        UTEST_ASSERT(sp.play(0, 0, 1.0f, 0));
+        render(&sp, dst);
+
+        sp.destroy(true);
+        ss.unlink(stream);
+
+        UTEST_ASSERT_MSG(ss.underruns() == 0, "Unexpected underruns: %d", int(ss.underruns()));
+        ss.destroy();
+
+        UTEST_ASSERT(dst.valid());
+        if (!dst.equals_absolute(ref, 1e-5))
+        {
+            size_t index = dst.last_diff();
+            UTEST_FAIL_MSG("Faded output differs at sample=%d: %.6f vs %.6f",
+                    int(index), ref.get(index), dst.get(index));
+        }
+    }
+
+    UTEST_MAIN
+    {
+        FloatBuffer data(STREAM_LENGTH * STREAM_CHANNELS);
+        data.randomize(-1.0f, 1.0f);
+        MemoryStream stream(data, STREAM_CHANNELS, STREAM_LENGTH);
+
+        test_playback(data, &stream);
+        test_no_voices(data, &stream);
+        test_fadeout(data, &stream);
+    }
+
+UTEST_END;
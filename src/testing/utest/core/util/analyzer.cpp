@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <test/FloatBuffer.h>
+#include <core/util/Analyzer.h>
+
+#include <math.h>
+
+#define SRATE       48000
+#define RANK        14
+#define LEVELS      4
+#define BLOCK       1024
+#define DURATION    (SRATE * 2)
+
+using namespace lsp;
+
+UTEST_BEGIN("core.util", analyzer)
+
+    void analyze(Analyzer &a, size_t levels, size_t bin)
+    {
+        FloatBuffer in(BLOCK);
+        const float *vin[1];
+        vin[0]          = in.data();
+
+        // Feed sine wave which frequency matches the center of the spectrum bin
+        UTEST_ASSERT(a.set_levels(levels));
+        a.reset();
+
+        float w         = 2.0f * M_PI * bin / float(1 << RANK);
+        for (size_t t=0; t<DURATION; t += BLOCK)
+        {
+            for (size_t i=0; i<BLOCK; ++i)
+                in[i]           = sinf(w * (t + i));
+            a.process(vin, BLOCK);
+        }
+        UTEST_ASSERT(!in.corrupted());
+    }
+
+    void check_peak(Analyzer &a, size_t bin, const char *label)
+    {
+        float classic, mres;
+        size_t step     = 1 << (LEVELS - 1);
+
+        // Get peak level for classic analysis
+        analyze(a, 1, bin);
+        classic         = a.get_level(0, bin);
+        float c_side    = a.get_level(0, bin + step * 8);
+
+        // Get peak level for multi-resolution analysis
+        analyze(a, LEVELS, bin);
+        mres            = a.get_level(0, bin);
+        float m_side    = a.get_level(0, bin + step * 8);
+
+        printf("%s: bin=%d, classic=%.6f (side=%.6f), multi-resolution=%.6f (side=%.6f)\n",
+                label, int(bin), classic, c_side, mres, m_side);
+
+        // Sine wave should be displayed with the same level, leakage to far bins should be low
+        UTEST_ASSERT_MSG(float_equals_relative(classic, mres, 0.05f),
+                "Peak level mismatch for %s: classic=%f, multi-resolution=%f", label, classic, mres);
+        UTEST_ASSERT_MSG(m_side < mres * 1e-2f,
+                "Too high leakage for %s: peak=%f, side=%f", label, mres, m_side);
+    }
+
+    UTEST_MAIN
+    {
+        Analyzer a;
+
+        UTEST_ASSERT(a.init(1, RANK, SRATE, 20.0f, LEVELS));
+        UTEST_ASSERT(!a.set_levels(0));
+        UTEST_ASSERT(!a.set_levels(LEVELS + 1));
+
+        a.set_activity(true);
+        a.set_envelope(envelope::WHITE_NOISE);
+        a.set_window(windows::HANN);
+        a.set_sample_rate(SRATE);
+        a.set_rate(20.0f);
+        a.set_rank(RANK);
+        a.set_reactivity(0.0f);
+        a.set_shift(1.0f);
+
+        // Bins covered by the deepest, middle and full-rate levels
+        check_peak(a, 34, "deepest level");
+        check_peak(a, 1000, "middle level");
+        check_peak(a, 3400, "full-rate level");
+
+        a.destroy();
+    }
+
+UTEST_END
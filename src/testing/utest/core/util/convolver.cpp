@@ -27,6 +27,15 @@
 
 using namespace lsp;
 
+namespace
+{
+    class StalledConvolver: public Convolver
+    {
+        public:
+            inline void hold_worker(bool hold)      { bWorkerHold = hold; }
+    };
+}
+
 #define LCONV_SIZE      0x10000
 #define CONV_SIZE       0x2000
 #define SRC_SIZE        0x2000
@@ -230,11 +239,64 @@ UTEST_BEGIN("core.util", convolver)
         c.destroy();
     }
 
+    void test_threaded(size_t rank, size_t step, bool stalled)
+    {
+        Convolver c1;
+        StalledConvolver c2;
+
+        FloatBuffer conv(CONV_SIZE + 0x35);
+        FloatBuffer src(SRC_SIZE + conv.size());
+        FloatBuffer dst1(src.size());
+        FloatBuffer dst2(dst1);
+
+        printf("Testing threaded convolution rank=%d, step=%d, stalled=%s...\n",
+                int(rank), int(step), (stalled) ? "true" : "false");
+
+        conv.randomize(-1.0f, 1.0f);
+        src.randomize(-1.0f, 1.0f);
+        dsp::fill_zero(src.data(SRC_SIZE), src.size() - SRC_SIZE);
+        dst1.fill_zero();
+        dst2.fill_zero();
+
+        UTEST_ASSERT(c1.init(conv, conv.size(), rank, 0.3f));
+        UTEST_ASSERT(c2.init(conv, conv.size(), rank, 0.3f, CONV_MODE_THREADED));
+        UTEST_ASSERT(!c1.threaded());
+        UTEST_ASSERT(c2.threaded());
+
+        // The stalled worker thread does not compute any block, all blocks should be
+        // applied by the processing thread
+        c2.hold_worker(stalled);
+
+        convolve(c1, dst1, src, src.size(), step);
+        convolve(c2, dst2, src, src.size(), step);
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(conv.valid(), "Convolution buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        if (!dst2.equals_absolute(dst1, 1e-3))
+        {
+            size_t index = dst2.last_diff();
+            UTEST_FAIL_MSG("Output of threaded convolver is invalid, started at sample=%d: %.5f vs %.5f",
+                    int(index), dst1[index], dst2[index]);
+        }
+
+        c1.destroy();
+        c2.destroy();
+    }
+
     UTEST_MAIN
     {
 //        test_collisions();
         test_small();
         test_large();
+        test_threaded(9, 31, false);
+        test_threaded(10, 256, false);
+        test_threaded(11, 1000, false);
+        test_threaded(9, 31, true);
+        test_threaded(10, 256, true);
+        test_threaded(11, 1000, true);
     }
 UTEST_END;
 
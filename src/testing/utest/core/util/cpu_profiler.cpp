@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <core/util/CpuProfiler.h>
+
+#define SRATE           48000
+#define BLOCK_SIZE      512
+#define BLOCKS          100
+
+using namespace lsp;
+
+UTEST_BEGIN("core.util", cpu_profiler)
+
+    void run_block(CpuProfiler &p, FloatBuffer &a, FloatBuffer &b, size_t rounds)
+    {
+        CpuProfiler::Block prof(p, BLOCK_SIZE);
+
+        p.stage("copy");
+        for (size_t i=0; i<rounds; ++i)
+            dsp::copy(b, a, BLOCK_SIZE);
+
+        p.stage("mul");
+        for (size_t i=0; i<rounds * 4; ++i)
+            dsp::mul2(b, a, BLOCK_SIZE);
+    }
+
+    void test_disabled()
+    {
+        FloatBuffer a(BLOCK_SIZE), b(BLOCK_SIZE);
+        a.randomize(-1.0f, 1.0f);
+
+        CpuProfiler p;
+        p.set_enabled(false);
+        p.set_sample_rate(SRATE);
+
+        for (size_t i=0; i<BLOCKS; ++i)
+            run_block(p, a, b, 1);
+
+        UTEST_ASSERT(p.blocks() == 0);
+        UTEST_ASSERT(p.samples() == 0);
+        UTEST_ASSERT(p.stages() == 0);
+    }
+
+    void test_stages()
+    {
+        FloatBuffer a(BLOCK_SIZE), b(BLOCK_SIZE);
+        a.randomize(-1.0f, 1.0f);
+
+        CpuProfiler p;
+        p.set_enabled(true);
+        p.set_sample_rate(SRATE);
+
+        // Stage calls outside of the block should be ignored
+        p.stage("ignored");
+        UTEST_ASSERT(p.stages() == 0);
+
+        for (size_t i=0; i<BLOCKS; ++i)
+            run_block(p, a, b, 16);
+
+        UTEST_ASSERT(p.blocks() == BLOCKS);
+        UTEST_ASSERT(p.samples() == BLOCKS * BLOCK_SIZE);
+        UTEST_ASSERT(p.stages() == 2);
+        UTEST_ASSERT(!::strcmp(p.stage_name(0), "copy"));
+        UTEST_ASSERT(!::strcmp(p.stage_name(1), "mul"));
+        UTEST_ASSERT(p.stage_name(2) == NULL);
+
+        float s0 = p.stage_share(0), s1 = p.stage_share(1);
+        printf("Stage shares: copy=%.2f%%, mul=%.2f%%\n", s0 * 100.0f, s1 * 100.0f);
+        UTEST_ASSERT((s0 > 0.0f) && (s1 > 0.0f));
+        UTEST_ASSERT(s0 + s1 <= 1.0f + 1e-5f);
+        UTEST_ASSERT(s1 > s0);
+
+        // Check reset
+        p.reset();
+        UTEST_ASSERT(p.blocks() == 0);
+        UTEST_ASSERT(p.samples() == 0);
+        UTEST_ASSERT(p.stages() == 0);
+    }
+
+    void test_overflow()
+    {
+        static const char *names[] =
+        {
+            "s00", "s01", "s02", "s03", "s04", "s05", "s06", "s07",
+            "s08", "s09", "s10", "s11", "s12", "s13", "s14", "s15",
+            "s16", "s17", "s18", "s19"
+        };
+
+        CpuProfiler p;
+        p.set_enabled(true);
+        p.set_sample_rate(SRATE);
+
+        for (size_t i=0; i<BLOCKS; ++i)
+        {
+            CpuProfiler::Block prof(p, BLOCK_SIZE);
+            for (size_t j=0; j<sizeof(names)/sizeof(const char *); ++j)
+                p.stage(names[j]);
+        }
+
+        UTEST_ASSERT(p.blocks() == BLOCKS);
+        UTEST_ASSERT(p.stages() == CPU_PROFILER_STAGES_MAX);
+    }
+
+    UTEST_MAIN
+    {
+        printf("Tick frequency: %.1f ticks/s\n", CpuProfiler::tick_frequency());
+        UTEST_ASSERT(CpuProfiler::tick_frequency() > 0.0);
+
+        test_disabled();
+        test_stages();
+        test_overflow();
+    }
+
+UTEST_END;
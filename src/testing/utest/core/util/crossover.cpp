@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <test/helpers.h>
+#include <core/util/Crossover.h>
+
+#define SRATE           48000
+#define BANDS           4
+#define FFT_RANK        10
+#define BUF_SIZE        256
+#define SAMPLES         8192
+
+using namespace lsp;
+
+UTEST_BEGIN("core.util", crossover)
+
+    typedef struct band_data_t
+    {
+        float      *out;
+        size_t      offset;
+        size_t      calls;
+    } band_data_t;
+
+    static void process_band(void *object, void *subject, size_t band, const float *data, size_t first, size_t count)
+    {
+        band_data_t *bd     = static_cast<band_data_t *>(subject);
+        dsp::copy(&bd[band].out[bd[band].offset + first], data, count);
+        ++bd[band].calls;
+    }
+
+    void process_chunked(Crossover &xc, band_data_t *bd, const float *src, size_t count)
+    {
+        // Use irregular chunk sizes to check the block boundaries
+        static const size_t chunks[] = { 1, 17, 300, 512, 5, 1000, 64 };
+        for (size_t i=0, off=0; off < count; ++i)
+        {
+            size_t to_do = lsp_min(count - off, chunks[i % (sizeof(chunks)/sizeof(size_t))]);
+            for (size_t j=0, n=xc.num_bands(); j<n; ++j)
+                bd[j].offset    = off;
+            xc.process(&src[off], to_do);
+            off    += to_do;
+        }
+    }
+
+    void test_fft_reconstruction()
+    {
+        FloatBuffer in(SAMPLES);
+        FloatBuffer sum(SAMPLES);
+        FloatBuffer *out[BANDS];
+        band_data_t bd[BANDS];
+
+        in.randomize_sign();
+        sum.fill_zero();
+
+        Crossover xc;
+        UTEST_ASSERT(xc.init(BANDS, BUF_SIZE, FFT_RANK));
+        xc.set_sample_rate(SRATE);
+        xc.set_type(CROSS_TYPE_FFT);
+        UTEST_ASSERT(xc.get_type() == CROSS_TYPE_FFT);
+
+        static const float freqs[] = { 300.0f, 2000.0f, 8000.0f };
+        for (size_t i=0; i<BANDS-1; ++i)
+        {
+            xc.set_frequency(i, freqs[i]);
+            xc.set_slope(i, 2);
+        }
+
+        for (size_t i=0; i<BANDS; ++i)
+        {
+            out[i]          = new FloatBuffer(SAMPLES);
+            out[i]->fill_zero();
+            bd[i].out       = out[i]->data();
+            bd[i].calls     = 0;
+            UTEST_ASSERT(xc.set_handler(i, process_band, NULL, bd));
+        }
+
+        process_chunked(xc, bd, in.data(), SAMPLES);
+
+        // Sum all bands, the result should be the delayed input signal
+        size_t latency  = xc.latency();
+        UTEST_ASSERT(latency == ((3 << FFT_RANK) >> 2));
+        for (size_t i=0; i<BANDS; ++i)
+        {
+            UTEST_ASSERT(bd[i].calls > 0);
+            UTEST_ASSERT(out[i]->valid());
+            dsp::add2(sum.data(), out[i]->data(), SAMPLES);
+        }
+
+        const float *src = in.data();
+        const float *dst = sum.data();
+        for (size_t i=0; i<latency; ++i)
+            UTEST_ASSERT_MSG(float_equals_absolute(dst[i], 0.0f, 1e-5f), "Non-zero sample at index %d: %f", int(i), dst[i]);
+        for (size_t i=latency; i<SAMPLES; ++i)
+            UTEST_ASSERT_MSG(float_equals_absolute(dst[i], src[i-latency], 1e-3f),
+                "Sample mismatch at index %d: %f vs %f", int(i), dst[i], src[i-latency]);
+
+        xc.destroy();
+        for (size_t i=0; i<BANDS; ++i)
+            delete out[i];
+    }
+
+    void test_fft_split()
+    {
+        FloatBuffer in(SAMPLES);
+        FloatBuffer lo(SAMPLES);
+        FloatBuffer hi(SAMPLES);
+        band_data_t bd[2];
+
+        // Generate low-frequency sine wave
+        float *src  = in.data();
+        float w     = 2.0f * M_PI * 100.0f / SRATE;
+        for (size_t i=0; i<SAMPLES; ++i)
+            src[i]      = sinf(w * i);
+        lo.fill_zero();
+        hi.fill_zero();
+
+        Crossover xc;
+        UTEST_ASSERT(xc.init(2, BUF_SIZE, FFT_RANK + 2));
+        xc.set_sample_rate(SRATE);
+        xc.set_type(CROSS_TYPE_FFT);
+        xc.set_frequency(0, 2000.0f);
+        xc.set_slope(0, 4);
+        xc.set_gain(0, 0.5f);
+
+        bd[0].out   = lo.data();
+        bd[0].calls = 0;
+        bd[1].out   = hi.data();
+        bd[1].calls = 0;
+        UTEST_ASSERT(xc.set_handler(0, process_band, NULL, bd));
+        UTEST_ASSERT(xc.set_handler(1, process_band, NULL, bd));
+
+        process_chunked(xc, bd, src, SAMPLES);
+        UTEST_ASSERT(lo.valid());
+        UTEST_ASSERT(hi.valid());
+
+        // The signal should be passed to the low band with the gain applied and delayed,
+        // skip the transient caused by the start of the signal
+        size_t latency  = xc.latency();
+        const float *l  = lo.data();
+        const float *h  = hi.data();
+        for (size_t i=latency*2; i<SAMPLES; ++i)
+        {
+            UTEST_ASSERT_MSG(float_equals_absolute(l[i], 0.5f * src[i-latency], 1e-3f),
+                "Low band mismatch at index %d: %f vs %f", int(i), l[i], 0.5f * src[i-latency]);
+            UTEST_ASSERT_MSG(float_equals_absolute(h[i], 0.0f, 1e-3f),
+                "High band is not silent at index %d: %f", int(i), h[i]);
+        }
+
+        xc.destroy();
+    }
+
+    void test_iir_fallback()
+    {
+        Crossover xc;
+        UTEST_ASSERT(xc.init(2, BUF_SIZE));
+        xc.set_type(CROSS_TYPE_FFT);
+        UTEST_ASSERT(xc.get_type() == CROSS_TYPE_IIR);
+        UTEST_ASSERT(xc.latency() == 0);
+        xc.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        printf("Testing FFT crossover reconstruction...\n");
+        test_fft_reconstruction();
+        printf("Testing FFT crossover band split...\n");
+        test_fft_split();
+        printf("Testing FFT mode without FFT buffers...\n");
+        test_iir_fallback();
+    }
+
+UTEST_END;
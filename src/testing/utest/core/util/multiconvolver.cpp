@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <test/helpers.h>
+#include <core/util/Convolver.h>
+#include <core/util/MultiConvolver.h>
+
+using namespace lsp;
+
+#define SRC_SIZE        0x4000
+#define INPUTS          2
+#define OUTPUTS         2
+
+UTEST_BEGIN("core.util", multiconvolver)
+
+    void test_matrix(size_t rank, size_t step, const size_t *lengths)
+    {
+        Convolver c[INPUTS * OUTPUTS];
+        MultiConvolver mc;
+
+        FloatBuffer *conv[INPUTS * OUTPUTS];
+        const float *cdata[INPUTS * OUTPUTS];
+        size_t clen[INPUTS * OUTPUTS];
+
+        FloatBuffer src0(SRC_SIZE), src1(SRC_SIZE);
+        FloatBuffer tmp(SRC_SIZE);
+        FloatBuffer dst1_0(SRC_SIZE), dst1_1(SRC_SIZE);
+        FloatBuffer dst2_0(SRC_SIZE), dst2_1(SRC_SIZE);
+
+        FloatBuffer *src[INPUTS]    = { &src0, &src1 };
+        FloatBuffer *dst1[OUTPUTS]  = { &dst1_0, &dst1_1 };
+        FloatBuffer *dst2[OUTPUTS]  = { &dst2_0, &dst2_1 };
+
+        printf("Testing %dx%d convolution matrix rank=%d, step=%d...\n", INPUTS, OUTPUTS, int(rank), int(step));
+
+        // Initialize kernels
+        for (size_t k=0; k<INPUTS * OUTPUTS; ++k)
+        {
+            conv[k]     = new FloatBuffer(lsp_max(lengths[k], size_t(1)));
+            conv[k]->randomize(-1.0f, 1.0f);
+            cdata[k]    = (lengths[k] > 0) ? conv[k]->data() : NULL;
+            clen[k]     = lengths[k];
+            if (lengths[k] > 0)
+                UTEST_ASSERT(c[k].init(conv[k]->data(), lengths[k], rank, 0.0f));
+        }
+        UTEST_ASSERT(mc.init(cdata, clen, INPUTS, OUTPUTS, rank, 0.0f));
+
+        // Initialize source data
+        for (size_t i=0; i<INPUTS; ++i)
+            src[i]->randomize(-1.0f, 1.0f);
+        for (size_t j=0; j<OUTPUTS; ++j)
+            dst1[j]->fill_zero();
+
+        // Compute reference output with independent convolvers
+        for (size_t i=0; i<INPUTS; ++i)
+            for (size_t j=0; j<OUTPUTS; ++j)
+            {
+                size_t k = i * OUTPUTS + j;
+                if (lengths[k] <= 0)
+                    continue;
+
+                for (size_t off=0; off<SRC_SIZE; off += step)
+                {
+                    size_t to_do = lsp_min(step, SRC_SIZE - off);
+                    c[k].process(tmp.data(off), src[i]->data(off), to_do);
+                }
+                dsp::add2(dst1[j]->data(), tmp, SRC_SIZE);
+            }
+
+        // Compute output with multi-convolver
+        for (size_t off=0; off<SRC_SIZE; off += step)
+        {
+            size_t to_do = lsp_min(step, SRC_SIZE - off);
+            const float *vs[INPUTS] = { src0.data(off), src1.data(off) };
+            float *vd[OUTPUTS]      = { dst2_0.data(off), dst2_1.data(off) };
+            mc.process(vd, vs, to_do);
+        }
+
+        // Validate buffers
+        for (size_t k=0; k<INPUTS * OUTPUTS; ++k)
+        {
+            UTEST_ASSERT_MSG(conv[k]->valid(), "Convolution buffer %d corrupted", int(k));
+            delete conv[k];
+            c[k].destroy();
+        }
+        mc.destroy();
+
+        for (size_t j=0; j<OUTPUTS; ++j)
+        {
+            UTEST_ASSERT_MSG(dst1[j]->valid(), "Destination buffer 1 corrupted for output %d", int(j));
+            UTEST_ASSERT_MSG(dst2[j]->valid(), "Destination buffer 2 corrupted for output %d", int(j));
+
+            if (!dst2[j]->equals_absolute(*dst1[j], 1e-3))
+            {
+                size_t index = dst2[j]->last_diff();
+                UTEST_FAIL_MSG("Output %d of multi-convolver is invalid, started at sample=%d: %.6f vs %.6f",
+                        int(j), int(index), dst1[j]->get(index), dst2[j]->get(index));
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        static const size_t lengths1[]  = { 4000, 3000, 1000, 2000 };
+        static const size_t lengths2[]  = { 100, 0, 5000, 31 };
+        static const size_t lengths3[]  = { 8000, 8000, 8000, 8000 };
+
+        test_matrix(8, 31, lengths1);
+        test_matrix(10, 256, lengths1);
+        test_matrix(10, 127, lengths2);
+        test_matrix(11, 1000, lengths3);
+        test_matrix(12, 128, lengths2);
+    }
+
+UTEST_END;
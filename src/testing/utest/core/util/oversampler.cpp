@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/FloatBuffer.h>
+#include <core/util/Oversampler.h>
+
+#define SRATE           48000
+#define BUF_SIZE        0x3000
+#define TONE_FREQ       1000.0f
+#define TONE_AMP        0.5f
+#define HF_SRATE        44100
+#define HF_FREQ         20000.0f
+#define HF_LOSS         0.1f            /* Maximum loss of the tone in passband after up- and downsampling (dB) */
+
+using namespace lsp;
+
+UTEST_BEGIN("core.util", oversampler)
+
+    void test_mode(over_mode_t mode, bool linear)
+    {
+        Oversampler os1, os2;
+        FloatBuffer src(BUF_SIZE), dst1(BUF_SIZE), dst2(BUF_SIZE);
+        FloatBuffer tmp(BUF_SIZE * 32);
+
+        UTEST_ASSERT(os1.init());
+        UTEST_ASSERT(os2.init());
+        os1.set_sample_rate(SRATE);
+        os1.set_mode(mode);
+        os2.set_sample_rate(SRATE);
+        os2.set_mode(mode);
+        UTEST_ASSERT(os1.modified());
+        os1.update_settings();
+        os2.update_settings();
+
+        size_t ratio    = os1.get_oversampling();
+        size_t latency  = os1.latency();
+        printf("Testing FIR oversampling mode %d: ratio=%d, latency=%d\n", int(mode), int(ratio), int(latency));
+        UTEST_ASSERT(latency <= os1.max_latency());
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            src[i]      = TONE_AMP * sinf(2.0f * M_PI * TONE_FREQ * i / SRATE);
+        dst1.fill_zero();
+        dst2.fill_zero();
+
+        // Process with variable block sizes
+        for (size_t off=0, step=1; off < BUF_SIZE; step = (step * 7 + 13) % 1000)
+        {
+            size_t to_do = lsp_min(step, BUF_SIZE - off);
+
+            // Combined processing
+            os1.process(dst1.data(off), src.data(off), to_do);
+
+            // Separate processing
+            os2.upsample(tmp, src.data(off), to_do);
+            os2.downsample(dst2.data(off), tmp, to_do);
+
+            off    += to_do;
+        }
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+        UTEST_ASSERT_MSG(tmp.valid(), "Temporary buffer corrupted");
+
+        // Both processing ways should give the same result
+        if (!dst1.equals_absolute(dst2, 1e-5))
+        {
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of process() differs from upsample() + downsample() at sample %d",
+                    int(dst1.last_diff()));
+        }
+
+        // Check the output signal after the transient process
+        float e_max = 0.0f, s_max = 0.0f;
+        for (size_t i=latency + 256; i<BUF_SIZE; ++i)
+        {
+            float s     = src[i - latency];
+            float e     = dst1[i] - s;
+            s_max       = lsp_max(s_max, fabs(dst1[i]));
+            e_max       = lsp_max(e_max, fabs(e));
+        }
+
+        printf("  peak=%.6f, max error=%.6f\n", s_max, e_max);
+        UTEST_ASSERT_MSG(fabs(s_max - TONE_AMP) < 1e-2f, "Invalid amplitude of the output signal: %.6f", s_max);
+        if (linear)
+        {
+            UTEST_ASSERT_MSG(latency == os1.max_latency(), "Invalid latency: %d", int(latency));
+            UTEST_ASSERT_MSG(e_max < 1e-2f, "Output signal does not match delayed input signal: error=%.6f", e_max);
+        }
+        else
+        {
+            UTEST_ASSERT_MSG(latency < os1.max_latency() / 2, "Too large latency: %d", int(latency));
+        }
+
+        os1.destroy();
+        os2.destroy();
+    }
+
+    void test_passband(over_mode_t mode)
+    {
+        Oversampler os;
+        FloatBuffer src(BUF_SIZE), dst(BUF_SIZE);
+        FloatBuffer tmp(BUF_SIZE * 32);
+
+        UTEST_ASSERT(os.init());
+        os.set_sample_rate(HF_SRATE);
+        os.set_mode(mode);
+        os.update_settings();
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            src[i]      = TONE_AMP * sinf(2.0f * M_PI * HF_FREQ * i / HF_SRATE);
+        os.upsample(tmp, src, BUF_SIZE);
+        os.downsample(dst, tmp, BUF_SIZE);
+
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+        UTEST_ASSERT_MSG(tmp.valid(), "Temporary buffer corrupted");
+
+        // Compare RMS of the tone after the transient process
+        size_t first    = os.max_latency() + 256;
+        float s_rms = 0.0f, d_rms = 0.0f;
+        for (size_t i=first; i<BUF_SIZE; ++i)
+        {
+            s_rms      += src[i] * src[i];
+            d_rms      += dst[i] * dst[i];
+        }
+        float loss      = 10.0f * log10f(s_rms / d_rms);
+
+        printf("Testing passband of FIR oversampling mode %d: %.0f Hz at %d Hz, loss=%.3f dB\n",
+                int(mode), HF_FREQ, int(HF_SRATE), loss);
+        UTEST_ASSERT_MSG(fabs(loss) < HF_LOSS, "Too large loss of the signal in the passband: %.3f dB", loss);
+
+        os.destroy();
+    }
+
+    UTEST_MAIN
+    {
+        static const over_mode_t linear[] =
+        {
+            OM_FIR_LINEAR_2X, OM_FIR_LINEAR_3X, OM_FIR_LINEAR_4X, OM_FIR_LINEAR_6X,
+            OM_FIR_LINEAR_8X, OM_FIR_LINEAR_16X, OM_FIR_LINEAR_32X
+        };
+        static const over_mode_t minphase[] =
+        {
+            OM_FIR_MINPHASE_2X, OM_FIR_MINPHASE_3X, OM_FIR_MINPHASE_4X, OM_FIR_MINPHASE_6X,
+            OM_FIR_MINPHASE_8X, OM_FIR_MINPHASE_16X, OM_FIR_MINPHASE_32X
+        };
+
+        for (size_t i=0; i<sizeof(linear)/sizeof(over_mode_t); ++i)
+            test_mode(linear[i], true);
+        for (size_t i=0; i<sizeof(minphase)/sizeof(over_mode_t); ++i)
+            test_mode(minphase[i], false);
+        for (size_t i=0; i<sizeof(linear)/sizeof(over_mode_t); ++i)
+            test_passband(linear[i]);
+        for (size_t i=0; i<sizeof(minphase)/sizeof(over_mode_t); ++i)
+            test_passband(minphase[i]);
+    }
+
+UTEST_END;
@@ -41,6 +41,13 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void convolve(float *dst, const float *src, const float *conv, size_t length, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -132,6 +139,7 @@ UTEST_BEGIN("dsp", convolve)
         IF_ARCH_X86(CALL(sse::convolve, 16));
         IF_ARCH_X86(CALL(avx::convolve, 32));
         IF_ARCH_X86(CALL(avx::convolve_fma3, 32));
+        IF_ARCH_X86_64(CALL(avx512::convolve, 64));
         IF_ARCH_ARM(CALL(neon_d32::convolve, 16));
         IF_ARCH_AARCH64(CALL(asimd::convolve, 16));
     }
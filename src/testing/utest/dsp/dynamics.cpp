@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <test/FloatBuffer.h>
+
+namespace native
+{
+    void dyn_gain_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    void dyn_gain_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    void dyn_curve_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    void dyn_curve_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+}
+
+IF_ARCH_X86_64(
+    namespace avx2
+    {
+        void x64_dyn_gain_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+        void x64_dyn_gain_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+        void x64_dyn_curve_x1(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+        void x64_dyn_curve_x2(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+    }
+)
+
+typedef void (* dyn_func_t)(float *dst, const float *src, const dsp::dyn_knee_t *k, size_t count);
+
+//-----------------------------------------------------------------------------
+// Unit test
+UTEST_BEGIN("dsp", dynamics)
+
+    static void init_knees(dsp::dyn_knee_t *k)
+    {
+        // Downward compressor: threshold -12 dB, ratio 4:1, knee 6 dB
+        float th    = 0.25f;
+        float r     = 0.25f;
+        float lth   = logf(th);
+        k[0].start  = th * 0.5f;
+        k[0].end    = th * 2.0f;
+        k[0].lo[0]  = 0.0f;
+        k[0].lo[1]  = 0.0f;
+        k[0].herm[0]= 0.0f;
+        k[0].herm[1]= 0.5f * (r - 1.0f) / (logf(k[0].end) - logf(k[0].start));
+        k[0].herm[2]= -2.0f * k[0].herm[1] * logf(k[0].start);
+        k[0].herm[3]= k[0].herm[1] * logf(k[0].start) * logf(k[0].start);
+        k[0].hi[0]  = r - 1.0f;
+        k[0].hi[1]  = (1.0f - r) * lth;
+
+        // Gate: zone -48 dB .. -36 dB, reduction -24 dB, smooth cubic transition
+        // g = red * (1 - 3*t^2 + 2*t^3), t = (lx - ln(zs)) / (ln(ze) - ln(zs))
+        float zs    = 0.004f, ze = 0.016f;
+        float a     = logf(zs);
+        float d     = logf(ze) - a;
+        float red   = logf(0.063f);
+        float c3    = 2.0f * red / (d*d*d);
+        k[1].start  = zs;
+        k[1].end    = ze;
+        k[1].lo[0]  = 0.0f;
+        k[1].lo[1]  = red;
+        k[1].herm[0]= c3;
+        k[1].herm[1]= -3.0f * red / (d*d) - 3.0f * a * c3;
+        k[1].herm[2]= 6.0f * red * a / (d*d) + 3.0f * a * a * c3;
+        k[1].herm[3]= red - 3.0f * red * a * a / (d*d) - a * a * a * c3;
+        k[1].hi[0]  = 0.0f;
+        k[1].hi[1]  = 0.0f;
+    }
+
+    void call(const char *label, size_t align, dyn_func_t ref, dyn_func_t func, size_t knees)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        dsp::dyn_knee_t k[2];
+        init_knees(k);
+
+        UTEST_FOREACH(count, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                32, 64, 65, 100, 999, 0xfff)
+        {
+            for (size_t mask=0; mask <= 0x03; ++mask)
+            {
+                for (size_t i=0; i<knees; ++i)
+                {
+                    printf("Testing %s on input buffer of %d numbers, knee=%d, mask=0x%x...\n",
+                            label, int(count), int(i), int(mask));
+
+                    FloatBuffer src(count, align, mask & 0x01);
+                    src.randomize(-2.0f, 2.0f);
+                    if (count > 0)
+                        src[0]      = 0.0f;
+                    for (size_t j=1; j<count; j += 3)
+                        src[j]     *= 0.01f;
+
+                    FloatBuffer dst1(count, align, mask & 0x02);
+                    FloatBuffer dst2(dst1);
+
+                    // Call functions
+                    ref(dst1, src, &k[i], count);
+                    func(dst2, src, &k[i], count);
+
+                    UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+                    UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+                    UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+                    // Compare buffers
+                    if (!dst1.equals_adaptive(dst2, 1e-4))
+                    {
+                        src.dump("src ");
+                        dst1.dump("dst1");
+                        dst2.dump("dst2");
+                        UTEST_FAIL_MSG("Output of functions for test '%s' differs", label);
+                    }
+
+                    // Dual-knee functions use both knees at once
+                    if (knees > 1)
+                        break;
+                }
+            }
+        }
+    }
+
+    void check_native()
+    {
+        dsp::dyn_knee_t k[2];
+        init_knees(k);
+
+        float src[6]    = { 0.0f, 0.01f, 0.1f, 0.25f, 1.0f, -1.0f };
+        float dst[6];
+
+        // Below the knee the gain is not changed, above the knee it follows the ratio
+        native::dyn_gain_x1(dst, src, &k[0], 6);
+        UTEST_ASSERT(float_equals_relative(dst[0], 1.0f));
+        UTEST_ASSERT(float_equals_relative(dst[1], 1.0f));
+        UTEST_ASSERT(float_equals_relative(dst[2], 1.0f));
+        UTEST_ASSERT(float_equals_relative(dst[4], powf(4.0f, -0.75f), 1e-4f));
+        UTEST_ASSERT(float_equals_relative(dst[5], dst[4]));
+
+        // Curve is input level multiplied by gain
+        native::dyn_curve_x1(dst, src, &k[0], 6);
+        UTEST_ASSERT(float_equals_relative(dst[4], powf(4.0f, -0.75f), 1e-4f));
+
+        // Gate reduces quiet signals and passes loud ones
+        native::dyn_gain_x1(dst, src, &k[1], 6);
+        UTEST_ASSERT(float_equals_relative(dst[0], 0.063f, 1e-4f));
+        UTEST_ASSERT(float_equals_relative(dst[4], 1.0f));
+
+        // Dual knee multiplies both gains
+        native::dyn_gain_x2(dst, src, k, 6);
+        UTEST_ASSERT(float_equals_relative(dst[0], 0.063f, 1e-4f));
+        UTEST_ASSERT(float_equals_relative(dst[4], powf(4.0f, -0.75f), 1e-4f));
+    }
+
+    UTEST_MAIN
+    {
+        check_native();
+
+        #define CALL(ref, func, align, knees) \
+            call(#func, align, ref, func, knees)
+
+        IF_ARCH_X86_64(CALL(native::dyn_gain_x1, avx2::x64_dyn_gain_x1, 32, 1));
+        IF_ARCH_X86_64(CALL(native::dyn_gain_x2, avx2::x64_dyn_gain_x2, 32, 2));
+        IF_ARCH_X86_64(CALL(native::dyn_curve_x1, avx2::x64_dyn_curve_x1, 32, 1));
+        IF_ARCH_X86_64(CALL(native::dyn_curve_x2, avx2::x64_dyn_curve_x2, 32, 2));
+    }
+UTEST_END
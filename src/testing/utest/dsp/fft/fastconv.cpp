@@ -33,6 +33,7 @@ namespace native
     void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
     void fastconv_restore(float *dst, float *src, size_t rank);
     void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+    void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank);
 }
 
 IF_ARCH_X86(
@@ -42,6 +43,7 @@ IF_ARCH_X86(
         void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
         void fastconv_restore(float *dst, float *src, size_t rank);
         void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank);
     }
 
     namespace avx
@@ -50,11 +52,24 @@ IF_ARCH_X86(
         void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
         void fastconv_restore(float *dst, float *src, size_t rank);
         void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank);
 
         void fastconv_parse_fma3(float *dst, const float *src, size_t rank);
         void fastconv_parse_apply_fma3(float *dst, float *tmp, const float *c, const float *src, size_t rank);
         void fastconv_restore_fma3(float *dst, float *src, size_t rank);
         void fastconv_apply_fma3(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_fmadd_fma3(float *dst, const float *c1, const float *c2, size_t rank);
+    }
+)
+
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void fastconv_parse(float *dst, const float *src, size_t rank);
+        void fastconv_parse_apply(float *dst, float *tmp, const float *c, const float *src, size_t rank);
+        void fastconv_restore(float *dst, float *src, size_t rank);
+        void fastconv_apply(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
+        void fastconv_fmadd(float *dst, const float *c1, const float *c2, size_t rank);
     }
 )
 
@@ -86,6 +101,8 @@ typedef void (* fastconv_restore_t)(float *dst, float *src, size_t rank);
 
 typedef void (* fastconv_apply_t)(float *dst, float *tmp, const float *c1, const float *c2, size_t rank);
 
+typedef void (* fastconv_fmadd_t)(float *dst, const float *c1, const float *c2, size_t rank);
+
 UTEST_BEGIN("dsp.fft", fastconv)
 
     // This is long-time test, raise time limit for it to one second
@@ -293,26 +310,110 @@ UTEST_BEGIN("dsp.fft", fastconv)
         }
     }
 
+    void call_fmadd(const char *label, size_t align,
+            fastconv_parse_t parse,
+            fastconv_fmadd_t fmadd,
+            fastconv_restore_t restore
+        )
+    {
+        if (!UTEST_SUPPORTED(parse))
+            return;
+        if (!UTEST_SUPPORTED(fmadd))
+            return;
+        if (!UTEST_SUPPORTED(restore))
+            return;
+
+        for (size_t rank=MIN_RANK; rank<=MAX_RANK; rank ++)
+        {
+            for (size_t mask=0; mask <= 0x0f; ++mask)
+            {
+                printf("Testing '%s' for FFT rank=%d, mask=0x%x\n", label, rank, mask);
+
+                FloatBuffer src1(1 << (rank-1), align, mask & 0x01);
+                FloatBuffer src2(1 << (rank-1), align, mask & 0x01);
+                FloatBuffer src3(1 << (rank-1), align, mask & 0x01);
+                FloatBuffer fa1(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer fa2(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer fb1(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer fb2(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer fc1(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer fc2(1 << (rank+1), align, mask & 0x02);
+                FloatBuffer acc(1 << (rank+1), align, mask & 0x04);
+                FloatBuffer tmp(1 << (rank+1), align, mask & 0x04);
+                FloatBuffer dst1(1 << rank, align, mask & 0x08);
+                FloatBuffer dst2(1 << rank, align, mask & 0x08);
+
+                // Reference: two independent convolutions with one shared input
+                native::fastconv_parse(fa1, src1, rank);
+                native::fastconv_parse(fb1, src2, rank);
+                native::fastconv_parse(fc1, src3, rank);
+                dsp::fill_zero(dst1, dst1.size());
+                native::fastconv_apply(dst1, tmp, fa1, fb1, rank);
+                native::fastconv_apply(dst1, tmp, fa1, fc1, rank);
+                UTEST_ASSERT_MSG(dst1.valid(), "Buffer DST1 corrupted");
+
+                // Accumulate convolutions and restore once
+                parse(fa2, src1, rank);
+                parse(fb2, src2, rank);
+                parse(fc2, src3, rank);
+                dsp::fill_zero(acc, acc.size());
+                fmadd(acc, fa2, fb2, rank);
+                fmadd(acc, fa2, fc2, rank);
+                UTEST_ASSERT_MSG(acc.valid(), "Buffer ACC corrupted");
+                UTEST_ASSERT_MSG(fa2.valid(), "Buffer FA2 corrupted");
+                UTEST_ASSERT_MSG(fb2.valid(), "Buffer FB2 corrupted");
+                UTEST_ASSERT_MSG(fc2.valid(), "Buffer FC2 corrupted");
+                restore(dst2, acc, rank);
+                UTEST_ASSERT_MSG(dst2.valid(), "Buffer DST2 corrupted");
+
+                // Compare buffers
+                if (!dst1.equals_adaptive(dst2, TOLERANCE))
+                {
+                    src1.dump("src1");
+                    src2.dump("src2");
+                    src3.dump("src3");
+                    dst1.dump("dst1");
+                    dst2.dump("dst2");
+
+                    ssize_t diff = dst2.last_diff();
+                    UTEST_FAIL_MSG("DST1 differs DST2 for test '%s' at sample %d (%.5f vs %.5f), rank=%d",
+                            label, int(diff), dst1.get(diff), dst2.get(diff), int(rank));
+                }
+            }
+        }
+    }
+
     UTEST_MAIN
     {
         // Do tests
         IF_ARCH_X86(call_pr("sse::fastconv_parse + sse::fastconv_restore", 16, sse::fastconv_parse, sse::fastconv_restore));
         IF_ARCH_X86(call_pr("avx::fastconv_parse + avx::fastconv_restore", 32, avx::fastconv_parse, avx::fastconv_restore));
         IF_ARCH_X86(call_pr("avx::fastconv_parse_fma3 + avx::fastconv_restore_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_restore_fma3));
+        IF_ARCH_X86_64(call_pr("avx512::fastconv_parse + avx512::fastconv_restore", 64, avx512::fastconv_parse, avx512::fastconv_restore));
         IF_ARCH_ARM(call_pr("neon_d32::fastconv_parse + neon_d32::fastconv_restore", 16, neon_d32::fastconv_parse, neon_d32::fastconv_restore));
         IF_ARCH_AARCH64(call_pr("asimd::fastconv_parse + asimd::fastconv_restore", 16, asimd::fastconv_parse, asimd::fastconv_restore));
 
         IF_ARCH_X86(call_pa("sse::fastconv_parse + sse::fastconv_apply", 16, sse::fastconv_parse, sse::fastconv_apply));
         IF_ARCH_X86(call_pa("avx::fastconv_parse + avx::fastconv_apply", 32, avx::fastconv_parse, avx::fastconv_apply));
         IF_ARCH_X86(call_pa("avx::fastconv_parse_fma3 + avx::fastconv_apply_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_apply_fma3));
+        IF_ARCH_X86_64(call_pa("avx512::fastconv_parse + avx512::fastconv_apply", 64, avx512::fastconv_parse, avx512::fastconv_apply));
         IF_ARCH_ARM(call_pa("neon_d32::fastconv_parse + neon_d32::fastconv_apply", 16, neon_d32::fastconv_parse, neon_d32::fastconv_apply));
         IF_ARCH_AARCH64(call_pa("asimd::fastconv_parse + asimd::fastconv_apply", 16, asimd::fastconv_parse, asimd::fastconv_apply));
 
         IF_ARCH_X86(call_pap("sse::fastconv_parse + sse::fastconv_parse_apply", 16, sse::fastconv_parse, sse::fastconv_parse_apply));
         IF_ARCH_X86(call_pap("avx::fastconv_parse + avx::fastconv_parse_apply", 32, avx::fastconv_parse, avx::fastconv_parse_apply));
         IF_ARCH_X86(call_pap("avx::fastconv_parse_fma3 + avx::fastconv_parse_apply_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_parse_apply_fma3));
+        IF_ARCH_X86_64(call_pap("avx512::fastconv_parse + avx512::fastconv_parse_apply", 64, avx512::fastconv_parse, avx512::fastconv_parse_apply));
         IF_ARCH_ARM(call_pap("neon_d32::fastconv_parse + neon_d32::fastconv_parse_apply", 16, neon_d32::fastconv_parse, neon_d32::fastconv_parse_apply));
         IF_ARCH_AARCH64(call_pap("asimd::fastconv_parse + asimd::fastconv_parse_apply", 16, asimd::fastconv_parse, asimd::fastconv_parse_apply));
+
+        call_fmadd("native::fastconv_fmadd", 16, native::fastconv_parse, native::fastconv_fmadd, native::fastconv_restore);
+        IF_ARCH_X86(call_fmadd("sse::fastconv_fmadd", 16, sse::fastconv_parse, sse::fastconv_fmadd, sse::fastconv_restore));
+        IF_ARCH_X86(call_fmadd("avx::fastconv_fmadd", 32, avx::fastconv_parse, avx::fastconv_fmadd, avx::fastconv_restore));
+        IF_ARCH_X86(call_fmadd("avx::fastconv_fmadd_fma3", 32, avx::fastconv_parse_fma3, avx::fastconv_fmadd_fma3, avx::fastconv_restore_fma3));
+        IF_ARCH_X86_64(call_fmadd("avx512::fastconv_fmadd", 64, avx512::fastconv_parse, avx512::fastconv_fmadd, avx512::fastconv_restore));
+        IF_ARCH_ARM(call_fmadd("neon_d32::fastconv_fmadd", 16, neon_d32::fastconv_parse, native::fastconv_fmadd, neon_d32::fastconv_restore));
+        IF_ARCH_AARCH64(call_fmadd("asimd::fastconv_fmadd", 16, asimd::fastconv_parse, native::fastconv_fmadd, asimd::fastconv_restore));
     }
 UTEST_END;
 
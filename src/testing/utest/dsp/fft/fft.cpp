@@ -48,6 +48,14 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void direct_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+        void reverse_fft(float *dst_re, float *dst_im, const float *src_re, const float *src_im, size_t rank);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -157,6 +165,9 @@ UTEST_BEGIN("dsp.fft", fft)
         IF_ARCH_X86(CALL(native::direct_fft, avx::direct_fft_fma3, 32));
         IF_ARCH_X86(CALL(native::reverse_fft, avx::reverse_fft_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::direct_fft, avx512::direct_fft, 64));
+        IF_ARCH_X86_64(CALL(native::reverse_fft, avx512::reverse_fft, 64));
+
         IF_ARCH_ARM(CALL(native::direct_fft, neon_d32::direct_fft, 16));
         IF_ARCH_ARM(CALL(native::reverse_fft, neon_d32::reverse_fft, 16));
 
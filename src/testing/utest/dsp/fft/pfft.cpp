@@ -48,6 +48,14 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void packed_direct_fft(float *dst, const float *src, size_t rank);
+        void packed_reverse_fft(float *dst, const float *src, size_t rank);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -133,6 +141,9 @@ UTEST_BEGIN("dsp.fft", pfft)
         IF_ARCH_X86(CALL(native::packed_direct_fft, avx::packed_direct_fft_fma3, 32));
         IF_ARCH_X86(CALL(native::packed_reverse_fft, avx::packed_reverse_fft_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::packed_direct_fft, avx512::packed_direct_fft, 64));
+        IF_ARCH_X86_64(CALL(native::packed_reverse_fft, avx512::packed_reverse_fft, 64));
+
         IF_ARCH_ARM(CALL(native::packed_direct_fft, neon_d32::packed_direct_fft, 16));
         IF_ARCH_ARM(CALL(native::packed_reverse_fft, neon_d32::packed_reverse_fft, 16));
 
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <test/FloatBuffer.h>
+
+#define BUF_SIZE        1024
+#define BUF_STEP        37
+#define TOLERANCE       1e-4f
+
+namespace native
+{
+    void biquad_process_x1(float *dst, const float *src, size_t count, biquad_t *f);
+    void bilinear_transform_x1(biquad_x1_t *bf, const f_cascade_t *bc, float kf, size_t count);
+
+    void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f);
+}
+
+IF_ARCH_X86(
+    namespace sse
+    {
+        void biquad_process_c2(float *dst, const float *src, size_t count, biquad_t *f);
+    }
+)
+
+typedef void (* biquad_process_t)(float *dst, const float *src, size_t count, biquad_t *f);
+
+UTEST_BEGIN("dsp.filters", multichannel)
+
+    /**
+     * Build the same two-stage filter for each channel but with different
+     * frequency shift coefficient
+     */
+    void init_cascades(f_cascade_t *bc, float *kf, size_t lanes)
+    {
+        for (size_t i=0; i<lanes; ++i)
+        {
+            kf[i]           = 1.0f / tanf(M_PI * (100.0f + 1000.0f * i) / 48000.0f);
+
+            // Stage 0: second-order lo-pass
+            f_cascade_t *c  = &bc[i];
+            c->t[0] = 1.0f;     c->t[1] = 0.0f;         c->t[2] = 0.0f;     c->t[3] = 0.0f;
+            c->b[0] = 1.0f;     c->b[1] = M_SQRT2;      c->b[2] = 1.0f;     c->b[3] = 0.0f;
+
+            // Stage 1: second-order shelving
+            c               = &bc[lanes + i];
+            c->t[0] = 1.0f;     c->t[1] = 0.5f + i*0.1f;c->t[2] = 1.0f;     c->t[3] = 0.0f;
+            c->b[0] = 1.0f;     c->b[1] = 1.5f;         c->b[2] = 1.0f;     c->b[3] = 0.0f;
+        }
+    }
+
+    void call(const char *label, size_t lanes, biquad_process_t process)
+    {
+        if (!UTEST_SUPPORTED(process))
+            return;
+
+        printf("Testing %s on %d channels...\n", label, int(lanes));
+
+        f_cascade_t bc[16] __lsp_aligned64;
+        float kf[8];
+        biquad_t fc[2] __lsp_aligned64;
+        biquad_t fx[16] __lsp_aligned64;
+
+        init_cascades(bc, kf, lanes);
+
+        // Per-channel reference filters
+        for (size_t i=0; i<lanes; ++i)
+        {
+            native::bilinear_transform_x1(&fx[i].x1, &bc[i], kf[i], 1);
+            native::bilinear_transform_x1(&fx[lanes + i].x1, &bc[lanes + i], kf[i], 1);
+            dsp::fill_zero(fx[i].d, BIQUAD_D_ITEMS);
+            dsp::fill_zero(fx[lanes + i].d, BIQUAD_D_ITEMS);
+        }
+
+        // Multichannel filters, each row of cascades is stored in it's own bank,
+        // lane i of the bank holds coefficients of channel i
+        for (size_t j=0; j<2; ++j)
+        {
+            float *c        = &fc[j].x1.b0;
+            dsp::fill_zero(fc[j].d, BIQUAD_D_ITEMS);
+            dsp::fill_zero(c, lanes * 6);
+
+            for (size_t i=0; i<lanes; ++i)
+            {
+                const biquad_x1_t *x = &fx[j*lanes + i].x1;
+                c[i]            = x->b0;
+                c[lanes + i]    = x->b1;
+                c[lanes*2 + i]  = x->b2;
+                c[lanes*3 + i]  = x->a1;
+                c[lanes*4 + i]  = x->a2;
+            }
+        }
+
+        // Prepare data
+        FloatBuffer src(BUF_SIZE * lanes);
+        FloatBuffer dst1(BUF_SIZE * lanes);
+        FloatBuffer dst2(BUF_SIZE * lanes);
+        FloatBuffer ch_in(BUF_SIZE);
+        FloatBuffer ch_out(BUF_SIZE);
+        src.randomize_sign();
+
+        // Reference: process each channel separately
+        for (size_t i=0; i<lanes; ++i)
+        {
+            for (size_t k=0; k<BUF_SIZE; ++k)
+                ch_in[k]        = src[k*lanes + i];
+            native::biquad_process_x1(ch_out, ch_in, BUF_SIZE, &fx[i]);
+            native::biquad_process_x1(ch_out, ch_out, BUF_SIZE, &fx[lanes + i]);
+            for (size_t k=0; k<BUF_SIZE; ++k)
+                dst1[k*lanes + i] = ch_out[k];
+        }
+
+        // Multichannel processing, split into blocks to check the filter memory
+        for (size_t k=0; k<BUF_SIZE; k += BUF_STEP)
+        {
+            size_t count = BUF_SIZE - k;
+            if (count > BUF_STEP)
+                count = BUF_STEP;
+            process(dst2.data(k * lanes), src.data(k * lanes), count, &fc[0]);
+            process(dst2.data(k * lanes), dst2.data(k * lanes), count, &fc[1]);
+        }
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+        UTEST_ASSERT_MSG(ch_in.valid(), "Channel input buffer corrupted");
+        UTEST_ASSERT_MSG(ch_out.valid(), "Channel output buffer corrupted");
+
+        if (!dst1.equals_adaptive(dst2, TOLERANCE))
+        {
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(dst1.last_diff()), dst1.get_diff(), dst2.get_diff());
+        }
+
+        // Validate the filter memory
+        for (size_t i=0; i<lanes; ++i)
+        {
+            for (size_t j=0; j<2; ++j)
+            {
+                const biquad_t *x = &fx[j*lanes + i];
+                const biquad_t *c = &fc[j];
+                UTEST_ASSERT_MSG(float_equals_adaptive(x->d[0], c->d[i], TOLERANCE),
+                        "Filter memory d0 of stage %d for channel %d differs: %.6f vs %.6f",
+                        int(j), int(i), x->d[0], c->d[i]);
+                UTEST_ASSERT_MSG(float_equals_adaptive(x->d[1], c->d[lanes + i], TOLERANCE),
+                        "Filter memory d1 of stage %d for channel %d differs: %.6f vs %.6f",
+                        int(j), int(i), x->d[1], c->d[lanes + i]);
+            }
+        }
+    }
+
+    UTEST_MAIN
+    {
+        #define CALL(process, lanes) \
+            call(#process, lanes, process)
+
+        CALL(native::biquad_process_c2, 2);
+        IF_ARCH_X86(CALL(sse::biquad_process_c2, 2));
+
+        #undef CALL
+    }
+
+UTEST_END;
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2020 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2020 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins
+ * Created on: 18 окт. 2020 г.
+ *
+ * lsp-plugins is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <dsp/dsp.h>
+#include <test/utest.h>
+#include <test/helpers.h>
+#include <test/FloatBuffer.h>
+
+#define BUF_SIZE        1024
+#define BUF_STEP        37
+#define TOLERANCE       1e-5f
+
+namespace native
+{
+    void biquad_process_dx1(float *dst, const float *src, size_t count, biquad_d_t *f);
+    void biquad_process_dx2(float *dst, const float *src, size_t count, biquad_d_t *f);
+    void dyn_biquad_process_dx1(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f);
+    void bilinear_transform_dx1(biquad_dx1_t *bf, const f_cascade_t *bc, double kf, size_t count);
+}
+
+IF_ARCH_X86(
+    namespace sse2
+    {
+        void biquad_process_dx1(float *dst, const float *src, size_t count, biquad_d_t *f);
+        void biquad_process_dx2(float *dst, const float *src, size_t count, biquad_d_t *f);
+        void dyn_biquad_process_dx1(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f);
+    }
+)
+
+typedef void (* biquad_process_dx_t)(float *dst, const float *src, size_t count, biquad_d_t *f);
+typedef void (* dyn_biquad_process_dx_t)(float *dst, const float *src, double *d, size_t count, const biquad_dx1_t *f);
+
+UTEST_BEGIN("dsp.filters", precise)
+
+    /**
+     * Two low-frequency cascades at high sample rate: the case where
+     * single-precision coefficients lose most of their significant bits
+     */
+    void init_cascades(f_cascade_t *bc, double &kf)
+    {
+        kf              = 1.0 / tan(M_PI * 10.0 / 192000.0);
+
+        // Stage 0: second-order lo-pass
+        f_cascade_t *c  = &bc[0];
+        c->t[0] = 1.0f;     c->t[1] = 0.0f;         c->t[2] = 0.0f;     c->t[3] = 0.0f;
+        c->b[0] = 1.0f;     c->b[1] = M_SQRT2;      c->b[2] = 1.0f;     c->b[3] = 0.0f;
+
+        // Stage 1: second-order shelving
+        c               = &bc[1];
+        c->t[0] = 1.0f;     c->t[1] = 0.5f;         c->t[2] = 1.0f;     c->t[3] = 0.0f;
+        c->b[0] = 1.0f;     c->b[1] = 1.5f;         c->b[2] = 1.0f;     c->b[3] = 0.0f;
+    }
+
+    void init_filter(biquad_d_t *f)
+    {
+        for (size_t i=0; i<BIQUAD_DD_ITEMS; ++i)
+            f->d[i]     = 0.0;
+    }
+
+    void reference(double *dst, const float *src, size_t count, const biquad_dx1_t *c, double *d)
+    {
+        for (size_t i=0; i<count; ++i)
+        {
+            double s    = src[i];
+            double s2   = c->b0*s + d[0];
+            d[0]        = d[1] + c->b1*s + c->a1*s2;
+            d[1]        = c->b2*s + c->a2*s2;
+            dst[i]      = s2;
+        }
+    }
+
+    void test_reference()
+    {
+        f_cascade_t bc[2] __lsp_aligned64;
+        biquad_d_t f __lsp_aligned64;
+        double kf, d[2];
+
+        init_cascades(bc, kf);
+        init_filter(&f);
+        native::bilinear_transform_dx1(&f.x1, bc, kf, 1);
+
+        // DC gain of the lo-pass cascade should be unity
+        double gain = (f.x1.b0 + f.x1.b1 + f.x1.b2) / (1.0 - f.x1.a1 - f.x1.a2);
+        UTEST_ASSERT_MSG(fabs(gain - 1.0) < 1e-6, "Invalid DC gain of double-precision filter: %.10f", gain);
+
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst(BUF_SIZE);
+        double *out = new double[BUF_SIZE];
+        UTEST_ASSERT(out != NULL);
+        src.randomize_sign();
+
+        d[0]    = 0.0;
+        d[1]    = 0.0;
+        reference(out, src, BUF_SIZE, &f.x1, d);
+        native::biquad_process_dx1(dst, src, BUF_SIZE, &f);
+
+        for (size_t i=0; i<BUF_SIZE; ++i)
+        {
+            if (!float_equals_adaptive(dst[i], out[i], TOLERANCE))
+            {
+                float v = out[i];
+                delete [] out;
+                UTEST_FAIL_MSG("Output differs from double-precision reference at sample %d: %.8f vs %.8f",
+                        int(i), dst[i], v);
+            }
+        }
+        delete [] out;
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst.valid(), "Destination buffer corrupted");
+    }
+
+    void call(const char *label, biquad_process_dx_t func, size_t stages)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        printf("Testing %s...\n", label);
+
+        f_cascade_t bc[2] __lsp_aligned64;
+        biquad_d_t f1[2] __lsp_aligned64;
+        biquad_d_t f2 __lsp_aligned64;
+        double kf;
+
+        init_cascades(bc, kf);
+        init_filter(&f2);
+
+        // Reference: each stage is processed by it's own dx1 filter
+        for (size_t i=0; i<stages; ++i)
+        {
+            init_filter(&f1[i]);
+            native::bilinear_transform_dx1(&f1[i].x1, &bc[i], kf, 1);
+        }
+
+        // Tested filter
+        if (stages == 1)
+            f2.x1   = f1[0].x1;
+        else
+        {
+            f2.x2.b0[0] = f1[0].x1.b0;  f2.x2.b0[1] = f1[1].x1.b0;
+            f2.x2.b1[0] = f1[0].x1.b1;  f2.x2.b1[1] = f1[1].x1.b1;
+            f2.x2.b2[0] = f1[0].x1.b2;  f2.x2.b2[1] = f1[1].x1.b2;
+            f2.x2.a1[0] = f1[0].x1.a1;  f2.x2.a1[1] = f1[1].x1.a1;
+            f2.x2.a2[0] = f1[0].x1.a2;  f2.x2.a2[1] = f1[1].x1.a2;
+            f2.x2.p[0]  = 0.0;          f2.x2.p[1]  = 0.0;
+        }
+
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        src.randomize_sign();
+
+        native::biquad_process_dx1(dst1, src, BUF_SIZE, &f1[0]);
+        if (stages > 1)
+            native::biquad_process_dx1(dst1, dst1, BUF_SIZE, &f1[1]);
+
+        // Split into blocks to check the filter memory
+        for (size_t k=0; k<BUF_SIZE; k += BUF_STEP)
+        {
+            size_t count = BUF_SIZE - k;
+            if (count > BUF_STEP)
+                count = BUF_STEP;
+            func(dst2.data(k), src.data(k), count, &f2);
+        }
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        if (!dst1.equals_adaptive(dst2, TOLERANCE))
+        {
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(dst1.last_diff()), dst1.get_diff(), dst2.get_diff());
+        }
+
+        // Validate the filter memory
+        for (size_t i=0; i<stages; ++i)
+        {
+            for (size_t j=0; j<2; ++j)
+            {
+                double v1 = f1[i].d[j];
+                double v2 = f2.d[j*stages + i];
+                UTEST_ASSERT_MSG(float_equals_adaptive(v1, v2, TOLERANCE),
+                        "Filter memory d%d of stage %d differs: %.8f vs %.8f",
+                        int(j), int(i), v1, v2);
+            }
+        }
+    }
+
+    void call(const char *label, dyn_biquad_process_dx_t func)
+    {
+        if (!UTEST_SUPPORTED(func))
+            return;
+
+        printf("Testing %s...\n", label);
+
+        f_cascade_t bc[2] __lsp_aligned64;
+        double d1[2], d2[2], kf;
+        init_cascades(bc, kf);
+
+        biquad_dx1_t *f = new biquad_dx1_t[BUF_SIZE];
+        UTEST_ASSERT(f != NULL);
+
+        // Sweep the cut-off frequency of the filter
+        for (size_t i=0; i<BUF_SIZE; ++i)
+            native::bilinear_transform_dx1(&f[i], &bc[0], kf / (1.0 + i * 0.01), 1);
+
+        FloatBuffer src(BUF_SIZE);
+        FloatBuffer dst1(BUF_SIZE);
+        FloatBuffer dst2(BUF_SIZE);
+        src.randomize_sign();
+
+        d1[0] = 0.0; d1[1] = 0.0;
+        d2[0] = 0.0; d2[1] = 0.0;
+        native::dyn_biquad_process_dx1(dst1, src, d1, BUF_SIZE, f);
+        for (size_t k=0; k<BUF_SIZE; k += BUF_STEP)
+        {
+            size_t count = BUF_SIZE - k;
+            if (count > BUF_STEP)
+                count = BUF_STEP;
+            func(dst2.data(k), src.data(k), d2, count, &f[k]);
+        }
+        delete [] f;
+
+        UTEST_ASSERT_MSG(src.valid(), "Source buffer corrupted");
+        UTEST_ASSERT_MSG(dst1.valid(), "Destination buffer 1 corrupted");
+        UTEST_ASSERT_MSG(dst2.valid(), "Destination buffer 2 corrupted");
+
+        if (!dst1.equals_adaptive(dst2, TOLERANCE))
+        {
+            dst1.dump("dst1");
+            dst2.dump("dst2");
+            UTEST_FAIL_MSG("Output of functions for test '%s' differs at sample %d: %.6f vs %.6f",
+                    label, int(dst1.last_diff()), dst1.get_diff(), dst2.get_diff());
+        }
+
+        UTEST_ASSERT_MSG(float_equals_adaptive(d1[0], d2[0], TOLERANCE), "Filter memory d0 differs");
+        UTEST_ASSERT_MSG(float_equals_adaptive(d1[1], d2[1], TOLERANCE), "Filter memory d1 differs");
+    }
+
+    UTEST_MAIN
+    {
+        test_reference();
+
+        call("native::biquad_process_dx2", native::biquad_process_dx2, 2);
+        IF_ARCH_X86(call("sse2::biquad_process_dx1", sse2::biquad_process_dx1, 1));
+        IF_ARCH_X86(call("sse2::biquad_process_dx2", sse2::biquad_process_dx2, 2));
+        IF_ARCH_X86(call("sse2::dyn_biquad_process_dx1", sse2::dyn_biquad_process_dx1));
+    }
+
+UTEST_END;
@@ -75,6 +75,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd3(float *dst, const float *a, const float *b, size_t count);
+        void    fmsub3(float *dst, const float *a, const float *b, size_t count);
+        void    fmrsub3(float *dst, const float *a, const float *b, size_t count);
+        void    fmmul3(float *dst, const float *a, const float *b, size_t count);
+        void    fmdiv3(float *dst, const float *a, const float *b, size_t count);
+        void    fmrdiv3(float *dst, const float *a, const float *b, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -180,6 +192,13 @@ UTEST_BEGIN("dsp.pmath", fmop3)
         IF_ARCH_X86(CALL(native::fmmod3, avx::fmmod3_fma3, 32));
         IF_ARCH_X86(CALL(native::fmrmod3, avx::fmrmod3_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::fmadd3, avx512::fmadd3, 64));
+        IF_ARCH_X86_64(CALL(native::fmsub3, avx512::fmsub3, 64));
+        IF_ARCH_X86_64(CALL(native::fmrsub3, avx512::fmrsub3, 64));
+        IF_ARCH_X86_64(CALL(native::fmmul3, avx512::fmmul3, 64));
+        IF_ARCH_X86_64(CALL(native::fmdiv3, avx512::fmdiv3, 64));
+        IF_ARCH_X86_64(CALL(native::fmrdiv3, avx512::fmrdiv3, 64));
+
         IF_ARCH_ARM(CALL(native::fmadd3, neon_d32::fmadd3, 16));
         IF_ARCH_ARM(CALL(native::fmsub3, neon_d32::fmsub3, 16));
         IF_ARCH_ARM(CALL(native::fmrsub3, neon_d32::fmrsub3, 16));
@@ -76,6 +76,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmsub4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmrsub4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmmul4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmdiv4(float *dst, const float *a, const float *b, const float *c, size_t count);
+        void    fmrdiv4(float *dst, const float *a, const float *b, const float *c, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -182,6 +194,13 @@ UTEST_BEGIN("dsp.pmath", fmop4)
         IF_ARCH_X86(CALL(native::fmmod4, avx::fmmod4_fma3, 32));
         IF_ARCH_X86(CALL(native::fmrmod4, avx::fmrmod4_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::fmadd4, avx512::fmadd4, 64));
+        IF_ARCH_X86_64(CALL(native::fmsub4, avx512::fmsub4, 64));
+        IF_ARCH_X86_64(CALL(native::fmrsub4, avx512::fmrsub4, 64));
+        IF_ARCH_X86_64(CALL(native::fmmul4, avx512::fmmul4, 64));
+        IF_ARCH_X86_64(CALL(native::fmdiv4, avx512::fmdiv4, 64));
+        IF_ARCH_X86_64(CALL(native::fmrdiv4, avx512::fmrdiv4, 64));
+
         IF_ARCH_ARM(CALL(native::fmadd4, neon_d32::fmadd4, 16));
         IF_ARCH_ARM(CALL(native::fmsub4, neon_d32::fmsub4, 16));
         IF_ARCH_ARM(CALL(native::fmrsub4, neon_d32::fmrsub4, 16));
@@ -93,6 +93,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd_k3(float *dst, const float *src, float k, size_t count);
+        void    fmsub_k3(float *dst, const float *src, float k, size_t count);
+        void    fmrsub_k3(float *dst, const float *src, float k, size_t count);
+        void    fmmul_k3(float *dst, const float *src, float k, size_t count);
+        void    fmdiv_k3(float *dst, const float *src, float k, size_t count);
+        void    fmrdiv_k3(float *dst, const float *src, float k, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -208,6 +220,13 @@ UTEST_BEGIN("dsp.pmath", fmop_k3)
         IF_ARCH_X86(CALL(native::fmmod_k3, avx2::fmmod_k3_fma3, 32));
         IF_ARCH_X86(CALL(native::fmrmod_k3, avx2::fmrmod_k3_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::fmadd_k3, avx512::fmadd_k3, 64));
+        IF_ARCH_X86_64(CALL(native::fmsub_k3, avx512::fmsub_k3, 64));
+        IF_ARCH_X86_64(CALL(native::fmrsub_k3, avx512::fmrsub_k3, 64));
+        IF_ARCH_X86_64(CALL(native::fmmul_k3, avx512::fmmul_k3, 64));
+        IF_ARCH_X86_64(CALL(native::fmdiv_k3, avx512::fmdiv_k3, 64));
+        IF_ARCH_X86_64(CALL(native::fmrdiv_k3, avx512::fmrdiv_k3, 64));
+
         IF_ARCH_ARM(CALL(native::fmadd_k3, neon_d32::fmadd_k3, 16));
         IF_ARCH_ARM(CALL(native::fmsub_k3, neon_d32::fmsub_k3, 16));
         IF_ARCH_ARM(CALL(native::fmrsub_k3, neon_d32::fmrsub_k3, 16));
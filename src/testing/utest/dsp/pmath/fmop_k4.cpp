@@ -93,6 +93,18 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void    fmadd_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmrsub_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmmul_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+        void    fmrdiv_k4(float *dst, const float *src1, const float *src2, float k, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -211,6 +223,13 @@ UTEST_BEGIN("dsp.pmath", fmop_k4)
         IF_ARCH_X86(CALL(native::fmmod_k4, avx2::fmmod_k4_fma3, 32));
         IF_ARCH_X86(CALL(native::fmrmod_k4, avx2::fmrmod_k4_fma3, 32));
 
+        IF_ARCH_X86_64(CALL(native::fmadd_k4, avx512::fmadd_k4, 64));
+        IF_ARCH_X86_64(CALL(native::fmsub_k4, avx512::fmsub_k4, 64));
+        IF_ARCH_X86_64(CALL(native::fmrsub_k4, avx512::fmrsub_k4, 64));
+        IF_ARCH_X86_64(CALL(native::fmmul_k4, avx512::fmmul_k4, 64));
+        IF_ARCH_X86_64(CALL(native::fmdiv_k4, avx512::fmdiv_k4, 64));
+        IF_ARCH_X86_64(CALL(native::fmrdiv_k4, avx512::fmrdiv_k4, 64));
+
         IF_ARCH_ARM(CALL(native::fmadd_k4, neon_d32::fmadd_k4, 16));
         IF_ARCH_ARM(CALL(native::fmsub_k4, neon_d32::fmsub_k4, 16));
         IF_ARCH_ARM(CALL(native::fmrsub_k4, neon_d32::fmrsub_k4, 16));
@@ -82,6 +82,27 @@ IF_ARCH_X86(
     }
 )
 
+IF_ARCH_X86_64(
+    namespace avx512
+    {
+        void lanczos_resample_2x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_2x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_2x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_3x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_4x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_6x4(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x2(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x3(float *dst, const float *src, size_t count);
+        void lanczos_resample_8x4(float *dst, const float *src, size_t count);
+    }
+)
+
 IF_ARCH_ARM(
     namespace neon_d32
     {
@@ -210,6 +231,22 @@ UTEST_BEGIN("dsp.resampling", oversampling)
         IF_ARCH_X86(CALL(native::lanczos_resample_8x3, avx::lanczos_resample_8x3, 32, 8));
         IF_ARCH_X86(CALL(native::lanczos_resample_8x4, avx::lanczos_resample_8x4, 32, 8));
 
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_2x2, avx512::lanczos_resample_2x2, 64, 2));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_2x3, avx512::lanczos_resample_2x3, 64, 2));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_2x4, avx512::lanczos_resample_2x4, 64, 2));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_3x2, avx512::lanczos_resample_3x2, 64, 3));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_3x3, avx512::lanczos_resample_3x3, 64, 3));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_3x4, avx512::lanczos_resample_3x4, 64, 3));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_4x2, avx512::lanczos_resample_4x2, 64, 4));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_4x3, avx512::lanczos_resample_4x3, 64, 4));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_4x4, avx512::lanczos_resample_4x4, 64, 4));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_6x2, avx512::lanczos_resample_6x2, 64, 6));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_6x3, avx512::lanczos_resample_6x3, 64, 6));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_6x4, avx512::lanczos_resample_6x4, 64, 6));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_8x2, avx512::lanczos_resample_8x2, 64, 8));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_8x3, avx512::lanczos_resample_8x3, 64, 8));
+        IF_ARCH_X86_64(CALL(native::lanczos_resample_8x4, avx512::lanczos_resample_8x4, 64, 8));
+
         IF_ARCH_ARM(CALL(native::lanczos_resample_2x2, neon_d32::lanczos_resample_2x2, 16, 2));
         IF_ARCH_ARM(CALL(native::lanczos_resample_2x3, neon_d32::lanczos_resample_2x3, 16, 2));
         IF_ARCH_ARM(CALL(native::lanczos_resample_2x4, neon_d32::lanczos_resample_2x4, 16, 2));
@@ -77,6 +77,7 @@ namespace lsp
 
         void CtlExpression::do_destroy()
         {
+            drop_bindings();
             sExpr.destroy();
             sVars.clear();
             drop_dependencies();
@@ -93,6 +94,74 @@ namespace lsp
             vDependencies.clear();
         }
 
+        void CtlExpression::drop_bindings()
+        {
+            for (size_t i=0, n=vBindings.size(); i<n; ++i)
+            {
+                binding_t *b = vBindings.at(i);
+                if (b->pPort != NULL)
+                    b->pPort->unbind(this);
+            }
+            vBindings.flush();
+            sExpr.unbind_all();
+        }
+
+        bool CtlExpression::bound(CtlPort *port) const
+        {
+            const binding_t *b = vBindings.get_array();
+            for (size_t i=0, n=vBindings.size(); i<n; ++i)
+            {
+                if (b[i].pPort == port)
+                    return true;
+            }
+            return false;
+        }
+
+        status_t CtlExpression::bind_slots()
+        {
+            drop_bindings();
+            if (pCtl == NULL)
+                return STATUS_OK;
+
+            // Bind variables that directly refer ports to these ports,
+            // so they do not need to be resolved by name on each evaluation
+            for (size_t i=0, n=sExpr.slots(); i<n; ++i)
+            {
+                const LSPString *name = sExpr.slot_name(i);
+                if ((name == NULL) || (sParams.contains(name)))
+                    continue;
+
+                CtlPort *p  = pCtl->port(name->get_utf8());
+                if (p == NULL)
+                    continue;
+
+                binding_t *b = vBindings.add();
+                if (b == NULL)
+                    return STATUS_NO_MEM;
+
+                b->nSlot    = i;
+                b->pPort    = p;
+                p->bind(this);
+            }
+
+            return STATUS_OK;
+        }
+
+        void CtlExpression::update_slots()
+        {
+            for (size_t i=0, n=vBindings.size(); i<n; ++i)
+            {
+                binding_t *b = vBindings.at(i);
+
+                // Parameters may be re-filled before each evaluation and shadow the port
+                const LSPString *name = sExpr.slot_name(b->nSlot);
+                if ((name != NULL) && (sParams.contains(name)))
+                    sExpr.unbind(b->nSlot);
+                else
+                    sExpr.bind_float(b->nSlot, b->pPort->get_value());
+            }
+        }
+
         void CtlExpression::notify(CtlPort *port)
         {
             if (!depends(port))
@@ -109,6 +178,7 @@ namespace lsp
 
             sVars.clear();
             drop_dependencies();
+            update_slots();
             status_t res = sExpr.evaluate(&value);
             if (res != STATUS_OK)
             {
@@ -130,6 +200,7 @@ namespace lsp
 
             sVars.clear();
             drop_dependencies();
+            update_slots();
             status_t res = sExpr.evaluate(idx, &value);
             if (res != STATUS_OK)
             {
@@ -167,12 +238,16 @@ namespace lsp
         {
             sVars.clear();
             drop_dependencies();
+            drop_bindings();
 
             LSPString tmp;
             if (!tmp.set_utf8(expr))
                 return false;
             if (sExpr.parse(&tmp, flags) != STATUS_OK)
                 return false;
+            if (bind_slots() != STATUS_OK)
+                return false;
+            update_slots();
 
             status_t res = sExpr.evaluate();
             #ifdef LSP_TRACE
@@ -186,9 +261,13 @@ namespace lsp
         {
             sVars.clear();
             drop_dependencies();
+            drop_bindings();
 
             if (sExpr.parse(expr, flags) != STATUS_OK)
                 return false;
+            if (bind_slots() != STATUS_OK)
+                return false;
+            update_slots();
 
             status_t res = sExpr.evaluate();
             #ifdef LSP_TRACE
@@ -200,8 +279,11 @@ namespace lsp
 
         bool CtlExpression::parse(io::IInSequence *expr, size_t flags)
         {
+            drop_bindings();
             if (sExpr.parse(expr, flags) != STATUS_OK)
                 return false;
+            if (bind_slots() != STATUS_OK)
+                return false;
             return evaluate() == STATUS_OK;
         }
 
@@ -209,7 +291,7 @@ namespace lsp
         {
             // lsp_trace("[%s] resolved %s -> %s = %f", sText.get_utf8(), name->get_utf8(), p->id(), p->get_value());
             // Already subscribed?
-            if (vDependencies.index_of(p) >= 0)
+            if ((vDependencies.index_of(p) >= 0) || (bound(p)))
                 return STATUS_OK;
 
             if (!vDependencies.add(p))
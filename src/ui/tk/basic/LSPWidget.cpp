@@ -440,7 +440,17 @@ namespace lsp
                 return;
             nFlags     |= (flags & (REDRAW_CHILD | REDRAW_SURFACE));
             if (pParent != NULL)
+            {
+                if (flags & REDRAW_SURFACE)
+                    pParent->damage(&sSize);
                 pParent->query_draw(REDRAW_CHILD);
+            }
+        }
+
+        void LSPWidget::damage(const realize_t *r)
+        {
+            if (pParent != NULL)
+                pParent->damage(r);
         }
 
         void LSPWidget::commit_redraw()
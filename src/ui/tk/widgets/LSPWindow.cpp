@@ -20,6 +20,9 @@
  */
 
 #include <ui/tk/tk.h>
+#include <time.h>
+
+#define FRAME_PERIOD            40      /* Minimum period between two frames in milliseconds */
 
 namespace lsp
 {
@@ -68,6 +71,10 @@ namespace lsp
             bOverridePointer= false;
             bSizeRequest    = true;
             bMapFlag        = false;
+            bRedrawQueued   = false;
+            bUnmapped       = false;
+            nLastFrame      = 0;
+            nDamage         = 0;
             nVertPos        = 0.5f;
             nHorPos         = 0.5f;
             nVertScale      = 0.0f;
@@ -231,6 +238,8 @@ namespace lsp
 
         void LSPWindow::do_destroy()
         {
+            cancel_render();
+
             if (pChild != NULL)
             {
                 unlink_widget(pChild);
@@ -260,8 +269,12 @@ namespace lsp
             LSPWidget *widget = static_cast<LSPWidget *>(args);
 
             LSPWindow *_this   = static_cast<LSPWindow *>(widget);
+            if (_this == NULL)
+                return STATUS_BAD_ARGUMENTS;
 
-            return (_this != NULL) ? _this->do_render() : STATUS_BAD_ARGUMENTS;
+            _this->bRedrawQueued    = false;
+            _this->nLastFrame       = ts;
+            return _this->do_render();
         }
 
         status_t LSPWindow::slot_window_close(LSPWidget *sender, void *ptr, void *data)
@@ -285,7 +298,10 @@ namespace lsp
             }
 
             if (!redraw_pending())
+            {
+                nDamage     = 0;
                 return STATUS_OK;
+            }
 
             // call rendering
             ISurface *s = pWindow->get_surface();
@@ -293,11 +309,14 @@ namespace lsp
                 return STATUS_OK;
 
             bool force = nFlags & REDRAW_SURFACE;
+            ISurface *old = pSurface;
             ws::ISurface *bs = get_surface(s);
+            if (bs != old)
+                force       = true;
 
             s->begin();
                 render(bs, force);
-                s->draw(bs, 0, 0);
+                flush_damage(s, bs, force);
                 commit_redraw();
             s->end();
 
@@ -307,9 +326,127 @@ namespace lsp
             return STATUS_OK;
         }
 
+        void LSPWindow::flush_damage(ISurface *s, ISurface *bs, bool force)
+        {
+            // Nothing is known about the changed area, flush the whole window
+            if ((force) || (nDamage <= 0))
+            {
+                s->draw(bs, 0, 0);
+                nDamage     = 0;
+                return;
+            }
+
+            // Flush only damaged parts of the back buffer
+            for (size_t i=0; i<nDamage; ++i)
+            {
+                realize_t *r = &vDamage[i];
+                s->draw_clipped(bs, r->nLeft, r->nTop, r->nLeft, r->nTop, r->nWidth, r->nHeight);
+            }
+            nDamage     = 0;
+        }
+
+        void LSPWindow::schedule_render()
+        {
+            if ((bRedrawQueued) || (bUnmapped) || (pWindow == NULL) || (!(nFlags & F_VISIBLE)))
+                return;
+
+            // Do not render more often than one time per frame period, all redraw
+            // requests received before the frame are coalesced into one render
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            timestamp_t now     = (ts.tv_sec * 1000L) + (ts.tv_nsec / 1000000L);
+            timestamp_t next    = nLastFrame + FRAME_PERIOD;
+
+            if (sRedraw.launch(1, 0, (next > now) ? next - now : 0) == STATUS_OK)
+                bRedrawQueued       = true;
+        }
+
+        void LSPWindow::cancel_render()
+        {
+            sRedraw.cancel();
+            bRedrawQueued       = false;
+        }
+
         void LSPWindow::query_resize()
         {
             bSizeRequest = true;
+            schedule_render();
+        }
+
+        void LSPWindow::query_draw(size_t flags)
+        {
+            LSPWidgetContainer::query_draw(flags);
+            if (redraw_pending())
+                schedule_render();
+        }
+
+        void LSPWindow::damage(const realize_t *r)
+        {
+            // Clip the area with the window's dimensions
+            ssize_t left    = (r->nLeft > 0) ? r->nLeft : 0;
+            ssize_t top     = (r->nTop > 0) ? r->nTop : 0;
+            ssize_t right   = r->nLeft + r->nWidth;
+            ssize_t bottom  = r->nTop + r->nHeight;
+            if (right > sSize.nWidth)
+                right           = sSize.nWidth;
+            if (bottom > sSize.nHeight)
+                bottom          = sSize.nHeight;
+            if ((left >= right) || (top >= bottom))
+                return;
+
+            // Merge the area with the overlapping or adjacent rectangle, or with the one
+            // that grows least when the list of rectangles is full
+            realize_t *dst  = NULL;
+            ssize_t growth  = 0;
+
+            for (size_t i=0; i<nDamage; ++i)
+            {
+                realize_t *d    = &vDamage[i];
+                ssize_t l       = (d->nLeft < left) ? d->nLeft : left;
+                ssize_t t       = (d->nTop < top) ? d->nTop : top;
+                ssize_t rr      = (d->nLeft + d->nWidth > right) ? d->nLeft + d->nWidth : right;
+                ssize_t bb      = (d->nTop + d->nHeight > bottom) ? d->nTop + d->nHeight : bottom;
+
+                if ((left <= d->nLeft + d->nWidth) && (d->nLeft <= right) &&
+                    (top <= d->nTop + d->nHeight) && (d->nTop <= bottom))
+                {
+                    dst             = d;
+                    break;
+                }
+                else if (nDamage >= DAMAGE_RECTS)
+                {
+                    ssize_t delta   = (rr - l) * (bb - t) - d->nWidth * d->nHeight;
+                    if ((dst == NULL) || (delta < growth))
+                    {
+                        dst             = d;
+                        growth          = delta;
+                    }
+                }
+            }
+
+            if (dst == NULL)
+            {
+                dst             = &vDamage[nDamage++];
+                dst->nLeft      = left;
+                dst->nTop       = top;
+                dst->nWidth     = right - left;
+                dst->nHeight    = bottom - top;
+                return;
+            }
+
+            if (left > dst->nLeft)
+                left            = dst->nLeft;
+            if (top > dst->nTop)
+                top             = dst->nTop;
+            if (right < dst->nLeft + dst->nWidth)
+                right           = dst->nLeft + dst->nWidth;
+            if (bottom < dst->nTop + dst->nHeight)
+                bottom          = dst->nTop + dst->nHeight;
+
+            dst->nLeft      = left;
+            dst->nTop       = top;
+            dst->nWidth     = right - left;
+            dst->nHeight    = bottom - top;
         }
 
         status_t LSPWindow::get_absolute_geometry(realize_t *realize)
@@ -427,7 +564,7 @@ namespace lsp
 
         bool LSPWindow::hide()
         {
-            sRedraw.cancel();
+            cancel_render();
             if (pWindow != NULL)
                 pWindow->hide();
 
@@ -477,8 +614,8 @@ namespace lsp
             sync_size();
             update_pointer();
 
-            // Launch redraw timer
-            sRedraw.launch(-1, 40);
+            // Request redraw of the window
+            bUnmapped   = false;
             query_draw();
 
             // Show window
@@ -576,7 +713,7 @@ namespace lsp
                     break;
 
                 case UIE_SHOW:
-                    sRedraw.launch(-1, 40);
+                    bUnmapped   = false;
                     query_draw();
                     if (bMapFlag != bool(nFlags & F_VISIBLE))
                     {
@@ -587,7 +724,8 @@ namespace lsp
                     break;
 
                 case UIE_HIDE:
-                    sRedraw.cancel();
+                    bUnmapped   = true;
+                    cancel_render();
                     if (bMapFlag != bool(nFlags & F_VISIBLE))
                     {
                         lsp_trace("HIDE ptr=%p", this);
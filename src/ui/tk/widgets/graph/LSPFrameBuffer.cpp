@@ -23,6 +23,8 @@
 #include <core/sugar.h>
 #include <dsp/dsp.h>
 
+#define FB_LUT_SIZE         4096        /* Number of entries in the color lookup table */
+
 namespace lsp
 {
     namespace tk
@@ -35,8 +37,10 @@ namespace lsp
             nRows       = 0;
             nCols       = 0;
             nCurrRow    = 0;
+            nOrigin     = 0;
             vData       = NULL;
             vTempRGBA   = NULL;
+            vLUT        = NULL;
             pData       = NULL;
 
             fTransparency    = 1.0f;
@@ -46,6 +50,7 @@ namespace lsp
             fWidth      = 1.0f;
             fHeight     = 1.0f;
             bClear      = true;
+            bUpdateLUT  = true;
             nPalette    = 0;
             pCalcColor  = &LSPFrameBuffer::calc_rainbow_color;
 
@@ -80,6 +85,7 @@ namespace lsp
                 pData = NULL;
             }
             vTempRGBA   = NULL;
+            vLUT        = NULL;
         }
 
         void LSPFrameBuffer::allocate_buffer()
@@ -88,9 +94,14 @@ namespace lsp
             if (amount <= 0)
                 return;
 
-            amount     += nCols * 4; // RGBA x number of columns for temporary buffer
+            amount     += FB_LUT_SIZE * 5; // RGBA temporary buffer + color lookup table
             vData       = alloc_aligned<float>(pData, amount, ALIGN64);
+            if (vData == NULL)
+                return;
+            dsp::fill_zero(vData, nRows * nCols); // Rows not written by append_data() should be valid for draw_row()
             vTempRGBA   = &vData[nRows * nCols];
+            vLUT        = reinterpret_cast<uint32_t *>(&vTempRGBA[FB_LUT_SIZE * 4]);
+            bUpdateLUT  = true;
         }
 
         float *LSPFrameBuffer::get_buffer()
@@ -100,13 +111,6 @@ namespace lsp
             return vData;
         }
 
-        float *LSPFrameBuffer::get_rgba_buffer()
-        {
-            if (vTempRGBA == NULL)
-                allocate_buffer();
-            return vTempRGBA;
-        }
-
         status_t LSPFrameBuffer::init()
         {
             status_t result = LSPGraphItem::init();
@@ -123,21 +127,24 @@ namespace lsp
 
         void LSPFrameBuffer::check_color_changed()
         {
-            // Trigger bClean flag if color changed
-            if (!bClear)
+            // Trigger bClear and bUpdateLUT flags if color changed
+            bool changed =
+                (sColor.red() != sColRGBA.r) ||
+                (sColor.green() != sColRGBA.g) ||
+                (sColor.blue() != sColRGBA.b) ||
+                (sColor.alpha() != sColRGBA.a);
+
+            if (!changed)
+                changed =
+                    (sBgColor.red() != sBgRGBA.r) ||
+                    (sBgColor.green() != sBgRGBA.g) ||
+                    (sBgColor.blue() != sBgRGBA.b) ||
+                    (sBgColor.alpha() != sBgRGBA.a);
+
+            if (changed)
             {
-                bClear =
-                    (sColor.red() != sColRGBA.r) ||
-                    (sColor.green() != sColRGBA.g) ||
-                    (sColor.blue() != sColRGBA.b) ||
-                    (sColor.alpha() != sColRGBA.a);
-
-                if (!bClear)
-                    bClear =
-                        (sBgColor.red() != sBgRGBA.r) ||
-                        (sBgColor.green() != sBgRGBA.g) ||
-                        (sBgColor.blue() != sBgRGBA.b) ||
-                        (sBgColor.alpha() != sBgRGBA.a);
+                bClear      = true;
+                bUpdateLUT  = true;
             }
 
             // Store actual color value
@@ -179,7 +186,9 @@ namespace lsp
         {
             if (nRows == rows)
                 return;
-            nRows = rows;
+            nRows   = rows;
+            nOrigin = 0;
+            bClear  = true;
             drop_data();
             query_draw();
         }
@@ -188,7 +197,8 @@ namespace lsp
         {
             if (nCols == cols)
                 return;
-            nCols = cols;
+            nCols   = cols;
+            bClear  = true;
             drop_data();
             query_draw();
         }
@@ -197,8 +207,10 @@ namespace lsp
         {
             if ((nRows == rows) && (nCols == cols))
                 return;
-            nRows = rows;
-            nCols = cols;
+            nRows   = rows;
+            nCols   = cols;
+            nOrigin = 0;
+            bClear  = true;
             drop_data();
             query_draw();
         }
@@ -268,8 +280,9 @@ namespace lsp
                     break;
             }
 
-            nPalette = value;
-            bClear = true;
+            nPalette    = value;
+            bClear      = true;
+            bUpdateLUT  = true;
             query_draw();
         }
 
@@ -337,6 +350,58 @@ namespace lsp
             dsp::hsla_to_rgba(rgba, rgba, n);
         }
 
+        void LSPFrameBuffer::update_lut()
+        {
+            // Use the lookup table as the temporary source of values
+            float *v    = reinterpret_cast<float *>(vLUT);
+            float k     = 1.0f / (FB_LUT_SIZE - 1);
+            for (size_t i=0; i<FB_LUT_SIZE; ++i)
+                v[i]        = i * k;
+
+            // Compute colors and convert them into the pixel format
+            (this->*pCalcColor)(vTempRGBA, v, FB_LUT_SIZE);
+            dsp::rgba_to_bgra32(vLUT, vTempRGBA, FB_LUT_SIZE);
+
+            bUpdateLUT  = false;
+        }
+
+        void LSPFrameBuffer::draw_row(uint32_t *dst, const float *src, size_t n)
+        {
+            // Values are limited to 0..1 range by append_data(), unwritten rows are zero
+            const float k   = FB_LUT_SIZE - 1;
+            for (size_t i=0; i<n; ++i)
+                dst[i]          = vLUT[size_t(src[i] * k + 0.5f)];
+        }
+
+        void LSPFrameBuffer::draw_ring_part(ISurface *s, ISurface *pp, float x, float y, float sx, float sy, float ra,
+                float shift, float first, float last, bool snap_first, bool snap_last)
+        {
+            // Compute the clipping rectangle for rows [first, last) of the frame buffer,
+            // columns are not clipped: the surface boundaries limit them
+            float ca    = cosf(ra), sa = sinf(ra);
+            float u0    = -1.0f, u1 = nCols + 1.0f;
+            float x0    = x + sx * (u0 * ca - first * sa);
+            float y0    = y + sy * (u0 * sa + first * ca);
+            float x1    = x + sx * (u1 * ca - last * sa);
+            float y1    = y + sy * (u1 * sa + last * ca);
+
+            // Snap the seam between parts to the pixel grid to prevent overlapping of partially covered pixels
+            if (snap_first)
+            {
+                x0      = roundf(x0);
+                y0      = roundf(y0);
+            }
+            if (snap_last)
+            {
+                x1      = roundf(x1);
+                y1      = roundf(y1);
+            }
+
+            s->clip_begin(lsp_min(x0, x1), lsp_min(y0, y1), fabs(x1 - x0), fabs(y1 - y0));
+            s->draw_rotate_alpha(pp, x - sx * shift * sa, y + sy * shift * ca, sx, sy, ra, fTransparency);
+            s->clip_end();
+        }
+
         void LSPFrameBuffer::render(ISurface *s, bool force)
         {
             // Check size
@@ -345,8 +410,7 @@ namespace lsp
 
             // Get data buffer
             float *buf = get_buffer();
-            float *rgba = get_rgba_buffer();
-            if ((buf == NULL) || (rgba == NULL))
+            if ((buf == NULL) || (vLUT == NULL))
                 return;
 
             // Get drawing surface
@@ -365,24 +429,29 @@ namespace lsp
                 if (xp == NULL)
                     return;
 
+                // Rebuild color lookup table if palette or color has changed
+                if (bUpdateLUT)
+                    update_lut();
+
                 // Do not draw more than can
                 if ((nChanges >= nRows) || (bClear))
                     nChanges    = nRows;
 
-                // Shift buffer
+                // The surface is a ring buffer of rows: instead of shifting the whole
+                // surface, move the origin back and overwrite the oldest rows
                 size_t stride = pp->stride();
-                ::memmove(&xp[stride * nChanges], xp, (nRows - nChanges) * stride);
+                nOrigin     = (nOrigin + nRows - nChanges) % nRows;
 
-                // Draw dots
-                Color c(1.0f, 0.0f, 0.0f);
-                size_t row = (nCurrRow + nRows - 1) % nRows;
+                // Draw dots, most recent row goes to the origin
+                size_t row  = (nCurrRow + nRows - 1) % nRows;
+                size_t dst  = nOrigin;
 
-                for (size_t i=0; i<nChanges; ++i, xp += stride)
+                for (size_t i=0; i<nChanges; ++i)
                 {
-                    const float *p = &vData[row * nCols];
-                    (this->*pCalcColor)(rgba, p, nCols);
-                    dsp::rgba_to_bgra32(xp, rgba, nCols);
+                    draw_row(reinterpret_cast<uint32_t *>(&xp[dst * stride]), &vData[row * nCols], nCols);
                     row = (row + nRows - 1) % nRows;
+                    if ((++dst) >= nRows)
+                        dst         = 0;
                 }
 
                 pp->end_direct();
@@ -444,7 +513,17 @@ namespace lsp
                     break;
             }
 
-            s->draw_rotate_alpha(pp, x, y, sx, sy, ra, fTransparency);
+            // Draw the ring buffer as two parts: surface rows [origin, rows) go first,
+            // surface rows [0, origin) go after them
+            if (nOrigin == 0)
+            {
+                s->draw_rotate_alpha(pp, x, y, sx, sy, ra, fTransparency);
+                return;
+            }
+
+            size_t split = nRows - nOrigin;
+            draw_ring_part(s, pp, x, y, sx, sy, ra, -float(nOrigin), 0.0f, split, false, true);
+            draw_ring_part(s, pp, x, y, sx, sy, ra, split, split, nRows, true, false);
         }
     } /* namespace tk */
 } /* namespace lsp */
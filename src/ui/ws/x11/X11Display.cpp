@@ -25,7 +25,9 @@
 
 #include <sys/poll.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #define X11IOBUF_SIZE               0x100000
 
@@ -114,6 +116,8 @@ namespace lsp
             {
                 pNextHandler    = NULL;
                 bExit           = false;
+                vWakeup[0]      = -1;
+                vWakeup[1]      = -1;
                 pDisplay        = NULL;
                 hRootWnd        = -1;
                 hClipWnd        = None;
@@ -148,6 +152,20 @@ namespace lsp
                     }
                 }
 
+                // Create the pipe that wakes up the main loop from other threads
+                if (::pipe(vWakeup) != 0)
+                {
+                    vWakeup[0]      = -1;
+                    vWakeup[1]      = -1;
+                    lsp_error("Can not create wake-up pipe");
+                    return STATUS_UNKNOWN_ERR;
+                }
+                for (size_t i=0; i<2; ++i)
+                {
+                    ::fcntl(vWakeup[i], F_SETFL, ::fcntl(vWakeup[i], F_GETFL) | O_NONBLOCK);
+                    ::fcntl(vWakeup[i], F_SETFD, FD_CLOEXEC);
+                }
+
                 // Open the display
                 pDisplay        = ::XOpenDisplay(NULL);
                 if (pDisplay == NULL)
@@ -331,6 +349,15 @@ namespace lsp
                     ::XCloseDisplay(dpy);
                 }
 
+                for (size_t i=0; i<2; ++i)
+                {
+                    if (vWakeup[i] >= 0)
+                    {
+                        ::close(vWakeup[i]);
+                        vWakeup[i]      = -1;
+                    }
+                }
+
                 // Remove custom handler
                 while (true)
                 {
@@ -356,10 +383,37 @@ namespace lsp
                 IDisplay::destroy();
             }
 
+            void X11Display::wakeup()
+            {
+                if (vWakeup[1] < 0)
+                    return;
+
+                // The pipe is non-blocking, it is enough to have at least one byte in it
+                char c = 0;
+                while (::write(vWakeup[1], &c, sizeof(c)) < 0)
+                {
+                    if (errno != EINTR)
+                        break;
+                }
+            }
+
+            void X11Display::drain_wakeup()
+            {
+                char buf[0x40];
+                while (true)
+                {
+                    ssize_t n = ::read(vWakeup[0], buf, sizeof(buf));
+                    if ((n < 0) && (errno == EINTR))
+                        continue;
+                    if (n < ssize_t(sizeof(buf)))
+                        break;
+                }
+            }
+
             int X11Display::main()
             {
-                // Make a pause
-                struct pollfd x11_poll;
+                // Sleep until X11 event, wake-up request or nearest task, do not wake up when idle
+                struct pollfd x11_poll[2];
                 struct timespec ts;
 
                 int x11_fd          = ConnectionNumber(pDisplay);
@@ -371,27 +425,27 @@ namespace lsp
                     // Get current time
                     clock_gettime(CLOCK_REALTIME, &ts);
                     timestamp_t xts     = (ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
-                    int wtime           = 50; // How many milliseconds to wait
+                    int wtime           = -1; // How many milliseconds to wait, sleep until event by default
 
-                    if (sTasks.size() > 0)
+                    if (::XPending(pDisplay) > 0)
+                        wtime               = 0;
+                    else if (sTasks.size() > 0)
                     {
                         dtask_t *t          = sTasks.first();
                         ssize_t delta       = t->nTime - xts;
-                        if (delta <= 0)
-                            wtime               = -1;
-                        else if (delta <= wtime)
-                            wtime               = delta;
+                        wtime               = (delta > 0) ? delta : 0;
                     }
-                    else if (::XPending(pDisplay) > 0)
-                        wtime               = 0;
 
-                    // Try to poll input data for a 100 msec period
-                    x11_poll.fd         = x11_fd;
-                    x11_poll.events     = POLLIN | POLLPRI | POLLHUP;
-                    x11_poll.revents    = 0;
+                    // Wait for input data, for the wake-up request or for the nearest task
+                    x11_poll[0].fd      = x11_fd;
+                    x11_poll[0].events  = POLLIN | POLLPRI | POLLHUP;
+                    x11_poll[0].revents = 0;
+                    x11_poll[1].fd      = vWakeup[0];
+                    x11_poll[1].events  = POLLIN;
+                    x11_poll[1].revents = 0;
 
                     errno               = 0;
-                    int poll_res        = (wtime > 0) ? poll(&x11_poll, 1, wtime) : 0;
+                    int poll_res        = (wtime != 0) ? poll(x11_poll, 2, wtime) : 0;
                     if (poll_res < 0)
                     {
                         int err_code = errno;
@@ -399,8 +453,19 @@ namespace lsp
                         if (err_code != EINTR)
                             return -1;
                     }
-                    else if ((wtime <= 0) || ((poll_res > 0) && (x11_poll.events > 0)))
+                    else if ((wtime >= 0) || (x11_poll[0].revents != 0) || (x11_poll[1].revents != 0))
                     {
+                        // Another thread has submitted a task or requested to leave the loop
+                        if (x11_poll[1].revents != 0)
+                            drain_wakeup();
+
+                        // Update current time after the wait
+                        if (wtime > 0)
+                        {
+                            clock_gettime(CLOCK_REALTIME, &ts);
+                            xts                 = (ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+                        }
+
                         // Do iteration
                         status_t result = IDisplay::main_iteration();
                         if (result == STATUS_OK)
@@ -2794,6 +2859,16 @@ namespace lsp
             void X11Display::quit_main()
             {
                 bExit = true;
+                wakeup();
+            }
+
+            taskid_t X11Display::submit_task(timestamp_t time, task_handler_t handler, void *arg)
+            {
+                // Wake up the main loop only if it needs to wait less than before
+                taskid_t id = IDisplay::submit_task(time, handler, arg);
+                if ((id >= 0) && (sTasks.first()->nID == id))
+                    wakeup();
+                return id;
             }
 
             bool X11Display::add_window(X11Window *wnd)
@@ -50,6 +50,7 @@
 #include <utils/resource_gen/scene3d.h>
 #include <utils/resource_gen/presets.h>
 #include <utils/resource_gen/json.h>
+#include <utils/resource_gen/index.h>
 
 namespace lsp
 {
@@ -364,6 +365,11 @@ namespace lsp
                 fprintf(out,    "\t\t{ NULL, NULL, %d }\n", resource::RESOURCE_UNKNOWN);
                 fprintf(out,    "\t};\n\n");
 
+                result = emit_resource_index(out, resources);
+            }
+
+            if (result == STATUS_OK)
+            {
                 fprintf(out,    "} /* namespace resource */\n"); // End of namespace
                 fprintf(out,    "} /* namespace lsp */\n"); // End of namespace
             }
@@ -374,7 +380,9 @@ namespace lsp
             sdict.flush();
             fdict.flush();
 
-            return fclose(out);
+            if (fclose(out) != 0)
+                return STATUS_IO_ERROR;
+            return result;
         }
 
         status_t main(int argc, const char **argv)